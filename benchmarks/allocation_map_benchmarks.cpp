@@ -0,0 +1,232 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "umpire/util/AllocationMap.hpp"
+#include "umpire/util/AllocationRecord.hpp"
+
+// Benchmarks for AllocationMap on its own, without any allocation.
+//
+// Each benchmark takes three arguments: the number of entries already in
+// the map, the address pattern (0 clustered, 1 scattered), and the number
+// of shards. Addresses are
+// never dereferenced, so the map can be filled with up to 1e7 entries
+// without allocating the memory they describe.
+//
+//   clustered: consecutive 256 byte blocks, as handed out by a pool.
+//   scattered: 64 byte blocks at random 16 byte aligned addresses across the
+//              user address space, as returned by malloc over a long run.
+
+enum Pattern { clustered = 0, scattered = 1 };
+
+static const std::size_t clustered_size = 256;
+static const std::size_t scattered_size = 64;
+static const uintptr_t clustered_base = 0x100000000000;
+
+// Number of records inserted or removed between pauses of the timer.
+static const std::size_t batch_size = 1024;
+
+static std::size_t recordSize(Pattern pattern)
+{
+  return pattern == clustered ? clustered_size : scattered_size;
+}
+
+// Generate count addresses, starting at the first-th address of the
+// pattern. Scattered addresses are seeded by first, so disjoint ranges
+// give different addresses.
+static std::vector<uintptr_t> makeAddresses(Pattern pattern, std::size_t first, std::size_t count)
+{
+  std::vector<uintptr_t> addresses(count);
+
+  if (pattern == clustered) {
+    for (std::size_t i = 0; i < count; ++i) {
+      addresses[i] = clustered_base + (first + i) * clustered_size;
+    }
+  } else {
+    std::mt19937_64 gen(first + 1);
+    std::uniform_int_distribution<uintptr_t> dist(0x10000000, 0x7fffffffffff);
+    for (std::size_t i = 0; i < count; ++i) {
+      addresses[i] = dist(gen) & ~static_cast<uintptr_t>(15);
+    }
+  }
+
+  return addresses;
+}
+
+struct Fixture {
+  std::size_t entries;
+  Pattern pattern;
+  std::size_t shards;
+
+  std::unique_ptr<umpire::util::AllocationMap> map;
+  std::vector<uintptr_t> addresses;
+};
+
+// Every thread of a run shares one map. It is rebuilt only when the
+// arguments change, since filling it with 1e7 entries takes a while.
+static Fixture& getFixture(benchmark::State& st)
+{
+  static std::mutex mutex;
+  static Fixture fixture{0, clustered, 0, nullptr, {}};
+
+  const std::size_t entries = st.range(0);
+  const Pattern pattern = static_cast<Pattern>(st.range(1));
+  const std::size_t shards = st.range(2);
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if (!fixture.map || fixture.entries != entries
+      || fixture.pattern != pattern || fixture.shards != shards) {
+    fixture.map.reset();
+    fixture.map.reset(new umpire::util::AllocationMap(shards));
+    fixture.entries = entries;
+    fixture.pattern = pattern;
+    fixture.shards = shards;
+    fixture.addresses = makeAddresses(pattern, 0, entries);
+
+    const std::size_t size = recordSize(pattern);
+    for (auto address : fixture.addresses) {
+      void* ptr = reinterpret_cast<void*>(address);
+      fixture.map->insert(ptr, umpire::util::AllocationRecord{ptr, size, nullptr});
+    }
+  }
+
+  return fixture;
+}
+
+// Each call takes its own block of addresses past the prefilled entries, so
+// concurrent threads never insert the same key.
+static std::vector<uintptr_t> makeExtraAddresses(Fixture& fixture)
+{
+  static std::atomic<std::size_t> next_block{1};
+
+  return makeAddresses(fixture.pattern,
+      fixture.entries * next_block.fetch_add(1) + batch_size, batch_size);
+}
+
+static void insert(benchmark::State& st)
+{
+  auto& fixture = getFixture(st);
+  auto extra = makeExtraAddresses(fixture);
+  const std::size_t size = recordSize(fixture.pattern);
+
+  while (st.KeepRunning()) {
+    for (auto address : extra) {
+      void* ptr = reinterpret_cast<void*>(address);
+      fixture.map->insert(ptr, umpire::util::AllocationRecord{ptr, size, nullptr});
+    }
+
+    st.PauseTiming();
+    for (auto address : extra) {
+      fixture.map->remove(reinterpret_cast<void*>(address));
+    }
+    st.ResumeTiming();
+  }
+
+  st.SetItemsProcessed(st.iterations() * batch_size);
+}
+
+static void remove(benchmark::State& st)
+{
+  auto& fixture = getFixture(st);
+  auto extra = makeExtraAddresses(fixture);
+  const std::size_t size = recordSize(fixture.pattern);
+
+  while (st.KeepRunning()) {
+    st.PauseTiming();
+    for (auto address : extra) {
+      void* ptr = reinterpret_cast<void*>(address);
+      fixture.map->insert(ptr, umpire::util::AllocationRecord{ptr, size, nullptr});
+    }
+    st.ResumeTiming();
+
+    for (auto address : extra) {
+      fixture.map->remove(reinterpret_cast<void*>(address));
+    }
+  }
+
+  st.SetItemsProcessed(st.iterations() * batch_size);
+}
+
+// Lookups visit the prefilled entries in a fixed pseudo-random order, so
+// consecutive lookups do not hit the same part of the map.
+template<typename Lookup>
+static void lookup(benchmark::State& st, Lookup&& op)
+{
+  auto& fixture = getFixture(st);
+  const auto& addresses = fixture.addresses;
+  const std::size_t count = addresses.size();
+  const std::size_t stride = 7919;
+
+  std::size_t i = 0;
+  while (st.KeepRunning()) {
+    op(*fixture.map, addresses[i]);
+    i = (i + stride) % count;
+  }
+
+  st.SetItemsProcessed(st.iterations());
+}
+
+static void findBase(benchmark::State& st)
+{
+  lookup(st, [](umpire::util::AllocationMap& map, uintptr_t address) {
+    benchmark::DoNotOptimize(map.find(reinterpret_cast<void*>(address)));
+  });
+}
+
+static void findOffset(benchmark::State& st)
+{
+  lookup(st, [](umpire::util::AllocationMap& map, uintptr_t address) {
+    benchmark::DoNotOptimize(map.find(reinterpret_cast<void*>(address + scattered_size/2)));
+  });
+}
+
+static void contains(benchmark::State& st)
+{
+  lookup(st, [](umpire::util::AllocationMap& map, uintptr_t address) {
+    benchmark::DoNotOptimize(map.contains(reinterpret_cast<void*>(address)));
+  });
+}
+
+static void arguments(benchmark::internal::Benchmark* b)
+{
+  const int max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+  for (int entries = 1000; entries <= 10000000; entries *= 10) {
+    for (int pattern : {clustered, scattered}) {
+      for (int shards : {1, 32}) {
+        b->Args({entries, pattern, shards});
+      }
+    }
+  }
+
+  b->ThreadRange(1, max_threads)->UseRealTime();
+}
+
+BENCHMARK(insert)->Apply(arguments);
+BENCHMARK(remove)->Apply(arguments);
+BENCHMARK(findBase)->Apply(arguments);
+BENCHMARK(findOffset)->Apply(arguments);
+BENCHMARK(contains)->Apply(arguments);
+
+BENCHMARK_MAIN()
@@ -0,0 +1,161 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "umpire/config.hpp"
+#include "umpire/ResourceManager.hpp"
+#include "umpire/Allocator.hpp"
+#include "umpire/strategy/DynamicPool.hpp"
+#include "umpire/strategy/FixedPool.hpp"
+#include "umpire/strategy/SizeClassPool.hpp"
+#include "umpire/strategy/ThreadCachingAllocator.hpp"
+#include "umpire/strategy/ThreadSafeAllocator.hpp"
+
+// Every benchmark runs from 1 up to max_threads threads at once. Throughput
+// is reported as items_per_second over wall-clock time, so a flat curve
+// means perfect scaling and a falling one means contention.
+//
+// DynamicPool, FixedPool and SizeClassPool are not thread-safe, so they are
+// measured behind a ThreadSafeAllocator, which is how they must be used from
+// several threads.
+
+static const size_t live_allocations = 64;
+static const int block_size = 64;
+
+struct block { char _[block_size]; };
+
+static umpire::Allocator getAllocator(const std::string& name)
+{
+  static std::mutex mutex;
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  if (!rm.isAllocator(name)) {
+    auto host = rm.getAllocator("HOST");
+
+    if (name == "thread_safe_dynamic_pool") {
+      rm.makeAllocator<umpire::strategy::ThreadSafeAllocator>(name,
+          rm.makeAllocator<umpire::strategy::DynamicPool>("bench_dynamic_pool", host));
+    } else if (name == "thread_safe_fixed_pool") {
+      rm.makeAllocator<umpire::strategy::ThreadSafeAllocator>(name,
+          rm.makeAllocator<umpire::strategy::FixedPool<block>>("bench_fixed_pool", host));
+    } else if (name == "thread_safe_size_class_pool") {
+      rm.makeAllocator<umpire::strategy::ThreadSafeAllocator>(name,
+          rm.makeAllocator<umpire::strategy::SizeClassPool>("bench_size_class_pool", host));
+    } else if (name == "thread_caching") {
+      rm.makeAllocator<umpire::strategy::ThreadCachingAllocator>(name, host);
+    }
+  }
+
+  return rm.getAllocator(name);
+}
+
+// Allocate and free with a window of live allocations per thread, so the
+// AllocationMap holds entries from every thread throughout.
+static void allocateDeallocate(benchmark::State& st, const std::string& name)
+{
+  auto allocator = getAllocator(name);
+  std::vector<void*> window(live_allocations, nullptr);
+  size_t i = 0;
+
+  while (st.KeepRunning()) {
+    void*& slot = window[i++ % live_allocations];
+    if (slot) {
+      allocator.deallocate(slot);
+    }
+    slot = allocator.allocate(block_size);
+  }
+
+  for (auto ptr : window) {
+    if (ptr) {
+      allocator.deallocate(ptr);
+    }
+  }
+
+  st.SetItemsProcessed(2 * st.iterations());
+}
+
+// Lookups run against a fixed set of allocations owned by each thread.
+template<typename Lookup>
+static void lookup(benchmark::State& st, const std::string& name, Lookup&& op)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto allocator = getAllocator(name);
+
+  std::vector<void*> ptrs(live_allocations);
+  for (auto& ptr : ptrs) {
+    ptr = allocator.allocate(block_size);
+  }
+
+  size_t i = 0;
+  while (st.KeepRunning()) {
+    op(rm, ptrs[i % live_allocations], ptrs[(i + 1) % live_allocations]);
+    ++i;
+  }
+
+  for (auto ptr : ptrs) {
+    allocator.deallocate(ptr);
+  }
+
+  st.SetItemsProcessed(st.iterations());
+}
+
+static void getSize(benchmark::State& st, const std::string& name)
+{
+  lookup(st, name, [](umpire::ResourceManager& rm, void* ptr, void*) {
+    benchmark::DoNotOptimize(rm.getSize(ptr));
+  });
+}
+
+static void hasAllocator(benchmark::State& st, const std::string& name)
+{
+  lookup(st, name, [](umpire::ResourceManager& rm, void* ptr, void*) {
+    benchmark::DoNotOptimize(rm.hasAllocator(static_cast<char*>(ptr) + 1));
+  });
+}
+
+static void copy(benchmark::State& st, const std::string& name)
+{
+  lookup(st, name, [](umpire::ResourceManager& rm, void* dst, void* src) {
+    rm.copy(dst, src, block_size);
+  });
+}
+
+static void threadCounts(benchmark::internal::Benchmark* b)
+{
+  const int max_threads = std::max(1u, std::thread::hardware_concurrency());
+  b->ThreadRange(1, max_threads)->UseRealTime();
+}
+
+#define UMPIRE_THREAD_BENCHMARKS(allocator) \
+BENCHMARK_CAPTURE(allocateDeallocate, allocator, #allocator)->Apply(threadCounts); \
+BENCHMARK_CAPTURE(getSize, allocator, #allocator)->Apply(threadCounts); \
+BENCHMARK_CAPTURE(hasAllocator, allocator, #allocator)->Apply(threadCounts); \
+BENCHMARK_CAPTURE(copy, allocator, #allocator)->Apply(threadCounts);
+
+UMPIRE_THREAD_BENCHMARKS(HOST)
+UMPIRE_THREAD_BENCHMARKS(thread_safe_dynamic_pool)
+UMPIRE_THREAD_BENCHMARKS(thread_safe_fixed_pool)
+UMPIRE_THREAD_BENCHMARKS(thread_safe_size_class_pool)
+UMPIRE_THREAD_BENCHMARKS(thread_caching)
+
+BENCHMARK_MAIN()
@@ -0,0 +1,279 @@
+#!/usr/bin/env python3
+##############################################################################
+# Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+# Produced at the Lawrence Livermore National Laboratory
+#
+# Created by David Beckingsale, david@llnl.gov
+# LLNL-CODE-747640
+#
+# All rights reserved.
+#
+# This file is part of Umpire.
+#
+# For details, see https://github.com/LLNL/Umpire
+# Please also see the LICENSE file for MIT license.
+##############################################################################
+"""
+Capture Umpire benchmark results and compare them against a baseline.
+
+  benchmark_baseline.py run --bin-dir build/benchmark --out-dir results \
+      --tag gcc-8_Release allocator_benchmarks copy_benchmarks
+
+runs each Google Benchmark executable with JSON output and writes all of
+their results to one file in out-dir, named after the host, the tag, the
+commit and the date. With --baseline FILE, the new results are then compared
+against FILE.
+
+  benchmark_baseline.py compare baseline.json current.json
+
+compares two such files. Each benchmark is run --repetitions times, and a
+benchmark is reported as a regression when its median time grew by more
+than --threshold and a Mann-Whitney U test over the repetitions says the
+difference is significant at --alpha. The exit status is 1 when there are
+regressions, so the comparison can gate a CI job.
+"""
+
+from __future__ import print_function
+
+import argparse
+import datetime
+import json
+import math
+import os
+import socket
+import subprocess
+import sys
+import tempfile
+
+AGGREGATE_SUFFIXES = ('_mean', '_median', '_stddev', '_cv')
+
+
+def git_commit(source_dir):
+    try:
+        return subprocess.check_output(
+            ['git', 'rev-parse', '--short', 'HEAD'],
+            cwd=source_dir, stderr=subprocess.DEVNULL).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return 'unknown'
+
+
+def run_benchmark(executable, repetitions, extra_args):
+    handle, out = tempfile.mkstemp(suffix='.json')
+    os.close(handle)
+
+    try:
+        command = [executable,
+                   '--benchmark_out=' + out,
+                   '--benchmark_out_format=json',
+                   '--benchmark_repetitions=%d' % repetitions] + extra_args
+        print('Running ' + ' '.join(command))
+        subprocess.check_call(command)
+
+        with open(out) as f:
+            return json.load(f)
+    finally:
+        os.remove(out)
+
+
+def run(args):
+    host = args.host or socket.gethostname().split('.')[0]
+    commit = git_commit(args.source_dir)
+    date = datetime.date.today().isoformat()
+
+    results = {
+        'umpire': {
+            'host': host,
+            'tag': args.tag,
+            'commit': commit,
+            'date': date,
+            'repetitions': args.repetitions,
+        },
+        'context': None,
+        'benchmarks': [],
+    }
+    failed = []
+
+    for name in args.benchmarks:
+        executable = os.path.join(args.bin_dir, name)
+        if not os.path.exists(executable):
+            print('Skipping ' + name + ': not built')
+            continue
+
+        try:
+            output = run_benchmark(executable, args.repetitions, args.benchmark_args)
+        except subprocess.CalledProcessError as e:
+            print('Error: %s exited with status %d' % (name, e.returncode))
+            failed.append(name)
+            continue
+
+        if results['context'] is None:
+            results['context'] = output.get('context')
+
+        for b in output.get('benchmarks', []):
+            b['executable'] = name
+            results['benchmarks'].append(b)
+
+    if not os.path.isdir(args.out_dir):
+        os.makedirs(args.out_dir)
+
+    path = os.path.join(args.out_dir,
+                        '_'.join([host, args.tag, commit, date]) + '.json')
+    with open(path, 'w') as f:
+        json.dump(results, f, indent=2)
+    print('Wrote ' + path)
+
+    status = 1 if failed else 0
+    if args.baseline:
+        status = max(status, compare_files(args.baseline, path, args))
+    return status
+
+
+def is_aggregate(b):
+    if 'run_type' in b:
+        return b['run_type'] == 'aggregate'
+    return b['name'].endswith(AGGREGATE_SUFFIXES)
+
+
+def load_times(path):
+    with open(path) as f:
+        results = json.load(f)
+
+    times = {}
+    for b in results.get('benchmarks', []):
+        if is_aggregate(b) or 'real_time' not in b:
+            continue
+
+        name = b.get('run_name', b['name'])
+        key = b.get('executable', '') + '/' + name
+        times.setdefault(key, []).append(float(b['real_time']))
+
+    return results.get('umpire', {}), times
+
+
+def median(values):
+    s = sorted(values)
+    n = len(s)
+    return s[n // 2] if n % 2 else 0.5 * (s[n // 2 - 1] + s[n // 2])
+
+
+def mann_whitney_p(a, b):
+    """
+    Two-sided p-value of the Mann-Whitney U test, using the normal
+    approximation with a tie correction. Returns 1.0 when there are too few
+    samples for the test to say anything.
+    """
+    n1, n2 = len(a), len(b)
+    if n1 < 2 or n2 < 2:
+        return 1.0
+
+    ranked = sorted([(v, 0) for v in a] + [(v, 1) for v in b])
+    ranks = [0.0] * len(ranked)
+    ties = 0.0
+    i = 0
+    while i < len(ranked):
+        j = i
+        while j + 1 < len(ranked) and ranked[j + 1][0] == ranked[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = 0.5 * (i + j) + 1.0
+        t = j - i + 1
+        ties += t * t * t - t
+        i = j + 1
+
+    r1 = sum(r for r, (_, group) in zip(ranks, ranked) if group == 0)
+    u = r1 - n1 * (n1 + 1) / 2.0
+
+    n = n1 + n2
+    mean = n1 * n2 / 2.0
+    variance = n1 * n2 / 12.0 * ((n + 1) - ties / (n * (n - 1)))
+    if variance <= 0.0:
+        return 1.0
+
+    z = (abs(u - mean) - 0.5) / math.sqrt(variance)
+    return math.erfc(max(z, 0.0) / math.sqrt(2.0))
+
+
+def compare_files(baseline_path, current_path, args):
+    baseline_info, baseline = load_times(baseline_path)
+    current_info, current = load_times(current_path)
+
+    for field in ('host', 'tag'):
+        if baseline_info.get(field) != current_info.get(field):
+            print('Warning: comparing results with different %s (%s vs %s)' % (
+                field, baseline_info.get(field), current_info.get(field)))
+
+    regressions = 0
+    print('%-60s %12s %12s %8s %8s' % (
+        'benchmark', 'baseline', 'current', 'change', 'p'))
+
+    for key in sorted(set(baseline) & set(current)):
+        old = median(baseline[key])
+        new = median(current[key])
+        change = (new - old) / old if old > 0.0 else 0.0
+        p = mann_whitney_p(baseline[key], current[key])
+
+        status = ''
+        if p < args.alpha and change > args.threshold:
+            status = 'SLOWER'
+            regressions += 1
+        elif p < args.alpha and change < -args.threshold:
+            status = 'faster'
+
+        print('%-60s %12.1f %12.1f %+7.1f%% %8.3f %s' % (
+            key[:60], old, new, 100.0 * change, p, status))
+
+    for key in sorted(set(baseline) - set(current)):
+        print('%-60s missing from current results' % key[:60])
+
+    print('%d regression(s) beyond %.0f%% at alpha %.2f' % (
+        regressions, 100.0 * args.threshold, args.alpha))
+
+    return 1 if regressions else 0
+
+
+def compare(args):
+    return compare_files(args.baseline, args.current, args)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--threshold', type=float, default=0.05,
+                        help='relative slowdown of the median to report')
+    parser.add_argument('--alpha', type=float, default=0.05,
+                        help='significance level of the test')
+    commands = parser.add_subparsers(dest='command')
+
+    run_parser = commands.add_parser('run', help='capture results')
+    run_parser.add_argument('--bin-dir', required=True)
+    run_parser.add_argument('--out-dir', required=True)
+    run_parser.add_argument('--source-dir', default=os.path.dirname(
+        os.path.abspath(__file__)))
+    run_parser.add_argument('--host', default=None)
+    run_parser.add_argument('--tag', default='default',
+                            help='compiler and configuration of this build')
+    run_parser.add_argument('--repetitions', type=int, default=10)
+    run_parser.add_argument('--baseline', default=None,
+                            help='results file to compare against')
+    run_parser.add_argument('--benchmark-arg', dest='benchmark_args',
+                            action='append', default=[],
+                            help='extra argument for every executable, '
+                                 'e.g. --benchmark-arg=--benchmark_min_time=0.1')
+    run_parser.add_argument('benchmarks', nargs='+')
+    run_parser.set_defaults(func=run)
+
+    compare_parser = commands.add_parser('compare', help='compare results')
+    compare_parser.add_argument('baseline')
+    compare_parser.add_argument('current')
+    compare_parser.set_defaults(func=compare)
+
+    args = parser.parse_args()
+    if not args.command:
+        parser.print_help()
+        return 2
+
+    return args.func(args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,137 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "umpire/config.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/Allocator.hpp"
+#include "umpire/strategy/DynamicPool.hpp"
+#include "umpire/strategy/FixedPool.hpp"
+#include "umpire/strategy/SizeClassPool.hpp"
+#include "umpire/strategy/ThreadCachingAllocator.hpp"
+
+// Memory Umpire itself uses per live allocation. For each strategy, 10^3 up
+// to 10^max_log10 allocations of block_size bytes are made and written to,
+// and the growth of the resident set size, less the bytes handed out, is
+// reported per allocation. The part of it held by the ResourceManager's
+// AllocationMap is reported separately; the rest is the strategy's own
+// bookkeeping, the slack in its blocks, and for HOST, malloc's headers.
+//
+// The resident set is read from /proc/self/statm, so this only runs on
+// Linux. Freed memory is not always returned to the system, so each
+// strategy is measured on its own, largest count last.
+//
+// usage: bookkeeping_footprint_benchmark [max_log10] [strategy]
+
+static const size_t block_size = 16;
+struct fixed_block { char _[block_size]; };
+
+static size_t residentBytes()
+{
+  std::ifstream statm("/proc/self/statm");
+  size_t pages = 0;
+  size_t resident = 0;
+  statm >> pages >> resident;
+
+  return resident * static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+static umpire::Allocator makeStrategy(const std::string& name)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto host = rm.getAllocator("HOST");
+
+  if (name == "DynamicPool") {
+    return rm.makeAllocator<umpire::strategy::DynamicPool>(name, host);
+  } else if (name == "FixedPool") {
+    return rm.makeAllocator<umpire::strategy::FixedPool<fixed_block>>(name, host);
+  } else if (name == "SizeClassPool") {
+    return rm.makeAllocator<umpire::strategy::SizeClassPool>(name, host);
+  } else if (name == "ThreadCachingAllocator") {
+    return rm.makeAllocator<umpire::strategy::ThreadCachingAllocator>(name, host);
+  }
+
+  return host;
+}
+
+static void measure(umpire::Allocator allocator, size_t count)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  std::vector<void*> ptrs(count);
+
+  const auto map_before = rm.getAllocationMapStatistics();
+  const size_t rss_before = residentBytes();
+
+  for (size_t i = 0; i < count; ++i) {
+    ptrs[i] = allocator.allocate(block_size);
+    std::memset(ptrs[i], 1, block_size);
+  }
+
+  const size_t rss_after = residentBytes();
+  const auto map_after = rm.getAllocationMapStatistics();
+
+  const double user_bytes = static_cast<double>(count * block_size);
+  const double growth = static_cast<double>(rss_after) - static_cast<double>(rss_before);
+  const double map_bytes = static_cast<double>(map_after.num_bytes) - static_cast<double>(map_before.num_bytes);
+
+  std::cout << std::left << std::setw(24) << allocator.getName() << std::right
+    << std::setw(12) << count
+    << std::setw(16) << std::fixed << std::setprecision(1) << growth / (1024*1024)
+    << std::setw(16) << (growth - user_bytes) / count
+    << std::setw(16) << map_bytes / count
+    << std::endl;
+
+  for (auto ptr : ptrs) {
+    allocator.deallocate(ptr);
+  }
+  allocator.release();
+}
+
+int main(int argc, char** argv) {
+  const int max_log10 = argc > 1 ? std::atoi(argv[1]) : 6;
+  const std::string only = argc > 2 ? argv[2] : "";
+
+  const char* strategies[] = {
+    "HOST", "DynamicPool", "FixedPool", "SizeClassPool", "ThreadCachingAllocator"
+  };
+
+  std::cout << std::left << std::setw(24) << "strategy" << std::right
+    << std::setw(12) << "allocations"
+    << std::setw(16) << "RSS growth (MB)"
+    << std::setw(16) << "overhead (B)"
+    << std::setw(16) << "map (B)"
+    << std::endl;
+
+  for (auto name : strategies) {
+    if (!only.empty() && only != name) {
+      continue;
+    }
+
+    auto allocator = makeStrategy(name);
+
+    for (int log10 = 3; log10 <= max_log10; ++log10) {
+      measure(allocator, static_cast<size_t>(std::pow(10.0, log10)));
+    }
+  }
+}
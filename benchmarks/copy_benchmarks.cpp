@@ -12,7 +12,9 @@
 // For details, see https://github.com/LLNL/Umpire
 // Please also see the LICENSE file for MIT license.
 //////////////////////////////////////////////////////////////////////////////
+#include <cstring>
 #include <iostream>
+#include <string>
 
 #include "benchmark/benchmark_api.h"
 
@@ -20,7 +22,25 @@
 
 #include "umpire/ResourceManager.hpp"
 #include "umpire/Allocator.hpp"
+#include "umpire/strategy/DynamicPool.hpp"
 
+#if defined(UMPIRE_ENABLE_CUDA)
+#include <cuda_runtime_api.h>
+#endif
+
+// Sizes are passed as powers of two, from 4B (2^2) to 4GB (2^32), so that
+// they fit in a benchmark argument on every version of the library.
+static const int min_log2_size = 2;
+static const int max_log2_size = 32;
+static const int log2_size_step = 2;
+
+static size_t getSize(benchmark::State& state) {
+  return static_cast<size_t>(1) << state.range(0);
+}
+
+static void setBytesProcessed(benchmark::State& state, size_t size) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(size));
+}
 
 static void benchmark_copy(benchmark::State& state, std::string src, std::string dest) {
   auto& rm = umpire::ResourceManager::getInstance();
@@ -28,32 +48,177 @@ static void benchmark_copy(benchmark::State& state, std::string src, std::string
   auto source_allocator = rm.getAllocator(src);
   auto dest_allocator = rm.getAllocator(dest);
 
-  auto size = state.range(0);
+  auto size = getSize(state);
+
+  void* src_ptr = source_allocator.allocate(size);
+  void* dest_ptr = dest_allocator.allocate(size);
+
+  while (state.KeepRunning()) {
+    rm.copy(dest_ptr, src_ptr);
+  }
+
+  setBytesProcessed(state, size);
+
+  source_allocator.deallocate(src_ptr);
+  dest_allocator.deallocate(dest_ptr);
+}
+
+static void benchmark_copy_known_allocators(benchmark::State& state, std::string src, std::string dest) {
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto source_allocator = rm.getAllocator(src);
+  auto dest_allocator = rm.getAllocator(dest);
+
+  auto size = getSize(state);
 
   void* src_ptr = source_allocator.allocate(size);
   void* dest_ptr = dest_allocator.allocate(size);
 
   while (state.KeepRunning()) {
-    rm.copy(src_ptr, dest_ptr);
+    rm.copy(dest_ptr, dest_allocator, src_ptr, source_allocator, size);
   }
 
+  setBytesProcessed(state, size);
+
   source_allocator.deallocate(src_ptr);
   dest_allocator.deallocate(dest_ptr);
 }
 
-BENCHMARK_CAPTURE(benchmark_copy, host_host, std::string("HOST"), std::string("HOST"))->Range(4, 4096);
+// The same transfer without going through the ResourceManager. The gap
+// between this and benchmark_copy is Umpire's lookup and dispatch cost.
+static void benchmark_raw_copy(benchmark::State& state, std::string src, std::string dest) {
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto source_allocator = rm.getAllocator(src);
+  auto dest_allocator = rm.getAllocator(dest);
+
+  auto size = getSize(state);
+
+  void* src_ptr = source_allocator.allocate(size);
+  void* dest_ptr = dest_allocator.allocate(size);
 
+  while (state.KeepRunning()) {
 #if defined(UMPIRE_ENABLE_CUDA)
-BENCHMARK_CAPTURE(benchmark_copy, host_device, std::string("HOST"), std::string("DEVICE"))->Range(4, 4096);
-BENCHMARK_CAPTURE(benchmark_copy, device_host, std::string("DEVICE"), std::string("HOST"))->Range(4, 4096);
-BENCHMARK_CAPTURE(benchmark_copy, device_device, std::string("DEVICE"), std::string("DEVICE"))->Range(4, 4096);
+    cudaMemcpy(dest_ptr, src_ptr, size, cudaMemcpyDefault);
+#else
+    std::memcpy(dest_ptr, src_ptr, size);
+    benchmark::ClobberMemory();
+#endif
+  }
+
+  setBytesProcessed(state, size);
+
+  source_allocator.deallocate(src_ptr);
+  dest_allocator.deallocate(dest_ptr);
+}
+
+static void benchmark_memset(benchmark::State& state, std::string name) {
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.getAllocator(name);
+
+  auto size = getSize(state);
+
+  void* ptr = allocator.allocate(size);
+
+  while (state.KeepRunning()) {
+    rm.memset(ptr, 0);
+  }
+
+  setBytesProcessed(state, size);
+
+  allocator.deallocate(ptr);
+}
+
+// Alternate between size and twice size, so every iteration either grows
+// or shrinks the allocation. Bytes processed counts the data preserved.
+static void benchmark_reallocate(benchmark::State& state, std::string name) {
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.getAllocator(name);
+
+  auto size = getSize(state);
+
+  void* ptr = allocator.allocate(size);
+  bool grow = true;
+
+  while (state.KeepRunning()) {
+    ptr = rm.reallocate(ptr, grow ? 2*size : size);
+    grow = !grow;
+  }
+
+  setBytesProcessed(state, size);
+
+  allocator.deallocate(ptr);
+}
+
+// Move back and forth between two allocators.
+static void benchmark_move(benchmark::State& state, std::string src, std::string dest) {
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto source_allocator = rm.getAllocator(src);
+  auto dest_allocator = rm.getAllocator(dest);
+
+  auto size = getSize(state);
+
+  void* ptr = source_allocator.allocate(size);
+  bool to_dest = true;
+
+  while (state.KeepRunning()) {
+    ptr = rm.move(ptr, to_dest ? dest_allocator : source_allocator);
+    to_dest = !to_dest;
+  }
+
+  setBytesProcessed(state, size);
+
+  rm.deallocate(ptr);
+}
+
+static void sizes(benchmark::internal::Benchmark* b) {
+  b->DenseRange(min_log2_size, max_log2_size, log2_size_step);
+}
+
+static std::string makePool() {
+  auto& rm = umpire::ResourceManager::getInstance();
+  rm.makeAllocator<umpire::strategy::DynamicPool>("copy_benchmarks_pool", rm.getAllocator("HOST"));
+  return "copy_benchmarks_pool";
+}
+
+static const std::string host_pool = makePool();
+
+BENCHMARK_CAPTURE(benchmark_copy, host_host, std::string("HOST"), std::string("HOST"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_copy_known_allocators, host_host, std::string("HOST"), std::string("HOST"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_raw_copy, host_host, std::string("HOST"), std::string("HOST"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_memset, host, std::string("HOST"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_reallocate, host, std::string("HOST"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_reallocate, host_pool, host_pool)->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_move, host_host_pool, std::string("HOST"), host_pool)->Apply(sizes);
+
+#if defined(UMPIRE_ENABLE_CUDA)
+BENCHMARK_CAPTURE(benchmark_copy, host_device, std::string("HOST"), std::string("DEVICE"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_copy, device_host, std::string("DEVICE"), std::string("HOST"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_copy, device_device, std::string("DEVICE"), std::string("DEVICE"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_copy_known_allocators, host_device, std::string("HOST"), std::string("DEVICE"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_raw_copy, host_device, std::string("HOST"), std::string("DEVICE"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_raw_copy, device_host, std::string("DEVICE"), std::string("HOST"))->Apply(sizes);
+
+BENCHMARK_CAPTURE(benchmark_copy, pinned_device, std::string("PINNED"), std::string("DEVICE"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_copy, device_pinned, std::string("DEVICE"), std::string("PINNED"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_raw_copy, pinned_device, std::string("PINNED"), std::string("DEVICE"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_raw_copy, device_pinned, std::string("DEVICE"), std::string("PINNED"))->Apply(sizes);
+
+BENCHMARK_CAPTURE(benchmark_copy, host_um, std::string("HOST"), std::string("UM"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_copy, um_host, std::string("UM"), std::string("HOST"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_copy, um_um, std::string("UM"), std::string("UM"))->Apply(sizes);
 
-BENCHMARK_CAPTURE(benchmark_copy, host_device, std::string("HOST"), std::string("UM"))->Range(4, 4096);
-BENCHMARK_CAPTURE(benchmark_copy, device_host, std::string("UM"), std::string("HOST"))->Range(4, 4096);
-BENCHMARK_CAPTURE(benchmark_copy, device_device, std::string("UM"), std::string("UM"))->Range(4, 4096);
+BENCHMARK_CAPTURE(benchmark_copy, device_um, std::string("DEVICE"), std::string("UM"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_copy, um_device, std::string("UM"), std::string("DEVICE"))->Apply(sizes);
 
-BENCHMARK_CAPTURE(benchmark_copy, device_device, std::string("DEVICE"), std::string("UM"))->Range(4, 4096);
-BENCHMARK_CAPTURE(benchmark_copy, device_device, std::string("UM"), std::string("DEVICE"))->Range(4, 4096);
+BENCHMARK_CAPTURE(benchmark_memset, device, std::string("DEVICE"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_memset, um, std::string("UM"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_reallocate, device, std::string("DEVICE"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_move, host_device, std::string("HOST"), std::string("DEVICE"))->Apply(sizes);
+BENCHMARK_CAPTURE(benchmark_move, pinned_device, std::string("PINNED"), std::string("DEVICE"))->Apply(sizes);
 #endif
 
 BENCHMARK_MAIN();
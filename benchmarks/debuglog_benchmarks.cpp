@@ -16,15 +16,47 @@
 
 #include "benchmark/benchmark_api.h"
 
+#include "umpire/ResourceManager.hpp"
+#include "umpire/strategy/DynamicPool.hpp"
 #include "umpire/util/Macros.hpp"
 
+/*
+ * Debug messages are disabled at runtime by default, so these measure the
+ * cost of a disabled UMPIRE_LOG. Build with -DLOG_LEVEL_MIN=Error to compare
+ * against the same calls compiled out.
+ */
 static void benchmark_DebugLogger(benchmark::State& state) {
   while (state.KeepRunning()) {
     UMPIRE_LOG(Debug, "(" << 22 << ")");
   }
 }
+
+static void benchmark_HostAllocateDeallocate(benchmark::State& state) {
+  auto allocator = umpire::ResourceManager::getInstance().getAllocator("HOST");
+
+  while (state.KeepRunning()) {
+    void* ptr = allocator.allocate(64);
+    allocator.deallocate(ptr);
+  }
+}
+
+static void benchmark_PoolGetCurrentSize(benchmark::State& state) {
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto allocator = rm.isAllocator("debuglog_pool")
+    ? rm.getAllocator("debuglog_pool")
+    : rm.makeAllocator<umpire::strategy::DynamicPool>(
+        "debuglog_pool", rm.getAllocator("HOST"));
+
+  long size = 0;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(size += allocator.getCurrentSize());
+  }
+}
+
 //
 // Register the function as a benchmark
 BENCHMARK(benchmark_DebugLogger);
+BENCHMARK(benchmark_HostAllocateDeallocate);
+BENCHMARK(benchmark_PoolGetCurrentSize);
 
 BENCHMARK_MAIN();
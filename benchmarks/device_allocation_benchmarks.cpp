@@ -0,0 +1,224 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cuda_runtime_api.h>
+
+#include "benchmark/benchmark_api.h"
+
+#include "umpire/config.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/Allocator.hpp"
+#include "umpire/strategy/CudaStreamPool.hpp"
+#include "umpire/strategy/DynamicPool.hpp"
+
+// Latency of a device allocate and free while other streams are busy, and
+// how often that pair waits for the work on those streams to finish.
+//
+// Before each timed pair, every busy stream is given s_work_bytes of
+// cudaMemsetAsync, which takes far longer than an allocation that does not
+// synchronize. If all of that work is done by the time the pair returns,
+// the pair waited for it; the label reports the fraction of pairs that did.
+// cudaFree synchronizes the device, so raw cudaMalloc and DEVICE are
+// expected to wait on every pair, and the pools and stream-ordered
+// allocators not to.
+//
+// Each benchmark takes two arguments: log2 of the allocation size, and the
+// number of busy streams. The streams are non-blocking, so they do not
+// synchronize with the default stream on their own.
+
+static const size_t s_work_bytes = 256 * 1024 * 1024;
+
+class BusyStreams {
+  public:
+    BusyStreams(int count) :
+      m_streams(count),
+      m_buffers(count)
+    {
+      for (int i = 0; i < count; ++i) {
+        ::cudaStreamCreateWithFlags(&m_streams[i], cudaStreamNonBlocking);
+        ::cudaMalloc(&m_buffers[i], s_work_bytes);
+      }
+    }
+
+    ~BusyStreams()
+    {
+      for (size_t i = 0; i < m_streams.size(); ++i) {
+        ::cudaStreamSynchronize(m_streams[i]);
+        ::cudaFree(m_buffers[i]);
+        ::cudaStreamDestroy(m_streams[i]);
+      }
+    }
+
+    void enqueue()
+    {
+      for (size_t i = 0; i < m_streams.size(); ++i) {
+        ::cudaMemsetAsync(m_buffers[i], static_cast<int>(i), s_work_bytes, m_streams[i]);
+      }
+    }
+
+    bool idle()
+    {
+      for (auto stream : m_streams) {
+        if (::cudaStreamQuery(stream) != cudaSuccess) {
+          return false;
+        }
+      }
+      return !m_streams.empty();
+    }
+
+    void synchronize()
+    {
+      for (auto stream : m_streams) {
+        ::cudaStreamSynchronize(stream);
+      }
+    }
+
+    cudaStream_t stream()
+    {
+      return m_streams.empty() ? 0 : m_streams[0];
+    }
+
+  private:
+    std::vector<cudaStream_t> m_streams;
+    std::vector<void*> m_buffers;
+};
+
+template <typename Allocate, typename Deallocate>
+static void run(benchmark::State& state, BusyStreams& busy, Allocate allocate, Deallocate deallocate)
+{
+  const size_t size = static_cast<size_t>(1) << state.range(0);
+
+  // Warm up, so pools have their memory before timing starts.
+  deallocate(allocate(size));
+  ::cudaDeviceSynchronize();
+
+  long waited = 0;
+
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    busy.enqueue();
+    state.ResumeTiming();
+
+    deallocate(allocate(size));
+
+    state.PauseTiming();
+    if (busy.idle()) {
+      ++waited;
+    }
+    busy.synchronize();
+    state.ResumeTiming();
+  }
+
+  std::ostringstream label;
+  label << "waited " << static_cast<double>(waited) / state.iterations();
+  state.SetLabel(label.str());
+}
+
+static umpire::Allocator getPool(const std::string& name)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  if (!rm.isAllocator(name)) {
+    if (name == "device_latency_stream_pool") {
+      rm.makeAllocator<umpire::strategy::CudaStreamPool>(name, rm.getAllocator("DEVICE"));
+    } else {
+      rm.makeAllocator<umpire::strategy::DynamicPool>(name, rm.getAllocator("DEVICE"));
+    }
+  }
+
+  return rm.getAllocator(name);
+}
+
+static void benchmark_cudaMalloc(benchmark::State& state) {
+  BusyStreams busy(state.range(1));
+
+  run(state, busy,
+      [] (size_t size) { void* ptr = nullptr; ::cudaMalloc(&ptr, size); return ptr; },
+      [] (void* ptr) { ::cudaFree(ptr); });
+}
+
+static void benchmark_Device(benchmark::State& state) {
+  auto allocator = umpire::ResourceManager::getInstance().getAllocator("DEVICE");
+  BusyStreams busy(state.range(1));
+
+  run(state, busy,
+      [&] (size_t size) { return allocator.allocate(size); },
+      [&] (void* ptr) { allocator.deallocate(ptr); });
+}
+
+static void benchmark_DynamicPool(benchmark::State& state) {
+  auto allocator = getPool("device_latency_pool");
+  BusyStreams busy(state.range(1));
+
+  run(state, busy,
+      [&] (size_t size) { return allocator.allocate(size); },
+      [&] (void* ptr) { allocator.deallocate(ptr); });
+}
+
+// Allocates and frees on the first busy stream, the way a kernel launched
+// there would use the memory.
+static void benchmark_CudaStreamPool(benchmark::State& state) {
+  auto allocator = getPool("device_latency_stream_pool");
+  auto pool = std::dynamic_pointer_cast<umpire::strategy::CudaStreamPool>(
+      allocator.getAllocationStrategy());
+  BusyStreams busy(state.range(1));
+  cudaStream_t stream = busy.stream();
+
+  run(state, busy,
+      [&] (size_t size) { return pool->allocate(size, stream); },
+      [&] (void* ptr) { pool->deallocate(ptr, stream); });
+}
+
+static void arguments(benchmark::internal::Benchmark* benchmark) {
+  for (int log2_size = 12; log2_size <= 26; log2_size += 7) {
+    for (int streams = 0; streams <= 4; streams += 4) {
+      benchmark->Args({log2_size, streams});
+    }
+  }
+}
+
+BENCHMARK(benchmark_cudaMalloc)->Apply(arguments);
+BENCHMARK(benchmark_Device)->Apply(arguments);
+BENCHMARK(benchmark_DynamicPool)->Apply(arguments);
+BENCHMARK(benchmark_CudaStreamPool)->Apply(arguments);
+
+#if defined(UMPIRE_ENABLE_CUDA_MALLOC_ASYNC)
+static void benchmark_cudaMallocAsync(benchmark::State& state) {
+  BusyStreams busy(state.range(1));
+  cudaStream_t stream = busy.stream();
+
+  run(state, busy,
+      [&] (size_t size) { void* ptr = nullptr; ::cudaMallocAsync(&ptr, size, stream); return ptr; },
+      [&] (void* ptr) { ::cudaFreeAsync(ptr, stream); });
+}
+
+static void benchmark_DeviceAsync(benchmark::State& state) {
+  auto allocator = umpire::ResourceManager::getInstance().getAllocator("DEVICE_ASYNC");
+  BusyStreams busy(state.range(1));
+
+  run(state, busy,
+      [&] (size_t size) { return allocator.allocate(size); },
+      [&] (void* ptr) { allocator.deallocate(ptr); });
+}
+
+BENCHMARK(benchmark_cudaMallocAsync)->Apply(arguments);
+BENCHMARK(benchmark_DeviceAsync)->Apply(arguments);
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,169 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "umpire/config.hpp"
+#include "umpire/ResourceManager.hpp"
+#include "umpire/Allocator.hpp"
+#include "umpire/alloc/MallocAllocator.hpp"
+#include "umpire/strategy/AllocationAdvisor.hpp"
+#include "umpire/strategy/DynamicPool.hpp"
+#include "umpire/strategy/ThreadSafeAllocator.hpp"
+
+#if defined(UMPIRE_ENABLE_CUDA)
+#include "umpire/alloc/CudaMallocAllocator.hpp"
+#endif
+
+// Cost of each layer of Umpire over the raw allocator, for the same
+// allocate and deallocate pair. Each benchmark adds one layer to the one
+// before it, so the difference in ns between neighbours is that layer:
+//
+//   MallocAllocator         the alloc:: struct, no Umpire bookkeeping
+//   ResourceUntracked       virtual dispatch into the DefaultMemoryResource
+//   Resource                ... plus AllocationMap registration
+//   Allocator               ... plus the Allocator handle
+//   ResourceManager         ... freeing through ResourceManager::deallocate,
+//                           which looks the pointer up first
+//
+// The stack benchmarks wrap HOST in 1 to 3 layers of one strategy, given
+// as the argument. The cost of a disabled UMPIRE_LOG is measured on its own
+// by debuglog_benchmarks.
+
+static const std::size_t size = 64;
+
+static umpire::Allocator getStack(const std::string& kind, const std::string& base, int depth)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  std::string name = base;
+
+  for (int level = 1; level <= depth; ++level) {
+    const std::string next = "layering_" + kind + "_" + base + "_" + std::to_string(level);
+
+    if (!rm.isAllocator(next)) {
+      auto allocator = rm.getAllocator(name);
+
+      if (kind == "ThreadSafe") {
+        rm.makeAllocator<umpire::strategy::ThreadSafeAllocator>(next, allocator);
+      } else if (kind == "Pool") {
+        rm.makeAllocator<umpire::strategy::DynamicPool>(next, allocator, 1024*1024, 1024*1024);
+      } else {
+        rm.makeAllocator<umpire::strategy::AllocationAdvisor>(next, allocator, "READ_MOSTLY");
+      }
+    }
+
+    name = next;
+  }
+
+  return rm.getAllocator(name);
+}
+
+static void runAllocator(benchmark::State& state, umpire::Allocator allocator)
+{
+  while (state.KeepRunning()) {
+    void* ptr = allocator.allocate(size);
+    benchmark::DoNotOptimize(ptr);
+    allocator.deallocate(ptr);
+  }
+}
+
+static void benchmark_MallocAllocator(benchmark::State& state) {
+  umpire::alloc::MallocAllocator allocator;
+
+  while (state.KeepRunning()) {
+    void* ptr = allocator.allocate(size);
+    benchmark::DoNotOptimize(ptr);
+    allocator.deallocate(ptr);
+  }
+}
+
+static void benchmark_ResourceUntracked(benchmark::State& state) {
+  auto strategy = umpire::ResourceManager::getInstance().getAllocator("HOST").getAllocationStrategy();
+
+  while (state.KeepRunning()) {
+    void* ptr = strategy->allocateUntracked(size);
+    benchmark::DoNotOptimize(ptr);
+    strategy->deallocateUntracked(ptr, size);
+  }
+}
+
+static void benchmark_Resource(benchmark::State& state) {
+  auto strategy = umpire::ResourceManager::getInstance().getAllocator("HOST").getAllocationStrategy();
+
+  while (state.KeepRunning()) {
+    void* ptr = strategy->allocate(size);
+    benchmark::DoNotOptimize(ptr);
+    strategy->deallocate(ptr);
+  }
+}
+
+static void benchmark_Allocator(benchmark::State& state) {
+  runAllocator(state, umpire::ResourceManager::getInstance().getAllocator("HOST"));
+}
+
+static void benchmark_ResourceManager(benchmark::State& state) {
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto allocator = rm.getAllocator("HOST");
+
+  while (state.KeepRunning()) {
+    void* ptr = allocator.allocate(size);
+    benchmark::DoNotOptimize(ptr);
+    rm.deallocate(ptr);
+  }
+}
+
+static void benchmark_ThreadSafeStack(benchmark::State& state) {
+  runAllocator(state, getStack("ThreadSafe", "HOST", state.range(0)));
+}
+
+static void benchmark_PoolStack(benchmark::State& state) {
+  runAllocator(state, getStack("Pool", "HOST", state.range(0)));
+}
+
+BENCHMARK(benchmark_MallocAllocator);
+BENCHMARK(benchmark_ResourceUntracked);
+BENCHMARK(benchmark_Resource);
+BENCHMARK(benchmark_Allocator);
+BENCHMARK(benchmark_ResourceManager);
+BENCHMARK(benchmark_ThreadSafeStack)->DenseRange(1, 3);
+BENCHMARK(benchmark_PoolStack)->DenseRange(1, 3);
+
+#if defined(UMPIRE_ENABLE_CUDA)
+static void benchmark_CudaMallocAllocator(benchmark::State& state) {
+  umpire::alloc::CudaMallocAllocator allocator;
+
+  while (state.KeepRunning()) {
+    void* ptr = allocator.allocate(size);
+    benchmark::DoNotOptimize(ptr);
+    allocator.deallocate(ptr);
+  }
+}
+
+static void benchmark_DeviceAllocator(benchmark::State& state) {
+  runAllocator(state, umpire::ResourceManager::getInstance().getAllocator("DEVICE"));
+}
+
+// Advice needs memory that can be advised, so the advisors wrap UM.
+static void benchmark_AdvisorStack(benchmark::State& state) {
+  runAllocator(state, getStack("Advisor", "UM", state.range(0)));
+}
+
+BENCHMARK(benchmark_CudaMallocAllocator);
+BENCHMARK(benchmark_DeviceAllocator);
+BENCHMARK(benchmark_AdvisorStack)->DenseRange(0, 3);
+#endif
+
+BENCHMARK_MAIN();
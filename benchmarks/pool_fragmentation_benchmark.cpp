@@ -0,0 +1,248 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "umpire/config.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/Allocator.hpp"
+#include "umpire/strategy/DynamicPool.hpp"
+#include "umpire/strategy/FixedPool.hpp"
+#include "umpire/strategy/SizeClassPool.hpp"
+
+// A long-running, seeded workload that models a simulation's allocation
+// pattern: mixed sizes, lognormal lifetimes and alternating phases of
+// growth and shrinkage. It reports allocation latency percentiles and,
+// sampled through the run, how far the pool's footprint (getActualSize) is
+// above what is handed out (getCurrentSize) and how fragmented its free
+// memory is.
+//
+// usage: pool_fragmentation_benchmark [steps] [seed]
+
+static const size_t fixed_block_size = 256;
+struct fixed_block { char _[fixed_block_size]; };
+
+struct Phase {
+  const char* name;
+  double allocate_probability;
+  double lifetime_mu;
+};
+
+// The run is divided into equal phases of steps. Each step frees every
+// allocation whose lifetime has ended, then allocates with the phase's
+// probability. Lifetimes are lognormal, measured in steps, so the live set
+// tends to allocate_probability * E[lifetime] blocks: phases that raise it
+// grow the pool and phases that lower it leave freed holes behind
+// allocations that outlive them.
+static const Phase phases[] = {
+  {"grow",    0.70, 8.5},
+  {"steady",  0.50, 8.0},
+  {"shrink",  0.20, 6.0},
+  {"burst",   0.90, 5.0},
+  {"steady",  0.50, 8.0},
+  {"shrink",  0.20, 6.0},
+  {"grow",    0.70, 8.5},
+  {"drain",   0.05, 4.0}
+};
+static const double lifetime_sigma = 1.5;
+static const int samples_per_phase = 4;
+
+class Workload {
+  public:
+    Workload(unsigned int seed, bool fixed_size) :
+      m_gen(seed),
+      m_fixed_size(fixed_size)
+    {
+    }
+
+    // 80% small, 19% medium, 1% large.
+    size_t size() {
+      if (m_fixed_size) {
+        return fixed_block_size;
+      }
+
+      const double kind = m_uniform(m_gen);
+      if (kind < 0.80) {
+        return std::uniform_int_distribution<size_t>(16, 1024)(m_gen);
+      } else if (kind < 0.99) {
+        return std::uniform_int_distribution<size_t>(1024, 64*1024)(m_gen);
+      } else {
+        return std::uniform_int_distribution<size_t>(64*1024, 1024*1024)(m_gen);
+      }
+    }
+
+    double lifetime(const Phase& phase) {
+      return std::lognormal_distribution<double>(phase.lifetime_mu, lifetime_sigma)(m_gen);
+    }
+
+    bool allocate(const Phase& phase) {
+      return m_uniform(m_gen) < phase.allocate_probability;
+    }
+
+  private:
+    std::mt19937_64 m_gen;
+    std::uniform_real_distribution<double> m_uniform;
+    bool m_fixed_size;
+};
+
+static double getFragmentation(umpire::Allocator& allocator) {
+  auto strategy = allocator.getAllocationStrategy();
+
+  if (auto pool = std::dynamic_pointer_cast<umpire::strategy::DynamicPool>(strategy)) {
+    return pool->getFragmentation();
+  }
+
+  if (auto pool = std::dynamic_pointer_cast<umpire::strategy::FixedPool<fixed_block>>(strategy)) {
+    return pool->getFragmentation();
+  }
+
+  return std::nan("");
+}
+
+static uint64_t percentile(std::vector<uint64_t>& sorted, double p) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  size_t index = static_cast<size_t>(p * (sorted.size() - 1));
+  return sorted[index];
+}
+
+void benchmark_pool(std::string name, size_t steps, unsigned int seed, bool fixed_size) {
+  typedef std::pair<double, void*> Death;
+
+  auto& rm = umpire::ResourceManager::getInstance();
+  umpire::Allocator alloc = rm.getAllocator(name);
+
+  Workload workload(seed, fixed_size);
+
+  std::priority_queue<Death, std::vector<Death>, std::greater<Death>> live;
+  std::vector<uint64_t> alloc_ns;
+  std::vector<uint64_t> dealloc_ns;
+  alloc_ns.reserve(steps);
+  dealloc_ns.reserve(steps);
+
+  const size_t num_phases = sizeof(phases)/sizeof(phases[0]);
+  const size_t phase_length = std::max<size_t>(steps / num_phases, 1);
+  const size_t sample_every = std::max<size_t>(phase_length / samples_per_phase, 1);
+
+  std::cout << name << std::endl;
+  std::cout << "    " << std::setw(10) << "step"
+    << std::setw(8) << "phase"
+    << std::setw(10) << "live"
+    << std::setw(14) << "current"
+    << std::setw(14) << "actual"
+    << std::setw(12) << "overhead"
+    << std::setw(8) << "frag" << std::endl;
+
+  for (size_t op = 0; op < steps; ++op) {
+    const Phase& phase = phases[std::min(op / phase_length, num_phases - 1)];
+
+    while (!live.empty() && live.top().first <= op) {
+      void* ptr = live.top().second;
+      live.pop();
+
+      auto begin = std::chrono::steady_clock::now();
+      alloc.deallocate(ptr);
+      auto end = std::chrono::steady_clock::now();
+
+      dealloc_ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+    }
+
+    if (workload.allocate(phase)) {
+      const size_t size = workload.size();
+
+      auto begin = std::chrono::steady_clock::now();
+      void* ptr = alloc.allocate(size);
+      auto end = std::chrono::steady_clock::now();
+
+      alloc_ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+      live.push(Death(op + workload.lifetime(phase), ptr));
+    }
+
+    if ((op + 1) % sample_every == 0) {
+      const long current = alloc.getCurrentSize();
+      const long actual = alloc.getActualSize();
+
+      std::cout << "    " << std::setw(10) << op + 1
+        << std::setw(8) << phase.name
+        << std::setw(10) << live.size()
+        << std::setw(14) << current
+        << std::setw(14) << actual
+        << std::setw(12) << std::fixed << std::setprecision(2)
+        << (current > 0 ? static_cast<double>(actual) / current : 0.0)
+        << std::setw(8) << getFragmentation(alloc) << std::endl;
+    }
+  }
+
+  while (!live.empty()) {
+    alloc.deallocate(live.top().second);
+    live.pop();
+  }
+
+  std::sort(alloc_ns.begin(), alloc_ns.end());
+  std::sort(dealloc_ns.begin(), dealloc_ns.end());
+
+  std::cout << "    alloc ns   p50: " << percentile(alloc_ns, 0.50)
+    << " p90: " << percentile(alloc_ns, 0.90)
+    << " p99: " << percentile(alloc_ns, 0.99)
+    << " p99.9: " << percentile(alloc_ns, 0.999)
+    << " max: " << percentile(alloc_ns, 1.0) << std::endl;
+  std::cout << "    dealloc ns p50: " << percentile(dealloc_ns, 0.50)
+    << " p90: " << percentile(dealloc_ns, 0.90)
+    << " p99: " << percentile(dealloc_ns, 0.99)
+    << " p99.9: " << percentile(dealloc_ns, 0.999)
+    << " max: " << percentile(dealloc_ns, 1.0) << std::endl;
+  std::cout << "    high watermark: " << alloc.getHighWatermark() << std::endl;
+}
+
+int main(int argc, char** argv) {
+  const size_t steps = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+  const unsigned int seed = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 12345678;
+
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto host = rm.getAllocator("HOST");
+
+  rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "dynamic_pool_best_fit", host, 64*1024*1024, 1024*1024,
+      umpire::PlacementPolicy::best_fit);
+  rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "dynamic_pool_first_fit", host, 64*1024*1024, 1024*1024,
+      umpire::PlacementPolicy::first_fit);
+  rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "dynamic_pool_segregated_fit", host, 64*1024*1024, 1024*1024,
+      umpire::PlacementPolicy::segregated_fit);
+  rm.makeAllocator<umpire::strategy::SizeClassPool>("size_class_pool", host);
+  rm.makeAllocator<umpire::strategy::FixedPool<fixed_block>>("fixed_pool", host);
+
+  benchmark_pool("dynamic_pool_best_fit", steps, seed, false);
+  benchmark_pool("dynamic_pool_first_fit", steps, seed, false);
+  benchmark_pool("dynamic_pool_segregated_fit", steps, seed, false);
+  benchmark_pool("size_class_pool", steps, seed, false);
+
+  // FixedPool serves one block size, so it runs the same phases and
+  // lifetimes with every request of fixed_block_size bytes.
+  benchmark_pool("fixed_pool", steps, seed, true);
+}
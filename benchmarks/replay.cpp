@@ -0,0 +1,257 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Replay the allocations recorded in a binary trace (see ENABLE_TRACE)
+ * against a stack of strategies, and report latency and memory use.
+ *
+ *   replay <trace file> [-n <allocator>] [resource] [strategy...]
+ *
+ * Events recorded by the allocator named with -n are replayed (by default,
+ * the one with the most allocations) in timestamp order on a single thread.
+ * Each strategy is layered on top of the previous one, starting from
+ * resource (HOST by default), e.g.
+ *
+ *   replay umpire.1234.trace HOST DynamicPool ThreadCachingAllocator
+ *
+ * Copies between two live replayed allocations are replayed too.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "umpire/config.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/Allocator.hpp"
+
+#include "umpire/strategy/DynamicPool.hpp"
+#include "umpire/strategy/SizeClassPool.hpp"
+#include "umpire/strategy/ThreadCachingAllocator.hpp"
+#include "umpire/strategy/ThreadSafeAllocator.hpp"
+
+#include "umpire/util/Exception.hpp"
+#include "umpire/util/Tracer.hpp"
+
+namespace {
+
+using umpire::util::trace::Record;
+
+umpire::Allocator makeStrategy(
+    const std::string& strategy,
+    const std::string& name,
+    umpire::Allocator allocator)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  if (strategy == "DynamicPool") {
+    return rm.makeAllocator<umpire::strategy::DynamicPool>(name, allocator);
+  } else if (strategy == "SizeClassPool") {
+    return rm.makeAllocator<umpire::strategy::SizeClassPool>(name, allocator);
+  } else if (strategy == "ThreadCachingAllocator") {
+    return rm.makeAllocator<umpire::strategy::ThreadCachingAllocator>(name, allocator);
+  } else if (strategy == "ThreadSafeAllocator") {
+    return rm.makeAllocator<umpire::strategy::ThreadSafeAllocator>(name, allocator);
+  }
+
+  std::cerr << "Unknown strategy " << strategy
+    << " (expected DynamicPool, SizeClassPool, ThreadCachingAllocator or ThreadSafeAllocator)"
+    << std::endl;
+  std::exit(1);
+}
+
+struct Timer {
+  double total;
+  std::size_t count;
+
+  void print(const std::string& label) const {
+    std::cout << "    " << label << ": " << count << " calls, "
+      << (count ? total/count : 0.0) * 1.0e9 << " ns/call" << std::endl;
+  }
+};
+
+} // end of anonymous namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0]
+      << " <trace file> [-n <allocator>] [resource] [strategy...]" << std::endl;
+    return 1;
+  }
+
+  std::string replay_name;
+  std::vector<std::string> stack;
+
+  for (int i = 2; i < argc; ++i) {
+    const std::string arg(argv[i]);
+
+    if (arg == "-n" && i + 1 < argc) {
+      replay_name = argv[++i];
+    } else {
+      stack.push_back(arg);
+    }
+  }
+
+  if (stack.empty()) {
+    stack.push_back("HOST");
+  }
+
+  // A build that can read traces also writes them; keep the replay's own
+  // events from overwriting the trace being replayed.
+  setenv("UMPIRE_TRACE_FILE", "/dev/null", 1);
+
+  std::vector<std::string> names;
+  std::vector<Record> records;
+
+  try {
+    umpire::util::Tracer::readTrace(argv[1], names, records);
+  } catch (umpire::util::Exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  std::stable_sort(records.begin(), records.end(),
+      [] (const Record& a, const Record& b) { return a.timestamp < b.timestamp; });
+
+  if (replay_name.empty()) {
+    std::map<uint32_t, std::size_t> allocations;
+    for (const auto& record : records) {
+      if (record.event == umpire::util::trace::allocate) {
+        ++allocations[record.name];
+      }
+    }
+
+    auto most = std::max_element(allocations.begin(), allocations.end(),
+        [] (const std::pair<const uint32_t, std::size_t>& a,
+            const std::pair<const uint32_t, std::size_t>& b) { return a.second < b.second; });
+
+    if (most == allocations.end()) {
+      std::cerr << argv[1] << " contains no allocations" << std::endl;
+      return 1;
+    }
+
+    replay_name = names[most->first];
+  }
+
+  auto name_id = std::find(names.begin(), names.end(), replay_name);
+
+  if (name_id == names.end()) {
+    std::cerr << argv[1] << " contains no events for " << replay_name << std::endl;
+    return 1;
+  }
+
+  const uint32_t replay_id = static_cast<uint32_t>(name_id - names.begin());
+
+  auto& rm = umpire::ResourceManager::getInstance();
+  umpire::Allocator allocator = rm.getAllocator(stack[0]);
+
+  for (std::size_t i = 1; i < stack.size(); ++i) {
+    allocator = makeStrategy(stack[i], "replay_" + std::to_string(i), allocator);
+  }
+
+  std::unordered_map<uint64_t, void*> pointers;
+
+  Timer allocate = {0.0, 0};
+  Timer deallocate = {0.0, 0};
+  Timer copy = {0.0, 0};
+
+  std::size_t peak_actual_size = 0;
+  std::size_t peak_current_size = 0;
+  std::size_t skipped = 0;
+  uint64_t last_deallocated = 0;
+
+  for (const auto& record : records) {
+    if (record.name != replay_id) {
+      // Copies are recorded under the name of the operation.
+      if (record.event != umpire::util::trace::copy) {
+        continue;
+      }
+
+      auto src = pointers.find(record.ptr);
+      auto dst = pointers.find(record.dst_ptr);
+
+      if (src == pointers.end() || dst == pointers.end()) {
+        continue;
+      }
+
+      auto begin = std::chrono::steady_clock::now();
+      rm.copy(dst->second, src->second, record.size);
+      copy.total += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+      ++copy.count;
+    } else if (record.event == umpire::util::trace::allocate) {
+      // Resources record their allocations under the same name as their
+      // Allocator, so the same allocation may appear twice.
+      if (pointers.count(record.ptr)) {
+        continue;
+      }
+
+      auto begin = std::chrono::steady_clock::now();
+      void* ptr = allocator.allocate(record.size);
+      allocate.total += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+      ++allocate.count;
+
+      pointers[record.ptr] = ptr;
+
+      peak_actual_size = std::max(peak_actual_size, allocator.getActualSize());
+      peak_current_size = std::max(peak_current_size, allocator.getCurrentSize());
+    } else if (record.event == umpire::util::trace::deallocate) {
+      auto ptr = pointers.find(record.ptr);
+
+      if (ptr == pointers.end()) {
+        if (record.ptr != last_deallocated) {
+          ++skipped;
+        }
+        continue;
+      }
+
+      auto begin = std::chrono::steady_clock::now();
+      allocator.deallocate(ptr->second);
+      deallocate.total += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+      ++deallocate.count;
+
+      pointers.erase(ptr);
+      last_deallocated = record.ptr;
+    }
+  }
+
+  std::cout << "Replayed " << replay_name << " on";
+  for (const auto& layer : stack) {
+    std::cout << " " << layer;
+  }
+  std::cout << std::endl;
+
+  allocate.print("allocate");
+  deallocate.print("deallocate");
+  copy.print("copy");
+
+  std::cout << "    peak current size: " << peak_current_size << std::endl;
+  std::cout << "    peak actual size: " << peak_actual_size << std::endl;
+  std::cout << "    overhead at peak: "
+    << (peak_current_size ? static_cast<double>(peak_actual_size) / peak_current_size : 0.0)
+    << "x" << std::endl;
+  std::cout << "    live at end: " << pointers.size()
+    << ", unmatched deallocations: " << skipped << std::endl;
+
+  for (auto& ptr : pointers) {
+    allocator.deallocate(ptr.second);
+  }
+
+  return 0;
+}
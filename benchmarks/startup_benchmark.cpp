@@ -0,0 +1,120 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "umpire/config.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/Allocator.hpp"
+#include "umpire/strategy/DynamicPool.hpp"
+
+// Cold-start cost of a process that uses Umpire: constructing the
+// ResourceManager, making each resource and its first allocation, and
+// building pools. Everything is done once, so each run of the program is one
+// sample; run it several times, e.g. once per rank of a short MPI job.
+//
+// Resources are made in the order getAvailableAllocators lists them, so the
+// first CUDA resource also pays for creating the CUDA context. Resources
+// that cannot allocate here, such as those for external memory, are listed
+// without an allocation time.
+//
+// usage: startup_benchmark [pools] [pool_initial_size]
+
+typedef std::chrono::steady_clock Clock;
+
+static double microseconds(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+static void report(const std::string& name, double create, double allocate, bool allocated)
+{
+  std::cout << std::left << std::setw(28) << name << std::right
+    << std::setw(14) << std::fixed << std::setprecision(1) << create;
+
+  if (allocated) {
+    std::cout << std::setw(14) << allocate;
+  } else {
+    std::cout << std::setw(14) << "-";
+  }
+
+  std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+  const int pools = argc > 1 ? std::atoi(argv[1]) : 16;
+  const size_t pool_initial_size = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64*1024*1024;
+
+  const auto program_start = Clock::now();
+
+  auto start = Clock::now();
+  auto& rm = umpire::ResourceManager::getInstance();
+  const double get_instance = microseconds(start);
+
+  std::cout << std::left << std::setw(28) << "step" << std::right
+    << std::setw(14) << "create (us)" << std::setw(14) << "first (us)" << std::endl;
+
+  report("getInstance", get_instance, 0.0, false);
+
+  for (auto& name : rm.getAvailableAllocators()) {
+    start = Clock::now();
+    auto allocator = rm.getAllocator(name);
+    const double create = microseconds(start);
+
+    double allocate = 0.0;
+    bool allocated = false;
+
+    try {
+      start = Clock::now();
+      void* ptr = allocator.allocate(4096);
+      allocator.deallocate(ptr);
+      allocate = microseconds(start);
+      allocated = true;
+    } catch (...) {
+    }
+
+    report(name, create, allocate, allocated);
+  }
+
+  // DynamicPool takes its first chunk on the first allocation, so that is
+  // where min_initial_alloc_size is paid for.
+  auto host = rm.getAllocator("HOST");
+  double create_total = 0.0;
+  double allocate_total = 0.0;
+
+  for (int i = 0; i < pools; ++i) {
+    start = Clock::now();
+    auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+        "startup_pool_" + std::to_string(i), host, pool_initial_size);
+    create_total += microseconds(start);
+
+    start = Clock::now();
+    void* ptr = pool.allocate(4096);
+    pool.deallocate(ptr);
+    allocate_total += microseconds(start);
+  }
+
+  if (pools > 0) {
+    report("DynamicPool (mean of " + std::to_string(pools) + ")",
+        create_total / pools, allocate_total / pools, true);
+  }
+
+  report("total", microseconds(program_start), 0.0, false);
+}
@@ -0,0 +1,209 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include <sys/resource.h>
+
+#include <cuda_runtime_api.h>
+
+#include "benchmark/benchmark_api.h"
+
+#include "umpire/config.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/Allocator.hpp"
+#include "umpire/strategy/AllocationAdvisor.hpp"
+
+// Cost of CPU and GPU access patterns on unified memory under each
+// AllocationAdvisor, to help choose the advice for an array.
+//
+// The GPU side of each pattern uses runtime calls that run on the device
+// rather than kernels of our own: cudaMemset writes every page, and a
+// cudaMemcpy into a DEVICE buffer reads every page. The CPU side writes
+// with memset and reads one word per cache line. Each iteration runs the
+// pattern once and synchronizes, so its time includes the page faults and
+// migrations the pattern causes.
+//
+// The label gives the number of CPU page faults per iteration, from
+// getrusage. GPU faults and migrations are not visible to the runtime API;
+// run under nsys with --cuda-um-gpu-page-faults=true to see them.
+//
+// Each benchmark takes log2 of the array size as its argument.
+
+static const char* s_advice[] = {
+  "none",
+  "READ_MOSTLY",
+  "PREFERRED_LOCATION_DEVICE",
+  "PREFERRED_LOCATION_HOST",
+  "ACCESSED_BY_DEVICE",
+  "ACCESSED_BY_HOST",
+  "PREFETCH"
+};
+
+static umpire::Allocator getAdvised(const std::string& advice)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  if (advice == "none") {
+    return rm.getAllocator("UM");
+  }
+
+  const std::string name = "um_advice_" + advice;
+
+  if (!rm.isAllocator(name)) {
+    const bool host = advice.size() > 5 && advice.compare(advice.size() - 5, 5, "_HOST") == 0;
+    const std::string operation = advice.substr(0, advice.rfind(host ? "_HOST" : "_DEVICE"));
+
+    if (host) {
+      rm.makeAllocator<umpire::strategy::AllocationAdvisor>(
+          name, rm.getAllocator("UM"), operation, rm.getAllocator("HOST"));
+    } else {
+      rm.makeAllocator<umpire::strategy::AllocationAdvisor>(
+          name, rm.getAllocator("UM"), operation);
+    }
+  }
+
+  return rm.getAllocator(name);
+}
+
+static long cpuFaults()
+{
+  struct rusage usage;
+  ::getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_minflt + usage.ru_majflt;
+}
+
+struct Arrays {
+  char* data;
+  void* device;
+  size_t size;
+  int value;
+
+  void gpuWrite() {
+    ::cudaMemset(data, ++value, size);
+    ::cudaDeviceSynchronize();
+  }
+
+  void gpuRead() {
+    ::cudaMemcpy(device, data, size, cudaMemcpyDefault);
+  }
+
+  void cpuWrite() {
+    std::memset(data, ++value, size);
+  }
+
+  void cpuRead() {
+    long sum = 0;
+    for (size_t i = 0; i < size; i += 64) {
+      sum += data[i];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+};
+
+template <typename Setup, typename Pattern>
+static void run(benchmark::State& state, const std::string& advice, Setup setup, Pattern pattern)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto allocator = getAdvised(advice);
+  auto device = rm.getAllocator("DEVICE");
+
+  Arrays arrays;
+  arrays.size = static_cast<size_t>(1) << state.range(0);
+  arrays.data = static_cast<char*>(allocator.allocate(arrays.size));
+  arrays.device = device.allocate(arrays.size);
+  arrays.value = 0;
+
+  setup(arrays);
+  ::cudaDeviceSynchronize();
+
+  const long faults = cpuFaults();
+
+  while (state.KeepRunning()) {
+    pattern(arrays);
+  }
+
+  std::ostringstream label;
+  label << "cpu faults/iter "
+    << static_cast<double>(cpuFaults() - faults) / state.iterations();
+  state.SetLabel(label.str());
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(arrays.size));
+
+  device.deallocate(arrays.device);
+  allocator.deallocate(arrays.data);
+}
+
+// Initialized once on the host, then only read by the GPU, e.g. tables
+// and coefficients.
+static void benchmark_cpu_init_gpu_read(benchmark::State& state, std::string advice) {
+  run(state, advice,
+      [] (Arrays& a) { a.cpuWrite(); },
+      [] (Arrays& a) { a.gpuRead(); });
+}
+
+// Read by both sides every step once initialized.
+static void benchmark_shared_read(benchmark::State& state, std::string advice) {
+  run(state, advice,
+      [] (Arrays& a) { a.cpuWrite(); },
+      [] (Arrays& a) { a.gpuRead(); a.cpuRead(); });
+}
+
+// Written on the GPU every step and read back on the host, e.g. results
+// that are checked or output.
+static void benchmark_gpu_write_cpu_read(benchmark::State& state, std::string advice) {
+  run(state, advice,
+      [] (Arrays&) {},
+      [] (Arrays& a) { a.gpuWrite(); a.cpuRead(); });
+}
+
+// Updated on the host, then used on the GPU, every step.
+static void benchmark_ping_pong(benchmark::State& state, std::string advice) {
+  run(state, advice,
+      [] (Arrays&) {},
+      [] (Arrays& a) { a.cpuWrite(); a.gpuRead(); });
+}
+
+// Only touched by the GPU after a host initialization.
+static void benchmark_gpu_resident(benchmark::State& state, std::string advice) {
+  run(state, advice,
+      [] (Arrays& a) { a.cpuWrite(); },
+      [] (Arrays& a) { a.gpuWrite(); a.gpuRead(); });
+}
+
+static void sizes(benchmark::internal::Benchmark* benchmark) {
+  for (int log2_size = 20; log2_size <= 28; log2_size += 4) {
+    benchmark->Arg(log2_size);
+  }
+  benchmark->UseRealTime();
+}
+
+#define ADVICE_BENCHMARKS(pattern) \
+  BENCHMARK_CAPTURE(pattern, none, std::string(s_advice[0]))->Apply(sizes); \
+  BENCHMARK_CAPTURE(pattern, read_mostly, std::string(s_advice[1]))->Apply(sizes); \
+  BENCHMARK_CAPTURE(pattern, preferred_device, std::string(s_advice[2]))->Apply(sizes); \
+  BENCHMARK_CAPTURE(pattern, preferred_host, std::string(s_advice[3]))->Apply(sizes); \
+  BENCHMARK_CAPTURE(pattern, accessed_by_device, std::string(s_advice[4]))->Apply(sizes); \
+  BENCHMARK_CAPTURE(pattern, accessed_by_host, std::string(s_advice[5]))->Apply(sizes); \
+  BENCHMARK_CAPTURE(pattern, prefetch, std::string(s_advice[6]))->Apply(sizes)
+
+ADVICE_BENCHMARKS(benchmark_cpu_init_gpu_read);
+ADVICE_BENCHMARKS(benchmark_shared_read);
+ADVICE_BENCHMARKS(benchmark_gpu_write_cpu_read);
+ADVICE_BENCHMARKS(benchmark_ping_pong);
+ADVICE_BENCHMARKS(benchmark_gpu_resident);
+
+BENCHMARK_MAIN();
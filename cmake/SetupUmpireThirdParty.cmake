@@ -23,6 +23,103 @@ if (EXISTS ${SHROUD_EXECUTABLE})
   include(${CMAKE_CURRENT_BINARY_DIR}/SetupShroud.cmake)
 endif ()
 
+if (ENABLE_CUDA)
+  if (NOT CUDA_VERSION VERSION_LESS 11.2)
+    set(ENABLE_CUDA_MALLOC_ASYNC On)
+  else ()
+    message(STATUS "CUDA ${CUDA_VERSION} does not provide cudaMallocAsync, DEVICE_ASYNC is disabled")
+  endif ()
+endif ()
+
+if (ENABLE_GDS)
+  if (NOT ENABLE_CUDA)
+    message(FATAL_ERROR "ENABLE_GDS requires ENABLE_CUDA")
+  endif ()
+
+  find_library( CUFILE_LIBRARY
+    cufile
+    PATHS ${CUFILE_LIBRARY_PATH} ${CUDA_TOOLKIT_ROOT_DIR}/lib64 ${CUDA_TOOLKIT_ROOT_DIR}/lib
+  )
+
+  if (NOT CUFILE_LIBRARY)
+    message(FATAL_ERROR "Could not find libcufile, make sure CUFILE_LIBRARY_PATH is set properly")
+  endif()
+
+  find_path( CUFILE_INCLUDE_DIR
+    cufile.h
+    PATHS ${CUFILE_INCLUDE_PATH} ${CUDA_TOOLKIT_ROOT_DIR}/include
+  )
+
+  if (NOT CUFILE_INCLUDE_DIR)
+    message(FATAL_ERROR "Could not find cufile.h, make sure CUFILE_INCLUDE_PATH is set properly")
+  endif()
+
+  blt_register_library( NAME cufile
+                        INCLUDES ${CUFILE_INCLUDE_DIR}
+                        LIBRARIES ${CUFILE_LIBRARY}
+                      )
+endif ()
+
+if (ENABLE_NVCOMP)
+  if (NOT ENABLE_CUDA)
+    message(FATAL_ERROR "ENABLE_NVCOMP requires ENABLE_CUDA")
+  endif ()
+
+  find_library( NVCOMP_LIBRARY
+    nvcomp
+    PATHS ${NVCOMP_LIBRARY_PATH} ${CUDA_TOOLKIT_ROOT_DIR}/lib64 ${CUDA_TOOLKIT_ROOT_DIR}/lib
+  )
+
+  if (NOT NVCOMP_LIBRARY)
+    message(FATAL_ERROR "Could not find libnvcomp, make sure NVCOMP_LIBRARY_PATH is set properly")
+  endif()
+
+  find_path( NVCOMP_INCLUDE_DIR
+    nvcomp/lz4.h
+    PATHS ${NVCOMP_INCLUDE_PATH} ${CUDA_TOOLKIT_ROOT_DIR}/include
+  )
+
+  if (NOT NVCOMP_INCLUDE_DIR)
+    message(FATAL_ERROR "Could not find nvcomp/lz4.h, make sure NVCOMP_INCLUDE_PATH is set properly")
+  endif()
+
+  find_library( LZ4_LIBRARY
+    lz4
+    PATHS ${LZ4_LIBRARY_PATH}
+  )
+
+  find_path( LZ4_INCLUDE_DIR
+    lz4.h
+    PATHS ${LZ4_INCLUDE_PATH}
+  )
+
+  if (NOT LZ4_LIBRARY OR NOT LZ4_INCLUDE_DIR)
+    message(FATAL_ERROR "Could not find liblz4, make sure LZ4_LIBRARY_PATH and LZ4_INCLUDE_PATH are set properly")
+  endif()
+
+  blt_register_library( NAME nvcomp
+                        INCLUDES ${NVCOMP_INCLUDE_DIR} ${LZ4_INCLUDE_DIR}
+                        LIBRARIES ${NVCOMP_LIBRARY} ${LZ4_LIBRARY}
+                      )
+endif ()
+
+if (ENABLE_HIP)
+  if (ENABLE_CUDA)
+    message(FATAL_ERROR "ENABLE_HIP and ENABLE_CUDA both provide the DEVICE, UM and PINNED resources, enable only one")
+  endif ()
+
+  find_package(hip REQUIRED
+    PATHS ${HIP_ROOT_DIR} ${ROCM_PATH} /opt/rocm)
+
+  blt_register_library( NAME hip_runtime
+                        LIBRARIES hip::host
+                      )
+endif ()
+
+if (ENABLE_OPENMP_TARGET AND NOT ENABLE_OPENMP)
+  message(FATAL_ERROR "ENABLE_OPENMP_TARGET requires ENABLE_OPENMP")
+endif ()
+
 if (ENABLE_SLIC AND ENABLE_LOGGING)
   find_library( SLIC_LIBRARY
     libslic.a
@@ -56,3 +153,88 @@ if (ENABLE_SLIC AND ENABLE_LOGGING)
                         LIBRARIES ${SLIC_LIBRARY} ${SLIC_UTIL_LIBRARY}
                       )
 endif ()
+
+if (ENABLE_MEMKIND)
+  find_library( MEMKIND_LIBRARY
+    memkind
+    PATHS ${MEMKIND_LIBRARY_PATH}
+  )
+
+  if (NOT MEMKIND_LIBRARY)
+    message(FATAL_ERROR "Could not find libmemkind, make sure MEMKIND_LIBRARY_PATH is set properly")
+  endif()
+
+  find_path( MEMKIND_INCLUDE_DIR
+    memkind.h
+    PATHS ${MEMKIND_INCLUDE_PATH}
+  )
+
+  if (NOT MEMKIND_INCLUDE_DIR)
+    message(FATAL_ERROR "Could not find memkind.h, make sure MEMKIND_INCLUDE_PATH is set properly")
+  endif()
+
+  blt_register_library( NAME memkind
+                        INCLUDES ${MEMKIND_INCLUDE_DIR}
+                        LIBRARIES ${MEMKIND_LIBRARY}
+                      )
+endif ()
+
+if (ENABLE_NVTX)
+  find_library( NVTX_LIBRARY
+    nvToolsExt
+    PATHS ${NVTX_LIBRARY_PATH} ${CUDA_TOOLKIT_ROOT_DIR}/lib64 ${CUDA_TOOLKIT_ROOT_DIR}/lib
+  )
+
+  if (NOT NVTX_LIBRARY)
+    message(FATAL_ERROR "Could not find libnvToolsExt, make sure NVTX_LIBRARY_PATH is set properly")
+  endif()
+
+  find_path( NVTX_INCLUDE_DIR
+    nvToolsExt.h
+    PATHS ${NVTX_INCLUDE_PATH} ${CUDA_TOOLKIT_ROOT_DIR}/include
+  )
+
+  if (NOT NVTX_INCLUDE_DIR)
+    message(FATAL_ERROR "Could not find nvToolsExt.h, make sure NVTX_INCLUDE_PATH is set properly")
+  endif()
+
+  blt_register_library( NAME nvtx
+                        INCLUDES ${NVTX_INCLUDE_DIR}
+                        LIBRARIES ${NVTX_LIBRARY}
+                      )
+endif ()
+
+if (ENABLE_CALIPER)
+  find_package(caliper REQUIRED
+    PATHS ${CALIPER_DIR})
+
+  blt_register_library( NAME caliper
+                        INCLUDES ${caliper_INCLUDE_DIR}
+                        LIBRARIES caliper
+                      )
+endif ()
+
+if (ENABLE_NUMA)
+  find_library( NUMA_LIBRARY
+    numa
+    PATHS ${NUMA_LIBRARY_PATH}
+  )
+
+  if (NOT NUMA_LIBRARY)
+    message(FATAL_ERROR "Could not find libnuma, make sure NUMA_LIBRARY_PATH is set properly")
+  endif()
+
+  find_path( NUMA_INCLUDE_DIR
+    numa.h
+    PATHS ${NUMA_INCLUDE_PATH}
+  )
+
+  if (NOT NUMA_INCLUDE_DIR)
+    message(FATAL_ERROR "Could not find numa.h, make sure NUMA_INCLUDE_PATH is set properly")
+  endif()
+
+  blt_register_library( NAME numa
+                        INCLUDES ${NUMA_INCLUDE_DIR}
+                        LIBRARIES ${NUMA_LIBRARY}
+                      )
+endif ()
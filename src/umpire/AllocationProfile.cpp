@@ -0,0 +1,190 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/AllocationProfile.hpp"
+
+#include "umpire/util/Macros.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace umpire {
+
+namespace {
+
+uint64_t parseNumber(const std::string& value, int line)
+{
+  char* end = nullptr;
+  const unsigned long long number = std::strtoull(value.c_str(), &end, 10);
+
+  if (value.empty() || *end != '\0') {
+    UMPIRE_ERROR("line " << line << ": " << value << " is not a number");
+  }
+
+  return static_cast<uint64_t>(number);
+}
+
+} // end of anonymous namespace
+
+AllocationProfile
+AllocationProfile::fromFile(const std::string& filename)
+{
+  UMPIRE_LOG(Debug, "(filename=\"" << filename << "\")");
+
+  std::ifstream stream(filename);
+  if (!stream) {
+    UMPIRE_ERROR("Cannot open allocation profile " << filename);
+  }
+
+  return fromStream(stream);
+}
+
+AllocationProfile
+AllocationProfile::fromStream(std::istream& stream)
+{
+  AllocationProfile profile;
+
+  std::string text;
+  int line = 0;
+
+  while (std::getline(stream, text)) {
+    ++line;
+
+    const std::size_t comment = text.find('#');
+    if (comment != std::string::npos) {
+      text.erase(comment);
+    }
+
+    std::istringstream tokens(text);
+    Entry entry{};
+
+    if (!(tokens >> entry.name)) {
+      continue;
+    }
+
+    std::string option;
+    while (tokens >> option) {
+      const std::size_t equals = option.find('=');
+      if (equals == std::string::npos || equals == 0) {
+        UMPIRE_ERROR("line " << line << ": expected option=value, got " << option);
+      }
+
+      const std::string key = option.substr(0, equals);
+      const std::string value = option.substr(equals + 1);
+
+      if (key == "high_watermark") {
+        entry.high_watermark = static_cast<long>(parseNumber(value, line));
+      } else if (key == "actual_size") {
+        entry.actual_size = static_cast<long>(parseNumber(value, line));
+      } else if (key == "chunks") {
+        entry.num_chunks = static_cast<std::size_t>(parseNumber(value, line));
+      } else if (key == "sizes") {
+        std::istringstream buckets(value);
+        std::string bucket;
+
+        while (std::getline(buckets, bucket, ',')) {
+          const std::size_t colon = bucket.find(':');
+          if (colon == std::string::npos) {
+            UMPIRE_ERROR("line " << line << ": expected bucket:count, got " << bucket);
+          }
+
+          const uint64_t index = parseNumber(bucket.substr(0, colon), line);
+          if (index >= static_cast<uint64_t>(util::Histogram::s_num_buckets)) {
+            UMPIRE_ERROR("line " << line << ": no size bucket " << index);
+          }
+
+          const uint64_t count = parseNumber(bucket.substr(colon + 1), line);
+          entry.allocation_bytes.buckets[index] = count;
+          entry.allocation_bytes.count += count;
+        }
+      } else {
+        UMPIRE_ERROR("line " << line << ": unknown option " << key);
+      }
+    }
+
+    profile.add(entry);
+  }
+
+  return profile;
+}
+
+void
+AllocationProfile::toFile(const std::string& filename) const
+{
+  UMPIRE_LOG(Debug, "(filename=\"" << filename << "\")");
+
+  std::ofstream stream(filename);
+  if (!stream) {
+    UMPIRE_ERROR("Cannot write allocation profile " << filename);
+  }
+
+  toStream(stream);
+}
+
+void
+AllocationProfile::toStream(std::ostream& stream) const
+{
+  stream << "# name high_watermark actual_size chunks sizes=bucket:count,..." << std::endl;
+
+  for (const auto& entry : m_entries) {
+    stream << entry.name
+      << " high_watermark=" << entry.high_watermark
+      << " actual_size=" << entry.actual_size
+      << " chunks=" << entry.num_chunks;
+
+    const char* separator = " sizes=";
+    for (int i = 0; i < util::Histogram::s_num_buckets; ++i) {
+      if (entry.allocation_bytes.buckets[i]) {
+        stream << separator << i << ":" << entry.allocation_bytes.buckets[i];
+        separator = ",";
+      }
+    }
+
+    stream << std::endl;
+  }
+}
+
+void
+AllocationProfile::add(const Entry& entry)
+{
+  for (auto& existing : m_entries) {
+    if (existing.name == entry.name) {
+      existing = entry;
+      return;
+    }
+  }
+
+  m_entries.push_back(entry);
+}
+
+const AllocationProfile::Entry*
+AllocationProfile::find(const std::string& name) const
+{
+  for (const auto& entry : m_entries) {
+    if (entry.name == name) {
+      return &entry;
+    }
+  }
+
+  return nullptr;
+}
+
+const std::vector<AllocationProfile::Entry>&
+AllocationProfile::getEntries() const
+{
+  return m_entries;
+}
+
+} // end of namespace umpire
@@ -0,0 +1,90 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_AllocationProfile_HPP
+#define UMPIRE_AllocationProfile_HPP
+
+#include "umpire/util/AllocatorStatistics.hpp"
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace umpire {
+
+/*!
+ * \brief How much memory each Allocator used in a run, kept in a text file
+ * so that the next run can size its pools up front.
+ *
+ * Each line describes one Allocator:
+ *
+ * \code
+ * # name       options
+ * DEVICE_POOL  high_watermark=805306368 actual_size=1073741824 chunks=12 sizes=4:100,21:12
+ * \endcode
+ *
+ * chunks counts the chunks a pool grew by. sizes lists the non-empty
+ * buckets of the allocation size histogram as bucket:count, in the
+ * buckets of util::Histogram; it is only recorded for Allocators with
+ * statistics enabled. Anything after a '#' is ignored.
+ *
+ * \see ResourceManager::useProfile
+ */
+class AllocationProfile {
+  public:
+    struct Entry {
+      std::string name;
+      long high_watermark;
+      long actual_size;
+      std::size_t num_chunks;
+      util::Histogram allocation_bytes;
+    };
+
+    /*!
+     * \brief Parse the profile in filename.
+     *
+     * Throws an umpire::Exception if the file cannot be read or a line is
+     * malformed.
+     */
+    static AllocationProfile fromFile(const std::string& filename);
+
+    static AllocationProfile fromStream(std::istream& stream);
+
+    /*!
+     * \brief Write the profile to filename, replacing it.
+     */
+    void toFile(const std::string& filename) const;
+
+    void toStream(std::ostream& stream) const;
+
+    /*!
+     * \brief Add entry, replacing any entry with the same name.
+     */
+    void add(const Entry& entry);
+
+    /*!
+     * \brief Return the entry for name, or nullptr if there is none.
+     */
+    const Entry* find(const std::string& name) const;
+
+    const std::vector<Entry>& getEntries() const;
+
+  private:
+    std::vector<Entry> m_entries;
+};
+
+} // end of namespace umpire
+
+#endif // UMPIRE_AllocationProfile_HPP
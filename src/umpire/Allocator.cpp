@@ -17,6 +17,8 @@
 #include "umpire/ResourceManager.hpp"
 #include "umpire/util/Macros.hpp"
 
+#include <cstring>
+
 #if defined(UMPIRE_ENABLE_STATISTICS)
 #include "umpire/util/StatisticsDatabase.hpp"
 #include "umpire/util/Statistic.hpp"
@@ -34,9 +36,106 @@ Allocator::allocate(size_t bytes)
 {
   void* ret = nullptr;
   UMPIRE_LOG(Debug, "(" << bytes << ")");
-  ret = m_allocator->allocate(bytes);
+  UMPIRE_ANNOTATE_SCOPE("allocate", m_allocator->getName(), bytes);
+
+  util::AllocatorStatistics* statistics = m_allocator->getStatistics();
+  if (statistics) {
+    const uint64_t start = util::AllocatorStatistics::now();
+    ret = m_allocator->allocate(bytes);
+    statistics->recordAllocate(util::AllocatorStatistics::now() - start, bytes);
+  } else {
+    ret = m_allocator->allocate(bytes);
+  }
+
+  UMPIRE_RECORD_STATISTIC(m_allocator->getStatisticHandle(), "ptr", reinterpret_cast<uintptr_t>(ret), "size", bytes, "event", "allocate");
+  return ret;
+}
+
+void*
+Allocator::allocate(size_t bytes, size_t alignment)
+{
+  void* ret = nullptr;
+  UMPIRE_LOG(Debug, "(" << bytes << ", alignment=" << alignment << ")");
+  UMPIRE_ANNOTATE_SCOPE("allocate", m_allocator->getName(), bytes);
+
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+    UMPIRE_ERROR("Alignment must be a power of two, got " << alignment);
+  }
+
+  util::AllocatorStatistics* statistics = m_allocator->getStatistics();
+  if (statistics) {
+    const uint64_t start = util::AllocatorStatistics::now();
+    ret = m_allocator->allocateAligned(bytes, alignment);
+    statistics->recordAllocate(util::AllocatorStatistics::now() - start, bytes);
+  } else {
+    ret = m_allocator->allocateAligned(bytes, alignment);
+  }
+
+  UMPIRE_RECORD_STATISTIC(m_allocator->getStatisticHandle(), "ptr", reinterpret_cast<uintptr_t>(ret), "size", bytes, "event", "allocate");
+  return ret;
+}
+
+void*
+Allocator::allocate(size_t bytes, Lifetime lifetime)
+{
+  void* ret = nullptr;
+  UMPIRE_LOG(Debug, "(" << bytes << ", lifetime=" << static_cast<int>(lifetime) << ")");
+  UMPIRE_ANNOTATE_SCOPE("allocate", m_allocator->getName(), bytes);
+
+  util::AllocatorStatistics* statistics = m_allocator->getStatistics();
+  if (statistics) {
+    const uint64_t start = util::AllocatorStatistics::now();
+    ret = m_allocator->allocateWithLifetime(bytes, lifetime);
+    statistics->recordAllocate(util::AllocatorStatistics::now() - start, bytes);
+  } else {
+    ret = m_allocator->allocateWithLifetime(bytes, lifetime);
+  }
+
+  UMPIRE_RECORD_STATISTIC(m_allocator->getStatisticHandle(), "ptr", reinterpret_cast<uintptr_t>(ret), "size", bytes, "event", "allocate");
+  return ret;
+}
+
+void*
+Allocator::allocateZeroed(size_t bytes)
+{
+  void* ret = nullptr;
+  UMPIRE_LOG(Debug, "(" << bytes << ")");
+  UMPIRE_ANNOTATE_SCOPE("allocate", m_allocator->getName(), bytes);
 
-  UMPIRE_RECORD_STATISTIC(getName(), "ptr", reinterpret_cast<uintptr_t>(ret), "size", bytes, "event", "allocate");
+  util::AllocatorStatistics* statistics = m_allocator->getStatistics();
+  if (statistics) {
+    const uint64_t start = util::AllocatorStatistics::now();
+    ret = m_allocator->allocateZeroed(bytes);
+    statistics->recordAllocate(util::AllocatorStatistics::now() - start, bytes);
+  } else {
+    ret = m_allocator->allocateZeroed(bytes);
+  }
+
+  UMPIRE_RECORD_STATISTIC(m_allocator->getStatisticHandle(), "ptr", reinterpret_cast<uintptr_t>(ret), "size", bytes, "event", "allocate");
+  return ret;
+}
+
+void*
+Allocator::tryAllocate(size_t bytes)
+{
+  void* ret = nullptr;
+  UMPIRE_LOG(Debug, "(" << bytes << ")");
+  UMPIRE_ANNOTATE_SCOPE("allocate", m_allocator->getName(), bytes);
+
+  util::AllocatorStatistics* statistics = m_allocator->getStatistics();
+  if (statistics) {
+    const uint64_t start = util::AllocatorStatistics::now();
+    ret = m_allocator->tryAllocate(bytes);
+    if (ret) {
+      statistics->recordAllocate(util::AllocatorStatistics::now() - start, bytes);
+    }
+  } else {
+    ret = m_allocator->tryAllocate(bytes);
+  }
+
+  if (ret) {
+    UMPIRE_RECORD_STATISTIC(m_allocator->getStatisticHandle(), "ptr", reinterpret_cast<uintptr_t>(ret), "size", bytes, "event", "allocate");
+  }
   return ret;
 }
 
@@ -44,18 +143,132 @@ void
 Allocator::deallocate(void* ptr)
 {
   UMPIRE_LOG(Debug, "(" << ptr << ")");
+  UMPIRE_ANNOTATE_SCOPE("deallocate", m_allocator->getName(), 0);
 
-
-  UMPIRE_RECORD_STATISTIC(getName(), "ptr", reinterpret_cast<uintptr_t>(ptr), "size", 0x0, "event", "deallocate");
+  UMPIRE_RECORD_STATISTIC(m_allocator->getStatisticHandle(), "ptr", reinterpret_cast<uintptr_t>(ptr), "size", 0x0, "event", "deallocate");
 
   if (!ptr) {
     UMPIRE_LOG(Info, "Deallocating a null pointer");
     return;
+  }
+
+  util::AllocatorStatistics* statistics = m_allocator->getStatistics();
+  if (statistics) {
+    const uint64_t start = util::AllocatorStatistics::now();
+    m_allocator->deallocate(ptr);
+    statistics->recordDeallocate(util::AllocatorStatistics::now() - start);
   } else {
     m_allocator->deallocate(ptr);
   }
 }
 
+void
+Allocator::allocateMany(const size_t* sizes, size_t count, void** ptrs)
+{
+  UMPIRE_LOG(Debug, "(count=" << count << ")");
+
+  util::AllocatorStatistics* statistics = m_allocator->getStatistics();
+  if (statistics) {
+    const uint64_t start = util::AllocatorStatistics::now();
+    m_allocator->allocateMany(sizes, count, ptrs);
+    const uint64_t elapsed = util::AllocatorStatistics::now() - start;
+
+    for (size_t i = 0; i < count; ++i) {
+      statistics->recordAllocate(elapsed / count, sizes[i]);
+    }
+  } else {
+    m_allocator->allocateMany(sizes, count, ptrs);
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    UMPIRE_RECORD_STATISTIC(m_allocator->getStatisticHandle(), "ptr", reinterpret_cast<uintptr_t>(ptrs[i]), "size", sizes[i], "event", "allocate");
+  }
+}
+
+void
+Allocator::deallocateMany(void** ptrs, size_t count)
+{
+  UMPIRE_LOG(Debug, "(count=" << count << ")");
+
+  for (size_t i = 0; i < count; ++i) {
+    UMPIRE_RECORD_STATISTIC(m_allocator->getStatisticHandle(), "ptr", reinterpret_cast<uintptr_t>(ptrs[i]), "size", 0x0, "event", "deallocate");
+  }
+
+  util::AllocatorStatistics* statistics = m_allocator->getStatistics();
+  if (statistics) {
+    const uint64_t start = util::AllocatorStatistics::now();
+    m_allocator->deallocateMany(ptrs, count);
+    const uint64_t elapsed = util::AllocatorStatistics::now() - start;
+
+    for (size_t i = 0; i < count; ++i) {
+      statistics->recordDeallocate(elapsed / count);
+    }
+  } else {
+    m_allocator->deallocateMany(ptrs, count);
+  }
+}
+
+void*
+Allocator::allocateUntracked(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(" << bytes << ")");
+  return m_allocator->allocateUntracked(bytes);
+}
+
+void
+Allocator::deallocateUntracked(void* ptr)
+{
+  UMPIRE_LOG(Debug, "(" << ptr << ")");
+
+  if (!ptr) {
+    UMPIRE_LOG(Info, "Deallocating a null pointer");
+    return;
+  } else {
+    m_allocator->deallocateUntracked(ptr);
+  }
+}
+
+void
+Allocator::deallocateUntracked(void* ptr, size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(" << ptr << ", " << bytes << ")");
+
+  if (!ptr) {
+    UMPIRE_LOG(Info, "Deallocating a null pointer");
+    return;
+  } else {
+    m_allocator->deallocateUntracked(ptr, bytes);
+  }
+}
+
+void
+Allocator::coalesce()
+{
+  UMPIRE_LOG(Debug, "()");
+  m_allocator->coalesce();
+}
+
+void
+Allocator::release()
+{
+  UMPIRE_LOG(Debug, "()");
+  m_allocator->release();
+}
+
+void
+Allocator::trim(size_t target_bytes)
+{
+  UMPIRE_LOG(Debug, "(" << target_bytes << ")");
+  m_allocator->trim(target_bytes);
+}
+
+void
+Allocator::reserve(size_t bytes, bool prefault)
+{
+  UMPIRE_LOG(Debug, "(" << bytes << ", " << prefault << ")");
+  m_allocator->reserve(bytes, prefault);
+}
+
 size_t
 Allocator::getSize(void* ptr)
 {
@@ -81,6 +294,34 @@ Allocator::getActualSize()
   return m_allocator->getActualSize();
 }
 
+void
+Allocator::enableStatistics()
+{
+  UMPIRE_LOG(Debug, "()");
+  m_allocator->enableStatistics();
+}
+
+void
+Allocator::setCompressCopies(bool compress)
+{
+  UMPIRE_LOG(Debug, "(compress=" << compress << ")");
+  m_allocator->setCompressCopies(compress);
+}
+
+util::AllocatorStatistics::Summary
+Allocator::getStatistics()
+{
+  util::AllocatorStatistics* statistics = m_allocator->getStatistics();
+
+  if (statistics) {
+    return statistics->getSummary();
+  }
+
+  util::AllocatorStatistics::Summary summary;
+  std::memset(&summary, 0, sizeof(summary));
+  return summary;
+}
+
 std::string
 Allocator::getName()
 {
@@ -106,4 +347,10 @@ Allocator::getPlatform()
   return m_allocator->getPlatform();
 }
 
+resource::MemoryResourceType
+Allocator::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
 } // end of namespace umpire
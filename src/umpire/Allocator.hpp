@@ -20,6 +20,7 @@
 #include <cstddef>
 #include <memory>
 
+#include "umpire/util/Lifetime.hpp"
 #include "umpire/util/Platform.hpp"
 
 class AllocatorTest;
@@ -28,6 +29,9 @@ namespace umpire {
 
 class ResourceManager;
 
+template<typename Strategy>
+class StrategyAllocator;
+
 /*!
  * \brief Allocator provides a unified interface to all Umpire classes that can
  * be used to allocate and free data.
@@ -43,6 +47,8 @@ class ResourceManager;
  */
 class Allocator {
   friend class ResourceManager;
+  friend class ScopedArena;
+  template<typename Strategy> friend class StrategyAllocator;
   friend class ::AllocatorTest;
 
   public:
@@ -62,6 +68,66 @@ class Allocator {
      */
     void* allocate(size_t bytes);
 
+    /*!
+     * \brief Allocate bytes of memory aligned to alignment bytes.
+     *
+     * DynamicPool, FixedPool, ArenaAllocator, MonotonicAllocationStrategy
+     * and the memory resources place allocations on the boundary directly.
+     * Other strategies throw an umpire::Exception if the memory they
+     * return is not suitably aligned.
+     *
+     * \param bytes Number of bytes to allocate (>= 0)
+     * \param alignment Alignment in bytes; a power of two.
+     *
+     * \return Pointer to start of the allocation.
+     */
+    void* allocate(size_t bytes, size_t alignment);
+
+    /*!
+     * \brief Allocate bytes of memory expected to live for lifetime.
+     *
+     * LifetimePool places allocations of each lifetime in a separate pool.
+     * Other strategies ignore the hint.
+     *
+     * \param bytes Number of bytes to allocate (>= 0)
+     * \param lifetime Expected lifetime of the allocation.
+     *
+     * \return Pointer to start of the allocation.
+     */
+    void* allocate(size_t bytes, Lifetime lifetime);
+
+    /*!
+     * \brief Allocate bytes of memory that reads as zero.
+     *
+     * This replaces allocate followed by ResourceManager::memset, without
+     * the extra pass over memory the allocator knows to be zero already:
+     * HOST uses calloc, and resources backed by fresh mappings skip the
+     * clearing entirely. DEVICE, UM and DEVICE_ASYNC clear the memory with
+     * cudaMemsetAsync on the default stream. Other strategies allocate and
+     * then memset.
+     *
+     * \param bytes Number of bytes to allocate (>= 0)
+     *
+     * \return Pointer to start of the allocation.
+     */
+    void* allocateZeroed(size_t bytes);
+
+    /*!
+     * \brief Allocate bytes of memory, or return nullptr if it can't be
+     * done.
+     *
+     * Unlike allocate, a failure throws no umpire::Exception and logs no
+     * error, so it is cheap enough to use speculatively, e.g. trying a
+     * large workspace before falling back to a smaller one. Memory
+     * resources and DynamicPool report failure directly; other strategies
+     * catch the failure of allocate.
+     *
+     * \param bytes Number of bytes to allocate (>= 0)
+     *
+     * \return Pointer to start of the allocation, or nullptr.
+     */
+    void* tryAllocate(size_t bytes);
+
     /*!
      * \brief Free the memory at ptr.
      *
@@ -73,6 +139,114 @@ class Allocator {
      */
     void deallocate(void* ptr);
 
+    /*!
+     * \brief Allocate count blocks of memory in one call.
+     *
+     * This is meant for groups of arrays that are created and freed
+     * together. DynamicPool carves the blocks side by side from a single
+     * free block and registers them at once, and ThreadSafeAllocator takes
+     * its lock once for the whole batch. Other strategies allocate the
+     * blocks one by one. Each block can still be freed individually.
+     *
+     * If any allocation fails, the blocks already allocated are freed and
+     * an umpire::Exception is thrown.
+     *
+     * \param sizes Number of bytes for each block.
+     * \param count Number of blocks.
+     * \param ptrs Array of count pointers that receives the blocks.
+     */
+    void allocateMany(const size_t* sizes, size_t count, void** ptrs);
+
+    /*!
+     * \brief Free count blocks of memory allocated by this Allocator.
+     *
+     * Null pointers in ptrs are ignored.
+     *
+     * \param ptrs Pointers to free.
+     * \param count Number of pointers.
+     */
+    void deallocateMany(void** ptrs, size_t count);
+
+    /*!
+     * \brief Allocate bytes of memory without registering the allocation
+     * with the ResourceManager.
+     *
+     * Pool strategies such as DynamicPool and FixedPool return memory
+     * directly from the pool, skipping the AllocationMap insertion.
+     * Strategies without an untracked path fall back to allocate.
+     *
+     * Pointers returned by this method are not known to the ResourceManager,
+     * so they cannot be used with ResourceManager::copy, memset, reallocate,
+     * move, deallocate or getSize. They must be freed using
+     * deallocateUntracked on the same Allocator. Memory resources keep no
+     * record of untracked memory, so memory taken from one directly must be
+     * freed with deallocateUntracked(ptr, bytes).
+     *
+     * \param bytes Number of bytes to allocate (>= 0)
+     *
+     * \return Pointer to start of the allocation.
+     */
+    void* allocateUntracked(size_t bytes);
+
+    /*!
+     * \brief Free memory obtained from allocateUntracked.
+     *
+     * \param ptr Pointer to free (!nullptr)
+     */
+    void deallocateUntracked(void* ptr);
+
+    /*!
+     * \brief Free memory obtained from allocateUntracked(bytes).
+     *
+     * \param ptr Pointer to free (!nullptr)
+     * \param bytes Number of bytes passed to allocateUntracked.
+     */
+    void deallocateUntracked(void* ptr, size_t bytes);
+
+    /*!
+     * \brief Merge free memory held by this Allocator into as few blocks
+     * as possible.
+     *
+     * For DynamicPool, all wholly free chunks are replaced by one chunk of
+     * their combined size. Allocators that do not hold free memory ignore
+     * this call.
+     */
+    void coalesce();
+
+    /*!
+     * \brief Return all unused memory held by this Allocator to the
+     * underlying memory resource.
+     *
+     * For DynamicPool, every chunk with no live allocations is freed.
+     * Allocators that do not hold free memory ignore this call.
+     */
+    void release();
+
+    /*!
+     * \brief Return unused memory held by this Allocator to the underlying
+     * memory resource until getActualSize is no more than target_bytes.
+     *
+     * Only memory with no live allocations can be released, so the actual
+     * size may remain above target_bytes.
+     *
+     * \param target_bytes Size to shrink to.
+     */
+    void trim(size_t target_bytes);
+
+    /*!
+     * \brief Take memory from the underlying memory resource now so that
+     * at least bytes can be allocated without growing.
+     *
+     * With prefault, the pages taken are touched (host memory, in parallel)
+     * or prefetched to the current device (unified memory), so that first
+     * use pays no page faults. Allocators that do not hold free memory
+     * ignore this call.
+     *
+     * \param bytes Number of bytes to hold free.
+     * \param prefault Whether to fault in the new pages.
+     */
+    void reserve(size_t bytes, bool prefault = true);
+
     /*!
      * \brief Return number of bytes allocated for allocation
      *
@@ -115,6 +289,38 @@ class Allocator {
      */
     size_t getActualSize();
 
+    /*!
+     * \brief Start recording latency and size histograms for this
+     * Allocator.
+     *
+     * Once enabled, every allocate and deallocate call on any Allocator
+     * sharing this strategy, and every synchronous ResourceManager::copy
+     * out of its memory, is timed and added to per-thread histograms. Recording
+     * cannot be turned off again.
+     */
+    void enableStatistics();
+
+    /*!
+     * \brief Return the histograms recorded for this Allocator, merged
+     * across threads.
+     *
+     * All histograms are empty if enableStatistics has not been called.
+     *
+     * \return Latencies of allocate, deallocate and copy in nanoseconds,
+     * and allocation sizes in bytes.
+     */
+    util::AllocatorStatistics::Summary getStatistics();
+
+    /*!
+     * \brief Set whether ResourceManager::copy compresses data moved into
+     * or out of this Allocator's memory.
+     *
+     * Such copies use the "COPY_COMPRESSED" operation, like
+     * ResourceManager::copyCompressed. This applies to every Allocator
+     * sharing this strategy.
+     */
+    void setCompressCopies(bool compress);
+
     /*!
      * \brief Get the name of this Allocator.
      *
@@ -156,6 +362,13 @@ class Allocator {
      */
     Platform getPlatform();
 
+    /*!
+     * \brief Get the kind of memory resource this Allocator allocates from.
+     *
+     * \return MemoryResourceType for this Allocator.
+     */
+    resource::MemoryResourceType getResourceType();
+
   private:
     /*!
      * \brief Construct an Allocator with the given AllocationStrategy.
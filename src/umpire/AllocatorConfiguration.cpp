@@ -0,0 +1,413 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/AllocatorConfiguration.hpp"
+
+#include "umpire/ResourceManager.hpp"
+
+#include "umpire/strategy/AlignedAllocator.hpp"
+#include "umpire/strategy/AllocationAdvisor.hpp"
+#include "umpire/strategy/ArenaAllocator.hpp"
+#include "umpire/strategy/CachingAllocator.hpp"
+#include "umpire/strategy/CommBufferPool.hpp"
+#include "umpire/strategy/CompactingPool.hpp"
+#include "umpire/strategy/DynamicPool.hpp"
+#include "umpire/strategy/MonotonicAllocationStrategy.hpp"
+#include "umpire/strategy/ReclaimingAllocator.hpp"
+#include "umpire/strategy/SizeClassPool.hpp"
+#include "umpire/strategy/SizedFixedPool.hpp"
+#include "umpire/strategy/SlotPool.hpp"
+#include "umpire/strategy/ThreadCachingAllocator.hpp"
+#include "umpire/strategy/ThreadSafeAllocator.hpp"
+
+#include "umpire/util/GrowthPolicy.hpp"
+#include "umpire/util/Macros.hpp"
+
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <set>
+#include <sstream>
+
+namespace umpire {
+
+namespace {
+
+/*
+ * Looks up the options of one entry, remembering which were used so that
+ * misspelt ones can be reported instead of silently ignored.
+ */
+class Options {
+  public:
+    Options(const AllocatorConfiguration::Entry& entry) :
+      m_entry(entry),
+      m_used()
+    {
+    }
+
+    bool has(const std::string& key)
+    {
+      m_used.insert(key);
+      return m_entry.options.find(key) != m_entry.options.end();
+    }
+
+    std::string getString(const std::string& key, const std::string& fallback)
+    {
+      if (!has(key)) {
+        return fallback;
+      }
+      return m_entry.options.at(key);
+    }
+
+    std::size_t getSize(const std::string& key, std::size_t fallback)
+    {
+      if (!has(key)) {
+        return fallback;
+      }
+
+      const std::string& value = m_entry.options.at(key);
+      if (value.empty() || !std::isdigit(static_cast<unsigned char>(value[0]))) {
+        UMPIRE_ERROR("line " << m_entry.line << ": " << key << "=" << value << " is not a size");
+      }
+
+      char* end = nullptr;
+      errno = 0;
+      unsigned long long size = std::strtoull(value.c_str(), &end, 10);
+
+      if (errno == ERANGE) {
+        UMPIRE_ERROR("line " << m_entry.line << ": " << key << "=" << value << " is too large");
+      }
+
+      int shifts = 0;
+      switch (std::toupper(*end)) {
+        case 'T': ++shifts; // fall through
+        case 'G': ++shifts; // fall through
+        case 'M': ++shifts; // fall through
+        case 'K': ++shifts; ++end; break;
+        default: break;
+      }
+
+      if (*end != '\0') {
+        UMPIRE_ERROR("line " << m_entry.line << ": " << key << "=" << value << " is not a size");
+      }
+
+      for (; shifts > 0; --shifts) {
+        if (size > (std::numeric_limits<std::size_t>::max() >> 10)) {
+          UMPIRE_ERROR("line " << m_entry.line << ": " << key << "=" << value << " is too large");
+        }
+        size <<= 10;
+      }
+
+      if (static_cast<std::size_t>(size) != size) {
+        UMPIRE_ERROR("line " << m_entry.line << ": " << key << "=" << value << " is too large");
+      }
+
+      return static_cast<std::size_t>(size);
+    }
+
+    bool getBool(const std::string& key, bool fallback)
+    {
+      const std::string value = getString(key, fallback ? "true" : "false");
+
+      if (value == "true" || value == "1") {
+        return true;
+      } else if (value == "false" || value == "0") {
+        return false;
+      }
+
+      UMPIRE_ERROR("line " << m_entry.line << ": " << key << "=" << value << " is not true or false");
+    }
+
+    /*
+     * A size, or a percentage of free memory such as 80%.
+     */
+    GrowthPolicy getChunkSize(const std::string& key, std::size_t fallback)
+    {
+      const std::string value = getString(key, "");
+
+      if (!value.empty() && value.back() == '%') {
+        char* end = nullptr;
+        const double percent = std::strtod(value.c_str(), &end);
+
+        if (end != value.c_str() + value.size() - 1 || percent <= 0.0 || percent > 100.0) {
+          UMPIRE_ERROR("line " << m_entry.line << ": " << key << "=" << value << " is not a percentage");
+        }
+
+        return GrowthPolicy::freeFraction(percent / 100.0);
+      }
+
+      return GrowthPolicy::fixed(getSize(key, fallback));
+    }
+
+    PlacementPolicy getPolicy(const std::string& key, PlacementPolicy fallback)
+    {
+      if (!has(key)) {
+        return fallback;
+      }
+
+      const std::string& value = m_entry.options.at(key);
+      if (value == "first_fit") {
+        return PlacementPolicy::first_fit;
+      } else if (value == "best_fit") {
+        return PlacementPolicy::best_fit;
+      } else if (value == "segregated_fit") {
+        return PlacementPolicy::segregated_fit;
+      }
+
+      UMPIRE_ERROR("line " << m_entry.line << ": unknown placement policy " << value);
+    }
+
+    /*
+     * Throw if an option was given that the strategy does not take.
+     */
+    void checkAllUsed()
+    {
+      for (const auto& option : m_entry.options) {
+        if (m_used.find(option.first) == m_used.end()) {
+          UMPIRE_ERROR("line " << m_entry.line << ": " << m_entry.strategy
+              << " has no option " << option.first);
+        }
+      }
+    }
+
+  private:
+    const AllocatorConfiguration::Entry& m_entry;
+    std::set<std::string> m_used;
+};
+
+} // end of anonymous namespace
+
+AllocatorConfiguration
+AllocatorConfiguration::fromFile(const std::string& filename)
+{
+  UMPIRE_LOG(Debug, "(filename=\"" << filename << "\")");
+
+  std::ifstream stream(filename);
+  if (!stream) {
+    UMPIRE_ERROR("Cannot open allocator configuration " << filename);
+  }
+
+  return fromStream(stream);
+}
+
+AllocatorConfiguration
+AllocatorConfiguration::fromStream(std::istream& stream)
+{
+  AllocatorConfiguration configuration;
+
+  std::string text;
+  int line = 0;
+
+  while (std::getline(stream, text)) {
+    ++line;
+
+    const std::size_t comment = text.find('#');
+    if (comment != std::string::npos) {
+      text.erase(comment);
+    }
+
+    std::istringstream tokens(text);
+    Entry entry;
+    entry.line = line;
+
+    if (!(tokens >> entry.name)) {
+      continue;
+    }
+
+    if (!(tokens >> entry.strategy >> entry.base)) {
+      UMPIRE_ERROR("line " << line << ": expected <name> <strategy> <base> [option=value ...]");
+    }
+
+    std::string option;
+    while (tokens >> option) {
+      const std::size_t equals = option.find('=');
+      if (equals == std::string::npos || equals == 0) {
+        UMPIRE_ERROR("line " << line << ": expected option=value, got " << option);
+      }
+
+      const std::string key = option.substr(0, equals);
+      if (entry.options.count(key)) {
+        UMPIRE_ERROR("line " << line << ": option " << key << " given more than once");
+      }
+
+      entry.options[key] = option.substr(equals + 1);
+    }
+
+    configuration.m_entries.push_back(entry);
+  }
+
+  return configuration;
+}
+
+void
+AllocatorConfiguration::apply(ResourceManager& rm) const
+{
+  for (const auto& entry : m_entries) {
+    UMPIRE_LOG(Debug, "Making " << entry.strategy << " \"" << entry.name
+        << "\" over \"" << entry.base << "\"");
+    makeAllocator(rm, entry);
+  }
+}
+
+const std::vector<AllocatorConfiguration::Entry>&
+AllocatorConfiguration::getEntries() const
+{
+  return m_entries;
+}
+
+void
+AllocatorConfiguration::makeAllocator(ResourceManager& rm, const Entry& entry) const
+{
+  if (!rm.isAllocator(entry.base)) {
+    UMPIRE_ERROR("line " << entry.line << ": no Allocator named " << entry.base);
+  }
+
+  Allocator base = rm.getAllocator(entry.base);
+  Options options(entry);
+
+  if (entry.strategy == "DynamicPool") {
+    const GrowthPolicy initial =
+      options.getChunkSize("min_initial_alloc_size", 512 * 1024 * 1024);
+    GrowthPolicy growth = options.getChunkSize("min_alloc_size", 1024 * 1024);
+    const PlacementPolicy policy = options.getPolicy("policy", PlacementPolicy::best_fit);
+    const std::size_t alignment = options.getSize("alignment", 16);
+    const bool cache_coloring = options.getBool("cache_coloring", false);
+
+    const std::string growth_kind = options.getString("growth", "fixed");
+    if (growth_kind == "geometric") {
+      if (growth.kind != GrowthPolicy::Kind::fixed) {
+        UMPIRE_ERROR("line " << entry.line << ": geometric growth needs a min_alloc_size in bytes");
+      }
+      growth = GrowthPolicy::geometric(growth.size, options.getSize("max_alloc_size", 1024ull * 1024 * 1024));
+    } else if (growth_kind != "fixed") {
+      UMPIRE_ERROR("line " << entry.line << ": unknown growth " << growth_kind);
+    }
+    options.checkAllUsed();
+
+    rm.makeAllocator<strategy::DynamicPool>(
+        entry.name, base, initial, growth, policy, alignment, cache_coloring);
+  } else if (entry.strategy == "AlignedAllocator") {
+    const std::size_t alignment = options.getSize("alignment", 64);
+    options.checkAllUsed();
+
+    rm.makeAllocator<strategy::AlignedAllocator>(entry.name, base, alignment);
+  } else if (entry.strategy == "ThreadSafeAllocator") {
+    options.checkAllUsed();
+    rm.makeAllocator<strategy::ThreadSafeAllocator>(entry.name, base);
+  } else if (entry.strategy == "ThreadCachingAllocator") {
+    options.checkAllUsed();
+    rm.makeAllocator<strategy::ThreadCachingAllocator>(entry.name, base);
+  } else if (entry.strategy == "AllocationAdvisor") {
+    if (!options.has("advice")) {
+      UMPIRE_ERROR("line " << entry.line << ": AllocationAdvisor needs an advice option");
+    }
+    const std::string advice = options.getString("advice", "");
+    const std::string accessing = options.getString("accessing_allocator", entry.base);
+    options.checkAllUsed();
+
+    if (!rm.isAllocator(accessing)) {
+      UMPIRE_ERROR("line " << entry.line << ": no Allocator named " << accessing);
+    }
+
+    rm.makeAllocator<strategy::AllocationAdvisor>(
+        entry.name, base, advice, rm.getAllocator(accessing));
+  } else if (entry.strategy == "MonotonicAllocationStrategy") {
+    if (!options.has("capacity")) {
+      UMPIRE_ERROR("line " << entry.line << ": MonotonicAllocationStrategy needs a capacity option");
+    }
+    const std::size_t capacity = options.getSize("capacity", 0);
+    options.checkAllUsed();
+
+    rm.makeAllocator<strategy::MonotonicAllocationStrategy>(entry.name, capacity, base);
+  } else if (entry.strategy == "SlotPool") {
+    if (!options.has("slots")) {
+      UMPIRE_ERROR("line " << entry.line << ": SlotPool needs a slots option");
+    }
+    const std::size_t slots = options.getSize("slots", 0);
+    options.checkAllUsed();
+
+    if (slots == 0) {
+      UMPIRE_ERROR("line " << entry.line << ": SlotPool needs at least one slot");
+    }
+
+    rm.makeAllocator<strategy::SlotPool>(entry.name, slots, base);
+  } else if (entry.strategy == "SizeClassPool") {
+    const std::size_t slab_size = options.getSize("slab_size", 1024 * 1024);
+    options.checkAllUsed();
+
+    // Each slab must hold at least one block of the largest size class.
+    if (slab_size < 64 * 1024) {
+      UMPIRE_ERROR("line " << entry.line << ": SizeClassPool slab_size must be at least 64K");
+    }
+
+    rm.makeAllocator<strategy::SizeClassPool>(entry.name, base, slab_size);
+  } else if (entry.strategy == "ArenaAllocator") {
+    const std::size_t block_size = options.getSize("block_size", 1024 * 1024);
+    const std::size_t alignment = options.getSize("alignment", 16);
+    const bool track_allocations = options.getBool("track_allocations", true);
+    options.checkAllUsed();
+
+    if (block_size == 0) {
+      UMPIRE_ERROR("line " << entry.line << ": ArenaAllocator block_size must be non-zero");
+    }
+
+    rm.makeAllocator<strategy::ArenaAllocator>(
+        entry.name, base, block_size, alignment, track_allocations);
+  } else if (entry.strategy == "ReclaimingAllocator") {
+    const std::size_t threshold = options.getSize("threshold", 64 * 1024 * 1024);
+    options.checkAllUsed();
+
+    rm.makeAllocator<strategy::ReclaimingAllocator>(entry.name, base, threshold);
+  } else if (entry.strategy == "CompactingPool") {
+    const std::size_t chunk_size = options.getSize("chunk_size", 64 * 1024 * 1024);
+    options.checkAllUsed();
+
+    rm.makeAllocator<strategy::CompactingPool>(entry.name, base, chunk_size);
+  } else if (entry.strategy == "CachingAllocator") {
+    const std::size_t granularity = options.getSize("granularity", 2 * 1024 * 1024);
+    const std::size_t max_cached_bytes = options.getSize("max_cached_bytes", 0);
+    options.checkAllUsed();
+
+    rm.makeAllocator<strategy::CachingAllocator>(
+        entry.name, base, granularity, max_cached_bytes);
+  } else if (entry.strategy == "CommBufferPool") {
+    const std::size_t slab_size = options.getSize("slab_size", 64 * 1024 * 1024);
+    const std::size_t alignment = options.getSize("alignment", 256);
+    options.checkAllUsed();
+
+    rm.makeAllocator<strategy::CommBufferPool>(
+        entry.name, base, slab_size, nullptr, nullptr, alignment);
+  } else if (entry.strategy == "SizedFixedPool") {
+    if (!options.has("block_size")) {
+      UMPIRE_ERROR("line " << entry.line << ": SizedFixedPool needs a block_size option");
+    }
+    const std::size_t block_size = options.getSize("block_size", 0);
+    const std::size_t alignment = options.getSize("alignment", 16);
+    const std::size_t blocks_per_pool = options.getSize("blocks_per_pool", 2048);
+    options.checkAllUsed();
+
+    if (block_size == 0 || blocks_per_pool == 0) {
+      UMPIRE_ERROR("line " << entry.line << ": SizedFixedPool block_size and blocks_per_pool must be non-zero");
+    }
+
+    rm.makeAllocator<strategy::SizedFixedPool>(
+        entry.name, base, block_size, alignment, blocks_per_pool);
+  } else {
+    UMPIRE_ERROR("line " << entry.line << ": unknown strategy " << entry.strategy);
+  }
+}
+
+} // end of namespace umpire
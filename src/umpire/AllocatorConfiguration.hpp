@@ -0,0 +1,104 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_AllocatorConfiguration_HPP
+#define UMPIRE_AllocatorConfiguration_HPP
+
+#include <cstddef>
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace umpire {
+
+class ResourceManager;
+
+/*!
+ * \brief Allocator stacks read from a text file.
+ *
+ * Each line names a new Allocator, the strategy that implements it and the
+ * Allocator it is built on, followed by the strategy's options:
+ *
+ * \code
+ * # name       strategy             base         options
+ * DEVICE_POOL  DynamicPool          DEVICE       min_initial_alloc_size=4G min_alloc_size=64M
+ * SAFE_POOL    ThreadSafeAllocator  DEVICE_POOL
+ * READ_MOSTLY  AllocationAdvisor    UM           advice=READ_MOSTLY
+ * \endcode
+ *
+ * Lines are applied in order, so the base may be any Allocator defined
+ * earlier in the file. Sizes take an optional K, M, G or T suffix (powers
+ * of 1024). Anything after a '#' is ignored.
+ *
+ * Supported strategies and options:
+ * - DynamicPool: min_initial_alloc_size, min_alloc_size, policy
+ *   (first_fit, best_fit or segregated_fit), alignment, growth (fixed or
+ *   geometric), max_alloc_size, cache_coloring. The two minimum sizes may instead be a
+ *   percentage of free memory, e.g. min_initial_alloc_size=80%.
+ * - AlignedAllocator: alignment
+ * - ThreadSafeAllocator, ThreadCachingAllocator: none
+ * - AllocationAdvisor: advice, accessing_allocator
+ * - MonotonicAllocationStrategy: capacity
+ * - SlotPool: slots
+ * - SizeClassPool: slab_size
+ * - ArenaAllocator: block_size, alignment, track_allocations
+ * - ReclaimingAllocator: threshold
+ * - CompactingPool: chunk_size
+ * - CachingAllocator: granularity, max_cached_bytes
+ * - CommBufferPool: slab_size, alignment
+ * - SizedFixedPool: block_size, alignment, blocks_per_pool
+ *
+ * ResourceManager::getInstance() applies the file named by the
+ * UMPIRE_CONFIG environment variable, if it is set.
+ */
+class AllocatorConfiguration {
+  public:
+    struct Entry {
+      std::string name;
+      std::string strategy;
+      std::string base;
+      std::map<std::string, std::string> options;
+      int line;
+    };
+
+    /*!
+     * \brief Parse the configuration in filename.
+     *
+     * Throws an umpire::Exception if the file cannot be read or a line is
+     * malformed.
+     */
+    static AllocatorConfiguration fromFile(const std::string& filename);
+
+    static AllocatorConfiguration fromStream(std::istream& stream);
+
+    /*!
+     * \brief Create every Allocator in the configuration.
+     *
+     * Throws an umpire::Exception naming the offending line if a strategy
+     * or option is unknown, or an Allocator cannot be made.
+     */
+    void apply(ResourceManager& rm) const;
+
+    const std::vector<Entry>& getEntries() const;
+
+  private:
+    void makeAllocator(ResourceManager& rm, const Entry& entry) const;
+
+    std::vector<Entry> m_entries;
+};
+
+} // end of namespace umpire
+
+#endif // UMPIRE_AllocatorConfiguration_HPP
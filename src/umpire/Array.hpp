@@ -0,0 +1,185 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_Array_HPP
+#define UMPIRE_Array_HPP
+
+#include "umpire/Allocator.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace umpire {
+
+/*!
+ * \brief Contiguous array of trivially copyable objects in memory from an
+ * umpire::Allocator.
+ *
+ * Unlike std::vector with a TypedAllocator, an Array never constructs,
+ * initializes or touches its elements on the host, so it can hold DEVICE
+ * memory. New elements from resize are left uninitialized, growth goes
+ * through ResourceManager::reallocate, and copies between Arrays go
+ * through ResourceManager::copy, so they use whatever copy operation
+ * connects the two Allocators. Moves transfer ownership of the memory
+ * without copying.
+ *
+ * Element access through operator[], begin and end is only valid when
+ * the Allocator's memory is accessible from the host.
+ *
+ * \code
+ * umpire::Array<double> a(1024, rm.getAllocator("DEVICE"));
+ * umpire::Array<double> b(a, rm.getAllocator("HOST"));
+ *
+ * a.resize(2048);
+ * kernel<<<...>>>(a.data(), a.size());
+ * \endcode
+ */
+template<typename T>
+class Array {
+  static_assert(std::is_trivially_copyable<T>::value,
+      "umpire::Array only holds trivially copyable types");
+
+  public:
+  typedef T value_type;
+  typedef size_t size_type;
+  typedef T* iterator;
+  typedef const T* const_iterator;
+
+  /*!
+   * \brief Construct an empty Array that allocates from allocator.
+   */
+  explicit Array(Allocator allocator);
+
+  /*!
+   * \brief Construct an Array of size uninitialized elements.
+   */
+  Array(size_t size, Allocator allocator);
+
+  /*!
+   * \brief Construct a copy of other with memory from other's Allocator.
+   */
+  Array(const Array& other);
+
+  /*!
+   * \brief Construct a copy of other with memory from allocator.
+   */
+  Array(const Array& other, Allocator allocator);
+
+  /*!
+   * \brief Take other's memory and Allocator, leaving other empty.
+   */
+  Array(Array&& other) noexcept;
+
+  ~Array();
+
+  /*!
+   * \brief Copy other's elements into this Array's memory.
+   *
+   * This Array keeps its own Allocator, so assigning between Arrays on
+   * different Allocators copies the data across, e.g. from HOST to DEVICE.
+   */
+  Array& operator=(const Array& other);
+
+  /*!
+   * \brief Release this Array's memory and take other's memory and
+   * Allocator, leaving other empty.
+   */
+  Array& operator=(Array&& other) noexcept;
+
+  /*!
+   * \brief Copy other's elements into this Array, ordered on stream.
+   *
+   * As operator=, except copies involving CUDA memory are issued with
+   * cudaMemcpyAsync on stream and may not have completed on return; see
+   * ResourceManager::copy. Only the copy is asynchronous: any growth of
+   * this Array happens first.
+   *
+   * \param other Array to copy from.
+   * \param stream Stream to order the copy on, e.g. a cudaStream_t.
+   */
+  void assign(const Array& other, void* stream);
+
+  /*!
+   * \brief Change the number of elements to size.
+   *
+   * Elements up to the old size keep their values and new elements are
+   * left uninitialized. The capacity grows to exactly size if needed; use
+   * reserve to grow ahead of time.
+   */
+  void resize(size_t size);
+
+  /*!
+   * \brief Make sure the Array can hold capacity elements without
+   * reallocating.
+   */
+  void reserve(size_t capacity);
+
+  /*!
+   * \brief Reallocate so that the capacity matches the size.
+   */
+  void shrink_to_fit();
+
+  /*!
+   * \brief Set the size to zero, keeping the memory.
+   */
+  void clear() noexcept;
+
+  void swap(Array& other) noexcept;
+
+  T* data() noexcept;
+  const T* data() const noexcept;
+
+  size_t size() const noexcept;
+  size_t capacity() const noexcept;
+  bool empty() const noexcept;
+
+  T& operator[](size_t i);
+  const T& operator[](size_t i) const;
+
+  iterator begin() noexcept;
+  iterator end() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+
+  /*!
+   * \brief Return the Allocator this Array gets its memory from.
+   */
+  Allocator getAllocator() const;
+
+  private:
+    /*!
+     * \brief Set the capacity to exactly capacity elements.
+     */
+    void reallocate(size_t capacity);
+
+    /*!
+     * \brief Copy size elements from other, which must fit.
+     */
+    void copyFrom(const Array& other, size_t size);
+
+    umpire::Allocator m_allocator;
+
+    T* m_data;
+    size_t m_size;
+    size_t m_capacity;
+};
+
+template<typename T>
+void swap(Array<T>& lhs, Array<T>& rhs) noexcept;
+
+} // end of namespace umpire
+
+#include "umpire/Array.inl"
+
+#endif // UMPIRE_Array_HPP
@@ -0,0 +1,312 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_Array_INL
+#define UMPIRE_Array_INL
+
+#include "umpire/ResourceManager.hpp"
+
+#include "umpire/util/Macros.hpp"
+
+#include <utility>
+
+namespace umpire {
+
+template<typename T>
+Array<T>::Array(Allocator allocator) :
+  m_allocator(allocator),
+  m_data(nullptr),
+  m_size(0),
+  m_capacity(0)
+{
+}
+
+template<typename T>
+Array<T>::Array(size_t size, Allocator allocator) :
+  m_allocator(allocator),
+  m_data(nullptr),
+  m_size(0),
+  m_capacity(0)
+{
+  resize(size);
+}
+
+template<typename T>
+Array<T>::Array(const Array& other) :
+  Array(other, other.m_allocator)
+{
+}
+
+template<typename T>
+Array<T>::Array(const Array& other, Allocator allocator) :
+  m_allocator(allocator),
+  m_data(nullptr),
+  m_size(0),
+  m_capacity(0)
+{
+  reserve(other.m_size);
+  copyFrom(other, other.m_size);
+  m_size = other.m_size;
+}
+
+template<typename T>
+Array<T>::Array(Array&& other) noexcept :
+  m_allocator(other.m_allocator),
+  m_data(other.m_data),
+  m_size(other.m_size),
+  m_capacity(other.m_capacity)
+{
+  other.m_data = nullptr;
+  other.m_size = 0;
+  other.m_capacity = 0;
+}
+
+template<typename T>
+Array<T>::~Array()
+{
+  if (m_data) {
+    m_allocator.deallocate(m_data);
+  }
+}
+
+template<typename T>
+Array<T>&
+Array<T>::operator=(const Array& other)
+{
+  if (this != &other) {
+    // The old contents are overwritten, so grow with a fresh allocation
+    // rather than a reallocate that would copy them.
+    if (other.m_size > m_capacity) {
+      Array fresh(m_allocator);
+      fresh.reallocate(other.m_size);
+      swap(fresh);
+    }
+
+    copyFrom(other, other.m_size);
+    m_size = other.m_size;
+  }
+
+  return *this;
+}
+
+template<typename T>
+Array<T>&
+Array<T>::operator=(Array&& other) noexcept
+{
+  if (this != &other) {
+    Array moved(std::move(other));
+    swap(moved);
+  }
+
+  return *this;
+}
+
+template<typename T>
+void
+Array<T>::assign(const Array& other, void* stream)
+{
+  if (this == &other) {
+    return;
+  }
+
+  if (other.m_size > m_capacity) {
+    Array fresh(m_allocator);
+    fresh.reallocate(other.m_size);
+    swap(fresh);
+  }
+
+  if (other.m_size > 0) {
+    auto& rm = ResourceManager::getInstance();
+    rm.copy(m_data, other.m_data, other.m_size*sizeof(T), stream);
+  }
+
+  m_size = other.m_size;
+}
+
+template<typename T>
+void
+Array<T>::resize(size_t size)
+{
+  reserve(size);
+  m_size = size;
+}
+
+template<typename T>
+void
+Array<T>::reserve(size_t capacity)
+{
+  if (capacity > m_capacity) {
+    reallocate(capacity);
+  }
+}
+
+template<typename T>
+void
+Array<T>::shrink_to_fit()
+{
+  if (m_capacity > m_size) {
+    reallocate(m_size);
+  }
+}
+
+template<typename T>
+void
+Array<T>::clear() noexcept
+{
+  m_size = 0;
+}
+
+template<typename T>
+void
+Array<T>::swap(Array& other) noexcept
+{
+  std::swap(m_allocator, other.m_allocator);
+  std::swap(m_data, other.m_data);
+  std::swap(m_size, other.m_size);
+  std::swap(m_capacity, other.m_capacity);
+}
+
+template<typename T>
+T*
+Array<T>::data() noexcept
+{
+  return m_data;
+}
+
+template<typename T>
+const T*
+Array<T>::data() const noexcept
+{
+  return m_data;
+}
+
+template<typename T>
+size_t
+Array<T>::size() const noexcept
+{
+  return m_size;
+}
+
+template<typename T>
+size_t
+Array<T>::capacity() const noexcept
+{
+  return m_capacity;
+}
+
+template<typename T>
+bool
+Array<T>::empty() const noexcept
+{
+  return m_size == 0;
+}
+
+template<typename T>
+T&
+Array<T>::operator[](size_t i)
+{
+  return m_data[i];
+}
+
+template<typename T>
+const T&
+Array<T>::operator[](size_t i) const
+{
+  return m_data[i];
+}
+
+template<typename T>
+typename Array<T>::iterator
+Array<T>::begin() noexcept
+{
+  return m_data;
+}
+
+template<typename T>
+typename Array<T>::iterator
+Array<T>::end() noexcept
+{
+  return m_data + m_size;
+}
+
+template<typename T>
+typename Array<T>::const_iterator
+Array<T>::begin() const noexcept
+{
+  return m_data;
+}
+
+template<typename T>
+typename Array<T>::const_iterator
+Array<T>::end() const noexcept
+{
+  return m_data + m_size;
+}
+
+template<typename T>
+Allocator
+Array<T>::getAllocator() const
+{
+  return m_allocator;
+}
+
+template<typename T>
+void
+Array<T>::reallocate(size_t capacity)
+{
+  if (capacity == 0) {
+    if (m_data) {
+      m_allocator.deallocate(m_data);
+    }
+    m_data = nullptr;
+  } else {
+    // Copies only the old allocation's bytes, and the pool strategies
+    // resize in place when they can.
+    auto& rm = ResourceManager::getInstance();
+    m_data = static_cast<T*>(
+        rm.reallocate(m_data, capacity*sizeof(T), m_allocator));
+  }
+
+  m_capacity = capacity;
+  if (m_size > capacity) {
+    m_size = capacity;
+  }
+}
+
+template<typename T>
+void
+Array<T>::copyFrom(const Array& other, size_t size)
+{
+  if (size == 0) {
+    return;
+  }
+
+  // Both Allocators are known, so skip the lookups of the pointer copy.
+  auto& rm = ResourceManager::getInstance();
+  Allocator src_allocator(other.m_allocator);
+  rm.copy(m_data, m_allocator,
+      other.m_data, src_allocator,
+      size*sizeof(T));
+}
+
+template<typename T>
+void
+swap(Array<T>& lhs, Array<T>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // end of namespace umpire
+
+#endif // UMPIRE_Array_INL
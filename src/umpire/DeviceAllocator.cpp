@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/DeviceAllocator.hpp"
+
+#include "umpire/ResourceManager.hpp"
+
+#include "umpire/util/Macros.hpp"
+
+#include <cuda_runtime_api.h>
+
+namespace umpire {
+
+const std::size_t DeviceAllocator::alignment;
+
+DeviceAllocator::DeviceAllocator(Allocator allocator, std::size_t size) :
+  m_allocator_id(allocator.getId()),
+  m_ptr(nullptr),
+  m_counter(nullptr),
+  m_size(size)
+{
+  UMPIRE_LOG(Debug, "(allocator=" << allocator.getName() << ", size=" << size << ")");
+
+  if (allocator.getPlatform() != Platform::cuda) {
+    UMPIRE_ERROR("DeviceAllocator needs memory the device can use, "
+        << allocator.getName() << " is not cuda memory");
+  }
+
+  // The counter sits in front of the memory handed out, in its own
+  // aligned slot.
+  char* memory = static_cast<char*>(allocator.allocate(alignment + size));
+
+  m_counter = reinterpret_cast<unsigned long long*>(memory);
+  m_ptr = memory + alignment;
+
+  reset();
+}
+
+void
+DeviceAllocator::reset()
+{
+  UMPIRE_LOG(Debug, "()");
+
+  cudaError_t error = ::cudaMemset(m_counter, 0, sizeof(unsigned long long));
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaMemset failed with error: " << cudaGetErrorString(error));
+  }
+}
+
+void
+DeviceAllocator::destroy()
+{
+  UMPIRE_LOG(Debug, "()");
+
+  if (m_counter) {
+    ResourceManager::getInstance().getAllocator(m_allocator_id).deallocate(m_counter);
+    m_counter = nullptr;
+    m_ptr = nullptr;
+  }
+}
+
+std::size_t
+DeviceAllocator::getCurrentSize() const
+{
+  unsigned long long offset = 0;
+
+  cudaError_t error = ::cudaMemcpy(
+      &offset, m_counter, sizeof(unsigned long long), cudaMemcpyDeviceToHost);
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaMemcpy failed with error: " << cudaGetErrorString(error));
+  }
+
+  return static_cast<std::size_t>(offset);
+}
+
+} // end of namespace umpire
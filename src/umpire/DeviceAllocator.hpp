@@ -0,0 +1,118 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_DeviceAllocator_HPP
+#define UMPIRE_DeviceAllocator_HPP
+
+#include "umpire/Allocator.hpp"
+
+#include <cstddef>
+
+#if defined(__CUDACC__)
+#define UMPIRE_HOST_DEVICE __host__ __device__
+#else
+#define UMPIRE_HOST_DEVICE
+#endif
+
+namespace umpire {
+
+/*!
+ * \brief A bump allocator that kernels can allocate scratch memory from.
+ *
+ * The memory is taken from an Allocator up front, which must return memory
+ * the device can use (DEVICE, UM or a pool over them). In device code,
+ * allocate claims the next bytes with a single atomicAdd on a counter kept
+ * in device memory, which is much faster than device malloc and not limited
+ * by its heap size. Nothing is freed individually; reset() on the host,
+ * once the kernels using the allocator have finished, reclaims everything.
+ *
+ * A DeviceAllocator is passed to kernels by value. Copies share the same
+ * memory, so it is not freed by a destructor: call destroy() on the host
+ * when it is no longer needed.
+ *
+ * \code
+ * umpire::DeviceAllocator scratch(rm.getAllocator("DEVICE_POOL"), 256*1024*1024);
+ *
+ * __global__ void build(umpire::DeviceAllocator scratch, ...)
+ * {
+ *   int* neighbors = static_cast<int*>(scratch.allocate(count*sizeof(int)));
+ *   ...
+ * }
+ *
+ * build<<<blocks, threads>>>(scratch, ...);
+ * cudaDeviceSynchronize();
+ * scratch.reset();
+ * \endcode
+ */
+class DeviceAllocator {
+  public:
+    /*!
+     * \brief Alignment of every allocation.
+     */
+    static const std::size_t alignment = 16;
+
+    /*!
+     * \param allocator Allocator to take the memory from.
+     * \param size Number of bytes kernels can allocate between resets.
+     */
+    DeviceAllocator(Allocator allocator, std::size_t size);
+
+#if defined(__CUDACC__)
+    /*!
+     * \brief Allocate bytes from device code.
+     *
+     * \return Pointer to the allocation, or nullptr if the allocator does
+     * not have bytes left.
+     */
+    __device__ void* allocate(std::size_t bytes) const
+    {
+      const unsigned long long aligned = (bytes + alignment - 1) & ~(alignment - 1);
+      const unsigned long long offset = atomicAdd(m_counter, aligned);
+
+      return (offset + aligned <= m_size) ? m_ptr + offset : nullptr;
+    }
+#endif
+
+    /*!
+     * \brief Free everything allocated so far.
+     *
+     * Must not be called while a kernel using the allocator is running.
+     */
+    void reset();
+
+    /*!
+     * \brief Return the memory to the Allocator it came from.
+     */
+    void destroy();
+
+    /*!
+     * \brief Return the number of bytes allocated since the last reset.
+     *
+     * Copies the counter from the device. Requests that did not fit are
+     * counted, so this may exceed getSize() when allocations failed.
+     */
+    std::size_t getCurrentSize() const;
+
+    UMPIRE_HOST_DEVICE std::size_t getSize() const { return m_size; }
+
+  private:
+    int m_allocator_id;
+    char* m_ptr;
+    unsigned long long* m_counter;
+    std::size_t m_size;
+};
+
+} // end of namespace umpire
+
+#endif // UMPIRE_DeviceAllocator_HPP
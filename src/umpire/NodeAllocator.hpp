@@ -0,0 +1,126 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_NodeAllocator_HPP
+#define UMPIRE_NodeAllocator_HPP
+
+#include "umpire/Allocator.hpp"
+#include "umpire/ResourceManager.hpp"
+
+#include "umpire/strategy/FixedPool.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace umpire {
+
+namespace detail {
+
+/*!
+ * \brief Block type for node pools.
+ *
+ * Depends only on size and alignment, so node types that agree on both map
+ * to the same FixedPool type and can share a pool.
+ */
+template<size_t Size, size_t Alignment>
+struct NodeBlock {
+  typename std::aligned_storage<Size, Alignment>::type data;
+};
+
+} // end of namespace detail
+
+/*!
+ * \brief C++11 allocator for node containers that puts single-object
+ * allocations in a FixedPool.
+ *
+ * std::list, std::map, std::set and the unordered containers allocate one
+ * node at a time. A NodeAllocator serves each of those from a FixedPool of
+ * blocks of exactly sizeof(T), so nodes are packed together instead of
+ * being scattered across the underlying Allocator. Requests for more than
+ * one object, such as a hash table's bucket array, go to the underlying
+ * Allocator directly.
+ *
+ * The pool is made through the ResourceManager on first use and named
+ * after the underlying Allocator, the block size and the block alignment,
+ * so every NodeAllocator on the same Allocator shares pools with the other
+ * node types of the same size and alignment.
+ *
+ * FixedPool is not thread-safe, so containers on the same Allocator that
+ * are used from different threads need external synchronization.
+ *
+ * \code
+ * umpire::NodeAllocator<std::pair<const int, double>> alloc(
+ *     rm.getAllocator("HOST"));
+ * std::map<int, double, std::less<int>,
+ *     umpire::NodeAllocator<std::pair<const int, double>>> map(alloc);
+ * \endcode
+ */
+template<typename T>
+class NodeAllocator {
+  template<typename U> friend class NodeAllocator;
+
+  public:
+  typedef T value_type;
+
+  typedef std::true_type propagate_on_container_copy_assignment;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  template<typename U>
+  struct rebind {
+    typedef NodeAllocator<U> other;
+  };
+
+  NodeAllocator(Allocator allocator);
+
+  template<typename U>
+  NodeAllocator(const NodeAllocator<U>& other);
+
+  T* allocate(size_t size);
+
+  void deallocate(T* ptr, size_t size);
+
+  /*!
+   * \brief Return the Allocator that pools and larger requests get their
+   * memory from.
+   */
+  Allocator getAllocator() const;
+
+  private:
+    typedef strategy::FixedPool<detail::NodeBlock<sizeof(T), alignof(T)>> Pool;
+
+    /*!
+     * \brief Find or make the pool for this node size, on first call.
+     */
+    Pool* getPool();
+
+    umpire::Allocator m_allocator;
+
+    /*!
+     * \brief Pool for single objects, owned by the ResourceManager.
+     */
+    Pool* m_pool;
+};
+
+template<typename T, typename U>
+bool operator==(const NodeAllocator<T>& lhs, const NodeAllocator<U>& rhs);
+
+template<typename T, typename U>
+bool operator!=(const NodeAllocator<T>& lhs, const NodeAllocator<U>& rhs);
+
+} // end of namespace umpire
+
+#include "umpire/NodeAllocator.inl"
+
+#endif // UMPIRE_NodeAllocator_HPP
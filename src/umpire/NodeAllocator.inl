@@ -0,0 +1,118 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_NodeAllocator_INL
+#define UMPIRE_NodeAllocator_INL
+
+#include "umpire/NodeAllocator.hpp"
+
+#include "umpire/util/Exception.hpp"
+#include "umpire/util/Macros.hpp"
+
+#include <string>
+
+namespace umpire {
+
+template<typename T>
+NodeAllocator<T>::NodeAllocator(Allocator allocator) :
+  m_allocator(allocator),
+  m_pool(nullptr)
+{
+}
+
+template<typename T>
+template<typename U>
+NodeAllocator<T>::NodeAllocator(const NodeAllocator<U>& other) :
+  m_allocator(other.m_allocator),
+  m_pool(nullptr)
+{
+}
+
+template<typename T>
+T*
+NodeAllocator<T>::allocate(size_t size)
+{
+  if (size == 1) {
+    return static_cast<T*>(getPool()->allocate(sizeof(T)));
+  }
+
+  return static_cast<T*>(m_allocator.allocate(sizeof(T)*size));
+}
+
+template<typename T>
+void
+NodeAllocator<T>::deallocate(T* ptr, size_t size)
+{
+  if (size == 1) {
+    getPool()->deallocate(ptr);
+  } else {
+    m_allocator.deallocate(ptr);
+  }
+}
+
+template<typename T>
+Allocator
+NodeAllocator<T>::getAllocator() const
+{
+  return m_allocator;
+}
+
+template<typename T>
+typename NodeAllocator<T>::Pool*
+NodeAllocator<T>::getPool()
+{
+  if (m_pool) {
+    return m_pool;
+  }
+
+  auto& rm = ResourceManager::getInstance();
+
+  const std::string name = m_allocator.getName()
+    + "_node_pool_" + std::to_string(sizeof(T))
+    + "_" + std::to_string(alignof(T));
+
+  if (!rm.isAllocator(name)) {
+    try {
+      rm.makeAllocator<Pool>(name, m_allocator);
+    } catch (util::Exception&) {
+      // Another thread made the pool first.
+    }
+  }
+
+  m_pool = dynamic_cast<Pool*>(rm.getAllocator(name).getAllocationStrategy().get());
+
+  if (!m_pool) {
+    UMPIRE_ERROR("Allocator " << name << " is not a node pool");
+  }
+
+  return m_pool;
+}
+
+template<typename T, typename U>
+bool
+operator==(const NodeAllocator<T>& lhs, const NodeAllocator<U>& rhs)
+{
+  return lhs.getAllocator().getAllocationStrategy() == rhs.getAllocator().getAllocationStrategy();
+}
+
+template<typename T, typename U>
+bool
+operator!=(const NodeAllocator<T>& lhs, const NodeAllocator<U>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+} // end of namespace umpire
+
+#endif // UMPIRE_NodeAllocator_INL
@@ -16,50 +16,303 @@
 
 #include "umpire/ResourceManager.hpp"
 
+#include "umpire/AllocatorConfiguration.hpp"
+
 #include "umpire/resource/MemoryResourceRegistry.hpp"
 
 #include "umpire/resource/HostResourceFactory.hpp"
+#include "umpire/resource/ExternalResourceFactory.hpp"
+#include "umpire/resource/ExternalMemoryResource.hpp"
+#include "umpire/resource/CowMemoryResource.hpp"
+#include "umpire/resource/HugePageResourceFactory.hpp"
+#include "umpire/resource/FileResourceFactory.hpp"
+#include "umpire/resource/SharedMemoryResourceFactory.hpp"
 #if defined(UMPIRE_ENABLE_CUDA)
 #include "umpire/resource/DeviceResourceFactory.hpp"
 #include "umpire/resource/UnifiedMemoryResourceFactory.hpp"
 #include "umpire/resource/PinnedMemoryResourceFactory.hpp"
+#include "umpire/resource/HostRegisteredMemoryResource.hpp"
+#include "umpire/resource/DeviceIpcMemoryResource.hpp"
+
+#include <cuda_runtime_api.h>
+#endif
+
+#if defined(UMPIRE_ENABLE_CUDA_MALLOC_ASYNC)
+#include "umpire/resource/DeviceAsyncResourceFactory.hpp"
+#endif
+
+#if defined(UMPIRE_ENABLE_HIP)
+#include "umpire/resource/HipDeviceResourceFactory.hpp"
+#include "umpire/resource/HipUnifiedMemoryResourceFactory.hpp"
+#include "umpire/resource/HipPinnedMemoryResourceFactory.hpp"
+
+#include <hip/hip_runtime_api.h>
+#endif
+
+#if defined(UMPIRE_ENABLE_NUMA)
+#include "umpire/resource/NumaResourceFactory.hpp"
+#include "umpire/alloc/NumaAllocator.hpp"
+#endif
+
+#if defined(UMPIRE_ENABLE_CUDA) && defined(UMPIRE_ENABLE_NUMA)
+#include "umpire/resource/NumaPinnedMemoryResourceFactory.hpp"
+#endif
+
+#if defined(UMPIRE_ENABLE_MEMKIND)
+#include "umpire/resource/HbmResourceFactory.hpp"
+#include "umpire/alloc/MemkindAllocator.hpp"
+#endif
+
+#if defined(UMPIRE_ENABLE_OPENMP_TARGET)
+#include <omp.h>
+
+#include "umpire/resource/OpenMPTargetResourceFactory.hpp"
 #endif
+
 #include "umpire/op/MemoryOperationRegistry.hpp"
 
+#include "umpire/strategy/DynamicPool.hpp"
+#include "umpire/strategy/ThreadSafeAllocator.hpp"
+
 #include "umpire/util/Macros.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <thread>
+
 namespace umpire {
 
-ResourceManager* ResourceManager::s_resource_manager_instance = nullptr;
+namespace {
+
+/*
+ * Number of independently locked shards used by the AllocationMap, so that
+ * pointer lookups from many threads do not serialize on a single mutex.
+ */
+const std::size_t s_allocation_map_shards = 32;
+
+/*
+ * Chunk sizes of the PINNED_POOL allocator. Pinned memory is a scarce
+ * resource, so the pool starts small and grows in steps large enough to
+ * hold a few typical staging buffers.
+ */
+const std::size_t s_pinned_pool_initial_size = 64 * 1024 * 1024;
+const std::size_t s_pinned_pool_min_size = 8 * 1024 * 1024;
+
+std::once_flag s_resource_manager_created;
+
+/*
+ * The ResourceManager being configured by getInstance, on the thread that
+ * configures it. Strategies look up the ResourceManager as they are built,
+ * so that thread must see the instance before it is published; every other
+ * thread waits in call_once until configuration has finished.
+ */
+thread_local ResourceManager* t_configuring_instance = nullptr;
+
+/*
+ * Default Allocator of the calling thread, overriding the global one when
+ * set. There is only one ResourceManager, so one slot per thread does.
+ */
+thread_local std::shared_ptr<strategy::AllocationStrategy> t_default_allocator;
+
+/*
+ * True if name can only be one of the resources made by
+ * getDeviceResources.
+ */
+bool isPerDeviceName(const std::string& name)
+{
+  return name.compare(0, 8, "DEVICE::") == 0
+    || name.compare(0, 8, "PINNED::") == 0
+    || name.compare(0, 13, "PINNED_POOL::") == 0;
+}
+
+/*
+ * Run work(device) for every device on a thread of its own, with that
+ * device current, and wait for all of them. Creating a context and making
+ * the first large allocation on a device take long enough that doing the
+ * devices one after another adds up on a node with many GPUs. The first
+ * exception thrown by any device is rethrown once they have all finished.
+ */
+void forEachDevice(int device_count, const std::function<void(int)>& work)
+{
+  std::vector<std::exception_ptr> errors(device_count);
+  std::vector<std::thread> threads;
+
+  for (int device = 0; device < device_count; ++device) {
+    threads.emplace_back([&work, &errors, device] {
+      try {
+#if defined(UMPIRE_ENABLE_CUDA)
+        ::cudaSetDevice(device);
+        ::cudaFree(nullptr);
+#elif defined(UMPIRE_ENABLE_HIP)
+        ::hipSetDevice(device);
+        ::hipFree(nullptr);
+#endif
+        work(device);
+      } catch (...) {
+        errors[device] = std::current_exception();
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+} // end of anonymous namespace
+
+std::atomic<ResourceManager*> ResourceManager::s_resource_manager_instance(nullptr);
 
 ResourceManager&
 ResourceManager::getInstance()
 {
-  if (!s_resource_manager_instance) {
-    s_resource_manager_instance = new ResourceManager();
+  ResourceManager* instance = s_resource_manager_instance.load(std::memory_order_acquire);
+
+  if (!instance && t_configuring_instance) {
+    return *t_configuring_instance;
+  }
+
+  if (!instance) {
+    std::call_once(s_resource_manager_created, [] {
+      // If configuration throws, call_once lets the next caller try again
+      // with a new instance. The failed one is never published, and is
+      // leaked since its strategies may still be referenced.
+      ResourceManager* resource_manager = new ResourceManager();
+      t_configuring_instance = resource_manager;
+
+      struct ConfiguringGuard {
+        ~ConfiguringGuard() { t_configuring_instance = nullptr; }
+      } guard;
+
+      const char* profile = std::getenv("UMPIRE_PROFILE");
+      if (profile && *profile) {
+        resource_manager->useProfile(profile);
+      }
+
+      const char* config = std::getenv("UMPIRE_CONFIG");
+      if (config && *config) {
+        resource_manager->configure(config);
+      }
+
+      const char* samples = std::getenv("UMPIRE_USAGE_SAMPLER_FILE");
+      if (samples && *samples) {
+        const char* interval = std::getenv("UMPIRE_USAGE_SAMPLER_INTERVAL");
+        resource_manager->startUsageSampler(samples,
+            (interval && *interval) ? std::atoi(interval) : 100);
+      }
+
+      s_resource_manager_instance.store(resource_manager, std::memory_order_release);
+    });
+
+    instance = s_resource_manager_instance.load(std::memory_order_acquire);
+  }
+
+  UMPIRE_LOG(Debug, "() returning " << instance);
+  return *instance;
+}
+
+ResourceManager::AllocatorNameTable::AllocatorNameTable(size_t num_buckets) :
+  mask(num_buckets - 1),
+  size(0),
+  buckets(new std::atomic<const AllocatorNameNode*>[num_buckets])
+{
+  for (size_t i = 0; i < num_buckets; ++i) {
+    buckets[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+ResourceManager::AllocatorNameTable::~AllocatorNameTable()
+{
+  for (size_t i = 0; i <= mask; ++i) {
+    const AllocatorNameNode* node = buckets[i].load(std::memory_order_relaxed);
+    while (node) {
+      const AllocatorNameNode* next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+}
+
+const ResourceManager::AllocatorNameNode*
+ResourceManager::AllocatorNameTable::find(const std::string& name) const
+{
+  const AllocatorNameNode* node =
+    buckets[std::hash<std::string>()(name) & mask].load(std::memory_order_acquire);
+
+  while (node && node->name != name) {
+    node = node->next;
   }
 
-  UMPIRE_LOG(Debug, "() returning " << s_resource_manager_instance);
-  return *s_resource_manager_instance;
+  return node;
+}
+
+void
+ResourceManager::AllocatorNameTable::insert(const std::string& name,
+    const std::shared_ptr<strategy::AllocationStrategy>& strategy)
+{
+  std::atomic<const AllocatorNameNode*>& bucket =
+    buckets[std::hash<std::string>()(name) & mask];
+
+  bucket.store(
+      new AllocatorNameNode{name, strategy, bucket.load(std::memory_order_relaxed)},
+      std::memory_order_release);
+  ++size;
 }
 
 ResourceManager::ResourceManager() :
   m_allocator_names(),
-  m_allocators_by_name(),
-  m_allocators_by_id(),
-  m_allocations(),
+  m_allocators_by_name(nullptr),
+  m_allocator_name_tables(),
+  m_allocations(s_allocation_map_shards),
+  m_chunks(),
   m_default_allocator(),
-  m_memory_resources(),
+  m_lazy_resources(),
+  m_device_resources_created(),
+  m_device_resources(),
   m_id(0),
-  m_mutex(new std::mutex())
+  m_mutex(new std::mutex()),
+  m_pending_moves(),
+  m_pending_moves_mutex(),
+  m_profile_filename(),
+  m_profile(),
+  m_usage_sampler_mutex(),
+  m_usage_sampler(),
+  m_copy_pool_mutex(),
+  m_copy_pool()
 {
   UMPIRE_LOG(Debug, "() entering");
+  for (auto& chunk : m_allocators_by_id) {
+    chunk.store(nullptr, std::memory_order_relaxed);
+  }
+
   resource::MemoryResourceRegistry& registry =
     resource::MemoryResourceRegistry::getInstance();
 
   registry.registerMemoryResource(
       std::make_shared<resource::HostResourceFactory>());
 
+  registry.registerMemoryResource(
+      std::make_shared<resource::HugePageResourceFactory>());
+
+  registry.registerMemoryResource(
+      std::make_shared<resource::FileResourceFactory>());
+
+  registry.registerMemoryResource(
+      std::make_shared<resource::SharedMemoryResourceFactory>());
+
+  registry.registerMemoryResource(
+      std::make_shared<resource::ExternalResourceFactory>());
+
 #if defined(UMPIRE_ENABLE_CUDA)
   registry.registerMemoryResource(
     std::make_shared<resource::DeviceResourceFactory>());
@@ -71,6 +324,42 @@ ResourceManager::ResourceManager() :
     std::make_shared<resource::PinnedMemoryResourceFactory>());
 #endif
 
+#if defined(UMPIRE_ENABLE_CUDA_MALLOC_ASYNC)
+  registry.registerMemoryResource(
+    std::make_shared<resource::DeviceAsyncResourceFactory>());
+#endif
+
+#if defined(UMPIRE_ENABLE_HIP)
+  registry.registerMemoryResource(
+    std::make_shared<resource::HipDeviceResourceFactory>());
+
+  registry.registerMemoryResource(
+    std::make_shared<resource::HipUnifiedMemoryResourceFactory>());
+
+  registry.registerMemoryResource(
+    std::make_shared<resource::HipPinnedMemoryResourceFactory>());
+#endif
+
+#if defined(UMPIRE_ENABLE_NUMA)
+  registry.registerMemoryResource(
+    std::make_shared<resource::NumaResourceFactory>());
+#endif
+
+#if defined(UMPIRE_ENABLE_CUDA) && defined(UMPIRE_ENABLE_NUMA)
+  registry.registerMemoryResource(
+    std::make_shared<resource::NumaPinnedMemoryResourceFactory>());
+#endif
+
+#if defined(UMPIRE_ENABLE_MEMKIND)
+  registry.registerMemoryResource(
+    std::make_shared<resource::HbmResourceFactory>());
+#endif
+
+#if defined(UMPIRE_ENABLE_OPENMP_TARGET)
+  registry.registerMemoryResource(
+    std::make_shared<resource::OpenMPTargetResourceFactory>());
+#endif
+
   initialize();
   UMPIRE_LOG(Debug, "() leaving");
 }
@@ -82,211 +371,1353 @@ ResourceManager::initialize()
   resource::MemoryResourceRegistry& registry =
     resource::MemoryResourceRegistry::getInstance();
 
-  m_memory_resources[resource::Host] = registry.makeMemoryResource("HOST", getNextId());
+  /*
+   * HOST is the default allocator, so it is made now. Every other resource
+   * is made the first time it is asked for: creating the CUDA resources
+   * initializes CUDA, which programs that only use HOST should not pay for.
+   * Their ids are reserved here so that they do not depend on the order in
+   * which resources are first used.
+   */
+  auto host_allocator = registry.makeMemoryResource("HOST", getNextId());
+  addAllocator("HOST", host_allocator);
+
+  m_default_allocator = host_allocator;
+
+  std::vector<std::string> lazy_names;
+
+  lazy_names.push_back("EXTERNAL_HOST");
 
 #if defined(UMPIRE_ENABLE_CUDA)
-  m_memory_resources[resource::Device] = registry.makeMemoryResource("DEVICE", getNextId());
-  m_memory_resources[resource::UnifiedMemory] = registry.makeMemoryResource("UM", getNextId());
-  m_memory_resources[resource::PinnedMemory] = registry.makeMemoryResource("PINNED", getNextId());
+  lazy_names.push_back("EXTERNAL_DEVICE");
+  lazy_names.push_back("EXTERNAL_UM");
+  lazy_names.push_back("EXTERNAL_PINNED");
+  lazy_names.push_back("DEVICE");
+  lazy_names.push_back("UM");
+  lazy_names.push_back("PINNED");
+  lazy_names.push_back("PINNED_MAPPED");
+  lazy_names.push_back("PINNED_POOL");
+  lazy_names.push_back("HOST_REGISTERED");
+  lazy_names.push_back("DEVICE_IPC");
 #endif
 
+#if defined(UMPIRE_ENABLE_CUDA_MALLOC_ASYNC)
+  lazy_names.push_back("DEVICE_ASYNC");
+#endif
+
+#if defined(UMPIRE_ENABLE_HIP)
+  lazy_names.push_back("DEVICE");
+  lazy_names.push_back("UM");
+  lazy_names.push_back("PINNED");
+  lazy_names.push_back("PINNED_MAPPED");
+  lazy_names.push_back("PINNED_POOL");
+#endif
+
+  for (const std::string name : {"HOST_HUGEPAGE", "HOST_HUGETLB", "HOST_HUGETLB_1GB"}) {
+    lazy_names.push_back(name);
+  }
+
+  lazy_names.push_back("FILE");
+  lazy_names.push_back("SHARED");
+  lazy_names.push_back("HOST_COW");
+
+#if defined(UMPIRE_ENABLE_NUMA)
   /*
-   * Construct default allocators for each resource
+   * One resource per NUMA node, plus one interleaved across all nodes.
    */
-  auto host_allocator = m_memory_resources[resource::Host];
-  m_allocators_by_name["HOST"] = host_allocator;
-  m_allocators_by_id[host_allocator->getId()] = host_allocator;
+  std::vector<int> numa_nodes = alloc::NumaAllocator::getNodes();
+  if (!numa_nodes.empty()) {
+    for (int node : numa_nodes) {
+      lazy_names.push_back("HOST_NUMA" + std::to_string(node));
+    }
+    lazy_names.push_back("HOST_NUMA_INTERLEAVED");
+  }
+#endif
 
-  m_default_allocator = host_allocator;
+#if defined(UMPIRE_ENABLE_MEMKIND)
+  if (alloc::MemkindAllocator::isAvailable()) {
+    lazy_names.push_back("HBM");
+  }
+#endif
+
+#if defined(UMPIRE_ENABLE_OPENMP_TARGET)
+  /*
+   * The default offload device, plus one resource per device number.
+   */
+  lazy_names.push_back("OMP_TARGET");
+  for (int device = 0; device < ::omp_get_num_devices(); ++device) {
+    lazy_names.push_back("OMP_TARGET::" + std::to_string(device));
+  }
+#endif
+
+  for (const auto& name : lazy_names) {
+    std::unique_ptr<LazyResource> lazy(new LazyResource());
+    lazy->name = name;
+    lazy->id = getNextId();
+    m_lazy_resources.push_back(std::move(lazy));
+  }
+
+  UMPIRE_LOG(Debug, "() leaving");
+}
+
+ResourceManager::LazyResource*
+ResourceManager::findLazyResource(const std::string& name)
+{
+  for (auto& lazy : m_lazy_resources) {
+    if (lazy->name == name) {
+      return lazy.get();
+    }
+  }
+
+  return nullptr;
+}
 
+std::shared_ptr<strategy::AllocationStrategy>&
+ResourceManager::getLazyResource(LazyResource& lazy)
+{
+  std::call_once(lazy.created, [&] {
+    UMPIRE_LOG(Debug, "Making MemoryResource " << lazy.name);
+    if (lazy.name == "PINNED_POOL") {
+      lazy.resource = makePinnedPool(lazy.name, lazy.id, getAllocator("PINNED"));
+    } else if (lazy.name == "HOST_COW") {
+      lazy.resource = std::make_shared<resource::CowMemoryResource>(
+          lazy.name, lazy.id);
 #if defined(UMPIRE_ENABLE_CUDA)
+    } else if (lazy.name == "HOST_REGISTERED") {
+      lazy.resource = std::make_shared<resource::HostRegisteredMemoryResource>(
+          lazy.name, lazy.id);
+    } else if (lazy.name == "DEVICE_IPC") {
+      lazy.resource = std::make_shared<resource::DeviceIpcMemoryResource>(
+          lazy.name, lazy.id);
+#endif
+    } else {
+      lazy.resource = resource::MemoryResourceRegistry::getInstance().makeMemoryResource(
+          lazy.name, lazy.id);
+    }
+    addAllocatorId(lazy.resource);
+  });
+
+  return lazy.resource;
+}
+
+std::shared_ptr<strategy::AllocationStrategy>
+ResourceManager::makePinnedPool(const std::string& name, int id, Allocator pinned)
+{
   /*
-   *  strategy::AllocationStrategyRegistry& strategy_registry =
-   *    strategy::AllocationStrategyRegistry::getInstance();
-   *
-   *  m_allocators_by_name["DEVICE"] = strategy_registry.makeAllocationStrategy("POOL", {}, {m_memory_resources["DEVICE"]});
+   * Staging buffers come in a handful of sizes that are reused over and
+   * over, so the segregated-fit policy finds a block of the right size
+   * class in constant time. The pool itself is not registered by name;
+   * users see the thread-safe wrapper.
    */
+  Allocator pool(std::make_shared<strategy::DynamicPool>(
+      name + "::pool", getNextId(), pinned,
+      s_pinned_pool_initial_size, s_pinned_pool_min_size,
+      PlacementPolicy::segregated_fit));
 
-  auto device_allocator = m_memory_resources[resource::Device];
-  m_allocators_by_name["DEVICE"] = device_allocator;
-  m_allocators_by_id[device_allocator->getId()] = device_allocator;
+  return std::make_shared<strategy::ThreadSafeAllocator>(name, id, pool);
+}
 
-  auto um_allocator = m_memory_resources[resource::UnifiedMemory];
-  m_allocators_by_name["UM"] = um_allocator;
-  m_allocators_by_id[um_allocator->getId()] = um_allocator;
+std::vector<std::shared_ptr<strategy::AllocationStrategy> >&
+ResourceManager::getDeviceResources()
+{
+  std::call_once(m_device_resources_created, [&] {
+#if defined(UMPIRE_ENABLE_CUDA)
+    /*
+     * One resource per device, which makes the device current around each
+     * allocation so every GPU's memory can be pooled and tracked separately.
+     */
+    int device_count = 0;
+    if (::cudaGetDeviceCount(&device_count) != cudaSuccess) {
+      device_count = 0;
+    }
 
-  auto pinned_allocator = m_memory_resources[resource::PinnedMemory];
-  m_allocators_by_name["PINNED"] = pinned_allocator;
-  m_allocators_by_id[pinned_allocator->getId()] = pinned_allocator;
+    resource::MemoryResourceRegistry& registry =
+      resource::MemoryResourceRegistry::getInstance();
+
+#if defined(UMPIRE_ENABLE_NUMA)
+    /*
+     * DEVICE::n, then staging memory on the socket nearest the device, so
+     * host to device copies do not cross the inter-socket link.
+     */
+    const int per_device = 3;
+#else
+    const int per_device = 1;
 #endif
-  UMPIRE_LOG(Debug, "() leaving");
+
+    // Ids are handed out in device order, whichever device is ready first.
+    std::vector<int> ids(device_count * per_device);
+    for (auto& id : ids) {
+      id = getNextId();
+    }
+
+    m_device_resources.assign(device_count * per_device, nullptr);
+
+    forEachDevice(device_count, [&] (int device) {
+      const std::string suffix = "::" + std::to_string(device);
+      const int first = device * per_device;
+
+      m_device_resources[first] =
+        registry.makeMemoryResource("DEVICE" + suffix, ids[first]);
+
+#if defined(UMPIRE_ENABLE_NUMA)
+      auto pinned = registry.makeMemoryResource("PINNED" + suffix, ids[first + 1]);
+      m_device_resources[first + 1] = pinned;
+      m_device_resources[first + 2] =
+        makePinnedPool("PINNED_POOL" + suffix, ids[first + 2], Allocator(pinned));
+#endif
+    });
+
+    for (auto& resource : m_device_resources) {
+      addAllocatorId(resource);
+    }
+#elif defined(UMPIRE_ENABLE_HIP)
+    int device_count = 0;
+    if (::hipGetDeviceCount(&device_count) != hipSuccess) {
+      device_count = 0;
+    }
+
+    resource::MemoryResourceRegistry& registry =
+      resource::MemoryResourceRegistry::getInstance();
+
+    std::vector<int> ids(device_count);
+    for (auto& id : ids) {
+      id = getNextId();
+    }
+
+    m_device_resources.assign(device_count, nullptr);
+
+    forEachDevice(device_count, [&] (int device) {
+      m_device_resources[device] = registry.makeMemoryResource(
+          "DEVICE::" + std::to_string(device), ids[device]);
+    });
+
+    for (auto& resource : m_device_resources) {
+      addAllocatorId(resource);
+    }
+#endif
+  });
+
+  return m_device_resources;
 }
 
-std::shared_ptr<strategy::AllocationStrategy>&
-ResourceManager::getAllocationStrategy(const std::string& name)
+std::vector<Allocator>
+ResourceManager::makeDevicePools(
+    const std::string& name,
+    size_t initial_size,
+    bool prefault)
 {
-  UMPIRE_LOG(Debug, "(\"" << name << "\")");
-  auto allocator = m_allocators_by_name.find(name);
-  if (allocator == m_allocators_by_name.end()) {
-    UMPIRE_ERROR("Allocator \"" << name << "\" not found.");
+  UMPIRE_LOG(Debug, "(name=\"" << name << "\", initial_size=" << initial_size
+      << ", prefault=" << prefault << ")");
+
+  std::vector<std::shared_ptr<strategy::AllocationStrategy> > devices;
+  for (auto& resource : getDeviceResources()) {
+    if (resource->getName().compare(0, 8, "DEVICE::") == 0) {
+      devices.push_back(resource);
+    }
+  }
+
+  const int device_count = static_cast<int>(devices.size());
+
+  std::vector<std::string> names;
+  std::vector<int> ids;
+  for (int device = 0; device < device_count; ++device) {
+    names.push_back(name + "::" + std::to_string(device));
+    ids.push_back(getNextId());
+
+    if (isAllocator(names.back())) {
+      UMPIRE_ERROR("Allocator with name " << names.back() << " is already registered.");
+    }
+  }
+
+  std::vector<std::shared_ptr<strategy::AllocationStrategy> > pools(device_count);
+
+  forEachDevice(device_count, [&] (int device) {
+    pools[device] = std::make_shared<strategy::DynamicPool>(
+        names[device], ids[device], Allocator(devices[device]), initial_size);
+    pools[device]->reserve(initial_size, prefault);
+  });
+
+  std::vector<Allocator> allocators;
+
+  try {
+    UMPIRE_LOCK;
+    for (auto& pool_name : names) {
+      if (isAllocator(pool_name)) {
+        UMPIRE_ERROR("Allocator with name " << pool_name << " is already registered.");
+      }
+    }
+
+    for (int device = 0; device < device_count; ++device) {
+      addAllocator(names[device], pools[device]);
+    }
+    UMPIRE_UNLOCK;
+  } catch (...) {
+    UMPIRE_UNLOCK;
+    throw;
+  }
+
+  for (auto& pool : pools) {
+    applyProfile(pool);
+    allocators.push_back(Allocator(pool));
+  }
+
+  return allocators;
+}
+
+void
+ResourceManager::configure(const std::string& filename)
+{
+  UMPIRE_LOG(Debug, "(filename=\"" << filename << "\")");
+  AllocatorConfiguration::fromFile(filename).apply(*this);
+}
+
+void
+ResourceManager::finalize()
+{
+  UMPIRE_LOG(Debug, "() entering");
+
+  if (!m_profile_filename.empty()) {
+    getProfile().toFile(m_profile_filename);
+  }
+
+  stopUsageSampler();
+}
+
+void
+ResourceManager::shutdown()
+{
+  UMPIRE_LOG(Debug, "() entering");
+
+  finalize();
+
+  {
+    std::lock_guard<std::mutex> lock(m_copy_pool_mutex);
+    m_copy_pool.reset();
+  }
+
+  freeCompletedMoves(true);
+
+  // The records of live allocations go in one pass over each shard, so
+  // the pools destroyed below find nothing left to deregister.
+  m_allocations.reset();
+
+  try {
+    UMPIRE_LOCK;
+
+    // Pools hold their parent Allocators, so dropping every reference here
+    // destroys each pool before the strategy it returns its chunks to.
+    m_default_allocator.reset();
+    m_device_resources.clear();
+
+    for (auto& lazy : m_lazy_resources) {
+      lazy->resource.reset();
+    }
+
+    for (auto& chunk : m_allocators_by_id) {
+      AllocatorSlot* slots = chunk.load(std::memory_order_acquire);
+
+      if (slots) {
+        for (int i = 0; i < s_allocators_per_chunk; ++i) {
+          slots[i].valid.store(false, std::memory_order_release);
+          slots[i].strategy.reset();
+        }
+      }
+    }
+
+    std::unique_ptr<AllocatorNameTable> empty(new AllocatorNameTable(s_allocator_name_buckets));
+    m_allocators_by_name.store(empty.get(), std::memory_order_release);
+    m_allocator_name_tables.clear();
+    m_allocator_name_tables.push_back(std::move(empty));
+
+    UMPIRE_UNLOCK;
+  } catch (...) {
+    UMPIRE_UNLOCK;
+    throw;
+  }
+}
+
+void
+ResourceManager::startUsageSampler(const std::string& filename, int interval_ms)
+{
+  UMPIRE_LOG(Debug, "(filename=\"" << filename << "\", interval_ms=" << interval_ms << ")");
+
+  std::lock_guard<std::mutex> lock(m_usage_sampler_mutex);
+
+  m_usage_sampler.reset();
+  m_usage_sampler.reset(new UsageSampler(
+        *this, filename, std::chrono::milliseconds(interval_ms)));
+}
+
+void
+ResourceManager::stopUsageSampler()
+{
+  UMPIRE_LOG(Debug, "()");
+
+  std::lock_guard<std::mutex> lock(m_usage_sampler_mutex);
+  m_usage_sampler.reset();
+}
+
+void
+ResourceManager::useProfile(const std::string& filename)
+{
+  UMPIRE_LOG(Debug, "(filename=\"" << filename << "\")");
+
+  m_profile_filename = filename;
+  m_profile = AllocationProfile();
+
+  if (!filename.empty() && std::ifstream(filename)) {
+    m_profile = AllocationProfile::fromFile(filename);
+  }
+}
+
+AllocationProfile
+ResourceManager::getProfile()
+{
+  AllocationProfile profile = m_profile;
+
+  m_allocators_by_name.load(std::memory_order_acquire)->forEach(
+      [&] (const AllocatorNameNode& named) {
+    auto& strategy = named.strategy;
+
+    AllocationProfile::Entry entry{};
+    entry.name = named.name;
+    entry.high_watermark = strategy->getHighWatermark();
+    entry.actual_size = std::max(strategy->getActualSize(), entry.high_watermark);
+
+    if (entry.high_watermark == 0) {
+      return;
+    }
+
+    auto pool = std::dynamic_pointer_cast<strategy::DynamicPool>(strategy);
+    if (pool) {
+      entry.num_chunks = pool->getNumChunks();
+    }
+
+    util::AllocatorStatistics* statistics = strategy->getStatistics();
+    if (statistics) {
+      entry.allocation_bytes = statistics->getSummary().allocation_bytes;
+    }
+
+    profile.add(entry);
+  });
+
+  return profile;
+}
+
+void
+ResourceManager::applyProfile(const std::shared_ptr<strategy::AllocationStrategy>& allocator)
+{
+  if (m_profile_filename.empty()) {
+    return;
+  }
+
+  allocator->enableStatistics();
+
+  const AllocationProfile::Entry* entry = m_profile.find(allocator->getName());
+  if (entry && entry->actual_size > 0) {
+    UMPIRE_LOG(Debug, "Reserving " << entry->actual_size << " bytes for " << allocator->getName());
+    allocator->reserve(static_cast<size_t>(entry->actual_size), false);
+  }
+}
+
+void
+ResourceManager::addAllocator(const std::string& name,
+    const std::shared_ptr<strategy::AllocationStrategy>& allocator)
+{
+  AllocatorNameTable* table = m_allocator_name_tables.empty()
+    ? nullptr : m_allocator_name_tables.back().get();
+
+  if (!table || table->size > table->mask) {
+    std::unique_ptr<AllocatorNameTable> grown(new AllocatorNameTable(
+          table ? 2 * (table->mask + 1) : s_allocator_name_buckets));
+
+    if (table) {
+      table->forEach([&] (const AllocatorNameNode& node) {
+        grown->insert(node.name, node.strategy);
+      });
+    }
+
+    table = grown.get();
+    m_allocator_name_tables.push_back(std::move(grown));
+    table->insert(name, allocator);
+    m_allocators_by_name.store(table, std::memory_order_release);
+  } else {
+    table->insert(name, allocator);
+  }
+
+  addAllocatorId(allocator);
+}
+
+void
+ResourceManager::addAllocatorId(const std::shared_ptr<strategy::AllocationStrategy>& allocator)
+{
+  const int id = allocator->getId();
+  if (id < 0 || id >= s_allocators_per_chunk * s_allocator_chunks) {
+    return;
+  }
+
+  std::atomic<AllocatorSlot*>& chunk = m_allocators_by_id[id / s_allocators_per_chunk];
+  AllocatorSlot* slots = chunk.load(std::memory_order_acquire);
+
+  if (!slots) {
+    AllocatorSlot* new_slots = new AllocatorSlot[s_allocators_per_chunk];
+    if (chunk.compare_exchange_strong(slots, new_slots, std::memory_order_acq_rel)) {
+      slots = new_slots;
+    } else {
+      delete[] new_slots;
+    }
+  }
+
+  AllocatorSlot& slot = slots[id % s_allocators_per_chunk];
+  if (!slot.valid.load(std::memory_order_acquire)) {
+    slot.strategy = allocator;
+    slot.valid.store(true, std::memory_order_release);
+  }
+}
+
+std::shared_ptr<strategy::AllocationStrategy>
+ResourceManager::getAllocationStrategy(const std::string& name)
+{
+  UMPIRE_LOG(Debug, "(\"" << name << "\")");
+  const AllocatorNameNode* named = m_allocators_by_name.load(std::memory_order_acquire)->find(name);
+  if (named) {
+    return named->strategy;
+  }
+
+  LazyResource* lazy = findLazyResource(name);
+  if (lazy) {
+    return getLazyResource(*lazy);
+  }
+
+  if (isPerDeviceName(name)) {
+    for (auto& device : getDeviceResources()) {
+      if (device->getName() == name) {
+        return device;
+      }
+    }
+  }
+
+  UMPIRE_ERROR("Allocator \"" << name << "\" not found.");
+}
+
+Allocator
+ResourceManager::getAllocator(const std::string& name)
+{
+  UMPIRE_LOG(Debug, "(\"" << name << "\")");
+  return Allocator(getAllocationStrategy(name));
+}
+
+Allocator
+ResourceManager::getAllocator(resource::MemoryResourceType resource_type)
+{
+  UMPIRE_LOG(Debug, "(\"" << static_cast<size_t>(resource_type) << "\")");
+
+  switch (resource_type) {
+    case resource::Host:
+      return getAllocator("HOST");
+#if defined(UMPIRE_ENABLE_CUDA) || defined(UMPIRE_ENABLE_HIP)
+    case resource::Device:
+      return getAllocator("DEVICE");
+    case resource::UnifiedMemory:
+      return getAllocator("UM");
+    case resource::PinnedMemory:
+      return getAllocator("PINNED");
+#endif
+    default:
+      UMPIRE_ERROR("Allocator \"" << static_cast<size_t>(resource_type) << "\" not found.");
+  }
+}
+
+Allocator
+ResourceManager::getAllocator(int id)
+{
+  UMPIRE_LOG(Debug, "(\"" << id << "\")");
+
+  if (id >= 0 && id < s_allocators_per_chunk * s_allocator_chunks) {
+    const AllocatorSlot* slots =
+      m_allocators_by_id[id / s_allocators_per_chunk].load(std::memory_order_acquire);
+
+    if (slots) {
+      const AllocatorSlot& slot = slots[id % s_allocators_per_chunk];
+      if (slot.valid.load(std::memory_order_acquire)) {
+        return Allocator(slot.strategy);
+      }
+    }
+  } else {
+    std::shared_ptr<strategy::AllocationStrategy> found;
+    m_allocators_by_name.load(std::memory_order_acquire)->forEach(
+        [&] (const AllocatorNameNode& named) {
+      if (named.strategy->getId() == id) {
+        found = named.strategy;
+      }
+    });
+
+    if (found) {
+      return Allocator(found);
+    }
+  }
+
+  for (auto& lazy : m_lazy_resources) {
+    if (lazy->id == id) {
+      return Allocator(getLazyResource(*lazy));
+    }
+  }
+
+  // Device resources only have ids once they have been made.
+  for (auto& device : getDeviceResources()) {
+    if (device->getId() == id) {
+      return Allocator(device);
+    }
+  }
+
+  UMPIRE_ERROR("Allocator \"" << id << "\" not found.");
+}
+
+Allocator
+ResourceManager::getDefaultAllocator()
+{
+  UMPIRE_LOG(Debug, "");
+
+  return Allocator(getDefaultAllocationStrategy()->shared_from_this());
+}
+
+strategy::AllocationStrategy*
+ResourceManager::getDefaultAllocationStrategy()
+{
+  if (t_default_allocator) {
+    return t_default_allocator.get();
+  }
+
+  if (!m_default_allocator) {
+    UMPIRE_ERROR("The default Allocator is not defined");
+  }
+
+  return m_default_allocator.get();
+}
+
+void
+ResourceManager::setDefaultAllocator(Allocator allocator)
+{
+  UMPIRE_LOG(Debug, "(\"" << allocator.getName() << "\")");
+
+  m_default_allocator = allocator.getAllocationStrategy();
+}
+
+void
+ResourceManager::setThreadDefaultAllocator(Allocator allocator)
+{
+  UMPIRE_LOG(Debug, "(\"" << allocator.getName() << "\")");
+
+  t_default_allocator = allocator.getAllocationStrategy();
+}
+
+void
+ResourceManager::resetThreadDefaultAllocator()
+{
+  UMPIRE_LOG(Debug, "");
+
+  t_default_allocator.reset();
+}
+
+std::shared_ptr<strategy::AllocationStrategy>
+ResourceManager::exchangeThreadDefaultAllocator(
+    std::shared_ptr<strategy::AllocationStrategy> allocator)
+{
+  t_default_allocator.swap(allocator);
+  return allocator;
+}
+
+void
+ResourceManager::registerAllocator(const std::string& name, Allocator allocator)
+{
+  try {
+    UMPIRE_LOCK;
+
+    if (isAllocator(name)) {
+      UMPIRE_ERROR("Allocator " << name << " is already registered.");
+    }
+
+    addAllocator(name, allocator.getAllocationStrategy());
+
+    UMPIRE_UNLOCK;
+  } catch (...) {
+    UMPIRE_UNLOCK;
+    throw;
+  }
+}
+
+Allocator
+ResourceManager::getAllocator(void* ptr)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+  return Allocator(findAllocatorForPointer(ptr)->shared_from_this());
+}
+
+bool
+ResourceManager::isAllocator(const std::string& name)
+{
+  if (m_allocators_by_name.load(std::memory_order_acquire)->find(name)
+      || findLazyResource(name)) {
+    return true;
+  }
+
+  if (isPerDeviceName(name)) {
+    for (auto& device : getDeviceResources()) {
+      if (device->getName() == name) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+bool
+ResourceManager::hasAllocator(void* ptr)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr <<")");
+
+  return m_chunks.find(ptr) || m_allocations.contains(ptr);
+}
+
+util::AllocationRecord* ResourceManager::registerAllocation(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", size=" << record.m_size << ") with " << this );
+
+  util::AllocationRecord claimed{record};
+  if (strategy::AllocationStrategy::claimRecord(claimed)) {
+    return m_allocations.insert(ptr, claimed);
+  }
+
+  return m_allocations.insert(ptr, record);
+}
+
+util::AllocationRecord ResourceManager::deregisterAllocation(void* ptr)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+  return m_allocations.remove(ptr);
+}
+
+void ResourceManager::registerAllocationBatch(void** ptrs, const util::AllocationRecord* records, size_t count)
+{
+  UMPIRE_LOG(Debug, "(count=" << count << ")");
+
+  util::AllocationRecord claimed{};
+  if (count > 0 && strategy::AllocationStrategy::claimRecord(claimed)) {
+    std::vector<util::AllocationRecord> owned(records, records + count);
+    for (auto& record : owned) {
+      record.m_strategy = claimed.m_strategy;
+    }
+    m_allocations.insertBatch(ptrs, owned.data(), count);
+    return;
+  }
+
+  m_allocations.insertBatch(ptrs, records, count);
+}
+
+size_t ResourceManager::deregisterAllocationRange(void* begin, void* end,
+    strategy::AllocationStrategy* strategy)
+{
+  UMPIRE_LOG(Debug, "(begin=" << begin << ", end=" << end << ")");
+  return m_allocations.removeRange(begin, end, strategy);
+}
+
+void ResourceManager::registerChunk(void* ptr, size_t size,
+    strategy::AllocationStrategy* strategy, void* handle)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", size=" << size << ", strategy=" << strategy << ")");
+  m_chunks.insert(ptr, size, strategy, handle);
+}
+
+void ResourceManager::deregisterChunk(void* ptr, strategy::AllocationStrategy* strategy)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", strategy=" << strategy << ")");
+  m_chunks.remove(ptr, strategy);
+}
+
+void* ResourceManager::findChunk(void* ptr, const strategy::AllocationStrategy* strategy) const
+{
+  return m_chunks.findHandle(ptr, strategy);
+}
+
+bool
+ResourceManager::isAllocatorRegistered(const std::string& name)
+{
+  return isAllocator(name);
+}
+
+void ResourceManager::copy(void* dst_ptr, void* src_ptr, size_t size)
+{
+  UMPIRE_LOG(Debug, "(src_ptr=" << src_ptr << ", dst_ptr=" << dst_ptr << ", size=" << size << ")");
+
+  copyRecords(dst_ptr, src_ptr, size, false);
+}
+
+void ResourceManager::copyCompressed(void* dst_ptr, void* src_ptr, size_t size)
+{
+  UMPIRE_LOG(Debug, "(src_ptr=" << src_ptr << ", dst_ptr=" << dst_ptr << ", size=" << size << ")");
+
+  copyRecords(dst_ptr, src_ptr, size, true);
+}
+
+void ResourceManager::copyRecords(void* dst_ptr, void* src_ptr, size_t size, bool compress)
+{
+  auto& op_registry = op::MemoryOperationRegistry::getInstance();
+
+  auto src_alloc_record = findRecord(src_ptr);
+  auto dst_alloc_record = findRecord(dst_ptr);
+
+  std::size_t src_size = src_alloc_record.m_size;
+  std::size_t dst_size = dst_alloc_record.m_size;
+
+  if (size == 0) {
+    size = src_size;
+  }
+
+  if (size > dst_size) {
+    UMPIRE_ERROR("Not enough resource in destination for copy: " << size << " -> " << dst_size);
+  }
+
+  op::MemoryOperation* op;
+
+  if (compress
+      || src_alloc_record.m_strategy->getCompressCopies()
+      || dst_alloc_record.m_strategy->getCompressCopies()) {
+    op = op_registry.find("COPY_COMPRESSED",
+        src_alloc_record.m_strategy,
+        dst_alloc_record.m_strategy).get();
+  } else {
+    op = op_registry.find(op::MemoryOperationType::copy,
+        src_alloc_record.m_strategy,
+        dst_alloc_record.m_strategy);
+  }
+
+  UMPIRE_ANNOTATE_SCOPE("copy", src_alloc_record.m_strategy->getName(), size);
+  op::OperationCounter counter(op::MemoryOperationType::copy,
+      src_alloc_record.m_strategy, dst_alloc_record.m_strategy, size);
+
+  util::AllocatorStatistics* statistics = src_alloc_record.m_strategy->getStatistics();
+  if (statistics) {
+    const uint64_t start = util::AllocatorStatistics::now();
+    op->transform(src_ptr, &dst_ptr, &src_alloc_record, &dst_alloc_record, size);
+    statistics->recordCopy(util::AllocatorStatistics::now() - start);
+  } else {
+    op->transform(src_ptr, &dst_ptr, &src_alloc_record, &dst_alloc_record, size);
+  }
+}
+
+void ResourceManager::copy(void* dst_ptr, void* src_ptr, size_t size, void* stream)
+{
+  UMPIRE_LOG(Debug, "(src_ptr=" << src_ptr << ", dst_ptr=" << dst_ptr << ", size=" << size << ", stream=" << stream << ")");
+
+  auto& op_registry = op::MemoryOperationRegistry::getInstance();
+
+  auto src_alloc_record = findRecord(src_ptr);
+  auto dst_alloc_record = findRecord(dst_ptr);
+
+  std::size_t src_size = src_alloc_record.m_size;
+  std::size_t dst_size = dst_alloc_record.m_size;
+
+  if (size == 0) {
+    size = src_size;
+  }
+
+  if (size > dst_size) {
+    UMPIRE_ERROR("Not enough resource in destination for copy: " << size << " -> " << dst_size);
+  }
+
+  auto op = op_registry.find(op::MemoryOperationType::copy,
+      src_alloc_record.m_strategy,
+      dst_alloc_record.m_strategy);
+
+  UMPIRE_ANNOTATE_SCOPE("copy_async", src_alloc_record.m_strategy->getName(), size);
+  op::OperationCounter counter(op::MemoryOperationType::copy,
+      src_alloc_record.m_strategy, dst_alloc_record.m_strategy, size);
+
+  op->transformAsync(src_ptr, &dst_ptr, &src_alloc_record, &dst_alloc_record, size, stream);
+}
+
+std::future<void> ResourceManager::copyAsync(void* dst_ptr, void* src_ptr, size_t size)
+{
+  UMPIRE_LOG(Debug, "(src_ptr=" << src_ptr << ", dst_ptr=" << dst_ptr << ", size=" << size << ")");
+
+  auto src_alloc_record = findRecord(src_ptr);
+  auto dst_alloc_record = findRecord(dst_ptr);
+
+  if (src_alloc_record.m_strategy->getPlatform() != Platform::cpu
+      || dst_alloc_record.m_strategy->getPlatform() != Platform::cpu) {
+    UMPIRE_ERROR("copyAsync only copies between host allocations, not from "
+        << src_alloc_record.m_strategy->getName() << " to "
+        << dst_alloc_record.m_strategy->getName());
+  }
+
+  if (size == 0) {
+    size = src_alloc_record.m_size;
+  }
+
+  if (size > dst_alloc_record.m_size) {
+    UMPIRE_ERROR("Not enough resource in destination for copy: " << size << " -> " << dst_alloc_record.m_size);
+  }
+
+  auto op = op::MemoryOperationRegistry::getInstance().find(
+      op::MemoryOperationType::copy,
+      src_alloc_record.m_strategy,
+      dst_alloc_record.m_strategy);
+
+  util::ThreadPool* pool;
+  {
+    std::lock_guard<std::mutex> lock(m_copy_pool_mutex);
+    if (!m_copy_pool) {
+      // Each copy is already split across threads, so two are enough to
+      // keep a small copy from waiting behind a large one.
+      m_copy_pool.reset(new util::ThreadPool(2));
+    }
+    pool = m_copy_pool.get();
+  }
+
+  return pool->submit([=] () mutable {
+    UMPIRE_ANNOTATE_SCOPE("copy_async", src_alloc_record.m_strategy->getName(), size);
+    op::OperationCounter counter(op::MemoryOperationType::copy,
+        src_alloc_record.m_strategy, dst_alloc_record.m_strategy, size);
+
+    op->transform(src_ptr, &dst_ptr, &src_alloc_record, &dst_alloc_record, size);
+  });
+}
+
+void ResourceManager::copy(
+    void* dst_ptr, Allocator& dst_allocator,
+    void* src_ptr, Allocator& src_allocator,
+    size_t size)
+{
+  UMPIRE_LOG(Debug, "(src_ptr=" << src_ptr << ", dst_ptr=" << dst_ptr << ", size=" << size << ")");
+
+  auto& op_registry = op::MemoryOperationRegistry::getInstance();
+
+  strategy::AllocationStrategy* src_strategy = src_allocator.m_allocator.get();
+  strategy::AllocationStrategy* dst_strategy = dst_allocator.m_allocator.get();
+
+  util::AllocationRecord src_record{src_ptr, size, src_strategy};
+  util::AllocationRecord dst_record{dst_ptr, size, dst_strategy};
+
+  auto op = op_registry.find(op::MemoryOperationType::copy,
+      src_strategy,
+      dst_strategy);
+
+  UMPIRE_ANNOTATE_SCOPE("copy", src_strategy->getName(), size);
+  op::OperationCounter counter(op::MemoryOperationType::copy,
+      src_strategy, dst_strategy, size);
+
+  util::AllocatorStatistics* statistics = src_strategy->getStatistics();
+  if (statistics) {
+    const uint64_t start = util::AllocatorStatistics::now();
+    op->transform(src_ptr, &dst_ptr, &src_record, &dst_record, size);
+    statistics->recordCopy(util::AllocatorStatistics::now() - start);
+  } else {
+    op->transform(src_ptr, &dst_ptr, &src_record, &dst_record, size);
+  }
+}
+
+void ResourceManager::copy2D(
+    void* dst_ptr, size_t dst_pitch,
+    void* src_ptr, size_t src_pitch,
+    size_t width, size_t height)
+{
+  copyStrided(dst_ptr, dst_pitch, height, src_ptr, src_pitch, height,
+      width, height, 1, nullptr, false);
+}
+
+void ResourceManager::copy2D(
+    void* dst_ptr, size_t dst_pitch,
+    void* src_ptr, size_t src_pitch,
+    size_t width, size_t height,
+    void* stream)
+{
+  copyStrided(dst_ptr, dst_pitch, height, src_ptr, src_pitch, height,
+      width, height, 1, stream, true);
+}
+
+void ResourceManager::copy3D(
+    void* dst_ptr, size_t dst_pitch, size_t dst_height,
+    void* src_ptr, size_t src_pitch, size_t src_height,
+    size_t width, size_t height, size_t depth)
+{
+  copyStrided(dst_ptr, dst_pitch, dst_height, src_ptr, src_pitch, src_height,
+      width, height, depth, nullptr, false);
+}
+
+void ResourceManager::copy3D(
+    void* dst_ptr, size_t dst_pitch, size_t dst_height,
+    void* src_ptr, size_t src_pitch, size_t src_height,
+    size_t width, size_t height, size_t depth,
+    void* stream)
+{
+  copyStrided(dst_ptr, dst_pitch, dst_height, src_ptr, src_pitch, src_height,
+      width, height, depth, stream, true);
+}
+
+void ResourceManager::copyStrided(
+    void* dst_ptr, size_t dst_pitch, size_t dst_height,
+    void* src_ptr, size_t src_pitch, size_t src_height,
+    size_t width, size_t height, size_t depth,
+    void* stream, bool async)
+{
+  UMPIRE_LOG(Debug, "(src_ptr=" << src_ptr << ", dst_ptr=" << dst_ptr
+      << ", width=" << width << ", height=" << height << ", depth=" << depth << ")");
+
+  if (width > src_pitch || width > dst_pitch) {
+    UMPIRE_ERROR("Copy width " << width << " is larger than the pitch: "
+        << src_pitch << " -> " << dst_pitch);
+  }
+
+  if (depth > 1 && (height > src_height || height > dst_height)) {
+    UMPIRE_ERROR("Copy height " << height << " is larger than the slice height: "
+        << src_height << " -> " << dst_height);
+  }
+
+  auto src_alloc_record = findRecord(src_ptr);
+  auto dst_alloc_record = findRecord(dst_ptr);
+
+  if (width == 0 || height == 0 || depth == 0) {
+    return;
+  }
+
+  // Bytes from the start of the block to the end of its last row.
+  const size_t src_extent =
+    ((depth - 1)*src_height + (height - 1))*src_pitch + width;
+  const size_t dst_extent =
+    ((depth - 1)*dst_height + (height - 1))*dst_pitch + width;
+
+  const size_t src_offset = static_cast<char*>(src_ptr)
+    - static_cast<char*>(src_alloc_record.m_ptr);
+  const size_t dst_offset = static_cast<char*>(dst_ptr)
+    - static_cast<char*>(dst_alloc_record.m_ptr);
+
+  if (src_offset + src_extent > src_alloc_record.m_size) {
+    UMPIRE_ERROR("Strided copy reads past the end of the source: "
+        << src_offset + src_extent << " > " << src_alloc_record.m_size);
+  }
+
+  if (dst_offset + dst_extent > dst_alloc_record.m_size) {
+    UMPIRE_ERROR("Not enough resource in destination for copy: "
+        << dst_offset + dst_extent << " > " << dst_alloc_record.m_size);
+  }
+
+  auto op = op::MemoryOperationRegistry::getInstance().find(
+      op::MemoryOperationType::copy,
+      src_alloc_record.m_strategy,
+      dst_alloc_record.m_strategy);
+
+  UMPIRE_ANNOTATE_SCOPE(async ? "copy_async" : "copy",
+      src_alloc_record.m_strategy->getName(), width * height * depth);
+  op::OperationCounter counter(op::MemoryOperationType::copy,
+      src_alloc_record.m_strategy, dst_alloc_record.m_strategy, width * height * depth);
+
+  if (async) {
+    op->transformStridedAsync(src_ptr, dst_ptr, &src_alloc_record, &dst_alloc_record,
+        width, height, depth, src_pitch, src_height, dst_pitch, dst_height, stream);
+    return;
+  }
+
+  util::AllocatorStatistics* statistics = src_alloc_record.m_strategy->getStatistics();
+  const uint64_t start = statistics ? util::AllocatorStatistics::now() : 0;
+
+  op->transformStrided(src_ptr, dst_ptr, &src_alloc_record, &dst_alloc_record,
+      width, height, depth, src_pitch, src_height, dst_pitch, dst_height);
+
+  if (statistics) {
+    statistics->recordCopy(util::AllocatorStatistics::now() - start);
+  }
+}
+
+void ResourceManager::copyBatch(void** dst_ptrs, void** src_ptrs, size_t* sizes, size_t count)
+{
+  const bool on_device = copyGrouped(dst_ptrs, src_ptrs, sizes, count, nullptr);
+
+#if defined(UMPIRE_ENABLE_CUDA)
+  if (on_device) {
+    cudaError_t error = ::cudaStreamSynchronize(0);
+
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaStreamSynchronize failed with error: "
+          << cudaGetErrorString(error));
+    }
+  }
+#else
+  UMPIRE_USE_VAR(on_device);
+#endif
+}
+
+void ResourceManager::copyBatch(void** dst_ptrs, void** src_ptrs, size_t* sizes, size_t count, void* stream)
+{
+  copyGrouped(dst_ptrs, src_ptrs, sizes, count, stream);
+}
+
+bool ResourceManager::copyGrouped(void** dst_ptrs, void** src_ptrs, size_t* sizes, size_t count, void* stream)
+{
+  UMPIRE_LOG(Debug, "(count=" << count << ", stream=" << stream << ")");
+
+  auto& op_registry = op::MemoryOperationRegistry::getInstance();
+
+  struct Group {
+    op::MemoryOperation* op;
+    std::vector<void*> src_ptrs;
+    std::vector<void*> dst_ptrs;
+    std::vector<util::AllocationRecord> src_records;
+    std::vector<util::AllocationRecord> dst_records;
+    std::vector<size_t> sizes;
+  };
+
+  // There are only as many groups as distinct operations, so a linear search
+  // is cheaper than a map.
+  std::vector<Group> groups;
+
+  for (size_t i = 0; i < count; ++i) {
+    auto src_alloc_record = findRecord(src_ptrs[i]);
+    auto dst_alloc_record = findRecord(dst_ptrs[i]);
+
+    size_t size = sizes[i];
+    if (size == 0) {
+      size = src_alloc_record.m_size;
+    }
+
+    if (size > dst_alloc_record.m_size) {
+      UMPIRE_ERROR("Not enough resource in destination for copy " << i << ": " << size << " -> " << dst_alloc_record.m_size);
+    }
+
+    auto op = op_registry.find(op::MemoryOperationType::copy,
+        src_alloc_record.m_strategy,
+        dst_alloc_record.m_strategy);
+
+    Group* group = nullptr;
+    for (auto& g : groups) {
+      if (g.op == op) {
+        group = &g;
+        break;
+      }
+    }
+
+    if (!group) {
+      groups.push_back(Group());
+      group = &groups.back();
+      group->op = op;
+    }
+
+    group->src_ptrs.push_back(src_ptrs[i]);
+    group->dst_ptrs.push_back(dst_ptrs[i]);
+    group->src_records.push_back(src_alloc_record);
+    group->dst_records.push_back(dst_alloc_record);
+    group->sizes.push_back(size);
+  }
+
+  std::vector<util::AllocationRecord*> src_records;
+  std::vector<util::AllocationRecord*> dst_records;
+
+  // Every group is issued before any is waited for, so that transfers in
+  // different directions can overlap.
+  bool on_device = false;
+
+  for (auto& group : groups) {
+    src_records.clear();
+    dst_records.clear();
+
+    for (size_t i = 0; i < group.sizes.size(); ++i) {
+      src_records.push_back(&group.src_records[i]);
+      dst_records.push_back(&group.dst_records[i]);
+    }
+
+    const std::size_t bytes =
+      std::accumulate(group.sizes.begin(), group.sizes.end(), std::size_t(0));
+
+    UMPIRE_ANNOTATE_SCOPE("copy_batch", group.src_records[0].m_strategy->getName(), bytes);
+    op::OperationCounter counter(op::MemoryOperationType::copy,
+        group.src_records[0].m_strategy, group.dst_records[0].m_strategy, bytes);
+
+    group.op->transformBatchAsync(
+        group.src_ptrs.data(),
+        group.dst_ptrs.data(),
+        src_records.data(),
+        dst_records.data(),
+        group.sizes.data(),
+        group.sizes.size(),
+        stream);
+
+    if (group.src_records[0].m_strategy->getPlatform() != Platform::cpu
+        || group.dst_records[0].m_strategy->getPlatform() != Platform::cpu) {
+      on_device = true;
+    }
   }
 
-  return m_allocators_by_name[name];
+  return on_device;
 }
 
-Allocator
-ResourceManager::getAllocator(const std::string& name)
+void ResourceManager::memset(void* ptr, int value, size_t length)
 {
-  UMPIRE_LOG(Debug, "(\"" << name << "\")");
-  return Allocator(getAllocationStrategy(name));
-}
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", value=" << value << ", length=" << length << ")");
 
-Allocator
-ResourceManager::getAllocator(resource::MemoryResourceType resource_type)
-{
-  UMPIRE_LOG(Debug, "(\"" << static_cast<size_t>(resource_type) << "\")");
+  auto& op_registry = op::MemoryOperationRegistry::getInstance();
 
-  auto allocator = m_memory_resources.find(resource_type);
-  if (allocator == m_memory_resources.end()) {
-    UMPIRE_ERROR("Allocator \"" << static_cast<size_t>(resource_type) << "\" not found.");
-  }
+  auto alloc_record = findRecord(ptr);
 
-  return Allocator(m_memory_resources[resource_type]);
-}
+  std::size_t src_size = alloc_record.m_size;
 
-Allocator
-ResourceManager::getAllocator(int id)
-{
-  UMPIRE_LOG(Debug, "(\"" << id << "\")");
+  if (length == 0) {
+    length = src_size;
+  }
 
-  auto allocator = m_allocators_by_id.find(id);
-  if (allocator == m_allocators_by_id.end()) {
-    UMPIRE_ERROR("Allocator \"" << id << "\" not found.");
+  if (length > src_size) {
+    UMPIRE_ERROR("Cannot memset over the end of allocation: " << length << " -> " << src_size);
   }
 
-  return Allocator(m_allocators_by_id[id]);
+  auto op = op_registry.find(op::MemoryOperationType::memset,
+      alloc_record.m_strategy,
+      alloc_record.m_strategy);
+
+  UMPIRE_ANNOTATE_SCOPE("memset", alloc_record.m_strategy->getName(), length);
+  op::OperationCounter counter(op::MemoryOperationType::memset,
+      alloc_record.m_strategy, alloc_record.m_strategy, length);
+
+  op->apply(ptr, &alloc_record, value, length);
 }
 
-Allocator
-ResourceManager::getDefaultAllocator()
+void ResourceManager::memset(void* ptr, int value, size_t length, void* stream)
 {
-  UMPIRE_LOG(Debug, "");
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", value=" << value << ", length=" << length << ", stream=" << stream << ")");
 
-  if (!m_default_allocator) {
-    UMPIRE_ERROR("The default Allocator is not defined");
-  }
+  auto& op_registry = op::MemoryOperationRegistry::getInstance();
 
-  return Allocator(m_default_allocator);
-}
+  auto alloc_record = findRecord(ptr);
 
-void
-ResourceManager::setDefaultAllocator(Allocator allocator)
-{
-  UMPIRE_LOG(Debug, "(\"" << allocator.getName() << "\")");
+  std::size_t src_size = alloc_record.m_size;
 
-  m_default_allocator = allocator.getAllocationStrategy();
-}
+  if (length == 0) {
+    length = src_size;
+  }
 
-void
-ResourceManager::registerAllocator(const std::string& name, Allocator allocator)
-{
-  if (isAllocator(name)) {
-    UMPIRE_ERROR("Allocator " << name << " is already registered.");
+  if (length > src_size) {
+    UMPIRE_ERROR("Cannot memset over the end of allocation: " << length << " -> " << src_size);
   }
 
-  m_allocators_by_name[name] = allocator.getAllocationStrategy();
-}
+  auto op = op_registry.find(op::MemoryOperationType::memset,
+      alloc_record.m_strategy,
+      alloc_record.m_strategy);
 
-Allocator
-ResourceManager::getAllocator(void* ptr)
-{
-  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
-  return Allocator(findAllocatorForPointer(ptr));
+  UMPIRE_ANNOTATE_SCOPE("memset_async", alloc_record.m_strategy->getName(), length);
+  op::OperationCounter counter(op::MemoryOperationType::memset,
+      alloc_record.m_strategy, alloc_record.m_strategy, length);
+
+  op->applyAsync(ptr, &alloc_record, value, length, stream);
 }
 
-bool
-ResourceManager::isAllocator(const std::string& name)
+void ResourceManager::fill(void* ptr, const void* pattern, size_t pattern_size, size_t length)
 {
-  return (m_allocators_by_name.find(name) != m_allocators_by_name.end());
+  fill(ptr, pattern, pattern_size, length, nullptr);
 }
 
-bool
-ResourceManager::hasAllocator(void* ptr)
+void ResourceManager::fill(void* ptr, const void* pattern, size_t pattern_size, size_t length, void* stream)
 {
-  UMPIRE_LOG(Debug, "(ptr=" << ptr <<")");
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", pattern=" << pattern << ", pattern_size=" << pattern_size << ", length=" << length << ", stream=" << stream << ")");
 
-  return m_allocations.contains(ptr);
-}
+  auto& op_registry = op::MemoryOperationRegistry::getInstance();
 
-void ResourceManager::registerAllocation(void* ptr, util::AllocationRecord* record)
-{
-  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", record=" << record << ") with " << this );
+  auto alloc_record = findRecord(ptr);
 
-  m_allocations.insert(ptr, record);
-}
+  std::size_t offset = static_cast<char*>(ptr) - static_cast<char*>(alloc_record.m_ptr);
+  std::size_t available = alloc_record.m_size - offset;
 
-util::AllocationRecord* ResourceManager::deregisterAllocation(void* ptr)
-{
-  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
-  return m_allocations.remove(ptr);
+  if (pattern_size == 0) {
+    UMPIRE_ERROR("Cannot fill with an empty pattern");
+  }
+
+  if (length == 0) {
+    length = available - (available % pattern_size);
+  }
+
+  if (length % pattern_size != 0) {
+    UMPIRE_ERROR("Cannot fill " << length << " bytes with a pattern of " << pattern_size << " bytes");
+  }
+
+  if (length > available) {
+    UMPIRE_ERROR("Cannot fill over the end of allocation: " << length << " -> " << available);
+  }
+
+  auto op = op_registry.find(op::MemoryOperationType::fill,
+      alloc_record.m_strategy,
+      alloc_record.m_strategy);
+
+  UMPIRE_ANNOTATE_SCOPE(stream ? "fill_async" : "fill", alloc_record.m_strategy->getName(), length);
+  op::OperationCounter counter(op::MemoryOperationType::fill,
+      alloc_record.m_strategy, alloc_record.m_strategy, length);
+
+  if (stream) {
+    op->fillAsync(ptr, &alloc_record, pattern, pattern_size, length, stream);
+  } else {
+    op->fill(ptr, &alloc_record, pattern, pattern_size, length);
+  }
 }
 
-bool
-ResourceManager::isAllocatorRegistered(const std::string& name)
+void ResourceManager::advise(const std::string& advice, void* ptr, int device, size_t length)
 {
-  return (m_allocators_by_name.find(name) != m_allocators_by_name.end());
+  advise(advice, ptr, device, length, nullptr);
 }
 
-void ResourceManager::copy(void* dst_ptr, void* src_ptr, size_t size)
+void ResourceManager::advise(const std::string& advice, void* ptr, int device, size_t length, void* stream)
 {
-  UMPIRE_LOG(Debug, "(src_ptr=" << src_ptr << ", dst_ptr=" << dst_ptr << ", size=" << size << ")");
+  UMPIRE_LOG(Debug, "(advice=" << advice << ", ptr=" << ptr << ", device=" << device << ", length=" << length << ", stream=" << stream << ")");
 
   auto& op_registry = op::MemoryOperationRegistry::getInstance();
 
-  auto src_alloc_record = m_allocations.find(src_ptr);
-  auto dst_alloc_record = m_allocations.find(dst_ptr);
+  auto alloc_record = findRecord(ptr);
 
-  std::size_t src_size = src_alloc_record->m_size;
-  std::size_t dst_size = dst_alloc_record->m_size;
+  std::size_t offset = static_cast<char*>(ptr) - static_cast<char*>(alloc_record.m_ptr);
+  std::size_t available = alloc_record.m_size - offset;
 
-  if (size == 0) {
-    size = src_size;
+  if (length == 0) {
+    length = available;
   }
 
-  if (size > dst_size) {
-    UMPIRE_ERROR("Not enough resource in destination for copy: " << size << " -> " << dst_size);
+  if (length > available) {
+    UMPIRE_ERROR("Cannot advise over the end of allocation: " << length << " -> " << available);
   }
 
-  auto op = op_registry.find("COPY", 
-      src_alloc_record->m_strategy, 
-      dst_alloc_record->m_strategy);
+  auto op = op_registry.find(advice,
+      alloc_record.m_strategy,
+      alloc_record.m_strategy);
 
-  op->transform(src_ptr, &dst_ptr, src_alloc_record, dst_alloc_record, size);
+  UMPIRE_ANNOTATE_SCOPE("advise", alloc_record.m_strategy->getName(), length);
+
+  op->applyAsync(ptr, &alloc_record, device, length, stream);
 }
 
-void ResourceManager::memset(void* ptr, int value, size_t length)
+void ResourceManager::prefetch(void* ptr, int device, size_t length)
 {
-  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", value=" << value << ", length=" << length << ")");
+  prefetch(ptr, device, length, nullptr);
+}
+
+void ResourceManager::prefetch(void* ptr, int device, size_t length, void* stream)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", device=" << device << ", length=" << length << ", stream=" << stream << ")");
 
   auto& op_registry = op::MemoryOperationRegistry::getInstance();
 
-  auto alloc_record = m_allocations.find(ptr);
+  auto alloc_record = findRecord(ptr);
 
-  std::size_t src_size = alloc_record->m_size;
+  std::size_t offset = static_cast<char*>(ptr) - static_cast<char*>(alloc_record.m_ptr);
+  std::size_t available = alloc_record.m_size - offset;
 
   if (length == 0) {
-    length = src_size;
+    length = available;
   }
 
-  if (length > src_size) {
-    UMPIRE_ERROR("Cannot memset over the end of allocation: " << length << " -> " << src_size);
+  if (length > available) {
+    UMPIRE_ERROR("Cannot prefetch over the end of allocation: " << length << " -> " << available);
   }
 
-  auto op = op_registry.find("MEMSET", 
-      alloc_record->m_strategy, 
-      alloc_record->m_strategy);
+  auto op = op_registry.find("PREFETCH",
+      alloc_record.m_strategy,
+      alloc_record.m_strategy);
+
+  UMPIRE_ANNOTATE_SCOPE("prefetch", alloc_record.m_strategy->getName(), length);
 
-  op->apply(ptr, alloc_record, value, length);
+  op->applyAsync(ptr, &alloc_record, device, length, stream);
 }
 
 void*
@@ -297,22 +1728,29 @@ ResourceManager::reallocate(void* src_ptr, size_t size)
   void* dst_ptr = nullptr;
 
   if (!src_ptr) {
-    dst_ptr = m_default_allocator->allocate(size);
+    dst_ptr = getDefaultAllocationStrategy()->allocate(size);
   } else {
     auto& op_registry = op::MemoryOperationRegistry::getInstance();
 
-    auto alloc_record = m_allocations.find(src_ptr);
+    auto alloc_record = findRecord(src_ptr);
 
-    if (src_ptr != alloc_record->m_ptr) {
-      UMPIRE_ERROR("Cannot reallocate an offset ptr (ptr=" << src_ptr << ", base=" << alloc_record->m_ptr);
+    if (src_ptr != alloc_record.m_ptr) {
+      UMPIRE_ERROR("Cannot reallocate an offset ptr (ptr=" << src_ptr << ", base=" << alloc_record.m_ptr);
     }
 
-    auto op = op_registry.find("REALLOCATE", 
-        alloc_record->m_strategy, 
-        alloc_record->m_strategy);
+    if (alloc_record.m_strategy->reallocateInPlace(src_ptr, size)) {
+      return src_ptr;
+    }
+
+    auto op = op_registry.find(op::MemoryOperationType::reallocate,
+        alloc_record.m_strategy,
+        alloc_record.m_strategy);
 
+    UMPIRE_ANNOTATE_SCOPE("reallocate", alloc_record.m_strategy->getName(), size);
+    op::OperationCounter counter(op::MemoryOperationType::reallocate,
+        alloc_record.m_strategy, alloc_record.m_strategy, size);
 
-    op->transform(src_ptr, &dst_ptr, alloc_record, alloc_record, size);
+    op->transform(src_ptr, &dst_ptr, &alloc_record, &alloc_record, size);
   }
 
   return dst_ptr;
@@ -328,9 +1766,9 @@ ResourceManager::reallocate(void* src_ptr, size_t size, Allocator allocator)
   if (!src_ptr) {
     dst_ptr = allocator.allocate(size);
   } else {
-    auto alloc_record = m_allocations.find(src_ptr);
+    auto alloc_record = findRecord(src_ptr);
 
-    if (alloc_record->m_strategy == allocator.getAllocationStrategy()) {
+    if (alloc_record.m_strategy == allocator.getAllocationStrategy().get()) {
       dst_ptr = reallocate(src_ptr, size);
     } else {
       UMPIRE_ERROR("Cannot reallocate " << src_ptr << " with Allocator " << allocator.getName());
@@ -345,18 +1783,18 @@ ResourceManager::move(void* ptr, Allocator allocator)
 {
   UMPIRE_LOG(Debug, "(src_ptr=" << ptr << ", allocator=" << allocator.getName() << ")");
 
-  auto alloc_record = m_allocations.find(ptr);
+  auto alloc_record = findRecord(ptr);
 
   // short-circuit if ptr was allocated by 'allocator'
-  if (alloc_record->m_strategy == allocator.getAllocationStrategy()) {
+  if (alloc_record.m_strategy == allocator.getAllocationStrategy().get()) {
     return ptr;
   }
 
-  if (ptr != alloc_record->m_ptr) {
-    UMPIRE_ERROR("Cannot move an offset ptr (ptr=" << ptr << ", base=" << alloc_record->m_ptr);
+  if (ptr != alloc_record.m_ptr) {
+    UMPIRE_ERROR("Cannot move an offset ptr (ptr=" << ptr << ", base=" << alloc_record.m_ptr);
   }
 
-  size_t size = alloc_record->m_size;
+  size_t size = alloc_record.m_size;
   void* dst_ptr = allocator.allocate(size);
 
   copy(dst_ptr, ptr);
@@ -366,40 +1804,360 @@ ResourceManager::move(void* ptr, Allocator allocator)
   return dst_ptr;
 }
 
+void*
+ResourceManager::move(void* ptr, Allocator allocator, void* stream)
+{
+  UMPIRE_LOG(Debug, "(src_ptr=" << ptr << ", allocator=" << allocator.getName() << ", stream=" << stream << ")");
+
+  auto alloc_record = findRecord(ptr);
+
+  if (alloc_record.m_strategy == allocator.getAllocationStrategy().get()) {
+    return ptr;
+  }
+
+  if (ptr != alloc_record.m_ptr) {
+    UMPIRE_ERROR("Cannot move an offset ptr (ptr=" << ptr << ", base=" << alloc_record.m_ptr);
+  }
+
+  freeCompletedMoves(false);
+
+  size_t size = alloc_record.m_size;
+  void* dst_ptr = allocator.allocate(size);
+
+  copy(dst_ptr, ptr, size, stream);
+
+#if defined(UMPIRE_ENABLE_CUDA)
+  if (alloc_record.m_strategy->getPlatform() == Platform::cuda
+      || allocator.getPlatform() == Platform::cuda) {
+    cudaEvent_t event;
+    cudaError_t error = ::cudaEventCreateWithFlags(&event, cudaEventDisableTiming);
+    if (error == cudaSuccess) {
+      error = ::cudaEventRecord(event, static_cast<cudaStream_t>(stream));
+    }
+
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("Recording the completion of the move of " << ptr
+          << " failed with error: " << cudaGetErrorString(error));
+    }
+
+    std::lock_guard<std::mutex> lock(m_pending_moves_mutex);
+    m_pending_moves.push_back({ptr, event});
+    return dst_ptr;
+  }
+#endif
+
+#if defined(UMPIRE_ENABLE_HIP)
+  /*
+   * The copy may still be in flight on the stream, so wait for it before
+   * the source goes back to its allocator.
+   */
+  if (stream) {
+    ::hipStreamSynchronize(static_cast<hipStream_t>(stream));
+  }
+#endif
+
+  deallocate(ptr);
+
+  return dst_ptr;
+}
+
+void*
+ResourceManager::move(void* ptr, int device)
+{
+  return move(ptr, device, nullptr);
+}
+
+void*
+ResourceManager::move(void* ptr, int device, void* stream)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", device=" << device << ", stream=" << stream << ")");
+
+  auto alloc_record = findRecord(ptr);
+
+  if (alloc_record.m_strategy->getResourceType() != resource::UnifiedMemory) {
+    UMPIRE_ERROR("Cannot move " << ptr << " in place, it is not unified memory");
+  }
+
+  if (ptr != alloc_record.m_ptr) {
+    UMPIRE_ERROR("Cannot move an offset ptr (ptr=" << ptr << ", base=" << alloc_record.m_ptr);
+  }
+
+  advise("PREFERRED_LOCATION", ptr, device);
+  prefetch(ptr, device, 0, stream);
+
+  return ptr;
+}
+
+void ResourceManager::synchronizeMoves()
+{
+  UMPIRE_LOG(Debug, "()");
+
+  freeCompletedMoves(true);
+}
+
+std::vector<op::MemoryOperationStatistics>
+ResourceManager::getOperationStatistics()
+{
+  return op::MemoryOperationRegistry::getInstance().getStatistics();
+}
+
+void
+ResourceManager::resetOperationStatistics()
+{
+  op::MemoryOperationRegistry::getInstance().resetStatistics();
+}
+
+void ResourceManager::freeCompletedMoves(bool wait)
+{
+#if !defined(UMPIRE_ENABLE_CUDA)
+  UMPIRE_USE_VAR(wait);
+#endif
+
+  std::vector<PendingMove> completed;
+
+  {
+    std::lock_guard<std::mutex> lock(m_pending_moves_mutex);
+
+    auto first_pending = m_pending_moves.begin();
+    for (auto it = m_pending_moves.begin(); it != m_pending_moves.end(); ++it) {
+#if defined(UMPIRE_ENABLE_CUDA)
+      cudaEvent_t event = static_cast<cudaEvent_t>(it->event);
+      if (wait) {
+        ::cudaEventSynchronize(event);
+      } else if (::cudaEventQuery(event) == cudaErrorNotReady) {
+        *first_pending++ = *it;
+        continue;
+      }
+#endif
+      completed.push_back(*it);
+    }
+    m_pending_moves.erase(first_pending, m_pending_moves.end());
+  }
+
+  for (auto& move : completed) {
+#if defined(UMPIRE_ENABLE_CUDA)
+    ::cudaEventDestroy(static_cast<cudaEvent_t>(move.event));
+#endif
+    deallocate(move.ptr);
+  }
+}
+
 void ResourceManager::deallocate(void* ptr)
 {
   UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
-  auto allocator = findAllocatorForPointer(ptr);;
 
-  allocator->deallocate(ptr);
+  auto chunk_record = m_chunks.find(ptr);
+  if (chunk_record) {
+    chunk_record->m_strategy->deallocate(ptr);
+    return;
+  }
+
+  // Removing the record here both finds the owning strategy and
+  // deregisters the allocation, so the free touches the map once.
+  auto record = m_allocations.remove(ptr);
+  record.m_strategy->deallocateRecord(ptr, record);
+}
+
+void ResourceManager::deallocateMany(void** ptrs, size_t count)
+{
+  UMPIRE_LOG(Debug, "(count=" << count << ")");
+
+  for (size_t i = 0; i < count; ++i) {
+    if (ptrs[i]) {
+      deallocate(ptrs[i]);
+    }
+  }
+}
+
+void ResourceManager::registerHostMemory(void* ptr, size_t size)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", size=" << size << ")");
+
+#if defined(UMPIRE_ENABLE_CUDA)
+  auto registered = std::static_pointer_cast<resource::HostRegisteredMemoryResource>(
+      getAllocationStrategy("HOST_REGISTERED"));
+
+  registered->registerMemory(ptr, size);
+#else
+  UMPIRE_ERROR("Cannot register host memory " << ptr << ", Umpire was built without CUDA");
+#endif
+}
+
+void ResourceManager::registerExternalAllocation(
+    void* ptr, size_t size, resource::MemoryResourceType type)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", size=" << size << ", type=" << type << ")");
+
+  std::string name;
+  switch (type) {
+    case resource::Host:
+    case resource::File:
+      name = "EXTERNAL_HOST";
+      break;
+    case resource::Device:
+      name = "EXTERNAL_DEVICE";
+      break;
+    case resource::UnifiedMemory:
+      name = "EXTERNAL_UM";
+      break;
+    case resource::PinnedMemory:
+      name = "EXTERNAL_PINNED";
+      break;
+  }
+
+  auto external = std::static_pointer_cast<resource::ExternalMemoryResource>(
+      getAllocationStrategy(name));
+
+  external->registerMemory(ptr, size);
+}
+
+void ResourceManager::deregisterExternalAllocation(void* ptr)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  auto record = findRecord(ptr);
+
+  if (record.m_ptr != ptr
+      || !dynamic_cast<resource::ExternalMemoryResource*>(record.m_strategy)) {
+    UMPIRE_ERROR(ptr << " is not a registered external allocation");
+  }
+
+  record.m_strategy->deallocate(ptr);
+}
+
+void* ResourceManager::getDevicePointer(void* ptr)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+#if defined(UMPIRE_ENABLE_CUDA)
+  void* device_ptr = nullptr;
+
+  cudaError_t error = ::cudaHostGetDevicePointer(&device_ptr, ptr, 0);
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaHostGetDevicePointer( ptr = " << ptr << " ) failed with error: " << cudaGetErrorString(error));
+  }
+
+  return device_ptr;
+#else
+  UMPIRE_ERROR("Cannot map " << ptr << " to the device, Umpire was built without CUDA");
+#endif
+}
+
+util::IpcHandle ResourceManager::getIpcHandle(void* ptr, void* stream)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", stream=" << stream << ")");
+
+#if defined(UMPIRE_ENABLE_CUDA)
+  auto record = findRecord(ptr);
+
+  if (record.m_strategy->getResourceType() != resource::Device) {
+    UMPIRE_ERROR("Cannot share " << ptr << ", it is not DEVICE memory");
+  }
+
+  size_t offset = static_cast<char*>(ptr) - static_cast<char*>(record.m_ptr);
+
+  auto ipc = std::static_pointer_cast<resource::DeviceIpcMemoryResource>(
+      getAllocationStrategy("DEVICE_IPC"));
+
+  return ipc->exportMemory(ptr, record.m_size - offset, static_cast<cudaStream_t>(stream));
+#else
+  UMPIRE_USE_VAR(stream);
+  UMPIRE_ERROR("Cannot share " << ptr << ", Umpire was built without CUDA");
+#endif
+}
+
+void* ResourceManager::openIpcHandle(const util::IpcHandle& handle, void* stream)
+{
+  UMPIRE_LOG(Debug, "(offset=" << handle.offset << ", size=" << handle.size << ")");
+
+#if defined(UMPIRE_ENABLE_CUDA)
+  auto ipc = std::static_pointer_cast<resource::DeviceIpcMemoryResource>(
+      getAllocationStrategy("DEVICE_IPC"));
+
+  return ipc->openMemory(handle, static_cast<cudaStream_t>(stream));
+#else
+  UMPIRE_USE_VAR(handle);
+  UMPIRE_USE_VAR(stream);
+  UMPIRE_ERROR("Cannot open an IPC handle, Umpire was built without CUDA");
+#endif
+}
+
+void* ResourceManager::snapshot(void* ptr)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  auto record = findRecord(ptr);
+
+  auto cow = dynamic_cast<resource::CowMemoryResource*>(record.m_strategy);
+  if (!cow || record.m_ptr != ptr) {
+    UMPIRE_ERROR("Cannot snapshot " << ptr << ", it is not the start of a HOST_COW allocation");
+  }
+
+  return cow->snapshot(ptr, record.m_size);
+}
+
+void ResourceManager::deregisterHostMemory(void* ptr)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  auto record = findRecord(ptr);
+
+  if (record.m_ptr != ptr || !record.m_strategy
+      || record.m_strategy->getName() != "HOST_REGISTERED") {
+    UMPIRE_ERROR(ptr << " is not registered host memory");
+  }
+
+  record.m_strategy->deallocate(ptr);
 }
 
 size_t
 ResourceManager::getSize(void* ptr)
 {
-  auto record = m_allocations.find(ptr);
-  UMPIRE_LOG(Debug, "(ptr=" << ptr << ") returning " << record->m_size);
-  return record->m_size;
+  auto record = findRecord(ptr);
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ") returning " << record.m_size);
+  return record.m_size;
+}
+
+util::AllocationMap::Statistics
+ResourceManager::getAllocationMapStatistics()
+{
+  return m_allocations.getStatistics();
+}
+
+util::AllocationRecord ResourceManager::findRecord(void* ptr)
+{
+  auto record = m_chunks.find(ptr);
+
+  return record ? *record : m_allocations.get(ptr);
 }
 
-std::shared_ptr<strategy::AllocationStrategy>& ResourceManager::findAllocatorForPointer(void* ptr)
+strategy::AllocationStrategy* ResourceManager::findAllocatorForPointer(void* ptr)
 {
-  auto allocation_record = m_allocations.find(ptr);
+  auto allocation_record = findRecord(ptr);
 
-  if (! allocation_record->m_strategy) {
+  if (! allocation_record.m_strategy) {
     UMPIRE_ERROR("Cannot find allocator " << ptr);
   }
 
-  UMPIRE_LOG(Debug, "(ptr=" << ptr << ") returning " << allocation_record->m_strategy);
-  return allocation_record->m_strategy;
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ") returning " << allocation_record.m_strategy);
+  return allocation_record.m_strategy;
 }
 
 std::vector<std::string>
 ResourceManager::getAvailableAllocators()
 {
   std::vector<std::string> names;
-  for(auto it = m_allocators_by_name.begin(); it != m_allocators_by_name.end(); ++it) {
-    names.push_back(it->first);
+  m_allocators_by_name.load(std::memory_order_acquire)->forEach(
+      [&] (const AllocatorNameNode& named) {
+    names.push_back(named.name);
+  });
+
+  for (auto& lazy : m_lazy_resources) {
+    names.push_back(lazy->name);
+  }
+
+  for (auto& device : getDeviceResources()) {
+    names.push_back(device->getName());
   }
 
   UMPIRE_LOG(Debug, "() returning " << names.size() << " allocators");
@@ -15,6 +15,8 @@
 #ifndef UMPIRE_ResourceManager_HPP
 #define UMPIRE_ResourceManager_HPP
 
+#include <atomic>
+#include <future>
 #include <vector>
 #include <string>
 #include <memory>
@@ -22,9 +24,15 @@
 #include <list>
 #include <unordered_map>
 
+#include "umpire/AllocationProfile.hpp"
 #include "umpire/Allocator.hpp"
+#include "umpire/UsageSampler.hpp"
+#include "umpire/op/MemoryOperationRegistry.hpp"
 #include "umpire/strategy/AllocationStrategy.hpp"
 #include "umpire/util/AllocationMap.hpp"
+#include "umpire/util/ChunkRegistry.hpp"
+#include "umpire/util/ThreadPool.hpp"
+#include "umpire/util/IpcHandle.hpp"
 
 #include "umpire/resource/MemoryResourceTypes.hpp"
 
@@ -47,7 +55,79 @@ class ResourceManager {
      */
     void initialize();
 
+    /*!
+     * \brief Finish using the ResourceManager.
+     *
+     * Writes the allocation profile, if useProfile has been called, and
+     * stops the usage sampler.
+     */
     void finalize();
+
+    /*!
+     * \brief Finalize, then release every Allocator and the memory it
+     * holds.
+     *
+     * This is meant for the end of a job. The records of all live
+     * allocations are dropped together rather than deregistered one at a
+     * time, and each pool then returns its chunks, including those with
+     * blocks still in use, straight to the Allocator it draws from. With
+     * millions of live allocations this takes milliseconds.
+     *
+     * Allocator objects held elsewhere keep their strategies alive until
+     * they are destroyed. No other thread may use the ResourceManager
+     * during or after this call, and none of the memory it managed may be
+     * used afterwards.
+     */
+    void shutdown();
+
+    /*!
+     * \brief Write the memory usage of every Allocator to filename every
+     * interval_ms milliseconds until stopUsageSampler or finalize.
+     *
+     * A sampler already running is stopped first. getInstance() calls this
+     * with the file named by UMPIRE_USAGE_SAMPLER_FILE, if it is set, and
+     * the interval in UMPIRE_USAGE_SAMPLER_INTERVAL (100ms by default).
+     *
+     * \see UsageSampler
+     */
+    void startUsageSampler(const std::string& filename, int interval_ms = 100);
+
+    /*!
+     * \brief Take a last sample and stop the usage sampler, if one is
+     * running.
+     */
+    void stopUsageSampler();
+
+    /*!
+     * \brief Size new Allocators from the allocation profile in filename,
+     * and record a new profile there at finalize.
+     *
+     * Every Allocator made afterwards records its allocation sizes. One
+     * named in the profile reserves its previous actual size as soon as it
+     * is made (see Allocator::reserve), so a DynamicPool starts with one
+     * chunk as large as it grew to last time instead of growing again. A
+     * missing file is treated as an empty profile, and an empty filename
+     * stops profiling.
+     *
+     * getInstance() calls this with the file named by UMPIRE_PROFILE, if it
+     * is set, before applying UMPIRE_CONFIG.
+     */
+    void useProfile(const std::string& filename);
+
+    /*!
+     * \brief Return the profile loaded by useProfile, updated with the
+     * usage so far of every Allocator made with makeAllocator.
+     */
+    AllocationProfile getProfile();
+
+    /*!
+     * \brief Create the Allocators described in the configuration file
+     * filename.
+     *
+     * See AllocatorConfiguration for the file format. getInstance() calls
+     * this with the file named by UMPIRE_CONFIG, if it is set.
+     */
+    void configure(const std::string& filename);
     
     /*!
      * \brief Get the names of all available Allocator objects.
@@ -73,7 +153,8 @@ class ResourceManager {
      * \brief Get the default Allocator.
      *
      * The default Allocator is used whenever an Allocator is required and one
-     * is not provided, or cannot be inferred.
+     * is not provided, or cannot be inferred. This is the calling thread's
+     * own default, if it has set one, and otherwise the global default.
      *
      * \return The default Allocator.
      */
@@ -89,6 +170,23 @@ class ResourceManager {
      */
     void setDefaultAllocator(Allocator allocator);
 
+    /*!
+     * \brief Set the default Allocator of the calling thread only.
+     *
+     * Other threads keep using their own default, or the global one, so a
+     * worker can send its implicit allocations to a private pool without
+     * affecting anyone else. See also ScopedDefaultAllocator.
+     *
+     * \param allocator The Allocator to use as this thread's default.
+     */
+    void setThreadDefaultAllocator(Allocator allocator);
+
+    /*!
+     * \brief Make the calling thread use the global default Allocator
+     * again.
+     */
+    void resetThreadDefaultAllocator();
+
     /*!
      * \brief Construct a new Allocator.
      *
@@ -99,6 +197,23 @@ class ResourceManager {
         const std::string& name, 
         Args&&... args);
 
+    /*!
+     * \brief Make a DynamicPool over each DEVICE::n resource, named
+     * name::n, with its first initial_size bytes already allocated.
+     *
+     * Each device is set up on a thread of its own: creating its context,
+     * the per-device resources and the pool's first chunk, prefetching the
+     * chunk too if prefault is set for managed memory. The call returns once
+     * every device is done, so it takes about as long as the slowest device
+     * rather than the sum of all of them.
+     *
+     * \return The pools in device order, or none if there are no devices.
+     */
+    std::vector<Allocator> makeDevicePools(
+        const std::string& name,
+        size_t initial_size,
+        bool prefault = false);
+
     /*!
      * \brief Register an Allocator with the ResourceManager.
      *
@@ -131,9 +246,66 @@ class ResourceManager {
      */
     bool hasAllocator(void* ptr);
     
-    void registerAllocation(void* ptr, util::AllocationRecord* record);
+    /*!
+     * \brief Register an allocation with the ResourceManager.
+     *
+     * A copy of record is stored in the AllocationMap. While a strategy
+     * stacked on top of the caller has an AllocationStrategy::OwnerScope
+     * open, the copy names that strategy instead.
+     *
+     * \return Pointer to the stored AllocationRecord, or nullptr if the
+     * AllocationMap is compact and packed the record.
+     */
+    util::AllocationRecord* registerAllocation(void* ptr, const util::AllocationRecord& record);
+
+    /*!
+     * \brief Deregister the most recent allocation of ptr.
+     *
+     * \return Copy of the AllocationRecord that was removed.
+     */
+    util::AllocationRecord deregisterAllocation(void* ptr);
 
-    util::AllocationRecord* deregisterAllocation(void* ptr);
+    /*!
+     * \brief Register count allocations at once, taking each AllocationMap
+     * lock once instead of once per allocation.
+     */
+    void registerAllocationBatch(void** ptrs, const util::AllocationRecord* records, size_t count);
+
+    /*!
+     * \brief Deregister every allocation whose pointer lies in [begin, end).
+     *
+     * Strategies that free many allocations together, such as an arena
+     * reset or a pool being destroyed, use this instead of calling
+     * deregisterAllocation for each one.
+     *
+     * \param strategy If not nullptr, only allocations made by this
+     * strategy are deregistered.
+     *
+     * \return Number of allocations deregistered.
+     */
+    size_t deregisterAllocationRange(void* begin, void* end,
+        strategy::AllocationStrategy* strategy = nullptr);
+
+    /*!
+     * \brief Register [ptr, ptr + size) as a chunk owned by strategy.
+     *
+     * Pointer lookups that land in the chunk are answered by
+     * strategy->findRecord(ptr, handle), so a pool that registers its chunks
+     * does not need to register each allocation it makes from them.
+     */
+    void registerChunk(void* ptr, size_t size,
+        strategy::AllocationStrategy* strategy, void* handle);
+
+    /*!
+     * \brief Deregister the chunk starting at ptr owned by strategy.
+     */
+    void deregisterChunk(void* ptr, strategy::AllocationStrategy* strategy);
+
+    /*!
+     * \brief Return the handle strategy registered for the chunk containing
+     * ptr, or nullptr if ptr is not in one of its chunks.
+     */
+    void* findChunk(void* ptr, const strategy::AllocationStrategy* strategy) const;
 
     /*!
      * \brief Check whether the named Allocator exists.
@@ -155,6 +327,180 @@ class ResourceManager {
      */
     void copy(void* dst_ptr, void* src_ptr, size_t size=0);
 
+    /*!
+     * \brief Copy size bytes of data from src_ptr to dst_ptr, compressing
+     * the data on its way.
+     *
+     * Copies between HOST and DEVICE memory use the "COPY_COMPRESSED"
+     * operation, which sends LZ4-compressed chunks over the bus when Umpire
+     * is built with ENABLE_NVCOMP and the data compresses well. Other
+     * copies, and all copies without ENABLE_NVCOMP, are the same as copy.
+     * Allocator::setCompressCopies makes copy behave like this for every
+     * copy into or out of an Allocator.
+     *
+     * \param dst_ptr Destination pointer.
+     * \param src_ptr Source pointer.
+     * \param size Size in bytes (0 copies the whole source allocation).
+     */
+    void copyCompressed(void* dst_ptr, void* src_ptr, size_t size=0);
+
+    /*!
+     * \brief Copy size bytes of data from src_ptr to dst_ptr, ordered on
+     * stream.
+     *
+     * For copies involving CUDA memory, this issues a cudaMemcpyAsync on
+     * stream and may return before the copy has completed; the caller must
+     * synchronize the stream before using the data. Copies between host
+     * resources complete before returning.
+     *
+     * \param dst_ptr Destination pointer.
+     * \param src_ptr Source pointer.
+     * \param size Size in bytes (0 copies the whole source allocation).
+     * \param stream Stream to order the copy on, e.g. a cudaStream_t.
+     */
+    void copy(void* dst_ptr, void* src_ptr, size_t size, void* stream);
+
+    /*!
+     * \brief Copy size bytes of data between two host allocations on a
+     * background thread.
+     *
+     * The pointers and size are checked before returning, and the copy is
+     * then queued to a small pool of threads, where large copies are split
+     * across threads as in copy. Both allocations must stay alive until
+     * the returned future is ready; any error from the copy is rethrown by
+     * its get().
+     *
+     * \param dst_ptr Destination pointer.
+     * \param src_ptr Source pointer.
+     * \param size Size in bytes (0 copies the whole source allocation).
+     *
+     * \throws util::Exception if either pointer is not in cpu memory.
+     */
+    std::future<void> copyAsync(void* dst_ptr, void* src_ptr, size_t size=0);
+
+    /*!
+     * \brief Copy size bytes of data from src_ptr to dst_ptr, where the
+     * Allocators that own them are already known.
+     *
+     * This skips the allocation lookups done by the other copy methods, so
+     * it is the cheapest way to issue many small copies. No checking is
+     * done: src_ptr and dst_ptr must lie in allocations made by
+     * src_allocator and dst_allocator respectively, and both must hold at
+     * least size bytes past the pointer.
+     *
+     * \param dst_ptr Destination pointer.
+     * \param dst_allocator Allocator that owns dst_ptr.
+     * \param src_ptr Source pointer.
+     * \param src_allocator Allocator that owns src_ptr.
+     * \param size Size in bytes.
+     */
+    void copy(
+        void* dst_ptr, Allocator& dst_allocator,
+        void* src_ptr, Allocator& src_allocator,
+        size_t size);
+
+    /*!
+     * \brief Perform count independent copies in one call.
+     *
+     * Copy i moves sizes[i] bytes from src_ptrs[i] to dst_ptrs[i], with a
+     * size of 0 meaning the whole source allocation, exactly as for copy.
+     * All allocations are looked up and checked before any data is moved.
+     * Copies are then grouped by source and destination platform and each
+     * group is handed to its MemoryOperation at once, which lets CUDA
+     * copies share a single synchronization.
+     *
+     * \param dst_ptrs Destination pointers.
+     * \param src_ptrs Source pointers.
+     * \param sizes Size in bytes of each copy.
+     * \param count Number of copies.
+     */
+    void copyBatch(void** dst_ptrs, void** src_ptrs, size_t* sizes, size_t count);
+
+    /*!
+     * \brief Perform count independent copies, ordered on stream.
+     *
+     * As copyBatch, but transfers between host and device memory may still
+     * be running when this returns; synchronize stream before using the
+     * data. In CUDA builds these go through the op::CudaCopyScheduler,
+     * which puts host-to-device and device-to-host transfers on separate
+     * streams so both copy engines run at once, and makes stream wait for
+     * them. Copies between host allocations complete before returning.
+     *
+     * \param dst_ptrs Destination pointers.
+     * \param src_ptrs Source pointers.
+     * \param sizes Size in bytes of each copy.
+     * \param count Number of copies.
+     * \param stream Stream to order the copies on, e.g. a cudaStream_t.
+     */
+    void copyBatch(void** dst_ptrs, void** src_ptrs, size_t* sizes, size_t count, void* stream);
+
+    /*!
+     * \brief Copy a width x height block of bytes between two pitched 2D
+     * arrays.
+     *
+     * Row j of the block starts at src_ptr + j*src_pitch in the source and
+     * at dst_ptr + j*dst_pitch in the destination, so columns or sub-blocks
+     * of an array can be copied without packing them first. Both pointers
+     * must be allocated by Umpire, and the allocations must hold every row.
+     *
+     * \param dst_ptr Destination pointer.
+     * \param dst_pitch Bytes between rows of the destination.
+     * \param src_ptr Source pointer.
+     * \param src_pitch Bytes between rows of the source.
+     * \param width Bytes to copy from each row.
+     * \param height Number of rows to copy.
+     */
+    void copy2D(
+        void* dst_ptr, size_t dst_pitch,
+        void* src_ptr, size_t src_pitch,
+        size_t width, size_t height);
+
+    /*!
+     * \brief Copy a width x height block of bytes between two pitched 2D
+     * arrays, ordered on stream.
+     *
+     * As for the asynchronous copy, CUDA copies may return before the data
+     * has moved.
+     */
+    void copy2D(
+        void* dst_ptr, size_t dst_pitch,
+        void* src_ptr, size_t src_pitch,
+        size_t width, size_t height,
+        void* stream);
+
+    /*!
+     * \brief Copy a width x height x depth block of bytes between two pitched
+     * 3D arrays.
+     *
+     * Each array is stored as slices of rows: rows are pitch bytes apart and
+     * slices are pitch*array_height bytes apart. Row j of slice k of the
+     * block starts at ptr + (k*array_height + j)*pitch.
+     *
+     * \param dst_ptr Destination pointer.
+     * \param dst_pitch Bytes between rows of the destination.
+     * \param dst_height Rows per slice of the destination array.
+     * \param src_ptr Source pointer.
+     * \param src_pitch Bytes between rows of the source.
+     * \param src_height Rows per slice of the source array.
+     * \param width Bytes to copy from each row.
+     * \param height Rows to copy from each slice.
+     * \param depth Number of slices to copy.
+     */
+    void copy3D(
+        void* dst_ptr, size_t dst_pitch, size_t dst_height,
+        void* src_ptr, size_t src_pitch, size_t src_height,
+        size_t width, size_t height, size_t depth);
+
+    /*!
+     * \brief Copy a width x height x depth block of bytes between two pitched
+     * 3D arrays, ordered on stream.
+     */
+    void copy3D(
+        void* dst_ptr, size_t dst_pitch, size_t dst_height,
+        void* src_ptr, size_t src_pitch, size_t src_height,
+        size_t width, size_t height, size_t depth,
+        void* stream);
+
     /*!
      * \brief Set the first length bytes of ptr to the value val.
      *
@@ -164,6 +510,131 @@ class ResourceManager {
      */
     void memset(void* ptr, int val, size_t length=0);
 
+    /*!
+     * \brief Set the first length bytes of ptr to the value val, ordered on
+     * stream.
+     *
+     * For CUDA memory, this issues a cudaMemsetAsync on stream and may
+     * return before the memset has completed.
+     *
+     * \param ptr Pointer to data.
+     * \param val Value to set.
+     * \param length Number of bytes to set to val (0 sets the whole
+     * allocation).
+     * \param stream Stream to order the memset on, e.g. a cudaStream_t.
+     */
+    void memset(void* ptr, int val, size_t length, void* stream);
+
+    /*!
+     * \brief Fill the first length bytes of ptr with repeated copies of a
+     * pattern_size byte pattern.
+     *
+     * ptr may point into the middle of an allocation.
+     *
+     * \param ptr Pointer to data.
+     * \param pattern Pointer to the pattern, in host memory.
+     * \param pattern_size Size of the pattern in bytes.
+     * \param length Number of bytes to fill (0 fills up to the end of the
+     * allocation).
+     *
+     * \throws umpire::util::Exception if length is not a multiple of
+     * pattern_size, or the range extends past the end of the allocation.
+     */
+    void fill(void* ptr, const void* pattern, size_t pattern_size, size_t length=0);
+
+    /*!
+     * \brief Fill the first length bytes of ptr with repeated copies of a
+     * pattern_size byte pattern, ordered on stream.
+     *
+     * pattern may be reused as soon as this returns, but for CUDA memory the
+     * fill itself may not have completed.
+     *
+     * \param ptr Pointer to data.
+     * \param pattern Pointer to the pattern, in host memory.
+     * \param pattern_size Size of the pattern in bytes.
+     * \param length Number of bytes to fill (0 fills up to the end of the
+     * allocation).
+     * \param stream Stream to order the fill on, e.g. a cudaStream_t.
+     */
+    void fill(void* ptr, const void* pattern, size_t pattern_size, size_t length, void* stream);
+
+    /*!
+     * \brief Set the first count elements of ptr to value.
+     *
+     * \param ptr Pointer to data.
+     * \param value Value to set each element to.
+     * \param count Number of elements to set (0 sets every element up to the
+     * end of the allocation).
+     */
+    template <typename T>
+    void fill(T* ptr, const T& value, size_t count=0);
+
+    /*!
+     * \brief Apply a memory advice operation to the first length bytes of
+     * ptr.
+     *
+     * ptr may point into the middle of an allocation, so advice can be
+     * given for any sub-range.
+     *
+     * \param advice Name of the operation, e.g. "READ_MOSTLY",
+     * "PREFERRED_LOCATION" or "ACCESSED_BY".
+     * \param ptr Pointer to data.
+     * \param device Device the advice refers to, or cudaCpuDeviceId for the
+     * host.
+     * \param length Number of bytes to advise (0 advises up to the end of
+     * the allocation).
+     *
+     * \throws umpire::util::Exception if the range extends past the end of
+     * the allocation, or the advice is not available for its memory.
+     */
+    void advise(const std::string& advice, void* ptr, int device, size_t length=0);
+
+    /*!
+     * \brief Apply a memory advice operation to the first length bytes of
+     * ptr, for work on stream.
+     *
+     * "PERSISTING_L2" sets the access policy window of stream, so kernels
+     * launched on it afterwards keep the range in the L2 cache. Other
+     * advice does not depend on the stream.
+     *
+     * \param advice Name of the operation, e.g. "PERSISTING_L2".
+     * \param ptr Pointer to data.
+     * \param device Device the advice refers to.
+     * \param length Number of bytes to advise (0 advises up to the end of
+     * the allocation).
+     * \param stream Stream the advice is for, e.g. a cudaStream_t.
+     */
+    void advise(const std::string& advice, void* ptr, int device, size_t length, void* stream);
+
+    /*!
+     * \brief Prefetch the first length bytes of ptr to device.
+     *
+     * ptr may point into the middle of an allocation.
+     *
+     * For unified memory this uses cudaMemPrefetchAsync on the default
+     * stream. Use cudaCpuDeviceId as device to prefetch to the host.
+     *
+     * \param ptr Pointer to data.
+     * \param device Device to move the data to.
+     * \param length Number of bytes to prefetch (0 prefetches up to the end
+     * of the allocation).
+     *
+     * \throws umpire::util::Exception if ptr's memory cannot be prefetched.
+     */
+    void prefetch(void* ptr, int device, size_t length=0);
+
+    /*!
+     * \brief Prefetch the first length bytes of ptr to device, ordered on
+     * stream.
+     *
+     * \param ptr Pointer to data.
+     * \param device Device to move the data to.
+     * \param length Number of bytes to prefetch (0 prefetches up to the end
+     * of the allocation).
+     * \param stream Stream to order the prefetch on, e.g. a cudaStream_t.
+     */
+    void prefetch(void* ptr, int device, size_t length, void* stream);
+
     /*!
      * \brief Reallocate src_ptr to size.
      *
@@ -202,6 +673,80 @@ class ResourceManager {
      */
     void* move(void* src_ptr, Allocator allocator);
 
+    /*!
+     * \brief Move src_ptr to memory from allocator, ordered on stream.
+     *
+     * The new memory is allocated and the copy is issued on stream, and
+     * the new pointer is returned straight away. Work queued on stream
+     * afterwards sees the moved data, and the host can wait for it by
+     * synchronizing stream. Moves of many arrays on different streams can
+     * therefore overlap with each other and with computation.
+     *
+     * src_ptr must not be used after this call. It is freed once the copy
+     * has completed: completed moves are cleaned up by later calls to this
+     * method, or all at once by synchronizeMoves. Moves between host
+     * resources complete, and free src_ptr, before returning.
+     *
+     * \param src_ptr Pointer to move.
+     * \param allocator Allocator to use to allocate new memory for moved data.
+     * \param stream Stream to order the copy on, e.g. a cudaStream_t.
+     *
+     * \return Pointer to new location of data.
+     */
+    void* move(void* src_ptr, Allocator allocator, void* stream);
+
+    /*!
+     * \brief Move a unified memory allocation to device in place.
+     *
+     * Rather than allocating new memory and copying, which doubles the
+     * footprint while both copies exist, the pages of ptr are given device
+     * as their preferred location and prefetched there. The pointer and the
+     * Allocator that owns it are unchanged. Use cudaCpuDeviceId as device to
+     * move the data to the host.
+     *
+     * \param ptr Pointer to a unified memory allocation.
+     * \param device Device to move the data to.
+     *
+     * \return ptr
+     *
+     * \throws umpire::util::Exception if ptr is not the start of a unified
+     * memory allocation.
+     */
+    void* move(void* ptr, int device);
+
+    /*!
+     * \brief Move a unified memory allocation to device in place, with the
+     * prefetch ordered on stream.
+     *
+     * \param ptr Pointer to a unified memory allocation.
+     * \param device Device to move the data to.
+     * \param stream Stream to order the prefetch on, e.g. a cudaStream_t.
+     *
+     * \return ptr
+     */
+    void* move(void* ptr, int device, void* stream);
+
+    /*!
+     * \brief Wait for every move issued with a stream to complete, and free
+     * their sources.
+     */
+    void synchronizeMoves();
+
+    /*!
+     * \brief Return the calls, bytes and time of every copy, memset, fill
+     * and reallocate operation, by operation type and platform pair.
+     *
+     * Only pairs that have been used since the last reset are returned.
+     * Time is measured around the call into the operation, so for calls
+     * taking a stream it excludes the transfer itself.
+     */
+    std::vector<op::MemoryOperationStatistics> getOperationStatistics();
+
+    /*!
+     * \brief Set the counters returned by getOperationStatistics to zero.
+     */
+    void resetOperationStatistics();
+
     /*!
      * \brief Deallocate any pointer allocated by an Umpire-managed resource.
      *
@@ -209,6 +754,127 @@ class ResourceManager {
      */
     void deallocate(void* ptr);
 
+    /*!
+     * \brief Deallocate count pointers allocated by any Umpire-managed
+     * resources.
+     *
+     * The pointers may belong to different Allocators. Null pointers are
+     * ignored.
+     *
+     * \param ptrs Pointers to deallocate.
+     * \param count Number of pointers.
+     */
+    void deallocateMany(void** ptrs, size_t count);
+
+    /*!
+     * \brief Page-lock size bytes of existing host memory at ptr.
+     *
+     * This is for host arrays that Umpire did not allocate. The range is
+     * registered with cudaHostRegister and recorded as belonging to the
+     * HOST_REGISTERED allocator, so copies between it and the GPU take the
+     * same path as PINNED memory. The range is unregistered by
+     * deregisterHostMemory, or by deallocate, neither of which frees the
+     * memory itself.
+     *
+     * \param ptr Start of the host memory.
+     * \param size Size of the host memory in bytes.
+     */
+    void registerHostMemory(void* ptr, size_t size);
+
+    /*!
+     * \brief Unregister host memory registered with registerHostMemory.
+     *
+     * \param ptr Pointer passed to registerHostMemory.
+     */
+    void deregisterHostMemory(void* ptr);
+
+    /*!
+     * \brief Make a copy-on-write snapshot of a HOST_COW allocation.
+     *
+     * The snapshot is a new HOST_COW allocation holding the contents of ptr
+     * at the time of the call. Pages are shared until the allocation or the
+     * snapshot writes them, so a snapshot costs time and memory in proportion
+     * to the pages written afterwards rather than to its size. Release it
+     * with deallocate.
+     *
+     * \param ptr Start of an allocation from HOST_COW.
+     *
+     * \return Pointer to the snapshot.
+     */
+    void* snapshot(void* ptr);
+
+    /*!
+     * \brief Record size bytes of memory at ptr, allocated outside of Umpire,
+     * as memory of the given type.
+     *
+     * The record does not own the memory: it lets copy, memset and advice
+     * operations treat a foreign buffer like one of Umpire's own
+     * allocations of that type. Remove it with deregisterExternalAllocation
+     * before the memory is freed by its owner.
+     *
+     * \param ptr Start of the memory.
+     * \param size Size of the memory in bytes.
+     * \param type Kind of memory that ptr points to.
+     */
+    void registerExternalAllocation(
+        void* ptr, size_t size, resource::MemoryResourceType type);
+
+    /*!
+     * \brief Remove the record made by registerExternalAllocation.
+     *
+     * The memory itself is not freed.
+     *
+     * \param ptr Pointer passed to registerExternalAllocation.
+     */
+    void deregisterExternalAllocation(void* ptr);
+
+    /*!
+     * \brief Return the address by which kernels can access mapped host
+     * memory.
+     *
+     * ptr may point anywhere inside an allocation from PINNED_MAPPED.
+     * Kernels read and write the memory directly over the interconnect, so
+     * it suits small, rarely reused data such as reduction results and
+     * flags, which then need no ResourceManager::copy.
+     *
+     * \param ptr Host pointer to mapped memory.
+     *
+     * \return Device pointer to the same memory.
+     */
+    void* getDevicePointer(void* ptr);
+
+    /*!
+     * \brief Make a handle by which another process can open a DEVICE
+     * allocation.
+     *
+     * ptr may come from DEVICE or from any pool built on it. The handle
+     * can be sent to the other process by any means and passed to
+     * openIpcHandle there.
+     *
+     * \param ptr Pointer to DEVICE memory.
+     * \param stream cudaStream_t whose queued work the opening process
+     *        waits for, or nullptr for the default stream.
+     *
+     * \return Handle for the allocation.
+     */
+    util::IpcHandle getIpcHandle(void* ptr, void* stream = nullptr);
+
+    /*!
+     * \brief Open a DEVICE allocation exported by another process.
+     *
+     * The allocation is recorded as belonging to the DEVICE_IPC allocator,
+     * so copies and memsets treat it as DEVICE memory. Opening the same
+     * handle again returns the same pointer. Each open is closed by
+     * deallocate, which never frees the memory itself.
+     *
+     * \param handle Handle from getIpcHandle in the other process.
+     * \param stream cudaStream_t that waits for the exporter's work, or
+     *        nullptr for the default stream.
+     *
+     * \return Pointer to the allocation in this process.
+     */
+    void* openIpcHandle(const util::IpcHandle& handle, void* stream = nullptr);
+
     /*!
      * \brief Get the size in bytes of the allocation for the given pointer.
      *
@@ -218,36 +884,235 @@ class ResourceManager {
      */
     size_t getSize(void* ptr);
 
+    /*!
+     * \brief Return the number of registered allocations and the bytes of
+     * bookkeeping memory used to track them.
+     *
+     * Allocations resolved through registered chunks are not included.
+     */
+    util::AllocationMap::Statistics getAllocationMapStatistics();
+
 
   private:
+    friend class ScopedDefaultAllocator;
+    friend class UsageSampler;
+
     ResourceManager();
 
+    /*
+     * The strategy used where no Allocator is given: the calling thread's
+     * default, or else the global one.
+     */
+    strategy::AllocationStrategy* getDefaultAllocationStrategy();
+
+    /*
+     * Replace the calling thread's default, returning the previous one
+     * (null if it had none).
+     */
+    std::shared_ptr<strategy::AllocationStrategy> exchangeThreadDefaultAllocator(
+        std::shared_ptr<strategy::AllocationStrategy> allocator);
+
     ResourceManager (const ResourceManager&) = delete;
     ResourceManager& operator= (const ResourceManager&) = delete;
 
-    std::shared_ptr<strategy::AllocationStrategy>& findAllocatorForPointer(void* ptr);
-    std::shared_ptr<strategy::AllocationStrategy>& getAllocationStrategy(const std::string& name);
+    strategy::AllocationStrategy* findAllocatorForPointer(void* ptr);
+
+    /*
+     * Return a copy of the record for ptr from the registered chunks, or
+     * else from m_allocations. Throws if neither knows of it.
+     */
+    util::AllocationRecord findRecord(void* ptr);
+
+    /*
+     * Check the bounds of a copy3D and hand it to the copy operation, which
+     * is asynchronous when stream is given.
+     */
+    void copyStrided(
+        void* dst_ptr, size_t dst_pitch, size_t dst_height,
+        void* src_ptr, size_t src_pitch, size_t src_height,
+        size_t width, size_t height, size_t depth,
+        void* stream, bool async);
+
+    /*
+     * Issue the copies of copyBatch on stream, grouped by operation, and
+     * return whether any group involved device memory.
+     */
+    bool copyGrouped(void** dst_ptrs, void** src_ptrs, size_t* sizes, size_t count, void* stream);
+
+    /*
+     * Copy as in copy, using "COPY_COMPRESSED" if compress is set or either
+     * allocation's strategy compresses its copies.
+     */
+    void copyRecords(void* dst_ptr, void* src_ptr, size_t size, bool compress);
+
+    std::shared_ptr<strategy::AllocationStrategy> getAllocationStrategy(const std::string& name);
+
+    /*
+     * Publish allocator under name. The caller must hold m_mutex.
+     */
+    void addAllocator(const std::string& name,
+        const std::shared_ptr<strategy::AllocationStrategy>& allocator);
+
+    /*
+     * Make allocator visible to getAllocator(int). Safe to call without
+     * m_mutex, as long as no other thread publishes the same id.
+     */
+    void addAllocatorId(const std::shared_ptr<strategy::AllocationStrategy>& allocator);
+
+    /*
+     * If a profile is in use, enable statistics on a newly made allocator
+     * and reserve the actual size the profile records for it.
+     */
+    void applyProfile(const std::shared_ptr<strategy::AllocationStrategy>& allocator);
+
+    /*
+     * A MemoryResource that is only made when it is first asked for. The id
+     * is reserved by initialize().
+     */
+    struct LazyResource {
+      std::string name;
+      int id;
+      std::once_flag created;
+      std::shared_ptr<strategy::AllocationStrategy> resource;
+    };
+
+    LazyResource* findLazyResource(const std::string& name);
+    std::shared_ptr<strategy::AllocationStrategy>& getLazyResource(LazyResource& lazy);
+
+    /*
+     * A PINNED_POOL allocator: a thread-safe DynamicPool over pinned, so
+     * staging buffers do not pay for cudaMallocHost each time.
+     */
+    std::shared_ptr<strategy::AllocationStrategy> makePinnedPool(
+        const std::string& name, int id, Allocator pinned);
+
+    /*
+     * The per-device DEVICE::n resources, and with NUMA support the
+     * PINNED::n and PINNED_POOL::n resources local to each device, made
+     * together on first use since even counting the devices initializes
+     * CUDA. Each device's context and resources are made on a thread of
+     * its own.
+     */
+    std::vector<std::shared_ptr<strategy::AllocationStrategy> >& getDeviceResources();
 
     int getNextId();
 
-    static ResourceManager* s_resource_manager_instance;
+    static std::atomic<ResourceManager*> s_resource_manager_instance;
 
     std::list<std::string> m_allocator_names;
 
-    std::unordered_map<std::string, std::shared_ptr<strategy::AllocationStrategy> > m_allocators_by_name;
-    std::unordered_map<int, std::shared_ptr<strategy::AllocationStrategy> > m_allocators_by_id;
+    struct AllocatorNameNode {
+      std::string name;
+      std::shared_ptr<strategy::AllocationStrategy> strategy;
+      const AllocatorNameNode* next;
+    };
+
+    /*
+     * Hash table of AllocatorNameNodes that is only ever added to.
+     */
+    struct AllocatorNameTable {
+      explicit AllocatorNameTable(size_t num_buckets);
+      ~AllocatorNameTable();
+
+      const AllocatorNameNode* find(const std::string& name) const;
+
+      /*
+       * Push a node for name onto its bucket. The caller must hold m_mutex.
+       */
+      void insert(const std::string& name,
+          const std::shared_ptr<strategy::AllocationStrategy>& strategy);
+
+      template<typename Function>
+      void forEach(Function&& function) const
+      {
+        for (size_t i = 0; i <= mask; ++i) {
+          for (const AllocatorNameNode* node = buckets[i].load(std::memory_order_acquire);
+              node; node = node->next) {
+            function(*node);
+          }
+        }
+      }
+
+      size_t mask;
+      size_t size;
+      std::unique_ptr<std::atomic<const AllocatorNameNode*>[]> buckets;
+    };
+
+    /*
+     * Allocators by name. Names are added under m_mutex and never removed
+     * before shutdown, and each node is published with a release store, so
+     * lookups take no lock.
+     *
+     * When the table is full it is replaced by one with twice the buckets
+     * and its own copy of every node. Readers may still be walking the old
+     * tables, so they are kept until shutdown, but they halve in size each
+     * time, so all of them together hold fewer nodes than the current one.
+     */
+    std::atomic<const AllocatorNameTable*> m_allocators_by_name;
+    std::vector<std::unique_ptr<AllocatorNameTable> > m_allocator_name_tables;
+
+    /*
+     * Allocators by id, in chunks that are allocated on demand and never
+     * move, so getAllocator(int) is a couple of loads. Ids past the end of
+     * the table are found by searching m_allocators_by_name.
+     */
+    struct AllocatorSlot {
+      std::shared_ptr<strategy::AllocationStrategy> strategy;
+      std::atomic<bool> valid{false};
+    };
+
+    static const int s_allocators_per_chunk = 256;
+    static const int s_allocator_chunks = 1024;
+
+    // Initial bucket count of m_allocators_by_name, a power of two.
+    static const size_t s_allocator_name_buckets = 64;
+
+    std::atomic<AllocatorSlot*> m_allocators_by_id[s_allocator_chunks];
 
     util::AllocationMap m_allocations;
 
+    util::ChunkRegistry m_chunks;
+
     std::shared_ptr<strategy::AllocationStrategy> m_default_allocator;
 
-    std::unordered_map<resource::MemoryResourceType, std::shared_ptr<strategy::AllocationStrategy>, resource::MemoryResourceTypeHash > m_memory_resources;
+    std::vector<std::unique_ptr<LazyResource> > m_lazy_resources;
+
+    std::once_flag m_device_resources_created;
+    std::vector<std::shared_ptr<strategy::AllocationStrategy> > m_device_resources;
 
     long m_allocated;
 
-    int m_id;
+    std::atomic<int> m_id;
 
     std::mutex* m_mutex;
+
+    /*
+     * Sources of asynchronous moves, each freed once its event (a
+     * cudaEvent_t) has completed.
+     */
+    struct PendingMove {
+      void* ptr;
+      void* event;
+    };
+
+    /*
+     * Free the sources of the pending moves that have completed, or of all
+     * of them if wait is set.
+     */
+    void freeCompletedMoves(bool wait);
+
+    std::vector<PendingMove> m_pending_moves;
+    std::mutex m_pending_moves_mutex;
+
+    std::string m_profile_filename;
+    AllocationProfile m_profile;
+
+    std::mutex m_usage_sampler_mutex;
+    std::unique_ptr<UsageSampler> m_usage_sampler;
+
+    // Threads running copyAsync, started by its first call.
+    std::mutex m_copy_pool_mutex;
+    std::unique_ptr<util::ThreadPool> m_copy_pool;
 };
 
 } // end of namespace umpire
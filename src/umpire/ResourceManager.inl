@@ -39,17 +39,24 @@ Allocator ResourceManager::makeAllocator(
 
     allocator = std::make_shared<Strategy>(name, getNextId(), std::forward<Args>(args)...);
 
-    m_allocators_by_name[name] = allocator;
-    m_allocators_by_id[allocator->getId()] = allocator;
+    addAllocator(name, allocator);
     UMPIRE_UNLOCK;
   } catch (...) {
     UMPIRE_UNLOCK;
     throw;
   }
 
+  applyProfile(allocator);
+
   return Allocator(allocator);
 }
 
+template <typename T>
+void ResourceManager::fill(T* ptr, const T& value, size_t count)
+{
+  fill(static_cast<void*>(ptr), static_cast<const void*>(&value), sizeof(T), count*sizeof(T));
+}
+
 } // end of namespace umpire
 
 #endif // UMPIRE_ResourceManager_INL
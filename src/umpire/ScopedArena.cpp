@@ -0,0 +1,78 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/ScopedArena.hpp"
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+
+ScopedArena::ScopedArena(
+    Allocator allocator,
+    const std::size_t block_size,
+    const bool track_allocations) :
+  m_arena(std::dynamic_pointer_cast<strategy::ArenaAllocator>(
+        allocator.getAllocationStrategy())),
+  m_mark()
+{
+  UMPIRE_LOG(Debug, "(allocator=" << allocator.getName() << ")");
+
+  if (!m_arena) {
+    m_arena = std::make_shared<strategy::ArenaAllocator>(
+        allocator.getName() + "::scope", allocator.getId(), allocator,
+        block_size, 16, track_allocations);
+  }
+
+  m_mark = m_arena->mark();
+}
+
+ScopedArena::~ScopedArena()
+{
+  try {
+    m_arena->rewind(m_mark);
+  } catch (...) {
+    // The arena was already rewound past the mark, so nothing is left to
+    // free.
+  }
+}
+
+void*
+ScopedArena::allocate(size_t bytes)
+{
+  return m_arena->allocate(bytes);
+}
+
+void*
+ScopedArena::allocate(size_t bytes, size_t alignment)
+{
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+    UMPIRE_ERROR("Alignment must be a power of two, got " << alignment);
+  }
+
+  return m_arena->allocateAligned(bytes, alignment);
+}
+
+void
+ScopedArena::reset()
+{
+  m_arena->rewind(m_mark);
+}
+
+Allocator
+ScopedArena::getAllocator()
+{
+  return Allocator(m_arena);
+}
+
+} // end of namespace umpire
@@ -0,0 +1,91 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_ScopedArena_HPP
+#define UMPIRE_ScopedArena_HPP
+
+#include "umpire/Allocator.hpp"
+#include "umpire/strategy/ArenaAllocator.hpp"
+
+#include <memory>
+
+namespace umpire {
+
+/*!
+ * \brief Allocate temporaries that are all freed together when the scope
+ * ends.
+ *
+ * Given an Allocator backed by a strategy::ArenaAllocator, the scope marks
+ * the arena's position and rewinds to it on destruction, so the arena's
+ * blocks are reused from one scope to the next. Given any other Allocator,
+ * the scope builds a private ArenaAllocator over it, which returns its
+ * blocks when the scope ends.
+ *
+ * Either way, allocating is a bump of a pointer plus, when allocations are
+ * tracked, one registration; nothing is freed one by one, and the
+ * registrations are dropped with one AllocationMap range removal per block.
+ * Pointers from the scope must not be used after it ends.
+ *
+ * \code
+ * for (int step = 0; step < num_steps; ++step) {
+ *   umpire::ScopedArena scope(rm.getAllocator("DEVICE_POOL"));
+ *   double* flux = static_cast<double*>(scope.allocate(n*sizeof(double)));
+ *   ...
+ * }
+ * \endcode
+ */
+class ScopedArena {
+  public:
+    /*!
+     * \param allocator Arena to rewind, or Allocator to build an arena on.
+     * \param block_size Minimum size of the blocks of a private arena.
+     * \param track_allocations Whether a private arena registers its
+     * allocations with the ResourceManager.
+     */
+    explicit ScopedArena(
+        Allocator allocator,
+        const std::size_t block_size = (1 * 1024 * 1024),
+        const bool track_allocations = true);
+
+    ~ScopedArena();
+
+    ScopedArena(const ScopedArena&) = delete;
+    ScopedArena& operator=(const ScopedArena&) = delete;
+
+    void* allocate(size_t bytes);
+
+    void* allocate(size_t bytes, size_t alignment);
+
+    /*!
+     * \brief Free everything allocated in the scope so far.
+     */
+    void reset();
+
+    /*!
+     * \brief Return an Allocator over the scope's arena, for code that
+     * takes an Allocator.
+     *
+     * Deallocating through it is allowed but frees nothing until the scope
+     * ends.
+     */
+    Allocator getAllocator();
+
+  private:
+    std::shared_ptr<strategy::ArenaAllocator> m_arena;
+    strategy::ArenaAllocator::Mark m_mark;
+};
+
+} // end of namespace umpire
+
+#endif // UMPIRE_ScopedArena_HPP
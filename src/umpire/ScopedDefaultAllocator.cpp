@@ -0,0 +1,32 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/ScopedDefaultAllocator.hpp"
+
+#include "umpire/ResourceManager.hpp"
+
+namespace umpire {
+
+ScopedDefaultAllocator::ScopedDefaultAllocator(Allocator allocator) :
+  m_previous(ResourceManager::getInstance().exchangeThreadDefaultAllocator(
+        allocator.getAllocationStrategy()))
+{
+}
+
+ScopedDefaultAllocator::~ScopedDefaultAllocator()
+{
+  ResourceManager::getInstance().exchangeThreadDefaultAllocator(m_previous);
+}
+
+} // end of namespace umpire
@@ -0,0 +1,57 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_ScopedDefaultAllocator_HPP
+#define UMPIRE_ScopedDefaultAllocator_HPP
+
+#include "umpire/Allocator.hpp"
+
+#include <memory>
+
+namespace umpire {
+
+/*!
+ * \brief Make an Allocator the calling thread's default for a scope.
+ *
+ * The thread's previous default, or its use of the global default, is
+ * restored when the scope ends, so scopes nest. Other threads are not
+ * affected.
+ *
+ * \code
+ * #pragma omp parallel
+ * {
+ *   umpire::ScopedDefaultAllocator scope(thread_pools[omp_get_thread_num()]);
+ *   void* work = rm.reallocate(nullptr, bytes);
+ *   ...
+ * }
+ * \endcode
+ *
+ * \see ResourceManager::setThreadDefaultAllocator
+ */
+class ScopedDefaultAllocator {
+  public:
+    explicit ScopedDefaultAllocator(Allocator allocator);
+
+    ~ScopedDefaultAllocator();
+
+    ScopedDefaultAllocator(const ScopedDefaultAllocator&) = delete;
+    ScopedDefaultAllocator& operator=(const ScopedDefaultAllocator&) = delete;
+
+  private:
+    std::shared_ptr<strategy::AllocationStrategy> m_previous;
+};
+
+} // end of namespace umpire
+
+#endif // UMPIRE_ScopedDefaultAllocator_HPP
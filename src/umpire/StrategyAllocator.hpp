@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_StrategyAllocator_HPP
+#define UMPIRE_StrategyAllocator_HPP
+
+#include "umpire/Allocator.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace umpire {
+
+/*!
+ * \brief Allocator handle that calls a strategy of a known type directly.
+ *
+ * Allocator is type-erased, so every allocate and deallocate is a virtual
+ * call, and copying it updates a shared reference count. A
+ * StrategyAllocator holds a plain pointer to the Strategy and makes
+ * non-virtual calls, so copying it is free and the compiler can inline the
+ * strategy's methods where their definitions are visible.
+ *
+ * The handle does not own the strategy. Strategies created through the
+ * ResourceManager live as long as it does, so this only matters for
+ * strategies made by hand, which must outlive every handle to them.
+ *
+ * \code
+ * auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+ *     "pool", rm.getAllocator("DEVICE"));
+ * umpire::StrategyAllocator<umpire::strategy::DynamicPool> fast_pool(pool);
+ *
+ * void* data = fast_pool.allocate(1024);
+ * fast_pool.deallocate(data);
+ *
+ * umpire::Allocator erased = fast_pool;
+ * \endcode
+ *
+ * In builds with ENABLE_STATISTICS or ENABLE_TRACE, calls go through
+ * Allocator so that they are still recorded.
+ */
+template<typename Strategy>
+class StrategyAllocator {
+  public:
+    /*!
+     * \brief Construct a handle to the strategy behind allocator.
+     *
+     * Throws an umpire::Exception unless the strategy is exactly a
+     * Strategy: calls are not virtual, so a subclass's overrides would be
+     * skipped.
+     */
+    StrategyAllocator(Allocator allocator);
+
+    void* allocate(size_t bytes);
+
+    void deallocate(void* ptr);
+
+    Strategy* getStrategy() const;
+
+    std::string getName() const;
+
+    int getId() const;
+
+    /*!
+     * \brief Return the type-erased Allocator for the same strategy.
+     */
+    operator Allocator() const;
+
+  private:
+    Strategy* m_strategy;
+};
+
+} // end of namespace umpire
+
+#include "umpire/StrategyAllocator.inl"
+
+#endif // UMPIRE_StrategyAllocator_HPP
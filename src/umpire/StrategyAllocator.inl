@@ -0,0 +1,113 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_StrategyAllocator_INL
+#define UMPIRE_StrategyAllocator_INL
+
+#include "umpire/StrategyAllocator.hpp"
+
+#include "umpire/config.hpp"
+
+#include "umpire/util/AllocatorStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+#include <typeinfo>
+
+namespace umpire {
+
+template<typename Strategy>
+StrategyAllocator<Strategy>::StrategyAllocator(Allocator allocator) :
+  m_strategy(nullptr)
+{
+  strategy::AllocationStrategy* base = allocator.getAllocationStrategy().get();
+
+  if (typeid(*base) != typeid(Strategy)) {
+    UMPIRE_ERROR("Allocator " << allocator.getName() << " is not a " << typeid(Strategy).name());
+  }
+
+  m_strategy = static_cast<Strategy*>(base);
+}
+
+template<typename Strategy>
+inline void*
+StrategyAllocator<Strategy>::allocate(size_t bytes)
+{
+#if defined(UMPIRE_ENABLE_STATISTICS) || defined(UMPIRE_ENABLE_TRACE)
+  return Allocator(*this).allocate(bytes);
+#else
+  util::AllocatorStatistics* statistics = m_strategy->getStatistics();
+  if (statistics) {
+    const uint64_t start = util::AllocatorStatistics::now();
+    void* ret = m_strategy->Strategy::allocate(bytes);
+    statistics->recordAllocate(util::AllocatorStatistics::now() - start, bytes);
+    return ret;
+  }
+
+  return m_strategy->Strategy::allocate(bytes);
+#endif
+}
+
+template<typename Strategy>
+inline void
+StrategyAllocator<Strategy>::deallocate(void* ptr)
+{
+#if defined(UMPIRE_ENABLE_STATISTICS) || defined(UMPIRE_ENABLE_TRACE)
+  Allocator(*this).deallocate(ptr);
+#else
+  if (!ptr) {
+    return;
+  }
+
+  util::AllocatorStatistics* statistics = m_strategy->getStatistics();
+  if (statistics) {
+    const uint64_t start = util::AllocatorStatistics::now();
+    m_strategy->Strategy::deallocate(ptr);
+    statistics->recordDeallocate(util::AllocatorStatistics::now() - start);
+    return;
+  }
+
+  m_strategy->Strategy::deallocate(ptr);
+#endif
+}
+
+template<typename Strategy>
+inline Strategy*
+StrategyAllocator<Strategy>::getStrategy() const
+{
+  return m_strategy;
+}
+
+template<typename Strategy>
+std::string
+StrategyAllocator<Strategy>::getName() const
+{
+  return m_strategy->getName();
+}
+
+template<typename Strategy>
+int
+StrategyAllocator<Strategy>::getId() const
+{
+  return m_strategy->getId();
+}
+
+template<typename Strategy>
+StrategyAllocator<Strategy>::operator Allocator() const
+{
+  return Allocator(m_strategy->shared_from_this());
+}
+
+} // end of namespace umpire
+
+#endif // UMPIRE_StrategyAllocator_INL
@@ -0,0 +1,179 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/TilePipeline.hpp"
+
+#include <algorithm>
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/Macros.hpp"
+
+#if defined(UMPIRE_ENABLE_CUDA)
+#include <cuda_runtime_api.h>
+#endif
+
+#if defined(UMPIRE_ENABLE_HIP)
+#include <hip/hip_runtime_api.h>
+#endif
+
+namespace umpire {
+
+TilePipeline::TilePipeline(
+    Allocator allocator,
+    std::size_t tile_size,
+    std::size_t depth) :
+  m_allocator(allocator),
+  m_tile_size(tile_size),
+  m_buffers(),
+  m_streams(depth, nullptr)
+{
+  UMPIRE_LOG(Debug, "(allocator=" << allocator.getName()
+      << ", tile_size=" << tile_size << ", depth=" << depth << ")");
+
+  if (tile_size == 0 || depth == 0) {
+    UMPIRE_ERROR("TilePipeline needs a tile size and depth above zero, got "
+        << tile_size << " and " << depth);
+  }
+
+  try {
+    for (std::size_t slot = 0; slot < depth; ++slot) {
+      m_buffers.push_back(m_allocator.allocate(m_tile_size));
+
+#if defined(UMPIRE_ENABLE_CUDA)
+      if (m_allocator.getPlatform() == Platform::cuda) {
+        cudaStream_t stream;
+        cudaError_t error = ::cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
+        if (error != cudaSuccess) {
+          UMPIRE_ERROR("cudaStreamCreateWithFlags failed with error: "
+              << cudaGetErrorString(error));
+        }
+        m_streams[slot] = stream;
+      }
+#elif defined(UMPIRE_ENABLE_HIP)
+      if (m_allocator.getPlatform() == Platform::hip) {
+        hipStream_t stream;
+        hipError_t error = ::hipStreamCreateWithFlags(&stream, hipStreamNonBlocking);
+        if (error != hipSuccess) {
+          UMPIRE_ERROR("hipStreamCreateWithFlags failed with error: "
+              << hipGetErrorString(error));
+        }
+        m_streams[slot] = stream;
+      }
+#endif
+    }
+  } catch (...) {
+    destroy();
+    throw;
+  }
+}
+
+TilePipeline::~TilePipeline()
+{
+  destroy();
+}
+
+void
+TilePipeline::run(const void* src, void* dst, std::size_t bytes, const Compute& compute)
+{
+  UMPIRE_LOG(Debug, "(src=" << src << ", dst=" << dst << ", bytes=" << bytes << ")");
+
+  auto& rm = ResourceManager::getInstance();
+
+  char* src_bytes = static_cast<char*>(const_cast<void*>(src));
+  char* dst_bytes = static_cast<char*>(dst);
+
+  std::size_t tile = 0;
+  for (std::size_t offset = 0; offset < bytes; offset += m_tile_size, ++tile) {
+    const std::size_t slot = tile % m_buffers.size();
+    const std::size_t length = std::min(m_tile_size, bytes - offset);
+
+    void* buffer = m_buffers[slot];
+    void* stream = m_streams[slot];
+
+    rm.copy(buffer, src_bytes + offset, length, stream);
+
+    compute(buffer, offset, length, stream);
+
+    if (dst_bytes) {
+      rm.copy(dst_bytes + offset, buffer, length, stream);
+    }
+  }
+
+  for (std::size_t slot = 0; slot < m_streams.size(); ++slot) {
+    synchronize(slot);
+  }
+}
+
+std::size_t
+TilePipeline::getTileSize() const noexcept
+{
+  return m_tile_size;
+}
+
+std::size_t
+TilePipeline::getDepth() const noexcept
+{
+  return m_buffers.size();
+}
+
+void
+TilePipeline::destroy() noexcept
+{
+  for (void*& stream : m_streams) {
+    if (stream) {
+      // Errors are ignored, the buffers are freed either way
+#if defined(UMPIRE_ENABLE_CUDA)
+      ::cudaStreamSynchronize(static_cast<cudaStream_t>(stream));
+      ::cudaStreamDestroy(static_cast<cudaStream_t>(stream));
+#elif defined(UMPIRE_ENABLE_HIP)
+      ::hipStreamSynchronize(static_cast<hipStream_t>(stream));
+      ::hipStreamDestroy(static_cast<hipStream_t>(stream));
+#endif
+      stream = nullptr;
+    }
+  }
+
+  for (void* buffer : m_buffers) {
+    try {
+      m_allocator.deallocate(buffer);
+    } catch (...) {
+      UMPIRE_LOG(Error, "Could not deallocate tile buffer " << buffer);
+    }
+  }
+  m_buffers.clear();
+}
+
+void
+TilePipeline::synchronize(std::size_t slot)
+{
+  if (!m_streams[slot]) {
+    return;
+  }
+
+#if defined(UMPIRE_ENABLE_CUDA)
+  cudaError_t error = ::cudaStreamSynchronize(static_cast<cudaStream_t>(m_streams[slot]));
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaStreamSynchronize failed with error: "
+        << cudaGetErrorString(error));
+  }
+#elif defined(UMPIRE_ENABLE_HIP)
+  hipError_t error = ::hipStreamSynchronize(static_cast<hipStream_t>(m_streams[slot]));
+  if (error != hipSuccess) {
+    UMPIRE_ERROR("hipStreamSynchronize failed with error: "
+        << hipGetErrorString(error));
+  }
+#endif
+}
+
+} // end of namespace umpire
@@ -0,0 +1,110 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_TilePipeline_HPP
+#define UMPIRE_TilePipeline_HPP
+
+#include "umpire/Allocator.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace umpire {
+
+/*!
+ * \brief Process a host range much larger than device memory one tile at a
+ * time, overlapping the copies of some tiles with the compute on others.
+ *
+ * The pipeline owns depth buffers of tile_size bytes, allocated once from
+ * the given Allocator, and on a GPU one stream per buffer. Tile i goes to
+ * buffer i % depth: its copy in, compute and copy out are all issued on
+ * that buffer's stream, so a buffer is only reused once the stream has
+ * finished with the previous tile, while the other streams keep the copy
+ * engines and the GPU busy. Nothing is allocated per tile.
+ *
+ * Copies go through ResourceManager::copy, so the host range must be known
+ * to Umpire, and only pinned host memory gives truly asynchronous copies.
+ * With an Allocator on the CPU the tiles are processed one after another
+ * with a null stream, which is handy for testing.
+ *
+ * \code
+ * umpire::TilePipeline pipeline(rm.getAllocator("DEVICE_POOL"), 64 << 20);
+ *
+ * pipeline.run(input, output, bytes,
+ *   [](void* tile, std::size_t offset, std::size_t length, void* stream) {
+ *     scale<<<blocks, threads, 0, static_cast<cudaStream_t>(stream)>>>(
+ *       static_cast<double*>(tile), length / sizeof(double));
+ *   });
+ * \endcode
+ */
+class TilePipeline {
+  public:
+    /*!
+     * \brief Called once per tile, after the tile is copied in.
+     *
+     * \param tile Device buffer holding the tile.
+     * \param offset Offset of the tile in the host range, in bytes.
+     * \param length Size of the tile, which is tile_size except for the
+     * last tile.
+     * \param stream Stream to launch work on, nullptr on the CPU.
+     */
+    using Compute = std::function<
+      void(void* tile, std::size_t offset, std::size_t length, void* stream)>;
+
+    /*!
+     * \param allocator Allocator for the tile buffers, usually a pool.
+     * \param tile_size Size of each tile in bytes.
+     * \param depth Number of buffers and streams, two for double buffering.
+     *
+     * \throws umpire::util::Exception if tile_size or depth is zero.
+     */
+    TilePipeline(
+        Allocator allocator,
+        std::size_t tile_size,
+        std::size_t depth = 2);
+
+    ~TilePipeline();
+
+    TilePipeline(const TilePipeline&) = delete;
+    TilePipeline& operator=(const TilePipeline&) = delete;
+
+    /*!
+     * \brief Copy [src, src + bytes) in, compute on each tile, and copy
+     * each tile out to the same offset of dst.
+     *
+     * dst may be src, to update the range in place, or nullptr if the
+     * tiles need not be copied back. Returns once all tiles are done.
+     */
+    void run(const void* src, void* dst, std::size_t bytes, const Compute& compute);
+
+    std::size_t getTileSize() const noexcept;
+
+    std::size_t getDepth() const noexcept;
+
+  private:
+    void synchronize(std::size_t slot);
+
+    void destroy() noexcept;
+
+    Allocator m_allocator;
+    std::size_t m_tile_size;
+
+    std::vector<void*> m_buffers;
+    std::vector<void*> m_streams;
+};
+
+} // end of namespace umpire
+
+#endif // UMPIRE_TilePipeline_HPP
@@ -17,23 +17,57 @@
 
 #include "umpire/Allocator.hpp"
 
+#include <type_traits>
+
 namespace umpire {
 
+/*!
+ * \brief C++11 allocator that gets its memory from an umpire::Allocator.
+ *
+ * Instances that share an Allocator compare equal, and the Allocator is
+ * propagated on container copy, move and swap, so any container can use
+ * it, including node containers and std::allocate_shared.
+ */
 template<typename T>
 class TypedAllocator {
+  template<typename U> friend class TypedAllocator;
+
   public:
   typedef T value_type;
 
+  typedef std::true_type propagate_on_container_copy_assignment;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  template<typename U>
+  struct rebind {
+    typedef TypedAllocator<U> other;
+  };
+
   TypedAllocator(Allocator allocator);
 
+  template<typename U>
+  TypedAllocator(const TypedAllocator<U>& other);
+
   T* allocate(size_t size);
 
   void deallocate(T* ptr, size_t size);
 
+  /*!
+   * \brief Return the Allocator this allocator gets its memory from.
+   */
+  Allocator getAllocator() const;
+
   private:
     umpire::Allocator m_allocator;
 };
 
+template<typename T, typename U>
+bool operator==(const TypedAllocator<T>& lhs, const TypedAllocator<U>& rhs);
+
+template<typename T, typename U>
+bool operator!=(const TypedAllocator<T>& lhs, const TypedAllocator<U>& rhs);
+
 } // end of namespace umpire
 
 #include "umpire/TypedAllocator.inl"
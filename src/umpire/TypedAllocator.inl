@@ -25,6 +25,13 @@ TypedAllocator<T>::TypedAllocator(Allocator allocator) :
 {
 }
 
+template<typename T>
+template<typename U>
+TypedAllocator<T>::TypedAllocator(const TypedAllocator<U>& other) :
+  m_allocator(other.m_allocator)
+{
+}
+
 template<typename T>
 T* 
 TypedAllocator<T>::allocate(size_t size)
@@ -39,6 +46,27 @@ TypedAllocator<T>::deallocate(T* ptr, size_t UMPIRE_UNUSED_ARG(size))
   m_allocator.deallocate(ptr);
 }
 
+template<typename T>
+Allocator
+TypedAllocator<T>::getAllocator() const
+{
+  return m_allocator;
+}
+
+template<typename T, typename U>
+bool
+operator==(const TypedAllocator<T>& lhs, const TypedAllocator<U>& rhs)
+{
+  return lhs.getAllocator().getAllocationStrategy() == rhs.getAllocator().getAllocationStrategy();
+}
+
+template<typename T, typename U>
+bool
+operator!=(const TypedAllocator<T>& lhs, const TypedAllocator<U>& rhs)
+{
+  return !(lhs == rhs);
+}
+
 
 } // end of namespace umpire
 
@@ -0,0 +1,130 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/UsageSampler.hpp"
+
+#include "umpire/ResourceManager.hpp"
+
+#include "umpire/util/Macros.hpp"
+
+#if defined(UMPIRE_ENABLE_CUDA)
+#include <cuda_runtime_api.h>
+#endif
+
+namespace umpire {
+
+UsageSampler::UsageSampler(
+    ResourceManager& resource_manager,
+    const std::string& filename,
+    std::chrono::milliseconds interval) :
+  m_resource_manager(resource_manager),
+  m_interval(interval),
+  m_mutex(),
+  m_wake(),
+  m_file(nullptr),
+  m_stop(false),
+  m_thread()
+{
+  if (interval.count() <= 0) {
+    UMPIRE_ERROR("Usage sampling interval must be positive, not " << interval.count() << "ms");
+  }
+
+  m_file = std::fopen(filename.c_str(), "w");
+
+  if (!m_file) {
+    UMPIRE_ERROR("Cannot open usage sample file " << filename);
+  }
+
+  std::fputs("timestamp,name,current_size,actual_size,high_watermark\n", m_file);
+
+  m_thread = std::thread(&UsageSampler::run, this);
+}
+
+UsageSampler::~UsageSampler()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_one();
+  m_thread.join();
+
+  sample();
+  std::fclose(m_file);
+}
+
+void
+UsageSampler::sample()
+{
+  const auto time = std::chrono::time_point_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now()).time_since_epoch();
+  const long long timestamp = static_cast<long long>(time.count());
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_resource_manager.m_allocators_by_name.load(std::memory_order_acquire)->forEach(
+      [&] (const ResourceManager::AllocatorNameNode& named) {
+    auto& strategy = named.strategy;
+
+    const long high_watermark = strategy->getHighWatermark();
+
+    if (high_watermark == 0 && strategy->getActualSize() == 0) {
+      return;
+    }
+
+    std::fprintf(m_file, "%lld,%s,%ld,%ld,%ld\n",
+        timestamp,
+        named.name.c_str(),
+        strategy->getCurrentSize(),
+        strategy->getActualSize(),
+        high_watermark);
+  });
+
+#if defined(UMPIRE_ENABLE_CUDA)
+  int devices = 0;
+  if (cudaGetDeviceCount(&devices) == cudaSuccess) {
+    int current = 0;
+    cudaGetDevice(&current);
+
+    for (int device = 0; device < devices; ++device) {
+      size_t free = 0;
+      size_t total = 0;
+
+      cudaSetDevice(device);
+      if (cudaMemGetInfo(&free, &total) == cudaSuccess) {
+        std::fprintf(m_file, "%lld,cuda::%d,%zu,%zu,\n",
+            timestamp, device, total - free, total);
+      }
+    }
+
+    cudaSetDevice(current);
+  }
+#endif
+
+  std::fflush(m_file);
+}
+
+void
+UsageSampler::run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  while (!m_wake.wait_for(lock, m_interval, [this] () { return m_stop; })) {
+    lock.unlock();
+    sample();
+    lock.lock();
+  }
+}
+
+} // end of namespace umpire
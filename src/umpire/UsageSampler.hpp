@@ -0,0 +1,94 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_UsageSampler_HPP
+#define UMPIRE_UsageSampler_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace umpire {
+
+class ResourceManager;
+
+/*!
+ * \brief Write the memory usage of every Allocator to a CSV file at a fixed
+ * interval, from a background thread.
+ *
+ * Each sample adds one row per Allocator that has been used:
+ *
+ * \code
+ * timestamp,name,current_size,actual_size,high_watermark
+ * 1546300800000000000,DEVICE_POOL,805306368,1073741824,805306368
+ * \endcode
+ *
+ * timestamp is in nanoseconds since the epoch. In CUDA builds each sample
+ * also adds a cuda::<device> row per device from cudaMemGetInfo, with the
+ * bytes in use as current_size and the device's total as actual_size.
+ *
+ * The sizes are the counters each Allocator keeps anyway, so allocations
+ * do no extra work while sampling. Counters are atomic and read without a
+ * lock, except in strategies that already update them under their own
+ * mutex, where the read takes it briefly.
+ *
+ * \see ResourceManager::startUsageSampler
+ */
+class UsageSampler {
+  public:
+    /*!
+     * \brief Start sampling the Allocators of resource_manager into
+     * filename, replacing it, every interval.
+     *
+     * \throws util::Exception if filename cannot be opened.
+     */
+    UsageSampler(
+        ResourceManager& resource_manager,
+        const std::string& filename,
+        std::chrono::milliseconds interval);
+
+    /*!
+     * \brief Take a last sample, stop the thread and close the file.
+     */
+    ~UsageSampler();
+
+    /*!
+     * \brief Write a sample now, in addition to the periodic ones.
+     */
+    void sample();
+
+    UsageSampler(const UsageSampler&) = delete;
+    UsageSampler& operator=(const UsageSampler&) = delete;
+
+  private:
+    void run();
+
+    ResourceManager& m_resource_manager;
+    std::chrono::milliseconds m_interval;
+
+    // Guards m_file and m_stop.
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::FILE* m_file;
+    bool m_stop;
+
+    std::thread m_thread;
+};
+
+} // end of namespace umpire
+
+#endif // UMPIRE_UsageSampler_HPP
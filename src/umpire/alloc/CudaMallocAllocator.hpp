@@ -17,14 +17,28 @@
 
 #include <cuda_runtime_api.h>
 
+#include "umpire/util/Macros.hpp"
+
 namespace umpire {
 namespace alloc {
 
 /*!
  * \brief Uses cudaMalloc and cudaFree to allocate and deallocate memory on
  *        NVIDIA GPUs.
+ *
+ * An allocator constructed with a device id makes that device current for
+ * each cudaMalloc and cudaFree, restoring the previous device afterwards.
+ * The device is only switched when it differs from the current one. The
+ * default allocator uses whichever device is current.
  */
 struct CudaMallocAllocator {
+  static const int current_device = -1;
+
+  CudaMallocAllocator(int device = current_device) :
+    m_device(device)
+  {
+  }
+
   /*!
    * \brief Allocate bytes of memory using cudaMalloc
    *
@@ -36,6 +50,7 @@ struct CudaMallocAllocator {
   void* allocate(size_t size)
   {
     void* ptr = nullptr;
+    DeviceGuard guard(m_device);
     cudaError_t error = ::cudaMalloc(&ptr, size);
     UMPIRE_LOG(Debug, "(bytes=" << size << ") returning " << ptr);
     if (error != cudaSuccess) {
@@ -45,6 +60,59 @@ struct CudaMallocAllocator {
     }
   }
 
+  /*!
+   * \brief Allocate bytes of memory using cudaMalloc, returning nullptr if it
+   * cannot be allocated.
+   */
+  void* tryAllocate(size_t bytes)
+  {
+    void* ptr = nullptr;
+    DeviceGuard guard(m_device);
+    cudaError_t error = ::cudaMalloc(&ptr, bytes);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ptr);
+    if (error != cudaSuccess) {
+      // Clear the error so later calls do not report it
+      ::cudaGetLastError();
+      return nullptr;
+    }
+
+    return ptr;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory aligned to alignment bytes.
+   *
+   * cudaMalloc returns memory aligned to at least 256 bytes.
+   *
+   * \throws umpire::util::Exception if alignment is larger than 256.
+   */
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    if (alignment > 256) {
+      UMPIRE_ERROR("cudaMalloc cannot align to " << alignment << " bytes");
+    }
+
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Allocate bytes of memory using cudaMalloc, zeroed with
+   * cudaMemsetAsync on the default stream.
+   *
+   * \throws umpire::util::Exception if memory cannot be allocated.
+   */
+  void* allocateZeroed(size_t bytes)
+  {
+    void* ptr = allocate(bytes);
+    DeviceGuard guard(m_device);
+    cudaError_t error = ::cudaMemsetAsync(ptr, 0, bytes, 0);
+    if (error != cudaSuccess) {
+      ::cudaFree(ptr);
+      UMPIRE_ERROR("cudaMemsetAsync( bytes = " << bytes << " ) failed with error: " << cudaGetErrorString(error));
+    }
+    return ptr;
+  }
+
   /*!
    * \brief Deallocate memory using cudaFree.
    *
@@ -55,11 +123,41 @@ struct CudaMallocAllocator {
   void deallocate(void* ptr)
   {
     UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+    DeviceGuard guard(m_device);
     cudaError_t error = ::cudaFree(ptr);
     if (error != cudaSuccess) {
       UMPIRE_ERROR("cudaFree( ptr = " << ptr << " ) failed with error: " << cudaGetErrorString(error));
     }
   }
+
+  /*!
+   * \brief Makes a device current for the lifetime of the guard.
+   */
+  struct DeviceGuard {
+    DeviceGuard(int device) :
+      m_previous(current_device)
+    {
+      if (device != current_device) {
+        int previous;
+        ::cudaGetDevice(&previous);
+        if (previous != device) {
+          ::cudaSetDevice(device);
+          m_previous = previous;
+        }
+      }
+    }
+
+    ~DeviceGuard()
+    {
+      if (m_previous != current_device) {
+        ::cudaSetDevice(m_previous);
+      }
+    }
+
+    int m_previous;
+  };
+
+  int m_device;
 };
 
 } // end of namespace alloc
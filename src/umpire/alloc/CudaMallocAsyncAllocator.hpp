@@ -0,0 +1,177 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CudaMallocAsyncAllocator_HPP
+#define UMPIRE_CudaMallocAsyncAllocator_HPP
+
+#include <cuda_runtime_api.h>
+
+#include <cstdint>
+
+#include "umpire/alloc/CudaMallocAllocator.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace alloc {
+
+/*!
+ * \brief Uses cudaMallocAsync and cudaFreeAsync to allocate and deallocate
+ *        memory from the driver's memory pool of a device.
+ *
+ * Allocations and frees are ordered on the default stream, and the driver
+ * reuses freed memory for later allocations on that stream without
+ * synchronizing. Memory above the pool's release threshold is returned to
+ * the system at the next synchronization; the threshold is set on the
+ * device's default pool, so it applies to every user of that pool in the
+ * process.
+ *
+ * Requires CUDA 11.2 or newer.
+ */
+struct CudaMallocAsyncAllocator {
+  /*!
+   * \brief Keep all freed memory in the pool.
+   */
+  static const uint64_t keep_all = UINT64_MAX;
+
+  /*!
+   * \brief Use the device that is current when the allocator is made, with
+   * release_threshold bytes kept in its pool.
+   */
+  CudaMallocAsyncAllocator(int device = CudaMallocAllocator::current_device,
+      uint64_t release_threshold = keep_all) :
+    m_device(device),
+    m_pool(nullptr)
+  {
+    if (m_device == CudaMallocAllocator::current_device) {
+      ::cudaGetDevice(&m_device);
+    }
+
+    cudaError_t error = ::cudaDeviceGetDefaultMemPool(&m_pool, m_device);
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaDeviceGetDefaultMemPool( device = " << m_device << " ) failed with error: " << cudaGetErrorString(error));
+    }
+
+    setReleaseThreshold(release_threshold);
+  }
+
+  /*!
+   * \brief Allocate bytes of memory using cudaMallocAsync
+   *
+   * \param bytes Number of bytes to allocate.
+   * \return Pointer to start of the allocation.
+   *
+   * \throws umpire::util::Exception if memory cannot be allocated.
+   */
+  void* allocate(size_t size)
+  {
+    void* ptr = nullptr;
+    CudaMallocAllocator::DeviceGuard guard(m_device);
+    cudaError_t error = ::cudaMallocAsync(&ptr, size, 0);
+    UMPIRE_LOG(Debug, "(bytes=" << size << ") returning " << ptr);
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaMallocAsync( bytes = " << size << " ) failed with error: " << cudaGetErrorString(error));
+    } else {
+      return ptr;
+    }
+  }
+
+  /*!
+   * \brief Allocate bytes of memory using cudaMallocAsync, returning nullptr if it
+   * cannot be allocated.
+   */
+  void* tryAllocate(size_t bytes)
+  {
+    void* ptr = nullptr;
+    CudaMallocAllocator::DeviceGuard guard(m_device);
+    cudaError_t error = ::cudaMallocAsync(&ptr, bytes, 0);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ptr);
+    if (error != cudaSuccess) {
+      ::cudaGetLastError();
+      return nullptr;
+    }
+
+    return ptr;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory aligned to alignment bytes.
+   *
+   * Pool allocations are aligned to at least 256 bytes.
+   *
+   * \throws umpire::util::Exception if alignment is larger than 256.
+   */
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    if (alignment > 256) {
+      UMPIRE_ERROR("cudaMallocAsync cannot align to " << alignment << " bytes");
+    }
+
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Allocate bytes of memory using cudaMallocAsync, zeroed with
+   * cudaMemsetAsync on the same stream.
+   *
+   * \throws umpire::util::Exception if memory cannot be allocated.
+   */
+  void* allocateZeroed(size_t bytes)
+  {
+    void* ptr = allocate(bytes);
+    CudaMallocAllocator::DeviceGuard guard(m_device);
+    cudaError_t error = ::cudaMemsetAsync(ptr, 0, bytes, 0);
+    if (error != cudaSuccess) {
+      ::cudaFreeAsync(ptr, 0);
+      UMPIRE_ERROR("cudaMemsetAsync( bytes = " << bytes << " ) failed with error: " << cudaGetErrorString(error));
+    }
+    return ptr;
+  }
+
+  /*!
+   * \brief Deallocate memory using cudaFreeAsync.
+   *
+   * \param ptr Address to deallocate.
+   *
+   * \throws umpire::util::Exception if memory cannot be free'd.
+   */
+  void deallocate(void* ptr)
+  {
+    UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+    CudaMallocAllocator::DeviceGuard guard(m_device);
+    cudaError_t error = ::cudaFreeAsync(ptr, 0);
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaFreeAsync( ptr = " << ptr << " ) failed with error: " << cudaGetErrorString(error));
+    }
+  }
+
+  /*!
+   * \brief Set how many bytes of freed memory the pool keeps across
+   * synchronizations, using cudaMemPoolSetAttribute.
+   */
+  void setReleaseThreshold(uint64_t bytes)
+  {
+    cudaError_t error = ::cudaMemPoolSetAttribute(m_pool, cudaMemPoolAttrReleaseThreshold, &bytes);
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaMemPoolSetAttribute( threshold = " << bytes << " ) failed with error: " << cudaGetErrorString(error));
+    }
+  }
+
+  int m_device;
+  cudaMemPool_t m_pool;
+};
+
+} // end of namespace alloc
+} // end of namespace umpire
+
+#endif // UMPIRE_CudaMallocAsyncAllocator_HPP
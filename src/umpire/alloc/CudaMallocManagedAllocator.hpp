@@ -47,6 +47,56 @@ struct CudaMallocManagedAllocator
     }
   }
 
+  /*!
+   * \brief Allocate bytes of memory using cudaMallocManaged, returning nullptr if it
+   * cannot be allocated.
+   */
+  void* tryAllocate(size_t bytes)
+  {
+    void* ptr = nullptr;
+    cudaError_t error = ::cudaMallocManaged(&ptr, bytes);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ptr);
+    if (error != cudaSuccess) {
+      ::cudaGetLastError();
+      return nullptr;
+    }
+
+    return ptr;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory aligned to alignment bytes.
+   *
+   * cudaMallocManaged returns memory aligned to at least 256 bytes.
+   *
+   * \throws umpire::util::Exception if alignment is larger than 256.
+   */
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    if (alignment > 256) {
+      UMPIRE_ERROR("cudaMallocManaged cannot align to " << alignment << " bytes");
+    }
+
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Allocate bytes of memory using cudaMallocManaged, zeroed with
+   * cudaMemsetAsync on the default stream.
+   *
+   * \throws umpire::util::Exception if memory cannot be allocated.
+   */
+  void* allocateZeroed(size_t bytes)
+  {
+    void* ptr = allocate(bytes);
+    cudaError_t error = ::cudaMemsetAsync(ptr, 0, bytes, 0);
+    if (error != cudaSuccess) {
+      ::cudaFree(ptr);
+      UMPIRE_ERROR("cudaMemsetAsync( bytes = " << bytes << " ) failed with error: " << cudaGetErrorString(error));
+    }
+    return ptr;
+  }
+
   /*!
    * \brief Deallocate memory using cudaFree.
    *
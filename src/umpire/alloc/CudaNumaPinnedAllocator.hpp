@@ -0,0 +1,126 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CudaNumaPinnedAllocator_HPP
+#define UMPIRE_CudaNumaPinnedAllocator_HPP
+
+#include <cuda_runtime_api.h>
+
+#include "umpire/alloc/NumaAllocator.hpp"
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace alloc {
+
+/*!
+ * \brief Allocates page-locked host memory on a chosen NUMA node.
+ *
+ * cudaHostAlloc places pages wherever the calling thread runs, which may be
+ * the socket far from the GPU the memory is staged for. This allocator
+ * takes the pages from a NumaAllocator bound to the node, then page-locks
+ * them with cudaHostRegister, so transfers to a device can use the memory
+ * on its own socket.
+ */
+struct CudaNumaPinnedAllocator
+{
+  /*!
+   * \brief Construct an allocator for the given node, or for memory
+   * interleaved across all nodes when node is NumaAllocator::interleaved.
+   */
+  CudaNumaPinnedAllocator(int node = NumaAllocator::interleaved) :
+    m_numa(node)
+  {
+  }
+
+  void* allocate(size_t bytes)
+  {
+    void* ptr = m_numa.allocate(bytes);
+    cudaError_t error = pin(ptr, bytes);
+
+    if (error != cudaSuccess) {
+      m_numa.deallocate(ptr);
+      UMPIRE_ERROR("cudaHostRegister( bytes = " << bytes << ", node = " << m_numa.m_node
+          << " ) failed with error: " << cudaGetErrorString(error));
+    }
+
+    return ptr;
+  }
+
+  /*!
+   * \brief Allocate bytes of page-locked memory on the node, returning
+   * nullptr if it cannot be allocated or locked.
+   */
+  void* tryAllocate(size_t bytes)
+  {
+    void* ptr = m_numa.tryAllocate(bytes);
+
+    if (ptr && pin(ptr, bytes) != cudaSuccess) {
+      ::cudaGetLastError();
+      m_numa.deallocate(ptr);
+      return nullptr;
+    }
+
+    return ptr;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory aligned to alignment bytes, which may be
+   * up to the page size.
+   */
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    if (alignment > static_cast<size_t>(::numa_pagesize())) {
+      UMPIRE_ERROR("numa_alloc cannot align to " << alignment << " bytes");
+    }
+
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Allocate bytes of zeroed memory; the pages are freshly mapped.
+   */
+  void* allocateZeroed(size_t bytes)
+  {
+    return allocate(bytes);
+  }
+
+  void deallocate(void* ptr)
+  {
+    UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+    cudaError_t error = ::cudaHostUnregister(ptr);
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaHostUnregister( ptr = " << ptr << " ) failed with error: " << cudaGetErrorString(error));
+    }
+
+    m_numa.deallocate(ptr);
+  }
+
+  /*!
+   * \brief Page-lock the bytes at ptr; at least one byte, so empty
+   * allocations can be unregistered like any other.
+   */
+  static cudaError_t pin(void* ptr, size_t bytes)
+  {
+    return ::cudaHostRegister(ptr, bytes ? bytes : 1, cudaHostRegisterPortable);
+  }
+
+  NumaAllocator m_numa;
+};
+
+} // end of namespace alloc
+} // end of namespace umpire
+
+#endif // UMPIRE_CudaNumaPinnedAllocator_HPP
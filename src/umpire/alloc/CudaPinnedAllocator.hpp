@@ -17,23 +17,81 @@
 
 #include <cuda_runtime_api.h>
 
+#include <cstring>
+
 namespace umpire {
 namespace alloc {
 
+/*!
+ * \brief Uses cudaHostAlloc and cudaFreeHost to allocate and deallocate
+ *        page-locked host memory.
+ *
+ * An allocator constructed with cudaHostAllocMapped also maps the memory
+ * into the device address space, so kernels can access it directly; see
+ * ResourceManager::getDevicePointer.
+ */
 struct CudaPinnedAllocator
 {
+  CudaPinnedAllocator(unsigned int flags = cudaHostAllocDefault) :
+    m_flags(flags)
+  {
+  }
+
   void* allocate(size_t bytes)
   {
     void* ptr = nullptr;
-    cudaError_t error = ::cudaMallocHost(&ptr, bytes);
+    cudaError_t error = ::cudaHostAlloc(&ptr, bytes, m_flags);
     UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ptr);
     if (error != cudaSuccess) {
-      UMPIRE_ERROR("cudaMallocHost( bytes = " << bytes << " ) failed with error: " << cudaGetErrorString(error));
+      UMPIRE_ERROR("cudaHostAlloc( bytes = " << bytes << ", flags = " << m_flags << " ) failed with error: " << cudaGetErrorString(error));
     } else {
       return ptr;
     }
   }
 
+  /*!
+   * \brief Allocate bytes of memory using cudaHostAlloc, returning nullptr if it
+   * cannot be allocated.
+   */
+  void* tryAllocate(size_t bytes)
+  {
+    void* ptr = nullptr;
+    cudaError_t error = ::cudaHostAlloc(&ptr, bytes, m_flags);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ptr);
+    if (error != cudaSuccess) {
+      ::cudaGetLastError();
+      return nullptr;
+    }
+
+    return ptr;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory aligned to alignment bytes.
+   *
+   * cudaHostAlloc returns memory aligned to at least 256 bytes.
+   *
+   * \throws umpire::util::Exception if alignment is larger than 256.
+   */
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    if (alignment > 256) {
+      UMPIRE_ERROR("cudaHostAlloc cannot align to " << alignment << " bytes");
+    }
+
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Allocate bytes of page-locked memory, cleared on the host.
+   */
+  void* allocateZeroed(size_t bytes)
+  {
+    void* ptr = allocate(bytes);
+    std::memset(ptr, 0, bytes);
+    return ptr;
+  }
+
   void deallocate(void* ptr)
   {
     UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
@@ -42,6 +100,8 @@ struct CudaPinnedAllocator
       UMPIRE_ERROR("cudaFreeHost( ptr = " << ptr << " ) failed with error: " << cudaGetErrorString(error));
     }
   }
+
+  unsigned int m_flags;
 };
 
 } // end of namespace alloc
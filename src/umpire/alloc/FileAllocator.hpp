@@ -0,0 +1,274 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_FileAllocator_HPP
+#define UMPIRE_FileAllocator_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace alloc {
+
+/*!
+ * \brief Uses mmap of a file to allocate memory that is backed by storage
+ * rather than swap.
+ *
+ * Each allocation creates an unlinked temporary file in the directory, sizes
+ * it and maps it MAP_SHARED, so the kernel pages data in and out of the file
+ * as it is touched. This allows datasets larger than DRAM, and on a
+ * filesystem mounted with DAX (e.g. persistent memory) loads and stores go
+ * straight to the device without the page cache.
+ *
+ * Storage is reserved with posix_fallocate where the filesystem supports
+ * it, so running out of space fails the allocation instead of raising
+ * SIGBUS on first touch.
+ *
+ * With GPUDirect Storage each allocation also keeps an O_DIRECT descriptor
+ * for its file, which findFile returns so copies to and from the GPU can
+ * bypass the mapping.
+ */
+struct FileAllocator
+{
+  FileAllocator(const std::string& directory) :
+    m_directory(directory),
+    m_mappings(getMappings())
+  {
+  }
+
+  /*!
+   * \brief Allocate bytes of memory backed by a new file.
+   *
+   * \param bytes Number of bytes to allocate.
+   * \return Pointer to start of the allocation.
+   *
+   * \throws umpire::util::Exception if the file cannot be created or mapped.
+   */
+  void* allocate(size_t bytes)
+  {
+    const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+    // Zero-byte requests still get a page, so every mapping has a unique address
+    const size_t length = (bytes == 0) ?
+      page_size : ((bytes + page_size - 1) / page_size) * page_size;
+
+    std::string path_template = m_directory + "/umpire.XXXXXX";
+    std::vector<char> path(path_template.begin(), path_template.end());
+    path.push_back('\0');
+
+    int fd = ::mkstemp(path.data());
+    if (fd < 0) {
+      UMPIRE_ERROR("mkstemp( " << path_template << " ) failed: " << std::strerror(errno));
+    }
+
+#if defined(UMPIRE_ENABLE_GDS)
+    // cuFile needs O_DIRECT, which is only available on some filesystems
+    int direct_fd = ::open(path.data(), O_RDWR | O_DIRECT);
+#endif
+
+    // The mapping keeps the file alive, and nothing is left behind on exit
+    ::unlink(path.data());
+
+    int error = ::posix_fallocate(fd, 0, static_cast<off_t>(length));
+    if (error == EOPNOTSUPP || error == EINVAL) {
+      error = (::ftruncate(fd, static_cast<off_t>(length)) == 0) ? 0 : errno;
+    }
+
+    if (error != 0) {
+      ::close(fd);
+#if defined(UMPIRE_ENABLE_GDS)
+      if (direct_fd >= 0) {
+        ::close(direct_fd);
+      }
+#endif
+      UMPIRE_ERROR("Reserving " << length << " bytes in " << m_directory
+          << " failed: " << std::strerror(error));
+    }
+
+    void* ret = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+#if defined(UMPIRE_ENABLE_GDS)
+    if (direct_fd >= 0) {
+      ::close(fd);
+      fd = direct_fd;
+    }
+#else
+    ::close(fd);
+    fd = -1;
+#endif
+
+    if (ret == MAP_FAILED) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+      UMPIRE_ERROR("mmap( bytes = " << bytes << " ) of a file in " << m_directory << " failed");
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mappings->mutex);
+      Mapping& mapping = m_mappings->files[ret];
+      mapping.length = length;
+      mapping.fd = fd;
+    }
+
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ret);
+
+    return ret;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory, returning nullptr if it cannot be
+   * allocated.
+   */
+  void* tryAllocate(size_t bytes)
+  {
+    try {
+      return allocate(bytes);
+    } catch (util::Exception&) {
+      return nullptr;
+    }
+  }
+
+  /*!
+   * \brief Allocate bytes of memory aligned to alignment bytes.
+   *
+   * Mappings start on a page boundary, so any alignment up to the page size
+   * is met without extra work.
+   *
+   * \throws umpire::util::Exception if alignment is larger than a page.
+   */
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+    if (alignment > page_size) {
+      UMPIRE_ERROR("mmap cannot align to " << alignment << " bytes, pages are " << page_size);
+    }
+
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Allocate bytes of zeroed memory.
+   *
+   * A new file reads as zeros, so this is allocate.
+   */
+  void* allocateZeroed(size_t bytes)
+  {
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Deallocate memory using munmap, which releases the file.
+   *
+   * \param ptr Address to deallocate.
+   *
+   * \throws umpire::util::Exception if ptr was not allocated by this
+   * allocator.
+   */
+  void deallocate(void* ptr)
+  {
+    UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+    Mapping removed;
+    {
+      std::lock_guard<std::mutex> lock(m_mappings->mutex);
+      auto mapping = m_mappings->files.find(ptr);
+      if (mapping == m_mappings->files.end()) {
+        UMPIRE_ERROR("Unknown mapping " << ptr);
+      }
+      removed = mapping->second;
+      m_mappings->files.erase(mapping);
+    }
+
+    ::munmap(ptr, removed.length);
+
+    if (removed.fd >= 0) {
+      ::close(removed.fd);
+    }
+  }
+
+  /*!
+   * \brief Find the file behind an address returned by any FileAllocator.
+   *
+   * \param ptr Address inside a FILE allocation.
+   * \param fd Set to a descriptor for the file, which stays open until the
+   *        allocation is deallocated.
+   * \param offset Set to the offset of ptr in the file.
+   *
+   * \return false if ptr is not in a FILE allocation or its descriptor was
+   * not kept, which is the case unless GPUDirect Storage is enabled.
+   */
+  static bool findFile(const void* ptr, int& fd, size_t& offset)
+  {
+    std::shared_ptr<Mappings> mappings = getMappings();
+    std::lock_guard<std::mutex> lock(mappings->mutex);
+
+    auto mapping = mappings->files.upper_bound(const_cast<void*>(ptr));
+    if (mapping == mappings->files.begin()) {
+      return false;
+    }
+    --mapping;
+
+    const char* base = static_cast<const char*>(mapping->first);
+    const char* address = static_cast<const char*>(ptr);
+    if (address >= base + mapping->second.length || mapping->second.fd < 0) {
+      return false;
+    }
+
+    fd = mapping->second.fd;
+    offset = static_cast<size_t>(address - base);
+    return true;
+  }
+
+  struct Mapping {
+    size_t length;
+    int fd;
+  };
+
+  struct Mappings {
+    std::mutex mutex;
+    std::map<void*, Mapping> files;
+  };
+
+  /*
+   * Shared by every FileAllocator so findFile can search them all. Each
+   * allocator holds a reference, so the table outlives static destruction
+   * for as long as any allocator does.
+   */
+  static std::shared_ptr<Mappings> getMappings()
+  {
+    static std::shared_ptr<Mappings> mappings = std::make_shared<Mappings>();
+    return mappings;
+  }
+
+  std::string m_directory;
+  std::shared_ptr<Mappings> m_mappings;
+};
+
+} // end of namespace alloc
+} // end of namespace umpire
+
+#endif // UMPIRE_FileAllocator_HPP
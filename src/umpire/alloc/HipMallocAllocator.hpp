@@ -0,0 +1,165 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_HipMallocAllocator_HPP
+#define UMPIRE_HipMallocAllocator_HPP
+
+#include <hip/hip_runtime_api.h>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace alloc {
+
+/*!
+ * \brief Uses hipMalloc and hipFree to allocate and deallocate memory on
+ *        AMD GPUs.
+ *
+ * An allocator constructed with a device id makes that device current for
+ * each hipMalloc and hipFree, restoring the previous device afterwards.
+ * The default allocator uses whichever device is current.
+ */
+struct HipMallocAllocator {
+  static const int current_device = -1;
+
+  HipMallocAllocator(int device = current_device) :
+    m_device(device)
+  {
+  }
+
+  /*!
+   * \brief Allocate bytes of memory using hipMalloc
+   *
+   * \param bytes Number of bytes to allocate.
+   * \return Pointer to start of the allocation.
+   *
+   * \throws umpire::util::Exception if memory cannot be allocated.
+   */
+  void* allocate(size_t size)
+  {
+    void* ptr = nullptr;
+    DeviceGuard guard(m_device);
+    hipError_t error = ::hipMalloc(&ptr, size);
+    UMPIRE_LOG(Debug, "(bytes=" << size << ") returning " << ptr);
+    if (error != hipSuccess) {
+      UMPIRE_ERROR("hipMalloc( bytes = " << size << " ) failed with error: " << hipGetErrorString(error));
+    } else {
+      return ptr;
+    }
+  }
+
+  /*!
+   * \brief Allocate bytes of memory using hipMalloc, returning nullptr if it
+   * cannot be allocated.
+   */
+  void* tryAllocate(size_t bytes)
+  {
+    void* ptr = nullptr;
+    DeviceGuard guard(m_device);
+    hipError_t error = ::hipMalloc(&ptr, bytes);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ptr);
+    if (error != hipSuccess) {
+      // Clear the error so later calls do not report it
+      ::hipGetLastError();
+      return nullptr;
+    }
+
+    return ptr;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory aligned to alignment bytes.
+   *
+   * hipMalloc returns memory aligned to at least 256 bytes.
+   *
+   * \throws umpire::util::Exception if alignment is larger than 256.
+   */
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    if (alignment > 256) {
+      UMPIRE_ERROR("hipMalloc cannot align to " << alignment << " bytes");
+    }
+
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Allocate bytes of memory using hipMalloc, zeroed with
+   * hipMemsetAsync on the default stream.
+   *
+   * \throws umpire::util::Exception if memory cannot be allocated.
+   */
+  void* allocateZeroed(size_t bytes)
+  {
+    void* ptr = allocate(bytes);
+    DeviceGuard guard(m_device);
+    hipError_t error = ::hipMemsetAsync(ptr, 0, bytes, 0);
+    if (error != hipSuccess) {
+      ::hipFree(ptr);
+      UMPIRE_ERROR("hipMemsetAsync( bytes = " << bytes << " ) failed with error: " << hipGetErrorString(error));
+    }
+    return ptr;
+  }
+
+  /*!
+   * \brief Deallocate memory using hipFree.
+   *
+   * \param ptr Address to deallocate.
+   *
+   * \throws umpire::util::Exception if memory cannot be free'd.
+   */
+  void deallocate(void* ptr)
+  {
+    UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+    DeviceGuard guard(m_device);
+    hipError_t error = ::hipFree(ptr);
+    if (error != hipSuccess) {
+      UMPIRE_ERROR("hipFree( ptr = " << ptr << " ) failed with error: " << hipGetErrorString(error));
+    }
+  }
+
+  /*!
+   * \brief Makes a device current for the lifetime of the guard.
+   */
+  struct DeviceGuard {
+    DeviceGuard(int device) :
+      m_previous(current_device)
+    {
+      if (device != current_device) {
+        int previous;
+        ::hipGetDevice(&previous);
+        if (previous != device) {
+          ::hipSetDevice(device);
+          m_previous = previous;
+        }
+      }
+    }
+
+    ~DeviceGuard()
+    {
+      if (m_previous != current_device) {
+        ::hipSetDevice(m_previous);
+      }
+    }
+
+    int m_previous;
+  };
+
+  int m_device;
+};
+
+} // end of namespace alloc
+} // end of namespace umpire
+
+#endif // UMPIRE_HipMallocAllocator_HPP
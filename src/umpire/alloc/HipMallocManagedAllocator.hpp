@@ -0,0 +1,123 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_HipMallocManagedAllocator_HPP
+#define UMPIRE_HipMallocManagedAllocator_HPP
+
+#include <hip/hip_runtime_api.h>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace alloc {
+
+/*!
+ * \brief Uses hipMallocManaged and hipFree to allocate and deallocate
+ *        unified memory on AMD GPUs.
+ */
+struct HipMallocManagedAllocator
+{
+  /*!
+   * \brief Allocate bytes of memory using hipMallocManaged.
+   *
+   * \param bytes Number of bytes to allocate.
+   *
+   * \return Pointer to start of the allocation.
+   *
+   * \throws umpire::util::Exception if memory cannot be allocated.
+   */
+  void* allocate(size_t bytes)
+  {
+    void* ptr = nullptr;
+    hipError_t error = ::hipMallocManaged(&ptr, bytes);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ptr);
+    if (error != hipSuccess) {
+      UMPIRE_ERROR("hipMallocManaged( bytes = " << bytes << " ) failed with error: " << hipGetErrorString(error));
+    } else {
+      return ptr;
+    }
+  }
+
+  /*!
+   * \brief Allocate bytes of memory using hipMallocManaged, returning nullptr if it
+   * cannot be allocated.
+   */
+  void* tryAllocate(size_t bytes)
+  {
+    void* ptr = nullptr;
+    hipError_t error = ::hipMallocManaged(&ptr, bytes);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ptr);
+    if (error != hipSuccess) {
+      ::hipGetLastError();
+      return nullptr;
+    }
+
+    return ptr;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory aligned to alignment bytes.
+   *
+   * hipMallocManaged returns memory aligned to at least 256 bytes.
+   *
+   * \throws umpire::util::Exception if alignment is larger than 256.
+   */
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    if (alignment > 256) {
+      UMPIRE_ERROR("hipMallocManaged cannot align to " << alignment << " bytes");
+    }
+
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Allocate bytes of memory using hipMallocManaged, zeroed with
+   * hipMemsetAsync on the default stream.
+   *
+   * \throws umpire::util::Exception if memory cannot be allocated.
+   */
+  void* allocateZeroed(size_t bytes)
+  {
+    void* ptr = allocate(bytes);
+    hipError_t error = ::hipMemsetAsync(ptr, 0, bytes, 0);
+    if (error != hipSuccess) {
+      ::hipFree(ptr);
+      UMPIRE_ERROR("hipMemsetAsync( bytes = " << bytes << " ) failed with error: " << hipGetErrorString(error));
+    }
+    return ptr;
+  }
+
+  /*!
+   * \brief Deallocate memory using hipFree.
+   *
+   * \param ptr Address to deallocate.
+   *
+   * \throws umpire::util::Exception if memory cannot be free'd.
+   */
+  void deallocate(void* ptr)
+  {
+    UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+    hipError_t error = ::hipFree(ptr);
+    if (error != hipSuccess) {
+      UMPIRE_ERROR("hipFree( ptr = " << ptr << " ) failed with error: " << hipGetErrorString(error));
+    }
+  }
+};
+
+} // end of namespace alloc
+} // end of namespace umpire
+
+#endif // UMPIRE_HipMallocManagedAllocator_HPP
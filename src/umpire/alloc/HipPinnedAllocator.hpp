@@ -0,0 +1,111 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_HipPinnedAllocator_HPP
+#define UMPIRE_HipPinnedAllocator_HPP
+
+#include <hip/hip_runtime_api.h>
+
+#include <cstring>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace alloc {
+
+/*!
+ * \brief Uses hipHostMalloc and hipHostFree to allocate and deallocate
+ *        page-locked host memory.
+ *
+ * An allocator constructed with hipHostMallocMapped also maps the memory
+ * into the device address space, so kernels can access it directly.
+ */
+struct HipPinnedAllocator
+{
+  HipPinnedAllocator(unsigned int flags = hipHostMallocDefault) :
+    m_flags(flags)
+  {
+  }
+
+  void* allocate(size_t bytes)
+  {
+    void* ptr = nullptr;
+    hipError_t error = ::hipHostMalloc(&ptr, bytes, m_flags);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ptr);
+    if (error != hipSuccess) {
+      UMPIRE_ERROR("hipHostMalloc( bytes = " << bytes << ", flags = " << m_flags << " ) failed with error: " << hipGetErrorString(error));
+    } else {
+      return ptr;
+    }
+  }
+
+  /*!
+   * \brief Allocate bytes of memory using hipHostMalloc, returning nullptr if it
+   * cannot be allocated.
+   */
+  void* tryAllocate(size_t bytes)
+  {
+    void* ptr = nullptr;
+    hipError_t error = ::hipHostMalloc(&ptr, bytes, m_flags);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ptr);
+    if (error != hipSuccess) {
+      ::hipGetLastError();
+      return nullptr;
+    }
+
+    return ptr;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory aligned to alignment bytes.
+   *
+   * hipHostMalloc returns memory aligned to at least 256 bytes.
+   *
+   * \throws umpire::util::Exception if alignment is larger than 256.
+   */
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    if (alignment > 256) {
+      UMPIRE_ERROR("hipHostMalloc cannot align to " << alignment << " bytes");
+    }
+
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Allocate bytes of page-locked memory, cleared on the host.
+   */
+  void* allocateZeroed(size_t bytes)
+  {
+    void* ptr = allocate(bytes);
+    std::memset(ptr, 0, bytes);
+    return ptr;
+  }
+
+  void deallocate(void* ptr)
+  {
+    UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+    hipError_t error = ::hipHostFree(ptr);
+    if (error != hipSuccess) {
+      UMPIRE_ERROR("hipHostFree( ptr = " << ptr << " ) failed with error: " << hipGetErrorString(error));
+    }
+  }
+
+  unsigned int m_flags;
+};
+
+} // end of namespace alloc
+} // end of namespace umpire
+
+#endif // UMPIRE_HipPinnedAllocator_HPP
@@ -15,6 +15,7 @@
 #ifndef UMPIRE_MallocAllocator_HPP
 #define UMPIRE_MallocAllocator_HPP
 
+#include <cstddef>
 #include <cstdlib>
 
 #include "umpire/util/Macros.hpp"
@@ -47,6 +48,67 @@ struct MallocAllocator
     }
   }
 
+  /*!
+   * \brief Allocate bytes of memory using malloc, returning nullptr if it
+   * cannot be allocated.
+   */
+  void* tryAllocate(size_t bytes)
+  {
+    void* ret = ::malloc(bytes);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ret);
+
+    return ret;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory aligned to alignment bytes.
+   *
+   * malloc already aligns to alignof(std::max_align_t), so only larger
+   * alignments go through posix_memalign. Both are released with free.
+   *
+   * \param bytes Number of bytes to allocate.
+   * \param alignment Power of two alignment in bytes.
+   * \return Pointer to start of the allocation.
+   *
+   * \throws umpire::util::Exception if memory cannot be allocated.
+   */
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    if (alignment <= alignof(std::max_align_t)) {
+      return allocate(bytes);
+    }
+
+    void* ret = nullptr;
+    const int error = ::posix_memalign(&ret, alignment, bytes);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ", alignment=" << alignment << ") returning " << ret);
+
+    if (error != 0) {
+      UMPIRE_ERROR("posix_memalign( bytes = " << bytes << ", alignment = " << alignment << " ) failed");
+    } else {
+      return ret;
+    }
+  }
+
+  /*!
+   * \brief Allocate bytes of zeroed memory using calloc.
+   *
+   * calloc skips clearing memory it knows to be zero, such as pages freshly
+   * mapped from the OS for a large request.
+   *
+   * \throws umpire::util::Exception if memory cannot be allocated.
+   */
+  void* allocateZeroed(size_t bytes)
+  {
+    void* ret = ::calloc(1, bytes);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ret);
+
+    if (ret == nullptr) {
+      UMPIRE_ERROR("calloc( bytes = " << bytes << " ) failed");
+    } else {
+      return ret;
+    }
+  }
+
   /*!
    * \brief Deallocate memory using free.
    *
@@ -0,0 +1,338 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_MemfdAllocator_HPP
+#define UMPIRE_MemfdAllocator_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace alloc {
+
+/*!
+ * \brief Allocates host memory backed by an anonymous memfd, so that
+ * allocations can be snapshotted with copy-on-write.
+ *
+ * An allocation starts as a MAP_SHARED mapping of its own memfd. snapshot
+ * maps the memfd again with MAP_PRIVATE and remaps the allocation the same
+ * way, which freezes the file: both views share its pages, and whichever
+ * side writes a page gets a private copy of it. A snapshot costs a pair of
+ * mmap calls, and memory grows only with the pages written afterwards.
+ *
+ * Snapshotting an allocation whose file is frozen first gives it a file of
+ * its own again. If no snapshot of the old file is left, the pages it wrote
+ * are found in /proc/self/pagemap and written back, so the cost stays
+ * proportional to the pages touched. Otherwise the whole allocation is
+ * copied to a new file.
+ */
+struct MemfdAllocator
+{
+  MemfdAllocator() :
+    m_mappings(std::make_shared<Mappings>())
+  {
+  }
+
+  /*!
+   * \brief Allocate bytes of memory backed by a new memfd.
+   *
+   * \param bytes Number of bytes to allocate.
+   * \return Pointer to start of the allocation.
+   *
+   * \throws umpire::util::Exception if the memfd cannot be created or mapped.
+   */
+  void* allocate(size_t bytes)
+  {
+    const size_t length = pageAlign(bytes);
+
+    std::shared_ptr<File> file = createFile(length);
+
+    void* ret = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, file->fd, 0);
+    if (ret == MAP_FAILED) {
+      UMPIRE_ERROR("mmap( bytes = " << bytes << " ) of a memfd failed: " << std::strerror(errno));
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mappings->mutex);
+      m_mappings->mappings[ret] = Mapping{file, length, true};
+    }
+
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ret);
+
+    return ret;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory, returning nullptr if it cannot be
+   * allocated.
+   */
+  void* tryAllocate(size_t bytes)
+  {
+    try {
+      return allocate(bytes);
+    } catch (util::Exception&) {
+      return nullptr;
+    }
+  }
+
+  /*!
+   * \brief Allocate bytes of memory aligned to alignment bytes.
+   *
+   * \throws umpire::util::Exception if alignment is larger than a page.
+   */
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+    if (alignment > page_size) {
+      UMPIRE_ERROR("mmap cannot align to " << alignment << " bytes, pages are " << page_size);
+    }
+
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Allocate bytes of zeroed memory.
+   *
+   * A new memfd reads as zeros, so this is allocate.
+   */
+  void* allocateZeroed(size_t bytes)
+  {
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Make a copy-on-write snapshot of the allocation at ptr.
+   *
+   * The snapshot holds the allocation's contents at the time of the call.
+   * It must be deallocated like any other allocation from this allocator,
+   * and can itself be snapshotted. Neither view may be written by another
+   * thread during the call.
+   *
+   * \param ptr Start of an allocation from this allocator.
+   * \return Pointer to the snapshot.
+   *
+   * \throws umpire::util::Exception if ptr was not allocated by this
+   * allocator.
+   */
+  void* snapshot(void* ptr)
+  {
+    std::lock_guard<std::mutex> lock(m_mappings->mutex);
+
+    auto found = m_mappings->mappings.find(ptr);
+    if (found == m_mappings->mappings.end()) {
+      UMPIRE_ERROR("Unknown mapping " << ptr);
+    }
+    Mapping& mapping = found->second;
+
+    if (!mapping.shared) {
+      if (mapping.file.use_count() == 1) {
+        writeBack(ptr, mapping);
+      } else {
+        std::shared_ptr<File> file = createFile(mapping.length);
+        writeAll(ptr, mapping.length, file->fd);
+        mapping.file = file;
+      }
+
+      remap(ptr, mapping.length, MAP_SHARED, mapping.file->fd);
+      mapping.shared = true;
+    }
+
+    void* ret = ::mmap(nullptr, mapping.length, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE, mapping.file->fd, 0);
+    if (ret == MAP_FAILED) {
+      UMPIRE_ERROR("mmap of a snapshot of " << ptr << " failed: " << std::strerror(errno));
+    }
+
+    remap(ptr, mapping.length, MAP_PRIVATE, mapping.file->fd);
+    mapping.shared = false;
+
+    Mapping snapshot_mapping{mapping.file, mapping.length, false};
+    m_mappings->mappings[ret] = snapshot_mapping;
+
+    UMPIRE_LOG(Debug, "(ptr=" << ptr << ") returning " << ret);
+
+    return ret;
+  }
+
+  /*!
+   * \brief Deallocate memory using munmap, closing the memfd once no
+   * mapping uses it.
+   *
+   * \throws umpire::util::Exception if ptr was not allocated by this
+   * allocator.
+   */
+  void deallocate(void* ptr)
+  {
+    UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+    std::shared_ptr<File> file;
+    size_t length = 0;
+    {
+      std::lock_guard<std::mutex> lock(m_mappings->mutex);
+      auto mapping = m_mappings->mappings.find(ptr);
+      if (mapping == m_mappings->mappings.end()) {
+        UMPIRE_ERROR("Unknown mapping " << ptr);
+      }
+      file = mapping->second.file;
+      length = mapping->second.length;
+      m_mappings->mappings.erase(mapping);
+    }
+
+    ::munmap(ptr, length);
+  }
+
+  struct File {
+    explicit File(int descriptor) : fd(descriptor) {}
+    ~File() { ::close(fd); }
+
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+
+    int fd;
+  };
+
+  struct Mapping {
+    std::shared_ptr<File> file;
+    size_t length;
+
+    // Writes go to the file, rather than to private copies of its pages
+    bool shared;
+  };
+
+  struct Mappings {
+    std::mutex mutex;
+    std::unordered_map<void*, Mapping> mappings;
+  };
+
+  static size_t pageAlign(size_t bytes)
+  {
+    const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+    // Zero-byte requests still get a page, so every mapping has a unique address
+    return (bytes == 0) ?
+      page_size : ((bytes + page_size - 1) / page_size) * page_size;
+  }
+
+  static std::shared_ptr<File> createFile(size_t length)
+  {
+    int fd = ::memfd_create("umpire", MFD_CLOEXEC);
+    if (fd < 0) {
+      UMPIRE_ERROR("memfd_create failed: " << std::strerror(errno));
+    }
+
+    std::shared_ptr<File> file = std::make_shared<File>(fd);
+
+    if (::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+      UMPIRE_ERROR("Sizing a memfd to " << length << " bytes failed: " << std::strerror(errno));
+    }
+
+    return file;
+  }
+
+  static void remap(void* ptr, size_t length, int flags, int fd)
+  {
+    if (::mmap(ptr, length, PROT_READ | PROT_WRITE, flags | MAP_FIXED, fd, 0) == MAP_FAILED) {
+      UMPIRE_ERROR("Remapping " << ptr << " failed: " << std::strerror(errno));
+    }
+  }
+
+  static void writeAll(void* ptr, size_t length, int fd)
+  {
+    writeRange(ptr, 0, length, fd);
+  }
+
+  static void writeRange(void* ptr, size_t offset, size_t length, int fd)
+  {
+    const char* data = static_cast<const char*>(ptr) + offset;
+    while (length > 0) {
+      ssize_t written = ::pwrite(fd, data, length, static_cast<off_t>(offset));
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        UMPIRE_ERROR("Writing to a memfd failed: " << std::strerror(errno));
+      }
+      data += written;
+      offset += static_cast<size_t>(written);
+      length -= static_cast<size_t>(written);
+    }
+  }
+
+  /*
+   * Write the pages of a private mapping that hold their own copy back to
+   * its file. In /proc/self/pagemap such pages are present and not file
+   * pages, or swapped out; untouched pages still read from the file.
+   */
+  static void writeBack(void* ptr, const Mapping& mapping)
+  {
+    const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t num_pages = mapping.length / page_size;
+
+    int pagemap = ::open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+    if (pagemap < 0) {
+      writeAll(ptr, mapping.length, mapping.file->fd);
+      return;
+    }
+
+    const uint64_t present = uint64_t{1} << 63;
+    const uint64_t swapped = uint64_t{1} << 62;
+    const uint64_t file_page = uint64_t{1} << 61;
+
+    const off_t first_entry = static_cast<off_t>(
+        reinterpret_cast<uintptr_t>(ptr) / page_size * sizeof(uint64_t));
+
+    uint64_t entries[512];
+    for (size_t page = 0; page < num_pages; page += 512) {
+      const size_t count = std::min<size_t>(512, num_pages - page);
+      const size_t bytes = count * sizeof(uint64_t);
+
+      if (::pread(pagemap, entries, bytes,
+            first_entry + static_cast<off_t>(page * sizeof(uint64_t)))
+          != static_cast<ssize_t>(bytes)) {
+        ::close(pagemap);
+        writeAll(ptr, mapping.length, mapping.file->fd);
+        return;
+      }
+
+      for (size_t i = 0; i < count; ++i) {
+        const bool written = ((entries[i] & present) && !(entries[i] & file_page))
+          || (entries[i] & swapped);
+        if (written) {
+          writeRange(ptr, (page + i) * page_size, page_size, mapping.file->fd);
+        }
+      }
+    }
+
+    ::close(pagemap);
+  }
+
+  std::shared_ptr<Mappings> m_mappings;
+};
+
+} // end of namespace alloc
+} // end of namespace umpire
+
+#endif // UMPIRE_MemfdAllocator_HPP
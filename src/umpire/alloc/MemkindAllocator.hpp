@@ -0,0 +1,133 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_MemkindAllocator_HPP
+#define UMPIRE_MemkindAllocator_HPP
+
+#include <memkind.h>
+
+#include <cstddef>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace alloc {
+
+/*!
+ * \brief Uses memkind to allocate high-bandwidth memory, e.g. the
+ * on-package HBM of nodes that expose it in flat mode.
+ *
+ * Allocations come from MEMKIND_HBW, and fail rather than fall back to
+ * other memory when it is exhausted; use a FallbackAllocator to spill to
+ * DDR instead.
+ */
+struct MemkindAllocator
+{
+  /*!
+   * \brief Allocate bytes of high-bandwidth memory.
+   *
+   * \param bytes Number of bytes to allocate.
+   * \return Pointer to start of the allocation.
+   *
+   * \throws umpire::util::Exception if memory cannot be allocated.
+   */
+  void* allocate(size_t bytes)
+  {
+    void* ret = ::memkind_malloc(MEMKIND_HBW, bytes);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ret);
+
+    if (ret == nullptr) {
+      UMPIRE_ERROR("memkind_malloc( MEMKIND_HBW, bytes = " << bytes << " ) failed");
+    }
+
+    return ret;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory using memkind_malloc, returning nullptr if it
+   * cannot be allocated.
+   */
+  void* tryAllocate(size_t bytes)
+  {
+    void* ret = ::memkind_malloc(MEMKIND_HBW, bytes);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ret);
+
+    return ret;
+  }
+
+  /*!
+   * \brief Allocate bytes of high-bandwidth memory aligned to alignment
+   * bytes.
+   *
+   * \throws umpire::util::Exception if memory cannot be allocated.
+   */
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    if (alignment < sizeof(void*)) {
+      return allocate(bytes);
+    }
+
+    void* ret = nullptr;
+    const int error = ::memkind_posix_memalign(MEMKIND_HBW, &ret, alignment, bytes);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ", alignment=" << alignment << ") returning " << ret);
+
+    if (error != 0) {
+      UMPIRE_ERROR("memkind_posix_memalign( MEMKIND_HBW, bytes = " << bytes << ", alignment = " << alignment << " ) failed");
+    }
+
+    return ret;
+  }
+
+  /*!
+   * \brief Allocate bytes of zeroed high-bandwidth memory using
+   * memkind_calloc.
+   *
+   * \throws umpire::util::Exception if memory cannot be allocated.
+   */
+  void* allocateZeroed(size_t bytes)
+  {
+    void* ret = ::memkind_calloc(MEMKIND_HBW, 1, bytes);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ret);
+
+    if (ret == nullptr) {
+      UMPIRE_ERROR("memkind_calloc( MEMKIND_HBW, bytes = " << bytes << " ) failed");
+    }
+
+    return ret;
+  }
+
+  /*!
+   * \brief Deallocate memory using memkind_free.
+   *
+   * \param ptr Address to deallocate.
+   */
+  void deallocate(void* ptr)
+  {
+    UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+    ::memkind_free(MEMKIND_HBW, ptr);
+  }
+
+  /*!
+   * \brief Return whether this system has high-bandwidth memory.
+   */
+  static bool isAvailable()
+  {
+    return ::memkind_check_available(MEMKIND_HBW) == 0;
+  }
+};
+
+} // end of namespace alloc
+} // end of namespace umpire
+
+#endif // UMPIRE_MemkindAllocator_HPP
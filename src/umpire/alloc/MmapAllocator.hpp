@@ -0,0 +1,225 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_MmapAllocator_HPP
+#define UMPIRE_MmapAllocator_HPP
+
+#include <sys/mman.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace alloc {
+
+/*!
+ * \brief Uses mmap and munmap to allocate and deallocate CPU memory, with
+ * optional huge page backing.
+ *
+ * In transparent_huge_pages mode, mappings are aligned to 2MB and marked
+ * with madvise(MADV_HUGEPAGE), so the kernel can back them with huge pages
+ * when available. In hugetlb_2mb and hugetlb_1gb modes, mappings use
+ * MAP_HUGETLB and are taken from the system's reserved huge page pool;
+ * allocation fails if no huge pages of that size are free.
+ *
+ * munmap needs the length of each mapping, so lengths are recorded in a map
+ * shared by all copies of the allocator.
+ */
+struct MmapAllocator
+{
+  enum class Mode {
+    default_pages,
+    transparent_huge_pages,
+    hugetlb_2mb,
+    hugetlb_1gb
+  };
+
+  MmapAllocator(Mode mode = Mode::default_pages) :
+    m_mode(mode),
+    m_mappings(std::make_shared<Mappings>())
+  {
+  }
+
+  /*!
+   * \brief Allocate bytes of memory using mmap.
+   *
+   * \param bytes Number of bytes to allocate.
+   * \return Pointer to start of the allocation.
+   *
+   * \throws umpire::util::Exception if memory cannot be allocated.
+   */
+  void* allocate(size_t bytes)
+  {
+    const size_t s_2mb = 2ul*1024*1024;
+    const size_t s_1gb = 1024ul*1024*1024;
+
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    size_t page_size = 4096;
+
+    switch (m_mode) {
+      case Mode::default_pages:
+        break;
+      case Mode::transparent_huge_pages:
+        page_size = s_2mb;
+        break;
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+      case Mode::hugetlb_2mb:
+        page_size = s_2mb;
+        flags |= MAP_HUGETLB | (21 << MAP_HUGE_SHIFT);
+        break;
+      case Mode::hugetlb_1gb:
+        page_size = s_1gb;
+        flags |= MAP_HUGETLB | (30 << MAP_HUGE_SHIFT);
+        break;
+#else
+      default:
+        UMPIRE_ERROR("MAP_HUGETLB is not supported on this system");
+#endif
+    }
+
+    // Zero-byte requests still get a page, so every mapping has a unique address
+    const size_t length = (bytes == 0) ?
+      page_size : ((bytes + page_size - 1) / page_size) * page_size;
+    void* ret = nullptr;
+
+    if (m_mode == Mode::transparent_huge_pages) {
+      /*
+       * Over-allocate by one huge page and trim the ends, so the mapping
+       * starts on a huge page boundary.
+       */
+      void* base = ::mmap(nullptr, length + page_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+      if (base == MAP_FAILED) {
+        UMPIRE_ERROR("mmap( bytes = " << bytes << " ) failed");
+      }
+
+      const uintptr_t start = reinterpret_cast<uintptr_t>(base);
+      const uintptr_t aligned = (start + page_size - 1) & ~(page_size - 1);
+      const size_t head = aligned - start;
+
+      if (head > 0) {
+        ::munmap(base, head);
+      }
+      ::munmap(reinterpret_cast<void*>(aligned + length), page_size - head);
+
+      ret = reinterpret_cast<void*>(aligned);
+
+#if defined(MADV_HUGEPAGE)
+      if (::madvise(ret, length, MADV_HUGEPAGE) != 0) {
+        UMPIRE_LOG(Debug, "madvise(MADV_HUGEPAGE) failed, using default pages");
+      }
+#endif
+    } else {
+      ret = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+      if (ret == MAP_FAILED) {
+        UMPIRE_ERROR("mmap( bytes = " << bytes << " ) failed");
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mappings->mutex);
+      m_mappings->lengths[ret] = length;
+    }
+
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ret);
+
+    return ret;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory, returning nullptr if it cannot be
+   * allocated.
+   */
+  void* tryAllocate(size_t bytes)
+  {
+    try {
+      return allocate(bytes);
+    } catch (util::Exception&) {
+      return nullptr;
+    }
+  }
+
+  /*!
+   * \brief Allocate bytes of memory aligned to alignment bytes.
+   *
+   * Mappings start on a page boundary, so any alignment up to the page
+   * size of the mode is met without extra work.
+   *
+   * \throws umpire::util::Exception if alignment is larger than a page.
+   */
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    const size_t page_size =
+      (m_mode == Mode::default_pages) ? 4096 :
+      (m_mode == Mode::hugetlb_1gb) ? 1024ul*1024*1024 : 2ul*1024*1024;
+
+    if (alignment > page_size) {
+      UMPIRE_ERROR("mmap cannot align to " << alignment << " bytes, pages are " << page_size);
+    }
+
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Allocate bytes of zeroed memory.
+   *
+   * Anonymous mappings are always zero-filled, so this is allocate.
+   */
+  void* allocateZeroed(size_t bytes)
+  {
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Deallocate memory using munmap.
+   *
+   * \param ptr Address to deallocate.
+   *
+   * \throws umpire::util::Exception if ptr was not allocated by this
+   * allocator.
+   */
+  void deallocate(void* ptr)
+  {
+    UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+    size_t length = 0;
+    {
+      std::lock_guard<std::mutex> lock(m_mappings->mutex);
+      auto mapping = m_mappings->lengths.find(ptr);
+      if (mapping == m_mappings->lengths.end()) {
+        UMPIRE_ERROR("Unknown mapping " << ptr);
+      }
+      length = mapping->second;
+      m_mappings->lengths.erase(mapping);
+    }
+
+    ::munmap(ptr, length);
+  }
+
+  struct Mappings {
+    std::mutex mutex;
+    std::unordered_map<void*, size_t> lengths;
+  };
+
+  Mode m_mode;
+  std::shared_ptr<Mappings> m_mappings;
+};
+
+} // end of namespace alloc
+} // end of namespace umpire
+
+#endif // UMPIRE_MmapAllocator_HPP
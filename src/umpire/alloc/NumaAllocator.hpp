@@ -0,0 +1,157 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_NumaAllocator_HPP
+#define UMPIRE_NumaAllocator_HPP
+
+#include <numa.h>
+
+#include <vector>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace alloc {
+
+/*!
+ * \brief Uses libnuma to allocate CPU memory bound to a single NUMA node, or
+ * interleaved page by page across all nodes.
+ *
+ * libnuma needs the size of an allocation to free it, so each allocation is
+ * preceded by one page holding its size. Returned pointers remain page
+ * aligned.
+ */
+struct NumaAllocator
+{
+  static const int interleaved = -1;
+
+  /*!
+   * \brief Construct an allocator for the given node, or for interleaved
+   * memory when node is NumaAllocator::interleaved.
+   */
+  NumaAllocator(int node = 0) :
+    m_node(node)
+  {
+  }
+
+  /*!
+   * \brief Allocate bytes of memory on this allocator's node(s).
+   *
+   * \param bytes Number of bytes to allocate.
+   * \return Pointer to start of the allocation.
+   *
+   * \throws umpire::util::Exception if memory cannot be allocated.
+   */
+  void* allocate(size_t bytes)
+  {
+    void* ret = tryAllocate(bytes);
+
+    if (ret == nullptr) {
+      UMPIRE_ERROR("numa_alloc( bytes = " << bytes << ", node = " << m_node << " ) failed");
+    }
+
+    return ret;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory on this allocator's node(s), returning
+   * nullptr if it cannot be allocated.
+   */
+  void* tryAllocate(size_t bytes)
+  {
+    const size_t page_size = ::numa_pagesize();
+    const size_t size = bytes + page_size;
+
+    void* base = (m_node == interleaved) ?
+      ::numa_alloc_interleaved(size) : ::numa_alloc_onnode(size, m_node);
+
+    if (base == nullptr) {
+      return nullptr;
+    }
+
+    *static_cast<size_t*>(base) = size;
+    void* ret = static_cast<char*>(base) + page_size;
+
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ", node=" << m_node << ") returning " << ret);
+
+    return ret;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory aligned to alignment bytes.
+   *
+   * Allocations start on a page boundary, so any alignment up to the page
+   * size is met without extra work.
+   *
+   * \throws umpire::util::Exception if alignment is larger than a page.
+   */
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    if (alignment > static_cast<size_t>(::numa_pagesize())) {
+      UMPIRE_ERROR("numa_alloc cannot align to " << alignment << " bytes");
+    }
+
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Allocate bytes of zeroed memory.
+   *
+   * libnuma maps fresh pages for each allocation, and only the page holding
+   * the size is written, so the memory returned is already zero.
+   */
+  void* allocateZeroed(size_t bytes)
+  {
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Deallocate memory using numa_free.
+   *
+   * \param ptr Address to deallocate.
+   */
+  void deallocate(void* ptr)
+  {
+    UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+    void* base = static_cast<char*>(ptr) - ::numa_pagesize();
+    ::numa_free(base, *static_cast<size_t*>(base));
+  }
+
+  /*!
+   * \brief Return the NUMA nodes memory can be allocated on, or no nodes if
+   * NUMA is not available on this system.
+   */
+  static std::vector<int> getNodes()
+  {
+    std::vector<int> nodes;
+
+    if (::numa_available() != -1) {
+      for (int node = 0; node <= ::numa_max_node(); ++node) {
+        if (::numa_bitmask_isbitset(::numa_all_nodes_ptr, node)) {
+          nodes.push_back(node);
+        }
+      }
+    }
+
+    return nodes;
+  }
+
+  int m_node;
+};
+
+} // end of namespace alloc
+} // end of namespace umpire
+
+#endif // UMPIRE_NumaAllocator_HPP
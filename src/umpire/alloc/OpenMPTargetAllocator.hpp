@@ -0,0 +1,185 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_OpenMPTargetAllocator_HPP
+#define UMPIRE_OpenMPTargetAllocator_HPP
+
+#include <omp.h>
+
+#include <map>
+#include <mutex>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace alloc {
+
+/*!
+ * \brief Uses omp_target_alloc and omp_target_free to allocate and
+ * deallocate memory on an OpenMP offload device.
+ *
+ * OpenMP offers no way to ask which device a pointer belongs to, so every
+ * allocation is recorded with its device. The copy operations look devices
+ * up with findDevice, which also works for pointers into the middle of an
+ * allocation, e.g. a block handed out by a pool.
+ */
+struct OpenMPTargetAllocator
+{
+  static const int default_device = -1;
+
+  /*!
+   * \brief Construct an allocator for the given device number, or for
+   * omp_get_default_device() when device is default_device.
+   */
+  OpenMPTargetAllocator(int device = default_device) :
+    m_device(device == default_device ? ::omp_get_default_device() : device)
+  {
+  }
+
+  /*!
+   * \brief Allocate bytes of memory using omp_target_alloc.
+   *
+   * \param bytes Number of bytes to allocate.
+   * \return Pointer to start of the allocation.
+   *
+   * \throws umpire::util::Exception if memory cannot be allocated.
+   */
+  void* allocate(size_t bytes)
+  {
+    void* ptr = tryAllocate(bytes);
+
+    if (ptr == nullptr) {
+      UMPIRE_ERROR("omp_target_alloc( bytes = " << bytes << ", device = " << m_device << " ) failed");
+    }
+
+    return ptr;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory using omp_target_alloc, returning
+   * nullptr if it cannot be allocated.
+   */
+  void* tryAllocate(size_t bytes)
+  {
+    void* ptr = ::omp_target_alloc(bytes, m_device);
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ", device=" << m_device << ") returning " << ptr);
+
+    if (ptr == nullptr) {
+      return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(getMutex());
+    getAllocations()[static_cast<char*>(ptr)] = Allocation{bytes, m_device};
+
+    return ptr;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory aligned to alignment bytes.
+   *
+   * omp_target_alloc makes no promise beyond the alignment of malloc, so
+   * only alignments up to 16 bytes are accepted.
+   *
+   * \throws umpire::util::Exception if alignment is larger than 16.
+   */
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    if (alignment > 16) {
+      UMPIRE_ERROR("omp_target_alloc cannot align to " << alignment << " bytes");
+    }
+
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Allocate bytes of memory using omp_target_alloc, cleared by a
+   * target region on the device.
+   */
+  void* allocateZeroed(size_t bytes)
+  {
+    char* ptr = static_cast<char*>(allocate(bytes));
+
+#pragma omp target teams distribute parallel for is_device_ptr(ptr) device(m_device)
+    for (size_t i = 0; i < bytes; ++i) {
+      ptr[i] = 0;
+    }
+
+    return ptr;
+  }
+
+  /*!
+   * \brief Deallocate memory using omp_target_free.
+   *
+   * \param ptr Address to deallocate.
+   */
+  void deallocate(void* ptr)
+  {
+    UMPIRE_LOG(Debug, "(ptr=" << ptr << ", device=" << m_device << ")");
+
+    {
+      std::lock_guard<std::mutex> lock(getMutex());
+      getAllocations().erase(static_cast<char*>(ptr));
+    }
+
+    ::omp_target_free(ptr, m_device);
+  }
+
+  /*!
+   * \brief Return the device number of the allocation containing ptr, or
+   * omp_get_initial_device() if ptr was not allocated by an
+   * OpenMPTargetAllocator.
+   */
+  static int findDevice(const void* ptr)
+  {
+    const char* p = static_cast<const char*>(ptr);
+
+    std::lock_guard<std::mutex> lock(getMutex());
+    auto& allocations = getAllocations();
+
+    auto allocation = allocations.upper_bound(const_cast<char*>(p));
+    if (allocation != allocations.begin()) {
+      --allocation;
+      if (p < allocation->first + allocation->second.size) {
+        return allocation->second.device;
+      }
+    }
+
+    return ::omp_get_initial_device();
+  }
+
+  int m_device;
+
+  private:
+    struct Allocation {
+      size_t size;
+      int device;
+    };
+
+    static std::map<char*, Allocation>& getAllocations()
+    {
+      static std::map<char*, Allocation> allocations;
+      return allocations;
+    }
+
+    static std::mutex& getMutex()
+    {
+      static std::mutex mutex;
+      return mutex;
+    }
+};
+
+} // end of namespace alloc
+} // end of namespace umpire
+
+#endif // UMPIRE_OpenMPTargetAllocator_HPP
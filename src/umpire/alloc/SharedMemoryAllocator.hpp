@@ -0,0 +1,223 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_SharedMemoryAllocator_HPP
+#define UMPIRE_SharedMemoryAllocator_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace alloc {
+
+/*!
+ * \brief Uses POSIX shared memory to allocate CPU memory that is shared by
+ * all processes on a node, e.g. the MPI ranks of a job.
+ *
+ * Allocation is collective: the n-th allocation made by each process maps
+ * the same segment, named after a key and n. The first process to arrive
+ * creates and sizes the segment, and the others wait for it and attach, so
+ * every process must make the same sequence of allocations with the same
+ * sizes. Processes only share memory when they use the same key.
+ *
+ * Deallocation unmaps the segment and removes its name. The memory is
+ * released once every process has deallocated it, but a process that has
+ * not attached yet can no longer find it, so processes should synchronize
+ * (e.g. with MPI_Barrier) between allocating and deallocating.
+ */
+struct SharedMemoryAllocator
+{
+  SharedMemoryAllocator(const std::string& key) :
+    m_key(key),
+    m_state(std::make_shared<State>())
+  {
+  }
+
+  /*!
+   * \brief Create or attach to the next shared segment.
+   *
+   * \param bytes Number of bytes to allocate.
+   * \return Pointer to start of the allocation.
+   *
+   * \throws umpire::util::Exception if the segment cannot be created, or
+   * another process created it with a different size.
+   */
+  void* allocate(size_t bytes)
+  {
+    const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+    // Zero-byte requests still get a page, so every mapping has a unique address
+    const size_t length = (bytes == 0) ?
+      page_size : ((bytes + page_size - 1) / page_size) * page_size;
+
+    std::string name;
+    {
+      std::lock_guard<std::mutex> lock(m_state->mutex);
+      name = "/umpire." + m_key + "." + std::to_string(m_state->next_segment++);
+    }
+
+    int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+
+    if (fd >= 0) {
+      if (::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+        const int error = errno;
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        UMPIRE_ERROR("ftruncate( " << name << ", " << length << " ) failed: " << std::strerror(error));
+      }
+    } else if (errno == EEXIST) {
+      fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+      if (fd < 0) {
+        UMPIRE_ERROR("shm_open( " << name << " ) failed: " << std::strerror(errno));
+      }
+
+      // The creator may not have sized the segment yet
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+      struct stat info;
+      info.st_size = 0;
+      while (::fstat(fd, &info) == 0 && info.st_size == 0
+          && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+
+      if (static_cast<size_t>(info.st_size) != length) {
+        ::close(fd);
+        UMPIRE_ERROR("Shared segment " << name << " has " << info.st_size
+            << " bytes, but " << length << " were requested");
+      }
+    } else {
+      UMPIRE_ERROR("shm_open( " << name << " ) failed: " << std::strerror(errno));
+    }
+
+    void* ret = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (ret == MAP_FAILED) {
+      UMPIRE_ERROR("mmap( " << name << ", bytes = " << bytes << " ) failed");
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_state->mutex);
+      m_state->segments[ret] = Segment{name, length};
+    }
+
+    UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ret << " from " << name);
+
+    return ret;
+  }
+
+  /*!
+   * \brief Allocate bytes of memory, returning nullptr if it cannot be
+   * allocated.
+   */
+  void* tryAllocate(size_t bytes)
+  {
+    try {
+      return allocate(bytes);
+    } catch (util::Exception&) {
+      return nullptr;
+    }
+  }
+
+  /*!
+   * \brief Allocate bytes of memory aligned to alignment bytes.
+   *
+   * Mappings start on a page boundary, so any alignment up to the page size
+   * is met without extra work.
+   *
+   * \throws umpire::util::Exception if alignment is larger than a page.
+   */
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+    if (alignment > page_size) {
+      UMPIRE_ERROR("mmap cannot align to " << alignment << " bytes, pages are " << page_size);
+    }
+
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Allocate bytes of zeroed memory.
+   *
+   * A new segment reads as zeros, so this is allocate. Processes that
+   * attach later see whatever has been written since.
+   */
+  void* allocateZeroed(size_t bytes)
+  {
+    return allocate(bytes);
+  }
+
+  /*!
+   * \brief Unmap a shared segment and remove its name.
+   *
+   * \param ptr Address to deallocate.
+   *
+   * \throws umpire::util::Exception if ptr was not allocated by this
+   * allocator.
+   */
+  void deallocate(void* ptr)
+  {
+    UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+    Segment segment;
+    {
+      std::lock_guard<std::mutex> lock(m_state->mutex);
+      auto found = m_state->segments.find(ptr);
+      if (found == m_state->segments.end()) {
+        UMPIRE_ERROR("Unknown shared segment " << ptr);
+      }
+      segment = found->second;
+      m_state->segments.erase(found);
+    }
+
+    ::munmap(ptr, segment.length);
+
+    // Another process may have removed the name already
+    ::shm_unlink(segment.name.c_str());
+  }
+
+  struct Segment {
+    std::string name;
+    size_t length;
+  };
+
+  struct State {
+    std::mutex mutex;
+    std::size_t next_segment = 0;
+    std::unordered_map<void*, Segment> segments;
+  };
+
+  std::string m_key;
+  std::shared_ptr<State> m_state;
+};
+
+} // end of namespace alloc
+} // end of namespace umpire
+
+#endif // UMPIRE_SharedMemoryAllocator_HPP
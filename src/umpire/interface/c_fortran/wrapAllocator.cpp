@@ -16,16 +16,72 @@
 // This is generated code, do not edit
 // wrapAllocator.cpp
 #include "wrapAllocator.h"
+#include <cstring>
+#include <string>
+#include "shroudrt.hpp"
 #include "umpire/Allocator.hpp"
 
 namespace umpire {
 
 // splicer begin class.Allocator.CXX_definitions
+static void copy_histogram(
+    const util::Histogram& from, UMPIRE_histogram * to)
+{
+    to->count = from.count;
+    to->sum = from.sum;
+    to->max = from.max;
+    for (int i = 0; i < UMPIRE_HISTOGRAM_BUCKETS; ++i) {
+        to->buckets[i] = from.buckets[i];
+    }
+}
 // splicer end class.Allocator.CXX_definitions
 
 extern "C" {
 
 // splicer begin class.Allocator.C_definitions
+void UMPIRE_allocator_enable_statistics(UMPIRE_allocator * self)
+{
+    Allocator *SH_this = static_cast<Allocator *>(static_cast<void *>(self));
+    SH_this->enableStatistics();
+    return;
+}
+
+void UMPIRE_allocator_get_statistics(UMPIRE_allocator * self,
+    UMPIRE_allocator_statistics * statistics)
+{
+    Allocator *SH_this = static_cast<Allocator *>(static_cast<void *>(self));
+    const util::AllocatorStatistics::Summary summary =
+        SH_this->getStatistics();
+    copy_histogram(summary.allocate_ns, &statistics->allocate_ns);
+    copy_histogram(summary.deallocate_ns, &statistics->deallocate_ns);
+    copy_histogram(summary.copy_ns, &statistics->copy_ns);
+    copy_histogram(summary.allocation_bytes, &statistics->allocation_bytes);
+    return;
+}
+
+void UMPIRE_allocator_allocate_many(UMPIRE_allocator * self,
+    const size_t * sizes, size_t count, void ** ptrs)
+{
+    Allocator *SH_this = static_cast<Allocator *>(static_cast<void *>(self));
+    SH_this->allocateMany(sizes, count, ptrs);
+    return;
+}
+
+void UMPIRE_allocator_deallocate_many(UMPIRE_allocator * self,
+    void ** ptrs, size_t count)
+{
+    Allocator *SH_this = static_cast<Allocator *>(static_cast<void *>(self));
+    SH_this->deallocateMany(ptrs, count);
+    return;
+}
+
+void * UMPIRE_allocator_allocate_aligned(UMPIRE_allocator * self,
+    size_t bytes, size_t alignment)
+{
+    Allocator *SH_this = static_cast<Allocator *>(static_cast<void *>(self));
+    void * SH_rv = SH_this->allocate(bytes, alignment);
+    return SH_rv;
+}
 // splicer end class.Allocator.C_definitions
 
 void * UMPIRE_allocator_allocate(UMPIRE_allocator * self, size_t bytes)
@@ -46,6 +102,93 @@ void UMPIRE_allocator_deallocate(UMPIRE_allocator * self, void * ptr)
 // splicer end class.Allocator.method.deallocate
 }
 
+void UMPIRE_allocator_release(UMPIRE_allocator * self)
+{
+// splicer begin class.Allocator.method.release
+    Allocator *SH_this = static_cast<Allocator *>(static_cast<void *>(self));
+    SH_this->release();
+    return;
+// splicer end class.Allocator.method.release
+}
+
+size_t UMPIRE_allocator_get_size(UMPIRE_allocator * self, void * ptr)
+{
+// splicer begin class.Allocator.method.get_size
+    Allocator *SH_this = static_cast<Allocator *>(static_cast<void *>(self));
+    size_t SH_rv = SH_this->getSize(ptr);
+    return SH_rv;
+// splicer end class.Allocator.method.get_size
+}
+
+size_t UMPIRE_allocator_get_high_watermark(UMPIRE_allocator * self)
+{
+// splicer begin class.Allocator.method.get_high_watermark
+    Allocator *SH_this = static_cast<Allocator *>(static_cast<void *>(self));
+    size_t SH_rv = SH_this->getHighWatermark();
+    return SH_rv;
+// splicer end class.Allocator.method.get_high_watermark
+}
+
+size_t UMPIRE_allocator_get_current_size(UMPIRE_allocator * self)
+{
+// splicer begin class.Allocator.method.get_current_size
+    Allocator *SH_this = static_cast<Allocator *>(static_cast<void *>(self));
+    size_t SH_rv = SH_this->getCurrentSize();
+    return SH_rv;
+// splicer end class.Allocator.method.get_current_size
+}
+
+size_t UMPIRE_allocator_get_actual_size(UMPIRE_allocator * self)
+{
+// splicer begin class.Allocator.method.get_actual_size
+    Allocator *SH_this = static_cast<Allocator *>(static_cast<void *>(self));
+    size_t SH_rv = SH_this->getActualSize();
+    return SH_rv;
+// splicer end class.Allocator.method.get_actual_size
+}
+
+void UMPIRE_allocator_get_name(UMPIRE_allocator * self, char * name, size_t Nname)
+{
+// splicer begin class.Allocator.method.get_name
+    Allocator *SH_this = static_cast<Allocator *>(static_cast<void *>(self));
+    const std::string SH_rv = SH_this->getName();
+    if (Nname > 0) {
+        size_t SH_n = SH_rv.size() < Nname ? SH_rv.size() : Nname - 1;
+        std::memcpy(name, SH_rv.c_str(), SH_n);
+        name[SH_n] = '\0';
+    }
+    return;
+// splicer end class.Allocator.method.get_name
+}
+
+void UMPIRE_allocator_get_name_bufferify(UMPIRE_allocator * self, char * SH_F_rv, int NSH_F_rv)
+{
+// splicer begin class.Allocator.method.get_name_bufferify
+    Allocator *SH_this = static_cast<Allocator *>(static_cast<void *>(self));
+    const std::string SH_rv = SH_this->getName();
+    shroud_FccCopy(SH_F_rv, NSH_F_rv, SH_rv.c_str());
+    return;
+// splicer end class.Allocator.method.get_name_bufferify
+}
+
+int UMPIRE_allocator_get_id(UMPIRE_allocator * self)
+{
+// splicer begin class.Allocator.method.get_id
+    Allocator *SH_this = static_cast<Allocator *>(static_cast<void *>(self));
+    int SH_rv = SH_this->getId();
+    return SH_rv;
+// splicer end class.Allocator.method.get_id
+}
+
+void UMPIRE_allocator_delete(UMPIRE_allocator * self)
+{
+// splicer begin class.Allocator.method.delete
+    Allocator *SH_this = static_cast<Allocator *>(static_cast<void *>(self));
+    delete SH_this;
+    return;
+// splicer end class.Allocator.method.delete
+}
+
 }  // extern "C"
 
 }  // namespace umpire
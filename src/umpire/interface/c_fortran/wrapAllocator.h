@@ -37,12 +37,61 @@ struct s_UMPIRE_allocator;
 typedef struct s_UMPIRE_allocator UMPIRE_allocator;
 
 // splicer begin class.Allocator.C_declarations
+#define UMPIRE_HISTOGRAM_BUCKETS 64
+
+// Bucket 0 counts zeros; bucket i > 0 counts values in [2^(i-1), 2^i).
+typedef struct s_UMPIRE_histogram {
+    unsigned long long count;
+    unsigned long long sum;
+    unsigned long long max;
+    unsigned long long buckets[UMPIRE_HISTOGRAM_BUCKETS];
+} UMPIRE_histogram;
+
+// Latencies are in nanoseconds, sizes in bytes.
+typedef struct s_UMPIRE_allocator_statistics {
+    UMPIRE_histogram allocate_ns;
+    UMPIRE_histogram deallocate_ns;
+    UMPIRE_histogram copy_ns;
+    UMPIRE_histogram allocation_bytes;
+} UMPIRE_allocator_statistics;
+
+void UMPIRE_allocator_enable_statistics(UMPIRE_allocator * self);
+
+void UMPIRE_allocator_get_statistics(UMPIRE_allocator * self,
+    UMPIRE_allocator_statistics * statistics);
+
+void UMPIRE_allocator_allocate_many(UMPIRE_allocator * self,
+    const size_t * sizes, size_t count, void ** ptrs);
+
+void UMPIRE_allocator_deallocate_many(UMPIRE_allocator * self,
+    void ** ptrs, size_t count);
+
+void * UMPIRE_allocator_allocate_aligned(UMPIRE_allocator * self,
+    size_t bytes, size_t alignment);
 // splicer end class.Allocator.C_declarations
 
 void * UMPIRE_allocator_allocate(UMPIRE_allocator * self, size_t bytes);
 
 void UMPIRE_allocator_deallocate(UMPIRE_allocator * self, void * ptr);
 
+void UMPIRE_allocator_release(UMPIRE_allocator * self);
+
+size_t UMPIRE_allocator_get_size(UMPIRE_allocator * self, void * ptr);
+
+size_t UMPIRE_allocator_get_high_watermark(UMPIRE_allocator * self);
+
+size_t UMPIRE_allocator_get_current_size(UMPIRE_allocator * self);
+
+size_t UMPIRE_allocator_get_actual_size(UMPIRE_allocator * self);
+
+void UMPIRE_allocator_get_name(UMPIRE_allocator * self, char * name, size_t Nname);
+
+void UMPIRE_allocator_get_name_bufferify(UMPIRE_allocator * self, char * SH_F_rv, int NSH_F_rv);
+
+int UMPIRE_allocator_get_id(UMPIRE_allocator * self);
+
+void UMPIRE_allocator_delete(UMPIRE_allocator * self);
+
 #ifdef __cplusplus
 }
 #endif
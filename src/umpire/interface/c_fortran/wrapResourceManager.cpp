@@ -17,7 +17,11 @@
 // wrapResourceManager.cpp
 #include "wrapResourceManager.h"
 #include <string>
+#include <vector>
 #include "umpire/ResourceManager.hpp"
+#include "umpire/strategy/AllocationAdvisor.hpp"
+#include "umpire/strategy/DynamicPool.hpp"
+#include "umpire/strategy/ThreadSafeAllocator.hpp"
 
 namespace umpire {
 
@@ -27,6 +31,39 @@ namespace umpire {
 extern "C" {
 
 // splicer begin class.ResourceManager.C_definitions
+void UMPIRE_resourcemanager_deallocate_many(UMPIRE_resourcemanager * self,
+    void ** ptrs, size_t count)
+{
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    SH_this->deallocateMany(ptrs, count);
+    return;
+}
+
+size_t UMPIRE_resourcemanager_get_operation_statistics(
+    UMPIRE_resourcemanager * self,
+    UMPIRE_operation_statistics * statistics, size_t max_count)
+{
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    const std::vector<op::MemoryOperationStatistics> entries =
+        SH_this->getOperationStatistics();
+    for (size_t i = 0; i < entries.size() && i < max_count; ++i) {
+        statistics[i].type = static_cast<int>(entries[i].type);
+        statistics[i].src_platform = static_cast<int>(entries[i].src_platform);
+        statistics[i].dst_platform = static_cast<int>(entries[i].dst_platform);
+        statistics[i].calls = entries[i].calls;
+        statistics[i].bytes = entries[i].bytes;
+        statistics[i].nanoseconds = entries[i].nanoseconds;
+    }
+    return entries.size();
+}
+
+void UMPIRE_resourcemanager_reset_operation_statistics(
+    UMPIRE_resourcemanager * self)
+{
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    SH_this->resetOperationStatistics();
+    return;
+}
 // splicer end class.ResourceManager.C_definitions
 
 UMPIRE_resourcemanager * UMPIRE_resourcemanager_get()
@@ -58,6 +95,96 @@ UMPIRE_allocator * UMPIRE_resourcemanager_get_allocator_bufferify(UMPIRE_resourc
 // splicer end class.ResourceManager.method.get_allocator_bufferify
 }
 
+UMPIRE_allocator * UMPIRE_resourcemanager_make_allocator_pool(UMPIRE_resourcemanager * self, const char * name, UMPIRE_allocator * allocator, size_t initial_size, size_t block)
+{
+// splicer begin class.ResourceManager.method.make_allocator_pool
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    const std::string SH_name(name);
+    Allocator *SH_allocator = static_cast<Allocator *>(static_cast<void *>(allocator));
+    Allocator * SH_rv = new Allocator(SH_this->makeAllocator<strategy::DynamicPool>(SH_name, *SH_allocator, initial_size, block));
+    UMPIRE_allocator * XSH_rv = static_cast<UMPIRE_allocator *>(static_cast<void *>(SH_rv));
+    return XSH_rv;
+// splicer end class.ResourceManager.method.make_allocator_pool
+}
+
+UMPIRE_allocator * UMPIRE_resourcemanager_make_allocator_pool_bufferify(UMPIRE_resourcemanager * self, const char * name, int Lname, UMPIRE_allocator * allocator, size_t initial_size, size_t block)
+{
+// splicer begin class.ResourceManager.method.make_allocator_pool_bufferify
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    const std::string SH_name(name, Lname);
+    Allocator *SH_allocator = static_cast<Allocator *>(static_cast<void *>(allocator));
+    Allocator * SH_rv = new Allocator(SH_this->makeAllocator<strategy::DynamicPool>(SH_name, *SH_allocator, initial_size, block));
+    UMPIRE_allocator * XSH_rv = static_cast<UMPIRE_allocator *>(static_cast<void *>(SH_rv));
+    return XSH_rv;
+// splicer end class.ResourceManager.method.make_allocator_pool_bufferify
+}
+
+UMPIRE_allocator * UMPIRE_resourcemanager_make_allocator_advisor(UMPIRE_resourcemanager * self, const char * name, UMPIRE_allocator * allocator, const char * advice, UMPIRE_allocator * accessing_allocator)
+{
+// splicer begin class.ResourceManager.method.make_allocator_advisor
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    const std::string SH_name(name);
+    const std::string SH_advice(advice);
+    Allocator *SH_allocator = static_cast<Allocator *>(static_cast<void *>(allocator));
+    Allocator *SH_accessing_allocator = static_cast<Allocator *>(static_cast<void *>(accessing_allocator));
+    Allocator * SH_rv = new Allocator(SH_accessing_allocator
+      ? SH_this->makeAllocator<strategy::AllocationAdvisor>(SH_name, *SH_allocator, SH_advice, *SH_accessing_allocator)
+      : SH_this->makeAllocator<strategy::AllocationAdvisor>(SH_name, *SH_allocator, SH_advice));
+    UMPIRE_allocator * XSH_rv = static_cast<UMPIRE_allocator *>(static_cast<void *>(SH_rv));
+    return XSH_rv;
+// splicer end class.ResourceManager.method.make_allocator_advisor
+}
+
+UMPIRE_allocator * UMPIRE_resourcemanager_make_allocator_advisor_bufferify(UMPIRE_resourcemanager * self, const char * name, int Lname, UMPIRE_allocator * allocator, const char * advice, int Ladvice, UMPIRE_allocator * accessing_allocator)
+{
+// splicer begin class.ResourceManager.method.make_allocator_advisor_bufferify
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    const std::string SH_name(name, Lname);
+    const std::string SH_advice(advice, Ladvice);
+    Allocator *SH_allocator = static_cast<Allocator *>(static_cast<void *>(allocator));
+    Allocator *SH_accessing_allocator = static_cast<Allocator *>(static_cast<void *>(accessing_allocator));
+    Allocator * SH_rv = new Allocator(SH_accessing_allocator
+      ? SH_this->makeAllocator<strategy::AllocationAdvisor>(SH_name, *SH_allocator, SH_advice, *SH_accessing_allocator)
+      : SH_this->makeAllocator<strategy::AllocationAdvisor>(SH_name, *SH_allocator, SH_advice));
+    UMPIRE_allocator * XSH_rv = static_cast<UMPIRE_allocator *>(static_cast<void *>(SH_rv));
+    return XSH_rv;
+// splicer end class.ResourceManager.method.make_allocator_advisor_bufferify
+}
+
+UMPIRE_allocator * UMPIRE_resourcemanager_make_allocator_thread_safe(UMPIRE_resourcemanager * self, const char * name, UMPIRE_allocator * allocator)
+{
+// splicer begin class.ResourceManager.method.make_allocator_thread_safe
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    const std::string SH_name(name);
+    Allocator *SH_allocator = static_cast<Allocator *>(static_cast<void *>(allocator));
+    Allocator * SH_rv = new Allocator(SH_this->makeAllocator<strategy::ThreadSafeAllocator>(SH_name, *SH_allocator));
+    UMPIRE_allocator * XSH_rv = static_cast<UMPIRE_allocator *>(static_cast<void *>(SH_rv));
+    return XSH_rv;
+// splicer end class.ResourceManager.method.make_allocator_thread_safe
+}
+
+UMPIRE_allocator * UMPIRE_resourcemanager_make_allocator_thread_safe_bufferify(UMPIRE_resourcemanager * self, const char * name, int Lname, UMPIRE_allocator * allocator)
+{
+// splicer begin class.ResourceManager.method.make_allocator_thread_safe_bufferify
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    const std::string SH_name(name, Lname);
+    Allocator *SH_allocator = static_cast<Allocator *>(static_cast<void *>(allocator));
+    Allocator * SH_rv = new Allocator(SH_this->makeAllocator<strategy::ThreadSafeAllocator>(SH_name, *SH_allocator));
+    UMPIRE_allocator * XSH_rv = static_cast<UMPIRE_allocator *>(static_cast<void *>(SH_rv));
+    return XSH_rv;
+// splicer end class.ResourceManager.method.make_allocator_thread_safe_bufferify
+}
+
+UMPIRE_allocator * UMPIRE_resourcemanager_get_allocator_for_pointer(UMPIRE_resourcemanager * self, void * ptr)
+{
+// splicer begin class.ResourceManager.method.get_allocator_for_pointer
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    Allocator * SH_rv = new Allocator(SH_this->getAllocator(ptr));
+    UMPIRE_allocator * XSH_rv = static_cast<UMPIRE_allocator *>(static_cast<void *>(SH_rv));
+    return XSH_rv;
+// splicer end class.ResourceManager.method.get_allocator_for_pointer
+}
+
 void UMPIRE_resourcemanager_copy(UMPIRE_resourcemanager * self, void * src_ptr, void * dst_ptr)
 {
 // splicer begin class.ResourceManager.method.copy
@@ -67,6 +194,81 @@ void UMPIRE_resourcemanager_copy(UMPIRE_resourcemanager * self, void * src_ptr,
 // splicer end class.ResourceManager.method.copy
 }
 
+void UMPIRE_resourcemanager_copy_async(UMPIRE_resourcemanager * self, void * dst_ptr, void * src_ptr, size_t size, void * stream)
+{
+// splicer begin class.ResourceManager.method.copy_async
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    SH_this->copy(dst_ptr, src_ptr, size, stream);
+    return;
+// splicer end class.ResourceManager.method.copy_async
+}
+
+void UMPIRE_resourcemanager_memset(UMPIRE_resourcemanager * self, void * ptr, int value, size_t length)
+{
+// splicer begin class.ResourceManager.method.memset
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    SH_this->memset(ptr, value, length);
+    return;
+// splicer end class.ResourceManager.method.memset
+}
+
+void UMPIRE_resourcemanager_memset_async(UMPIRE_resourcemanager * self, void * ptr, int value, size_t length, void * stream)
+{
+// splicer begin class.ResourceManager.method.memset_async
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    SH_this->memset(ptr, value, length, stream);
+    return;
+// splicer end class.ResourceManager.method.memset_async
+}
+
+void * UMPIRE_resourcemanager_reallocate(UMPIRE_resourcemanager * self, void * src_ptr, size_t size)
+{
+// splicer begin class.ResourceManager.method.reallocate
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    void * SH_rv = SH_this->reallocate(src_ptr, size);
+    return SH_rv;
+// splicer end class.ResourceManager.method.reallocate
+}
+
+void * UMPIRE_resourcemanager_reallocate_with_allocator(UMPIRE_resourcemanager * self, void * src_ptr, size_t size, UMPIRE_allocator * allocator)
+{
+// splicer begin class.ResourceManager.method.reallocate_with_allocator
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    Allocator *SH_allocator = static_cast<Allocator *>(static_cast<void *>(allocator));
+    void * SH_rv = SH_this->reallocate(src_ptr, size, *SH_allocator);
+    return SH_rv;
+// splicer end class.ResourceManager.method.reallocate_with_allocator
+}
+
+void * UMPIRE_resourcemanager_move(UMPIRE_resourcemanager * self, void * src_ptr, UMPIRE_allocator * allocator)
+{
+// splicer begin class.ResourceManager.method.move
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    Allocator *SH_allocator = static_cast<Allocator *>(static_cast<void *>(allocator));
+    void * SH_rv = SH_this->move(src_ptr, *SH_allocator);
+    return SH_rv;
+// splicer end class.ResourceManager.method.move
+}
+
+void * UMPIRE_resourcemanager_move_async(UMPIRE_resourcemanager * self, void * src_ptr, UMPIRE_allocator * allocator, void * stream)
+{
+// splicer begin class.ResourceManager.method.move_async
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    Allocator *SH_allocator = static_cast<Allocator *>(static_cast<void *>(allocator));
+    void * SH_rv = SH_this->move(src_ptr, *SH_allocator, stream);
+    return SH_rv;
+// splicer end class.ResourceManager.method.move_async
+}
+
+void UMPIRE_resourcemanager_synchronize_moves(UMPIRE_resourcemanager * self)
+{
+// splicer begin class.ResourceManager.method.synchronize_moves
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    SH_this->synchronizeMoves();
+    return;
+// splicer end class.ResourceManager.method.synchronize_moves
+}
+
 void UMPIRE_resourcemanager_deallocate(UMPIRE_resourcemanager * self, void * ptr)
 {
 // splicer begin class.ResourceManager.method.deallocate
@@ -76,6 +278,15 @@ void UMPIRE_resourcemanager_deallocate(UMPIRE_resourcemanager * self, void * ptr
 // splicer end class.ResourceManager.method.deallocate
 }
 
+size_t UMPIRE_resourcemanager_get_size(UMPIRE_resourcemanager * self, void * ptr)
+{
+// splicer begin class.ResourceManager.method.get_size
+    ResourceManager *SH_this = static_cast<ResourceManager *>(static_cast<void *>(self));
+    size_t SH_rv = SH_this->getSize(ptr);
+    return SH_rv;
+// splicer end class.ResourceManager.method.get_size
+}
+
 }  // extern "C"
 
 }  // namespace umpire
@@ -23,6 +23,8 @@
 #ifndef WRAPRESOURCEMANAGER_H
 #define WRAPRESOURCEMANAGER_H
 
+#include "stdlib.h"
+
 // splicer begin class.ResourceManager.CXX_declarations
 // splicer end class.ResourceManager.CXX_declarations
 
@@ -37,6 +39,27 @@ struct s_UMPIRE_resourcemanager;
 typedef struct s_UMPIRE_resourcemanager UMPIRE_resourcemanager;
 
 // splicer begin class.ResourceManager.C_declarations
+// type is 0 for copy, 1 memset, 2 reallocate and 3 fill. Platforms are
+// 0 for cpu, 1 cuda, 2 hip and 3 omp_target.
+typedef struct s_UMPIRE_operation_statistics {
+    int type;
+    int src_platform;
+    int dst_platform;
+    unsigned long long calls;
+    unsigned long long bytes;
+    unsigned long long nanoseconds;
+} UMPIRE_operation_statistics;
+
+// Fills up to max_count entries and returns the number available.
+size_t UMPIRE_resourcemanager_get_operation_statistics(
+    UMPIRE_resourcemanager * self,
+    UMPIRE_operation_statistics * statistics, size_t max_count);
+
+void UMPIRE_resourcemanager_reset_operation_statistics(
+    UMPIRE_resourcemanager * self);
+
+void UMPIRE_resourcemanager_deallocate_many(UMPIRE_resourcemanager * self,
+    void ** ptrs, size_t count);
 // splicer end class.ResourceManager.C_declarations
 
 UMPIRE_resourcemanager * UMPIRE_resourcemanager_get();
@@ -45,10 +68,42 @@ UMPIRE_allocator * UMPIRE_resourcemanager_get_allocator(UMPIRE_resourcemanager *
 
 UMPIRE_allocator * UMPIRE_resourcemanager_get_allocator_bufferify(UMPIRE_resourcemanager * self, const char * space, int Lspace);
 
+UMPIRE_allocator * UMPIRE_resourcemanager_make_allocator_pool(UMPIRE_resourcemanager * self, const char * name, UMPIRE_allocator * allocator, size_t initial_size, size_t block);
+
+UMPIRE_allocator * UMPIRE_resourcemanager_make_allocator_pool_bufferify(UMPIRE_resourcemanager * self, const char * name, int Lname, UMPIRE_allocator * allocator, size_t initial_size, size_t block);
+
+UMPIRE_allocator * UMPIRE_resourcemanager_make_allocator_advisor(UMPIRE_resourcemanager * self, const char * name, UMPIRE_allocator * allocator, const char * advice, UMPIRE_allocator * accessing_allocator);
+
+UMPIRE_allocator * UMPIRE_resourcemanager_make_allocator_advisor_bufferify(UMPIRE_resourcemanager * self, const char * name, int Lname, UMPIRE_allocator * allocator, const char * advice, int Ladvice, UMPIRE_allocator * accessing_allocator);
+
+UMPIRE_allocator * UMPIRE_resourcemanager_make_allocator_thread_safe(UMPIRE_resourcemanager * self, const char * name, UMPIRE_allocator * allocator);
+
+UMPIRE_allocator * UMPIRE_resourcemanager_make_allocator_thread_safe_bufferify(UMPIRE_resourcemanager * self, const char * name, int Lname, UMPIRE_allocator * allocator);
+
+UMPIRE_allocator * UMPIRE_resourcemanager_get_allocator_for_pointer(UMPIRE_resourcemanager * self, void * ptr);
+
 void UMPIRE_resourcemanager_copy(UMPIRE_resourcemanager * self, void * src_ptr, void * dst_ptr);
 
+void UMPIRE_resourcemanager_copy_async(UMPIRE_resourcemanager * self, void * dst_ptr, void * src_ptr, size_t size, void * stream);
+
+void UMPIRE_resourcemanager_memset(UMPIRE_resourcemanager * self, void * ptr, int value, size_t length);
+
+void UMPIRE_resourcemanager_memset_async(UMPIRE_resourcemanager * self, void * ptr, int value, size_t length, void * stream);
+
+void * UMPIRE_resourcemanager_reallocate(UMPIRE_resourcemanager * self, void * src_ptr, size_t size);
+
+void * UMPIRE_resourcemanager_reallocate_with_allocator(UMPIRE_resourcemanager * self, void * src_ptr, size_t size, UMPIRE_allocator * allocator);
+
+void * UMPIRE_resourcemanager_move(UMPIRE_resourcemanager * self, void * src_ptr, UMPIRE_allocator * allocator);
+
+void * UMPIRE_resourcemanager_move_async(UMPIRE_resourcemanager * self, void * src_ptr, UMPIRE_allocator * allocator, void * stream);
+
+void UMPIRE_resourcemanager_synchronize_moves(UMPIRE_resourcemanager * self);
+
 void UMPIRE_resourcemanager_deallocate(UMPIRE_resourcemanager * self, void * ptr);
 
+size_t UMPIRE_resourcemanager_get_size(UMPIRE_resourcemanager * self, void * ptr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,7 @@ module umpire_mod
     ! splicer begin class.ResourceManager.module_use
     ! splicer end class.ResourceManager.module_use
     ! splicer begin class.Allocator.module_use
+    use iso_c_binding, only : C_SIZE_T
     ! splicer end class.Allocator.module_use
     implicit none
 
@@ -42,8 +43,21 @@ module umpire_mod
         ! splicer end class.ResourceManager.component_part
     contains
         procedure :: get_allocator => resourcemanager_get_allocator
+        procedure :: make_allocator_pool => resourcemanager_make_allocator_pool
+        procedure :: make_allocator_advisor => resourcemanager_make_allocator_advisor
+        procedure :: make_allocator_thread_safe => resourcemanager_make_allocator_thread_safe
+        procedure :: get_allocator_for_pointer => resourcemanager_get_allocator_for_pointer
         procedure :: copy => resourcemanager_copy
+        procedure :: copy_async => resourcemanager_copy_async
+        procedure :: memset => resourcemanager_memset
+        procedure :: memset_async => resourcemanager_memset_async
+        procedure :: reallocate => resourcemanager_reallocate
+        procedure :: reallocate_with_allocator => resourcemanager_reallocate_with_allocator
+        procedure :: move => resourcemanager_move
+        procedure :: move_async => resourcemanager_move_async
+        procedure :: synchronize_moves => resourcemanager_synchronize_moves
         procedure :: deallocate => resourcemanager_deallocate
+        procedure :: get_size => resourcemanager_get_size
         procedure :: get_instance => resourcemanager_get_instance
         procedure :: set_instance => resourcemanager_set_instance
         procedure :: associated => resourcemanager_associated
@@ -52,6 +66,9 @@ module umpire_mod
     end type UmpireResourceManager
 
     ! splicer begin class.Allocator.module_top
+    ! Alignment in bytes of the arrays returned by the typed allocate
+    ! routines, enough for the widest vector loads.
+    integer(C_SIZE_T), parameter :: UMPIRE_ARRAY_ALIGNMENT = 64
     ! splicer end class.Allocator.module_top
 
     type UmpireAllocator
@@ -61,10 +78,52 @@ module umpire_mod
     contains
         procedure :: allocate => allocator_allocate
         procedure :: deallocate => allocator_deallocate
+        procedure :: release => allocator_release
+        procedure :: get_size => allocator_get_size
+        procedure :: get_high_watermark => allocator_get_high_watermark
+        procedure :: get_current_size => allocator_get_current_size
+        procedure :: get_actual_size => allocator_get_actual_size
+        procedure :: get_name => allocator_get_name
+        procedure :: get_id => allocator_get_id
+        procedure :: delete => allocator_delete
         procedure :: get_instance => allocator_get_instance
         procedure :: set_instance => allocator_set_instance
         procedure :: associated => allocator_associated
         ! splicer begin class.Allocator.type_bound_procedure_part
+        procedure :: allocate_double_array_1d => allocator_allocate_double_array_1d
+        procedure :: allocate_double_array_2d => allocator_allocate_double_array_2d
+        procedure :: allocate_double_array_3d => allocator_allocate_double_array_3d
+        procedure :: allocate_double_array_4d => allocator_allocate_double_array_4d
+        procedure :: allocate_int_array_1d => allocator_allocate_int_array_1d
+        procedure :: allocate_int_array_2d => allocator_allocate_int_array_2d
+        procedure :: allocate_int_array_3d => allocator_allocate_int_array_3d
+        procedure :: allocate_int_array_4d => allocator_allocate_int_array_4d
+        procedure :: deallocate_double_array_1d => allocator_deallocate_double_array_1d
+        procedure :: deallocate_double_array_2d => allocator_deallocate_double_array_2d
+        procedure :: deallocate_double_array_3d => allocator_deallocate_double_array_3d
+        procedure :: deallocate_double_array_4d => allocator_deallocate_double_array_4d
+        procedure :: deallocate_int_array_1d => allocator_deallocate_int_array_1d
+        procedure :: deallocate_int_array_2d => allocator_deallocate_int_array_2d
+        procedure :: deallocate_int_array_3d => allocator_deallocate_int_array_3d
+        procedure :: deallocate_int_array_4d => allocator_deallocate_int_array_4d
+        generic :: allocate_array => &
+            allocate_double_array_1d, &
+            allocate_double_array_2d, &
+            allocate_double_array_3d, &
+            allocate_double_array_4d, &
+            allocate_int_array_1d, &
+            allocate_int_array_2d, &
+            allocate_int_array_3d, &
+            allocate_int_array_4d
+        generic :: deallocate_array => &
+            deallocate_double_array_1d, &
+            deallocate_double_array_2d, &
+            deallocate_double_array_3d, &
+            deallocate_double_array_4d, &
+            deallocate_int_array_1d, &
+            deallocate_int_array_2d, &
+            deallocate_int_array_3d, &
+            deallocate_int_array_4d
         ! splicer end class.Allocator.type_bound_procedure_part
     end type UmpireAllocator
 
@@ -110,6 +169,58 @@ module umpire_mod
             type(C_PTR) :: SH_rv
         end function c_resourcemanager_get_allocator_bufferify
 
+        function c_resourcemanager_make_allocator_pool_bufferify(self, name, Lname, allocator, initial_size, block) &
+                result(SH_rv) &
+                bind(C, name="UMPIRE_resourcemanager_make_allocator_pool_bufferify")
+            use iso_c_binding, only : C_CHAR, C_INT, C_PTR, C_SIZE_T
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            character(kind=C_CHAR), intent(IN) :: name(*)
+            integer(C_INT), value, intent(IN) :: Lname
+            type(C_PTR), value, intent(IN) :: allocator
+            integer(C_SIZE_T), value, intent(IN) :: initial_size
+            integer(C_SIZE_T), value, intent(IN) :: block
+            type(C_PTR) :: SH_rv
+        end function c_resourcemanager_make_allocator_pool_bufferify
+
+        function c_resourcemanager_make_allocator_advisor_bufferify(self, name, Lname, allocator, &
+                advice, Ladvice, accessing_allocator) &
+                result(SH_rv) &
+                bind(C, name="UMPIRE_resourcemanager_make_allocator_advisor_bufferify")
+            use iso_c_binding, only : C_CHAR, C_INT, C_PTR
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            character(kind=C_CHAR), intent(IN) :: name(*)
+            integer(C_INT), value, intent(IN) :: Lname
+            type(C_PTR), value, intent(IN) :: allocator
+            character(kind=C_CHAR), intent(IN) :: advice(*)
+            integer(C_INT), value, intent(IN) :: Ladvice
+            type(C_PTR), value, intent(IN) :: accessing_allocator
+            type(C_PTR) :: SH_rv
+        end function c_resourcemanager_make_allocator_advisor_bufferify
+
+        function c_resourcemanager_make_allocator_thread_safe_bufferify(self, name, Lname, allocator) &
+                result(SH_rv) &
+                bind(C, name="UMPIRE_resourcemanager_make_allocator_thread_safe_bufferify")
+            use iso_c_binding, only : C_CHAR, C_INT, C_PTR
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            character(kind=C_CHAR), intent(IN) :: name(*)
+            integer(C_INT), value, intent(IN) :: Lname
+            type(C_PTR), value, intent(IN) :: allocator
+            type(C_PTR) :: SH_rv
+        end function c_resourcemanager_make_allocator_thread_safe_bufferify
+
+        function c_resourcemanager_get_allocator_for_pointer(self, ptr) &
+                result(SH_rv) &
+                bind(C, name="UMPIRE_resourcemanager_get_allocator_for_pointer")
+            use iso_c_binding, only : C_PTR
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            type(C_PTR), value, intent(IN) :: ptr
+            type(C_PTR) :: SH_rv
+        end function c_resourcemanager_get_allocator_for_pointer
+
         subroutine c_resourcemanager_copy(self, src_ptr, dst_ptr) &
                 bind(C, name="UMPIRE_resourcemanager_copy")
             use iso_c_binding, only : C_PTR
@@ -119,6 +230,91 @@ module umpire_mod
             type(C_PTR), value, intent(IN) :: dst_ptr
         end subroutine c_resourcemanager_copy
 
+        subroutine c_resourcemanager_copy_async(self, dst_ptr, src_ptr, size, stream) &
+                bind(C, name="UMPIRE_resourcemanager_copy_async")
+            use iso_c_binding, only : C_PTR, C_SIZE_T
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            type(C_PTR), value, intent(IN) :: dst_ptr
+            type(C_PTR), value, intent(IN) :: src_ptr
+            integer(C_SIZE_T), value, intent(IN) :: size
+            type(C_PTR), value, intent(IN) :: stream
+        end subroutine c_resourcemanager_copy_async
+
+        subroutine c_resourcemanager_memset(self, ptr, value, length) &
+                bind(C, name="UMPIRE_resourcemanager_memset")
+            use iso_c_binding, only : C_INT, C_PTR, C_SIZE_T
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            type(C_PTR), value, intent(IN) :: ptr
+            integer(C_INT), value, intent(IN) :: value
+            integer(C_SIZE_T), value, intent(IN) :: length
+        end subroutine c_resourcemanager_memset
+
+        subroutine c_resourcemanager_memset_async(self, ptr, value, length, stream) &
+                bind(C, name="UMPIRE_resourcemanager_memset_async")
+            use iso_c_binding, only : C_INT, C_PTR, C_SIZE_T
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            type(C_PTR), value, intent(IN) :: ptr
+            integer(C_INT), value, intent(IN) :: value
+            integer(C_SIZE_T), value, intent(IN) :: length
+            type(C_PTR), value, intent(IN) :: stream
+        end subroutine c_resourcemanager_memset_async
+
+        function c_resourcemanager_reallocate(self, src_ptr, size) &
+                result(SH_rv) &
+                bind(C, name="UMPIRE_resourcemanager_reallocate")
+            use iso_c_binding, only : C_PTR, C_SIZE_T
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            type(C_PTR), value, intent(IN) :: src_ptr
+            integer(C_SIZE_T), value, intent(IN) :: size
+            type(C_PTR) :: SH_rv
+        end function c_resourcemanager_reallocate
+
+        function c_resourcemanager_reallocate_with_allocator(self, src_ptr, size, allocator) &
+                result(SH_rv) &
+                bind(C, name="UMPIRE_resourcemanager_reallocate_with_allocator")
+            use iso_c_binding, only : C_PTR, C_SIZE_T
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            type(C_PTR), value, intent(IN) :: src_ptr
+            integer(C_SIZE_T), value, intent(IN) :: size
+            type(C_PTR), value, intent(IN) :: allocator
+            type(C_PTR) :: SH_rv
+        end function c_resourcemanager_reallocate_with_allocator
+
+        function c_resourcemanager_move(self, src_ptr, allocator) &
+                result(SH_rv) &
+                bind(C, name="UMPIRE_resourcemanager_move")
+            use iso_c_binding, only : C_PTR
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            type(C_PTR), value, intent(IN) :: src_ptr
+            type(C_PTR), value, intent(IN) :: allocator
+            type(C_PTR) :: SH_rv
+        end function c_resourcemanager_move
+
+        function c_resourcemanager_move_async(self, src_ptr, allocator, stream) &
+                result(SH_rv) &
+                bind(C, name="UMPIRE_resourcemanager_move_async")
+            use iso_c_binding, only : C_PTR
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            type(C_PTR), value, intent(IN) :: src_ptr
+            type(C_PTR), value, intent(IN) :: allocator
+            type(C_PTR), value, intent(IN) :: stream
+            type(C_PTR) :: SH_rv
+        end function c_resourcemanager_move_async
+
+        subroutine c_resourcemanager_synchronize_moves(self) &
+                bind(C, name="UMPIRE_resourcemanager_synchronize_moves")
+            use iso_c_binding, only : C_PTR
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+        end subroutine c_resourcemanager_synchronize_moves
+
         subroutine c_resourcemanager_deallocate(self, ptr) &
                 bind(C, name="UMPIRE_resourcemanager_deallocate")
             use iso_c_binding, only : C_PTR
@@ -127,6 +323,16 @@ module umpire_mod
             type(C_PTR), value, intent(IN) :: ptr
         end subroutine c_resourcemanager_deallocate
 
+        function c_resourcemanager_get_size(self, ptr) &
+                result(SH_rv) &
+                bind(C, name="UMPIRE_resourcemanager_get_size")
+            use iso_c_binding, only : C_PTR, C_SIZE_T
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            type(C_PTR), value, intent(IN) :: ptr
+            integer(C_SIZE_T) :: SH_rv
+        end function c_resourcemanager_get_size
+
         ! splicer begin class.ResourceManager.additional_interfaces
         ! splicer end class.ResourceManager.additional_interfaces
 
@@ -148,7 +354,86 @@ module umpire_mod
             type(C_PTR), value, intent(IN) :: ptr
         end subroutine c_allocator_deallocate
 
+        subroutine c_allocator_release(self) &
+                bind(C, name="UMPIRE_allocator_release")
+            use iso_c_binding, only : C_PTR
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+        end subroutine c_allocator_release
+
+        function c_allocator_get_size(self, ptr) &
+                result(SH_rv) &
+                bind(C, name="UMPIRE_allocator_get_size")
+            use iso_c_binding, only : C_PTR, C_SIZE_T
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            type(C_PTR), value, intent(IN) :: ptr
+            integer(C_SIZE_T) :: SH_rv
+        end function c_allocator_get_size
+
+        function c_allocator_get_high_watermark(self) &
+                result(SH_rv) &
+                bind(C, name="UMPIRE_allocator_get_high_watermark")
+            use iso_c_binding, only : C_PTR, C_SIZE_T
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            integer(C_SIZE_T) :: SH_rv
+        end function c_allocator_get_high_watermark
+
+        function c_allocator_get_current_size(self) &
+                result(SH_rv) &
+                bind(C, name="UMPIRE_allocator_get_current_size")
+            use iso_c_binding, only : C_PTR, C_SIZE_T
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            integer(C_SIZE_T) :: SH_rv
+        end function c_allocator_get_current_size
+
+        function c_allocator_get_actual_size(self) &
+                result(SH_rv) &
+                bind(C, name="UMPIRE_allocator_get_actual_size")
+            use iso_c_binding, only : C_PTR, C_SIZE_T
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            integer(C_SIZE_T) :: SH_rv
+        end function c_allocator_get_actual_size
+
+        subroutine c_allocator_get_name_bufferify(self, SH_F_rv, NSH_F_rv) &
+                bind(C, name="UMPIRE_allocator_get_name_bufferify")
+            use iso_c_binding, only : C_CHAR, C_INT, C_PTR
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            character(kind=C_CHAR), intent(OUT) :: SH_F_rv(*)
+            integer(C_INT), value, intent(IN) :: NSH_F_rv
+        end subroutine c_allocator_get_name_bufferify
+
+        function c_allocator_get_id(self) &
+                result(SH_rv) &
+                bind(C, name="UMPIRE_allocator_get_id")
+            use iso_c_binding, only : C_INT, C_PTR
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            integer(C_INT) :: SH_rv
+        end function c_allocator_get_id
+
+        subroutine c_allocator_delete(self) &
+                bind(C, name="UMPIRE_allocator_delete")
+            use iso_c_binding, only : C_PTR
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+        end subroutine c_allocator_delete
+
         ! splicer begin class.Allocator.additional_interfaces
+        function c_allocator_allocate_aligned(self, bytes, alignment) &
+                result(SH_rv) &
+                bind(C, name="UMPIRE_allocator_allocate_aligned")
+            use iso_c_binding, only : C_PTR, C_SIZE_T
+            implicit none
+            type(C_PTR), value, intent(IN) :: self
+            integer(C_SIZE_T), value, intent(IN) :: bytes
+            integer(C_SIZE_T), value, intent(IN) :: alignment
+            type(C_PTR) :: SH_rv
+        end function c_allocator_allocate_aligned
         ! splicer end class.Allocator.additional_interfaces
     end interface
 
@@ -174,6 +459,77 @@ contains
         ! splicer end class.ResourceManager.method.get_allocator
     end function resourcemanager_get_allocator
 
+    function resourcemanager_make_allocator_pool(obj, name, allocator, initial_size, block) result(SH_rv)
+        use iso_c_binding, only : C_INT, C_SIZE_T
+        class(UmpireResourceManager) :: obj
+        character(*), intent(IN) :: name
+        type(UmpireAllocator), intent(IN) :: allocator
+        integer(C_SIZE_T), value, intent(IN) :: initial_size
+        integer(C_SIZE_T), value, intent(IN) :: block
+        type(UmpireAllocator) :: SH_rv
+        ! splicer begin class.ResourceManager.method.make_allocator_pool
+        SH_rv%voidptr = c_resourcemanager_make_allocator_pool_bufferify(  &
+            obj%voidptr,  &
+            name,  &
+            len_trim(name, kind=C_INT),  &
+            allocator%voidptr,  &
+            initial_size,  &
+            block)
+        ! splicer end class.ResourceManager.method.make_allocator_pool
+    end function resourcemanager_make_allocator_pool
+
+    function resourcemanager_make_allocator_advisor(obj, name, allocator, advice, accessing_allocator) result(SH_rv)
+        use iso_c_binding, only : C_INT, C_NULL_PTR, C_PTR
+        class(UmpireResourceManager) :: obj
+        character(*), intent(IN) :: name
+        type(UmpireAllocator), intent(IN) :: allocator
+        character(*), intent(IN) :: advice
+        type(UmpireAllocator), intent(IN), optional :: accessing_allocator
+        type(UmpireAllocator) :: SH_rv
+        type(C_PTR) :: SH_accessing_allocator
+        ! splicer begin class.ResourceManager.method.make_allocator_advisor
+        SH_accessing_allocator = C_NULL_PTR
+        if (present(accessing_allocator)) then
+            SH_accessing_allocator = accessing_allocator%voidptr
+        endif
+        SH_rv%voidptr = c_resourcemanager_make_allocator_advisor_bufferify(  &
+            obj%voidptr,  &
+            name,  &
+            len_trim(name, kind=C_INT),  &
+            allocator%voidptr,  &
+            advice,  &
+            len_trim(advice, kind=C_INT),  &
+            SH_accessing_allocator)
+        ! splicer end class.ResourceManager.method.make_allocator_advisor
+    end function resourcemanager_make_allocator_advisor
+
+    function resourcemanager_make_allocator_thread_safe(obj, name, allocator) result(SH_rv)
+        use iso_c_binding, only : C_INT
+        class(UmpireResourceManager) :: obj
+        character(*), intent(IN) :: name
+        type(UmpireAllocator), intent(IN) :: allocator
+        type(UmpireAllocator) :: SH_rv
+        ! splicer begin class.ResourceManager.method.make_allocator_thread_safe
+        SH_rv%voidptr = c_resourcemanager_make_allocator_thread_safe_bufferify(  &
+            obj%voidptr,  &
+            name,  &
+            len_trim(name, kind=C_INT),  &
+            allocator%voidptr)
+        ! splicer end class.ResourceManager.method.make_allocator_thread_safe
+    end function resourcemanager_make_allocator_thread_safe
+
+    function resourcemanager_get_allocator_for_pointer(obj, ptr) result(SH_rv)
+        use iso_c_binding, only : C_PTR
+        class(UmpireResourceManager) :: obj
+        type(C_PTR), value, intent(IN) :: ptr
+        type(UmpireAllocator) :: SH_rv
+        ! splicer begin class.ResourceManager.method.get_allocator_for_pointer
+        SH_rv%voidptr = c_resourcemanager_get_allocator_for_pointer(  &
+            obj%voidptr,  &
+            ptr)
+        ! splicer end class.ResourceManager.method.get_allocator_for_pointer
+    end function resourcemanager_get_allocator_for_pointer
+
     subroutine resourcemanager_copy(obj, src_ptr, dst_ptr)
         use iso_c_binding, only : C_PTR
         class(UmpireResourceManager) :: obj
@@ -187,6 +543,122 @@ contains
         ! splicer end class.ResourceManager.method.copy
     end subroutine resourcemanager_copy
 
+    subroutine resourcemanager_copy_async(obj, dst_ptr, src_ptr, size, stream)
+        use iso_c_binding, only : C_PTR, C_SIZE_T
+        class(UmpireResourceManager) :: obj
+        type(C_PTR), value, intent(IN) :: dst_ptr
+        type(C_PTR), value, intent(IN) :: src_ptr
+        integer(C_SIZE_T), value, intent(IN) :: size
+        type(C_PTR), value, intent(IN) :: stream
+        ! splicer begin class.ResourceManager.method.copy_async
+        call c_resourcemanager_copy_async(  &
+            obj%voidptr,  &
+            dst_ptr,  &
+            src_ptr,  &
+            size,  &
+            stream)
+        ! splicer end class.ResourceManager.method.copy_async
+    end subroutine resourcemanager_copy_async
+
+    subroutine resourcemanager_memset(obj, ptr, value, length)
+        use iso_c_binding, only : C_INT, C_PTR, C_SIZE_T
+        class(UmpireResourceManager) :: obj
+        type(C_PTR), value, intent(IN) :: ptr
+        integer(C_INT), value, intent(IN) :: value
+        integer(C_SIZE_T), value, intent(IN) :: length
+        ! splicer begin class.ResourceManager.method.memset
+        call c_resourcemanager_memset(  &
+            obj%voidptr,  &
+            ptr,  &
+            value,  &
+            length)
+        ! splicer end class.ResourceManager.method.memset
+    end subroutine resourcemanager_memset
+
+    subroutine resourcemanager_memset_async(obj, ptr, value, length, stream)
+        use iso_c_binding, only : C_INT, C_PTR, C_SIZE_T
+        class(UmpireResourceManager) :: obj
+        type(C_PTR), value, intent(IN) :: ptr
+        integer(C_INT), value, intent(IN) :: value
+        integer(C_SIZE_T), value, intent(IN) :: length
+        type(C_PTR), value, intent(IN) :: stream
+        ! splicer begin class.ResourceManager.method.memset_async
+        call c_resourcemanager_memset_async(  &
+            obj%voidptr,  &
+            ptr,  &
+            value,  &
+            length,  &
+            stream)
+        ! splicer end class.ResourceManager.method.memset_async
+    end subroutine resourcemanager_memset_async
+
+    function resourcemanager_reallocate(obj, src_ptr, size) result(SH_rv)
+        use iso_c_binding, only : C_PTR, C_SIZE_T
+        class(UmpireResourceManager) :: obj
+        type(C_PTR), value, intent(IN) :: src_ptr
+        integer(C_SIZE_T), value, intent(IN) :: size
+        type(C_PTR) :: SH_rv
+        ! splicer begin class.ResourceManager.method.reallocate
+        SH_rv = c_resourcemanager_reallocate(  &
+            obj%voidptr,  &
+            src_ptr,  &
+            size)
+        ! splicer end class.ResourceManager.method.reallocate
+    end function resourcemanager_reallocate
+
+    function resourcemanager_reallocate_with_allocator(obj, src_ptr, size, allocator) result(SH_rv)
+        use iso_c_binding, only : C_PTR, C_SIZE_T
+        class(UmpireResourceManager) :: obj
+        type(C_PTR), value, intent(IN) :: src_ptr
+        integer(C_SIZE_T), value, intent(IN) :: size
+        type(UmpireAllocator), intent(IN) :: allocator
+        type(C_PTR) :: SH_rv
+        ! splicer begin class.ResourceManager.method.reallocate_with_allocator
+        SH_rv = c_resourcemanager_reallocate_with_allocator(  &
+            obj%voidptr,  &
+            src_ptr,  &
+            size,  &
+            allocator%voidptr)
+        ! splicer end class.ResourceManager.method.reallocate_with_allocator
+    end function resourcemanager_reallocate_with_allocator
+
+    function resourcemanager_move(obj, src_ptr, allocator) result(SH_rv)
+        use iso_c_binding, only : C_PTR
+        class(UmpireResourceManager) :: obj
+        type(C_PTR), value, intent(IN) :: src_ptr
+        type(UmpireAllocator), intent(IN) :: allocator
+        type(C_PTR) :: SH_rv
+        ! splicer begin class.ResourceManager.method.move
+        SH_rv = c_resourcemanager_move(  &
+            obj%voidptr,  &
+            src_ptr,  &
+            allocator%voidptr)
+        ! splicer end class.ResourceManager.method.move
+    end function resourcemanager_move
+
+    function resourcemanager_move_async(obj, src_ptr, allocator, stream) result(SH_rv)
+        use iso_c_binding, only : C_PTR
+        class(UmpireResourceManager) :: obj
+        type(C_PTR), value, intent(IN) :: src_ptr
+        type(UmpireAllocator), intent(IN) :: allocator
+        type(C_PTR), value, intent(IN) :: stream
+        type(C_PTR) :: SH_rv
+        ! splicer begin class.ResourceManager.method.move_async
+        SH_rv = c_resourcemanager_move_async(  &
+            obj%voidptr,  &
+            src_ptr,  &
+            allocator%voidptr,  &
+            stream)
+        ! splicer end class.ResourceManager.method.move_async
+    end function resourcemanager_move_async
+
+    subroutine resourcemanager_synchronize_moves(obj)
+        class(UmpireResourceManager) :: obj
+        ! splicer begin class.ResourceManager.method.synchronize_moves
+        call c_resourcemanager_synchronize_moves(obj%voidptr)
+        ! splicer end class.ResourceManager.method.synchronize_moves
+    end subroutine resourcemanager_synchronize_moves
+
     subroutine resourcemanager_deallocate(obj, ptr)
         use iso_c_binding, only : C_PTR
         class(UmpireResourceManager) :: obj
@@ -198,6 +670,18 @@ contains
         ! splicer end class.ResourceManager.method.deallocate
     end subroutine resourcemanager_deallocate
 
+    function resourcemanager_get_size(obj, ptr) result(SH_rv)
+        use iso_c_binding, only : C_PTR, C_SIZE_T
+        class(UmpireResourceManager) :: obj
+        type(C_PTR), value, intent(IN) :: ptr
+        integer(C_SIZE_T) :: SH_rv
+        ! splicer begin class.ResourceManager.method.get_size
+        SH_rv = c_resourcemanager_get_size(  &
+            obj%voidptr,  &
+            ptr)
+        ! splicer end class.ResourceManager.method.get_size
+    end function resourcemanager_get_size
+
     function resourcemanager_get_instance(obj) result (voidptr)
         use iso_c_binding, only: C_PTR
         implicit none
@@ -248,6 +732,82 @@ contains
         ! splicer end class.Allocator.method.deallocate
     end subroutine allocator_deallocate
 
+    subroutine allocator_release(obj)
+        class(UmpireAllocator) :: obj
+        ! splicer begin class.Allocator.method.release
+        call c_allocator_release(obj%voidptr)
+        ! splicer end class.Allocator.method.release
+    end subroutine allocator_release
+
+    function allocator_get_size(obj, ptr) result(SH_rv)
+        use iso_c_binding, only : C_PTR, C_SIZE_T
+        class(UmpireAllocator) :: obj
+        type(C_PTR), value, intent(IN) :: ptr
+        integer(C_SIZE_T) :: SH_rv
+        ! splicer begin class.Allocator.method.get_size
+        SH_rv = c_allocator_get_size(  &
+            obj%voidptr,  &
+            ptr)
+        ! splicer end class.Allocator.method.get_size
+    end function allocator_get_size
+
+    function allocator_get_high_watermark(obj) result(SH_rv)
+        use iso_c_binding, only : C_SIZE_T
+        class(UmpireAllocator) :: obj
+        integer(C_SIZE_T) :: SH_rv
+        ! splicer begin class.Allocator.method.get_high_watermark
+        SH_rv = c_allocator_get_high_watermark(obj%voidptr)
+        ! splicer end class.Allocator.method.get_high_watermark
+    end function allocator_get_high_watermark
+
+    function allocator_get_current_size(obj) result(SH_rv)
+        use iso_c_binding, only : C_SIZE_T
+        class(UmpireAllocator) :: obj
+        integer(C_SIZE_T) :: SH_rv
+        ! splicer begin class.Allocator.method.get_current_size
+        SH_rv = c_allocator_get_current_size(obj%voidptr)
+        ! splicer end class.Allocator.method.get_current_size
+    end function allocator_get_current_size
+
+    function allocator_get_actual_size(obj) result(SH_rv)
+        use iso_c_binding, only : C_SIZE_T
+        class(UmpireAllocator) :: obj
+        integer(C_SIZE_T) :: SH_rv
+        ! splicer begin class.Allocator.method.get_actual_size
+        SH_rv = c_allocator_get_actual_size(obj%voidptr)
+        ! splicer end class.Allocator.method.get_actual_size
+    end function allocator_get_actual_size
+
+    function allocator_get_name(obj) result(SH_rv)
+        use iso_c_binding, only : C_INT
+        class(UmpireAllocator) :: obj
+        character(len=256) :: SH_rv
+        ! splicer begin class.Allocator.method.get_name
+        call c_allocator_get_name_bufferify(  &
+            obj%voidptr,  &
+            SH_rv,  &
+            len(SH_rv, kind=C_INT))
+        ! splicer end class.Allocator.method.get_name
+    end function allocator_get_name
+
+    function allocator_get_id(obj) result(SH_rv)
+        use iso_c_binding, only : C_INT
+        class(UmpireAllocator) :: obj
+        integer(C_INT) :: SH_rv
+        ! splicer begin class.Allocator.method.get_id
+        SH_rv = c_allocator_get_id(obj%voidptr)
+        ! splicer end class.Allocator.method.get_id
+    end function allocator_get_id
+
+    subroutine allocator_delete(obj)
+        use iso_c_binding, only : C_NULL_PTR
+        class(UmpireAllocator) :: obj
+        ! splicer begin class.Allocator.method.delete
+        call c_allocator_delete(obj%voidptr)
+        obj%voidptr = C_NULL_PTR
+        ! splicer end class.Allocator.method.delete
+    end subroutine allocator_delete
+
     function allocator_get_instance(obj) result (voidptr)
         use iso_c_binding, only: C_PTR
         implicit none
@@ -273,6 +833,177 @@ contains
     end function allocator_associated
 
     ! splicer begin class.Allocator.additional_functions
+    ! Typed allocations: each returns a pointer array of the given shape,
+    ! aligned to UMPIRE_ARRAY_ALIGNMENT bytes. Use the matching deallocate
+    ! routine, or deallocate c_loc(array), to free it.
+
+    subroutine allocator_allocate_double_array_1d(obj, array, dims)
+        use iso_c_binding, only : C_DOUBLE, C_INT, C_PTR, C_SIZE_T, c_f_pointer, c_sizeof
+        class(UmpireAllocator) :: obj
+        real(C_DOUBLE), intent(INOUT), pointer, dimension(:) :: array
+        integer(C_INT), intent(IN) :: dims(1)
+        type(C_PTR) :: data_ptr
+        data_ptr = c_allocator_allocate_aligned(  &
+            obj%voidptr,  &
+            product(int(dims, C_SIZE_T)) * c_sizeof(0.0_C_DOUBLE),  &
+            UMPIRE_ARRAY_ALIGNMENT)
+        call c_f_pointer(data_ptr, array, dims)
+    end subroutine allocator_allocate_double_array_1d
+
+    subroutine allocator_allocate_double_array_2d(obj, array, dims)
+        use iso_c_binding, only : C_DOUBLE, C_INT, C_PTR, C_SIZE_T, c_f_pointer, c_sizeof
+        class(UmpireAllocator) :: obj
+        real(C_DOUBLE), intent(INOUT), pointer, dimension(:, :) :: array
+        integer(C_INT), intent(IN) :: dims(2)
+        type(C_PTR) :: data_ptr
+        data_ptr = c_allocator_allocate_aligned(  &
+            obj%voidptr,  &
+            product(int(dims, C_SIZE_T)) * c_sizeof(0.0_C_DOUBLE),  &
+            UMPIRE_ARRAY_ALIGNMENT)
+        call c_f_pointer(data_ptr, array, dims)
+    end subroutine allocator_allocate_double_array_2d
+
+    subroutine allocator_allocate_double_array_3d(obj, array, dims)
+        use iso_c_binding, only : C_DOUBLE, C_INT, C_PTR, C_SIZE_T, c_f_pointer, c_sizeof
+        class(UmpireAllocator) :: obj
+        real(C_DOUBLE), intent(INOUT), pointer, dimension(:, :, :) :: array
+        integer(C_INT), intent(IN) :: dims(3)
+        type(C_PTR) :: data_ptr
+        data_ptr = c_allocator_allocate_aligned(  &
+            obj%voidptr,  &
+            product(int(dims, C_SIZE_T)) * c_sizeof(0.0_C_DOUBLE),  &
+            UMPIRE_ARRAY_ALIGNMENT)
+        call c_f_pointer(data_ptr, array, dims)
+    end subroutine allocator_allocate_double_array_3d
+
+    subroutine allocator_allocate_double_array_4d(obj, array, dims)
+        use iso_c_binding, only : C_DOUBLE, C_INT, C_PTR, C_SIZE_T, c_f_pointer, c_sizeof
+        class(UmpireAllocator) :: obj
+        real(C_DOUBLE), intent(INOUT), pointer, dimension(:, :, :, :) :: array
+        integer(C_INT), intent(IN) :: dims(4)
+        type(C_PTR) :: data_ptr
+        data_ptr = c_allocator_allocate_aligned(  &
+            obj%voidptr,  &
+            product(int(dims, C_SIZE_T)) * c_sizeof(0.0_C_DOUBLE),  &
+            UMPIRE_ARRAY_ALIGNMENT)
+        call c_f_pointer(data_ptr, array, dims)
+    end subroutine allocator_allocate_double_array_4d
+
+    subroutine allocator_allocate_int_array_1d(obj, array, dims)
+        use iso_c_binding, only : C_INT, C_INT, C_PTR, C_SIZE_T, c_f_pointer, c_sizeof
+        class(UmpireAllocator) :: obj
+        integer(C_INT), intent(INOUT), pointer, dimension(:) :: array
+        integer(C_INT), intent(IN) :: dims(1)
+        type(C_PTR) :: data_ptr
+        data_ptr = c_allocator_allocate_aligned(  &
+            obj%voidptr,  &
+            product(int(dims, C_SIZE_T)) * c_sizeof(0_C_INT),  &
+            UMPIRE_ARRAY_ALIGNMENT)
+        call c_f_pointer(data_ptr, array, dims)
+    end subroutine allocator_allocate_int_array_1d
+
+    subroutine allocator_allocate_int_array_2d(obj, array, dims)
+        use iso_c_binding, only : C_INT, C_INT, C_PTR, C_SIZE_T, c_f_pointer, c_sizeof
+        class(UmpireAllocator) :: obj
+        integer(C_INT), intent(INOUT), pointer, dimension(:, :) :: array
+        integer(C_INT), intent(IN) :: dims(2)
+        type(C_PTR) :: data_ptr
+        data_ptr = c_allocator_allocate_aligned(  &
+            obj%voidptr,  &
+            product(int(dims, C_SIZE_T)) * c_sizeof(0_C_INT),  &
+            UMPIRE_ARRAY_ALIGNMENT)
+        call c_f_pointer(data_ptr, array, dims)
+    end subroutine allocator_allocate_int_array_2d
+
+    subroutine allocator_allocate_int_array_3d(obj, array, dims)
+        use iso_c_binding, only : C_INT, C_INT, C_PTR, C_SIZE_T, c_f_pointer, c_sizeof
+        class(UmpireAllocator) :: obj
+        integer(C_INT), intent(INOUT), pointer, dimension(:, :, :) :: array
+        integer(C_INT), intent(IN) :: dims(3)
+        type(C_PTR) :: data_ptr
+        data_ptr = c_allocator_allocate_aligned(  &
+            obj%voidptr,  &
+            product(int(dims, C_SIZE_T)) * c_sizeof(0_C_INT),  &
+            UMPIRE_ARRAY_ALIGNMENT)
+        call c_f_pointer(data_ptr, array, dims)
+    end subroutine allocator_allocate_int_array_3d
+
+    subroutine allocator_allocate_int_array_4d(obj, array, dims)
+        use iso_c_binding, only : C_INT, C_INT, C_PTR, C_SIZE_T, c_f_pointer, c_sizeof
+        class(UmpireAllocator) :: obj
+        integer(C_INT), intent(INOUT), pointer, dimension(:, :, :, :) :: array
+        integer(C_INT), intent(IN) :: dims(4)
+        type(C_PTR) :: data_ptr
+        data_ptr = c_allocator_allocate_aligned(  &
+            obj%voidptr,  &
+            product(int(dims, C_SIZE_T)) * c_sizeof(0_C_INT),  &
+            UMPIRE_ARRAY_ALIGNMENT)
+        call c_f_pointer(data_ptr, array, dims)
+    end subroutine allocator_allocate_int_array_4d
+
+    subroutine allocator_deallocate_double_array_1d(obj, array)
+        use iso_c_binding, only : C_DOUBLE, c_loc
+        class(UmpireAllocator) :: obj
+        real(C_DOUBLE), intent(INOUT), pointer, dimension(:) :: array
+        call c_allocator_deallocate(obj%voidptr, c_loc(array))
+        nullify(array)
+    end subroutine allocator_deallocate_double_array_1d
+
+    subroutine allocator_deallocate_double_array_2d(obj, array)
+        use iso_c_binding, only : C_DOUBLE, c_loc
+        class(UmpireAllocator) :: obj
+        real(C_DOUBLE), intent(INOUT), pointer, dimension(:, :) :: array
+        call c_allocator_deallocate(obj%voidptr, c_loc(array))
+        nullify(array)
+    end subroutine allocator_deallocate_double_array_2d
+
+    subroutine allocator_deallocate_double_array_3d(obj, array)
+        use iso_c_binding, only : C_DOUBLE, c_loc
+        class(UmpireAllocator) :: obj
+        real(C_DOUBLE), intent(INOUT), pointer, dimension(:, :, :) :: array
+        call c_allocator_deallocate(obj%voidptr, c_loc(array))
+        nullify(array)
+    end subroutine allocator_deallocate_double_array_3d
+
+    subroutine allocator_deallocate_double_array_4d(obj, array)
+        use iso_c_binding, only : C_DOUBLE, c_loc
+        class(UmpireAllocator) :: obj
+        real(C_DOUBLE), intent(INOUT), pointer, dimension(:, :, :, :) :: array
+        call c_allocator_deallocate(obj%voidptr, c_loc(array))
+        nullify(array)
+    end subroutine allocator_deallocate_double_array_4d
+
+    subroutine allocator_deallocate_int_array_1d(obj, array)
+        use iso_c_binding, only : C_INT, c_loc
+        class(UmpireAllocator) :: obj
+        integer(C_INT), intent(INOUT), pointer, dimension(:) :: array
+        call c_allocator_deallocate(obj%voidptr, c_loc(array))
+        nullify(array)
+    end subroutine allocator_deallocate_int_array_1d
+
+    subroutine allocator_deallocate_int_array_2d(obj, array)
+        use iso_c_binding, only : C_INT, c_loc
+        class(UmpireAllocator) :: obj
+        integer(C_INT), intent(INOUT), pointer, dimension(:, :) :: array
+        call c_allocator_deallocate(obj%voidptr, c_loc(array))
+        nullify(array)
+    end subroutine allocator_deallocate_int_array_2d
+
+    subroutine allocator_deallocate_int_array_3d(obj, array)
+        use iso_c_binding, only : C_INT, c_loc
+        class(UmpireAllocator) :: obj
+        integer(C_INT), intent(INOUT), pointer, dimension(:, :, :) :: array
+        call c_allocator_deallocate(obj%voidptr, c_loc(array))
+        nullify(array)
+    end subroutine allocator_deallocate_int_array_3d
+
+    subroutine allocator_deallocate_int_array_4d(obj, array)
+        use iso_c_binding, only : C_INT, c_loc
+        class(UmpireAllocator) :: obj
+        integer(C_INT), intent(INOUT), pointer, dimension(:, :, :, :) :: array
+        call c_allocator_deallocate(obj%voidptr, c_loc(array))
+        nullify(array)
+    end subroutine allocator_deallocate_int_array_4d
     ! splicer end class.Allocator.additional_functions
 
     function resourcemanager_eq(a,b) result (rv)
@@ -0,0 +1,364 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+/*
+ * Preloadable replacements for the C allocation functions that route
+ * malloc, calloc, realloc, free and the aligned variants to an Umpire
+ * Allocator:
+ *
+ *   LD_PRELOAD=libumpire_malloc.so ./legacy_app
+ *
+ * UMPIRE_MALLOC_ALLOCATOR names the Allocator to use, for example one
+ * defined by the file named in UMPIRE_CONFIG. Without it, a
+ * ThreadCachingAllocator over a SizeClassPool over HOST is made. Allocators
+ * that are not thread-safe are wrapped in a ThreadSafeAllocator.
+ *
+ * Umpire allocates memory for its own bookkeeping, and HOST gets its memory
+ * from malloc, so every call into Umpire marks the calling thread; any
+ * allocation made while the thread is marked goes to glibc. Memory is also
+ * taken from glibc until this library's constructor has run, which is after
+ * the constructors of Umpire itself, whenever Umpire fails, and for aligned
+ * requests beyond malloc's own alignment. free and realloc ask the
+ * ResourceManager whether it knows the pointer and hand anything else back
+ * to glibc.
+ */
+#include "umpire/ResourceManager.hpp"
+#include "umpire/Allocator.hpp"
+
+#include "umpire/strategy/SizeClassPool.hpp"
+#include "umpire/strategy/ThreadCachingAllocator.hpp"
+#include "umpire/strategy/ThreadSafeAllocator.hpp"
+
+#include "umpire/util/Macros.hpp"
+
+#include <dlfcn.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+extern "C" {
+void* __libc_malloc(size_t bytes);
+void* __libc_calloc(size_t count, size_t bytes);
+void* __libc_realloc(void* ptr, size_t bytes);
+void* __libc_memalign(size_t alignment, size_t bytes);
+void __libc_free(void* ptr);
+}
+
+namespace {
+
+enum State {
+  s_unloaded,
+  s_uninitialized,
+  s_initializing,
+  s_ready,
+  s_failed
+};
+
+/*
+ * Alignment malloc guarantees, which every Allocator is assumed to meet.
+ * Larger alignments are rare and not every Allocator can meet them without
+ * throwing, so they go straight to glibc.
+ */
+const size_t s_malloc_alignment = 2 * sizeof(void*);
+
+std::atomic<int> s_state(s_unloaded);
+umpire::Allocator* s_allocator = nullptr;
+
+/*
+ * Set while the thread is inside Umpire. Initial-exec TLS is reached
+ * without calling __tls_get_addr, which may itself allocate.
+ */
+thread_local bool t_in_umpire __attribute__((tls_model("initial-exec"))) = false;
+
+class Reentry
+{
+  public:
+    Reentry() { t_in_umpire = true; }
+    ~Reentry() { t_in_umpire = false; }
+};
+
+__attribute__((constructor))
+void loaded()
+{
+  int expected = s_unloaded;
+  s_state.compare_exchange_strong(expected, s_uninitialized);
+}
+
+umpire::Allocator makeAllocator(umpire::ResourceManager& rm)
+{
+  const char* name = std::getenv("UMPIRE_MALLOC_ALLOCATOR");
+
+  umpire::Allocator allocator = (name && *name) ?
+    rm.getAllocator(name) :
+    rm.makeAllocator<umpire::strategy::ThreadCachingAllocator>(
+        "UMPIRE_MALLOC",
+        rm.makeAllocator<umpire::strategy::SizeClassPool>(
+          "UMPIRE_MALLOC::pool", rm.getAllocator("HOST")));
+
+  if (!allocator.getAllocationStrategy()->isThreadSafe()) {
+    allocator = rm.makeAllocator<umpire::strategy::ThreadSafeAllocator>(
+        allocator.getName() + "::malloc", allocator);
+  }
+
+  return allocator;
+}
+
+/*
+ * Return the Allocator to route to, making it on first use, or nullptr if
+ * memory should come from glibc. Called with the thread marked.
+ */
+umpire::Allocator* getAllocator()
+{
+  int state = s_state.load(std::memory_order_acquire);
+
+  if (state == s_uninitialized
+      && s_state.compare_exchange_strong(state, s_initializing)) {
+    try {
+      s_allocator = new umpire::Allocator(
+          makeAllocator(umpire::ResourceManager::getInstance()));
+      state = s_ready;
+    } catch (...) {
+      UMPIRE_LOG(Error, "Cannot make the Allocator for malloc, using the system malloc");
+      state = s_failed;
+    }
+
+    s_state.store(state, std::memory_order_release);
+  }
+
+  return (state == s_ready) ? s_allocator : nullptr;
+}
+
+bool isReady()
+{
+  return s_state.load(std::memory_order_acquire) == s_ready;
+}
+
+/*
+ * Allocate from Umpire, falling back to glibc if it throws. Called with the
+ * thread marked.
+ */
+void* allocate(size_t bytes, size_t alignment)
+{
+  if (alignment > s_malloc_alignment) {
+    return __libc_memalign(alignment, bytes);
+  }
+
+  umpire::Allocator* allocator = getAllocator();
+
+  if (allocator) {
+    try {
+      // Every allocation, even an empty one, needs a pointer of its own.
+      return allocator->allocate(std::max<size_t>(bytes, 1));
+    } catch (...) {
+    }
+  }
+
+  return __libc_malloc(bytes);
+}
+
+bool isValidAlignment(size_t alignment)
+{
+  return alignment != 0 && (alignment & (alignment - 1)) == 0;
+}
+
+} // end of anonymous namespace
+
+extern "C" {
+
+void* malloc(size_t bytes) noexcept
+{
+  if (t_in_umpire) {
+    return __libc_malloc(bytes);
+  }
+
+  Reentry reentry;
+  return allocate(bytes, s_malloc_alignment);
+}
+
+void* calloc(size_t count, size_t bytes) noexcept
+{
+  if (t_in_umpire) {
+    return __libc_calloc(count, bytes);
+  }
+
+  if (bytes != 0 && count > static_cast<size_t>(-1) / bytes) {
+    errno = ENOMEM;
+    return nullptr;
+  }
+
+  Reentry reentry;
+  void* ret = allocate(count * bytes, s_malloc_alignment);
+
+  if (ret) {
+    std::memset(ret, 0, count * bytes);
+  }
+
+  return ret;
+}
+
+void free(void* ptr) noexcept
+{
+  if (!ptr) {
+    return;
+  }
+
+  if (t_in_umpire || !isReady()) {
+    __libc_free(ptr);
+    return;
+  }
+
+  Reentry reentry;
+
+  try {
+    auto& rm = umpire::ResourceManager::getInstance();
+
+    if (rm.hasAllocator(ptr)) {
+      rm.deallocate(ptr);
+      return;
+    }
+  } catch (...) {
+    UMPIRE_LOG(Error, "Cannot free " << ptr);
+    return;
+  }
+
+  __libc_free(ptr);
+}
+
+void* realloc(void* ptr, size_t bytes) noexcept
+{
+  if (!ptr) {
+    return malloc(bytes);
+  }
+
+  if (t_in_umpire || !isReady()) {
+    return __libc_realloc(ptr, bytes);
+  }
+
+  Reentry reentry;
+
+  try {
+    auto& rm = umpire::ResourceManager::getInstance();
+
+    if (!rm.hasAllocator(ptr)) {
+      return __libc_realloc(ptr, bytes);
+    }
+
+    if (bytes == 0) {
+      rm.deallocate(ptr);
+      return nullptr;
+    }
+
+    const size_t old_bytes = rm.getSize(ptr);
+    void* ret = allocate(bytes, s_malloc_alignment);
+
+    if (ret) {
+      std::memcpy(ret, ptr, std::min(old_bytes, bytes));
+      rm.deallocate(ptr);
+    }
+
+    return ret;
+  } catch (...) {
+    UMPIRE_LOG(Error, "Cannot reallocate " << ptr);
+    errno = ENOMEM;
+    return nullptr;
+  }
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t bytes) noexcept
+{
+  if (!isValidAlignment(alignment) || alignment % sizeof(void*) != 0) {
+    return EINVAL;
+  }
+
+  void* ret = nullptr;
+
+  if (t_in_umpire) {
+    ret = __libc_memalign(alignment, bytes);
+  } else {
+    Reentry reentry;
+    ret = allocate(bytes, alignment);
+  }
+
+  if (!ret) {
+    return ENOMEM;
+  }
+
+  *ptr = ret;
+  return 0;
+}
+
+void* aligned_alloc(size_t alignment, size_t bytes) noexcept
+{
+  if (!isValidAlignment(alignment)) {
+    errno = EINVAL;
+    return nullptr;
+  }
+
+  if (t_in_umpire) {
+    return __libc_memalign(alignment, bytes);
+  }
+
+  Reentry reentry;
+  return allocate(bytes, alignment);
+}
+
+void* memalign(size_t alignment, size_t bytes) noexcept
+{
+  return aligned_alloc(alignment, bytes);
+}
+
+/*
+ * glibc reads the size from the chunk header it keeps in front of its own
+ * allocations, which Umpire's do not have.
+ */
+size_t malloc_usable_size(void* ptr) noexcept
+{
+  typedef size_t (*UsableSize)(void*);
+  static std::atomic<UsableSize> s_usable_size(nullptr);
+
+  if (!ptr) {
+    return 0;
+  }
+
+  if (!t_in_umpire && isReady()) {
+    Reentry reentry;
+
+    try {
+      auto& rm = umpire::ResourceManager::getInstance();
+
+      if (rm.hasAllocator(ptr)) {
+        return rm.getSize(ptr);
+      }
+    } catch (...) {
+      return 0;
+    }
+  }
+
+  UsableSize usable_size = s_usable_size.load(std::memory_order_acquire);
+
+  if (!usable_size) {
+    const bool in_umpire = t_in_umpire;
+    t_in_umpire = true;
+    usable_size = reinterpret_cast<UsableSize>(::dlsym(RTLD_NEXT, "malloc_usable_size"));
+    t_in_umpire = in_umpire;
+    s_usable_size.store(usable_size, std::memory_order_release);
+  }
+
+  return usable_size ? usable_size(ptr) : 0;
+}
+
+} // extern "C"
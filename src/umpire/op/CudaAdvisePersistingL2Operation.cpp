@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/CudaAdvisePersistingL2Operation.hpp"
+
+#include <algorithm>
+
+#include <cuda_runtime_api.h>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+void
+CudaAdvisePersistingL2Operation::apply(
+    void* src_ptr,
+    util::AllocationRecord* src_allocation,
+    int val,
+    size_t length)
+{
+  applyAsync(src_ptr, src_allocation, val, length, nullptr);
+}
+
+void
+CudaAdvisePersistingL2Operation::applyAsync(
+    void* src_ptr,
+    util::AllocationRecord* UMPIRE_UNUSED_ARG(src_allocation),
+    int val,
+    size_t length,
+    void* stream)
+{
+  int device = val;
+  cudaError_t error;
+
+  if (device == cudaCpuDeviceId) {
+    ::cudaGetDevice(&device);
+  }
+
+  cudaDeviceProp properties;
+  error = ::cudaGetDeviceProperties(&properties, device);
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaGetDeviceProperties( device = " << device << "),"
+        << " failed with error: "
+        << cudaGetErrorString(error));
+  }
+
+  if (properties.persistingL2CacheMaxSize <= 0
+      || properties.accessPolicyMaxWindowSize <= 0) {
+    return;
+  }
+
+  const size_t window = std::min(length,
+      static_cast<size_t>(properties.accessPolicyMaxWindowSize));
+
+  size_t set_aside = 0;
+  error = ::cudaDeviceGetLimit(&set_aside, cudaLimitPersistingL2CacheSize);
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaDeviceGetLimit( cudaLimitPersistingL2CacheSize ) failed with error: "
+        << cudaGetErrorString(error));
+  }
+
+  if (set_aside < window) {
+    set_aside = std::min(window,
+        static_cast<size_t>(properties.persistingL2CacheMaxSize));
+
+    error = ::cudaDeviceSetLimit(cudaLimitPersistingL2CacheSize, set_aside);
+
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaDeviceSetLimit( cudaLimitPersistingL2CacheSize, " << set_aside
+          << " ) failed with error: " << cudaGetErrorString(error));
+    }
+  }
+
+  cudaStreamAttrValue attribute;
+  attribute.accessPolicyWindow.base_ptr = src_ptr;
+  attribute.accessPolicyWindow.num_bytes = window;
+  attribute.accessPolicyWindow.hitRatio = window > 0 ?
+    std::min(1.0f, static_cast<float>(set_aside) / static_cast<float>(window)) : 0.0f;
+  attribute.accessPolicyWindow.hitProp = cudaAccessPropertyPersisting;
+  attribute.accessPolicyWindow.missProp = cudaAccessPropertyStreaming;
+
+  error = ::cudaStreamSetAttribute(static_cast<cudaStream_t>(stream),
+      cudaStreamAttributeAccessPolicyWindow, &attribute);
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaStreamSetAttribute( src_ptr = " << src_ptr
+      << ", length = " << window
+      << ", stream = " << stream
+      << ", cudaStreamAttributeAccessPolicyWindow ) failed with error: "
+      << cudaGetErrorString(error));
+  }
+}
+
+} // end of namespace op
+} // end of namespace umpire
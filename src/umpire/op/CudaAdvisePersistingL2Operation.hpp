@@ -0,0 +1,70 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CudaAdvisePersistingL2Operation_HPP
+#define UMPIRE_CudaAdvisePersistingL2Operation_HPP
+
+#include "umpire/op/MemoryOperation.hpp"
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Keep device data resident in the L2 cache for kernels on a stream.
+ *
+ * Sets the stream's access policy window to the range, with hits marked
+ * persisting and misses streaming. The device's L2 set-aside for persisting
+ * accesses is grown to fit the range, up to the largest the device allows,
+ * and the hit ratio is lowered when the range is larger than the set-aside.
+ * A stream has one window, so advising another range replaces it.
+ *
+ * Devices without persisting L2 support (before compute capability 8.0)
+ * ignore the advice.
+ */
+class CudaAdvisePersistingL2Operation :
+  public MemoryOperation {
+public:
+  /*!
+   * @copybrief MemoryOperation::apply
+   *
+   * Sets the window on the default stream of device val.
+   *
+   * @copydetails MemoryOperation::apply
+   */
+    void apply(
+        void* src_ptr,
+        util::AllocationRecord *src_allocation,
+        int val,
+        size_t length);
+
+  /*!
+   * @copybrief MemoryOperation::applyAsync
+   *
+   * Sets the window on the given cudaStream_t, for kernels launched on it
+   * afterwards.
+   *
+   * @copydetails MemoryOperation::applyAsync
+   */
+    void applyAsync(
+        void* src_ptr,
+        util::AllocationRecord *src_allocation,
+        int val,
+        size_t length,
+        void* stream);
+};
+
+} // end of namespace op
+} // end of namespace umpire
+
+#endif // UMPIRE_CudaAdvisePersistingL2Operation_HPP
@@ -0,0 +1,411 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/CudaCompressedCopyOperation.hpp"
+
+#include <lz4.h>
+#include <nvcomp/lz4.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "umpire/alloc/CudaMallocAllocator.hpp"
+#include "umpire/alloc/CudaPinnedAllocator.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+namespace {
+
+// Below this many chunks per thread, starting a thread costs more than it saves.
+const std::size_t s_min_chunks_per_thread = 16;
+
+const unsigned int s_max_threads = 8;
+
+// The arrays in Scratch::host_tables and Scratch::device_tables.
+enum Table {
+  input_ptrs,
+  output_ptrs,
+  input_bytes,
+  output_bytes,
+  actual_bytes,
+  statuses,
+  num_tables
+};
+
+template <typename T>
+T* table(void* tables, Table index, std::size_t chunks)
+{
+  return reinterpret_cast<T*>(
+      static_cast<char*>(tables) + index*chunks*sizeof(void*));
+}
+
+// nvCOMP reads and writes compressed chunks on 8-byte boundaries.
+std::size_t align(std::size_t bytes)
+{
+  return (bytes + 7) & ~static_cast<std::size_t>(7);
+}
+
+void check(cudaError_t error, const char* call)
+{
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR(call << " failed with error: " << cudaGetErrorString(error));
+  }
+}
+
+void check(nvcompStatus_t status, const char* call)
+{
+  if (status != nvcompSuccess) {
+    UMPIRE_ERROR(call << " failed with status " << static_cast<int>(status));
+  }
+}
+
+// Replace buffer with a larger one if it holds fewer than bytes.
+template <typename Allocator>
+void grow(Allocator& allocator, void*& buffer, std::size_t& capacity,
+    std::size_t bytes)
+{
+  if (bytes > capacity) {
+    if (buffer) {
+      allocator.deallocate(buffer);
+    }
+
+    buffer = nullptr;
+    capacity = 0;
+
+    buffer = allocator.allocate(bytes);
+    capacity = bytes;
+  }
+}
+
+/*
+ * Call function(i) for each chunk i, spread over a few threads. Returns
+ * false if any call returned false.
+ */
+template <typename Function>
+bool forEachChunk(std::size_t chunks, Function function)
+{
+  const unsigned int hardware_threads =
+    std::max(std::thread::hardware_concurrency(), 1u);
+  const std::size_t num_threads = std::max<std::size_t>(1,
+      std::min<std::size_t>(std::min(hardware_threads, s_max_threads),
+        chunks / s_min_chunks_per_thread));
+
+  std::atomic<bool> succeeded{true};
+
+  auto work = [&](std::size_t first) {
+    for (std::size_t i = first; i < chunks; i += num_threads) {
+      if (!function(i)) {
+        succeeded = false;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+
+  for (std::size_t t = 0; t < num_threads - 1; ++t) {
+    threads.push_back(std::thread(work, t));
+  }
+
+  work(num_threads - 1);
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  return succeeded;
+}
+
+} // end of anonymous namespace
+
+const std::size_t CudaCompressedCopyOperation::s_min_length;
+const std::size_t CudaCompressedCopyOperation::s_chunk_size;
+
+CudaCompressedCopyOperation::CudaCompressedCopyOperation(cudaMemcpyKind kind) :
+  m_kind(kind),
+  m_scratch(),
+  m_mutex()
+{
+}
+
+CudaCompressedCopyOperation::~CudaCompressedCopyOperation()
+{
+  alloc::CudaMallocAllocator device_allocator;
+  alloc::CudaPinnedAllocator pinned_allocator;
+
+  for (auto& entry : m_scratch) {
+    Scratch& scratch = entry.second;
+
+    if (scratch.device_data) device_allocator.deallocate(scratch.device_data);
+    if (scratch.device_temp) device_allocator.deallocate(scratch.device_temp);
+    if (scratch.device_tables) device_allocator.deallocate(scratch.device_tables);
+    if (scratch.host_data) pinned_allocator.deallocate(scratch.host_data);
+    if (scratch.host_tables) pinned_allocator.deallocate(scratch.host_tables);
+  }
+}
+
+void CudaCompressedCopyOperation::transform(
+    void* src_ptr,
+    void** dst_ptr,
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(src_allocation),
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(dst_allocation),
+    size_t length)
+{
+  char* dst = static_cast<char*>(*dst_ptr);
+  const char* src = static_cast<const char*>(src_ptr);
+
+  if (length < s_min_length) {
+    check(::cudaMemcpy(dst, src, length, m_kind), "cudaMemcpy");
+  } else {
+    // Compress and decompress on the device that holds the GPU side.
+    const void* device_ptr = (m_kind == cudaMemcpyHostToDevice) ? *dst_ptr : src_ptr;
+
+    cudaPointerAttributes attributes;
+    check(::cudaPointerGetAttributes(&attributes, device_ptr),
+        "cudaPointerGetAttributes");
+
+    int previous_device;
+    check(::cudaGetDevice(&previous_device), "cudaGetDevice");
+    check(::cudaSetDevice(attributes.device), "cudaSetDevice");
+
+    try {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      Scratch& scratch = m_scratch[attributes.device];
+
+      if (m_kind == cudaMemcpyHostToDevice) {
+        copyToDevice(scratch, dst, src, length);
+      } else {
+        copyFromDevice(scratch, dst, src, length);
+      }
+    } catch (...) {
+      ::cudaSetDevice(previous_device);
+      throw;
+    }
+
+    check(::cudaSetDevice(previous_device), "cudaSetDevice");
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaCompressedCopyOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "dst_ptr", reinterpret_cast<uintptr_t>(dst_ptr),
+      "size", length,
+      "event", "copy_compressed");
+}
+
+void CudaCompressedCopyOperation::reserve(Scratch& scratch,
+    std::size_t data_bytes, std::size_t temp_bytes, std::size_t chunks)
+{
+  alloc::CudaMallocAllocator device_allocator;
+  alloc::CudaPinnedAllocator pinned_allocator;
+
+  const std::size_t tables_bytes = num_tables*chunks*sizeof(void*);
+
+  grow(device_allocator, scratch.device_data, scratch.device_data_bytes, data_bytes);
+  grow(device_allocator, scratch.device_temp, scratch.device_temp_bytes, temp_bytes);
+  grow(device_allocator, scratch.device_tables, scratch.device_tables_bytes, tables_bytes);
+  grow(pinned_allocator, scratch.host_data, scratch.host_data_bytes, data_bytes);
+  grow(pinned_allocator, scratch.host_tables, scratch.host_tables_bytes, tables_bytes);
+}
+
+void CudaCompressedCopyOperation::copyToDevice(Scratch& scratch,
+    char* dst, const char* src, std::size_t length)
+{
+  const std::size_t chunks = (length + s_chunk_size - 1) / s_chunk_size;
+  const std::size_t bound = align(
+      LZ4_compressBound(static_cast<int>(s_chunk_size)));
+
+  std::size_t temp_bytes = 0;
+  check(nvcompBatchedLZ4DecompressGetTempSize(chunks, s_chunk_size, &temp_bytes),
+      "nvcompBatchedLZ4DecompressGetTempSize");
+
+  reserve(scratch, chunks*bound, temp_bytes, chunks);
+
+  char* host_data = static_cast<char*>(scratch.host_data);
+  char* device_data = static_cast<char*>(scratch.device_data);
+  void* host_tables = scratch.host_tables;
+  void* device_tables = scratch.device_tables;
+
+  const void** compressed_ptrs = table<const void*>(host_tables, input_ptrs, chunks);
+  void** uncompressed_ptrs = table<void*>(host_tables, output_ptrs, chunks);
+  std::size_t* compressed_bytes = table<std::size_t>(host_tables, input_bytes, chunks);
+  std::size_t* uncompressed_bytes = table<std::size_t>(host_tables, output_bytes, chunks);
+
+  // Each chunk is compressed into a slot of its own, then packed.
+  const bool compressed = forEachChunk(chunks, [&](std::size_t i) {
+      const std::size_t offset = i*s_chunk_size;
+      const int bytes = static_cast<int>(std::min(s_chunk_size, length - offset));
+
+      const int result = LZ4_compress_default(src + offset,
+          host_data + i*bound, bytes, static_cast<int>(bound));
+
+      uncompressed_bytes[i] = bytes;
+      compressed_bytes[i] = (result > 0) ? result : 0;
+      return result > 0;
+  });
+
+  if (!compressed) {
+    UMPIRE_ERROR("LZ4_compress_default failed to compress " << length << " bytes");
+  }
+
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < chunks; ++i) {
+    if (total != i*bound) {
+      std::memmove(host_data + total, host_data + i*bound, compressed_bytes[i]);
+    }
+
+    compressed_ptrs[i] = device_data + total;
+    uncompressed_ptrs[i] = dst + i*s_chunk_size;
+    total += align(compressed_bytes[i]);
+  }
+
+  if (total > length - length/4) {
+    check(::cudaMemcpy(dst, src, length, cudaMemcpyHostToDevice), "cudaMemcpy");
+    return;
+  }
+
+  check(::cudaMemcpyAsync(device_data, host_data, total,
+        cudaMemcpyHostToDevice, 0), "cudaMemcpyAsync");
+  check(::cudaMemcpyAsync(device_tables, host_tables,
+        actual_bytes*chunks*sizeof(void*), cudaMemcpyHostToDevice, 0),
+      "cudaMemcpyAsync");
+
+  check(nvcompBatchedLZ4DecompressAsync(
+        table<const void* const>(device_tables, input_ptrs, chunks),
+        table<const std::size_t>(device_tables, input_bytes, chunks),
+        table<const std::size_t>(device_tables, output_bytes, chunks),
+        table<std::size_t>(device_tables, actual_bytes, chunks),
+        chunks,
+        scratch.device_temp,
+        temp_bytes,
+        table<void* const>(device_tables, output_ptrs, chunks),
+        table<nvcompStatus_t>(device_tables, statuses, chunks),
+        0),
+      "nvcompBatchedLZ4DecompressAsync");
+
+  nvcompStatus_t* host_statuses = table<nvcompStatus_t>(host_tables, statuses, chunks);
+
+  check(::cudaMemcpyAsync(host_statuses,
+        table<nvcompStatus_t>(device_tables, statuses, chunks),
+        chunks*sizeof(nvcompStatus_t), cudaMemcpyDeviceToHost, 0),
+      "cudaMemcpyAsync");
+  check(::cudaStreamSynchronize(0), "cudaStreamSynchronize");
+
+  for (std::size_t i = 0; i < chunks; ++i) {
+    if (host_statuses[i] != nvcompSuccess) {
+      UMPIRE_ERROR("nvCOMP failed to decompress chunk " << i << " with status "
+          << static_cast<int>(host_statuses[i]));
+    }
+  }
+}
+
+void CudaCompressedCopyOperation::copyFromDevice(Scratch& scratch,
+    char* dst, const char* src, std::size_t length)
+{
+  const std::size_t chunks = (length + s_chunk_size - 1) / s_chunk_size;
+
+  std::size_t bound = 0;
+  check(nvcompBatchedLZ4CompressGetMaxOutputChunkSize(s_chunk_size,
+        nvcompBatchedLZ4DefaultOpts, &bound),
+      "nvcompBatchedLZ4CompressGetMaxOutputChunkSize");
+  bound = align(bound);
+
+  std::size_t temp_bytes = 0;
+  check(nvcompBatchedLZ4CompressGetTempSize(chunks, s_chunk_size,
+        nvcompBatchedLZ4DefaultOpts, &temp_bytes),
+      "nvcompBatchedLZ4CompressGetTempSize");
+
+  reserve(scratch, chunks*bound, temp_bytes, chunks);
+
+  char* host_data = static_cast<char*>(scratch.host_data);
+  char* device_data = static_cast<char*>(scratch.device_data);
+  void* host_tables = scratch.host_tables;
+  void* device_tables = scratch.device_tables;
+
+  const void** uncompressed_ptrs = table<const void*>(host_tables, input_ptrs, chunks);
+  void** compressed_ptrs = table<void*>(host_tables, output_ptrs, chunks);
+  std::size_t* uncompressed_bytes = table<std::size_t>(host_tables, input_bytes, chunks);
+  std::size_t* compressed_bytes = table<std::size_t>(host_tables, output_bytes, chunks);
+  std::size_t* offsets = table<std::size_t>(host_tables, actual_bytes, chunks);
+
+  // Each chunk is compressed into a slot of its own on the device.
+  for (std::size_t i = 0; i < chunks; ++i) {
+    const std::size_t offset = i*s_chunk_size;
+
+    uncompressed_ptrs[i] = src + offset;
+    compressed_ptrs[i] = device_data + i*bound;
+    uncompressed_bytes[i] = std::min(s_chunk_size, length - offset);
+  }
+
+  check(::cudaMemcpyAsync(device_tables, host_tables,
+        output_bytes*chunks*sizeof(void*), cudaMemcpyHostToDevice, 0),
+      "cudaMemcpyAsync");
+
+  check(nvcompBatchedLZ4CompressAsync(
+        table<const void* const>(device_tables, input_ptrs, chunks),
+        table<const std::size_t>(device_tables, input_bytes, chunks),
+        s_chunk_size,
+        chunks,
+        scratch.device_temp,
+        temp_bytes,
+        table<void* const>(device_tables, output_ptrs, chunks),
+        table<std::size_t>(device_tables, output_bytes, chunks),
+        nvcompBatchedLZ4DefaultOpts,
+        0),
+      "nvcompBatchedLZ4CompressAsync");
+
+  check(::cudaMemcpyAsync(compressed_bytes,
+        table<std::size_t>(device_tables, output_bytes, chunks),
+        chunks*sizeof(std::size_t), cudaMemcpyDeviceToHost, 0),
+      "cudaMemcpyAsync");
+  check(::cudaStreamSynchronize(0), "cudaStreamSynchronize");
+
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < chunks; ++i) {
+    offsets[i] = total;
+    total += compressed_bytes[i];
+  }
+
+  if (total > length - length/4) {
+    check(::cudaMemcpy(dst, src, length, cudaMemcpyDeviceToHost), "cudaMemcpy");
+    return;
+  }
+
+  // Only the compressed bytes of each slot cross the bus.
+  for (std::size_t i = 0; i < chunks; ++i) {
+    check(::cudaMemcpyAsync(host_data + offsets[i], device_data + i*bound,
+          compressed_bytes[i], cudaMemcpyDeviceToHost, 0),
+        "cudaMemcpyAsync");
+  }
+  check(::cudaStreamSynchronize(0), "cudaStreamSynchronize");
+
+  const bool decompressed = forEachChunk(chunks, [&](std::size_t i) {
+      const int bytes = static_cast<int>(uncompressed_bytes[i]);
+
+      return LZ4_decompress_safe(host_data + offsets[i], dst + i*s_chunk_size,
+          static_cast<int>(compressed_bytes[i]), bytes) == bytes;
+  });
+
+  if (!decompressed) {
+    UMPIRE_ERROR("LZ4_decompress_safe failed to decompress " << length << " bytes");
+  }
+}
+
+} // end of namespace op
+} // end of namespace umpire
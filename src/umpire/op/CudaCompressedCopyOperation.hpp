@@ -0,0 +1,115 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CudaCompressedCopyOperation_HPP
+#define UMPIRE_CudaCompressedCopyOperation_HPP
+
+#include <cuda_runtime_api.h>
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+
+#include "umpire/op/MemoryOperation.hpp"
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Copy between CPU and NVIDIA GPU memory that moves LZ4-compressed
+ * data over the bus.
+ *
+ * The data is split into chunks that are compressed where they are read
+ * and decompressed where they are written: with liblz4 on the host, using
+ * several threads, and with nvCOMP's batched LZ4 on the GPU. Both produce
+ * and accept the same raw LZ4 blocks. This pays off when the bus is the
+ * bottleneck and the data compresses well, e.g. sparse or mostly constant
+ * arrays.
+ *
+ * Copies smaller than s_min_length, and data that does not shrink by at
+ * least a quarter, are copied as they are with cudaMemcpy.
+ *
+ * Registered as the "COPY_COMPRESSED" operation; see
+ * ResourceManager::copyCompressed.
+ */
+class CudaCompressedCopyOperation : public MemoryOperation {
+ public:
+  /*!
+   * \brief Copies shorter than this are not compressed.
+   */
+  static const std::size_t s_min_length = 1024 * 1024;
+
+  /*!
+   * \brief Construct a new CudaCompressedCopyOperation.
+   *
+   * \param kind cudaMemcpyHostToDevice or cudaMemcpyDeviceToHost.
+   */
+  CudaCompressedCopyOperation(cudaMemcpyKind kind);
+
+  ~CudaCompressedCopyOperation();
+
+   /*!
+    * @copybrief MemoryOperation::transform
+    *
+    * Compresses the data on the side of src_ptr, copies the compressed
+    * chunks and decompresses them into dst_ptr.
+    *
+    * @copydetails MemoryOperation::transform
+    */
+  void transform(
+      void* src_ptr,
+      void** dst_ptr,
+      umpire::util::AllocationRecord *src_allocation,
+      umpire::util::AllocationRecord *dst_allocation,
+      size_t length);
+
+ private:
+  static const std::size_t s_chunk_size = 256 * 1024;
+
+  /*
+   * Buffers reused by every copy on one device, grown as needed. Each
+   * table holds six arrays of one pointer-sized entry per chunk.
+   */
+  struct Scratch {
+    void* device_data{nullptr};
+    std::size_t device_data_bytes{0};
+    void* device_temp{nullptr};
+    std::size_t device_temp_bytes{0};
+    void* device_tables{nullptr};
+    std::size_t device_tables_bytes{0};
+    void* host_data{nullptr};
+    std::size_t host_data_bytes{0};
+    void* host_tables{nullptr};
+    std::size_t host_tables_bytes{0};
+  };
+
+  void reserve(Scratch& scratch, std::size_t data_bytes,
+      std::size_t temp_bytes, std::size_t chunks);
+
+  void copyToDevice(Scratch& scratch, char* dst, const char* src,
+      std::size_t length);
+
+  void copyFromDevice(Scratch& scratch, char* dst, const char* src,
+      std::size_t length);
+
+  cudaMemcpyKind m_kind;
+
+  std::map<int, Scratch> m_scratch;
+  std::mutex m_mutex;
+};
+
+} // end of namespace op
+} // end of namespace umpire
+
+#endif // UMPIRE_CudaCompressedCopyOperation_HPP
@@ -15,7 +15,7 @@
 #ifndef UMPIRE_CudaCopyFromOperation_HPP
 #define UMPIRE_CudaCopyFromOperation_HPP
 
-#include "umpire/op/MemoryOperation.hpp"
+#include "umpire/op/CudaStridedCopyOperation.hpp"
 
 namespace umpire {
 namespace op {
@@ -23,9 +23,10 @@ namespace op {
 /*!
  * \brief Copy operation to move data from a NVIDA GPU to CPU memory.
  */
-class CudaCopyFromOperation :
-  public MemoryOperation {
+class CudaCopyFromOperation : public CudaStridedCopyOperation {
  public:
+  CudaCopyFromOperation();
+
    /*!
     * @copybrief MemoryOperation::transform
     *
@@ -40,6 +41,54 @@ class CudaCopyFromOperation :
       util::AllocationRecord *src_allocation,
       util::AllocationRecord *dst_allocation,
       size_t length);
+
+   /*!
+    * @copybrief MemoryOperation::transformAsync
+    *
+    * Uses cudaMemcpyAsync on the given cudaStream_t.
+    *
+    * @copydetails MemoryOperation::transformAsync
+    */
+  void transformAsync(
+      void* src_ptr,
+      void** dst_ptr,
+      util::AllocationRecord *src_allocation,
+      util::AllocationRecord *dst_allocation,
+      size_t length,
+      void* stream);
+
+   /*!
+    * @copybrief MemoryOperation::transformBatch
+    *
+    * Issues every transfer with cudaMemcpyAsync on the default stream and
+    * synchronizes once at the end.
+    *
+    * @copydetails MemoryOperation::transformBatch
+    */
+  void transformBatch(
+      void** src_ptrs,
+      void** dst_ptrs,
+      util::AllocationRecord** src_allocations,
+      util::AllocationRecord** dst_allocations,
+      size_t* lengths,
+      size_t count);
+
+   /*!
+    * @copybrief MemoryOperation::transformBatchAsync
+    *
+    * Issues the transfers through the CudaCopyScheduler, on its
+    * device-to-host stream.
+    *
+    * @copydetails MemoryOperation::transformBatchAsync
+    */
+  void transformBatchAsync(
+      void** src_ptrs,
+      void** dst_ptrs,
+      umpire::util::AllocationRecord** src_allocations,
+      umpire::util::AllocationRecord** dst_allocations,
+      size_t* lengths,
+      size_t count,
+      void* stream);
 };
 
 } // end of namespace op
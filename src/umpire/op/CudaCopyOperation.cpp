@@ -21,6 +21,11 @@
 namespace umpire {
 namespace op {
 
+CudaCopyOperation::CudaCopyOperation() :
+  CudaStridedCopyOperation(cudaMemcpyDeviceToDevice)
+{
+}
+
 void CudaCopyOperation::transform(
     void* src_ptr,
     void** dst_ptr,
@@ -47,5 +52,67 @@ void CudaCopyOperation::transform(
       "event", "copy");
 }
 
+void CudaCopyOperation::transformAsync(
+    void* src_ptr,
+    void** dst_ptr,
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(src_allocation),
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(dst_allocation),
+    size_t length,
+    void* stream)
+{
+  cudaError_t error = 
+    ::cudaMemcpyAsync(*dst_ptr, src_ptr, length, cudaMemcpyDeviceToDevice,
+        static_cast<cudaStream_t>(stream));
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaMemcpyAsync( dest_ptr = " << *dst_ptr
+      << ", src_ptr = " << src_ptr
+      << ", length = " << length
+      << ", cudaMemcpyDeviceToDevice, stream = " << stream << " ) failed with error: " 
+      << cudaGetErrorString(error));
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaCopyOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "dst_ptr", reinterpret_cast<uintptr_t>(dst_ptr),
+      "size", length,
+      "event", "copy_async");
+}
+
+void CudaCopyOperation::transformBatch(
+    void** src_ptrs,
+    void** dst_ptrs,
+    umpire::util::AllocationRecord** UMPIRE_UNUSED_ARG(src_allocations),
+    umpire::util::AllocationRecord** UMPIRE_UNUSED_ARG(dst_allocations),
+    size_t* lengths,
+    size_t count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    cudaError_t error = 
+      ::cudaMemcpyAsync(dst_ptrs[i], src_ptrs[i], lengths[i], cudaMemcpyDeviceToDevice);
+
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaMemcpyAsync( dest_ptr = " << dst_ptrs[i]
+        << ", src_ptr = " << src_ptrs[i]
+        << ", length = " << lengths[i]
+        << ", cudaMemcpyDeviceToDevice ) failed with error: "
+        << cudaGetErrorString(error));
+    }
+  }
+
+  cudaError_t error = ::cudaStreamSynchronize(0);
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaStreamSynchronize failed with error: "
+      << cudaGetErrorString(error));
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaCopyOperation",
+      "count", count,
+      "event", "copy_batch");
+}
+
 } // end of namespace op
 } // end of namespace umpire
@@ -15,7 +15,7 @@
 #ifndef UMPIRE_CudaCopyOperation_HPP
 #define UMPIRE_CudaCopyOperation_HPP
 
-#include "umpire/op/MemoryOperation.hpp"
+#include "umpire/op/CudaStridedCopyOperation.hpp"
 
 namespace umpire {
 namespace op {
@@ -23,8 +23,10 @@ namespace op {
 /*!
  * \brief Copy operation to move data between two GPU addresses.
  */
-class CudaCopyOperation : public MemoryOperation {
+class CudaCopyOperation : public CudaStridedCopyOperation {
  public:
+  CudaCopyOperation();
+
    /*!
     * @copybrief MemoryOperation::transform
     *
@@ -39,6 +41,37 @@ class CudaCopyOperation : public MemoryOperation {
       umpire::util::AllocationRecord *src_allocation,
       umpire::util::AllocationRecord *dst_allocation,
       size_t length);
+
+   /*!
+    * @copybrief MemoryOperation::transformAsync
+    *
+    * Uses cudaMemcpyAsync on the given cudaStream_t.
+    *
+    * @copydetails MemoryOperation::transformAsync
+    */
+  void transformAsync(
+      void* src_ptr,
+      void** dst_ptr,
+      umpire::util::AllocationRecord *src_allocation,
+      umpire::util::AllocationRecord *dst_allocation,
+      size_t length,
+      void* stream);
+
+   /*!
+    * @copybrief MemoryOperation::transformBatch
+    *
+    * Issues every transfer with cudaMemcpyAsync on the default stream and
+    * synchronizes once at the end.
+    *
+    * @copydetails MemoryOperation::transformBatch
+    */
+  void transformBatch(
+      void** src_ptrs,
+      void** dst_ptrs,
+      umpire::util::AllocationRecord** src_allocations,
+      umpire::util::AllocationRecord** dst_allocations,
+      size_t* lengths,
+      size_t count);
 };
 
 } // end of namespace op
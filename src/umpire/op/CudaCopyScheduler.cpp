@@ -0,0 +1,182 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/CudaCopyScheduler.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+CudaCopyScheduler*
+CudaCopyScheduler::s_copy_scheduler_instance = nullptr;
+
+const std::size_t CudaCopyScheduler::s_chunk_size;
+
+namespace {
+
+void check(cudaError_t error, const char* call)
+{
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR(call << " failed with error: " << cudaGetErrorString(error));
+  }
+}
+
+} // end of anonymous namespace
+
+CudaCopyScheduler&
+CudaCopyScheduler::getInstance()
+{
+  static std::once_flag created;
+  std::call_once(created, [] {
+    s_copy_scheduler_instance = new CudaCopyScheduler();
+    UMPIRE_LOG(Debug, "() Created CudaCopyScheduler at " << s_copy_scheduler_instance);
+  });
+
+  return *s_copy_scheduler_instance;
+}
+
+CudaCopyScheduler::CudaCopyScheduler() :
+  m_devices(),
+  m_mutex(new std::mutex())
+{
+}
+
+CudaCopyScheduler::DeviceStreams&
+CudaCopyScheduler::getStreams()
+{
+  int device;
+  check(::cudaGetDevice(&device), "cudaGetDevice");
+
+  auto existing = m_devices.find(device);
+  if (existing != m_devices.end()) {
+    return existing->second;
+  }
+
+  DeviceStreams streams;
+  for (int i = 0; i < num_directions; ++i) {
+    check(::cudaStreamCreateWithFlags(&streams.streams[i], cudaStreamNonBlocking),
+        "cudaStreamCreateWithFlags");
+    check(::cudaEventCreateWithFlags(&streams.done[i], cudaEventDisableTiming),
+        "cudaEventCreateWithFlags");
+  }
+  check(::cudaEventCreateWithFlags(&streams.ready, cudaEventDisableTiming),
+      "cudaEventCreateWithFlags");
+
+  UMPIRE_LOG(Debug, "Created copy streams for device " << device);
+
+  return m_devices.insert(std::make_pair(device, streams)).first->second;
+}
+
+void
+CudaCopyScheduler::copy(
+    void** dst_ptrs,
+    void** src_ptrs,
+    const std::size_t* lengths,
+    const cudaMemcpyKind* kinds,
+    std::size_t count,
+    cudaStream_t stream)
+{
+  std::lock_guard<std::mutex> lock(*m_mutex);
+
+  DeviceStreams& device = getStreams();
+
+  // Start after whatever the caller has already queued on stream.
+  check(::cudaEventRecord(device.ready, stream), "cudaEventRecord");
+
+  std::vector<std::size_t> transfers[num_directions];
+  for (std::size_t i = 0; i < count; ++i) {
+    if (kinds[i] == cudaMemcpyHostToDevice) {
+      transfers[to_device].push_back(i);
+    } else if (kinds[i] == cudaMemcpyDeviceToHost) {
+      transfers[from_device].push_back(i);
+    } else {
+      UMPIRE_ERROR("CudaCopyScheduler cannot copy with cudaMemcpyKind " << kinds[i]);
+    }
+  }
+
+  for (int d = 0; d < num_directions; ++d) {
+    if (!transfers[d].empty()) {
+      check(::cudaStreamWaitEvent(device.streams[d], device.ready, 0),
+          "cudaStreamWaitEvent");
+    }
+  }
+
+  // Position of each direction: which transfer, and how far into it.
+  std::size_t next[num_directions] = {0, 0};
+  std::size_t offset[num_directions] = {0, 0};
+
+  bool issued = true;
+  while (issued) {
+    issued = false;
+
+    for (int d = 0; d < num_directions; ++d) {
+      if (next[d] == transfers[d].size()) {
+        continue;
+      }
+
+      const std::size_t i = transfers[d][next[d]];
+      const std::size_t bytes = std::min(s_chunk_size, lengths[i] - offset[d]);
+
+      cudaError_t error = ::cudaMemcpyAsync(
+          static_cast<char*>(dst_ptrs[i]) + offset[d],
+          static_cast<const char*>(src_ptrs[i]) + offset[d],
+          bytes, kinds[i], device.streams[d]);
+
+      if (error != cudaSuccess) {
+        UMPIRE_ERROR("cudaMemcpyAsync( dest_ptr = " << dst_ptrs[i]
+          << ", src_ptr = " << src_ptrs[i]
+          << ", offset = " << offset[d]
+          << ", length = " << bytes
+          << " ) failed with error: "
+          << cudaGetErrorString(error));
+      }
+
+      offset[d] += bytes;
+      if (offset[d] == lengths[i]) {
+        offset[d] = 0;
+        ++next[d];
+      }
+
+      issued = true;
+    }
+  }
+
+  // Work queued on stream from here on waits for both directions.
+  for (int d = 0; d < num_directions; ++d) {
+    if (!transfers[d].empty()) {
+      check(::cudaEventRecord(device.done[d], device.streams[d]), "cudaEventRecord");
+      check(::cudaStreamWaitEvent(stream, device.done[d], 0), "cudaStreamWaitEvent");
+    }
+  }
+}
+
+void
+CudaCopyScheduler::copy(
+    void** dst_ptrs,
+    void** src_ptrs,
+    const std::size_t* lengths,
+    cudaMemcpyKind kind,
+    std::size_t count,
+    cudaStream_t stream)
+{
+  std::vector<cudaMemcpyKind> kinds(count, kind);
+  copy(dst_ptrs, src_ptrs, lengths, kinds.data(), count, stream);
+}
+
+} // end of namespace op
+} // end of namespace umpire
@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CudaCopyScheduler_HPP
+#define UMPIRE_CudaCopyScheduler_HPP
+
+#include <cuda_runtime_api.h>
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Issues host-to-device and device-to-host transfers on one stream
+ * per direction, so the GPU's two copy engines can run at once.
+ *
+ * A batch is ordered after the work already on the caller's stream, and
+ * the caller's stream then waits for the whole batch, so to the caller it
+ * behaves like a sequence of cudaMemcpyAsync calls on that stream. Inside
+ * the batch, the two directions overlap. Transfers are split into
+ * s_chunk_size chunks, issued alternately from each direction, so a huge
+ * transfer in one direction does not hold back the start of the other.
+ *
+ * Only pinned host memory gives overlap; the driver stages pageable
+ * transfers synchronously. The streams belong to the current device and
+ * are created on first use. Concurrent batches are serialized while they
+ * are issued.
+ */
+class CudaCopyScheduler {
+  public:
+    /*!
+     * \brief Transfers are issued in chunks of at most this many bytes.
+     */
+    static const std::size_t s_chunk_size = 16 * 1024 * 1024;
+
+    static CudaCopyScheduler& getInstance();
+
+    /*!
+     * \brief Copy count transfers, each in direction kinds[i], ordered on
+     * stream.
+     *
+     * \param kinds cudaMemcpyHostToDevice or cudaMemcpyDeviceToHost for
+     *        each transfer.
+     */
+    void copy(
+        void** dst_ptrs,
+        void** src_ptrs,
+        const std::size_t* lengths,
+        const cudaMemcpyKind* kinds,
+        std::size_t count,
+        cudaStream_t stream);
+
+    /*!
+     * \brief Copy count transfers that all go in direction kind.
+     */
+    void copy(
+        void** dst_ptrs,
+        void** src_ptrs,
+        const std::size_t* lengths,
+        cudaMemcpyKind kind,
+        std::size_t count,
+        cudaStream_t stream);
+
+  protected:
+    CudaCopyScheduler();
+
+    CudaCopyScheduler (const CudaCopyScheduler&) = delete;
+    CudaCopyScheduler& operator= (const CudaCopyScheduler&) = delete;
+
+  private:
+    enum Direction {
+      to_device = 0,
+      from_device,
+      num_directions
+    };
+
+    struct DeviceStreams {
+      cudaStream_t streams[num_directions];
+      cudaEvent_t done[num_directions];
+      cudaEvent_t ready;
+    };
+
+    DeviceStreams& getStreams();
+
+    static CudaCopyScheduler* s_copy_scheduler_instance;
+
+    std::unordered_map<int, DeviceStreams> m_devices;
+
+    std::mutex* m_mutex;
+};
+
+} // end of namespace op
+} // end of namespace umpire
+
+#endif // UMPIRE_CudaCopyScheduler_HPP
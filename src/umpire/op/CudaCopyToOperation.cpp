@@ -16,26 +16,66 @@
 
 #include <cuda_runtime_api.h>
 
+#include "umpire/op/CudaCopyScheduler.hpp"
+#include "umpire/op/CudaStagingCopyEngine.hpp"
+
 #include "umpire/util/Macros.hpp"
 
 namespace umpire {
 namespace op {
 
+CudaCopyToOperation::CudaCopyToOperation() :
+  CudaStridedCopyOperation(cudaMemcpyHostToDevice)
+{
+}
+
 void CudaCopyToOperation::transform(
     void* src_ptr,
     void** dst_ptr,
     umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(src_allocation),
     umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(dst_allocation),
     size_t length)
+{
+  if (length >= CudaStagingCopyEngine::s_staging_threshold) {
+    CudaStagingCopyEngine::getInstance().copyToDevice(*dst_ptr, src_ptr, length);
+  } else {
+    cudaError_t error = 
+      ::cudaMemcpy(*dst_ptr, src_ptr, length, cudaMemcpyHostToDevice);
+
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaMemcpy( dest_ptr = " << *dst_ptr
+        << ", src_ptr = " << src_ptr
+        << ", length = " << length
+        << ", cudaMemcpyHostToDevice ) failed with error: " 
+        << cudaGetErrorString(error));
+    }
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaCopyToOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "dst_ptr", reinterpret_cast<uintptr_t>(dst_ptr),
+      "size", length,
+      "event", "copy");
+}
+
+void CudaCopyToOperation::transformAsync(
+    void* src_ptr,
+    void** dst_ptr,
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(src_allocation),
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(dst_allocation),
+    size_t length,
+    void* stream)
 {
   cudaError_t error = 
-    ::cudaMemcpy(*dst_ptr, src_ptr, length, cudaMemcpyHostToDevice);
+    ::cudaMemcpyAsync(*dst_ptr, src_ptr, length, cudaMemcpyHostToDevice,
+        static_cast<cudaStream_t>(stream));
 
   if (error != cudaSuccess) {
-    UMPIRE_ERROR("cudaMemcpy( dest_ptr = " << *dst_ptr
+    UMPIRE_ERROR("cudaMemcpyAsync( dest_ptr = " << *dst_ptr
       << ", src_ptr = " << src_ptr
       << ", length = " << length
-      << ", cudaMemcpyHostToDevice ) failed with error: " 
+      << ", cudaMemcpyHostToDevice, stream = " << stream << " ) failed with error: " 
       << cudaGetErrorString(error));
   }
 
@@ -44,7 +84,59 @@ void CudaCopyToOperation::transform(
       "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
       "dst_ptr", reinterpret_cast<uintptr_t>(dst_ptr),
       "size", length,
-      "event", "copy");
+      "event", "copy_async");
+}
+
+void CudaCopyToOperation::transformBatch(
+    void** src_ptrs,
+    void** dst_ptrs,
+    umpire::util::AllocationRecord** UMPIRE_UNUSED_ARG(src_allocations),
+    umpire::util::AllocationRecord** UMPIRE_UNUSED_ARG(dst_allocations),
+    size_t* lengths,
+    size_t count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    cudaError_t error = 
+      ::cudaMemcpyAsync(dst_ptrs[i], src_ptrs[i], lengths[i], cudaMemcpyHostToDevice);
+
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaMemcpyAsync( dest_ptr = " << dst_ptrs[i]
+        << ", src_ptr = " << src_ptrs[i]
+        << ", length = " << lengths[i]
+        << ", cudaMemcpyHostToDevice ) failed with error: "
+        << cudaGetErrorString(error));
+    }
+  }
+
+  cudaError_t error = ::cudaStreamSynchronize(0);
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaStreamSynchronize failed with error: "
+      << cudaGetErrorString(error));
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaCopyToOperation",
+      "count", count,
+      "event", "copy_batch");
+}
+
+void CudaCopyToOperation::transformBatchAsync(
+    void** src_ptrs,
+    void** dst_ptrs,
+    umpire::util::AllocationRecord** UMPIRE_UNUSED_ARG(src_allocations),
+    umpire::util::AllocationRecord** UMPIRE_UNUSED_ARG(dst_allocations),
+    size_t* lengths,
+    size_t count,
+    void* stream)
+{
+  CudaCopyScheduler::getInstance().copy(dst_ptrs, src_ptrs, lengths,
+      cudaMemcpyHostToDevice, count, static_cast<cudaStream_t>(stream));
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaCopyToOperation",
+      "count", count,
+      "event", "copy_batch_async");
 }
 
 } // end of namespace op
@@ -15,7 +15,7 @@
 #ifndef UMPIRE_CudaCopyToOperation_HPP
 #define UMPIRE_CudaCopyToOperation_HPP
 
-#include "umpire/op/MemoryOperation.hpp"
+#include "umpire/op/CudaStridedCopyOperation.hpp"
 
 namespace umpire {
 namespace op {
@@ -23,8 +23,10 @@ namespace op {
 /*!
  * \brief Copy operation to move data from CPU to NVIDIA GPU memory.
  */
-class CudaCopyToOperation : public MemoryOperation {
+class CudaCopyToOperation : public CudaStridedCopyOperation {
  public:
+  CudaCopyToOperation();
+
    /*!
     * @copybrief MemoryOperation::transform
     *
@@ -39,6 +41,54 @@ class CudaCopyToOperation : public MemoryOperation {
       umpire::util::AllocationRecord *src_allocation,
       umpire::util::AllocationRecord *dst_allocation,
       size_t length);
+
+   /*!
+    * @copybrief MemoryOperation::transformAsync
+    *
+    * Uses cudaMemcpyAsync on the given cudaStream_t.
+    *
+    * @copydetails MemoryOperation::transformAsync
+    */
+  void transformAsync(
+      void* src_ptr,
+      void** dst_ptr,
+      umpire::util::AllocationRecord *src_allocation,
+      umpire::util::AllocationRecord *dst_allocation,
+      size_t length,
+      void* stream);
+
+   /*!
+    * @copybrief MemoryOperation::transformBatch
+    *
+    * Issues every transfer with cudaMemcpyAsync on the default stream and
+    * synchronizes once at the end.
+    *
+    * @copydetails MemoryOperation::transformBatch
+    */
+  void transformBatch(
+      void** src_ptrs,
+      void** dst_ptrs,
+      umpire::util::AllocationRecord** src_allocations,
+      umpire::util::AllocationRecord** dst_allocations,
+      size_t* lengths,
+      size_t count);
+
+   /*!
+    * @copybrief MemoryOperation::transformBatchAsync
+    *
+    * Issues the transfers through the CudaCopyScheduler, on its
+    * host-to-device stream.
+    *
+    * @copydetails MemoryOperation::transformBatchAsync
+    */
+  void transformBatchAsync(
+      void** src_ptrs,
+      void** dst_ptrs,
+      umpire::util::AllocationRecord** src_allocations,
+      umpire::util::AllocationRecord** dst_allocations,
+      size_t* lengths,
+      size_t count,
+      void* stream);
 };
 
 } // end of namespace op
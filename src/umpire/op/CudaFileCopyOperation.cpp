@@ -0,0 +1,172 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/CudaFileCopyOperation.hpp"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(UMPIRE_ENABLE_GDS)
+#include <cufile.h>
+#endif
+
+#include "umpire/alloc/FileAllocator.hpp"
+#include "umpire/strategy/AllocationStrategy.hpp"
+#include "umpire/util/AllocationRecord.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+namespace {
+
+/*
+ * Page-aligned range covering [ptr, ptr + length), for madvise and msync.
+ */
+void pageRange(void* ptr, size_t length, void*& start, size_t& range_length)
+{
+  const uintptr_t page_size = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+  const uintptr_t first = reinterpret_cast<uintptr_t>(ptr) & ~(page_size - 1);
+  const uintptr_t end = reinterpret_cast<uintptr_t>(ptr) + length;
+
+  start = reinterpret_cast<void*>(first);
+  range_length = end - first;
+}
+
+} // end of anonymous namespace
+
+void CudaFileCopyOperation::transform(
+    void* src_ptr,
+    void** dst_ptr,
+    util::AllocationRecord* src_allocation,
+    util::AllocationRecord* dst_allocation,
+    size_t length)
+{
+  const bool to_device =
+    (src_allocation->m_strategy->getResourceType() == resource::File);
+
+  void* file_ptr = to_device ? src_ptr : *dst_ptr;
+  void* device_ptr = to_device ? *dst_ptr : src_ptr;
+
+  if (transformDirect(file_ptr, device_ptr, length, to_device)) {
+    UMPIRE_RECORD_STATISTIC(
+        "CudaFileCopyOperation",
+        "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+        "dst_ptr", reinterpret_cast<uintptr_t>(*dst_ptr),
+        "size", length,
+        "event", "copy_direct");
+    return;
+  }
+
+  if (to_device) {
+    void* start;
+    size_t range_length;
+    pageRange(file_ptr, length, start, range_length);
+
+    // Only a hint, so a failure just means the copy faults pages in
+    if (::madvise(start, range_length, MADV_SEQUENTIAL) != 0) {
+      UMPIRE_LOG(Debug, "madvise(MADV_SEQUENTIAL) failed for " << file_ptr);
+    }
+
+    m_copy_to.transform(src_ptr, dst_ptr, src_allocation, dst_allocation, length);
+  } else {
+    m_copy_from.transform(src_ptr, dst_ptr, src_allocation, dst_allocation, length);
+  }
+}
+
+#if defined(UMPIRE_ENABLE_GDS)
+bool CudaFileCopyOperation::transformDirect(
+    void* file_ptr,
+    void* device_ptr,
+    size_t length,
+    bool to_device)
+{
+  std::call_once(m_driver_opened, [&] {
+    CUfileError_t status = ::cuFileDriverOpen();
+    m_driver_available = (status.err == CU_FILE_SUCCESS);
+    if (!m_driver_available) {
+      UMPIRE_LOG(Debug, "cuFileDriverOpen failed with error " << status.err
+          << ", FILE copies will be staged through host memory");
+    }
+  });
+
+  int fd;
+  size_t offset;
+  if (!m_driver_available || !alloc::FileAllocator::findFile(file_ptr, fd, offset)) {
+    return false;
+  }
+
+  CUfileDescr_t description;
+  std::memset(&description, 0, sizeof(description));
+  description.handle.fd = fd;
+  description.type = CU_FILE_HANDLE_TYPE_OPAQUE_FD;
+
+  CUfileHandle_t handle;
+  CUfileError_t status = ::cuFileHandleRegister(&handle, &description);
+  if (status.err != CU_FILE_SUCCESS) {
+    UMPIRE_LOG(Debug, "cuFileHandleRegister failed with error " << status.err
+        << " for " << file_ptr);
+    return false;
+  }
+
+  void* start;
+  size_t range_length;
+  pageRange(file_ptr, length, start, range_length);
+
+  /*
+   * cuFile goes around the page cache, so dirty pages of the mapping must
+   * reach the file before it is read, and before it is written so a later
+   * writeback cannot overwrite the new data.
+   */
+  ::msync(start, range_length, MS_SYNC);
+
+  ssize_t transferred;
+  if (to_device) {
+    transferred = ::cuFileRead(handle, device_ptr, length,
+        static_cast<off_t>(offset), 0);
+  } else {
+    transferred = ::cuFileWrite(handle, device_ptr, length,
+        static_cast<off_t>(offset), 0);
+
+    // Fault the new contents back in on the next access to the mapping
+    ::madvise(start, range_length, MADV_DONTNEED);
+  }
+
+  ::cuFileHandleDeregister(handle);
+
+  if (transferred != static_cast<ssize_t>(length)) {
+    UMPIRE_LOG(Debug, (to_device ? "cuFileRead" : "cuFileWrite")
+        << " of " << length << " bytes at " << file_ptr
+        << " returned " << transferred);
+    return false;
+  }
+
+  return true;
+}
+#else
+bool CudaFileCopyOperation::transformDirect(
+    void* UMPIRE_UNUSED_ARG(file_ptr),
+    void* UMPIRE_UNUSED_ARG(device_ptr),
+    size_t UMPIRE_UNUSED_ARG(length),
+    bool UMPIRE_UNUSED_ARG(to_device))
+{
+  return false;
+}
+#endif
+
+} // end of namespace op
+} // end of namespace umpire
@@ -0,0 +1,77 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CudaFileCopyOperation_HPP
+#define UMPIRE_CudaFileCopyOperation_HPP
+
+#include <mutex>
+
+#include "umpire/op/MemoryOperation.hpp"
+#include "umpire/op/CudaCopyToOperation.hpp"
+#include "umpire/op/CudaCopyFromOperation.hpp"
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Copy memory between a FILE allocation and NVIDIA GPU memory.
+ *
+ * When Umpire is built with GPUDirect Storage, the copy is a cuFileRead or
+ * cuFileWrite on the allocation's file, so data moves between storage and
+ * the GPU without passing through host memory. Mapped pages are written
+ * back first, and pages overwritten by a write are dropped from the
+ * mapping, so the mapping and the file stay consistent.
+ *
+ * Without GPUDirect Storage, or if cuFile cannot handle the file (e.g. the
+ * filesystem has no O_DIRECT), the mapping is copied with the pinned
+ * staging pipeline of CudaCopyToOperation and CudaCopyFromOperation, after
+ * advising a sequential read of the file.
+ */
+class CudaFileCopyOperation : public MemoryOperation {
+ public:
+   /*!
+    * @copybrief MemoryOperation::transform
+    *
+    * Uses cuFile when it is available, and staged copies otherwise.
+    *
+    * @copydetails MemoryOperation::transform
+    */
+  void transform(
+      void* src_ptr,
+      void** dst_ptr,
+      util::AllocationRecord *src_allocation,
+      util::AllocationRecord *dst_allocation,
+      size_t length);
+
+ private:
+  /*
+   * Copy with cuFile, returning false if the caller should fall back.
+   */
+  bool transformDirect(
+      void* file_ptr,
+      void* device_ptr,
+      size_t length,
+      bool to_device);
+
+  CudaCopyToOperation m_copy_to;
+  CudaCopyFromOperation m_copy_from;
+
+  std::once_flag m_driver_opened;
+  bool m_driver_available = false;
+};
+
+} // end of namespace op
+} // end of namespace umpire
+
+#endif // UMPIRE_CudaFileCopyOperation_HPP
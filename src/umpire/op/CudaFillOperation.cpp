@@ -0,0 +1,171 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/CudaFillOperation.hpp"
+
+#include <algorithm>
+
+#include <cuda_runtime_api.h>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+namespace {
+
+void fillDoubling(
+    void* src_ptr,
+    const void* pattern,
+    size_t pattern_size,
+    size_t length,
+    cudaStream_t stream)
+{
+  cudaError_t error;
+
+  if (pattern_size == 1) {
+    error = ::cudaMemsetAsync(src_ptr, *static_cast<const unsigned char*>(pattern), length, stream);
+
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaMemsetAsync( src_ptr = " << src_ptr
+        << ", length = " << length
+        << ", stream = " << stream
+        << ") failed with error: "
+        << cudaGetErrorString(error));
+    }
+    return;
+  }
+
+  if (length == 0) {
+    return;
+  }
+
+  char* ptr = static_cast<char*>(src_ptr);
+
+  cudaStreamCaptureStatus capture = cudaStreamCaptureStatusNone;
+  error = ::cudaStreamIsCapturing(stream, &capture);
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaStreamIsCapturing( stream = " << stream
+      << ") failed with error: "
+      << cudaGetErrorString(error));
+  }
+
+  if (capture == cudaStreamCaptureStatusActive) {
+    // A captured copy would read the pattern when the graph is launched,
+    // after the caller's buffer is gone, so set each run of equal bytes
+    // with a memset node instead.
+    const unsigned char* bytes = static_cast<const unsigned char*>(pattern);
+    const size_t seed = std::min(pattern_size, length);
+
+    for (size_t start = 0; start < seed; ) {
+      size_t end = start + 1;
+      while (end < seed && bytes[end] == bytes[start]) {
+        ++end;
+      }
+
+      error = ::cudaMemsetAsync(ptr + start, bytes[start], end - start, stream);
+
+      if (error != cudaSuccess) {
+        UMPIRE_ERROR("cudaMemsetAsync( src_ptr = " << static_cast<void*>(ptr + start)
+          << ", length = " << end - start
+          << ", stream = " << stream
+          << ") failed with error: "
+          << cudaGetErrorString(error));
+      }
+
+      start = end;
+    }
+  } else {
+    error = ::cudaMemcpyAsync(ptr, pattern, pattern_size, cudaMemcpyDefault, stream);
+
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaMemcpyAsync( dest_ptr = " << src_ptr
+        << ", src_ptr = " << pattern
+        << ", length = " << pattern_size
+        << ", stream = " << stream
+        << ") failed with error: "
+        << cudaGetErrorString(error));
+    }
+  }
+
+  size_t filled = pattern_size;
+
+  while (filled < length) {
+    const size_t bytes = std::min(filled, length - filled);
+
+    error = ::cudaMemcpyAsync(ptr + filled, ptr, bytes, cudaMemcpyDefault, stream);
+
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaMemcpyAsync( dest_ptr = " << static_cast<void*>(ptr + filled)
+        << ", src_ptr = " << src_ptr
+        << ", length = " << bytes
+        << ", stream = " << stream
+        << ") failed with error: "
+        << cudaGetErrorString(error));
+    }
+
+    filled += bytes;
+  }
+}
+
+} // end of anonymous namespace
+
+void
+CudaFillOperation::fill(
+    void* src_ptr,
+    util::AllocationRecord* UMPIRE_UNUSED_ARG(allocation),
+    const void* pattern,
+    size_t pattern_size,
+    size_t length)
+{
+  fillDoubling(src_ptr, pattern, pattern_size, length, 0);
+
+  cudaError_t error = ::cudaStreamSynchronize(0);
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaStreamSynchronize() failed with error: "
+      << cudaGetErrorString(error));
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaFillOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "pattern_size", pattern_size,
+      "size", length,
+      "event", "fill");
+}
+
+void
+CudaFillOperation::fillAsync(
+    void* src_ptr,
+    util::AllocationRecord* UMPIRE_UNUSED_ARG(allocation),
+    const void* pattern,
+    size_t pattern_size,
+    size_t length,
+    void* stream)
+{
+  fillDoubling(src_ptr, pattern, pattern_size, length,
+      static_cast<cudaStream_t>(stream));
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaFillOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "pattern_size", pattern_size,
+      "size", length,
+      "event", "fill_async");
+}
+
+} // end of namespace op
+} // end of namespace umpire
@@ -0,0 +1,68 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CudaFillOperation_HPP
+#define UMPIRE_CudaFillOperation_HPP
+
+#include "umpire/op/MemoryOperation.hpp"
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Fill an allocation in CUDA memory with a repeated pattern.
+ *
+ * Single bytes use cudaMemset. Wider patterns are copied to the start of the
+ * region once, and the filled prefix is then doubled with device-to-device
+ * copies, so filling n bytes takes O(log(n / pattern_size)) copies and never
+ * moves more than n bytes.
+ */
+class CudaFillOperation : public MemoryOperation {
+ public:
+   /*!
+    * \copybrief MemoryOperation::fill
+    *
+    * \copydetails MemoryOperation::fill
+    */
+  void fill(
+      void* src_ptr,
+      util::AllocationRecord* allocation,
+      const void* pattern,
+      size_t pattern_size,
+      size_t length);
+
+   /*!
+    * \copybrief MemoryOperation::fillAsync
+    *
+    * Issues every copy on the given cudaStream_t. The pattern is read from
+    * pageable memory, so the CUDA runtime has consumed it before the first
+    * copy returns. While the stream is being captured into a CUDA graph,
+    * the pattern is instead written with memsets, so the graph does not
+    * refer to it.
+    *
+    * \copydetails MemoryOperation::fillAsync
+    */
+  void fillAsync(
+      void* src_ptr,
+      util::AllocationRecord* allocation,
+      const void* pattern,
+      size_t pattern_size,
+      size_t length,
+      void* stream);
+};
+
+} // end of namespace op
+} // end of namespace umpire
+
+#endif // UMPIRE_CudaFillOperation_HPP
@@ -0,0 +1,85 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/CudaMemPrefetchOperation.hpp"
+
+#include <cuda_runtime_api.h>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+void
+CudaMemPrefetchOperation::apply(
+    void* src_ptr,
+    util::AllocationRecord* src_allocation,
+    int val,
+    size_t length)
+{
+  applyAsync(src_ptr, src_allocation, val, length, nullptr);
+}
+
+void
+CudaMemPrefetchOperation::applyAsync(
+    void* src_ptr,
+    util::AllocationRecord* UMPIRE_UNUSED_ARG(src_allocation),
+    int val,
+    size_t length,
+    void* stream)
+{
+  int device = val;
+  cudaError_t error;
+
+  int current_device;
+  error = ::cudaGetDevice(&current_device);
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaGetDevice failed with error: "
+        << cudaGetErrorString(error));
+  }
+
+  int concurrent_managed_access = 0;
+  error = ::cudaDeviceGetAttribute(&concurrent_managed_access,
+      cudaDevAttrConcurrentManagedAccess, current_device);
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaDeviceGetAttribute( device = " << current_device << "),"
+        << " failed with error: "
+        << cudaGetErrorString(error));
+  }
+
+  if (concurrent_managed_access == 1) {
+    error = ::cudaMemPrefetchAsync(src_ptr, length, device,
+        static_cast<cudaStream_t>(stream));
+
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaMemPrefetchAsync( src_ptr = " << src_ptr
+        << ", length = " << length
+        << ", device = " << device
+        << ", stream = " << stream << ") "
+        << "failed with error: " << cudaGetErrorString(error));
+    }
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaMemPrefetchOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "size", length,
+      "device", device,
+      "event", "prefetch");
+}
+
+} // end of namespace op
+} // end of namespace umpire
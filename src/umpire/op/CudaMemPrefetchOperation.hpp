@@ -0,0 +1,67 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CudaMemPrefetchOperation_HPP
+#define UMPIRE_CudaMemPrefetchOperation_HPP
+
+#include "umpire/op/MemoryOperation.hpp"
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Prefetch unified memory to a device, or to the host with
+ * cudaCpuDeviceId.
+ *
+ * Unlike the advise operations this moves the data, so the first kernel to
+ * touch it does not take page faults. Devices without concurrent managed
+ * access cannot prefetch, and the operation does nothing there.
+ */
+class CudaMemPrefetchOperation :
+  public MemoryOperation {
+public:
+  /*!
+   * @copybrief MemoryOperation::apply
+   *
+   * Uses cudaMemPrefetchAsync to move data to device val on the default
+   * stream.
+   *
+   * @copydetails MemoryOperation::apply
+   */
+    void apply(
+        void* src_ptr,
+        util::AllocationRecord *src_allocation,
+        int val,
+        size_t length);
+
+  /*!
+   * @copybrief MemoryOperation::applyAsync
+   *
+   * Uses cudaMemPrefetchAsync to move data to device val on the given
+   * cudaStream_t.
+   *
+   * @copydetails MemoryOperation::applyAsync
+   */
+    void applyAsync(
+        void* src_ptr,
+        util::AllocationRecord *src_allocation,
+        int val,
+        size_t length,
+        void* stream);
+};
+
+} // end of namespace op
+} // end of namespace umpire
+
+#endif // UMPIRE_CudaMemPrefetchOperation_HPP
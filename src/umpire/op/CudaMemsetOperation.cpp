@@ -46,5 +46,33 @@ CudaMemsetOperation::apply(
       "event", "memset");
 }
 
+void
+CudaMemsetOperation::applyAsync(
+    void* src_ptr,
+    util::AllocationRecord*  UMPIRE_UNUSED_ARG(allocation),
+    int value,
+    size_t length,
+    void* stream)
+{
+  cudaError_t error = ::cudaMemsetAsync(src_ptr, value, length,
+        static_cast<cudaStream_t>(stream));
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaMemsetAsync( src_ptr = " << src_ptr
+      << ", value = " << value
+      << ", length = " << length
+      << ", stream = " << stream
+      << ") failed with error: "
+      << cudaGetErrorString(error));
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaMemsetOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "value", value,
+      "size", length,
+      "event", "memset_async");
+}
+
 } // end of namespace op
 } // end of namespace umpire
@@ -37,6 +37,20 @@ class CudaMemsetOperation : public MemoryOperation {
       util::AllocationRecord* ptr,
       int value,
       size_t length);
+
+   /*!
+    * @copybrief MemoryOperation::applyAsync
+    *
+    * Uses cudaMemsetAsync on the given cudaStream_t.
+    *
+    * @copydetails MemoryOperation::applyAsync
+    */
+  void applyAsync(
+      void* src_ptr,
+      util::AllocationRecord* ptr,
+      int value,
+      size_t length,
+      void* stream);
 };
 
 } // end of naemspace op
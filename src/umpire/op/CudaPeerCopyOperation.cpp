@@ -0,0 +1,174 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/CudaPeerCopyOperation.hpp"
+
+#include <cuda_runtime_api.h>
+
+#include "umpire/alloc/CudaMallocAllocator.hpp"
+#include "umpire/op/CudaStagingCopyEngine.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+void CudaPeerCopyOperation::transform(
+    void* src_ptr,
+    void** dst_ptr,
+    umpire::util::AllocationRecord* src_allocation,
+    umpire::util::AllocationRecord* dst_allocation,
+    size_t length)
+{
+  int src_device, dst_device;
+
+  if (!getDevices(src_ptr, *dst_ptr, src_device, dst_device)
+      || src_device == dst_device) {
+    CudaCopyOperation::transform(src_ptr, dst_ptr, src_allocation, dst_allocation, length);
+    return;
+  }
+
+  if (enablePeerAccess(dst_device, src_device)) {
+    cudaError_t error =
+      ::cudaMemcpyPeer(*dst_ptr, dst_device, src_ptr, src_device, length);
+
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaMemcpyPeer( dest_ptr = " << *dst_ptr
+        << ", dst_device = " << dst_device
+        << ", src_ptr = " << src_ptr
+        << ", src_device = " << src_device
+        << ", length = " << length
+        << " ) failed with error: "
+        << cudaGetErrorString(error));
+    }
+  } else {
+    CudaStagingCopyEngine::getInstance().copyBetweenDevices(
+        *dst_ptr, dst_device, src_ptr, src_device, length);
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaPeerCopyOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "dst_ptr", reinterpret_cast<uintptr_t>(dst_ptr),
+      "size", length,
+      "event", "copy");
+}
+
+void CudaPeerCopyOperation::transformAsync(
+    void* src_ptr,
+    void** dst_ptr,
+    umpire::util::AllocationRecord* src_allocation,
+    umpire::util::AllocationRecord* dst_allocation,
+    size_t length,
+    void* stream)
+{
+  int src_device, dst_device;
+
+  if (!getDevices(src_ptr, *dst_ptr, src_device, dst_device)
+      || src_device == dst_device) {
+    CudaCopyOperation::transformAsync(src_ptr, dst_ptr, src_allocation, dst_allocation, length, stream);
+    return;
+  }
+
+  if (enablePeerAccess(dst_device, src_device)) {
+    cudaError_t error =
+      ::cudaMemcpyPeerAsync(*dst_ptr, dst_device, src_ptr, src_device, length,
+          static_cast<cudaStream_t>(stream));
+
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaMemcpyPeerAsync( dest_ptr = " << *dst_ptr
+        << ", dst_device = " << dst_device
+        << ", src_ptr = " << src_ptr
+        << ", src_device = " << src_device
+        << ", length = " << length
+        << ", stream = " << stream << " ) failed with error: "
+        << cudaGetErrorString(error));
+    }
+  } else {
+    CudaStagingCopyEngine::getInstance().copyBetweenDevices(
+        *dst_ptr, dst_device, src_ptr, src_device, length);
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaPeerCopyOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "dst_ptr", reinterpret_cast<uintptr_t>(dst_ptr),
+      "size", length,
+      "event", "copy_async");
+}
+
+bool CudaPeerCopyOperation::getDevices(
+    const void* src_ptr, const void* dst_ptr,
+    int& src_device, int& dst_device)
+{
+  cudaPointerAttributes src_attributes, dst_attributes;
+
+  if (::cudaPointerGetAttributes(&src_attributes, src_ptr) != cudaSuccess
+      || ::cudaPointerGetAttributes(&dst_attributes, dst_ptr) != cudaSuccess) {
+    ::cudaGetLastError();
+    return false;
+  }
+
+#if CUDART_VERSION >= 10000
+  if (src_attributes.type != cudaMemoryTypeDevice
+      || dst_attributes.type != cudaMemoryTypeDevice) {
+    return false;
+  }
+#else
+  if (src_attributes.memoryType != cudaMemoryTypeDevice || src_attributes.isManaged
+      || dst_attributes.memoryType != cudaMemoryTypeDevice || dst_attributes.isManaged) {
+    return false;
+  }
+#endif
+
+  src_device = src_attributes.device;
+  dst_device = dst_attributes.device;
+
+  return true;
+}
+
+bool CudaPeerCopyOperation::enablePeerAccess(int dst_device, int src_device)
+{
+  std::lock_guard<std::mutex> lock(m_peer_access_mutex);
+
+  const auto devices = std::make_pair(dst_device, src_device);
+  auto peer_access = m_peer_access.find(devices);
+
+  if (peer_access != m_peer_access.end()) {
+    return peer_access->second;
+  }
+
+  int can_access = 0;
+  ::cudaDeviceCanAccessPeer(&can_access, dst_device, src_device);
+
+  bool enabled = false;
+  if (can_access) {
+    alloc::CudaMallocAllocator::DeviceGuard guard(dst_device);
+
+    cudaError_t error = ::cudaDeviceEnablePeerAccess(src_device, 0);
+    if (error == cudaSuccess || error == cudaErrorPeerAccessAlreadyEnabled) {
+      enabled = true;
+    }
+
+    // Clear cudaErrorPeerAccessAlreadyEnabled so it is not reported later
+    ::cudaGetLastError();
+  }
+
+  UMPIRE_LOG(Debug, "(dst_device=" << dst_device << ", src_device=" << src_device << ") peer access " << (enabled ? "enabled" : "unavailable"));
+
+  m_peer_access[devices] = enabled;
+  return enabled;
+}
+
+} // end of namespace op
+} // end of namespace umpire
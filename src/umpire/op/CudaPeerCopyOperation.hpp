@@ -0,0 +1,92 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CudaPeerCopyOperation_HPP
+#define UMPIRE_CudaPeerCopyOperation_HPP
+
+#include "umpire/op/CudaCopyOperation.hpp"
+
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Copy operation to move data between GPU addresses that may be on
+ * different devices.
+ *
+ * Copies within one device, or involving unified memory, behave like
+ * CudaCopyOperation. Copies between two devices use cudaMemcpyPeerAsync,
+ * enabling peer access the first time each pair of devices is seen. When
+ * the devices cannot access each other, data is passed through pinned host
+ * memory with the CudaStagingCopyEngine.
+ */
+class CudaPeerCopyOperation : public CudaCopyOperation {
+ public:
+   /*!
+    * @copybrief MemoryOperation::transform
+    *
+    * @copydetails MemoryOperation::transform
+    */
+  void transform(
+      void* src_ptr,
+      void** dst_ptr,
+      umpire::util::AllocationRecord *src_allocation,
+      umpire::util::AllocationRecord *dst_allocation,
+      size_t length);
+
+   /*!
+    * @copybrief MemoryOperation::transformAsync
+    *
+    * Copies between devices without peer access are staged through host
+    * memory and complete before this returns.
+    *
+    * @copydetails MemoryOperation::transformAsync
+    */
+  void transformAsync(
+      void* src_ptr,
+      void** dst_ptr,
+      umpire::util::AllocationRecord *src_allocation,
+      umpire::util::AllocationRecord *dst_allocation,
+      size_t length,
+      void* stream);
+
+ private:
+  /*!
+   * \brief Find the devices of src_ptr and dst_ptr.
+   *
+   * \return false if either pointer is not plain device memory, in which
+   * case the copy needs no peer handling.
+   */
+  bool getDevices(const void* src_ptr, const void* dst_ptr,
+      int& src_device, int& dst_device);
+
+  /*!
+   * \brief Enable access from dst_device to src_device's memory, once per
+   * pair.
+   *
+   * \return true if peer access is available.
+   */
+  bool enablePeerAccess(int dst_device, int src_device);
+
+  std::map<std::pair<int, int>, bool> m_peer_access;
+  std::mutex m_peer_access_mutex;
+};
+
+} // end of namespace op
+} // end of namespace umpire
+
+#endif // UMPIRE_CudaPeerCopyOperation_HPP
@@ -0,0 +1,148 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/CudaPinnedCopyOperation.hpp"
+
+#include <cuda_runtime_api.h>
+
+#include <vector>
+
+#include "umpire/op/CudaCopyScheduler.hpp"
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+CudaPinnedCopyOperation::CudaPinnedCopyOperation() :
+  CudaStridedCopyOperation(cudaMemcpyDefault)
+{
+}
+
+void CudaPinnedCopyOperation::transform(
+    void* src_ptr,
+    void** dst_ptr,
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(src_allocation),
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(dst_allocation),
+    size_t length)
+{
+  cudaError_t error =
+    ::cudaMemcpy(*dst_ptr, src_ptr, length, cudaMemcpyDefault);
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaMemcpy( dest_ptr = " << *dst_ptr
+      << ", src_ptr = " << src_ptr
+      << ", length = " << length
+      << ", cudaMemcpyDefault ) failed with error: "
+      << cudaGetErrorString(error));
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaPinnedCopyOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "dst_ptr", reinterpret_cast<uintptr_t>(dst_ptr),
+      "size", length,
+      "event", "copy");
+}
+
+void CudaPinnedCopyOperation::transformAsync(
+    void* src_ptr,
+    void** dst_ptr,
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(src_allocation),
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(dst_allocation),
+    size_t length,
+    void* stream)
+{
+  cudaError_t error =
+    ::cudaMemcpyAsync(*dst_ptr, src_ptr, length, cudaMemcpyDefault,
+        static_cast<cudaStream_t>(stream));
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaMemcpyAsync( dest_ptr = " << *dst_ptr
+      << ", src_ptr = " << src_ptr
+      << ", length = " << length
+      << ", cudaMemcpyDefault, stream = " << stream << " ) failed with error: "
+      << cudaGetErrorString(error));
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaPinnedCopyOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "dst_ptr", reinterpret_cast<uintptr_t>(dst_ptr),
+      "size", length,
+      "event", "copy_async");
+}
+
+void CudaPinnedCopyOperation::transformBatch(
+    void** src_ptrs,
+    void** dst_ptrs,
+    umpire::util::AllocationRecord** UMPIRE_UNUSED_ARG(src_allocations),
+    umpire::util::AllocationRecord** UMPIRE_UNUSED_ARG(dst_allocations),
+    size_t* lengths,
+    size_t count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    cudaError_t error =
+      ::cudaMemcpyAsync(dst_ptrs[i], src_ptrs[i], lengths[i], cudaMemcpyDefault);
+
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaMemcpyAsync( dest_ptr = " << dst_ptrs[i]
+        << ", src_ptr = " << src_ptrs[i]
+        << ", length = " << lengths[i]
+        << ", cudaMemcpyDefault ) failed with error: "
+        << cudaGetErrorString(error));
+    }
+  }
+
+  cudaError_t error = ::cudaStreamSynchronize(0);
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaStreamSynchronize failed with error: "
+      << cudaGetErrorString(error));
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaPinnedCopyOperation",
+      "count", count,
+      "event", "copy_batch");
+}
+
+void CudaPinnedCopyOperation::transformBatchAsync(
+    void** src_ptrs,
+    void** dst_ptrs,
+    umpire::util::AllocationRecord** src_allocations,
+    umpire::util::AllocationRecord** UMPIRE_UNUSED_ARG(dst_allocations),
+    size_t* lengths,
+    size_t count,
+    void* stream)
+{
+  // Each direction has its own copy engine, and its own scheduler stream.
+  std::vector<cudaMemcpyKind> kinds(count);
+  for (size_t i = 0; i < count; ++i) {
+    kinds[i] = (src_allocations[i]->m_strategy->getPlatform() == Platform::cpu) ?
+      cudaMemcpyHostToDevice : cudaMemcpyDeviceToHost;
+  }
+
+  CudaCopyScheduler::getInstance().copy(dst_ptrs, src_ptrs, lengths,
+      kinds.data(), count, static_cast<cudaStream_t>(stream));
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaPinnedCopyOperation",
+      "count", count,
+      "event", "copy_batch_async");
+}
+
+} // end of namespace op
+} // end of namespace umpire
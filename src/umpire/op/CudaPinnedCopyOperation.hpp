@@ -0,0 +1,101 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CudaPinnedCopyOperation_HPP
+#define UMPIRE_CudaPinnedCopyOperation_HPP
+
+#include "umpire/op/CudaStridedCopyOperation.hpp"
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Copy operation to move data between pinned host memory and GPU
+ * memory.
+ *
+ * Pinned memory can be read by the GPU's copy engines directly, so transfers
+ * are issued with cudaMemcpyDefault and no staging, and asynchronous copies
+ * really are asynchronous.
+ */
+class CudaPinnedCopyOperation : public CudaStridedCopyOperation {
+ public:
+  CudaPinnedCopyOperation();
+
+   /*!
+    * @copybrief MemoryOperation::transform
+    *
+    * Uses cudaMemcpy with cudaMemcpyDefault.
+    *
+    * @copydetails MemoryOperation::transform
+    */
+  void transform(
+      void* src_ptr,
+      void** dst_ptr,
+      umpire::util::AllocationRecord *src_allocation,
+      umpire::util::AllocationRecord *dst_allocation,
+      size_t length);
+
+   /*!
+    * @copybrief MemoryOperation::transformAsync
+    *
+    * Uses cudaMemcpyAsync with cudaMemcpyDefault on the given cudaStream_t.
+    *
+    * @copydetails MemoryOperation::transformAsync
+    */
+  void transformAsync(
+      void* src_ptr,
+      void** dst_ptr,
+      umpire::util::AllocationRecord *src_allocation,
+      umpire::util::AllocationRecord *dst_allocation,
+      size_t length,
+      void* stream);
+
+   /*!
+    * @copybrief MemoryOperation::transformBatch
+    *
+    * Issues every transfer with cudaMemcpyAsync on the default stream and
+    * synchronizes once at the end.
+    *
+    * @copydetails MemoryOperation::transformBatch
+    */
+  void transformBatch(
+      void** src_ptrs,
+      void** dst_ptrs,
+      umpire::util::AllocationRecord** src_allocations,
+      umpire::util::AllocationRecord** dst_allocations,
+      size_t* lengths,
+      size_t count);
+
+   /*!
+    * @copybrief MemoryOperation::transformBatchAsync
+    *
+    * Issues the transfers through the CudaCopyScheduler, on the
+    * stream for their direction.
+    *
+    * @copydetails MemoryOperation::transformBatchAsync
+    */
+  void transformBatchAsync(
+      void** src_ptrs,
+      void** dst_ptrs,
+      umpire::util::AllocationRecord** src_allocations,
+      umpire::util::AllocationRecord** dst_allocations,
+      size_t* lengths,
+      size_t count,
+      void* stream);
+};
+
+} // end of namespace op
+} // end of namespace umpire
+
+#endif // UMPIRE_CudaPinnedCopyOperation_HPP
@@ -0,0 +1,238 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/CudaStagingCopyEngine.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "umpire/alloc/CudaMallocAllocator.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+CudaStagingCopyEngine*
+CudaStagingCopyEngine::s_staging_copy_engine_instance = nullptr;
+
+const std::size_t CudaStagingCopyEngine::s_staging_threshold;
+const std::size_t CudaStagingCopyEngine::s_chunk_size;
+
+CudaStagingCopyEngine&
+CudaStagingCopyEngine::getInstance()
+{
+  if (!s_staging_copy_engine_instance) {
+    s_staging_copy_engine_instance = new CudaStagingCopyEngine();
+    UMPIRE_LOG(Debug, "() Created CudaStagingCopyEngine at " << s_staging_copy_engine_instance);
+  }
+
+  return *s_staging_copy_engine_instance;
+}
+
+CudaStagingCopyEngine::CudaStagingCopyEngine() :
+  m_pinned_allocator(),
+  m_initialized(false),
+  m_mutex(new std::mutex())
+{
+}
+
+void
+CudaStagingCopyEngine::initialize()
+{
+  for (int i = 0; i < s_num_buffers; ++i) {
+    m_buffers[i] = static_cast<char*>(m_pinned_allocator.allocate(s_chunk_size));
+
+    cudaError_t error = ::cudaStreamCreateWithFlags(&m_streams[i], cudaStreamNonBlocking);
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaStreamCreateWithFlags failed with error: "
+          << cudaGetErrorString(error));
+    }
+
+    error = ::cudaEventCreateWithFlags(&m_events[i], cudaEventDisableTiming);
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaEventCreateWithFlags failed with error: "
+          << cudaGetErrorString(error));
+    }
+  }
+
+  m_initialized = true;
+}
+
+void
+CudaStagingCopyEngine::waitFor(int buffer)
+{
+  cudaError_t error = ::cudaEventSynchronize(m_events[buffer]);
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaEventSynchronize failed with error: "
+        << cudaGetErrorString(error));
+  }
+}
+
+void
+CudaStagingCopyEngine::copyToDevice(
+    void* dst_ptr, const void* src_ptr, std::size_t length)
+{
+  UMPIRE_LOG(Debug, "(dst_ptr=" << dst_ptr << ", src_ptr=" << src_ptr << ", length=" << length << ")");
+
+  char* dst = static_cast<char*>(dst_ptr);
+  const char* src = static_cast<const char*>(src_ptr);
+
+  try {
+    UMPIRE_LOCK;
+
+    if (!m_initialized)
+      initialize();
+
+    int buffer = 0;
+    for (std::size_t offset = 0; offset < length; offset += s_chunk_size) {
+      const std::size_t chunk = std::min(s_chunk_size, length - offset);
+
+      // The buffer's previous chunk must have left for the device before
+      // it can be refilled.
+      waitFor(buffer);
+      std::memcpy(m_buffers[buffer], src + offset, chunk);
+
+      cudaError_t error = ::cudaMemcpyAsync(dst + offset, m_buffers[buffer],
+          chunk, cudaMemcpyHostToDevice, m_streams[buffer]);
+      if (error != cudaSuccess) {
+        UMPIRE_ERROR("cudaMemcpyAsync( dest_ptr = " << static_cast<void*>(dst + offset)
+            << ", length = " << chunk
+            << ", cudaMemcpyHostToDevice ) failed with error: "
+            << cudaGetErrorString(error));
+      }
+      ::cudaEventRecord(m_events[buffer], m_streams[buffer]);
+
+      buffer = (buffer + 1) % s_num_buffers;
+    }
+
+    for (int i = 0; i < s_num_buffers; ++i) {
+      waitFor(i);
+    }
+
+    UMPIRE_UNLOCK;
+  } catch (...) {
+    UMPIRE_UNLOCK;
+    throw;
+  }
+}
+
+void
+CudaStagingCopyEngine::copyFromDevice(
+    void* dst_ptr, const void* src_ptr, std::size_t length)
+{
+  UMPIRE_LOG(Debug, "(dst_ptr=" << dst_ptr << ", src_ptr=" << src_ptr << ", length=" << length << ")");
+
+  char* dst = static_cast<char*>(dst_ptr);
+  const char* src = static_cast<const char*>(src_ptr);
+
+  try {
+    UMPIRE_LOCK;
+
+    if (!m_initialized)
+      initialize();
+
+    const std::size_t num_chunks = (length + s_chunk_size - 1) / s_chunk_size;
+
+    // Keep one chunk in flight ahead of the one being drained to the host.
+    for (std::size_t i = 0; i <= num_chunks; ++i) {
+      if (i < num_chunks) {
+        const int buffer = i % s_num_buffers;
+        const std::size_t offset = i * s_chunk_size;
+        const std::size_t chunk = std::min(s_chunk_size, length - offset);
+
+        cudaError_t error = ::cudaMemcpyAsync(m_buffers[buffer], src + offset,
+            chunk, cudaMemcpyDeviceToHost, m_streams[buffer]);
+        if (error != cudaSuccess) {
+          UMPIRE_ERROR("cudaMemcpyAsync( src_ptr = " << static_cast<const void*>(src + offset)
+              << ", length = " << chunk
+              << ", cudaMemcpyDeviceToHost ) failed with error: "
+              << cudaGetErrorString(error));
+        }
+        ::cudaEventRecord(m_events[buffer], m_streams[buffer]);
+      }
+
+      if (i > 0) {
+        const int buffer = (i - 1) % s_num_buffers;
+        const std::size_t offset = (i - 1) * s_chunk_size;
+        const std::size_t chunk = std::min(s_chunk_size, length - offset);
+
+        waitFor(buffer);
+        std::memcpy(dst + offset, m_buffers[buffer], chunk);
+      }
+    }
+
+    UMPIRE_UNLOCK;
+  } catch (...) {
+    UMPIRE_UNLOCK;
+    throw;
+  }
+}
+
+void
+CudaStagingCopyEngine::copyBetweenDevices(
+    void* dst_ptr, int dst_device,
+    const void* src_ptr, int src_device, std::size_t length)
+{
+  UMPIRE_LOG(Debug, "(dst_ptr=" << dst_ptr << ", dst_device=" << dst_device
+      << ", src_ptr=" << src_ptr << ", src_device=" << src_device
+      << ", length=" << length << ")");
+
+  char* dst = static_cast<char*>(dst_ptr);
+  const char* src = static_cast<const char*>(src_ptr);
+
+  try {
+    UMPIRE_LOCK;
+
+    if (!m_initialized)
+      initialize();
+
+    // The engine's streams belong to one device, so the chunks use each
+    // device's default stream instead.
+    for (std::size_t offset = 0; offset < length; offset += s_chunk_size) {
+      const std::size_t chunk = std::min(s_chunk_size, length - offset);
+      cudaError_t error;
+
+      {
+        alloc::CudaMallocAllocator::DeviceGuard guard(src_device);
+        error = ::cudaMemcpy(m_buffers[0], src + offset, chunk, cudaMemcpyDeviceToHost);
+      }
+      if (error != cudaSuccess) {
+        UMPIRE_ERROR("cudaMemcpy( src_ptr = " << static_cast<const void*>(src + offset)
+            << ", length = " << chunk
+            << ", cudaMemcpyDeviceToHost ) failed with error: "
+            << cudaGetErrorString(error));
+      }
+
+      {
+        alloc::CudaMallocAllocator::DeviceGuard guard(dst_device);
+        error = ::cudaMemcpy(dst + offset, m_buffers[0], chunk, cudaMemcpyHostToDevice);
+      }
+      if (error != cudaSuccess) {
+        UMPIRE_ERROR("cudaMemcpy( dest_ptr = " << static_cast<void*>(dst + offset)
+            << ", length = " << chunk
+            << ", cudaMemcpyHostToDevice ) failed with error: "
+            << cudaGetErrorString(error));
+      }
+    }
+
+    UMPIRE_UNLOCK;
+  } catch (...) {
+    UMPIRE_UNLOCK;
+    throw;
+  }
+}
+
+} // end of namespace op
+} // end of namespace umpire
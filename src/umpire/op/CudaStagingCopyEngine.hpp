@@ -0,0 +1,98 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CudaStagingCopyEngine_HPP
+#define UMPIRE_CudaStagingCopyEngine_HPP
+
+#include <cuda_runtime_api.h>
+
+#include <cstddef>
+#include <mutex>
+
+#include "umpire/util/Macros.hpp"
+#include "umpire/alloc/CudaPinnedAllocator.hpp"
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Moves large transfers between pageable host memory and the GPU
+ * through a pair of pinned staging buffers.
+ *
+ * Transfers are split into chunks. While one chunk is copied by the GPU
+ * from (or to) one pinned buffer on its own stream, the host fills (or
+ * drains) the other buffer, so the host memcpy and the DMA overlap. This
+ * gets close to pinned-memory bandwidth for sources that cannot themselves
+ * be pinned.
+ *
+ * The buffers are allocated on first use and shared by all copies;
+ * concurrent copies are serialized.
+ */
+class CudaStagingCopyEngine {
+  public:
+    /*!
+     * \brief Transfers smaller than this go straight to cudaMemcpy.
+     */
+    static const std::size_t s_staging_threshold = 4 * 1024 * 1024;
+
+    static CudaStagingCopyEngine& getInstance();
+
+    /*!
+     * \brief Copy length bytes from pageable host memory to the GPU.
+     */
+    void copyToDevice(void* dst_ptr, const void* src_ptr, std::size_t length);
+
+    /*!
+     * \brief Copy length bytes from the GPU to pageable host memory.
+     */
+    void copyFromDevice(void* dst_ptr, const void* src_ptr, std::size_t length);
+
+    /*!
+     * \brief Copy length bytes between two GPUs that cannot access each
+     * other's memory, passing each chunk through a pinned buffer.
+     */
+    void copyBetweenDevices(void* dst_ptr, int dst_device,
+        const void* src_ptr, int src_device, std::size_t length);
+
+  protected:
+    CudaStagingCopyEngine();
+
+    CudaStagingCopyEngine (const CudaStagingCopyEngine&) = delete;
+    CudaStagingCopyEngine& operator= (const CudaStagingCopyEngine&) = delete;
+
+  private:
+    static const std::size_t s_chunk_size = 2 * 1024 * 1024;
+    static const int s_num_buffers = 2;
+
+    void initialize();
+
+    void waitFor(int buffer);
+
+    static CudaStagingCopyEngine* s_staging_copy_engine_instance;
+
+    alloc::CudaPinnedAllocator m_pinned_allocator;
+
+    char* m_buffers[s_num_buffers];
+    cudaStream_t m_streams[s_num_buffers];
+    cudaEvent_t m_events[s_num_buffers];
+
+    bool m_initialized;
+
+    std::mutex* m_mutex;
+};
+
+} // end of namespace op
+} // end of namespace umpire
+
+#endif // UMPIRE_CudaStagingCopyEngine_HPP
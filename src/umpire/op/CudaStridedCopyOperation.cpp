@@ -0,0 +1,123 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/CudaStridedCopyOperation.hpp"
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+CudaStridedCopyOperation::CudaStridedCopyOperation(cudaMemcpyKind kind) :
+  m_kind(kind)
+{
+}
+
+void CudaStridedCopyOperation::copy(
+    void* src_ptr,
+    void* dst_ptr,
+    size_t width,
+    size_t height,
+    size_t depth,
+    size_t src_pitch,
+    size_t src_height,
+    size_t dst_pitch,
+    size_t dst_height,
+    cudaStream_t stream,
+    bool async)
+{
+  cudaError_t error;
+
+  if (depth == 1) {
+    error = async ?
+      ::cudaMemcpy2DAsync(dst_ptr, dst_pitch, src_ptr, src_pitch,
+          width, height, m_kind, stream) :
+      ::cudaMemcpy2D(dst_ptr, dst_pitch, src_ptr, src_pitch,
+          width, height, m_kind);
+  } else {
+    cudaMemcpy3DParms parms = {};
+    parms.srcPtr = make_cudaPitchedPtr(src_ptr, src_pitch, width, src_height);
+    parms.dstPtr = make_cudaPitchedPtr(dst_ptr, dst_pitch, width, dst_height);
+    parms.extent = make_cudaExtent(width, height, depth);
+    parms.kind = m_kind;
+
+    error = async ?
+      ::cudaMemcpy3DAsync(&parms, stream) :
+      ::cudaMemcpy3D(&parms);
+  }
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaMemcpy" << (depth == 1 ? "2D" : "3D") << (async ? "Async" : "")
+      << "( dest_ptr = " << dst_ptr
+      << ", src_ptr = " << src_ptr
+      << ", width = " << width
+      << ", height = " << height
+      << ", depth = " << depth
+      << ", kind = " << m_kind << " ) failed with error: "
+      << cudaGetErrorString(error));
+  }
+}
+
+void CudaStridedCopyOperation::transformStrided(
+    void* src_ptr,
+    void* dst_ptr,
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(src_allocation),
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(dst_allocation),
+    size_t width,
+    size_t height,
+    size_t depth,
+    size_t src_pitch,
+    size_t src_height,
+    size_t dst_pitch,
+    size_t dst_height)
+{
+  copy(src_ptr, dst_ptr, width, height, depth,
+      src_pitch, src_height, dst_pitch, dst_height, 0, false);
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaStridedCopyOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "dst_ptr", reinterpret_cast<uintptr_t>(dst_ptr),
+      "size", width*height*depth,
+      "event", "copy_strided");
+}
+
+void CudaStridedCopyOperation::transformStridedAsync(
+    void* src_ptr,
+    void* dst_ptr,
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(src_allocation),
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(dst_allocation),
+    size_t width,
+    size_t height,
+    size_t depth,
+    size_t src_pitch,
+    size_t src_height,
+    size_t dst_pitch,
+    size_t dst_height,
+    void* stream)
+{
+  copy(src_ptr, dst_ptr, width, height, depth,
+      src_pitch, src_height, dst_pitch, dst_height,
+      static_cast<cudaStream_t>(stream), true);
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaStridedCopyOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "dst_ptr", reinterpret_cast<uintptr_t>(dst_ptr),
+      "size", width*height*depth,
+      "event", "copy_strided_async");
+}
+
+} // end of namespace op
+} // end of namespace umpire
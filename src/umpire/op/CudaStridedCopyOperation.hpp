@@ -0,0 +1,101 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CudaStridedCopyOperation_HPP
+#define UMPIRE_CudaStridedCopyOperation_HPP
+
+#include <cuda_runtime_api.h>
+
+#include "umpire/op/MemoryOperation.hpp"
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Base class of the CUDA copy operations, providing pitched copies.
+ *
+ * A single slice is copied with cudaMemcpy2D and several with cudaMemcpy3D,
+ * so faces and sub-blocks of a grid move in one call without packing them
+ * into a contiguous buffer first.
+ */
+class CudaStridedCopyOperation : public MemoryOperation {
+ public:
+   /*!
+    * @copybrief MemoryOperation::transformStrided
+    *
+    * Uses cudaMemcpy2D or cudaMemcpy3D.
+    *
+    * @copydetails MemoryOperation::transformStrided
+    */
+  void transformStrided(
+      void* src_ptr,
+      void* dst_ptr,
+      umpire::util::AllocationRecord *src_allocation,
+      umpire::util::AllocationRecord *dst_allocation,
+      size_t width,
+      size_t height,
+      size_t depth,
+      size_t src_pitch,
+      size_t src_height,
+      size_t dst_pitch,
+      size_t dst_height);
+
+   /*!
+    * @copybrief MemoryOperation::transformStridedAsync
+    *
+    * Uses cudaMemcpy2DAsync or cudaMemcpy3DAsync on the given cudaStream_t.
+    *
+    * @copydetails MemoryOperation::transformStridedAsync
+    */
+  void transformStridedAsync(
+      void* src_ptr,
+      void* dst_ptr,
+      umpire::util::AllocationRecord *src_allocation,
+      umpire::util::AllocationRecord *dst_allocation,
+      size_t width,
+      size_t height,
+      size_t depth,
+      size_t src_pitch,
+      size_t src_height,
+      size_t dst_pitch,
+      size_t dst_height,
+      void* stream);
+
+ protected:
+  /*!
+   * \param kind Direction passed to the CUDA copy calls.
+   */
+  CudaStridedCopyOperation(cudaMemcpyKind kind);
+
+ private:
+  void copy(
+      void* src_ptr,
+      void* dst_ptr,
+      size_t width,
+      size_t height,
+      size_t depth,
+      size_t src_pitch,
+      size_t src_height,
+      size_t dst_pitch,
+      size_t dst_height,
+      cudaStream_t stream,
+      bool async);
+
+  cudaMemcpyKind m_kind;
+};
+
+} // end of namespace op
+} // end of namespace umpire
+
+#endif // UMPIRE_CudaStridedCopyOperation_HPP
@@ -0,0 +1,146 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/CudaUnifiedMemoryCopyOperation.hpp"
+
+#include <cuda_runtime_api.h>
+
+#include <cstring>
+
+#include "umpire/strategy/AllocationStrategy.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+CudaUnifiedMemoryCopyOperation::CudaUnifiedMemoryCopyOperation() :
+  CudaStridedCopyOperation(cudaMemcpyDefault)
+{
+}
+
+void CudaUnifiedMemoryCopyOperation::transform(
+    void* src_ptr,
+    void** dst_ptr,
+    umpire::util::AllocationRecord* src_allocation,
+    umpire::util::AllocationRecord* dst_allocation,
+    size_t length)
+{
+  const bool on_host =
+    prefetch(src_ptr, *dst_ptr, src_allocation, dst_allocation, length, 0);
+
+  if (on_host) {
+    cudaError_t error = ::cudaStreamSynchronize(0);
+
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaStreamSynchronize failed with error: "
+        << cudaGetErrorString(error));
+    }
+
+    std::memcpy(*dst_ptr, src_ptr, length);
+  } else {
+    cudaError_t error =
+      ::cudaMemcpy(*dst_ptr, src_ptr, length, cudaMemcpyDefault);
+
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaMemcpy( dest_ptr = " << *dst_ptr
+        << ", src_ptr = " << src_ptr
+        << ", length = " << length
+        << ", cudaMemcpyDefault ) failed with error: "
+        << cudaGetErrorString(error));
+    }
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaUnifiedMemoryCopyOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "dst_ptr", reinterpret_cast<uintptr_t>(dst_ptr),
+      "size", length,
+      "event", "copy");
+}
+
+void CudaUnifiedMemoryCopyOperation::transformAsync(
+    void* src_ptr,
+    void** dst_ptr,
+    umpire::util::AllocationRecord* src_allocation,
+    umpire::util::AllocationRecord* dst_allocation,
+    size_t length,
+    void* stream)
+{
+  prefetch(src_ptr, *dst_ptr, src_allocation, dst_allocation, length, stream);
+
+  cudaError_t error =
+    ::cudaMemcpyAsync(*dst_ptr, src_ptr, length, cudaMemcpyDefault,
+        static_cast<cudaStream_t>(stream));
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaMemcpyAsync( dest_ptr = " << *dst_ptr
+      << ", src_ptr = " << src_ptr
+      << ", length = " << length
+      << ", cudaMemcpyDefault, stream = " << stream << " ) failed with error: "
+      << cudaGetErrorString(error));
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "CudaUnifiedMemoryCopyOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "dst_ptr", reinterpret_cast<uintptr_t>(dst_ptr),
+      "size", length,
+      "event", "copy_async");
+}
+
+bool CudaUnifiedMemoryCopyOperation::prefetch(
+    void* src_ptr,
+    void* dst_ptr,
+    umpire::util::AllocationRecord* src_allocation,
+    umpire::util::AllocationRecord* dst_allocation,
+    size_t length,
+    void* stream)
+{
+  const bool src_is_um =
+    src_allocation->m_strategy->getResourceType() == resource::UnifiedMemory;
+
+  void* um_ptr = src_is_um ? src_ptr : dst_ptr;
+  void* other_ptr = src_is_um ? dst_ptr : src_ptr;
+  util::AllocationRecord* other_allocation = src_is_um ? dst_allocation : src_allocation;
+
+  int location = cudaCpuDeviceId;
+
+  if (other_allocation->m_strategy->getResourceType() == resource::Device) {
+    cudaPointerAttributes attributes;
+    if (::cudaPointerGetAttributes(&attributes, other_ptr) == cudaSuccess) {
+      location = attributes.device;
+    } else {
+      ::cudaGetDevice(&location);
+    }
+  }
+
+  cudaError_t error = ::cudaMemPrefetchAsync(um_ptr, length, location,
+      static_cast<cudaStream_t>(stream));
+
+  if (error != cudaSuccess) {
+    // Devices without concurrent managed access cannot prefetch; the copy
+    // still works, it just migrates pages on demand.
+    UMPIRE_LOG(Debug, "cudaMemPrefetchAsync( ptr = " << um_ptr
+        << ", length = " << length
+        << ", location = " << location << " ) failed with error: "
+        << cudaGetErrorString(error));
+    ::cudaGetLastError();
+    return false;
+  }
+
+  return location == cudaCpuDeviceId;
+}
+
+} // end of namespace op
+} // end of namespace umpire
@@ -0,0 +1,83 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CudaUnifiedMemoryCopyOperation_HPP
+#define UMPIRE_CudaUnifiedMemoryCopyOperation_HPP
+
+#include "umpire/op/CudaStridedCopyOperation.hpp"
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Copy operation between unified memory and host or device memory.
+ *
+ * Before copying, the unified memory range is prefetched to wherever the
+ * other side of the copy lives, so the copy does not page fault its way
+ * across the bus. Copies with host memory then finish with a host memcpy.
+ */
+class CudaUnifiedMemoryCopyOperation : public CudaStridedCopyOperation {
+ public:
+  CudaUnifiedMemoryCopyOperation();
+
+   /*!
+    * @copybrief MemoryOperation::transform
+    *
+    * Uses cudaMemPrefetchAsync followed by memcpy or cudaMemcpy.
+    *
+    * @copydetails MemoryOperation::transform
+    */
+  void transform(
+      void* src_ptr,
+      void** dst_ptr,
+      umpire::util::AllocationRecord *src_allocation,
+      umpire::util::AllocationRecord *dst_allocation,
+      size_t length);
+
+   /*!
+    * @copybrief MemoryOperation::transformAsync
+    *
+    * Uses cudaMemPrefetchAsync followed by cudaMemcpyAsync on the given
+    * cudaStream_t.
+    *
+    * @copydetails MemoryOperation::transformAsync
+    */
+  void transformAsync(
+      void* src_ptr,
+      void** dst_ptr,
+      umpire::util::AllocationRecord *src_allocation,
+      umpire::util::AllocationRecord *dst_allocation,
+      size_t length,
+      void* stream);
+
+ private:
+  /*!
+   * \brief Prefetch the unified memory side of the copy to the location
+   * of the other side.
+   *
+   * \return true if the data now lives on the host.
+   */
+  bool prefetch(
+      void* src_ptr,
+      void* dst_ptr,
+      umpire::util::AllocationRecord *src_allocation,
+      umpire::util::AllocationRecord *dst_allocation,
+      size_t length,
+      void* stream);
+};
+
+} // end of namespace op
+} // end of namespace umpire
+
+#endif // UMPIRE_CudaUnifiedMemoryCopyOperation_HPP
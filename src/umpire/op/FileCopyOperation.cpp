@@ -0,0 +1,52 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/FileCopyOperation.hpp"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+
+#include "umpire/strategy/AllocationStrategy.hpp"
+#include "umpire/util/AllocationRecord.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+void FileCopyOperation::transform(
+    void* src_ptr,
+    void** dst_ptr,
+    umpire::util::AllocationRecord* src_allocation,
+    umpire::util::AllocationRecord* dst_allocation,
+    size_t length)
+{
+  if (src_allocation->m_strategy->getResourceType() == resource::File) {
+    const uintptr_t page_size = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+    const uintptr_t start = reinterpret_cast<uintptr_t>(src_ptr) & ~(page_size - 1);
+    const uintptr_t end = reinterpret_cast<uintptr_t>(src_ptr) + length;
+
+    // Only a hint, so a failure just means the copy faults pages in
+    if (::madvise(reinterpret_cast<void*>(start), end - start, MADV_SEQUENTIAL) != 0) {
+      UMPIRE_LOG(Debug, "madvise(MADV_SEQUENTIAL) failed for " << src_ptr);
+    }
+  }
+
+  HostCopyOperation::transform(
+      src_ptr, dst_ptr, src_allocation, dst_allocation, length);
+}
+
+} // end of namespace op
+} // end of namespace umpire
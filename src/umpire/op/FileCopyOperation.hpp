@@ -0,0 +1,51 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_FileCopyOperation_HPP
+#define UMPIRE_FileCopyOperation_HPP
+
+#include "umpire/op/HostCopyOperation.hpp"
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Copy memory to or from a FILE allocation.
+ *
+ * The file-backed source range is marked MADV_SEQUENTIAL first, so the
+ * kernel reads ahead of the copy and drops pages behind it instead of
+ * faulting them in one at a time.
+ */
+class FileCopyOperation : public HostCopyOperation {
+ public:
+   /*
+    * \copybrief MemoryOperation::transform
+    *
+    * Advise the file-backed source range, then perform the copy as a
+    * HostCopyOperation.
+    *
+    * \copydetails MemoryOperation::transform
+    */
+  void transform(
+      void* src_ptr,
+      void** dst_ptr,
+      umpire::util::AllocationRecord *src_allocation,
+      umpire::util::AllocationRecord *dst_allocation,
+      size_t length);
+};
+
+} // end of naemspace op
+} //end of namespace umpire
+
+#endif // UMPIRE_FileCopyOperation_HPP
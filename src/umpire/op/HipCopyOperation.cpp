@@ -0,0 +1,111 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/HipCopyOperation.hpp"
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+HipCopyOperation::HipCopyOperation(hipMemcpyKind kind) :
+  m_kind(kind)
+{
+}
+
+void HipCopyOperation::transform(
+    void* src_ptr,
+    void** dst_ptr,
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(src_allocation),
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(dst_allocation),
+    size_t length)
+{
+  hipError_t error =
+    ::hipMemcpy(*dst_ptr, src_ptr, length, m_kind);
+
+  if (error != hipSuccess) {
+    UMPIRE_ERROR("hipMemcpy( dest_ptr = " << *dst_ptr
+      << ", src_ptr = " << src_ptr
+      << ", length = " << length
+      << ", kind = " << m_kind << " ) failed with error: "
+      << hipGetErrorString(error));
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "HipCopyOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "dst_ptr", reinterpret_cast<uintptr_t>(dst_ptr),
+      "size", length,
+      "event", "copy");
+}
+
+void HipCopyOperation::transformAsync(
+    void* src_ptr,
+    void** dst_ptr,
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(src_allocation),
+    umpire::util::AllocationRecord* UMPIRE_UNUSED_ARG(dst_allocation),
+    size_t length,
+    void* stream)
+{
+  hipError_t error =
+    ::hipMemcpyAsync(*dst_ptr, src_ptr, length, m_kind,
+        static_cast<hipStream_t>(stream));
+
+  if (error != hipSuccess) {
+    UMPIRE_ERROR("hipMemcpyAsync( dest_ptr = " << *dst_ptr
+      << ", src_ptr = " << src_ptr
+      << ", length = " << length
+      << ", kind = " << m_kind << ", stream = " << stream << " ) failed with error: "
+      << hipGetErrorString(error));
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "HipCopyOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "dst_ptr", reinterpret_cast<uintptr_t>(dst_ptr),
+      "size", length,
+      "event", "copy_async");
+}
+
+void HipCopyOperation::transformBatch(
+    void** src_ptrs,
+    void** dst_ptrs,
+    umpire::util::AllocationRecord** UMPIRE_UNUSED_ARG(src_allocations),
+    umpire::util::AllocationRecord** UMPIRE_UNUSED_ARG(dst_allocations),
+    size_t* lengths,
+    size_t count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    hipError_t error =
+      ::hipMemcpyAsync(dst_ptrs[i], src_ptrs[i], lengths[i], m_kind, 0);
+
+    if (error != hipSuccess) {
+      UMPIRE_ERROR("hipMemcpyAsync( dest_ptr = " << dst_ptrs[i]
+        << ", src_ptr = " << src_ptrs[i]
+        << ", length = " << lengths[i]
+        << ", kind = " << m_kind << " ) failed with error: "
+        << hipGetErrorString(error));
+    }
+  }
+
+  hipError_t error = ::hipStreamSynchronize(0);
+
+  if (error != hipSuccess) {
+    UMPIRE_ERROR("hipStreamSynchronize failed with error: "
+      << hipGetErrorString(error));
+  }
+}
+
+} // end of namespace op
+} // end of namespace umpire
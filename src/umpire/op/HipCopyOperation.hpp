@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_HipCopyOperation_HPP
+#define UMPIRE_HipCopyOperation_HPP
+
+#include <hip/hip_runtime_api.h>
+
+#include "umpire/op/MemoryOperation.hpp"
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Copy operation to move data to, from or between AMD GPUs.
+ *
+ * One instance is registered for each direction, with the hipMemcpyKind
+ * that describes it.
+ */
+class HipCopyOperation : public MemoryOperation {
+ public:
+  HipCopyOperation(hipMemcpyKind kind);
+
+   /*!
+    * @copybrief MemoryOperation::transform
+    *
+    * Uses hipMemcpy.
+    *
+    * @copydetails MemoryOperation::transform
+    */
+  void transform(
+      void* src_ptr,
+      void** dst_ptr,
+      umpire::util::AllocationRecord *src_allocation,
+      umpire::util::AllocationRecord *dst_allocation,
+      size_t length);
+
+   /*!
+    * @copybrief MemoryOperation::transformAsync
+    *
+    * Uses hipMemcpyAsync on the given hipStream_t.
+    *
+    * @copydetails MemoryOperation::transformAsync
+    */
+  void transformAsync(
+      void* src_ptr,
+      void** dst_ptr,
+      umpire::util::AllocationRecord *src_allocation,
+      umpire::util::AllocationRecord *dst_allocation,
+      size_t length,
+      void* stream);
+
+   /*!
+    * @copybrief MemoryOperation::transformBatch
+    *
+    * Issues every transfer with hipMemcpyAsync on the default stream and
+    * synchronizes once at the end.
+    *
+    * @copydetails MemoryOperation::transformBatch
+    */
+  void transformBatch(
+      void** src_ptrs,
+      void** dst_ptrs,
+      umpire::util::AllocationRecord** src_allocations,
+      umpire::util::AllocationRecord** dst_allocations,
+      size_t* lengths,
+      size_t count);
+
+ private:
+  hipMemcpyKind m_kind;
+};
+
+} // end of namespace op
+} // end of namespace umpire
+
+#endif // UMPIRE_HipCopyOperation_HPP
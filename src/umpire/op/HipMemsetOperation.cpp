@@ -0,0 +1,135 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/HipMemsetOperation.hpp"
+
+#include <algorithm>
+
+#include <hip/hip_runtime_api.h>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+void
+HipMemsetOperation::apply(
+    void* src_ptr,
+    util::AllocationRecord*  UMPIRE_UNUSED_ARG(allocation),
+    int value,
+    size_t length)
+{
+  hipError_t error = ::hipMemset(src_ptr, value, length);
+
+  if (error != hipSuccess) {
+    UMPIRE_ERROR("hipMemset( src_ptr = " << src_ptr
+      << ", value = " << value
+      << ", length = " << length
+      << ") failed with error: "
+      << hipGetErrorString(error));
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "HipMemsetOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "value", value,
+      "size", length,
+      "event", "memset");
+}
+
+void
+HipMemsetOperation::applyAsync(
+    void* src_ptr,
+    util::AllocationRecord*  UMPIRE_UNUSED_ARG(allocation),
+    int value,
+    size_t length,
+    void* stream)
+{
+  hipError_t error = ::hipMemsetAsync(src_ptr, value, length,
+        static_cast<hipStream_t>(stream));
+
+  if (error != hipSuccess) {
+    UMPIRE_ERROR("hipMemsetAsync( src_ptr = " << src_ptr
+      << ", value = " << value
+      << ", length = " << length
+      << ", stream = " << stream
+      << ") failed with error: "
+      << hipGetErrorString(error));
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "HipMemsetOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "value", value,
+      "size", length,
+      "event", "memset_async");
+}
+
+void
+HipMemsetOperation::fill(
+    void* src_ptr,
+    util::AllocationRecord* allocation,
+    const void* pattern,
+    size_t pattern_size,
+    size_t length)
+{
+  if (pattern_size == 1) {
+    apply(src_ptr, allocation, *static_cast<const unsigned char*>(pattern), length);
+    return;
+  }
+
+  if (length == 0) {
+    return;
+  }
+
+  char* ptr = static_cast<char*>(src_ptr);
+
+  hipError_t error = ::hipMemcpy(ptr, pattern, pattern_size, hipMemcpyDefault);
+
+  if (error != hipSuccess) {
+    UMPIRE_ERROR("hipMemcpy( dest_ptr = " << src_ptr
+      << ", src_ptr = " << pattern
+      << ", length = " << pattern_size
+      << ") failed with error: "
+      << hipGetErrorString(error));
+  }
+
+  size_t filled = pattern_size;
+
+  while (filled < length) {
+    const size_t bytes = std::min(filled, length - filled);
+
+    error = ::hipMemcpy(ptr + filled, ptr, bytes, hipMemcpyDefault);
+
+    if (error != hipSuccess) {
+      UMPIRE_ERROR("hipMemcpy( dest_ptr = " << static_cast<void*>(ptr + filled)
+        << ", src_ptr = " << src_ptr
+        << ", length = " << bytes
+        << ") failed with error: "
+        << hipGetErrorString(error));
+    }
+
+    filled += bytes;
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "HipMemsetOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "pattern_size", pattern_size,
+      "size", length,
+      "event", "fill");
+}
+
+} // end of namespace op
+} // end of namespace umpire
@@ -0,0 +1,74 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_HipMemsetOperation_HPP
+#define UMPIRE_HipMemsetOperation_HPP
+
+#include "umpire/op/MemoryOperation.hpp"
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Memset and fill on AMD device memory.
+ */
+class HipMemsetOperation : public MemoryOperation {
+ public:
+   /*!
+    * @copybrief MemoryOperation::apply
+    *
+    * Uses hipMemset to set first length bytes of src_ptr to value.
+    *
+    * @copydetails MemoryOperation::apply
+    */
+  void apply(
+      void* src_ptr,
+      util::AllocationRecord* ptr,
+      int value,
+      size_t length);
+
+   /*!
+    * @copybrief MemoryOperation::applyAsync
+    *
+    * Uses hipMemsetAsync on the given hipStream_t.
+    *
+    * @copydetails MemoryOperation::applyAsync
+    */
+  void applyAsync(
+      void* src_ptr,
+      util::AllocationRecord* ptr,
+      int value,
+      size_t length,
+      void* stream);
+
+   /*!
+    * @copybrief MemoryOperation::fill
+    *
+    * Copies the pattern once with hipMemcpy, then doubles the filled
+    * prefix with device to device copies.
+    *
+    * @copydetails MemoryOperation::fill
+    */
+  void fill(
+      void* src_ptr,
+      util::AllocationRecord* allocation,
+      const void* pattern,
+      size_t pattern_size,
+      size_t length);
+};
+
+} // end of namespace op
+} // end of namespace umpire
+
+#endif // UMPIRE_HipMemsetOperation_HPP
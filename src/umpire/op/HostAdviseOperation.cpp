@@ -0,0 +1,54 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/HostAdviseOperation.hpp"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+HostAdviseOperation::HostAdviseOperation(int advice) :
+  m_advice(advice)
+{
+}
+
+void
+HostAdviseOperation::apply(
+    void* src_ptr,
+    util::AllocationRecord* UMPIRE_UNUSED_ARG(src_allocation),
+    int UMPIRE_UNUSED_ARG(val),
+    size_t length)
+{
+  const uintptr_t page_size = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+  const uintptr_t start = reinterpret_cast<uintptr_t>(src_ptr) & ~(page_size - 1);
+  const uintptr_t end = reinterpret_cast<uintptr_t>(src_ptr) + length;
+
+  if (::madvise(reinterpret_cast<void*>(start), end - start, m_advice) != 0) {
+    UMPIRE_ERROR("madvise( src_ptr = " << src_ptr
+        << ", length = " << length
+        << ", " << m_advice << ") failed with error: "
+        << std::strerror(errno));
+  }
+}
+
+} // end of namespace op
+} // end of namespace umpire
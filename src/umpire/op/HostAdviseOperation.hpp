@@ -0,0 +1,56 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_HostAdviseOperation_HPP
+#define UMPIRE_HostAdviseOperation_HPP
+
+#include "umpire/op/MemoryOperation.hpp"
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Give the kernel a madvise hint about how CPU memory will be used.
+ *
+ * The range is widened to whole pages. This is most useful for FILE
+ * allocations, where MADV_SEQUENTIAL enables aggressive readahead,
+ * MADV_RANDOM disables it, and MADV_WILLNEED starts reading pages in.
+ */
+class HostAdviseOperation :
+  public MemoryOperation {
+public:
+  HostAdviseOperation(int advice);
+
+  /*!
+   * @copybrief MemoryOperation::apply
+   *
+   * Uses madvise to apply the advice given at construction. The val
+   * argument is ignored.
+   *
+   * @copydetails MemoryOperation::apply
+   */
+    void apply(
+        void* src_ptr,
+        util::AllocationRecord *src_allocation,
+        int val,
+        size_t length);
+
+private:
+  int m_advice;
+};
+
+} // end of namespace op
+} // end of namespace umpire
+
+#endif // UMPIRE_HostAdviseOperation_HPP
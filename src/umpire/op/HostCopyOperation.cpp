@@ -14,13 +14,73 @@
 //////////////////////////////////////////////////////////////////////////////
 #include "umpire/op/HostCopyOperation.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include "umpire/util/Macros.hpp"
 
 namespace umpire {
 namespace op {
 
+namespace {
+
+// Below this much work per thread, starting a thread costs more than it saves.
+const size_t s_min_bytes_per_thread = 4 * 1024 * 1024;
+
+// A few threads saturate memory bandwidth; more just contend.
+const unsigned int s_max_threads = 8;
+
+} // end of anonymous namespace
+
+const size_t HostCopyOperation::s_parallel_threshold;
+const size_t HostCopyOperation::s_streaming_threshold;
+
+void HostCopyOperation::copy(char* dst, const char* src, size_t length, bool streaming)
+{
+#if defined(__SSE2__)
+  if (streaming) {
+    // Copy up to a 16-byte boundary in dst, then stream whole 64-byte lines.
+    const size_t head = std::min(length,
+        static_cast<size_t>((16 - (reinterpret_cast<uintptr_t>(dst) & 15)) & 15));
+    std::memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    length -= head;
+
+    const size_t body = length & ~static_cast<size_t>(63);
+    for (size_t i = 0; i < body; i += 64) {
+      const __m128i* s = reinterpret_cast<const __m128i*>(src + i);
+      __m128i* d = reinterpret_cast<__m128i*>(dst + i);
+
+      const __m128i a = _mm_loadu_si128(s);
+      const __m128i b = _mm_loadu_si128(s + 1);
+      const __m128i c = _mm_loadu_si128(s + 2);
+      const __m128i e = _mm_loadu_si128(s + 3);
+
+      _mm_stream_si128(d, a);
+      _mm_stream_si128(d + 1, b);
+      _mm_stream_si128(d + 2, c);
+      _mm_stream_si128(d + 3, e);
+    }
+    _mm_sfence();
+
+    std::memcpy(dst + body, src + body, length - body);
+    return;
+  }
+#else
+  (void) streaming;
+#endif
+
+  std::memcpy(dst, src, length);
+}
+
 void HostCopyOperation::transform(
     void* src_ptr,
     void** dst_ptr,
@@ -28,10 +88,38 @@ void HostCopyOperation::transform(
     util::AllocationRecord* UMPIRE_UNUSED_ARG(dst_allocation),
     size_t length)
 {
-  std::memcpy(
-      *dst_ptr,
-      src_ptr,
-      length);
+  char* dst = static_cast<char*>(*dst_ptr);
+  const char* src = static_cast<const char*>(src_ptr);
+
+  if (length < s_parallel_threshold) {
+    std::memcpy(dst, src, length);
+  } else {
+    const bool streaming = (length > s_streaming_threshold);
+
+    const unsigned int hardware_threads =
+      std::max(std::thread::hardware_concurrency(), 1u);
+    const size_t num_threads = std::min<size_t>(
+        std::min(hardware_threads, s_max_threads),
+        length / s_min_bytes_per_thread);
+
+    // Split on cache-line boundaries; the calling thread takes the last part.
+    const size_t part = ((length / num_threads) + 63) & ~static_cast<size_t>(63);
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+
+    for (size_t i = 0; i < num_threads - 1; ++i) {
+      threads.push_back(std::thread(copy,
+            dst + i*part, src + i*part, part, streaming));
+    }
+
+    const size_t offset = (num_threads - 1)*part;
+    copy(dst + offset, src + offset, length - offset, streaming);
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
 
   UMPIRE_RECORD_STATISTIC(
       "HostCopyOperation",
@@ -41,5 +129,74 @@ void HostCopyOperation::transform(
       "event", "copy");
 }
 
+void HostCopyOperation::transformStrided(
+    void* src_ptr,
+    void* dst_ptr,
+    util::AllocationRecord* src_allocation,
+    util::AllocationRecord* dst_allocation,
+    size_t width,
+    size_t height,
+    size_t depth,
+    size_t src_pitch,
+    size_t src_height,
+    size_t dst_pitch,
+    size_t dst_height)
+{
+  const size_t rows = height*depth;
+  const size_t length = width*rows;
+
+  if (src_pitch == width && dst_pitch == width
+      && (depth == 1 || (src_height == height && dst_height == height))) {
+    transform(src_ptr, &dst_ptr, src_allocation, dst_allocation, length);
+    return;
+  }
+
+  char* dst = static_cast<char*>(dst_ptr);
+  const char* src = static_cast<const char*>(src_ptr);
+
+  // Copy rows [first, last) of the block, numbered slice by slice.
+  auto copy_rows = [=] (size_t first, size_t last) {
+    for (size_t r = first; r < last; ++r) {
+      const size_t k = r / height;
+      const size_t j = r % height;
+      std::memcpy(dst + (k*dst_height + j)*dst_pitch,
+          src + (k*src_height + j)*src_pitch, width);
+    }
+  };
+
+  if (length < s_parallel_threshold) {
+    copy_rows(0, rows);
+  } else {
+    const unsigned int hardware_threads =
+      std::max(std::thread::hardware_concurrency(), 1u);
+    const size_t num_threads = std::min<size_t>(
+        std::min<size_t>(std::min(hardware_threads, s_max_threads), rows),
+        length / s_min_bytes_per_thread);
+
+    const size_t part = (rows + num_threads - 1) / num_threads;
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+
+    for (size_t i = 0; i < num_threads - 1; ++i) {
+      threads.push_back(std::thread(copy_rows,
+            i*part, std::min(rows, (i + 1)*part)));
+    }
+
+    copy_rows(std::min(rows, (num_threads - 1)*part), rows);
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "HostCopyOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "dst_ptr", reinterpret_cast<uintptr_t>(dst_ptr),
+      "size", length,
+      "event", "copy_strided");
+}
+
 } // end of namespace op
 } // end of namespace umpire
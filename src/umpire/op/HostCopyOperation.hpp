@@ -22,9 +22,17 @@ namespace op {
 
 /*!
  * \brief Copy memory between two allocations in CPU memory.
+ *
+ * Copies of at least s_parallel_threshold bytes are split across several
+ * threads, since one core cannot saturate memory bandwidth. Copies larger
+ * than s_streaming_threshold, which would only evict the cache, also use
+ * non-temporal stores where the target supports them.
  */
 class HostCopyOperation : public MemoryOperation {
  public:
+  static const size_t s_parallel_threshold = 16 * 1024 * 1024;
+  static const size_t s_streaming_threshold = 32 * 1024 * 1024;
+
    /*
     * \copybrief MemoryOperation::transform
     *
@@ -38,6 +46,31 @@ class HostCopyOperation : public MemoryOperation {
       umpire::util::AllocationRecord *src_allocation,
       umpire::util::AllocationRecord *dst_allocation,
       size_t length);
+
+   /*
+    * \copybrief MemoryOperation::transformStrided
+    *
+    * Blocks that are contiguous in both arrays are copied by transform.
+    * Otherwise each row is copied with a memcpy, with the rows split across
+    * threads once the block reaches s_parallel_threshold bytes.
+    *
+    * \copydetails MemoryOperation::transformStrided
+    */
+  void transformStrided(
+      void* src_ptr,
+      void* dst_ptr,
+      umpire::util::AllocationRecord *src_allocation,
+      umpire::util::AllocationRecord *dst_allocation,
+      size_t width,
+      size_t height,
+      size_t depth,
+      size_t src_pitch,
+      size_t src_height,
+      size_t dst_pitch,
+      size_t dst_height);
+
+ private:
+  static void copy(char* dst, const char* src, size_t length, bool streaming);
 };
 
 } // end of naemspace op
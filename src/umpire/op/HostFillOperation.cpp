@@ -0,0 +1,94 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/HostFillOperation.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+namespace {
+
+template <typename T>
+bool fillTyped(void* ptr, const void* pattern, size_t length)
+{
+  if (reinterpret_cast<uintptr_t>(ptr) % sizeof(T) != 0) {
+    return false;
+  }
+
+  T value;
+  std::memcpy(&value, pattern, sizeof(T));
+  std::fill_n(static_cast<T*>(ptr), length / sizeof(T), value);
+
+  return true;
+}
+
+} // end of anonymous namespace
+
+void
+HostFillOperation::fill(
+    void* src_ptr,
+    util::AllocationRecord* UMPIRE_UNUSED_ARG(allocation),
+    const void* pattern,
+    size_t pattern_size,
+    size_t length)
+{
+  bool done = false;
+
+  switch (pattern_size) {
+    case 1:
+      std::memset(src_ptr, *static_cast<const unsigned char*>(pattern), length);
+      done = true;
+      break;
+    case 2:
+      done = fillTyped<uint16_t>(src_ptr, pattern, length);
+      break;
+    case 4:
+      done = fillTyped<uint32_t>(src_ptr, pattern, length);
+      break;
+    case 8:
+      done = fillTyped<uint64_t>(src_ptr, pattern, length);
+      break;
+    default:
+      break;
+  }
+
+  if (!done && length > 0) {
+    char* ptr = static_cast<char*>(src_ptr);
+    size_t filled = pattern_size;
+
+    std::memcpy(ptr, pattern, pattern_size);
+
+    while (filled < length) {
+      const size_t bytes = std::min(filled, length - filled);
+      std::memcpy(ptr + filled, ptr, bytes);
+      filled += bytes;
+    }
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "HostFillOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "pattern_size", pattern_size,
+      "size", length,
+      "event", "fill");
+}
+
+} // end of namespace op
+} // end of namespace umpire
@@ -0,0 +1,48 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_HostFillOperation_HPP
+#define UMPIRE_HostFillOperation_HPP
+
+#include "umpire/op/MemoryOperation.hpp"
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Fill an allocation in CPU memory with a repeated pattern.
+ *
+ * Aligned 2, 4 and 8 byte patterns are stored with a typed loop that the
+ * compiler vectorizes; single bytes use std::memset. Any other pattern is
+ * copied once and the filled region is then doubled with std::memcpy.
+ */
+class HostFillOperation : public MemoryOperation {
+ public:
+   /*!
+    * \copybrief MemoryOperation::fill
+    *
+    * \copydetails MemoryOperation::fill
+    */
+  void fill(
+      void* src_ptr,
+      util::AllocationRecord* allocation,
+      const void* pattern,
+      size_t pattern_size,
+      size_t length);
+};
+
+} // end of namespace op
+} // end of namespace umpire
+
+#endif // UMPIRE_HostFillOperation_HPP
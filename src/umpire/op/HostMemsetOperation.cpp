@@ -14,13 +14,36 @@
 //////////////////////////////////////////////////////////////////////////////
 #include "umpire/op/HostMemsetOperation.hpp"
 
+#include <algorithm>
 #include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 #include "umpire/util/Macros.hpp"
 
 namespace umpire {
 namespace op {
 
+namespace {
+
+const size_t s_page_size = 4096;
+
+void memsetPages(char* ptr, int value, size_t length, size_t part, size_t index)
+{
+  const size_t begin = std::min(length, index*part);
+  const size_t end = std::min(length, begin + part);
+
+  std::memset(ptr + begin, value, end - begin);
+}
+
+} // end of anonymous namespace
+
+const size_t HostMemsetOperation::s_parallel_threshold;
+
 void
 HostMemsetOperation::apply(
     void* src_ptr,
@@ -28,7 +51,38 @@ HostMemsetOperation::apply(
     int value,
     size_t length)
 {
-  std::memset(src_ptr, value, length);
+  char* ptr = static_cast<char*>(src_ptr);
+
+  if (length < s_parallel_threshold) {
+    std::memset(ptr, value, length);
+  } else {
+#if defined(_OPENMP)
+#pragma omp parallel
+    {
+      const size_t num_threads = omp_get_num_threads();
+      const size_t num_pages = (length + s_page_size - 1) / s_page_size;
+      const size_t part = ((num_pages + num_threads - 1) / num_threads) * s_page_size;
+
+      memsetPages(ptr, value, length, part, omp_get_thread_num());
+    }
+#else
+    const size_t num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    const size_t num_pages = (length + s_page_size - 1) / s_page_size;
+    const size_t part = ((num_pages + num_threads - 1) / num_threads) * s_page_size;
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+
+    for (size_t i = 1; i < num_threads; ++i) {
+      threads.push_back(std::thread(memsetPages, ptr, value, length, part, i));
+    }
+    memsetPages(ptr, value, length, part, 0);
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+#endif
+  }
 
   UMPIRE_RECORD_STATISTIC(
       "HostMemsetOperation",
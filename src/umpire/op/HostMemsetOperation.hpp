@@ -22,9 +22,18 @@ namespace op {
 
 /*!
  * \brief Memset an allocation in CPU memory.
+ *
+ * Memsets of at least s_parallel_threshold bytes are divided page by page
+ * among threads. When built with OpenMP, the pages are split with a static
+ * schedule over the OpenMP thread team, so on first touch each page is
+ * placed on the NUMA node of the thread that a statically scheduled OpenMP
+ * loop over the same data will later read it from. Thread placement follows
+ * OMP_PROC_BIND and OMP_PLACES.
  */
 class HostMemsetOperation : public MemoryOperation {
  public:
+  static const size_t s_parallel_threshold = 4 * 1024 * 1024;
+
    /*!
     * \copybrief MemoryOperation::apply
     *
@@ -17,6 +17,8 @@
 #include <cstdlib>
 
 #include "umpire/ResourceManager.hpp"
+#include "umpire/alloc/MallocAllocator.hpp"
+#include "umpire/resource/DefaultMemoryResource.hpp"
 #include "umpire/util/Macros.hpp"
 
 namespace umpire {
@@ -25,12 +27,19 @@ namespace op {
 void HostReallocateOperation::transform(
     void* src_ptr,
     void** dst_ptr,
-    util::AllocationRecord* UMPIRE_UNUSED_ARG(src_allocation),
+    util::AllocationRecord* src_allocation,
     util::AllocationRecord *dst_allocation,
     size_t length)
 {
   auto allocator = dst_allocation->m_strategy;
 
+  // Only memory that came straight from malloc may be passed to realloc.
+  if (!dynamic_cast<resource::DefaultMemoryResource<alloc::MallocAllocator>*>(allocator)) {
+    GenericReallocateOperation::transform(
+        src_ptr, dst_ptr, src_allocation, dst_allocation, length);
+    return;
+  }
+
   ResourceManager::getInstance().deregisterAllocation(src_ptr);
 
   *dst_ptr = ::realloc(src_ptr, length);
@@ -44,7 +53,7 @@ void HostReallocateOperation::transform(
 
   ResourceManager::getInstance().registerAllocation(
       *dst_ptr,
-      new util::AllocationRecord{*dst_ptr, length, allocator});
+      {*dst_ptr, length, allocator});
 }
 
 } // end of namespace op
@@ -15,7 +15,7 @@
 #ifndef UMPIRE_HostReallocateOperation_HPP
 #define UMPIRE_HostReallocateOperation_HPP
 
-#include "umpire/op/MemoryOperation.hpp"
+#include "umpire/op/GenericReallocateOperation.hpp"
 
 namespace umpire {
 namespace op {
@@ -24,12 +24,14 @@ namespace op {
  * \brief Reallocate data in CPU memory.
  */
 class HostReallocateOperation : 
-  public MemoryOperation {
+  public GenericReallocateOperation {
  public:
   /*!
    * \copybrief MemoryOperation::transform
    *
-   * Uses POSIX realloc to reallocate memory in the CPU memory.
+   * Uses POSIX realloc to reallocate memory obtained directly from the
+   * malloc-based HOST resource. Memory from any other CPU strategy, e.g. a
+   * pool, is reallocated by allocating, copying and freeing.
    *
    * \copydetails MemoryOperation::transform
    */
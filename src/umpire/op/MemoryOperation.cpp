@@ -40,6 +40,125 @@ MemoryOperation::apply(
   UMPIRE_ERROR("MemoryOperation::apply() is not implemented");
 }
 
+void
+MemoryOperation::transformBatch(
+    void** src_ptrs,
+    void** dst_ptrs,
+    util::AllocationRecord** src_allocations,
+    util::AllocationRecord** dst_allocations,
+    size_t* lengths,
+    size_t count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    transform(src_ptrs[i], &dst_ptrs[i],
+        src_allocations[i], dst_allocations[i], lengths[i]);
+  }
+}
+
+void
+MemoryOperation::transformBatchAsync(
+    void** src_ptrs,
+    void** dst_ptrs,
+    util::AllocationRecord** src_allocations,
+    util::AllocationRecord** dst_allocations,
+    size_t* lengths,
+    size_t count,
+    void* UMPIRE_UNUSED_ARG(stream))
+{
+  transformBatch(src_ptrs, dst_ptrs, src_allocations, dst_allocations, lengths, count);
+}
+
+void
+MemoryOperation::transformAsync(
+    void* src_ptr,
+    void** dst_ptr,
+    util::AllocationRecord* src_allocation,
+    util::AllocationRecord* dst_allocation,
+    size_t length,
+    void* UMPIRE_UNUSED_ARG(stream))
+{
+  transform(src_ptr, dst_ptr, src_allocation, dst_allocation, length);
+}
+
+void
+MemoryOperation::transformStrided(
+    void* src_ptr,
+    void* dst_ptr,
+    util::AllocationRecord* src_allocation,
+    util::AllocationRecord* dst_allocation,
+    size_t width,
+    size_t height,
+    size_t depth,
+    size_t src_pitch,
+    size_t src_height,
+    size_t dst_pitch,
+    size_t dst_height)
+{
+  char* src = static_cast<char*>(src_ptr);
+  char* dst = static_cast<char*>(dst_ptr);
+
+  for (size_t k = 0; k < depth; ++k) {
+    for (size_t j = 0; j < height; ++j) {
+      void* dst_row = dst + (k*dst_height + j)*dst_pitch;
+      transform(src + (k*src_height + j)*src_pitch, &dst_row,
+          src_allocation, dst_allocation, width);
+    }
+  }
+}
+
+void
+MemoryOperation::transformStridedAsync(
+    void* src_ptr,
+    void* dst_ptr,
+    util::AllocationRecord* src_allocation,
+    util::AllocationRecord* dst_allocation,
+    size_t width,
+    size_t height,
+    size_t depth,
+    size_t src_pitch,
+    size_t src_height,
+    size_t dst_pitch,
+    size_t dst_height,
+    void* UMPIRE_UNUSED_ARG(stream))
+{
+  transformStrided(src_ptr, dst_ptr, src_allocation, dst_allocation,
+      width, height, depth, src_pitch, src_height, dst_pitch, dst_height);
+}
+
+void
+MemoryOperation::applyAsync(
+    void* src_ptr,
+    util::AllocationRecord* src_allocation,
+    int val,
+    size_t length,
+    void* UMPIRE_UNUSED_ARG(stream))
+{
+  apply(src_ptr, src_allocation, val, length);
+}
+
+void
+MemoryOperation::fill(
+    void* UMPIRE_UNUSED_ARG(src_ptr),
+    util::AllocationRecord* UMPIRE_UNUSED_ARG(src_allocation),
+    const void* UMPIRE_UNUSED_ARG(pattern),
+    size_t UMPIRE_UNUSED_ARG(pattern_size),
+    size_t UMPIRE_UNUSED_ARG(length))
+{
+  UMPIRE_ERROR("MemoryOperation::fill() is not implemented");
+}
+
+void
+MemoryOperation::fillAsync(
+    void* src_ptr,
+    util::AllocationRecord* src_allocation,
+    const void* pattern,
+    size_t pattern_size,
+    size_t length,
+    void* UMPIRE_UNUSED_ARG(stream))
+{
+  fill(src_ptr, src_allocation, pattern, pattern_size, length);
+}
+
 
 
 } // end of namespace op
@@ -25,8 +25,8 @@ namespace op {
 /*!
  * \brief Base class of an operation on memory.
  *
- * Neither the transfrom or apply methods are pure virtual, so inheriting
- * classes only need overload the appropriate method. However, both methods
+ * Neither the transfrom, apply or fill methods are pure virtual, so inheriting
+ * classes only need overload the appropriate method. However, all of them
  * will throw an error if called.
  */
 class MemoryOperation {
@@ -64,6 +64,206 @@ class MemoryOperation {
         util::AllocationRecord *src_allocation,
         int val,
         size_t length);
+
+    /*!
+     * \brief Transform a batch of count independent transfers.
+     *
+     * Transfer i moves lengths[i] bytes from src_ptrs[i] to dst_ptrs[i]; all
+     * transfers share the same pair of platforms. The default
+     * implementation calls transform for each one. Operations that can
+     * amortize per-call costs override it, but must complete every transfer
+     * before returning.
+     *
+     * \param src_ptrs Pointers to source memory locations.
+     * \param dst_ptrs Pointers to destination memory locations.
+     * \param src_allocations AllocationRecords of sources.
+     * \param dst_allocations AllocationRecords of destinations.
+     * \param lengths Number of bytes to transform for each transfer.
+     * \param count Number of transfers.
+     *
+     * \throws util::Exception
+     */
+    virtual void transformBatch(
+        void** src_ptrs,
+        void** dst_ptrs,
+        util::AllocationRecord** src_allocations,
+        util::AllocationRecord** dst_allocations,
+        size_t* lengths,
+        size_t count);
+
+    /*!
+     * \brief Transform a batch of count independent transfers, ordered on
+     * stream.
+     *
+     * The default implementation calls transformBatch, so the transfers
+     * have completed when this method returns. Operations that can run
+     * asynchronously override it and may return before the data has moved.
+     *
+     * \copydetails MemoryOperation::transformBatch
+     * \param stream Stream to order the transfers on (a cudaStream_t for
+     * CUDA operations).
+     */
+    virtual void transformBatchAsync(
+        void** src_ptrs,
+        void** dst_ptrs,
+        util::AllocationRecord** src_allocations,
+        util::AllocationRecord** dst_allocations,
+        size_t* lengths,
+        size_t count,
+        void* stream);
+
+    /*!
+     * \brief Transform length bytes of memory from src_ptr to dst_ptr,
+     * ordered on stream.
+     *
+     * The default implementation calls transform, so the operation has
+     * completed when this method returns. Operations that can run
+     * asynchronously override it and may return before the data has moved.
+     *
+     * \param src_ptr Pointer to source memory location.
+     * \param dst_ptr Pointer to destinatino memory location.
+     * \param src_allocation AllocationRecord of source.
+     * \param dst_allocation AllocationRecord of destination.
+     * \param length Number of bytes to transform.
+     * \param stream Stream to order the operation on (a cudaStream_t for
+     * CUDA operations).
+     *
+     * \throws util::Exception
+     */
+    virtual void transformAsync(
+        void* src_ptr,
+        void** dst_ptr,
+        util::AllocationRecord *src_allocation,
+        util::AllocationRecord *dst_allocation,
+        size_t length,
+        void* stream);
+
+    /*!
+     * \brief Transform a width x height x depth block of memory between two
+     * pitched arrays.
+     *
+     * Each array is laid out as depth slices of rows, with rows pitch bytes
+     * apart and slices pitch*height bytes apart, where height is the number
+     * of rows per slice of the whole array rather than of the block. Row j
+     * of slice k of the block starts at ptr + (k*height + j)*pitch. The
+     * default implementation calls transform once per row.
+     *
+     * \param src_ptr Pointer to the first byte of the source block.
+     * \param dst_ptr Pointer to the first byte of the destination block.
+     * \param src_allocation AllocationRecord of source.
+     * \param dst_allocation AllocationRecord of destination.
+     * \param width Number of bytes to transform in each row.
+     * \param height Number of rows to transform in each slice.
+     * \param depth Number of slices to transform.
+     * \param src_pitch Bytes between rows of the source.
+     * \param src_height Rows per slice of the source.
+     * \param dst_pitch Bytes between rows of the destination.
+     * \param dst_height Rows per slice of the destination.
+     *
+     * \throws util::Exception
+     */
+    virtual void transformStrided(
+        void* src_ptr,
+        void* dst_ptr,
+        util::AllocationRecord *src_allocation,
+        util::AllocationRecord *dst_allocation,
+        size_t width,
+        size_t height,
+        size_t depth,
+        size_t src_pitch,
+        size_t src_height,
+        size_t dst_pitch,
+        size_t dst_height);
+
+    /*!
+     * \brief Transform a block of memory between two pitched arrays, ordered
+     * on stream.
+     *
+     * The default implementation calls transformStrided.
+     *
+     * \copydetails MemoryOperation::transformStrided
+     * \param stream Stream to order the operation on (a cudaStream_t for
+     * CUDA operations).
+     */
+    virtual void transformStridedAsync(
+        void* src_ptr,
+        void* dst_ptr,
+        util::AllocationRecord *src_allocation,
+        util::AllocationRecord *dst_allocation,
+        size_t width,
+        size_t height,
+        size_t depth,
+        size_t src_pitch,
+        size_t src_height,
+        size_t dst_pitch,
+        size_t dst_height,
+        void* stream);
+
+    /*!
+     * \brief Apply val to the first length bytes of src_ptr, ordered on
+     * stream.
+     *
+     * The default implementation calls apply.
+     *
+     * \param src_ptr Pointer to source memory location.
+     * \param src_allocation AllocationRecord of source.
+     * \param val Value to apply.
+     * \param length Number of bytes to modify.
+     * \param stream Stream to order the operation on (a cudaStream_t for
+     * CUDA operations).
+     *
+     * \throws util::Exception
+     */
+    virtual void applyAsync(
+        void* src_ptr,
+        util::AllocationRecord *src_allocation,
+        int val,
+        size_t length,
+        void* stream);
+
+    /*!
+     * \brief Fill the first length bytes of src_ptr with repeated copies of
+     * pattern.
+     *
+     * \param src_ptr Pointer to source memory location.
+     * \param src_allocation AllocationRecord of source.
+     * \param pattern Pointer to the pattern, which is in host memory.
+     * \param pattern_size Size of the pattern in bytes.
+     * \param length Number of bytes to modify, a multiple of pattern_size.
+     *
+     * \throws util::Exception
+     */
+    virtual void fill(
+        void* src_ptr,
+        util::AllocationRecord *src_allocation,
+        const void* pattern,
+        size_t pattern_size,
+        size_t length);
+
+    /*!
+     * \brief Fill the first length bytes of src_ptr with repeated copies of
+     * pattern, ordered on stream.
+     *
+     * The default implementation calls fill. pattern may be reused as soon
+     * as this method returns.
+     *
+     * \param src_ptr Pointer to source memory location.
+     * \param src_allocation AllocationRecord of source.
+     * \param pattern Pointer to the pattern, which is in host memory.
+     * \param pattern_size Size of the pattern in bytes.
+     * \param length Number of bytes to modify, a multiple of pattern_size.
+     * \param stream Stream to order the operation on (a cudaStream_t for
+     * CUDA operations).
+     *
+     * \throws util::Exception
+     */
+    virtual void fillAsync(
+        void* src_ptr,
+        util::AllocationRecord *src_allocation,
+        const void* pattern,
+        size_t pattern_size,
+        size_t length,
+        void* stream);
 };
 
 } // end of namespace op
@@ -14,9 +14,16 @@
 //////////////////////////////////////////////////////////////////////////////
 #include "umpire/config.hpp"
 
+#include <sys/mman.h>
+
+#include <exception>
+
 #include "umpire/op/MemoryOperationRegistry.hpp"
 
+#include "umpire/op/HostAdviseOperation.hpp"
 #include "umpire/op/HostCopyOperation.hpp"
+#include "umpire/op/FileCopyOperation.hpp"
+#include "umpire/op/HostFillOperation.hpp"
 #include "umpire/op/HostMemsetOperation.hpp"
 #include "umpire/op/HostReallocateOperation.hpp"
 
@@ -25,15 +32,35 @@
 #if defined(UMPIRE_ENABLE_CUDA)
 #include "umpire/op/CudaCopyFromOperation.hpp"
 #include "umpire/op/CudaCopyToOperation.hpp"
-#include "umpire/op/CudaCopyOperation.hpp"
+#include "umpire/op/CudaFileCopyOperation.hpp"
+#include "umpire/op/CudaPeerCopyOperation.hpp"
+#include "umpire/op/CudaPinnedCopyOperation.hpp"
+#include "umpire/op/CudaUnifiedMemoryCopyOperation.hpp"
 
+#include "umpire/op/CudaFillOperation.hpp"
 #include "umpire/op/CudaMemsetOperation.hpp"
 
 #include "umpire/op/CudaAdviseAccessedByOperation.hpp"
 #include "umpire/op/CudaAdvisePreferredLocationOperation.hpp"
 #include "umpire/op/CudaAdviseReadMostlyOperation.hpp"
+#include "umpire/op/CudaAdvisePersistingL2Operation.hpp"
+#include "umpire/op/CudaMemPrefetchOperation.hpp"
+#endif
+
+#if defined(UMPIRE_ENABLE_NVCOMP)
+#include "umpire/op/CudaCompressedCopyOperation.hpp"
+#endif
+
+#if defined(UMPIRE_ENABLE_HIP)
+#include "umpire/op/HipCopyOperation.hpp"
+#include "umpire/op/HipMemsetOperation.hpp"
 #endif
 
+#if defined(UMPIRE_ENABLE_OPENMP_TARGET)
+#include "umpire/op/OpenMPTargetCopyOperation.hpp"
+#endif
+
+#include "umpire/util/AllocatorStatistics.hpp"
 #include "umpire/util/Macros.hpp"
 
 namespace umpire {
@@ -55,6 +82,18 @@ MemoryOperationRegistry::getInstance()
 
 MemoryOperationRegistry::MemoryOperationRegistry()
 {
+  for (std::size_t i = 0; i < s_num_operation_types; ++i) {
+    for (std::size_t j = 0; j < s_num_platforms; ++j) {
+      for (std::size_t k = 0; k < s_num_platforms; ++k) {
+        m_operation_table[i][j][k] = nullptr;
+
+        m_counters[i][j][k].calls.store(0);
+        m_counters[i][j][k].bytes.store(0);
+        m_counters[i][j][k].nanoseconds.store(0);
+      }
+    }
+  }
+
   registerOperation(
       "COPY",
       std::make_pair(Platform::cpu, Platform::cpu),
@@ -65,11 +104,49 @@ MemoryOperationRegistry::MemoryOperationRegistry()
       std::make_pair(Platform::cpu, Platform::cpu),
       std::make_shared<HostMemsetOperation>());
 
+  registerOperation(
+      "FILL",
+      std::make_pair(Platform::cpu, Platform::cpu),
+      std::make_shared<HostFillOperation>());
+
   registerOperation(
       "REALLOCATE",
       std::make_pair(Platform::cpu, Platform::cpu),
       std::make_shared<HostReallocateOperation>());
 
+  registerOperation(
+      "MADV_SEQUENTIAL",
+      std::make_pair(Platform::cpu, Platform::cpu),
+      std::make_shared<HostAdviseOperation>(MADV_SEQUENTIAL));
+
+  registerOperation(
+      "MADV_RANDOM",
+      std::make_pair(Platform::cpu, Platform::cpu),
+      std::make_shared<HostAdviseOperation>(MADV_RANDOM));
+
+  registerOperation(
+      "MADV_WILLNEED",
+      std::make_pair(Platform::cpu, Platform::cpu),
+      std::make_shared<HostAdviseOperation>(MADV_WILLNEED));
+
+  /*
+   * Copies out of a file are advised for sequential readahead first.
+   */
+  registerOperation(
+      MemoryOperationType::copy,
+      std::make_pair(resource::File, resource::Host),
+      std::make_shared<FileCopyOperation>());
+
+  registerOperation(
+      MemoryOperationType::copy,
+      std::make_pair(resource::Host, resource::File),
+      std::make_shared<FileCopyOperation>());
+
+  registerOperation(
+      MemoryOperationType::copy,
+      std::make_pair(resource::File, resource::File),
+      std::make_shared<FileCopyOperation>());
+
 #if defined(UMPIRE_ENABLE_CUDA)
   registerOperation(
       "COPY",
@@ -84,13 +161,18 @@ MemoryOperationRegistry::MemoryOperationRegistry()
   registerOperation(
       "COPY",
       std::make_pair(Platform::cuda, Platform::cuda),
-      std::make_shared<CudaCopyOperation>());
+      std::make_shared<CudaPeerCopyOperation>());
 
   registerOperation(
       "MEMSET",
       std::make_pair(Platform::cuda, Platform::cuda),
       std::make_shared<CudaMemsetOperation>());
 
+  registerOperation(
+      "FILL",
+      std::make_pair(Platform::cuda, Platform::cuda),
+      std::make_shared<CudaFillOperation>());
+
   registerOperation(
       "REALLOCATE",
       std::make_pair(Platform::cuda, Platform::cuda),
@@ -116,7 +198,183 @@ MemoryOperationRegistry::MemoryOperationRegistry()
       std::make_pair(Platform::cuda, Platform::cuda),
       std::make_shared<CudaAdviseReadMostlyOperation>());
 
+  registerOperation(
+      "PERSISTING_L2",
+      std::make_pair(Platform::cuda, Platform::cuda),
+      std::make_shared<CudaAdvisePersistingL2Operation>());
+
+  registerOperation(
+      "PREFETCH",
+      std::make_pair(Platform::cuda, Platform::cuda),
+      std::make_shared<CudaMemPrefetchOperation>());
+
+  /*
+   * Pinned memory is host memory, so copies that stay on the host skip the
+   * CUDA runtime entirely, and copies to the GPU need no staging.
+   */
+  registerOperation(
+      MemoryOperationType::copy,
+      std::make_pair(resource::PinnedMemory, resource::Host),
+      std::make_shared<HostCopyOperation>());
+
+  registerOperation(
+      MemoryOperationType::copy,
+      std::make_pair(resource::Host, resource::PinnedMemory),
+      std::make_shared<HostCopyOperation>());
+
+  registerOperation(
+      MemoryOperationType::copy,
+      std::make_pair(resource::PinnedMemory, resource::PinnedMemory),
+      std::make_shared<HostCopyOperation>());
+
+  registerOperation(
+      MemoryOperationType::memset,
+      std::make_pair(resource::PinnedMemory, resource::PinnedMemory),
+      std::make_shared<HostMemsetOperation>());
+
+  registerOperation(
+      MemoryOperationType::fill,
+      std::make_pair(resource::PinnedMemory, resource::PinnedMemory),
+      std::make_shared<HostFillOperation>());
+
+  registerOperation(
+      MemoryOperationType::copy,
+      std::make_pair(resource::PinnedMemory, resource::Device),
+      std::make_shared<CudaPinnedCopyOperation>());
+
+  registerOperation(
+      MemoryOperationType::copy,
+      std::make_pair(resource::Device, resource::PinnedMemory),
+      std::make_shared<CudaPinnedCopyOperation>());
+
+  /*
+   * Unified memory is prefetched to the other side of the copy first.
+   */
+  registerOperation(
+      MemoryOperationType::copy,
+      std::make_pair(resource::UnifiedMemory, resource::Host),
+      std::make_shared<CudaUnifiedMemoryCopyOperation>());
+
+  registerOperation(
+      MemoryOperationType::copy,
+      std::make_pair(resource::Host, resource::UnifiedMemory),
+      std::make_shared<CudaUnifiedMemoryCopyOperation>());
+
+  registerOperation(
+      MemoryOperationType::copy,
+      std::make_pair(resource::UnifiedMemory, resource::Device),
+      std::make_shared<CudaUnifiedMemoryCopyOperation>());
+
+  registerOperation(
+      MemoryOperationType::copy,
+      std::make_pair(resource::Device, resource::UnifiedMemory),
+      std::make_shared<CudaUnifiedMemoryCopyOperation>());
+
+  /*
+   * FILE allocations are read and written by GPUDirect Storage when it is
+   * available, without a copy through host memory.
+   */
+  auto file_copy = std::make_shared<CudaFileCopyOperation>();
+
+  registerOperation(
+      MemoryOperationType::copy,
+      std::make_pair(resource::File, resource::Device),
+      file_copy);
+
+  registerOperation(
+      MemoryOperationType::copy,
+      std::make_pair(resource::Device, resource::File),
+      file_copy);
+#endif
+
+#if defined(UMPIRE_ENABLE_HIP)
+  registerOperation(
+      "COPY",
+      std::make_pair(Platform::cpu, Platform::hip),
+      std::make_shared<HipCopyOperation>(hipMemcpyHostToDevice));
+
+  registerOperation(
+      "COPY",
+      std::make_pair(Platform::hip, Platform::cpu),
+      std::make_shared<HipCopyOperation>(hipMemcpyDeviceToHost));
+
+  registerOperation(
+      "COPY",
+      std::make_pair(Platform::hip, Platform::hip),
+      std::make_shared<HipCopyOperation>(hipMemcpyDefault));
+
+  registerOperation(
+      "MEMSET",
+      std::make_pair(Platform::hip, Platform::hip),
+      std::make_shared<HipMemsetOperation>());
+
+  registerOperation(
+      "FILL",
+      std::make_pair(Platform::hip, Platform::hip),
+      std::make_shared<HipMemsetOperation>());
+
+  registerOperation(
+      "REALLOCATE",
+      std::make_pair(Platform::hip, Platform::hip),
+      std::make_shared<GenericReallocateOperation>());
+
+  /*
+   * Pinned memory is host memory, so copies that stay on the host skip the
+   * HIP runtime.
+   */
+  registerOperation(
+      MemoryOperationType::copy,
+      std::make_pair(resource::PinnedMemory, resource::Host),
+      std::make_shared<HostCopyOperation>());
+
+  registerOperation(
+      MemoryOperationType::copy,
+      std::make_pair(resource::Host, resource::PinnedMemory),
+      std::make_shared<HostCopyOperation>());
+#endif
+
+#if defined(UMPIRE_ENABLE_OPENMP_TARGET)
+  registerOperation(
+      "COPY",
+      std::make_pair(Platform::cpu, Platform::omp_target),
+      std::make_shared<OpenMPTargetCopyOperation>());
+
+  registerOperation(
+      "COPY",
+      std::make_pair(Platform::omp_target, Platform::cpu),
+      std::make_shared<OpenMPTargetCopyOperation>());
+
+  registerOperation(
+      "COPY",
+      std::make_pair(Platform::omp_target, Platform::omp_target),
+      std::make_shared<OpenMPTargetCopyOperation>());
+
+  registerOperation(
+      "REALLOCATE",
+      std::make_pair(Platform::omp_target, Platform::omp_target),
+      std::make_shared<GenericReallocateOperation>());
+#endif
+
+#if defined(UMPIRE_ENABLE_NVCOMP)
+  registerOperation(
+      "COPY_COMPRESSED",
+      std::make_pair(Platform::cpu, Platform::cuda),
+      std::make_shared<CudaCompressedCopyOperation>(cudaMemcpyHostToDevice));
+
+  registerOperation(
+      "COPY_COMPRESSED",
+      std::make_pair(Platform::cuda, Platform::cpu),
+      std::make_shared<CudaCompressedCopyOperation>(cudaMemcpyDeviceToHost));
 #endif
+
+  /*
+   * Compression only pays off across a bus, so every other pair that can
+   * be copied at all uses its plain copy for COPY_COMPRESSED.
+   */
+  auto& compressed = m_operators["COPY_COMPRESSED"];
+  for (const auto& copy : m_operators["COPY"]) {
+    compressed.insert(copy);
+  }
 }
 
 void
@@ -134,7 +392,73 @@ MemoryOperationRegistry::registerOperation(
           std::shared_ptr<MemoryOperation>, pair_hash >())).first;
   }
 
-  operations->second.insert(std::make_pair(platforms, operation));
+  auto op = operations->second.insert(std::make_pair(platforms, operation)).first;
+
+  MemoryOperationType type;
+  if (name == "COPY") {
+    type = MemoryOperationType::copy;
+  } else if (name == "MEMSET") {
+    type = MemoryOperationType::memset;
+  } else if (name == "REALLOCATE") {
+    type = MemoryOperationType::reallocate;
+  } else if (name == "FILL") {
+    type = MemoryOperationType::fill;
+  } else {
+    return;
+  }
+
+  m_operation_table
+    [static_cast<std::size_t>(type)]
+    [static_cast<std::size_t>(platforms.first)]
+    [static_cast<std::size_t>(platforms.second)] = op->second.get();
+}
+
+void
+MemoryOperationRegistry::registerOperation(
+    MemoryOperationType type,
+    std::pair<resource::MemoryResourceType, resource::MemoryResourceType> resources,
+    std::shared_ptr<MemoryOperation>&& operation)
+{
+  m_resource_operation_table
+    [static_cast<std::size_t>(type)]
+    [static_cast<std::size_t>(resources.first)]
+    [static_cast<std::size_t>(resources.second)] = operation;
+}
+
+MemoryOperation*
+MemoryOperationRegistry::find(
+    MemoryOperationType type,
+    strategy::AllocationStrategy* src_allocator,
+    strategy::AllocationStrategy* dst_allocator)
+{
+  MemoryOperation* op = m_resource_operation_table
+    [static_cast<std::size_t>(type)]
+    [static_cast<std::size_t>(src_allocator->getResourceType())]
+    [static_cast<std::size_t>(dst_allocator->getResourceType())].get();
+
+  if (op) {
+    return op;
+  }
+
+  return find(type, src_allocator->getPlatform(), dst_allocator->getPlatform());
+}
+
+MemoryOperation*
+MemoryOperationRegistry::find(
+    MemoryOperationType type,
+    Platform src_platform,
+    Platform dst_platform)
+{
+  MemoryOperation* op = m_operation_table
+    [static_cast<std::size_t>(type)]
+    [static_cast<std::size_t>(src_platform)]
+    [static_cast<std::size_t>(dst_platform)];
+
+  if (!op) {
+    UMPIRE_ERROR("Cannot find operator " << static_cast<int>(type) << " for platforms " << static_cast<int>(src_platform) << ", " << static_cast<int>(dst_platform));
+  }
+
+  return op;
 }
 
 std::shared_ptr<umpire::op::MemoryOperation>
@@ -142,6 +466,15 @@ MemoryOperationRegistry::find(
     const std::string& name,
     std::shared_ptr<strategy::AllocationStrategy>& src_allocator,
     std::shared_ptr<strategy::AllocationStrategy>& dst_allocator)
+{
+  return find(name, src_allocator.get(), dst_allocator.get());
+}
+
+std::shared_ptr<umpire::op::MemoryOperation>
+MemoryOperationRegistry::find(
+    const std::string& name,
+    strategy::AllocationStrategy* src_allocator,
+    strategy::AllocationStrategy* dst_allocator)
 {
   auto platforms = std::make_pair(
       src_allocator->getPlatform(),
@@ -162,7 +495,99 @@ MemoryOperationRegistry::find(
   return op->second;
 }
 
+void
+MemoryOperationRegistry::recordOperation(
+    MemoryOperationType type,
+    Platform src_platform,
+    Platform dst_platform,
+    std::size_t bytes,
+    uint64_t nanoseconds)
+{
+  Counters& counters = m_counters
+    [static_cast<std::size_t>(type)]
+    [static_cast<std::size_t>(src_platform)]
+    [static_cast<std::size_t>(dst_platform)];
+
+  counters.calls.fetch_add(1, std::memory_order_relaxed);
+  counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+  counters.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+std::vector<MemoryOperationStatistics>
+MemoryOperationRegistry::getStatistics()
+{
+  std::vector<MemoryOperationStatistics> statistics;
+
+  for (std::size_t i = 0; i < s_num_operation_types; ++i) {
+    for (std::size_t j = 0; j < s_num_platforms; ++j) {
+      for (std::size_t k = 0; k < s_num_platforms; ++k) {
+        const Counters& counters = m_counters[i][j][k];
+        const uint64_t calls = counters.calls.load(std::memory_order_relaxed);
+
+        if (calls > 0) {
+          MemoryOperationStatistics entry;
+          entry.type = static_cast<MemoryOperationType>(i);
+          entry.src_platform = static_cast<Platform>(j);
+          entry.dst_platform = static_cast<Platform>(k);
+          entry.calls = calls;
+          entry.bytes = counters.bytes.load(std::memory_order_relaxed);
+          entry.nanoseconds = counters.nanoseconds.load(std::memory_order_relaxed);
+          statistics.push_back(entry);
+        }
+      }
+    }
+  }
+
+  return statistics;
+}
 
+void
+MemoryOperationRegistry::resetStatistics()
+{
+  for (std::size_t i = 0; i < s_num_operation_types; ++i) {
+    for (std::size_t j = 0; j < s_num_platforms; ++j) {
+      for (std::size_t k = 0; k < s_num_platforms; ++k) {
+        m_counters[i][j][k].calls.store(0, std::memory_order_relaxed);
+        m_counters[i][j][k].bytes.store(0, std::memory_order_relaxed);
+        m_counters[i][j][k].nanoseconds.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+}
+
+double
+MemoryOperationStatistics::getBandwidth() const
+{
+  if (nanoseconds == 0) {
+    return 0.0;
+  }
+
+  return static_cast<double>(bytes) * 1.0e9 / static_cast<double>(nanoseconds);
+}
+
+OperationCounter::OperationCounter(
+    MemoryOperationType type,
+    strategy::AllocationStrategy* src_allocator,
+    strategy::AllocationStrategy* dst_allocator,
+    std::size_t bytes) :
+  m_type(type),
+  m_src_platform(src_allocator->getPlatform()),
+  m_dst_platform(dst_allocator->getPlatform()),
+  m_bytes(bytes),
+  m_start(util::AllocatorStatistics::now())
+{
+}
+
+OperationCounter::~OperationCounter()
+{
+  if (std::uncaught_exception()) {
+    return;
+  }
+
+  MemoryOperationRegistry::getInstance().recordOperation(
+      m_type, m_src_platform, m_dst_platform, m_bytes,
+      util::AllocatorStatistics::now() - m_start);
+}
 
 } // end of namespace op
 } // end of namespace umpire
@@ -18,11 +18,15 @@
 #include "umpire/op/MemoryOperation.hpp"
 
 #include "umpire/strategy/AllocationStrategy.hpp"
+#include "umpire/resource/MemoryResourceTypes.hpp"
 #include "umpire/util/Platform.hpp"
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <functional>
+#include <vector>
 
 namespace umpire {
 namespace op {
@@ -38,6 +42,42 @@ struct pair_hash {
   }
 };
 
+/*!
+ * \brief Operations the ResourceManager dispatches on every call.
+ *
+ * These can be found through tables indexed by MemoryResourceType pair and
+ * by Platform pair, which avoids hashing the operation name on the hot path.
+ */
+enum class MemoryOperationType {
+  copy,
+  memset,
+  reallocate,
+  fill
+};
+
+/*!
+ * \brief Calls, bytes and time of one built-in operation type between one
+ * pair of Platforms.
+ *
+ * Time is measured around the call into the MemoryOperation, so for
+ * asynchronous calls it is only the time taken to enqueue the work.
+ */
+struct MemoryOperationStatistics {
+  MemoryOperationType type;
+  Platform src_platform;
+  Platform dst_platform;
+
+  uint64_t calls;
+  uint64_t bytes;
+  uint64_t nanoseconds;
+
+  /*!
+   * \brief Return the bytes per second over all calls, or 0 if no time
+   * was recorded.
+   */
+  double getBandwidth() const;
+};
+
 /*!
  * \brief The MemoryOperationRegistry serves as a registry for MemoryOperation
  * objects. It is a singleton class, typically accessed through the
@@ -56,6 +96,10 @@ struct pair_hash {
  * - "MEMSET"
  * - "REALLOCATE"
  *
+ * "COPY_COMPRESSED" is registered for every pair that has a "COPY". It
+ * compresses data sent between HOST and DEVICE memory when Umpire is built
+ * with ENABLE_NVCOMP, and is the plain copy otherwise.
+ *
  * \see MemoryOperation
  * \see AllocationStrategy
  */
@@ -80,11 +124,58 @@ class MemoryOperationRegistry {
      * \throws umpire::util::Exception if the requested MemoryOperation is not
      *         found.
      */
+    std::shared_ptr<umpire::op::MemoryOperation> find(
+        const std::string& name,
+        strategy::AllocationStrategy* source_allocator,
+        strategy::AllocationStrategy* dst_allocator);
+
+    /*!
+     * \copydoc find
+     */
     std::shared_ptr<umpire::op::MemoryOperation> find(
         const std::string& name,
         std::shared_ptr<strategy::AllocationStrategy>& source_allocator,
         std::shared_ptr<strategy::AllocationStrategy>& dst_allocator);
 
+    /*!
+     * \brief Function to find one of the built-in MemoryOperation types.
+     *
+     * Equivalent to finding the operation by name ("COPY", "MEMSET" or
+     * "REALLOCATE"), but uses a table lookup and does not touch any
+     * reference counts. The returned pointer is owned by the registry.
+     *
+     * \param type Type of operation.
+     * \param src_platform Platform of the source allocation.
+     * \param dst_platform Platform of the destination allocation.
+     *
+     * \throws umpire::util::Exception if the requested MemoryOperation is not
+     *         found.
+     */
+    MemoryOperation* find(
+        MemoryOperationType type,
+        Platform src_platform,
+        Platform dst_platform);
+
+    /*!
+     * \brief Function to find the best built-in MemoryOperation for a pair
+     * of AllocationStrategy objects.
+     *
+     * An operation registered for the strategies' MemoryResourceType pair,
+     * e.g. PINNED to DEVICE, is preferred. Otherwise the operation for their
+     * Platform pair is returned.
+     *
+     * \param type Type of operation.
+     * \param src_allocator AllocationStrategy of the source allocation.
+     * \param dst_allocator AllocationStrategy of the destination allocation.
+     *
+     * \throws umpire::util::Exception if the requested MemoryOperation is not
+     *         found.
+     */
+    MemoryOperation* find(
+        MemoryOperationType type,
+        strategy::AllocationStrategy* src_allocator,
+        strategy::AllocationStrategy* dst_allocator);
+
     /*!
      * \brief Add a new MemoryOperation to the registry
      *
@@ -100,6 +191,46 @@ class MemoryOperationRegistry {
       std::pair<Platform, Platform> platforms,
       std::shared_ptr<MemoryOperation>&& operation);
 
+    /*!
+     * \brief Add a built-in MemoryOperation specialized for a pair of
+     * memory resource kinds.
+     *
+     * These take precedence over operations registered by Platform when
+     * found with the AllocationStrategy overload of find.
+     *
+     * \param type Type of operation.
+     * \param resources pair of MemoryResourceTypes for the source and
+     *        destination.
+     * \param operation pointer to the MemoryOperation.
+     */
+    void registerOperation(
+      MemoryOperationType type,
+      std::pair<resource::MemoryResourceType, resource::MemoryResourceType> resources,
+      std::shared_ptr<MemoryOperation>&& operation);
+
+    /*!
+     * \brief Count a call to a built-in operation.
+     *
+     * Counters are relaxed atomics, so this may be called from any thread.
+     */
+    void recordOperation(
+      MemoryOperationType type,
+      Platform src_platform,
+      Platform dst_platform,
+      std::size_t bytes,
+      uint64_t nanoseconds);
+
+    /*!
+     * \brief Return the counters of every operation type and Platform pair
+     * that has been called since the last reset.
+     */
+    std::vector<MemoryOperationStatistics> getStatistics();
+
+    /*!
+     * \brief Set every counter back to zero.
+     */
+    void resetStatistics();
+
   protected:
     MemoryOperationRegistry();
     MemoryOperationRegistry (const MemoryOperationRegistry&) = delete;
@@ -108,6 +239,38 @@ class MemoryOperationRegistry {
   private:
     static MemoryOperationRegistry* s_memory_operation_registry_instance;
 
+    // Platform::omp_target is the last Platform.
+    static const std::size_t s_num_platforms =
+      static_cast<std::size_t>(Platform::omp_target) + 1;
+    static const std::size_t s_num_operation_types = 4;
+
+    // File is the last MemoryResourceType.
+    static const std::size_t s_num_resource_types =
+      static_cast<std::size_t>(resource::File) + 1;
+
+    /*
+     * Raw pointers to the MemoryOperation for each built-in type and Platform
+     * pair, kept in sync with m_operators by registerOperation.
+     */
+    MemoryOperation* m_operation_table
+      [s_num_operation_types][s_num_platforms][s_num_platforms];
+
+    struct Counters {
+      std::atomic<uint64_t> calls;
+      std::atomic<uint64_t> bytes;
+      std::atomic<uint64_t> nanoseconds;
+    };
+
+    Counters m_counters
+      [s_num_operation_types][s_num_platforms][s_num_platforms];
+
+    /*
+     * Operations specialized for a MemoryResourceType pair, or nullptr
+     * where the Platform table applies.
+     */
+    std::shared_ptr<MemoryOperation> m_resource_operation_table
+      [s_num_operation_types][s_num_resource_types][s_num_resource_types];
+
     /*
      * Doubly-nested unordered_map that stores MemoryOperations by first name,
      * then by Platform pair.
@@ -120,6 +283,33 @@ class MemoryOperationRegistry {
 
 };
 
+/*!
+ * \brief Times a call to a built-in operation and records it with the
+ * MemoryOperationRegistry when it goes out of scope.
+ *
+ * Nothing is recorded if the scope is left by an exception.
+ */
+class OperationCounter {
+  public:
+    OperationCounter(
+        MemoryOperationType type,
+        strategy::AllocationStrategy* src_allocator,
+        strategy::AllocationStrategy* dst_allocator,
+        std::size_t bytes);
+
+    ~OperationCounter();
+
+    OperationCounter(const OperationCounter&) = delete;
+    OperationCounter& operator=(const OperationCounter&) = delete;
+
+  private:
+    MemoryOperationType m_type;
+    Platform m_src_platform;
+    Platform m_dst_platform;
+    std::size_t m_bytes;
+    uint64_t m_start;
+};
+
 } // end of namespace op
 } // end of namespace umpire
 
@@ -0,0 +1,56 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/op/OpenMPTargetCopyOperation.hpp"
+
+#include <omp.h>
+
+#include "umpire/alloc/OpenMPTargetAllocator.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace op {
+
+void OpenMPTargetCopyOperation::transform(
+    void* src_ptr,
+    void** dst_ptr,
+    util::AllocationRecord* UMPIRE_UNUSED_ARG(src_allocation),
+    util::AllocationRecord* UMPIRE_UNUSED_ARG(dst_allocation),
+    size_t length)
+{
+  const int src_device = alloc::OpenMPTargetAllocator::findDevice(src_ptr);
+  const int dst_device = alloc::OpenMPTargetAllocator::findDevice(*dst_ptr);
+
+  int error = ::omp_target_memcpy(*dst_ptr, src_ptr, length, 0, 0,
+      dst_device, src_device);
+
+  if (error != 0) {
+    UMPIRE_ERROR("omp_target_memcpy( dst_ptr = " << *dst_ptr
+      << ", src_ptr = " << src_ptr
+      << ", length = " << length
+      << ", dst_device = " << dst_device
+      << ", src_device = " << src_device
+      << " ) failed with error: " << error);
+  }
+
+  UMPIRE_RECORD_STATISTIC(
+      "OpenMPTargetCopyOperation",
+      "src_ptr", reinterpret_cast<uintptr_t>(src_ptr),
+      "dst_ptr", reinterpret_cast<uintptr_t>(dst_ptr),
+      "size", length,
+      "event", "copy");
+}
+
+} // end of namespace op
+} // end of namespace umpire
@@ -0,0 +1,49 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_OpenMPTargetCopyOperation_HPP
+#define UMPIRE_OpenMPTargetCopyOperation_HPP
+
+#include "umpire/op/MemoryOperation.hpp"
+
+namespace umpire {
+namespace op {
+
+/*!
+ * \brief Copy operation to move data to, from or between OpenMP offload
+ * devices.
+ */
+class OpenMPTargetCopyOperation : public MemoryOperation {
+ public:
+   /*!
+    * @copybrief MemoryOperation::transform
+    *
+    * Uses omp_target_memcpy, with the device of each pointer found through
+    * OpenMPTargetAllocator::findDevice. Host pointers use
+    * omp_get_initial_device().
+    *
+    * @copydetails MemoryOperation::transform
+    */
+  void transform(
+      void* src_ptr,
+      void** dst_ptr,
+      util::AllocationRecord *src_allocation,
+      util::AllocationRecord *dst_allocation,
+      size_t length);
+};
+
+} // end of namespace op
+} //end of namespace umpire
+
+#endif // UMPIRE_OpenMPTargetCopyOperation_HPP
@@ -0,0 +1,148 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_memory_resource_adaptor_HPP
+#define UMPIRE_memory_resource_adaptor_HPP
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#define UMPIRE_HAVE_PMR
+#endif
+#endif
+
+#if defined(UMPIRE_HAVE_PMR)
+
+#include "umpire/Allocator.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+
+namespace umpire {
+namespace pmr {
+
+/*!
+ * \brief std::pmr::memory_resource that gets its memory from an
+ * umpire::Allocator.
+ *
+ * Allocations go through the Allocator, so they are tracked and counted in
+ * its statistics like any other. Alignments beyond alignof(std::max_align_t)
+ * use the aligned Allocator::allocate. Two adaptors compare equal when their
+ * Allocators share a strategy.
+ *
+ * \code
+ * umpire::pmr::memory_resource_adaptor resource(rm.getAllocator("pool"));
+ * std::pmr::vector<double> data(&resource);
+ * \endcode
+ */
+class memory_resource_adaptor :
+  public std::pmr::memory_resource
+{
+  public:
+    memory_resource_adaptor(Allocator allocator) :
+      m_allocator(allocator)
+    {
+    }
+
+    /*!
+     * \brief Return the Allocator this resource gets its memory from.
+     */
+    Allocator getAllocator() const
+    {
+      return m_allocator;
+    }
+
+  protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+      if (alignment > alignof(std::max_align_t)) {
+        return m_allocator.allocate(bytes, alignment);
+      }
+
+      return m_allocator.allocate(bytes);
+    }
+
+    void do_deallocate(void* ptr, std::size_t, std::size_t) override
+    {
+      m_allocator.deallocate(ptr);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+      auto adaptor = dynamic_cast<const memory_resource_adaptor*>(&other);
+
+      return adaptor &&
+        getAllocator().getAllocationStrategy() == adaptor->getAllocator().getAllocationStrategy();
+    }
+
+  private:
+    Allocator m_allocator;
+};
+
+namespace detail {
+
+/*!
+ * \brief Holds the adaptor so it is constructed before the resource that
+ * uses it as an upstream.
+ */
+struct upstream_holder {
+  upstream_holder(Allocator allocator) :
+    m_upstream(allocator)
+  {
+  }
+
+  memory_resource_adaptor m_upstream;
+};
+
+} // end of namespace detail
+
+/*!
+ * \brief A std::pmr resource whose upstream is an umpire::Allocator.
+ *
+ * Resource is one of the standard resources that take an upstream as their
+ * last constructor argument. Arguments before it are forwarded:
+ *
+ * \code
+ * umpire::pmr::monotonic_buffer_resource arena(
+ *     rm.getAllocator("DEVICE_pool"), 1 << 20);
+ * std::pmr::vector<double> data(&arena);
+ * \endcode
+ */
+template<typename Resource>
+class upstream_resource :
+  private detail::upstream_holder,
+  public Resource
+{
+  public:
+    template<typename... Args>
+    upstream_resource(Allocator allocator, Args&&... args) :
+      detail::upstream_holder(allocator),
+      Resource(std::forward<Args>(args)..., &m_upstream)
+    {
+    }
+
+    upstream_resource(const upstream_resource&) = delete;
+    upstream_resource& operator=(const upstream_resource&) = delete;
+};
+
+typedef upstream_resource<std::pmr::monotonic_buffer_resource> monotonic_buffer_resource;
+typedef upstream_resource<std::pmr::unsynchronized_pool_resource> unsynchronized_pool_resource;
+typedef upstream_resource<std::pmr::synchronized_pool_resource> synchronized_pool_resource;
+
+} // end of namespace pmr
+} // end of namespace umpire
+
+#endif // defined(UMPIRE_HAVE_PMR)
+
+#endif // UMPIRE_memory_resource_adaptor_HPP
@@ -0,0 +1,45 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/resource/CowMemoryResource.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace resource {
+
+CowMemoryResource::CowMemoryResource(const std::string& name, int id) :
+  DefaultMemoryResource<alloc::MemfdAllocator>(Platform::cpu, name, id, Host)
+{
+}
+
+void*
+CowMemoryResource::snapshot(void* ptr, size_t bytes)
+{
+  void* ret = m_allocator.snapshot(ptr);
+  ResourceManager::getInstance().registerAllocation(ret, {ret, bytes, this});
+
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", bytes=" << bytes << ") returning " << ret);
+
+  UMPIRE_RECORD_STATISTIC(this->getStatisticHandle(), "ptr", reinterpret_cast<uintptr_t>(ret), "size", bytes, "event", "snapshot");
+
+  return ret;
+}
+
+} // end of namespace resource
+} // end of namespace umpire
@@ -0,0 +1,48 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CowMemoryResource_HPP
+#define UMPIRE_CowMemoryResource_HPP
+
+#include "umpire/resource/DefaultMemoryResource.hpp"
+#include "umpire/alloc/MemfdAllocator.hpp"
+
+namespace umpire {
+namespace resource {
+
+/*!
+ * \brief MemoryResource for HOST memory that can be snapshotted with
+ * copy-on-write.
+ *
+ * Allocations are MemfdAllocator mappings. Snapshots are recorded as
+ * allocations of this resource, with the size of the original, so they are
+ * released with deallocate. They count fully towards getCurrentSize even
+ * though they share pages with the original until either side writes them.
+ */
+class CowMemoryResource :
+  public DefaultMemoryResource<alloc::MemfdAllocator>
+{
+  public:
+    CowMemoryResource(const std::string& name, int id);
+
+    /*!
+     * \brief Snapshot the bytes-long allocation at ptr.
+     */
+    void* snapshot(void* ptr, size_t bytes);
+};
+
+} // end of namespace resource
+} // end of namespace umpire
+
+#endif // UMPIRE_CowMemoryResource_HPP
@@ -15,7 +15,10 @@
 #ifndef UMPIRE_DefaultMemoryResource_HPP
 #define UMPIRE_DefaultMemoryResource_HPP
 
+#include <atomic>
+
 #include "umpire/resource/MemoryResource.hpp"
+#include "umpire/resource/MemoryResourceTypes.hpp"
 
 #include "umpire/util/AllocationRecord.hpp"
 #include "umpire/util/Platform.hpp"
@@ -33,23 +36,71 @@ class DefaultMemoryResource :
   public MemoryResource
 {
   public: 
-    DefaultMemoryResource(Platform platform, const std::string& name, int id);
+    DefaultMemoryResource(Platform platform, const std::string& name, int id,
+        MemoryResourceType type = Host);
+
+    /*!
+     * \brief Construct a DefaultMemoryResource using a configured instance of
+     * _allocator, e.g. one bound to a particular NUMA node.
+     */
+    DefaultMemoryResource(Platform platform, const std::string& name, int id, _allocator allocator,
+        MemoryResourceType type = Host);
 
     void* allocate(size_t bytes);
+    void* allocateAligned(size_t bytes, size_t alignment);
+
+    /*!
+     * \brief Allocate zeroed memory with _allocator's allocateZeroed, which
+     * clears it only if the underlying allocation is not known to be zero.
+     */
+    void* allocateZeroed(size_t bytes);
+
+    /*!
+     * \brief Allocate with _allocator's tryAllocate, so failure returns
+     * nullptr without an exception being thrown.
+     */
+    void* tryAllocate(size_t bytes);
+
     void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    /*!
+     * \brief Allocate without a record, for strategies that take chunks
+     * from this resource. The memory still counts towards getCurrentSize.
+     */
+    void* allocateUntracked(size_t bytes);
+
+    /*!
+     * \brief Throws, since the resource does not know the size to take
+     * off getCurrentSize; use deallocateUntracked(ptr, bytes).
+     */
+    void deallocateUntracked(void* ptr);
+    void deallocateUntracked(void* ptr, size_t bytes);
+    void* tryAllocateUntracked(size_t bytes);
 
     long getCurrentSize();
     long getHighWatermark();
 
     Platform getPlatform();
 
+    MemoryResourceType getResourceType();
+
+    /*!
+     * \brief Every _allocator used by Umpire calls through to a thread-safe
+     * system or CUDA allocator, and the statistics are atomic, so resources
+     * need no external locking.
+     */
+    bool isThreadSafe();
+
   protected: 
     _allocator m_allocator;
 
-    long m_current_size;
-    long m_highwatermark;
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
 
     Platform m_platform;
+
+    MemoryResourceType m_resource_type;
 };
 
 } // end of namespace resource
@@ -17,6 +17,7 @@
 
 #include "umpire/resource/DefaultMemoryResource.hpp"
 #include "umpire/ResourceManager.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
 #include "umpire/util/Macros.hpp"
 
 #include <memory>
@@ -26,57 +27,157 @@ namespace umpire {
 namespace resource {
 
 template<typename _allocator>
-DefaultMemoryResource<_allocator>::DefaultMemoryResource(Platform platform, const std::string& name, int id) :
+DefaultMemoryResource<_allocator>::DefaultMemoryResource(Platform platform, const std::string& name, int id,
+    MemoryResourceType type) :
   MemoryResource(name, id),
   m_allocator(),
   m_current_size(0l),
   m_highwatermark(0l),
-  m_platform(platform)
+  m_platform(platform),
+  m_resource_type(type)
+{
+}
+
+template<typename _allocator>
+DefaultMemoryResource<_allocator>::DefaultMemoryResource(Platform platform, const std::string& name, int id, _allocator allocator,
+    MemoryResourceType type) :
+  MemoryResource(name, id),
+  m_allocator(allocator),
+  m_current_size(0l),
+  m_highwatermark(0l),
+  m_platform(platform),
+  m_resource_type(type)
 {
 }
 
 template<typename _allocator>
 void* DefaultMemoryResource<_allocator>::allocate(size_t bytes)
+{
+  void* ptr = DefaultMemoryResource<_allocator>::allocateUntracked(bytes);
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+
+  return ptr;
+}
+
+template<typename _allocator>
+void* DefaultMemoryResource<_allocator>::allocateUntracked(size_t bytes)
 {
   void* ptr = m_allocator.allocate(bytes);
-  ResourceManager::getInstance().registerAllocation(ptr, new util::AllocationRecord{ptr, bytes, this->shared_from_this()});
 
-  m_current_size += bytes;
-  if (m_current_size > m_highwatermark)
-    m_highwatermark = m_current_size;
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
 
   UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ptr);
 
-  UMPIRE_RECORD_STATISTIC(getName(), "ptr", reinterpret_cast<uintptr_t>(ptr), "size", bytes, "event", "allocate");
+  UMPIRE_RECORD_STATISTIC(this->getStatisticHandle(), "ptr", reinterpret_cast<uintptr_t>(ptr), "size", bytes, "event", "allocate");
+
+  return ptr;
+}
+
+template<typename _allocator>
+void* DefaultMemoryResource<_allocator>::allocateAligned(size_t bytes, size_t alignment)
+{
+  void* ptr = m_allocator.allocate(bytes, alignment);
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ", alignment=" << alignment << ") returning " << ptr);
+
+  UMPIRE_RECORD_STATISTIC(this->getStatisticHandle(), "ptr", reinterpret_cast<uintptr_t>(ptr), "size", bytes, "event", "allocate");
+
+  return ptr;
+}
+
+template<typename _allocator>
+void* DefaultMemoryResource<_allocator>::allocateZeroed(size_t bytes)
+{
+  void* ptr = m_allocator.allocateZeroed(bytes);
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ptr);
+
+  UMPIRE_RECORD_STATISTIC(this->getStatisticHandle(), "ptr", reinterpret_cast<uintptr_t>(ptr), "size", bytes, "event", "allocate");
+
+  return ptr;
+}
+
+template<typename _allocator>
+void* DefaultMemoryResource<_allocator>::tryAllocate(size_t bytes)
+{
+  void* ptr = m_allocator.tryAllocate(bytes);
+
+  if (ptr) {
+    ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+
+    util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+    UMPIRE_RECORD_STATISTIC(this->getStatisticHandle(), "ptr", reinterpret_cast<uintptr_t>(ptr), "size", bytes, "event", "allocate");
+  }
+
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ptr);
 
   return ptr;
 }
 
 template<typename _allocator>
 void DefaultMemoryResource<_allocator>::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+template<typename _allocator>
+void DefaultMemoryResource<_allocator>::deallocateRecord(void* ptr, const util::AllocationRecord& record)
 {
   UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
 
-  UMPIRE_RECORD_STATISTIC(getName(), "ptr", reinterpret_cast<uintptr_t>(ptr), "size", 0x0, "event", "deallocate");
+  UMPIRE_RECORD_STATISTIC(this->getStatisticHandle(), "ptr", reinterpret_cast<uintptr_t>(ptr), "size", 0x0, "event", "deallocate");
 
   m_allocator.deallocate(ptr);
-  util::AllocationRecord* record = ResourceManager::getInstance().deregisterAllocation(ptr);
-  m_current_size -= record->m_size;
-  delete record;
+  util::decreaseSize(m_current_size, record.m_size);
+}
+
+template<typename _allocator>
+void DefaultMemoryResource<_allocator>::deallocateUntracked(void* ptr)
+{
+  UMPIRE_ERROR("Cannot free untracked memory " << ptr << " from " << this->getName() << " without its size");
+}
+
+template<typename _allocator>
+void DefaultMemoryResource<_allocator>::deallocateUntracked(void* ptr, size_t bytes)
+{
+  deallocateRecord(ptr, {ptr, bytes, this});
+}
+
+template<typename _allocator>
+void* DefaultMemoryResource<_allocator>::tryAllocateUntracked(size_t bytes)
+{
+  void* ptr = m_allocator.tryAllocate(bytes);
+
+  if (ptr) {
+    util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+    UMPIRE_RECORD_STATISTIC(this->getStatisticHandle(), "ptr", reinterpret_cast<uintptr_t>(ptr), "size", bytes, "event", "allocate");
+  }
+
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ptr);
+
+  return ptr;
 }
 
 template<typename _allocator>
 long DefaultMemoryResource<_allocator>::getCurrentSize()
 {
   UMPIRE_LOG(Debug, "() returning " << m_current_size);
-  return m_current_size;
+  return m_current_size.load(std::memory_order_relaxed);
 }
 
 template<typename _allocator>
 long DefaultMemoryResource<_allocator>::getHighWatermark()
 {
   UMPIRE_LOG(Debug, "() returning " << m_highwatermark);
-  return m_highwatermark;
+  return m_highwatermark.load(std::memory_order_relaxed);
 }
 
 template<typename _allocator>
@@ -85,6 +186,18 @@ Platform DefaultMemoryResource<_allocator>::getPlatform()
   return m_platform;
 }
 
+template<typename _allocator>
+MemoryResourceType DefaultMemoryResource<_allocator>::getResourceType()
+{
+  return m_resource_type;
+}
+
+template<typename _allocator>
+bool DefaultMemoryResource<_allocator>::isThreadSafe()
+{
+  return true;
+}
+
 } // end of namespace resource
 } // end of namespace umpire
 #endif // UMPIRE_DefaultMemoryResource_INL
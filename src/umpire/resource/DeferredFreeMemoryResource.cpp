@@ -0,0 +1,42 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/resource/DeferredFreeMemoryResource.hpp"
+
+#include "umpire/config.hpp"
+
+#include <cstdlib>
+#include <string>
+
+namespace umpire {
+namespace resource {
+
+bool
+getDefaultDeferredFree()
+{
+  const char* value = std::getenv("UMPIRE_CUDA_DEFERRED_FREE");
+
+  if (value && *value) {
+    return std::string(value) == "1";
+  }
+
+#if defined(UMPIRE_CUDA_DEFERRED_FREE)
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // end of namespace resource
+} // end of namespace umpire
@@ -0,0 +1,97 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_DeferredFreeMemoryResource_HPP
+#define UMPIRE_DeferredFreeMemoryResource_HPP
+
+#include <mutex>
+#include <vector>
+
+#include "umpire/resource/DefaultMemoryResource.hpp"
+
+namespace umpire {
+namespace resource {
+
+/*!
+ * \brief Return whether the CUDA resources should defer their frees.
+ *
+ * The UMPIRE_CUDA_DEFERRED_FREE environment variable ("1" or "0") takes
+ * precedence over the CUDA_DEFERRED_FREE build option.
+ */
+bool getDefaultDeferredFree();
+
+/*!
+ * \brief DefaultMemoryResource that queues frees instead of performing
+ * them straight away.
+ *
+ * cudaFree and cudaFreeHost implicitly synchronize the device, so freeing
+ * in the middle of a timestep stalls every kernel in flight. This resource
+ * queues the pointers instead and frees them as a batch, paying for one
+ * synchronization, when:
+ *
+ * - release is called, e.g. through Allocator::release at a point where
+ *   the caller synchronizes anyway;
+ * - an allocation fails, after which it is retried;
+ * - the resource is destroyed.
+ *
+ * Deallocated memory no longer counts towards getCurrentSize, but still
+ * counts towards getActualSize until it has been freed.
+ */
+template <typename _allocator>
+class DeferredFreeMemoryResource :
+  public DefaultMemoryResource<_allocator>
+{
+  public:
+    DeferredFreeMemoryResource(Platform platform, const std::string& name, int id,
+        MemoryResourceType type = Host);
+
+    DeferredFreeMemoryResource(Platform platform, const std::string& name, int id, _allocator allocator,
+        MemoryResourceType type = Host);
+
+    ~DeferredFreeMemoryResource();
+
+    void* allocate(size_t bytes);
+    void* allocateAligned(size_t bytes, size_t alignment);
+    void* allocateUntracked(size_t bytes);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    /*!
+     * \brief Free every queued pointer.
+     */
+    void release();
+
+    long getActualSize();
+
+    /*!
+     * \brief Return the number of pointers waiting to be freed.
+     */
+    size_t getNumPendingFrees();
+
+  private:
+    /*!
+     * \brief Free the queued pointers, returning whether there were any.
+     */
+    bool drain();
+
+    std::mutex m_mutex;
+    std::vector<void*> m_pending;
+    size_t m_pending_bytes;
+};
+
+} // end of namespace resource
+} // end of namespace umpire
+
+#include "umpire/resource/DeferredFreeMemoryResource.inl"
+
+#endif // UMPIRE_DeferredFreeMemoryResource_HPP
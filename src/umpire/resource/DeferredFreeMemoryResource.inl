@@ -0,0 +1,156 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_DeferredFreeMemoryResource_INL
+#define UMPIRE_DeferredFreeMemoryResource_INL
+
+#include "umpire/resource/DeferredFreeMemoryResource.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace resource {
+
+template<typename _allocator>
+DeferredFreeMemoryResource<_allocator>::DeferredFreeMemoryResource(Platform platform, const std::string& name, int id,
+    MemoryResourceType type) :
+  DefaultMemoryResource<_allocator>(platform, name, id, type),
+  m_mutex(),
+  m_pending(),
+  m_pending_bytes(0)
+{
+}
+
+template<typename _allocator>
+DeferredFreeMemoryResource<_allocator>::DeferredFreeMemoryResource(Platform platform, const std::string& name, int id, _allocator allocator,
+    MemoryResourceType type) :
+  DefaultMemoryResource<_allocator>(platform, name, id, allocator, type),
+  m_mutex(),
+  m_pending(),
+  m_pending_bytes(0)
+{
+}
+
+template<typename _allocator>
+DeferredFreeMemoryResource<_allocator>::~DeferredFreeMemoryResource()
+{
+  // The runtime may already be shut down, so failures are ignored.
+  for (auto ptr : m_pending) {
+    try {
+      this->m_allocator.deallocate(ptr);
+    } catch (...) {
+    }
+  }
+}
+
+template<typename _allocator>
+void* DeferredFreeMemoryResource<_allocator>::allocate(size_t bytes)
+{
+  try {
+    return DefaultMemoryResource<_allocator>::allocate(bytes);
+  } catch (...) {
+    if (!drain()) {
+      throw;
+    }
+  }
+
+  return DefaultMemoryResource<_allocator>::allocate(bytes);
+}
+
+template<typename _allocator>
+void* DeferredFreeMemoryResource<_allocator>::allocateAligned(size_t bytes, size_t alignment)
+{
+  try {
+    return DefaultMemoryResource<_allocator>::allocateAligned(bytes, alignment);
+  } catch (...) {
+    if (!drain()) {
+      throw;
+    }
+  }
+
+  return DefaultMemoryResource<_allocator>::allocateAligned(bytes, alignment);
+}
+
+template<typename _allocator>
+void* DeferredFreeMemoryResource<_allocator>::allocateUntracked(size_t bytes)
+{
+  try {
+    return DefaultMemoryResource<_allocator>::allocateUntracked(bytes);
+  } catch (...) {
+    if (!drain()) {
+      throw;
+    }
+  }
+
+  return DefaultMemoryResource<_allocator>::allocateUntracked(bytes);
+}
+
+template<typename _allocator>
+void DeferredFreeMemoryResource<_allocator>::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  UMPIRE_RECORD_STATISTIC(this->getStatisticHandle(), "ptr", reinterpret_cast<uintptr_t>(ptr), "size", 0x0, "event", "deallocate");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_pending.push_back(ptr);
+  m_pending_bytes += record.m_size;
+
+  util::decreaseSize(this->m_current_size, record.m_size);
+}
+
+template<typename _allocator>
+void DeferredFreeMemoryResource<_allocator>::release()
+{
+  UMPIRE_LOG(Debug, "()");
+  drain();
+}
+
+template<typename _allocator>
+long DeferredFreeMemoryResource<_allocator>::getActualSize()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return this->getCurrentSize() + static_cast<long>(m_pending_bytes);
+}
+
+template<typename _allocator>
+size_t DeferredFreeMemoryResource<_allocator>::getNumPendingFrees()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_pending.size();
+}
+
+template<typename _allocator>
+bool DeferredFreeMemoryResource<_allocator>::drain()
+{
+  std::vector<void*> pending;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    pending.swap(m_pending);
+    m_pending_bytes = 0;
+  }
+
+  UMPIRE_LOG(Debug, "Freeing " << pending.size() << " deferred pointers");
+
+  for (auto ptr : pending) {
+    this->m_allocator.deallocate(ptr);
+  }
+
+  return !pending.empty();
+}
+
+} // end of namespace resource
+} // end of namespace umpire
+
+#endif // UMPIRE_DeferredFreeMemoryResource_INL
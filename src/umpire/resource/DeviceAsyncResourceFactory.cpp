@@ -0,0 +1,49 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/resource/DeviceAsyncResourceFactory.hpp"
+
+#include "umpire/resource/DefaultMemoryResource.hpp"
+#include "umpire/alloc/CudaMallocAsyncAllocator.hpp"
+
+#include <cstdlib>
+#include <string>
+
+namespace umpire {
+namespace resource {
+
+bool
+DeviceAsyncResourceFactory::isValidMemoryResourceFor(const std::string& name)
+{
+  return (name.compare("DEVICE_ASYNC") == 0);
+}
+
+std::shared_ptr<MemoryResource>
+DeviceAsyncResourceFactory::create(const std::string& name, int id)
+{
+  uint64_t release_threshold = alloc::CudaMallocAsyncAllocator::keep_all;
+
+  const char* value = std::getenv("UMPIRE_DEVICE_ASYNC_RELEASE_THRESHOLD");
+  if (value && *value) {
+    release_threshold = std::stoull(value);
+  }
+
+  return std::make_shared<resource::DefaultMemoryResource<alloc::CudaMallocAsyncAllocator> >(
+      Platform::cuda, name, id,
+      alloc::CudaMallocAsyncAllocator(alloc::CudaMallocAllocator::current_device, release_threshold),
+      Device);
+}
+
+} // end of namespace resource
+} // end of namespace umpire
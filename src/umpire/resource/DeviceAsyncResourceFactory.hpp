@@ -0,0 +1,42 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_DeviceAsyncResourceFactory_HPP
+#define UMPIRE_DeviceAsyncResourceFactory_HPP
+
+#include "umpire/resource/MemoryResourceFactory.hpp"
+
+namespace umpire {
+namespace resource {
+
+/*!
+ * \brief Factory class for the "DEVICE_ASYNC" MemoryResource, which
+ * allocates GPU memory from the driver's stream-ordered memory pool.
+ *
+ * The pool's release threshold is read from the
+ * UMPIRE_DEVICE_ASYNC_RELEASE_THRESHOLD environment variable, in bytes. By
+ * default all freed memory is kept, so the resource behaves like a pool.
+ */
+class DeviceAsyncResourceFactory :
+  public MemoryResourceFactory
+{
+  bool isValidMemoryResourceFor(const std::string& name);
+
+  std::shared_ptr<MemoryResource> create(const std::string& name, int id);
+};
+
+} // end of namespace resource
+} // end of namespace umpire
+
+#endif // UMPIRE_DeviceAsyncResourceFactory_HPP
@@ -0,0 +1,191 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/resource/DeviceIpcMemoryResource.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/Macros.hpp"
+
+#include <cuda.h>
+
+#include <cstring>
+
+namespace umpire {
+namespace resource {
+
+static_assert(sizeof(cudaIpcMemHandle_t) <= sizeof(util::IpcHandle::memory),
+    "cudaIpcMemHandle_t does not fit in IpcHandle");
+static_assert(sizeof(cudaIpcEventHandle_t) <= sizeof(util::IpcHandle::event),
+    "cudaIpcEventHandle_t does not fit in IpcHandle");
+
+DeviceIpcMemoryResource::DeviceIpcMemoryResource(const std::string& name, int id) :
+  ExternalMemoryResource(name, id, Platform::cuda, Device)
+{
+}
+
+DeviceIpcMemoryResource::~DeviceIpcMemoryResource()
+{
+  for (auto& mapping : m_mappings) {
+    ::cudaIpcCloseMemHandle(mapping.second.base);
+    ::cudaEventDestroy(mapping.second.event);
+  }
+
+  for (auto& event : m_events) {
+    ::cudaEventDestroy(event.second);
+  }
+}
+
+util::IpcHandle
+DeviceIpcMemoryResource::exportMemory(void* ptr, size_t size, cudaStream_t stream)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", size=" << size << ")");
+
+  CUdeviceptr base;
+  size_t range;
+  CUresult result = ::cuMemGetAddressRange(&base, &range, reinterpret_cast<CUdeviceptr>(ptr));
+  if (result != CUDA_SUCCESS) {
+    UMPIRE_ERROR("cuMemGetAddressRange( ptr = " << ptr << " ) failed with error: " << result);
+  }
+
+  void* block = reinterpret_cast<void*>(base);
+
+  util::IpcHandle handle;
+  std::memset(&handle, 0, sizeof(handle));
+  handle.offset = static_cast<char*>(ptr) - static_cast<char*>(block);
+  handle.size = size;
+
+  cudaIpcMemHandle_t memory;
+  cudaError_t error = ::cudaIpcGetMemHandle(&memory, block);
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaIpcGetMemHandle( ptr = " << block << " ) failed with error: " << cudaGetErrorString(error));
+  }
+  std::memcpy(handle.memory, &memory, sizeof(memory));
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto found = m_events.find(block);
+  if (found == m_events.end()) {
+    cudaEvent_t event;
+    error = ::cudaEventCreateWithFlags(&event, cudaEventDisableTiming | cudaEventInterprocess);
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaEventCreateWithFlags failed with error: " << cudaGetErrorString(error));
+    }
+    found = m_events.insert({block, event}).first;
+  }
+
+  ::cudaEventRecord(found->second, stream);
+
+  cudaIpcEventHandle_t event;
+  error = ::cudaIpcGetEventHandle(&event, found->second);
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaIpcGetEventHandle failed with error: " << cudaGetErrorString(error));
+  }
+  std::memcpy(handle.event, &event, sizeof(event));
+
+  return handle;
+}
+
+void*
+DeviceIpcMemoryResource::openMemory(const util::IpcHandle& handle, cudaStream_t stream)
+{
+  UMPIRE_LOG(Debug, "(offset=" << handle.offset << ", size=" << handle.size << ")");
+
+  std::string key(handle.memory, sizeof(cudaIpcMemHandle_t));
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto mapping = m_mappings.find(key);
+  if (mapping == m_mappings.end()) {
+    cudaIpcMemHandle_t memory;
+    std::memcpy(&memory, handle.memory, sizeof(memory));
+
+    void* base = nullptr;
+    cudaError_t error = ::cudaIpcOpenMemHandle(&base, memory, cudaIpcMemLazyEnablePeerAccess);
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaIpcOpenMemHandle failed with error: " << cudaGetErrorString(error));
+    }
+
+    cudaIpcEventHandle_t event_handle;
+    std::memcpy(&event_handle, handle.event, sizeof(event_handle));
+
+    cudaEvent_t event;
+    error = ::cudaIpcOpenEventHandle(&event, event_handle);
+    if (error != cudaSuccess) {
+      ::cudaIpcCloseMemHandle(base);
+      UMPIRE_ERROR("cudaIpcOpenEventHandle failed with error: " << cudaGetErrorString(error));
+    }
+
+    mapping = m_mappings.insert({key, {base, event, 0}}).first;
+  }
+
+  ::cudaStreamWaitEvent(stream, mapping->second.event, 0);
+
+  void* ptr = static_cast<char*>(mapping->second.base) + handle.offset;
+
+  auto open = m_opens.find(ptr);
+  if (open == m_opens.end()) {
+    ExternalMemoryResource::registerMemory(ptr, handle.size);
+    m_opens.insert({ptr, {key, 1}});
+  } else {
+    ++open->second.count;
+  }
+  ++mapping->second.opens;
+
+  return ptr;
+}
+
+void
+DeviceIpcMemoryResource::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto open = m_opens.find(ptr);
+  if (open == m_opens.end()) {
+    UMPIRE_ERROR(ptr << " was not opened by " << getName());
+  }
+
+  --m_mappings[open->second.key].opens;
+
+  if (--open->second.count > 0) {
+    // Other opens still use the pointer, so put its record back.
+    ResourceManager::getInstance().registerAllocation(ptr, record);
+    return;
+  }
+
+  m_opens.erase(open);
+  ExternalMemoryResource::deallocateRecord(ptr, record);
+}
+
+void
+DeviceIpcMemoryResource::release()
+{
+  UMPIRE_LOG(Debug, "()");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  for (auto it = m_mappings.begin(); it != m_mappings.end(); ) {
+    if (it->second.opens == 0) {
+      ::cudaIpcCloseMemHandle(it->second.base);
+      ::cudaEventDestroy(it->second.event);
+      it = m_mappings.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+} // end of namespace resource
+} // end of namespace umpire
@@ -0,0 +1,101 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_DeviceIpcMemoryResource_HPP
+#define UMPIRE_DeviceIpcMemoryResource_HPP
+
+#include "umpire/resource/ExternalMemoryResource.hpp"
+
+#include "umpire/util/IpcHandle.hpp"
+
+#include <cuda_runtime_api.h>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace umpire {
+namespace resource {
+
+/*!
+ * \brief MemoryResource for DEVICE memory shared between processes with
+ * CUDA IPC.
+ *
+ * exportMemory makes an IpcHandle for memory this process allocated. The
+ * handle names the whole cudaMalloc block, so an allocation from a pool is
+ * shared by its offset into the pool's chunk. openMemory maps a handle
+ * from another process and records the allocation as belonging to this
+ * resource; deallocating it only drops the record.
+ *
+ * Opening the same allocation again returns the same pointer, and each
+ * open needs its own deallocate. Mapped blocks stay cached so repeat opens
+ * are cheap, and release closes any that no allocation uses.
+ */
+class DeviceIpcMemoryResource :
+  public ExternalMemoryResource
+{
+  public:
+    DeviceIpcMemoryResource(const std::string& name, int id);
+
+    ~DeviceIpcMemoryResource();
+
+    /*!
+     * \brief Make a handle for size bytes of DEVICE memory at ptr.
+     *
+     * An interprocess event is recorded on stream, and the process that
+     * opens the handle waits for it, so work queued on stream before the
+     * export is visible there.
+     */
+    util::IpcHandle exportMemory(void* ptr, size_t size, cudaStream_t stream);
+
+    /*!
+     * \brief Map the allocation named by handle into this process.
+     *
+     * stream waits on the exporter's event before the pointer is returned.
+     */
+    void* openMemory(const util::IpcHandle& handle, cudaStream_t stream);
+
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    /*!
+     * \brief Close mapped blocks that no open allocation uses.
+     */
+    void release();
+
+  private:
+    struct Mapping {
+      void* base;
+      cudaEvent_t event;
+      long opens;
+    };
+
+    struct Open {
+      std::string key;
+      long count;
+    };
+
+    std::mutex m_mutex;
+
+    // Interprocess events used for exports, by block base address.
+    std::unordered_map<void*, cudaEvent_t> m_events;
+
+    // Blocks opened from other processes, by their cudaIpcMemHandle_t.
+    std::unordered_map<std::string, Mapping> m_mappings;
+    std::unordered_map<void*, Open> m_opens;
+};
+
+} // end of namespace resource
+} // end of namespace umpire
+
+#endif // UMPIRE_DeviceIpcMemoryResource_HPP
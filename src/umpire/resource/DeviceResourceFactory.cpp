@@ -15,8 +15,11 @@
 #include "umpire/resource/DeviceResourceFactory.hpp"
 
 #include "umpire/resource/DefaultMemoryResource.hpp"
+#include "umpire/resource/DeferredFreeMemoryResource.hpp"
 #include "umpire/alloc/CudaMallocAllocator.hpp"
 
+#include <cctype>
+
 namespace umpire {
 namespace resource {
 
@@ -25,15 +28,46 @@ DeviceResourceFactory::isValidMemoryResourceFor(const std::string& name)
 {
   if (name.compare("DEVICE") == 0) {
     return true;
-  } else {
+  }
+
+  const std::string prefix("DEVICE::");
+
+  if (name.compare(0, prefix.size(), prefix) != 0
+      || name.size() == prefix.size()) {
     return false;
   }
+
+  for (size_t i = prefix.size(); i < name.size(); ++i) {
+    if (!std::isdigit(static_cast<unsigned char>(name[i]))) {
+      return false;
+    }
+  }
+
+  return true;
 }
 
 std::shared_ptr<MemoryResource>
-DeviceResourceFactory::create(const std::string& UMPIRE_UNUSED_ARG(name), int id)
+DeviceResourceFactory::create(const std::string& name, int id)
 {
-  return std::make_shared<resource::DefaultMemoryResource<alloc::CudaMallocAllocator> >(Platform::cuda, "DEVICE", id);
+  int device = alloc::CudaMallocAllocator::current_device;
+
+  if (name.compare("DEVICE") != 0) {
+    device = std::stoi(name.substr(std::string("DEVICE::").size()));
+
+    int device_count = 0;
+    ::cudaGetDeviceCount(&device_count);
+    if (device >= device_count) {
+      UMPIRE_ERROR("CUDA device " << device << " is not available, found " << device_count << " devices");
+    }
+  }
+
+  if (getDefaultDeferredFree()) {
+    return std::make_shared<resource::DeferredFreeMemoryResource<alloc::CudaMallocAllocator> >(
+        Platform::cuda, name, id, alloc::CudaMallocAllocator(device), Device);
+  }
+
+  return std::make_shared<resource::DefaultMemoryResource<alloc::CudaMallocAllocator> >(
+      Platform::cuda, name, id, alloc::CudaMallocAllocator(device), Device);
 }
 
 } // end of namespace resource
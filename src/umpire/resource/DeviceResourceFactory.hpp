@@ -24,6 +24,9 @@ namespace resource {
 /*!
  * \brief Factory class for constructing MemoryResource objects that use GPU
  * memory.
+ *
+ * "DEVICE" allocates on whichever device is current, while "DEVICE::<n>",
+ * e.g. "DEVICE::1", always allocates on device n.
  */
 class DeviceResourceFactory :
   public MemoryResourceFactory
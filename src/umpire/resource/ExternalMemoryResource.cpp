@@ -0,0 +1,97 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/resource/ExternalMemoryResource.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace resource {
+
+ExternalMemoryResource::ExternalMemoryResource(
+    const std::string& name,
+    int id,
+    Platform platform,
+    MemoryResourceType type) :
+  MemoryResource(name, id),
+  m_current_size(0l),
+  m_highwatermark(0l),
+  m_platform(platform),
+  m_type(type)
+{
+}
+
+void*
+ExternalMemoryResource::allocate(size_t UMPIRE_UNUSED_ARG(bytes))
+{
+  UMPIRE_ERROR(getName() << " cannot allocate memory, it only records memory allocated elsewhere");
+}
+
+void
+ExternalMemoryResource::registerMemory(void* ptr, size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", bytes=" << bytes << ")");
+
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+}
+
+void
+ExternalMemoryResource::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+ExternalMemoryResource::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  util::decreaseSize(m_current_size, record.m_size);
+}
+
+long
+ExternalMemoryResource::getCurrentSize()
+{
+  return m_current_size.load(std::memory_order_relaxed);
+}
+
+long
+ExternalMemoryResource::getHighWatermark()
+{
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+Platform
+ExternalMemoryResource::getPlatform()
+{
+  return m_platform;
+}
+
+MemoryResourceType
+ExternalMemoryResource::getResourceType()
+{
+  return m_type;
+}
+
+bool
+ExternalMemoryResource::isThreadSafe()
+{
+  return true;
+}
+
+} // end of namespace resource
+} // end of namespace umpire
@@ -0,0 +1,83 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_ExternalMemoryResource_HPP
+#define UMPIRE_ExternalMemoryResource_HPP
+
+#include <atomic>
+
+#include "umpire/resource/MemoryResource.hpp"
+#include "umpire/resource/MemoryResourceTypes.hpp"
+
+#include "umpire/util/Platform.hpp"
+
+namespace umpire {
+namespace resource {
+
+/*!
+ * \brief MemoryResource for memory that was allocated outside of Umpire.
+ *
+ * Registered ranges are recorded in the AllocationMap with this resource's
+ * MemoryResourceType and Platform, so copies, memsets and advice on them
+ * take the same path as memory that Umpire allocated. Deallocating a range
+ * only removes its record; the memory still belongs to whoever allocated it.
+ * Nothing can be allocated from this resource.
+ */
+class ExternalMemoryResource :
+  public MemoryResource
+{
+  public:
+    ExternalMemoryResource(
+        const std::string& name,
+        int id,
+        Platform platform,
+        MemoryResourceType type);
+
+    /*!
+     * \brief Throws, since this resource does not own any memory.
+     */
+    void* allocate(size_t bytes);
+
+    /*!
+     * \brief Record bytes of memory at ptr as belonging to this resource.
+     */
+    virtual void registerMemory(void* ptr, size_t bytes);
+
+    /*!
+     * \brief Remove the record of the range starting at ptr.
+     */
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    long getCurrentSize();
+    long getHighWatermark();
+
+    Platform getPlatform();
+
+    MemoryResourceType getResourceType();
+
+    bool isThreadSafe();
+
+  private:
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
+
+    Platform m_platform;
+    MemoryResourceType m_type;
+};
+
+} // end of namespace resource
+} // end of namespace umpire
+
+#endif // UMPIRE_ExternalMemoryResource_HPP
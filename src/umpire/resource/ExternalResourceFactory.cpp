@@ -0,0 +1,54 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/resource/ExternalResourceFactory.hpp"
+
+#include "umpire/resource/ExternalMemoryResource.hpp"
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace resource {
+
+bool
+ExternalResourceFactory::isValidMemoryResourceFor(const std::string& name)
+{
+  if ((name.compare("EXTERNAL_HOST") == 0)
+      || (name.compare("EXTERNAL_DEVICE") == 0)
+      || (name.compare("EXTERNAL_UM") == 0)
+      || (name.compare("EXTERNAL_PINNED") == 0)) {
+    return true;
+  } else {
+    return false;
+  }
+}
+
+std::shared_ptr<MemoryResource>
+ExternalResourceFactory::create(const std::string& name, int id)
+{
+  if (name.compare("EXTERNAL_HOST") == 0) {
+    return std::make_shared<ExternalMemoryResource>(name, id, Platform::cpu, Host);
+  } else if (name.compare("EXTERNAL_DEVICE") == 0) {
+    return std::make_shared<ExternalMemoryResource>(name, id, Platform::cuda, Device);
+  } else if (name.compare("EXTERNAL_UM") == 0) {
+    return std::make_shared<ExternalMemoryResource>(name, id, Platform::cuda, UnifiedMemory);
+  } else if (name.compare("EXTERNAL_PINNED") == 0) {
+    return std::make_shared<ExternalMemoryResource>(name, id, Platform::cuda, PinnedMemory);
+  }
+
+  UMPIRE_ERROR("ExternalResourceFactory cannot create " << name);
+}
+
+} // end of namespace resource
+} // end of namespace umpire
@@ -0,0 +1,46 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/resource/FileResourceFactory.hpp"
+
+#include <cstdlib>
+
+#include "umpire/resource/DefaultMemoryResource.hpp"
+#include "umpire/alloc/FileAllocator.hpp"
+
+namespace umpire {
+namespace resource {
+
+bool
+FileResourceFactory::isValidMemoryResourceFor(const std::string& name)
+{
+  if (name.compare("FILE") == 0) {
+    return true;
+  } else {
+    return false;
+  }
+}
+
+std::shared_ptr<MemoryResource>
+FileResourceFactory::create(const std::string& name, int id)
+{
+  const char* directory = std::getenv("UMPIRE_FILE_DIR");
+
+  return std::make_shared<DefaultMemoryResource<alloc::FileAllocator> >(
+      Platform::cpu, name, id,
+      alloc::FileAllocator(directory ? directory : "/tmp"), File);
+}
+
+} // end of namespace resource
+} // end of namespace umpire
@@ -0,0 +1,41 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/resource/HbmResourceFactory.hpp"
+
+#include "umpire/resource/DefaultMemoryResource.hpp"
+#include "umpire/alloc/MemkindAllocator.hpp"
+
+namespace umpire {
+namespace resource {
+
+bool
+HbmResourceFactory::isValidMemoryResourceFor(const std::string& name)
+{
+  return name.compare("HBM") == 0;
+}
+
+std::shared_ptr<MemoryResource>
+HbmResourceFactory::create(const std::string& name, int id)
+{
+  if (!alloc::MemkindAllocator::isAvailable()) {
+    UMPIRE_ERROR("High-bandwidth memory is not available");
+  }
+
+  return std::make_shared<DefaultMemoryResource<alloc::MemkindAllocator> >(
+      Platform::cpu, name, id);
+}
+
+} // end of namespace resource
+} // end of namespace umpire
@@ -0,0 +1,42 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_HbmResourceFactory_HPP
+#define UMPIRE_HbmResourceFactory_HPP
+
+#include "umpire/resource/MemoryResourceFactory.hpp"
+
+namespace umpire {
+namespace resource {
+
+
+/*!
+ * \brief Factory class to construct a MemoryResource that uses
+ * high-bandwidth memory through memkind.
+ *
+ * The only valid name is "HBM". On systems without memkind, flat-mode HBM
+ * that appears as its own NUMA node can be used through that node's
+ * "HOST_NUMA<node>" resource instead.
+ */
+class HbmResourceFactory :
+  public MemoryResourceFactory
+{
+  bool isValidMemoryResourceFor(const std::string& name);
+  std::shared_ptr<MemoryResource> create(const std::string& name, int id);
+};
+
+} // end of namespace resource
+} // end of namespace umpire
+
+#endif // UMPIRE_HbmResourceFactory_HPP
@@ -0,0 +1,74 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/resource/HipDeviceResourceFactory.hpp"
+
+#include "umpire/resource/DefaultMemoryResource.hpp"
+#include "umpire/resource/DeferredFreeMemoryResource.hpp"
+#include "umpire/alloc/HipMallocAllocator.hpp"
+
+#include <cctype>
+
+namespace umpire {
+namespace resource {
+
+bool
+HipDeviceResourceFactory::isValidMemoryResourceFor(const std::string& name)
+{
+  if (name.compare("DEVICE") == 0) {
+    return true;
+  }
+
+  const std::string prefix("DEVICE::");
+
+  if (name.compare(0, prefix.size(), prefix) != 0
+      || name.size() == prefix.size()) {
+    return false;
+  }
+
+  for (size_t i = prefix.size(); i < name.size(); ++i) {
+    if (!std::isdigit(static_cast<unsigned char>(name[i]))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::shared_ptr<MemoryResource>
+HipDeviceResourceFactory::create(const std::string& name, int id)
+{
+  int device = alloc::HipMallocAllocator::current_device;
+
+  if (name.compare("DEVICE") != 0) {
+    device = std::stoi(name.substr(std::string("DEVICE::").size()));
+
+    int device_count = 0;
+    ::hipGetDeviceCount(&device_count);
+    if (device >= device_count) {
+      UMPIRE_ERROR("HIP device " << device << " is not available, found " << device_count << " devices");
+    }
+  }
+
+  if (getDefaultDeferredFree()) {
+    return std::make_shared<resource::DeferredFreeMemoryResource<alloc::HipMallocAllocator> >(
+        Platform::hip, name, id, alloc::HipMallocAllocator(device), Device);
+  }
+
+  return std::make_shared<resource::DefaultMemoryResource<alloc::HipMallocAllocator> >(
+      Platform::hip, name, id, alloc::HipMallocAllocator(device), Device);
+}
+
+} // end of namespace resource
+} // end of namespace umpire
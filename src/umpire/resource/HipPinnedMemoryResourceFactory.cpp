@@ -0,0 +1,51 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/resource/HipPinnedMemoryResourceFactory.hpp"
+
+#include "umpire/resource/DefaultMemoryResource.hpp"
+#include "umpire/resource/DeferredFreeMemoryResource.hpp"
+
+#include "umpire/alloc/HipPinnedAllocator.hpp"
+
+namespace umpire {
+namespace resource {
+
+bool
+HipPinnedMemoryResourceFactory::isValidMemoryResourceFor(const std::string& name)
+{
+  if (name.compare("PINNED") == 0 || name.compare("PINNED_MAPPED") == 0) {
+    return true;
+  } else {
+    return false;
+  }
+}
+
+std::shared_ptr<MemoryResource>
+HipPinnedMemoryResourceFactory::create(const std::string& name, int id)
+{
+  const unsigned int flags = (name.compare("PINNED_MAPPED") == 0) ?
+    hipHostMallocMapped : hipHostMallocDefault;
+
+  if (getDefaultDeferredFree()) {
+    return std::make_shared<resource::DeferredFreeMemoryResource<alloc::HipPinnedAllocator> >(
+        Platform::hip, name, id, alloc::HipPinnedAllocator(flags), PinnedMemory);
+  }
+
+  return std::make_shared<resource::DefaultMemoryResource<alloc::HipPinnedAllocator> >(
+      Platform::hip, name, id, alloc::HipPinnedAllocator(flags), PinnedMemory);
+}
+
+} // end of namespace resource
+} // end of namespace umpire
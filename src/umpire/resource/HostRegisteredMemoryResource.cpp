@@ -0,0 +1,52 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/resource/HostRegisteredMemoryResource.hpp"
+
+#include "umpire/util/Macros.hpp"
+
+#include <cuda_runtime_api.h>
+
+namespace umpire {
+namespace resource {
+
+HostRegisteredMemoryResource::HostRegisteredMemoryResource(const std::string& name, int id) :
+  ExternalMemoryResource(name, id, Platform::cuda, PinnedMemory)
+{
+}
+
+void
+HostRegisteredMemoryResource::registerMemory(void* ptr, size_t bytes)
+{
+  cudaError_t error = ::cudaHostRegister(ptr, bytes, cudaHostRegisterDefault);
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaHostRegister( ptr = " << ptr << ", bytes = " << bytes << " ) failed with error: " << cudaGetErrorString(error));
+  }
+
+  ExternalMemoryResource::registerMemory(ptr, bytes);
+}
+
+void
+HostRegisteredMemoryResource::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  ExternalMemoryResource::deallocateRecord(ptr, record);
+
+  cudaError_t error = ::cudaHostUnregister(ptr);
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaHostUnregister( ptr = " << ptr << " ) failed with error: " << cudaGetErrorString(error));
+  }
+}
+
+} // end of namespace resource
+} // end of namespace umpire
@@ -0,0 +1,52 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_HostRegisteredMemoryResource_HPP
+#define UMPIRE_HostRegisteredMemoryResource_HPP
+
+#include "umpire/resource/ExternalMemoryResource.hpp"
+
+namespace umpire {
+namespace resource {
+
+/*!
+ * \brief MemoryResource for host memory that was allocated elsewhere and
+ * page-locked with cudaHostRegister.
+ *
+ * Registered ranges are recorded in the AllocationMap as PinnedMemory, so
+ * copies between them and the GPU take the same path as PINNED memory.
+ * Deallocating a range only unregisters it; the memory still belongs to
+ * whoever allocated it. Nothing can be allocated from this resource.
+ */
+class HostRegisteredMemoryResource :
+  public ExternalMemoryResource
+{
+  public:
+    HostRegisteredMemoryResource(const std::string& name, int id);
+
+    /*!
+     * \brief Page-lock bytes of host memory at ptr and register the range.
+     */
+    void registerMemory(void* ptr, size_t bytes);
+
+    /*!
+     * \brief Unregister the range starting at ptr.
+     */
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+};
+
+} // end of namespace resource
+} // end of namespace umpire
+
+#endif // UMPIRE_HostRegisteredMemoryResource_HPP
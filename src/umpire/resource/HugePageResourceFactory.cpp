@@ -0,0 +1,51 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/resource/HugePageResourceFactory.hpp"
+
+#include "umpire/resource/DefaultMemoryResource.hpp"
+#include "umpire/alloc/MmapAllocator.hpp"
+
+namespace umpire {
+namespace resource {
+
+bool
+HugePageResourceFactory::isValidMemoryResourceFor(const std::string& name)
+{
+  if ((name.compare("HOST_HUGEPAGE") == 0)
+      || (name.compare("HOST_HUGETLB") == 0)
+      || (name.compare("HOST_HUGETLB_1GB") == 0)) {
+    return true;
+  } else {
+    return false;
+  }
+}
+
+std::shared_ptr<MemoryResource>
+HugePageResourceFactory::create(const std::string& name, int id)
+{
+  alloc::MmapAllocator::Mode mode = alloc::MmapAllocator::Mode::transparent_huge_pages;
+
+  if (name.compare("HOST_HUGETLB") == 0) {
+    mode = alloc::MmapAllocator::Mode::hugetlb_2mb;
+  } else if (name.compare("HOST_HUGETLB_1GB") == 0) {
+    mode = alloc::MmapAllocator::Mode::hugetlb_1gb;
+  }
+
+  return std::make_shared<DefaultMemoryResource<alloc::MmapAllocator> >(
+      Platform::cpu, name, id, alloc::MmapAllocator(mode));
+}
+
+} // end of namespace resource
+} // end of namespace umpire
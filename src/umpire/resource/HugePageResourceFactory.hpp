@@ -0,0 +1,42 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_HugePageResourceFactory_HPP
+#define UMPIRE_HugePageResourceFactory_HPP
+
+#include "umpire/resource/MemoryResourceFactory.hpp"
+
+namespace umpire {
+namespace resource {
+
+
+/*!
+ * \brief Factory class to construct a MemoryResource that uses huge page
+ * backed CPU memory.
+ *
+ * Valid names are "HOST_HUGEPAGE" for transparent huge pages,
+ * "HOST_HUGETLB" for 2MB MAP_HUGETLB pages and "HOST_HUGETLB_1GB" for 1GB
+ * MAP_HUGETLB pages.
+ */
+class HugePageResourceFactory :
+  public MemoryResourceFactory
+{
+  bool isValidMemoryResourceFor(const std::string& name);
+  std::shared_ptr<MemoryResource> create(const std::string& name, int id);
+};
+
+} // end of namespace resource
+} // end of namespace umpire
+
+#endif // UMPIRE_HugePageResourceFactory_HPP
@@ -15,6 +15,8 @@
 #ifndef UMPIRE_MemoryResourceTypes_HPP
 #define UMPIRE_MemoryResourceTypes_HPP
 
+#include <cstddef>
+
 namespace umpire {
 namespace resource {
 
@@ -32,7 +34,8 @@ enum MemoryResourceType {
   Host,
   Device,
   UnifiedMemory,
-  PinnedMemory
+  PinnedMemory,
+  File
 };
 
 } // end of namespace resource
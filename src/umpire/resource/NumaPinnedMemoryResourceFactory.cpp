@@ -0,0 +1,102 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/resource/NumaPinnedMemoryResourceFactory.hpp"
+
+#include "umpire/resource/DefaultMemoryResource.hpp"
+#include "umpire/resource/DeferredFreeMemoryResource.hpp"
+
+#include "umpire/alloc/CudaNumaPinnedAllocator.hpp"
+
+#include <cctype>
+#include <fstream>
+
+namespace umpire {
+namespace resource {
+
+namespace {
+
+const std::string s_prefix("PINNED::");
+
+} // end of anonymous namespace
+
+bool
+NumaPinnedMemoryResourceFactory::isValidMemoryResourceFor(const std::string& name)
+{
+  if (name.compare(0, s_prefix.size(), s_prefix) != 0
+      || name.size() == s_prefix.size()) {
+    return false;
+  }
+
+  for (size_t i = s_prefix.size(); i < name.size(); ++i) {
+    if (!std::isdigit(static_cast<unsigned char>(name[i]))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::shared_ptr<MemoryResource>
+NumaPinnedMemoryResourceFactory::create(const std::string& name, int id)
+{
+  const int device = std::stoi(name.substr(s_prefix.size()));
+
+  int device_count = 0;
+  ::cudaGetDeviceCount(&device_count);
+  if (device >= device_count) {
+    UMPIRE_ERROR("CUDA device " << device << " is not available, found " << device_count << " devices");
+  }
+
+  const int node = getDeviceNode(device);
+  UMPIRE_LOG(Debug, "Placing " << name << " on NUMA node " << node);
+
+  if (getDefaultDeferredFree()) {
+    return std::make_shared<resource::DeferredFreeMemoryResource<alloc::CudaNumaPinnedAllocator> >(
+        Platform::cuda, name, id, alloc::CudaNumaPinnedAllocator(node), PinnedMemory);
+  }
+
+  return std::make_shared<resource::DefaultMemoryResource<alloc::CudaNumaPinnedAllocator> >(
+      Platform::cuda, name, id, alloc::CudaNumaPinnedAllocator(node), PinnedMemory);
+}
+
+int
+NumaPinnedMemoryResourceFactory::getDeviceNode(int device)
+{
+  char bus_id[32];
+
+  if (::cudaDeviceGetPCIBusId(bus_id, sizeof(bus_id), device) != cudaSuccess) {
+    ::cudaGetLastError();
+    return alloc::NumaAllocator::interleaved;
+  }
+
+  // sysfs names devices in lower case, e.g. 0000:3b:00.0
+  std::string pci_name(bus_id);
+  for (auto& c : pci_name) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+
+  std::ifstream numa_node("/sys/bus/pci/devices/" + pci_name + "/numa_node");
+  int node = -1;
+
+  if (!(numa_node >> node) || node < 0
+      || ::numa_available() == -1 || node > ::numa_max_node()) {
+    return alloc::NumaAllocator::interleaved;
+  }
+
+  return node;
+}
+
+} // end of namespace resource
+} // end of namespace umpire
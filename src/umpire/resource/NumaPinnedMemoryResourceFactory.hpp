@@ -0,0 +1,48 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_NumaPinnedMemoryResourceFactory_HPP
+#define UMPIRE_NumaPinnedMemoryResourceFactory_HPP
+
+#include "umpire/resource/MemoryResourceFactory.hpp"
+
+namespace umpire {
+namespace resource {
+
+/*!
+ * \brief Factory for the PINNED::n resources, whose page-locked memory is
+ * placed on the NUMA node closest to CUDA device n.
+ *
+ * The node is read from the device's PCI entry in sysfs. Devices with no
+ * known node get memory interleaved across all nodes.
+ */
+class NumaPinnedMemoryResourceFactory :
+  public MemoryResourceFactory
+{
+  bool isValidMemoryResourceFor(const std::string& name);
+
+  std::shared_ptr<MemoryResource> create(const std::string& name, int id);
+
+  public:
+    /*!
+     * \brief Return the NUMA node closest to CUDA device, or
+     * alloc::NumaAllocator::interleaved if it is not known.
+     */
+    static int getDeviceNode(int device);
+};
+
+} // end of namespace resource
+} // end of namespace umpire
+
+#endif // UMPIRE_NumaPinnedMemoryResourceFactory_HPP
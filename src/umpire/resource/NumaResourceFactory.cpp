@@ -0,0 +1,71 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/resource/NumaResourceFactory.hpp"
+
+#include "umpire/resource/DefaultMemoryResource.hpp"
+#include "umpire/alloc/NumaAllocator.hpp"
+
+#include <cctype>
+
+namespace umpire {
+namespace resource {
+
+namespace {
+
+const std::string s_prefix("HOST_NUMA");
+const std::string s_interleaved("HOST_NUMA_INTERLEAVED");
+
+} // end of anonymous namespace
+
+bool
+NumaResourceFactory::isValidMemoryResourceFor(const std::string& name)
+{
+  if (name.compare(s_interleaved) == 0) {
+    return true;
+  }
+
+  if (name.compare(0, s_prefix.size(), s_prefix) != 0
+      || name.size() == s_prefix.size()) {
+    return false;
+  }
+
+  for (size_t i = s_prefix.size(); i < name.size(); ++i) {
+    if (!std::isdigit(static_cast<unsigned char>(name[i]))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::shared_ptr<MemoryResource>
+NumaResourceFactory::create(const std::string& name, int id)
+{
+  int node = alloc::NumaAllocator::interleaved;
+
+  if (name.compare(s_interleaved) != 0) {
+    node = std::stoi(name.substr(s_prefix.size()));
+
+    if (::numa_available() == -1 || node > ::numa_max_node()) {
+      UMPIRE_ERROR("NUMA node " << node << " is not available");
+    }
+  }
+
+  return std::make_shared<DefaultMemoryResource<alloc::NumaAllocator> >(
+      Platform::cpu, name, id, alloc::NumaAllocator(node));
+}
+
+} // end of namespace resource
+} // end of namespace umpire
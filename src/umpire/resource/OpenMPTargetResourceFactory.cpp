@@ -0,0 +1,71 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/resource/OpenMPTargetResourceFactory.hpp"
+
+#include "umpire/resource/DefaultMemoryResource.hpp"
+#include "umpire/alloc/OpenMPTargetAllocator.hpp"
+
+#include <cctype>
+
+namespace umpire {
+namespace resource {
+
+namespace {
+
+const std::string s_name("OMP_TARGET");
+const std::string s_prefix("OMP_TARGET::");
+
+} // end of anonymous namespace
+
+bool
+OpenMPTargetResourceFactory::isValidMemoryResourceFor(const std::string& name)
+{
+  if (name.compare(s_name) == 0) {
+    return true;
+  }
+
+  if (name.compare(0, s_prefix.size(), s_prefix) != 0
+      || name.size() == s_prefix.size()) {
+    return false;
+  }
+
+  for (size_t i = s_prefix.size(); i < name.size(); ++i) {
+    if (!std::isdigit(static_cast<unsigned char>(name[i]))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::shared_ptr<MemoryResource>
+OpenMPTargetResourceFactory::create(const std::string& name, int id)
+{
+  int device = alloc::OpenMPTargetAllocator::default_device;
+
+  if (name.compare(s_name) != 0) {
+    device = std::stoi(name.substr(s_prefix.size()));
+
+    if (device >= ::omp_get_num_devices()) {
+      UMPIRE_ERROR("OpenMP target device " << device << " is not available, found " << ::omp_get_num_devices() << " devices");
+    }
+  }
+
+  return std::make_shared<DefaultMemoryResource<alloc::OpenMPTargetAllocator> >(
+      Platform::omp_target, name, id, alloc::OpenMPTargetAllocator(device), Device);
+}
+
+} // end of namespace resource
+} // end of namespace umpire
@@ -15,6 +15,7 @@
 #include "umpire/resource/PinnedMemoryResourceFactory.hpp"
 
 #include "umpire/resource/DefaultMemoryResource.hpp"
+#include "umpire/resource/DeferredFreeMemoryResource.hpp"
 
 #include "umpire/alloc/CudaPinnedAllocator.hpp"
 
@@ -24,7 +25,7 @@ namespace resource {
 bool
 PinnedMemoryResourceFactory::isValidMemoryResourceFor(const std::string& name)
 {
-  if (name.compare("PINNED") == 0) {
+  if (name.compare("PINNED") == 0 || name.compare("PINNED_MAPPED") == 0) {
     return true;
   } else {
     return false;
@@ -32,9 +33,18 @@ PinnedMemoryResourceFactory::isValidMemoryResourceFor(const std::string& name)
 }
 
 std::shared_ptr<MemoryResource>
-PinnedMemoryResourceFactory::create(const std::string& UMPIRE_UNUSED_ARG(name), int id)
+PinnedMemoryResourceFactory::create(const std::string& name, int id)
 {
-  return std::make_shared<resource::DefaultMemoryResource<alloc::CudaPinnedAllocator> >(Platform::cuda, "PINNED", id);
+  const unsigned int flags = (name.compare("PINNED_MAPPED") == 0) ?
+    cudaHostAllocMapped : cudaHostAllocDefault;
+
+  if (getDefaultDeferredFree()) {
+    return std::make_shared<resource::DeferredFreeMemoryResource<alloc::CudaPinnedAllocator> >(
+        Platform::cuda, name, id, alloc::CudaPinnedAllocator(flags), PinnedMemory);
+  }
+
+  return std::make_shared<resource::DefaultMemoryResource<alloc::CudaPinnedAllocator> >(
+      Platform::cuda, name, id, alloc::CudaPinnedAllocator(flags), PinnedMemory);
 }
 
 } // end of namespace resource
@@ -20,6 +20,13 @@
 namespace umpire {
 namespace resource {
 
+/*!
+ * \brief Factory class for constructing MemoryResource objects that use
+ * page-locked host memory.
+ *
+ * "PINNED_MAPPED" memory is also mapped into the device address space, so
+ * kernels can read and write it without an explicit copy.
+ */
 class PinnedMemoryResourceFactory :
   public MemoryResourceFactory
 {
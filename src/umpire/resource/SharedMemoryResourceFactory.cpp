@@ -0,0 +1,48 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/resource/SharedMemoryResourceFactory.hpp"
+
+#include <unistd.h>
+
+#include <cstdlib>
+
+#include "umpire/resource/DefaultMemoryResource.hpp"
+#include "umpire/alloc/SharedMemoryAllocator.hpp"
+
+namespace umpire {
+namespace resource {
+
+bool
+SharedMemoryResourceFactory::isValidMemoryResourceFor(const std::string& name)
+{
+  if (name.compare("SHARED") == 0) {
+    return true;
+  } else {
+    return false;
+  }
+}
+
+std::shared_ptr<MemoryResource>
+SharedMemoryResourceFactory::create(const std::string& name, int id)
+{
+  const char* key = std::getenv("UMPIRE_SHARED_KEY");
+
+  return std::make_shared<DefaultMemoryResource<alloc::SharedMemoryAllocator> >(
+      Platform::cpu, name, id,
+      alloc::SharedMemoryAllocator(key ? key : std::to_string(::getppid())));
+}
+
+} // end of namespace resource
+} // end of namespace umpire
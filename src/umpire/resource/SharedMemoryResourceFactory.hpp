@@ -0,0 +1,43 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_SharedMemoryResourceFactory_HPP
+#define UMPIRE_SharedMemoryResourceFactory_HPP
+
+#include "umpire/resource/MemoryResourceFactory.hpp"
+
+namespace umpire {
+namespace resource {
+
+
+/*!
+ * \brief Factory class to construct a MemoryResource that uses CPU memory
+ * shared by the processes on a node.
+ *
+ * The only valid name is "SHARED". Processes share segments when they use
+ * the same key, taken from the UMPIRE_SHARED_KEY environment variable. The
+ * default key is the parent process ID, which is shared by ranks started by
+ * the same launcher daemon on a node (e.g. slurmstepd or an MPI proxy).
+ */
+class SharedMemoryResourceFactory :
+  public MemoryResourceFactory
+{
+  bool isValidMemoryResourceFor(const std::string& name);
+  std::shared_ptr<MemoryResource> create(const std::string& name, int id);
+};
+
+} // end of namespace resource
+} // end of namespace umpire
+
+#endif // UMPIRE_SharedMemoryResourceFactory_HPP
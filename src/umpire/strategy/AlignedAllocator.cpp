@@ -0,0 +1,138 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/AlignedAllocator.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+#include <algorithm>
+
+namespace umpire {
+namespace strategy {
+
+AlignedAllocator::AlignedAllocator(
+    const std::string& name,
+    int id,
+    Allocator allocator,
+    size_t alignment) :
+  AllocationStrategy(name, id),
+  m_current_size(0),
+  m_highwatermark(0),
+  m_allocator(allocator.getAllocationStrategy()),
+  m_alignment(alignment)
+{
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+    UMPIRE_ERROR("AlignedAllocator alignment must be a power of two, got " << alignment);
+  }
+}
+
+void*
+AlignedAllocator::allocate(size_t bytes)
+{
+  return allocateAligned(bytes, m_alignment);
+}
+
+void*
+AlignedAllocator::allocateAligned(size_t bytes, size_t alignment)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ", alignment=" << alignment << ")");
+
+  const size_t padded = (bytes + (m_alignment - 1)) & ~(m_alignment - 1);
+
+  OwnerScope scope(this, bytes);
+  void* ptr = m_allocator->allocateAligned(padded, std::max(alignment, m_alignment));
+
+  if (!scope.claimed()) {
+    ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+  }
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ptr;
+}
+
+void
+AlignedAllocator::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+AlignedAllocator::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  // The wrapped allocator was asked for the padded size
+  const size_t padded = (record.m_size + (m_alignment - 1)) & ~(m_alignment - 1);
+  m_allocator->deallocateRecord(ptr, {ptr, padded, record.m_strategy});
+  util::decreaseSize(m_current_size, record.m_size);
+}
+
+void
+AlignedAllocator::coalesce()
+{
+  m_allocator->coalesce();
+}
+
+void
+AlignedAllocator::release()
+{
+  m_allocator->release();
+}
+
+long
+AlignedAllocator::getCurrentSize()
+{
+  return m_current_size.load(std::memory_order_relaxed);
+}
+
+long
+AlignedAllocator::getHighWatermark()
+{
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+long
+AlignedAllocator::getActualSize()
+{
+  return m_allocator->getActualSize();
+}
+
+Platform
+AlignedAllocator::getPlatform()
+{
+  return m_allocator->getPlatform();
+}
+
+resource::MemoryResourceType
+AlignedAllocator::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+bool
+AlignedAllocator::isThreadSafe()
+{
+  return m_allocator->isThreadSafe();
+}
+
+size_t
+AlignedAllocator::getAlignment()
+{
+  return m_alignment;
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
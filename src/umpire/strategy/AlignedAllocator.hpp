@@ -0,0 +1,84 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_AlignedAllocator_HPP
+#define UMPIRE_AlignedAllocator_HPP
+
+#include <atomic>
+#include <memory>
+
+#include "umpire/Allocator.hpp"
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Pad every allocation from another AllocationStrategy to a whole
+ * number of alignment-sized units, starting on a unit boundary.
+ *
+ * Pools hand neighbouring blocks to different threads, so small per-thread
+ * buffers can end up on the same cache line and false share. Wrapping the
+ * pool with an alignment of the cache line size (64 or 128 bytes), or the
+ * page size, gives each allocation its own lines or pages.
+ *
+ * The wrapped strategy must support allocateAligned at this alignment, as
+ * DynamicPool, ArenaAllocator and MonotonicAllocationStrategy do.
+ */
+class AlignedAllocator :
+  public AllocationStrategy
+{
+  public:
+    AlignedAllocator(
+        const std::string& name,
+        int id,
+        Allocator allocator,
+        size_t alignment = 64);
+
+    void* allocate(size_t bytes);
+    void* allocateAligned(size_t bytes, size_t alignment);
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    void coalesce();
+    void release();
+
+    long getCurrentSize();
+    long getHighWatermark();
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+    bool isThreadSafe();
+
+    /*!
+     * \brief Return the alignment, and size granularity, of every allocation.
+     */
+    size_t getAlignment();
+
+  private:
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
+
+    std::shared_ptr<AllocationStrategy> m_allocator;
+
+    const size_t m_alignment;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_AlignedAllocator_HPP
@@ -17,6 +17,7 @@
 #include "umpire/op/MemoryOperationRegistry.hpp"
 
 #include "umpire/ResourceManager.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
 
 #if defined(UMPIRE_ENABLE_CUDA)
 #include <cuda_runtime_api.h>
@@ -45,14 +46,15 @@ AllocationAdvisor::AllocationAdvisor(
   m_current_size(0),
   m_highwatermark(0),
   m_allocator(allocator.getAllocationStrategy()),
-  m_device(0)
+  m_device(0),
+  m_stream(nullptr)
 {
   auto& op_registry = op::MemoryOperationRegistry::getInstance();
 
   m_advice_operation = op_registry.find(
       advice_operation,
-      m_allocator,
-      m_allocator);
+      m_allocator.get(),
+      m_allocator.get());
 
 #if defined(UMPIRE_ENABLE_CUDA)
   if (accessing_allocator.getPlatform() == Platform::cpu) {
@@ -63,42 +65,81 @@ AllocationAdvisor::AllocationAdvisor(
 #endif
 }
 
+AllocationAdvisor::AllocationAdvisor(
+    const std::string& name,
+    int id,
+    Allocator allocator,
+    const std::string& advice_operation,
+    void* stream) :
+  AllocationAdvisor(
+      name, id, allocator, advice_operation, allocator)
+{
+  m_stream = stream;
+}
+
 void* AllocationAdvisor::allocate(size_t bytes)
 {
+  OwnerScope scope(this, bytes);
   void* ptr = m_allocator->allocate(bytes);
-  auto alloc_record = new util::AllocationRecord{ptr, bytes, this->shared_from_this()};
 
-  m_advice_operation->apply(
-      ptr, 
-      alloc_record,
-      m_device, 
-      bytes);
+  util::AllocationRecord record{ptr, bytes, this};
+  if (!scope.claimed()) {
+    ResourceManager::getInstance().registerAllocation(ptr, record);
+  }
 
-  ResourceManager::getInstance().registerAllocation(ptr, alloc_record);
+  m_advice_operation->applyAsync(
+      ptr,
+      &record,
+      m_device,
+      bytes,
+      m_stream);
 
-  m_current_size += bytes;
-  if (m_current_size > m_highwatermark)
-    m_highwatermark = m_current_size;
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ptr;
+}
+
+void* AllocationAdvisor::allocateAligned(size_t bytes, size_t alignment)
+{
+  OwnerScope scope(this, bytes);
+  void* ptr = m_allocator->allocateAligned(bytes, alignment);
+
+  util::AllocationRecord record{ptr, bytes, this};
+  if (!scope.claimed()) {
+    ResourceManager::getInstance().registerAllocation(ptr, record);
+  }
+
+  m_advice_operation->applyAsync(
+      ptr,
+      &record,
+      m_device,
+      bytes,
+      m_stream);
+
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
 
   return ptr;
 }
 
 void AllocationAdvisor::deallocate(void* ptr)
 {
-  m_allocator->deallocate(ptr);
-  m_current_size -= ResourceManager::getInstance().getSize(ptr);
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
 
-  ResourceManager::getInstance().deregisterAllocation(ptr);
+void AllocationAdvisor::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  m_allocator->deallocateRecord(ptr, record);
+  util::decreaseSize(m_current_size, record.m_size);
 }
 
 long AllocationAdvisor::getCurrentSize()
 {
-  return m_current_size;
+  return m_current_size.load(std::memory_order_relaxed);
 }
 
 long AllocationAdvisor::getHighWatermark()
 {
-  return m_highwatermark;
+  return m_highwatermark.load(std::memory_order_relaxed);
 }
 
 Platform AllocationAdvisor::getPlatform()
@@ -106,5 +147,11 @@ Platform AllocationAdvisor::getPlatform()
   return m_allocator->getPlatform();
 }
 
+resource::MemoryResourceType
+AllocationAdvisor::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
 } // end of namespace strategy
 } // end of namespace umpire
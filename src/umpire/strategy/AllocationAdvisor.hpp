@@ -15,6 +15,7 @@
 #ifndef UMPIRE_AllocationAdvisor_HPP
 #define UMPIRE_AllocationAdvisor_HPP
 
+#include <atomic>
 #include <memory>
 
 #include "umpire/strategy/AllocationStrategy.hpp"
@@ -24,6 +25,22 @@
 namespace umpire {
 namespace strategy {
 
+/*!
+ * \brief Applies a MemoryOperation, e.g. a cudaMemAdvise hint, to every
+ * allocation made from the underlying allocator.
+ *
+ * The operation is one of "READ_MOSTLY", "PREFERRED_LOCATION",
+ * "ACCESSED_BY", "PREFETCH" or "PERSISTING_L2", and is applied for the host
+ * when the accessing allocator is on the cpu platform. "PREFETCH" moves new
+ * unified memory allocations to where they will be used, so the first touch
+ * does not page fault. "PERSISTING_L2" keeps a new allocation in the L2
+ * cache for kernels on the stream given to the constructor; a stream holds
+ * one such range, so it suits a few small, heavily reused tables.
+ *
+ * Advice applies to whole pages. When advising allocations from a pool,
+ * give the DynamicPool an alignment of the page size so that no page is
+ * shared with an allocation advised differently.
+ */
 class AllocationAdvisor :
   public AllocationStrategy
 {
@@ -41,22 +58,40 @@ class AllocationAdvisor :
         const std::string& advice_operation,
         Allocator accessing_allocator);
 
+      /*!
+       * \brief Apply advice_operation for work on stream, e.g. the
+       * cudaStream_t whose kernels should keep allocations in L2 with
+       * "PERSISTING_L2".
+       */
+      AllocationAdvisor(
+        const std::string& name,
+        int id,
+        Allocator allocator,
+        const std::string& advice_operation,
+        void* stream);
+
     void* allocate(size_t bytes);
+    void* allocateAligned(size_t bytes, size_t alignment);
     void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
 
     long getCurrentSize();
     long getHighWatermark();
 
     Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
   private:
     std::shared_ptr<op::MemoryOperation> m_advice_operation;
 
-    long m_current_size;
-    long m_highwatermark;
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
 
     std::shared_ptr<umpire::strategy::AllocationStrategy> m_allocator;
 
     int m_device;
+
+    void* m_stream;
 };
 
 } // end of namespace strategy
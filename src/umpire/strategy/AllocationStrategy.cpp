@@ -14,13 +14,92 @@
 //////////////////////////////////////////////////////////////////////////////
 #include "umpire/strategy/AllocationStrategy.hpp"
 
+#include "umpire/ResourceManager.hpp"
+
+#include "umpire/util/Macros.hpp"
+
+#include <cstdint>
+#include <new>
+
 namespace umpire {
 namespace strategy {
 
+thread_local AllocationStrategy::OwnerScope::Claim* AllocationStrategy::s_claim = nullptr;
+
+AllocationStrategy::OwnerScope::OwnerScope(AllocationStrategy* owner, size_t bytes) :
+  m_claim{owner, bytes, false},
+  m_previous(s_claim),
+  m_active(nullptr)
+{
+  if (!owner) {
+    s_claim = nullptr;
+  } else if (m_previous) {
+    m_active = m_previous;
+  } else {
+    m_active = &m_claim;
+    s_claim = m_active;
+  }
+}
+
+AllocationStrategy::OwnerScope::~OwnerScope()
+{
+  s_claim = m_previous;
+}
+
+bool
+AllocationStrategy::OwnerScope::claimed() const
+{
+  return m_active && m_active->claimed;
+}
+
+bool
+AllocationStrategy::claimRecord(util::AllocationRecord& record)
+{
+  OwnerScope::Claim* claim = s_claim;
+
+  if (!claim) {
+    return false;
+  }
+
+  record.m_strategy = claim->owner;
+  if (claim->bytes) {
+    record.m_size = claim->bytes;
+  }
+  claim->claimed = true;
+
+  return true;
+}
+
 AllocationStrategy::AllocationStrategy(const std::string& name, int id) :
   m_name(name),
-  m_id(id)
+  m_id(id),
+  m_statistics(nullptr),
+  m_compress_copies(false)
+#if defined(UMPIRE_ENABLE_STATISTICS) || defined(UMPIRE_ENABLE_TRACE)
+  , m_statistic_handle(util::detail::get_statistic_handle(name))
+#endif
+{
+}
+
+AllocationStrategy::~AllocationStrategy()
+{
+  delete m_statistics.load();
+}
+
+void
+AllocationStrategy::enableStatistics()
 {
+  if (getStatistics()) {
+    return;
+  }
+
+  util::AllocatorStatistics* expected = nullptr;
+  util::AllocatorStatistics* statistics = new util::AllocatorStatistics();
+
+  if (!m_statistics.compare_exchange_strong(expected, statistics,
+        std::memory_order_acq_rel)) {
+    delete statistics;
+  }
 }
 
 std::string
@@ -35,11 +114,166 @@ AllocationStrategy::getId()
   return m_id;
 }
 
+void*
+AllocationStrategy::allocateAligned(size_t bytes, size_t alignment)
+{
+  void* ptr = allocate(bytes);
+
+  if (reinterpret_cast<uintptr_t>(ptr) % alignment != 0) {
+    deallocate(ptr);
+    UMPIRE_ERROR(m_name << " cannot align an allocation to " << alignment << " bytes");
+  }
+
+  return ptr;
+}
+
+void*
+AllocationStrategy::allocateWithLifetime(size_t bytes, Lifetime UMPIRE_UNUSED_ARG(lifetime))
+{
+  return allocate(bytes);
+}
+
+void*
+AllocationStrategy::allocateZeroed(size_t bytes)
+{
+  void* ptr = allocate(bytes);
+
+  if (bytes > 0) {
+    ResourceManager::getInstance().memset(ptr, 0, bytes);
+  }
+
+  return ptr;
+}
+
+void*
+AllocationStrategy::tryAllocate(size_t bytes)
+{
+  try {
+    return allocate(bytes);
+  } catch (util::Exception&) {
+  } catch (std::bad_alloc&) {
+  }
+
+  return nullptr;
+}
+
+void
+AllocationStrategy::allocateMany(const size_t* sizes, size_t count, void** ptrs)
+{
+  size_t i = 0;
+
+  try {
+    for (; i < count; ++i) {
+      ptrs[i] = allocate(sizes[i]);
+    }
+  } catch (...) {
+    while (i > 0) {
+      deallocate(ptrs[--i]);
+    }
+    throw;
+  }
+}
+
+void
+AllocationStrategy::deallocateMany(void** ptrs, size_t count)
+{
+  for (size_t i = 0; i < count; ++i) {
+    if (ptrs[i]) {
+      deallocate(ptrs[i]);
+    }
+  }
+}
+
+void
+AllocationStrategy::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  ResourceManager::getInstance().registerAllocation(ptr, record);
+  deallocate(ptr);
+}
+
+void*
+AllocationStrategy::allocateUntracked(size_t bytes)
+{
+  // Keep any enclosing strategy from claiming this chunk
+  OwnerScope scope(nullptr);
+  return allocate(bytes);
+}
+
+void
+AllocationStrategy::deallocateUntracked(void* ptr)
+{
+  deallocate(ptr);
+}
+
+void
+AllocationStrategy::deallocateUntracked(void* ptr, size_t UMPIRE_UNUSED_ARG(bytes))
+{
+  deallocateUntracked(ptr);
+}
+
+void*
+AllocationStrategy::tryAllocateUntracked(size_t bytes)
+{
+  try {
+    return allocateUntracked(bytes);
+  } catch (util::Exception&) {
+  } catch (std::bad_alloc&) {
+  }
+
+  return nullptr;
+}
+
+bool
+AllocationStrategy::reallocateInPlace(void* UMPIRE_UNUSED_ARG(ptr), size_t UMPIRE_UNUSED_ARG(bytes))
+{
+  return false;
+}
+
+void
+AllocationStrategy::coalesce()
+{
+}
+
+void
+AllocationStrategy::release()
+{
+}
+
+void
+AllocationStrategy::trim(size_t UMPIRE_UNUSED_ARG(target_bytes))
+{
+}
+
+void
+AllocationStrategy::reserve(
+    size_t UMPIRE_UNUSED_ARG(bytes),
+    bool UMPIRE_UNUSED_ARG(prefault))
+{
+}
+
 long
 AllocationStrategy::getActualSize()
 {
   return getCurrentSize();
 }
 
+resource::MemoryResourceType
+AllocationStrategy::getResourceType()
+{
+  return (getPlatform() == Platform::cpu) ? resource::Host : resource::Device;
+}
+
+bool
+AllocationStrategy::isThreadSafe()
+{
+  return false;
+}
+
+util::AllocationRecord*
+AllocationStrategy::findRecord(void* UMPIRE_UNUSED_ARG(ptr), void* UMPIRE_UNUSED_ARG(handle))
+{
+  return nullptr;
+}
+
 } // end of namespace strategy
 } // end of namespace umpire
@@ -16,6 +16,13 @@
 #define UMPIRE_AllocationStrategy_HPP
 
 #include "umpire/util/Platform.hpp"
+#include "umpire/resource/MemoryResourceTypes.hpp"
+#include "umpire/util/AllocatorStatistics.hpp"
+#include "umpire/util/Lifetime.hpp"
+#include "umpire/util/AllocationRecord.hpp"
+#include "umpire/util/StatisticHandle.hpp"
+
+#include <atomic>
 
 #include <string>
 #include <memory>
@@ -34,6 +41,8 @@ class AllocationStrategy :
   public:
     AllocationStrategy(const std::string& name, int id);
 
+    virtual ~AllocationStrategy();
+
     /*!
      * \brief Allocate bytes of memory.
      *
@@ -50,20 +59,351 @@ class AllocationStrategy :
      */
     virtual void deallocate(void* ptr) = 0;
 
+    /*!
+     * \brief Free the memory at ptr, whose record has already been removed
+     * from the AllocationMap.
+     *
+     * ResourceManager::deallocate removes the record while looking up the
+     * owning strategy and passes it here, so a free costs a single map
+     * operation. Strategies that register their allocations implement
+     * deallocate by deregistering ptr and calling this method. The default
+     * implementation registers record again and calls deallocate.
+     *
+     * \param ptr Pointer to free.
+     * \param record The record that was registered for ptr.
+     */
+    virtual void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    /*!
+     * \brief Allocate bytes of memory aligned to alignment bytes.
+     *
+     * Strategies that can place allocations on a boundary override this.
+     * The default implementation calls allocate and throws if the result
+     * happens not to be aligned.
+     *
+     * \param bytes Number of bytes to allocate.
+     * \param alignment Alignment in bytes; a power of two.
+     *
+     * \return Pointer to start of allocation.
+     */
+    virtual void* allocateAligned(size_t bytes, size_t alignment);
+
+    /*!
+     * \brief Allocate bytes of memory expected to live for lifetime.
+     *
+     * Strategies that segregate allocations by lifetime override this.
+     * The default implementation ignores the hint and calls allocate.
+     *
+     * \param bytes Number of bytes to allocate.
+     * \param lifetime Expected lifetime of the allocation.
+     *
+     * \return Pointer to start of allocation.
+     */
+    virtual void* allocateWithLifetime(size_t bytes, Lifetime lifetime);
+
+    /*!
+     * \brief Allocate bytes of memory that reads as zero.
+     *
+     * Memory resources override this to skip clearing memory they know to
+     * be zero already, such as freshly mapped host pages. The default
+     * implementation calls allocate and then the ResourceManager's memset
+     * operation for the platform, e.g. cudaMemset on a device.
+     *
+     * \param bytes Number of bytes to allocate.
+     *
+     * \return Pointer to start of allocation.
+     */
+    virtual void* allocateZeroed(size_t bytes);
+
+    /*!
+     * \brief Allocate bytes of memory, returning nullptr instead of throwing
+     * if they cannot be allocated.
+     *
+     * Memory resources override this so that running out of memory raises
+     * no exception. The default implementation calls allocate and catches
+     * any umpire::util::Exception or std::bad_alloc.
+     *
+     * \param bytes Number of bytes to allocate.
+     *
+     * \return Pointer to start of allocation, or nullptr.
+     */
+    virtual void* tryAllocate(size_t bytes);
+
+    /*!
+     * \brief Allocate count blocks of memory at once.
+     *
+     * Strategies that can serve a batch with one search, one lock and one
+     * AllocationMap update override this. The default implementation calls
+     * allocate for each block, freeing the blocks already allocated if one
+     * of them fails.
+     *
+     * \param sizes Number of bytes for each block.
+     * \param count Number of blocks.
+     * \param ptrs Receives the pointer to each block.
+     */
+    virtual void allocateMany(const size_t* sizes, size_t count, void** ptrs);
+
+    /*!
+     * \brief Free count blocks of memory at once.
+     *
+     * The default implementation calls deallocate for each non-null
+     * pointer.
+     *
+     * \param ptrs Pointers to free.
+     * \param count Number of pointers.
+     */
+    virtual void deallocateMany(void** ptrs, size_t count);
+
+    /*!
+     * \brief Allocate bytes of memory without registering the allocation
+     * with the ResourceManager.
+     *
+     * Strategies that can hand out memory without a record in the
+     * AllocationMap override this method; the default implementation calls
+     * allocate, registering the memory with this strategy even when called
+     * from inside another strategy's allocate.
+     *
+     * \param bytes Number of bytes to allocate.
+     *
+     * \return Pointer to start of allocation.
+     */
+    virtual void* allocateUntracked(size_t bytes);
+
+    /*!
+     * \brief Free memory obtained from allocateUntracked.
+     *
+     * \param ptr Pointer to free.
+     */
+    virtual void deallocateUntracked(void* ptr);
+
+    /*!
+     * \brief Free memory obtained from allocateUntracked(bytes).
+     *
+     * Memory resources need the size to keep their statistics, so
+     * strategies that take chunks from another strategy free them with this
+     * method. The default implementation ignores bytes and calls
+     * deallocateUntracked(ptr).
+     *
+     * \param ptr Pointer to free.
+     * \param bytes Number of bytes passed to allocateUntracked.
+     */
+    virtual void deallocateUntracked(void* ptr, size_t bytes);
+
+    /*!
+     * \brief Allocate bytes of memory without registering the allocation,
+     * returning nullptr instead of throwing if they cannot be allocated.
+     *
+     * Pools grow with this when asked to tryAllocate. The default
+     * implementation calls allocateUntracked and catches the exception.
+     *
+     * \param bytes Number of bytes to allocate.
+     *
+     * \return Pointer to start of allocation, or nullptr.
+     */
+    virtual void* tryAllocateUntracked(size_t bytes);
+
+    /*!
+     * \brief Try to resize the allocation at ptr to bytes without moving
+     * it.
+     *
+     * Strategies that can grow or shrink a block into neighbouring free
+     * memory override this, updating the allocation's record. The default
+     * implementation does nothing and returns false.
+     *
+     * \param ptr Pointer to an allocation made by this strategy.
+     * \param bytes New size in bytes.
+     *
+     * \return true if the allocation now holds bytes bytes, false if the
+     * caller must allocate, copy and free instead.
+     */
+    virtual bool reallocateInPlace(void* ptr, size_t bytes);
+
+    /*!
+     * \brief Merge free memory held by this strategy into as few blocks as
+     * possible.
+     *
+     * The default implementation does nothing.
+     */
+    virtual void coalesce();
+
+    /*!
+     * \brief Return all unused memory held by this strategy to the
+     * underlying allocator.
+     *
+     * The default implementation does nothing.
+     */
+    virtual void release();
+
+    /*!
+     * \brief Return unused memory held by this strategy to the underlying
+     * allocator until getActualSize is no more than target_bytes.
+     *
+     * The default implementation does nothing.
+     *
+     * \param target_bytes Size to shrink to.
+     */
+    virtual void trim(size_t target_bytes);
+
+    /*!
+     * \brief Take memory from the underlying allocator so that at least
+     * bytes are held free, faulting its pages in if prefault is set.
+     *
+     * The default implementation does nothing.
+     *
+     * \param bytes Number of bytes to hold free.
+     * \param prefault Whether to touch or prefetch the new memory.
+     */
+    virtual void reserve(size_t bytes, bool prefault);
+
     virtual long getCurrentSize() = 0;
     virtual long getHighWatermark() = 0;
     virtual long getActualSize();
 
     virtual Platform getPlatform()  = 0;
 
+    /*!
+     * \brief Return the kind of memory resource this strategy ultimately
+     * allocates from, used to pick specialized memory operations.
+     *
+     * The default implementation derives it from getPlatform, returning
+     * Host for cpu and Device for cuda.
+     */
+    virtual resource::MemoryResourceType getResourceType();
+
+    /*!
+     * \brief Return whether allocate, deallocate and the other mutating
+     * methods may be called concurrently from several threads.
+     *
+     * ThreadSafeAllocator skips its lock for strategies that return true.
+     * The default implementation returns false.
+     */
+    virtual bool isThreadSafe();
+
+    /*!
+     * \brief Return the record of the live allocation containing ptr, or
+     * nullptr if there is none.
+     *
+     * Only called for pointers inside a chunk that this strategy registered
+     * with ResourceManager::registerChunk, with the handle it passed there.
+     * Strategies that register chunks keep their allocations out of the
+     * ResourceManager's AllocationMap and must implement this. The default
+     * implementation returns nullptr.
+     */
+    virtual util::AllocationRecord* findRecord(void* ptr, void* handle);
+
     std::string getName();
 
     int getId();
 
+    /*!
+     * \brief Start recording latency and size histograms for this strategy.
+     *
+     * Calling this again has no effect; recording cannot be turned off.
+     */
+    void enableStatistics();
+
+    /*!
+     * \brief Return the histograms recorded for this strategy, or nullptr
+     * if enableStatistics has not been called.
+     */
+    util::AllocatorStatistics* getStatistics() noexcept {
+      return m_statistics.load(std::memory_order_acquire);
+    }
+
+    /*!
+     * \brief Set whether ResourceManager::copy compresses data moved into
+     * or out of this strategy's memory, as ResourceManager::copyCompressed
+     * does.
+     */
+    void setCompressCopies(bool compress) noexcept {
+      m_compress_copies.store(compress, std::memory_order_relaxed);
+    }
+
+    bool getCompressCopies() const noexcept {
+      return m_compress_copies.load(std::memory_order_relaxed);
+    }
+
+#if defined(UMPIRE_ENABLE_STATISTICS) || defined(UMPIRE_ENABLE_TRACE)
+    /*!
+     * \brief Return the handle UMPIRE_RECORD_STATISTIC records this
+     * strategy's events against, resolved from its name at construction.
+     */
+    util::StatisticHandle getStatisticHandle() noexcept {
+      return m_statistic_handle;
+    }
+#endif
+
+    /*!
+     * \brief Apply the OwnerScope active on the calling thread, if any, to
+     * a record about to be registered.
+     *
+     * Called by ResourceManager::registerAllocation. The record is given the
+     * scope's owner, and its size if the scope has one.
+     *
+     * \return true if the record was changed.
+     */
+    static bool claimRecord(util::AllocationRecord& record);
+
   protected:
+    /*!
+     * \brief Make this strategy the owner of the allocation registered by
+     * the strategies it calls while the scope is alive.
+     *
+     * Strategies that pass each allocation through to another strategy
+     * create one around the call, instead of registering a record of their
+     * own on top of the one registered underneath. The single record names
+     * the outermost strategy, so an allocation costs one AllocationMap
+     * insertion however many strategies are stacked. Nested scopes defer to
+     * the outermost one. If nothing was registered, e.g. because the strategy
+     * underneath keeps its own records, claimed() is false and the caller
+     * registers the allocation itself.
+     *
+     * On deallocation the owner receives the record and passes it down with
+     * deallocateRecord.
+     *
+     * A scope with a null owner hides any outer scope, for strategies that
+     * need the record registered underneath to find where a pointer came
+     * from.
+     */
+    class OwnerScope {
+      public:
+        OwnerScope(AllocationStrategy* owner, size_t bytes = 0);
+        ~OwnerScope();
+
+        OwnerScope(const OwnerScope&) = delete;
+        OwnerScope& operator=(const OwnerScope&) = delete;
+
+        bool claimed() const;
+
+      private:
+        struct Claim {
+          AllocationStrategy* owner;
+          size_t bytes;
+          bool claimed;
+        };
+
+        Claim m_claim;
+        Claim* m_previous;
+        Claim* m_active;
+
+        friend class AllocationStrategy;
+    };
+
     std::string m_name;
 
     int m_id;
+
+  private:
+    // The claim of the outermost OwnerScope on this thread.
+    static thread_local OwnerScope::Claim* s_claim;
+
+    std::atomic<util::AllocatorStatistics*> m_statistics;
+
+    std::atomic<bool> m_compress_copies;
+
+#if defined(UMPIRE_ENABLE_STATISTICS) || defined(UMPIRE_ENABLE_TRACE)
+    util::StatisticHandle m_statistic_handle;
+#endif
 };
 
 } // end of namespace strategy
@@ -0,0 +1,251 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/ArenaAllocator.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace strategy {
+
+ArenaAllocator::ArenaAllocator(
+    const std::string& name,
+    int id,
+    Allocator allocator,
+    const std::size_t block_size,
+    const std::size_t alignment,
+    const bool track_allocations) :
+  AllocationStrategy(name, id),
+  m_blocks(),
+  m_current_block(0),
+  m_offset(0),
+  m_block_size(block_size),
+  m_alignment(alignment),
+  m_track_allocations(track_allocations),
+  m_current_size(0),
+  m_highwatermark(0),
+  m_actual_size(0),
+  m_allocator(allocator.getAllocationStrategy())
+{
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+    UMPIRE_ERROR("ArenaAllocator alignment must be a power of two, got " << alignment);
+  }
+}
+
+ArenaAllocator::~ArenaAllocator()
+{
+  if (m_track_allocations) {
+    deregisterFrom(0, 0);
+  }
+
+  for (auto& block : m_blocks) {
+    m_allocator->deallocateUntracked(block.data, block.size);
+  }
+}
+
+void*
+ArenaAllocator::allocate(size_t bytes)
+{
+  void* ret = bump(bytes, m_alignment);
+
+  if (m_track_allocations) {
+    ResourceManager::getInstance().registerAllocation(ret, {ret, bytes, this});
+  }
+
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ret);
+  return ret;
+}
+
+void*
+ArenaAllocator::allocateAligned(size_t bytes, size_t alignment)
+{
+  void* ret = bump(bytes, std::max(alignment, m_alignment));
+
+  if (m_track_allocations) {
+    ResourceManager::getInstance().registerAllocation(ret, {ret, bytes, this});
+  }
+
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ", alignment=" << alignment << ") returning " << ret);
+  return ret;
+}
+
+void
+ArenaAllocator::deallocate(void* ptr)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  if (m_track_allocations) {
+    ResourceManager::getInstance().deregisterAllocation(ptr);
+  }
+}
+
+void
+ArenaAllocator::deallocateRecord(void* ptr, const util::AllocationRecord& UMPIRE_UNUSED_ARG(record))
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+}
+
+void*
+ArenaAllocator::allocateUntracked(size_t bytes)
+{
+  return bump(bytes, m_alignment);
+}
+
+void
+ArenaAllocator::deallocateUntracked(void* UMPIRE_UNUSED_ARG(ptr))
+{
+}
+
+ArenaAllocator::Mark
+ArenaAllocator::mark()
+{
+  return Mark{m_current_block, m_offset,
+    m_current_size.load(std::memory_order_relaxed)};
+}
+
+void
+ArenaAllocator::rewind(const Mark& position)
+{
+  UMPIRE_LOG(Debug, "(block=" << position.block << ", offset=" << position.offset << ")");
+
+  if (position.block > m_current_block ||
+      (position.block == m_current_block && position.offset > m_offset)) {
+    UMPIRE_ERROR("Cannot rewind " << m_name << " past its current position");
+  }
+
+  if (m_track_allocations) {
+    deregisterFrom(position.block, position.offset);
+  }
+
+  m_current_block = position.block;
+  m_offset = position.offset;
+  m_current_size.store(position.size, std::memory_order_relaxed);
+}
+
+void
+ArenaAllocator::reset()
+{
+  rewind(Mark{0, 0, 0});
+}
+
+void
+ArenaAllocator::release()
+{
+  UMPIRE_LOG(Debug, "()");
+
+  // The current block is kept unless nothing has been allocated from it.
+  const size_t keep = (m_offset == 0) ? m_current_block : m_current_block + 1;
+
+  for (size_t i = keep; i < m_blocks.size(); ++i) {
+    m_allocator->deallocateUntracked(m_blocks[i].data, m_blocks[i].size);
+    m_actual_size.fetch_sub(m_blocks[i].size, std::memory_order_relaxed);
+  }
+  m_blocks.resize(std::min(keep, m_blocks.size()));
+
+  if (m_current_block >= m_blocks.size()) {
+    m_current_block = m_blocks.size();
+    m_offset = 0;
+  }
+}
+
+long
+ArenaAllocator::getCurrentSize()
+{
+  UMPIRE_LOG(Debug, "() returning " << m_current_size);
+  return m_current_size.load(std::memory_order_relaxed);
+}
+
+long
+ArenaAllocator::getHighWatermark()
+{
+  UMPIRE_LOG(Debug, "() returning " << m_highwatermark);
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+long
+ArenaAllocator::getActualSize()
+{
+  UMPIRE_LOG(Debug, "() returning " << m_actual_size);
+  return m_actual_size.load(std::memory_order_relaxed);
+}
+
+Platform
+ArenaAllocator::getPlatform()
+{
+  return m_allocator->getPlatform();
+}
+
+resource::MemoryResourceType
+ArenaAllocator::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+void*
+ArenaAllocator::bump(size_t bytes, size_t alignment)
+{
+  const uintptr_t mask = alignment - 1;
+
+  while (m_current_block < m_blocks.size()) {
+    const Block& block = m_blocks[m_current_block];
+    const uintptr_t start = reinterpret_cast<uintptr_t>(block.data);
+    const size_t offset = ((start + m_offset + mask) & ~mask) - start;
+
+    // Zero-byte allocations still take a byte, so every pointer lies
+    // strictly inside its block.
+    const size_t used = (bytes > 0) ? bytes : 1;
+
+    if (offset + used <= block.size) {
+      m_offset = offset + used;
+      util::increaseSize(m_current_size, m_highwatermark, bytes);
+      return block.data + offset;
+    }
+
+    ++m_current_block;
+    m_offset = 0;
+  }
+
+  // Leave room to align the start of a block the backing allocator did not.
+  const size_t size = std::max(m_block_size, bytes + mask + 1);
+  char* data = static_cast<char*>(m_allocator->allocateUntracked(size));
+
+  m_blocks.push_back(Block{data, size});
+  m_actual_size.fetch_add(size, std::memory_order_relaxed);
+
+  m_current_block = m_blocks.size() - 1;
+  m_offset = 0;
+
+  return bump(bytes, alignment);
+}
+
+void
+ArenaAllocator::deregisterFrom(size_t block, size_t offset)
+{
+  auto& rm = ResourceManager::getInstance();
+  const size_t last_block = std::min(m_current_block, m_blocks.size() - 1);
+
+  for (size_t i = block; i < m_blocks.size() && i <= last_block; ++i) {
+    char* data = m_blocks[i].data;
+    const size_t begin = (i == block) ? offset : 0;
+    rm.deregisterAllocationRange(data + begin, data + m_blocks[i].size, this);
+  }
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
@@ -0,0 +1,172 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_ArenaAllocator_HPP
+#define UMPIRE_ArenaAllocator_HPP
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+#include "umpire/Allocator.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Bump-allocate from a chain of blocks, freeing everything at once.
+ *
+ * Each allocation is carved from the current block at the next suitably
+ * aligned address. When a request does not fit, the arena moves on to the
+ * next block, taking a new one of at least block_size bytes from the
+ * backing Allocator if needed.
+ *
+ * Individual deallocations do not return memory. Instead, mark() records
+ * the current position and rewind() returns to it, making everything
+ * allocated since available again; reset() rewinds to the start. Blocks are
+ * kept for reuse until release() or destruction.
+ *
+ * If track_allocations is false, allocations are not registered with the
+ * ResourceManager, so allocate costs a few instructions, but the pointers
+ * cannot be used with ResourceManager operations. Otherwise rewind
+ * deregisters everything allocated since the mark with one range removal
+ * per block.
+ *
+ * \code
+ * auto scratch = rm.makeAllocator<umpire::strategy::ArenaAllocator>(
+ *     "scratch", rm.getAllocator("DEVICE"), 64*1024*1024, 256, false);
+ * auto arena = std::dynamic_pointer_cast<umpire::strategy::ArenaAllocator>(
+ *     scratch.getAllocationStrategy());
+ *
+ * for (int step = 0; step < num_steps; ++step) {
+ *   double* tmp = static_cast<double*>(scratch.allocate(n*sizeof(double)));
+ *   ...
+ *   arena->reset();
+ * }
+ * \endcode
+ */
+class ArenaAllocator :
+  public AllocationStrategy
+{
+  public:
+    /*!
+     * \brief Position in the arena returned by mark().
+     */
+    struct Mark {
+      size_t block;
+      size_t offset;
+      long size;
+    };
+
+    /*!
+     * \param block_size Minimum size of each block taken from allocator.
+     * \param alignment Alignment of every allocation; a power of two.
+     * \param track_allocations Register allocations with the
+     * ResourceManager.
+     */
+    ArenaAllocator(
+        const std::string& name,
+        int id,
+        Allocator allocator,
+        const std::size_t block_size = (1 * 1024 * 1024),
+        const std::size_t alignment = 16,
+        const bool track_allocations = true);
+
+    ~ArenaAllocator();
+
+    void* allocate(size_t bytes);
+
+    /*!
+     * \brief Allocate at the next address aligned to the larger of
+     * alignment and the arena's own alignment.
+     */
+    void* allocateAligned(size_t bytes, size_t alignment);
+
+    /*!
+     * \brief Deregister ptr; its memory is reused only after a rewind.
+     */
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    void* allocateUntracked(size_t bytes);
+
+    void deallocateUntracked(void* ptr);
+
+    /*!
+     * \brief Return the current position, to pass to rewind.
+     */
+    Mark mark();
+
+    /*!
+     * \brief Free everything allocated since position was marked.
+     *
+     * Throws if position is past the current position.
+     */
+    void rewind(const Mark& position);
+
+    /*!
+     * \brief Free everything allocated from this arena.
+     */
+    void reset();
+
+    /*!
+     * \brief Return blocks past the current position to the backing
+     * Allocator.
+     */
+    void release();
+
+    /*!
+     * \brief Return the bytes allocated since the last reset; deallocate
+     * does not reduce this.
+     */
+    long getCurrentSize();
+    long getHighWatermark();
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+  private:
+    struct Block {
+      char* data;
+      size_t size;
+    };
+
+    void* bump(size_t bytes, size_t alignment);
+
+    void deregisterFrom(size_t block, size_t offset);
+
+    std::vector<Block> m_blocks;
+
+    size_t m_current_block;
+    size_t m_offset;
+
+    const size_t m_block_size;
+    const size_t m_alignment;
+    const bool m_track_allocations;
+
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
+    std::atomic<long> m_actual_size;
+
+    std::shared_ptr<umpire::strategy::AllocationStrategy> m_allocator;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_ArenaAllocator_HPP
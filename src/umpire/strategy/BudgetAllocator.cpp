@@ -0,0 +1,315 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/BudgetAllocator.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace strategy {
+
+BudgetAllocator::BudgetAllocator(
+    const std::string& name,
+    int id,
+    Allocator allocator,
+    size_t hard_limit,
+    size_t soft_limit) :
+  AllocationStrategy(name, id),
+  m_allocator(allocator.getAllocationStrategy()),
+  m_fallback(),
+  m_hard_limit(hard_limit),
+  m_soft_limit(soft_limit == 0 ? hard_limit : soft_limit),
+  m_budgeted(0),
+  m_current_size(0),
+  m_highwatermark(0),
+  m_num_rejections(0),
+  m_num_trims(0),
+  m_mutex(),
+  m_fallback_ptrs(),
+  m_num_fallback_ptrs(0)
+{
+  if (m_soft_limit > m_hard_limit) {
+    UMPIRE_ERROR("BudgetAllocator " << name << " has soft limit " << m_soft_limit
+        << " above its hard limit " << m_hard_limit);
+  }
+}
+
+BudgetAllocator::BudgetAllocator(
+    const std::string& name,
+    int id,
+    Allocator allocator,
+    Allocator fallback,
+    size_t hard_limit,
+    size_t soft_limit) :
+  BudgetAllocator(name, id, allocator, hard_limit, soft_limit)
+{
+  m_fallback = fallback.getAllocationStrategy();
+
+  if (m_fallback->getPlatform() != m_allocator->getPlatform()) {
+    UMPIRE_ERROR("BudgetAllocator " << name << " needs " << m_allocator->getName()
+        << " and " << m_fallback->getName() << " to be on the same platform");
+  }
+}
+
+bool
+BudgetAllocator::charge(size_t bytes)
+{
+  size_t budgeted = m_budgeted.load(std::memory_order_relaxed);
+
+  do {
+    if (bytes > m_hard_limit - budgeted) {
+      return false;
+    }
+  } while (!m_budgeted.compare_exchange_weak(budgeted, budgeted + bytes,
+        std::memory_order_relaxed));
+
+  return true;
+}
+
+void
+BudgetAllocator::shrink(size_t target_bytes)
+{
+  const size_t actual = static_cast<size_t>(m_allocator->getActualSize());
+
+  if (actual <= target_bytes || actual <= m_budgeted.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  UMPIRE_LOG(Debug, m_allocator->getName() << " holds " << actual
+      << " bytes, trimming to " << target_bytes);
+  ++m_num_trims;
+
+  m_allocator->trim(target_bytes);
+
+  if (static_cast<size_t>(m_allocator->getActualSize()) > target_bytes) {
+    m_allocator->coalesce();
+  }
+}
+
+template <typename Allocate>
+void*
+BudgetAllocator::allocateWithin(size_t bytes, bool may_fail, Allocate allocate)
+{
+  OwnerScope scope(this, bytes);
+  void* ptr = nullptr;
+
+  if (charge(bytes)) {
+    // Make room first, so a pool returns free chunks rather than growing
+    // past the hard limit.
+    shrink(m_hard_limit - bytes);
+
+    try {
+      ptr = allocate(m_allocator.get());
+    } catch (...) {
+      m_budgeted.fetch_sub(bytes, std::memory_order_relaxed);
+      throw;
+    }
+
+    if (!ptr) {
+      m_budgeted.fetch_sub(bytes, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    shrink(m_soft_limit);
+  } else {
+    ++m_num_rejections;
+
+    if (!m_fallback) {
+      if (may_fail) {
+        return nullptr;
+      }
+      UMPIRE_ERROR("Allocating " << bytes << " bytes from " << getName()
+          << " would exceed its hard limit of " << m_hard_limit << " bytes, "
+          << m_budgeted.load(std::memory_order_relaxed) << " are in use");
+    }
+
+    UMPIRE_LOG(Debug, "Using " << m_fallback->getName() << " for " << bytes << " bytes");
+    ptr = allocate(m_fallback.get());
+
+    if (!ptr) {
+      return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_fallback_ptrs.insert(ptr);
+    m_num_fallback_ptrs.store(m_fallback_ptrs.size(), std::memory_order_release);
+  }
+
+  if (!scope.claimed()) {
+    ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+  }
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ptr;
+}
+
+void*
+BudgetAllocator::allocate(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  return allocateWithin(bytes, false,
+    [bytes] (AllocationStrategy* strategy) {
+      return strategy->allocate(bytes);
+    });
+}
+
+void*
+BudgetAllocator::allocateAligned(size_t bytes, size_t alignment)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ", alignment=" << alignment << ")");
+
+  return allocateWithin(bytes, false,
+    [bytes, alignment] (AllocationStrategy* strategy) {
+      return strategy->allocateAligned(bytes, alignment);
+    });
+}
+
+void*
+BudgetAllocator::tryAllocate(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  return allocateWithin(bytes, true,
+    [bytes] (AllocationStrategy* strategy) {
+      return strategy->tryAllocate(bytes);
+    });
+}
+
+void
+BudgetAllocator::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+BudgetAllocator::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  bool spilled = false;
+
+  if (m_num_fallback_ptrs.load(std::memory_order_acquire) > 0) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    spilled = m_fallback_ptrs.erase(ptr) > 0;
+    m_num_fallback_ptrs.store(m_fallback_ptrs.size(), std::memory_order_release);
+  }
+
+  util::decreaseSize(m_current_size, record.m_size);
+
+  if (spilled) {
+    m_fallback->deallocateRecord(ptr, record);
+  } else {
+    m_allocator->deallocateRecord(ptr, record);
+    m_budgeted.fetch_sub(record.m_size, std::memory_order_relaxed);
+
+    shrink(m_soft_limit);
+  }
+}
+
+void
+BudgetAllocator::coalesce()
+{
+  m_allocator->coalesce();
+}
+
+void
+BudgetAllocator::release()
+{
+  m_allocator->release();
+  if (m_fallback) {
+    m_fallback->release();
+  }
+}
+
+void
+BudgetAllocator::trim(size_t target_bytes)
+{
+  m_allocator->trim(target_bytes);
+}
+
+long
+BudgetAllocator::getCurrentSize()
+{
+  return m_current_size.load(std::memory_order_relaxed);
+}
+
+long
+BudgetAllocator::getHighWatermark()
+{
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+long
+BudgetAllocator::getActualSize()
+{
+  long size = m_allocator->getActualSize();
+  if (m_fallback) {
+    size += m_fallback->getActualSize();
+  }
+  return size;
+}
+
+Platform
+BudgetAllocator::getPlatform()
+{
+  return m_allocator->getPlatform();
+}
+
+resource::MemoryResourceType
+BudgetAllocator::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+bool
+BudgetAllocator::isThreadSafe()
+{
+  return m_allocator->isThreadSafe() && (!m_fallback || m_fallback->isThreadSafe());
+}
+
+size_t
+BudgetAllocator::getHardLimit()
+{
+  return m_hard_limit;
+}
+
+size_t
+BudgetAllocator::getSoftLimit()
+{
+  return m_soft_limit;
+}
+
+size_t
+BudgetAllocator::getBudgetedSize()
+{
+  return m_budgeted.load(std::memory_order_relaxed);
+}
+
+size_t
+BudgetAllocator::getNumRejections()
+{
+  return m_num_rejections.load(std::memory_order_relaxed);
+}
+
+size_t
+BudgetAllocator::getNumTrims()
+{
+  return m_num_trims.load(std::memory_order_relaxed);
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
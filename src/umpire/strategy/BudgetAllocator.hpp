@@ -0,0 +1,158 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_BudgetAllocator_HPP
+#define UMPIRE_BudgetAllocator_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+#include "umpire/Allocator.hpp"
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Cap the memory an AllocationStrategy may hand out and hold.
+ *
+ * This lets Umpire share a device with libraries that allocate for
+ * themselves, e.g. cuBLAS and cuFFT workspaces:
+ *
+ * \code
+ * auto budget = rm.makeAllocator<umpire::strategy::BudgetAllocator>(
+ *     "BUDGET", rm.getAllocator("DEVICE_POOL"), 12*GiB, 10*GiB);
+ * \endcode
+ *
+ * The bytes handed out are charged against the hard limit atomically, and
+ * a request that would exceed it is rejected: allocate throws and
+ * tryAllocate returns nullptr. If a fallback Allocator is given, the
+ * request is made from the fallback instead, and is not charged.
+ *
+ * The soft limit applies to the memory the wrapped strategy holds, its
+ * getActualSize. Whenever that is above the soft limit after an
+ * allocation or deallocation, and some of it is free, the strategy is
+ * trimmed to the soft limit. If it still holds too much, what remains free
+ * is coalesced, so later requests reuse it instead of growing. Before an
+ * allocation that could take the strategy past the hard limit, it is
+ * trimmed to make room, so a pool returns free chunks instead of growing.
+ * A pool may still grow past the hard limit by up to one chunk, so its
+ * chunk size should be small compared to the limits.
+ */
+class BudgetAllocator :
+  public AllocationStrategy
+{
+  public:
+    /*!
+     * \brief Construct a new BudgetAllocator.
+     *
+     * \param name Name of this instance of the BudgetAllocator.
+     * \param id Id of this instance of the BudgetAllocator.
+     * \param allocator Allocator to charge against the budget.
+     * \param hard_limit Number of bytes that may be allocated at once.
+     * \param soft_limit Number of bytes the allocator should hold. The
+     *        default of 0 uses the hard limit.
+     */
+    BudgetAllocator(
+        const std::string& name,
+        int id,
+        Allocator allocator,
+        size_t hard_limit,
+        size_t soft_limit = 0);
+
+    /*!
+     * \brief Construct a new BudgetAllocator that sends requests over the
+     * hard limit to fallback.
+     */
+    BudgetAllocator(
+        const std::string& name,
+        int id,
+        Allocator allocator,
+        Allocator fallback,
+        size_t hard_limit,
+        size_t soft_limit = 0);
+
+    void* allocate(size_t bytes);
+    void* allocateAligned(size_t bytes, size_t alignment);
+    void* tryAllocate(size_t bytes);
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    void coalesce();
+    void release();
+    void trim(size_t target_bytes);
+
+    long getCurrentSize();
+    long getHighWatermark();
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+    bool isThreadSafe();
+
+    size_t getHardLimit();
+    size_t getSoftLimit();
+
+    /*!
+     * \brief Return the number of bytes charged against the hard limit.
+     */
+    size_t getBudgetedSize();
+
+    /*!
+     * \brief Return the number of requests that did not fit under the hard
+     * limit, whether they were rejected or sent to the fallback.
+     */
+    size_t getNumRejections();
+
+    /*!
+     * \brief Return the number of times the allocator has been trimmed
+     * because it held more than the soft limit.
+     */
+    size_t getNumTrims();
+
+  private:
+    template <typename Allocate>
+    void* allocateWithin(size_t bytes, bool may_fail, Allocate allocate);
+
+    bool charge(size_t bytes);
+    void shrink(size_t target_bytes);
+
+    std::shared_ptr<AllocationStrategy> m_allocator;
+    std::shared_ptr<AllocationStrategy> m_fallback;
+
+    const size_t m_hard_limit;
+    const size_t m_soft_limit;
+
+    std::atomic<size_t> m_budgeted;
+
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
+
+    std::atomic<size_t> m_num_rejections;
+    std::atomic<size_t> m_num_trims;
+
+    // Allocations currently held by the fallback, and how many there are.
+    std::mutex m_mutex;
+    std::unordered_set<void*> m_fallback_ptrs;
+    std::atomic<size_t> m_num_fallback_ptrs;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_BudgetAllocator_HPP
@@ -0,0 +1,315 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/CachingAllocator.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace strategy {
+
+CachingAllocator::CachingAllocator(
+    const std::string& name,
+    int id,
+    Allocator allocator,
+    const std::size_t granularity,
+    const std::size_t max_cached_bytes) :
+  AllocationStrategy(name, id),
+  m_allocator(allocator.getAllocationStrategy()),
+  m_granularity(granularity),
+  m_max_cached_bytes(max_cached_bytes),
+  m_current_size(0),
+  m_highwatermark(0),
+  m_actual_size(0),
+  m_cached_bytes(0),
+  m_num_segments(0),
+  m_cache(),
+  m_used(),
+  m_mutex()
+{
+  if (granularity == 0) {
+    UMPIRE_ERROR("CachingAllocator " << name << " granularity must be greater than 0");
+  }
+}
+
+CachingAllocator::~CachingAllocator()
+{
+  release();
+
+  for (auto& block : m_cache) {
+    delete block.second;
+  }
+
+  for (auto& block : m_used) {
+    delete block.second;
+  }
+}
+
+void*
+CachingAllocator::allocate(size_t bytes)
+{
+  void* ptr = allocateUntracked(bytes);
+
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+
+  return ptr;
+}
+
+void
+CachingAllocator::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+CachingAllocator::deallocateRecord(void* ptr, const util::AllocationRecord&)
+{
+  deallocateUntracked(ptr);
+}
+
+void*
+CachingAllocator::allocateUntracked(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  const size_t size =
+    ((std::max<size_t>(bytes, 1) + m_granularity - 1) / m_granularity) * m_granularity;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  Block* block = takeBlock(size);
+  block->bytes = bytes;
+  m_used[block->ptr] = block;
+
+  m_current_size += bytes;
+  m_highwatermark = std::max(m_highwatermark, m_current_size);
+
+  return block->ptr;
+}
+
+void
+CachingAllocator::deallocateUntracked(void* ptr, size_t)
+{
+  deallocateUntracked(ptr);
+}
+
+void
+CachingAllocator::deallocateUntracked(void* ptr)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto used = m_used.find(static_cast<char*>(ptr));
+  if (used == m_used.end()) {
+    UMPIRE_ERROR("Cannot deallocate " << ptr << ", it is not in " << getName());
+  }
+
+  Block* block = used->second;
+  m_used.erase(used);
+  m_current_size -= block->bytes;
+
+  // Merge with free neighbours from the same segment.
+  if (block->prev && block->prev->free) {
+    Block* prev = block->prev;
+    m_cache.erase(prev->cached);
+    m_cached_bytes -= prev->size;
+
+    prev->size += block->size;
+    prev->next = block->next;
+    if (block->next) {
+      block->next->prev = prev;
+    }
+
+    delete block;
+    block = prev;
+  }
+
+  if (block->next && block->next->free) {
+    Block* next = block->next;
+    m_cache.erase(next->cached);
+    m_cached_bytes -= next->size;
+
+    block->size += next->size;
+    block->next = next->next;
+    if (next->next) {
+      next->next->prev = block;
+    }
+
+    delete next;
+  }
+
+  if (m_max_cached_bytes != 0
+      && !block->prev && !block->next
+      && m_cached_bytes + block->size > m_max_cached_bytes) {
+    releaseSegment(block);
+  } else {
+    cacheBlock(block);
+  }
+}
+
+CachingAllocator::Block*
+CachingAllocator::takeBlock(size_t size)
+{
+  auto cached = m_cache.lower_bound(size);
+
+  if (cached == m_cache.end()) {
+    void* ptr = m_allocator->tryAllocateUntracked(size);
+
+    if (!ptr) {
+      UMPIRE_LOG(Debug, "Out of memory for " << size << " bytes, emptying the cache");
+
+      for (auto it = m_cache.begin(); it != m_cache.end();) {
+        Block* block = (it++)->second;
+        if (!block->prev && !block->next) {
+          m_cache.erase(block->cached);
+          m_cached_bytes -= block->size;
+          releaseSegment(block);
+        }
+      }
+
+      ptr = m_allocator->allocateUntracked(size);
+    }
+
+    m_actual_size += size;
+    m_num_segments++;
+
+    return new Block{static_cast<char*>(ptr), size, 0, false, nullptr, nullptr, m_cache.end()};
+  }
+
+  Block* block = cached->second;
+  m_cache.erase(cached);
+  m_cached_bytes -= block->size;
+  block->free = false;
+
+  if (block->size > size) {
+    Block* rest = new Block{
+      block->ptr + size, block->size - size, 0, true, block, block->next, m_cache.end()};
+    if (block->next) {
+      block->next->prev = rest;
+    }
+    block->next = rest;
+    block->size = size;
+
+    cacheBlock(rest);
+  }
+
+  return block;
+}
+
+void
+CachingAllocator::cacheBlock(Block* block)
+{
+  block->free = true;
+  block->cached = m_cache.insert(std::make_pair(block->size, block));
+  m_cached_bytes += block->size;
+}
+
+void
+CachingAllocator::releaseSegment(Block* block)
+{
+  m_allocator->deallocateUntracked(block->ptr, block->size);
+
+  m_actual_size -= block->size;
+  m_num_segments--;
+
+  delete block;
+}
+
+void
+CachingAllocator::release()
+{
+  trim(0);
+}
+
+void
+CachingAllocator::trim(size_t target_bytes)
+{
+  UMPIRE_LOG(Debug, "(target_bytes=" << target_bytes << ")");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  // The cache is ordered by size, so walking it backwards frees the largest
+  // segments first.
+  auto it = m_cache.end();
+  while (it != m_cache.begin() && static_cast<size_t>(m_actual_size) > target_bytes) {
+    Block* block = (--it)->second;
+
+    if (!block->prev && !block->next) {
+      it = m_cache.erase(it);
+      m_cached_bytes -= block->size;
+      releaseSegment(block);
+    }
+  }
+}
+
+long
+CachingAllocator::getCurrentSize()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_current_size;
+}
+
+long
+CachingAllocator::getHighWatermark()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_highwatermark;
+}
+
+long
+CachingAllocator::getActualSize()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_actual_size;
+}
+
+size_t
+CachingAllocator::getCachedBytes()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_cached_bytes;
+}
+
+size_t
+CachingAllocator::getNumSegments()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_num_segments;
+}
+
+Platform
+CachingAllocator::getPlatform()
+{
+  return m_allocator->getPlatform();
+}
+
+resource::MemoryResourceType
+CachingAllocator::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+bool
+CachingAllocator::isThreadSafe()
+{
+  return true;
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
@@ -0,0 +1,168 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CachingAllocator_HPP
+#define UMPIRE_CachingAllocator_HPP
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "umpire/Allocator.hpp"
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Cache of large blocks, so that repeated large allocations do not
+ * go back to the Allocator each time.
+ *
+ * Requests are rounded up to a multiple of granularity bytes. Freed blocks
+ * stay in a cache ordered by size, and a request is served by the smallest
+ * cached block that fits, splitting off the rest as a separate cached
+ * block. Only a request that nothing in the cache fits takes a new segment
+ * of exactly the rounded size from the Allocator. Neighbouring free blocks
+ * from the same segment are merged again, and a segment is handed back to
+ * the Allocator whole:
+ *
+ * \code
+ * auto workspace = rm.makeAllocator<umpire::strategy::CachingAllocator>(
+ *     "DEVICE_CACHE", rm.getAllocator("DEVICE"));
+ * \endcode
+ *
+ * This suits workspaces of hundreds of megabytes, where a DynamicPool would
+ * grow by chunks that are too small. When the Allocator runs out of
+ * memory, the free segments are released and the allocation is tried once
+ * more. release empties the cache at any other time, and if
+ * max_cached_bytes is set, segments that become free are released while
+ * more than that many bytes are cached.
+ *
+ * Pools can also grow from a CachingAllocator, which then acts as a chunk
+ * cache shared between them. Chunks that one pool frees with release or
+ * trim stay in the cache, and another pool that grows takes them from
+ * there instead of from the resource:
+ *
+ * \code
+ * auto chunks = rm.makeAllocator<umpire::strategy::CachingAllocator>(
+ *     "DEVICE_CHUNKS", rm.getAllocator("DEVICE"));
+ *
+ * auto hydro = rm.makeAllocator<umpire::strategy::DynamicPool>("HYDRO_POOL", chunks);
+ * auto transport = rm.makeAllocator<umpire::strategy::DynamicPool>("TRANSPORT_POOL", chunks);
+ * \endcode
+ */
+class CachingAllocator :
+  public AllocationStrategy
+{
+  public:
+    /*!
+     * \brief Construct a new CachingAllocator.
+     *
+     * \param name Name of this instance of the CachingAllocator.
+     * \param id Id of this instance of the CachingAllocator.
+     * \param allocator Allocator to take segments from.
+     * \param granularity Size in bytes that requests are rounded up to a
+     *        multiple of.
+     * \param max_cached_bytes Number of free bytes to keep cached before
+     *        free segments are released, or 0 for no limit.
+     */
+    CachingAllocator(
+        const std::string& name,
+        int id,
+        Allocator allocator,
+        const std::size_t granularity = (2 * 1024 * 1024),
+        const std::size_t max_cached_bytes = 0);
+
+    ~CachingAllocator();
+
+    void* allocate(size_t bytes);
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    void* allocateUntracked(size_t bytes);
+    void deallocateUntracked(void* ptr);
+    void deallocateUntracked(void* ptr, size_t bytes);
+
+    /*!
+     * \brief Free every cached segment that holds no allocations.
+     */
+    void release();
+
+    /*!
+     * \brief Free cached segments, largest first, until getActualSize is no
+     * more than target_bytes or no free segments are left.
+     */
+    void trim(size_t target_bytes);
+
+    long getCurrentSize();
+    long getHighWatermark();
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+    bool isThreadSafe();
+
+    /*!
+     * \brief Return the number of free bytes held in the cache.
+     */
+    size_t getCachedBytes();
+
+    /*!
+     * \brief Return the number of segments taken from the Allocator.
+     */
+    size_t getNumSegments();
+
+    CachingAllocator(const CachingAllocator&) = delete;
+    CachingAllocator& operator=(const CachingAllocator&) = delete;
+
+  private:
+    struct Block {
+      char* ptr;
+      size_t size;
+      size_t bytes;
+      bool free;
+
+      // Neighbours in the same segment.
+      Block* prev;
+      Block* next;
+
+      std::multimap<size_t, Block*>::iterator cached;
+    };
+
+    Block* takeBlock(size_t size);
+    void cacheBlock(Block* block);
+    void releaseSegment(Block* block);
+
+    std::shared_ptr<AllocationStrategy> m_allocator;
+    const size_t m_granularity;
+    const size_t m_max_cached_bytes;
+
+    long m_current_size;
+    long m_highwatermark;
+    long m_actual_size;
+    size_t m_cached_bytes;
+    size_t m_num_segments;
+
+    std::multimap<size_t, Block*> m_cache;
+    std::map<char*, Block*> m_used;
+
+    std::mutex m_mutex;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_CachingAllocator_HPP
@@ -0,0 +1,294 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/CommBufferPool.hpp"
+
+#include <algorithm>
+#include <map>
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*
+ * The AllocationStrategy the pool grows from: takes slabs from the
+ * Allocator, keeps track of them, and runs the callbacks.
+ */
+class CommBufferPool::SlabSource :
+  public AllocationStrategy
+{
+  public:
+    SlabSource(
+        const std::string& name,
+        std::shared_ptr<AllocationStrategy> allocator,
+        SlabCallback on_new_slab,
+        SlabCallback on_release_slab) :
+      AllocationStrategy(name, -1),
+      m_allocator(allocator),
+      m_on_new_slab(on_new_slab),
+      m_on_release_slab(on_release_slab),
+      m_slabs(),
+      m_size(0),
+      m_mutex()
+    {
+    }
+
+    void* allocate(size_t bytes) { return allocateUntracked(bytes); }
+
+    void deallocate(void* UMPIRE_UNUSED_ARG(ptr)) {
+      UMPIRE_ERROR(m_name << " slabs must be freed with their size");
+    }
+
+    void* allocateUntracked(size_t bytes) {
+      void* ptr = m_allocator->allocateUntracked(bytes);
+      UMPIRE_LOG(Debug, "New slab " << ptr << " of " << bytes << " bytes");
+
+      if (m_on_new_slab) {
+        try {
+          m_on_new_slab(ptr, bytes);
+        } catch (...) {
+          m_allocator->deallocateUntracked(ptr, bytes);
+          throw;
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_slabs[static_cast<char*>(ptr)] = bytes;
+      m_size += bytes;
+
+      return ptr;
+    }
+
+    void deallocateUntracked(void* ptr) { deallocate(ptr); }
+
+    void deallocateUntracked(void* ptr, size_t bytes) {
+      UMPIRE_LOG(Debug, "Releasing slab " << ptr << " of " << bytes << " bytes");
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_slabs.erase(static_cast<char*>(ptr));
+        m_size -= bytes;
+      }
+
+      if (m_on_release_slab) {
+        m_on_release_slab(ptr, bytes);
+      }
+
+      m_allocator->deallocateUntracked(ptr, bytes);
+    }
+
+    long getCurrentSize() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return static_cast<long>(m_size);
+    }
+
+    long getHighWatermark() { return getCurrentSize(); }
+
+    Platform getPlatform() { return m_allocator->getPlatform(); }
+
+    resource::MemoryResourceType getResourceType() {
+      return m_allocator->getResourceType();
+    }
+
+    std::vector<std::pair<void*, std::size_t> > getSlabs() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      std::vector<std::pair<void*, std::size_t> > slabs;
+      for (auto& slab : m_slabs) {
+        slabs.push_back(std::make_pair(static_cast<void*>(slab.first), slab.second));
+      }
+
+      return slabs;
+    }
+
+    bool findSlab(void* ptr, void** slab, std::size_t* bytes) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      char* address = static_cast<char*>(ptr);
+      auto next = m_slabs.upper_bound(address);
+      if (next == m_slabs.begin()) {
+        return false;
+      }
+
+      auto found = std::prev(next);
+      if (address >= found->first + found->second) {
+        return false;
+      }
+
+      *slab = found->first;
+      *bytes = found->second;
+      return true;
+    }
+
+    std::size_t getNumSlabs() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_slabs.size();
+    }
+
+  private:
+    std::shared_ptr<AllocationStrategy> m_allocator;
+
+    SlabCallback m_on_new_slab;
+    SlabCallback m_on_release_slab;
+
+    std::map<char*, std::size_t> m_slabs;
+    std::size_t m_size;
+
+    std::mutex m_mutex;
+};
+
+CommBufferPool::CommBufferPool(
+    const std::string& name,
+    int id,
+    Allocator allocator,
+    const std::size_t slab_size,
+    SlabCallback on_new_slab,
+    SlabCallback on_release_slab,
+    const std::size_t alignment) :
+  AllocationStrategy(name, id),
+  m_allocator(allocator.getAllocationStrategy()),
+  m_source(std::make_shared<SlabSource>(
+        name + "::slabs", m_allocator, on_new_slab, on_release_slab)),
+  m_pool(nullptr),
+  m_alignment(alignment),
+  m_current_size(0),
+  m_highwatermark(0),
+  m_mutex()
+{
+  if (alignment < DynamicSizePool<>::alignment || (alignment & (alignment - 1))) {
+    UMPIRE_ERROR("CommBufferPool alignment " << alignment << " must be a power of two of at least "
+        << static_cast<std::size_t>(DynamicSizePool<>::alignment));
+  }
+
+  m_pool = new DynamicSizePool<>(m_source, slab_size, slab_size);
+}
+
+CommBufferPool::~CommBufferPool()
+{
+  delete m_pool;
+}
+
+void*
+CommBufferPool::allocate(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  void* ptr;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ptr = m_pool->allocate(bytes, m_alignment);
+
+    m_current_size += bytes;
+    m_highwatermark = std::max(m_highwatermark, m_current_size);
+  }
+
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+
+  return ptr;
+}
+
+void
+CommBufferPool::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+CommBufferPool::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_pool->deallocate(ptr);
+  m_current_size -= record.m_size;
+}
+
+void
+CommBufferPool::release()
+{
+  UMPIRE_LOG(Debug, "()");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_pool->releaseFreeChunks();
+}
+
+void
+CommBufferPool::reserve(size_t bytes, bool UMPIRE_UNUSED_ARG(prefault))
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_pool->reserve(bytes);
+}
+
+long
+CommBufferPool::getCurrentSize()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_current_size;
+}
+
+long
+CommBufferPool::getHighWatermark()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_highwatermark;
+}
+
+long
+CommBufferPool::getActualSize()
+{
+  return m_source->getCurrentSize();
+}
+
+Platform
+CommBufferPool::getPlatform()
+{
+  return m_allocator->getPlatform();
+}
+
+resource::MemoryResourceType
+CommBufferPool::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+bool
+CommBufferPool::isThreadSafe()
+{
+  return true;
+}
+
+std::vector<std::pair<void*, std::size_t> >
+CommBufferPool::getSlabs()
+{
+  return m_source->getSlabs();
+}
+
+bool
+CommBufferPool::findSlab(void* ptr, void** slab, std::size_t* bytes)
+{
+  return m_source->findSlab(ptr, slab, bytes);
+}
+
+std::size_t
+CommBufferPool::getNumSlabs()
+{
+  return m_source->getNumSlabs();
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
@@ -0,0 +1,150 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CommBufferPool_HPP
+#define UMPIRE_CommBufferPool_HPP
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "umpire/Allocator.hpp"
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+#include "umpire/tpl/simpool/DynamicSizePool.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Pool of communication buffers carved from a few large slabs that
+ * are registered with the network transport once.
+ *
+ * GPU-aware MPI libraries register each buffer with the NIC the first
+ * time they see its address, and cache the registration. Buffers from
+ * cudaMalloc come and go at new addresses, so halo exchanges keep missing
+ * that cache. A CommBufferPool takes slab_size slabs from a DEVICE or
+ * PINNED Allocator and hands out buffers inside them, so every buffer
+ * lies in memory the transport has already registered. on_new_slab is
+ * called once for each slab when it is taken, and on_release_slab just
+ * before a slab is given back:
+ *
+ * \code
+ * auto comm = rm.makeAllocator<umpire::strategy::CommBufferPool>(
+ *     "COMM_BUFFERS", rm.getAllocator("DEVICE"), 256 * 1024 * 1024,
+ *     [&] (void* ptr, std::size_t bytes) { ucp_mem_map(...); },
+ *     [&] (void* ptr, std::size_t bytes) { ucp_mem_unmap(...); });
+ * \endcode
+ *
+ * Slabs are kept until release is called or the pool is destroyed, so
+ * release the pool before shutting the transport down. findSlab gives the
+ * slab holding a buffer, for transports that address memory as a
+ * registered base plus an offset. Calls are serialized with a mutex.
+ */
+class CommBufferPool :
+  public AllocationStrategy
+{
+  public:
+    /*!
+     * \brief Called with the address and size of a slab.
+     */
+    typedef std::function<void(void*, std::size_t)> SlabCallback;
+
+    /*!
+     * \brief Construct a new CommBufferPool.
+     *
+     * \param name Name of this instance of the CommBufferPool.
+     * \param id Id of this instance of the CommBufferPool.
+     * \param allocator Allocator to take slabs from.
+     * \param slab_size Size in bytes of each slab. Larger requests get a
+     *        slab of their own.
+     * \param on_new_slab Called after a slab is taken from allocator.
+     * \param on_release_slab Called before a slab is returned to allocator.
+     * \param alignment Alignment in bytes of every buffer.
+     */
+    CommBufferPool(
+        const std::string& name,
+        int id,
+        Allocator allocator,
+        const std::size_t slab_size = (64 * 1024 * 1024),
+        SlabCallback on_new_slab = nullptr,
+        SlabCallback on_release_slab = nullptr,
+        const std::size_t alignment = 256);
+
+    ~CommBufferPool();
+
+    void* allocate(size_t bytes);
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    /*!
+     * \brief Return slabs that hold no buffers to the Allocator.
+     */
+    void release();
+
+    /*!
+     * \brief Take slabs now so that at least bytes are free, registering
+     * them before the first exchange.
+     */
+    void reserve(size_t bytes, bool prefault);
+
+    long getCurrentSize();
+    long getHighWatermark();
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+    bool isThreadSafe();
+
+    /*!
+     * \brief Return the address and size of every slab.
+     */
+    std::vector<std::pair<void*, std::size_t> > getSlabs();
+
+    /*!
+     * \brief Find the slab holding ptr.
+     *
+     * \return false if ptr is not in any slab of this pool.
+     */
+    bool findSlab(void* ptr, void** slab, std::size_t* bytes);
+
+    std::size_t getNumSlabs();
+
+    CommBufferPool(const CommBufferPool&) = delete;
+    CommBufferPool& operator=(const CommBufferPool&) = delete;
+
+  private:
+    class SlabSource;
+
+    std::shared_ptr<AllocationStrategy> m_allocator;
+    std::shared_ptr<SlabSource> m_source;
+    DynamicSizePool<>* m_pool;
+
+    const std::size_t m_alignment;
+
+    long m_current_size;
+    long m_highwatermark;
+
+    std::mutex m_mutex;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_CommBufferPool_HPP
@@ -0,0 +1,504 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/CompactingPool.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/op/MemoryOperationRegistry.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace strategy {
+
+namespace {
+
+size_t roundUp(size_t bytes)
+{
+  const size_t size = std::max<size_t>(bytes, 1);
+  return ((size + CompactingPool::s_alignment - 1) / CompactingPool::s_alignment)
+    * CompactingPool::s_alignment;
+}
+
+/*
+ * Largest number of pieces an overlapping move is split into before it is
+ * staged through a scratch buffer instead.
+ */
+const size_t s_max_move_pieces = 16;
+
+} // end of anonymous namespace
+
+CompactingPool::CompactingPool(
+    const std::string& name,
+    int id,
+    Allocator allocator,
+    const std::size_t chunk_size) :
+  AllocationStrategy(name, id),
+  m_allocator(allocator.getAllocationStrategy()),
+  m_chunk_size(roundUp(chunk_size)),
+  m_current_size(0),
+  m_highwatermark(0),
+  m_actual_size(0),
+  m_chunks(),
+  m_blocks(),
+  m_free(),
+  m_free_by_size(),
+  m_mutex()
+{
+}
+
+CompactingPool::~CompactingPool()
+{
+  auto& rm = ResourceManager::getInstance();
+
+  for (auto& block : m_blocks) {
+    delete block.second;
+  }
+
+  for (auto& chunk : m_chunks) {
+    rm.deregisterAllocationRange(chunk.first, chunk.first + chunk.second.size, this);
+    m_allocator->deallocateUntracked(chunk.first, chunk.second.size);
+  }
+}
+
+void*
+CompactingPool::allocate(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return allocateBlock(bytes, false)->ptr;
+}
+
+void
+CompactingPool::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+CompactingPool::deallocateRecord(void* ptr, const util::AllocationRecord& UMPIRE_UNUSED_ARG(record))
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto block = m_blocks.find(static_cast<char*>(ptr));
+  if (block == m_blocks.end()) {
+    UMPIRE_ERROR("Cannot deallocate " << ptr << ", it is not in " << getName());
+  }
+
+  deallocateBlock(block->second);
+}
+
+CompactingPool::Handle
+CompactingPool::allocateHandle(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return allocateBlock(bytes, true);
+}
+
+void
+CompactingPool::deallocateHandle(Handle handle)
+{
+  deallocate(handle->ptr);
+}
+
+void*
+CompactingPool::pin(Handle handle)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++handle->pins;
+  return handle->ptr;
+}
+
+void
+CompactingPool::unpin(Handle handle)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (handle->pins == 0) {
+    UMPIRE_ERROR("Cannot unpin " << static_cast<void*>(handle->ptr) << ", it is not pinned");
+  }
+
+  --handle->pins;
+}
+
+size_t
+CompactingPool::getSize(Handle handle)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return handle->size;
+}
+
+size_t
+CompactingPool::compact()
+{
+  UMPIRE_LOG(Debug, "()");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto& rm = ResourceManager::getInstance();
+
+  struct Hole {
+    char* ptr;
+    size_t size;
+  };
+
+  /*
+   * Lay the blocks out again chunk by chunk, starting with the chunks that
+   * hold blocks which cannot move, and then the fullest, so the chunks that
+   * empty are the ones that are cheapest to empty. Within a chunk, each
+   * movable block goes to the first hole left in a chunk already laid out
+   * that fits, or else slides down to the end of the block before it. Holes
+   * only ever lie below the block being placed, so a move can only overlap
+   * its own source when sliding.
+   */
+  struct Pass {
+    std::map<char*, Chunk>::iterator chunk;
+    bool fixed;
+  };
+
+  std::vector<Pass> passes;
+  for (auto chunk = m_chunks.begin(); chunk != m_chunks.end(); ++chunk) {
+    passes.push_back({chunk, false});
+  }
+
+  for (auto& block : m_blocks) {
+    if (!block.second->movable || block.second->pins > 0) {
+      auto chunk = findChunk(block.first);
+      for (auto& pass : passes) {
+        if (pass.chunk == chunk) {
+          pass.fixed = true;
+          break;
+        }
+      }
+    }
+  }
+
+  std::stable_sort(passes.begin(), passes.end(), [] (const Pass& a, const Pass& b) {
+    return (a.fixed != b.fixed) ? a.fixed : a.chunk->second.used > b.chunk->second.used;
+  });
+
+  std::vector<Hole> holes;
+  size_t moved = 0;
+
+  for (auto& pass : passes) {
+    Chunk& chunk = pass.chunk->second;
+    char* const end = pass.chunk->first + chunk.size;
+    char* cursor = pass.chunk->first;
+    chunk.used = 0;
+
+    for (auto block = m_blocks.lower_bound(pass.chunk->first);
+         block != m_blocks.end() && block->first < end; ++block) {
+      Block* current = block->second;
+      const size_t size = roundUp(current->size);
+      char* dst = nullptr;
+
+      if (current->movable && current->pins == 0) {
+        for (auto& hole : holes) {
+          if (hole.size >= size) {
+            dst = hole.ptr;
+            hole.ptr += size;
+            hole.size -= size;
+            findChunk(dst)->second.used += size;
+            break;
+          }
+        }
+
+        if (!dst) {
+          dst = cursor;
+        }
+      } else {
+        dst = current->ptr;
+      }
+
+      if (dst != current->ptr) {
+        move(dst, current->ptr, current->size);
+        moved += current->size;
+
+        auto record = rm.deregisterAllocation(current->ptr);
+        record.m_ptr = dst;
+        rm.registerAllocation(dst, record);
+
+        current->ptr = dst;
+      }
+
+      if (dst >= cursor && dst < end) {
+        if (dst > cursor) {
+          holes.push_back({cursor, static_cast<size_t>(dst - cursor)});
+        }
+        cursor = dst + size;
+        chunk.used += size;
+      }
+    }
+
+    if (cursor < end) {
+      holes.push_back({cursor, static_cast<size_t>(end - cursor)});
+    }
+  }
+
+  // Blocks moved into holes left the map out of address order.
+  std::map<char*, Block*> blocks;
+  for (auto& entry : m_blocks) {
+    blocks.insert({entry.second->ptr, entry.second});
+  }
+  m_blocks.swap(blocks);
+
+  m_free.clear();
+  m_free_by_size.clear();
+  for (auto& hole : holes) {
+    if (hole.size > 0) {
+      addFree(hole.ptr, hole.size);
+    }
+  }
+
+  releaseEmptyChunks();
+
+  UMPIRE_LOG(Debug, "Moved " << moved << " bytes, " << m_chunks.size() << " chunks remain");
+
+  return moved;
+}
+
+void
+CompactingPool::release()
+{
+  UMPIRE_LOG(Debug, "()");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  releaseEmptyChunks();
+}
+
+long
+CompactingPool::getCurrentSize()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_current_size;
+}
+
+long
+CompactingPool::getHighWatermark()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_highwatermark;
+}
+
+long
+CompactingPool::getActualSize()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_actual_size;
+}
+
+Platform
+CompactingPool::getPlatform()
+{
+  return m_allocator->getPlatform();
+}
+
+resource::MemoryResourceType
+CompactingPool::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+bool
+CompactingPool::isThreadSafe()
+{
+  return true;
+}
+
+size_t
+CompactingPool::getNumChunks()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_chunks.size();
+}
+
+CompactingPool::Block*
+CompactingPool::allocateBlock(size_t bytes, bool movable)
+{
+  const size_t size = roundUp(bytes);
+  char* ptr = takeFree(size);
+
+  if (!ptr) {
+    const size_t chunk_size = std::max(size, m_chunk_size);
+    ptr = static_cast<char*>(m_allocator->allocateUntracked(chunk_size));
+    m_chunks.insert({ptr, Chunk{chunk_size, 0}});
+    m_actual_size += chunk_size;
+
+    if (chunk_size > size) {
+      addFree(ptr + size, chunk_size - size);
+    }
+  }
+
+  findChunk(ptr)->second.used += size;
+
+  Block* block = new Block{ptr, bytes, 0, movable};
+  m_blocks.insert({ptr, block});
+
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+
+  m_current_size += bytes;
+  m_highwatermark = std::max(m_highwatermark, m_current_size);
+
+  return block;
+}
+
+void
+CompactingPool::deallocateBlock(Block* block)
+{
+  const size_t size = roundUp(block->size);
+
+  findChunk(block->ptr)->second.used -= size;
+  m_current_size -= block->size;
+
+  m_blocks.erase(block->ptr);
+  addFree(block->ptr, size);
+
+  delete block;
+}
+
+char*
+CompactingPool::takeFree(size_t size)
+{
+  auto best = m_free_by_size.lower_bound(size);
+  if (best == m_free_by_size.end()) {
+    return nullptr;
+  }
+
+  char* ptr = best->second;
+  const size_t free_size = best->first;
+
+  removeFree(m_free.find(ptr));
+
+  if (free_size > size) {
+    addFree(ptr + size, free_size - size);
+  }
+
+  return ptr;
+}
+
+void
+CompactingPool::addFree(char* ptr, size_t size)
+{
+  auto chunk = findChunk(ptr);
+
+  // Merge with the free ranges on either side within the same chunk.
+  auto next = m_free.find(ptr + size);
+  if (next != m_free.end() && findChunk(next->first) == chunk) {
+    size += next->second;
+    removeFree(next);
+  }
+
+  auto prev = m_free.lower_bound(ptr);
+  if (prev != m_free.begin()) {
+    --prev;
+    if (prev->first + prev->second == ptr && findChunk(prev->first) == chunk) {
+      ptr = prev->first;
+      size += prev->second;
+      removeFree(prev);
+    }
+  }
+
+  m_free.insert({ptr, size});
+  m_free_by_size.insert({size, ptr});
+}
+
+void
+CompactingPool::removeFree(std::map<char*, size_t>::iterator range)
+{
+  auto sized = m_free_by_size.equal_range(range->second);
+  for (auto entry = sized.first; entry != sized.second; ++entry) {
+    if (entry->second == range->first) {
+      m_free_by_size.erase(entry);
+      break;
+    }
+  }
+
+  m_free.erase(range);
+}
+
+std::map<char*, CompactingPool::Chunk>::iterator
+CompactingPool::findChunk(char* ptr)
+{
+  auto chunk = m_chunks.upper_bound(ptr);
+  return --chunk;
+}
+
+void
+CompactingPool::move(char* dst, char* src, size_t bytes)
+{
+  auto op = op::MemoryOperationRegistry::getInstance().find(
+      op::MemoryOperationType::copy, m_allocator.get(), m_allocator.get());
+
+  util::AllocationRecord src_record{src, bytes, m_allocator.get()};
+  util::AllocationRecord dst_record{dst, bytes, m_allocator.get()};
+
+  const size_t distance = static_cast<size_t>(src - dst);
+
+  if (distance >= bytes) {
+    void* dst_ptr = dst;
+    op->transform(src, &dst_ptr, &src_record, &dst_record, bytes);
+    return;
+  }
+
+  /*
+   * The ranges overlap. Copying forward in pieces no longer than the
+   * distance never reads bytes already overwritten, but many small pieces
+   * are slow, so a long move goes through a scratch buffer if one can be
+   * had.
+   */
+  if (bytes / distance > s_max_move_pieces) {
+    void* scratch = m_allocator->tryAllocateUntracked(bytes);
+
+    if (scratch) {
+      util::AllocationRecord scratch_record{scratch, bytes, m_allocator.get()};
+      void* dst_ptr = dst;
+
+      op->transform(src, &scratch, &src_record, &scratch_record, bytes);
+      op->transform(scratch, &dst_ptr, &scratch_record, &dst_record, bytes);
+
+      m_allocator->deallocateUntracked(scratch, bytes);
+      return;
+    }
+  }
+
+  for (size_t offset = 0; offset < bytes; offset += distance) {
+    const size_t length = std::min(distance, bytes - offset);
+    void* dst_ptr = dst + offset;
+    op->transform(src + offset, &dst_ptr, &src_record, &dst_record, length);
+  }
+}
+
+void
+CompactingPool::releaseEmptyChunks()
+{
+  for (auto chunk = m_chunks.begin(); chunk != m_chunks.end(); ) {
+    if (chunk->second.used == 0) {
+      removeFree(m_free.find(chunk->first));
+      m_allocator->deallocateUntracked(chunk->first, chunk->second.size);
+      m_actual_size -= chunk->second.size;
+      chunk = m_chunks.erase(chunk);
+    } else {
+      ++chunk;
+    }
+  }
+}
+
+} // end of namespace strategy
+} // end namespace umpire
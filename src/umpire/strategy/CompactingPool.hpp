@@ -0,0 +1,187 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CompactingPool_HPP
+#define UMPIRE_CompactingPool_HPP
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "umpire/Allocator.hpp"
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Pool whose handle-based allocations can be moved to undo
+ * fragmentation.
+ *
+ * An allocation made with allocateHandle is reached through pin, which
+ * returns its current address and keeps it there until the matching unpin.
+ * compact slides every unpinned handle allocation towards the start of the
+ * oldest chunks, copying with the pool's memory operations, and frees the
+ * chunks left empty:
+ *
+ * \code
+ * auto pool = rm.makeAllocator<umpire::strategy::CompactingPool>(
+ *     "COMPACTING", rm.getAllocator("DEVICE"));
+ *
+ * auto strategy = std::dynamic_pointer_cast<umpire::strategy::CompactingPool>(
+ *     pool.getAllocationStrategy());
+ *
+ * auto handle = strategy->allocateHandle(bytes);
+ * double* data = static_cast<double*>(strategy->pin(handle));
+ * ...
+ * strategy->unpin(handle);
+ * ...
+ * strategy->compact();
+ * \endcode
+ *
+ * Memory from allocate is never moved. Pointers obtained from pin are only
+ * valid until unpin, and compact must only run when no copy or kernel is
+ * still using an unpinned allocation. Blocks start on multiples of
+ * s_alignment bytes, and are placed by best fit between compactions.
+ */
+class CompactingPool :
+  public AllocationStrategy
+{
+  public:
+    struct Block;
+
+    /*!
+     * \brief Opaque reference to a handle-based allocation.
+     */
+    typedef Block* Handle;
+
+    static const std::size_t s_alignment = 16;
+
+    /*!
+     * \brief Construct a new CompactingPool.
+     *
+     * \param name Name of this instance of the CompactingPool.
+     * \param id Id of this instance of the CompactingPool.
+     * \param allocator Allocator to take chunks from.
+     * \param chunk_size Size in bytes of each chunk. Larger requests get a
+     *        chunk of their own.
+     */
+    CompactingPool(
+        const std::string& name,
+        int id,
+        Allocator allocator,
+        const std::size_t chunk_size = (64 * 1024 * 1024));
+
+    ~CompactingPool();
+
+    void* allocate(size_t bytes);
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    /*!
+     * \brief Allocate bytes that compact may move while they are not
+     * pinned.
+     */
+    Handle allocateHandle(size_t bytes);
+
+    void deallocateHandle(Handle handle);
+
+    /*!
+     * \brief Return the current address of the allocation, and keep it
+     * there until a matching unpin. Pins nest.
+     */
+    void* pin(Handle handle);
+
+    void unpin(Handle handle);
+
+    size_t getSize(Handle handle);
+
+    /*!
+     * \brief Move unpinned handle allocations to close the gaps between
+     * allocations, then free the chunks left empty.
+     *
+     * \return Number of bytes copied.
+     */
+    size_t compact();
+
+    /*!
+     * \brief Free the chunks that hold no allocations.
+     */
+    void release();
+
+    long getCurrentSize();
+    long getHighWatermark();
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+    bool isThreadSafe();
+
+    /*!
+     * \brief Return the number of chunks taken from the Allocator.
+     */
+    size_t getNumChunks();
+
+    CompactingPool(const CompactingPool&) = delete;
+    CompactingPool& operator=(const CompactingPool&) = delete;
+
+    struct Block {
+      char* ptr;
+      size_t size;
+      size_t pins;
+      bool movable;
+    };
+
+  private:
+    struct Chunk {
+      size_t size;
+      size_t used;
+    };
+
+    Block* allocateBlock(size_t bytes, bool movable);
+    void deallocateBlock(Block* block);
+
+    char* takeFree(size_t size);
+    void addFree(char* ptr, size_t size);
+    void removeFree(std::map<char*, size_t>::iterator range);
+
+    std::map<char*, Chunk>::iterator findChunk(char* ptr);
+
+    void move(char* dst, char* src, size_t bytes);
+
+    void releaseEmptyChunks();
+
+    std::shared_ptr<AllocationStrategy> m_allocator;
+    const size_t m_chunk_size;
+
+    long m_current_size;
+    long m_highwatermark;
+    long m_actual_size;
+
+    // Chunks, live blocks and free ranges, all keyed by address.
+    std::map<char*, Chunk> m_chunks;
+    std::map<char*, Block*> m_blocks;
+    std::map<char*, size_t> m_free;
+    std::multimap<size_t, char*> m_free_by_size;
+
+    std::mutex m_mutex;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_CompactingPool_HPP
@@ -0,0 +1,171 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_ComposedStrategy_HPP
+#define UMPIRE_ComposedStrategy_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+#include "umpire/Allocator.hpp"
+
+#include "umpire/tpl/simpool/DynamicSizePool.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Policies that ComposedStrategy stacks into a single strategy.
+ *
+ * Each policy names a layer template taking the layer below it. Layers are
+ * plain classes with non-virtual methods, so a whole stack is inlined into
+ * ComposedStrategy's allocate and deallocate.
+ */
+namespace compose {
+
+/*!
+ * \brief Settings passed to every layer when a ComposedStrategy is built.
+ */
+struct Context
+{
+  std::string name;
+  std::shared_ptr<AllocationStrategy> allocator;
+  std::size_t min_initial_alloc_size;
+  std::size_t min_alloc_size;
+};
+
+namespace detail {
+
+class ResourceLayer;
+
+template <typename Next>
+class LockedLayer;
+
+template <typename Pool, typename Next>
+class PooledLayer;
+
+template <typename Next>
+class TrackedLayer;
+
+template <typename... Policies>
+struct Chain;
+
+} // end of namespace detail
+
+/*!
+ * \brief Serialize the layers below with a mutex.
+ */
+struct Locked
+{
+  template <typename Next>
+  using apply = detail::LockedLayer<Next>;
+};
+
+/*!
+ * \brief Serve allocations from a Pool, such as DynamicSizePool, whose
+ * chunks come from the layers below.
+ *
+ * The first chunk is min_initial_alloc_size bytes and later ones at least
+ * min_alloc_size bytes. Only growing or releasing the pool makes a virtual
+ * call, through a small AllocationStrategy that forwards to the next layer.
+ */
+template <typename Pool = DynamicSizePool<>>
+struct Pooled
+{
+  template <typename Next>
+  using apply = detail::PooledLayer<Pool, Next>;
+};
+
+/*!
+ * \brief Count the bytes passing through this layer, for getCurrentSize
+ * and getHighWatermark.
+ *
+ * Above a Pooled layer this counts the bytes handed out; below it, the bytes
+ * the pool holds. The outermost Tracked layer answers for the strategy, and
+ * a stack without one reports a size of 0.
+ */
+struct Tracked
+{
+  template <typename Next>
+  using apply = detail::TrackedLayer<Next>;
+};
+
+} // end of namespace compose
+
+/*!
+ * \brief Strategy built from a list of layer policies at compile time.
+ *
+ * Stacking ThreadSafeAllocator over DynamicPool over a resource costs a
+ * virtual call, a shared_ptr and an OwnerScope per strategy on every
+ * allocation. A ComposedStrategy fuses the same behaviour into one class:
+ * Policies are listed outermost first, the last one allocating from the
+ * given Allocator, and each allocation is registered once with this
+ * strategy as its owner.
+ *
+ * \code
+ *
+ * using namespace umpire::strategy;
+ *
+ * auto allocator = rm.makeAllocator<ComposedStrategy<
+ *     compose::Locked, compose::Tracked, compose::Pooled<>>>(
+ *   "fused_pool", rm.getAllocator("HOST"));
+ *
+ * \endcode
+ */
+template <typename... Policies>
+class ComposedStrategy :
+  public AllocationStrategy
+{
+  public:
+    ComposedStrategy(
+        const std::string& name,
+        int id,
+        Allocator allocator,
+        const std::size_t min_initial_alloc_size = (512 * 1024 * 1024),
+        const std::size_t min_alloc_size = (1 * 1024 * 1024));
+
+    void* allocate(size_t bytes);
+    void* tryAllocate(size_t bytes);
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    void release();
+
+    long getCurrentSize();
+    long getHighWatermark();
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+    bool isThreadSafe();
+
+  private:
+    std::shared_ptr<AllocationStrategy> m_allocator;
+
+    typename compose::detail::Chain<Policies...>::type m_chain;
+};
+
+} // end of namespace strategy
+} // end of namespace umpire
+
+#include "umpire/strategy/ComposedStrategy.inl"
+
+#endif // UMPIRE_ComposedStrategy_HPP
@@ -0,0 +1,386 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_ComposedStrategy_INL
+#define UMPIRE_ComposedStrategy_INL
+
+#include "umpire/strategy/ComposedStrategy.hpp"
+
+#include "umpire/ResourceManager.hpp"
+
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace strategy {
+namespace compose {
+namespace detail {
+
+/*
+ * Bottom of every stack: the Allocator the ComposedStrategy was given.
+ */
+class ResourceLayer
+{
+  public:
+    explicit ResourceLayer(const Context& context) :
+      m_allocator(context.allocator)
+    {
+    }
+
+    void* allocate(size_t bytes) {
+      return m_allocator->allocateUntracked(bytes);
+    }
+
+    void* tryAllocate(size_t bytes) {
+      return m_allocator->tryAllocateUntracked(bytes);
+    }
+
+    void deallocate(void* ptr, size_t bytes) {
+      m_allocator->deallocateUntracked(ptr, bytes);
+    }
+
+    void release() {
+    }
+
+    long getCurrentSize() { return 0; }
+    long getHighWatermark() { return 0; }
+    long getActualSize() { return 0; }
+
+    bool isThreadSafe() {
+      return m_allocator->isThreadSafe();
+    }
+
+  private:
+    std::shared_ptr<AllocationStrategy> m_allocator;
+};
+
+/*
+ * Passes every call to the next layer; layers hide the methods they change.
+ */
+template <typename Next>
+class ForwardingLayer
+{
+  public:
+    explicit ForwardingLayer(const Context& context) :
+      m_next(context)
+    {
+    }
+
+    void* allocate(size_t bytes) { return m_next.allocate(bytes); }
+    void* tryAllocate(size_t bytes) { return m_next.tryAllocate(bytes); }
+    void deallocate(void* ptr, size_t bytes) { m_next.deallocate(ptr, bytes); }
+    void release() { m_next.release(); }
+
+    long getCurrentSize() { return m_next.getCurrentSize(); }
+    long getHighWatermark() { return m_next.getHighWatermark(); }
+    long getActualSize() { return m_next.getActualSize(); }
+
+    bool isThreadSafe() { return m_next.isThreadSafe(); }
+
+  protected:
+    Next m_next;
+};
+
+template <typename Next>
+class LockedLayer :
+  public ForwardingLayer<Next>
+{
+  public:
+    explicit LockedLayer(const Context& context) :
+      ForwardingLayer<Next>(context)
+    {
+    }
+
+    void* allocate(size_t bytes) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return this->m_next.allocate(bytes);
+    }
+
+    void* tryAllocate(size_t bytes) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return this->m_next.tryAllocate(bytes);
+    }
+
+    void deallocate(void* ptr, size_t bytes) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      this->m_next.deallocate(ptr, bytes);
+    }
+
+    void release() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      this->m_next.release();
+    }
+
+    long getActualSize() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return this->m_next.getActualSize();
+    }
+
+    bool isThreadSafe() { return true; }
+
+  private:
+    std::mutex m_mutex;
+};
+
+/*
+ * The AllocationStrategy a Pool grows from, handing chunks to the next
+ * layer.
+ */
+template <typename Next>
+class UpstreamStrategy :
+  public AllocationStrategy
+{
+  public:
+    UpstreamStrategy(const Context& context, Next& next) :
+      AllocationStrategy(context.name, -1),
+      m_next(next),
+      m_allocator(context.allocator)
+    {
+    }
+
+    void* allocate(size_t bytes) { return m_next.allocate(bytes); }
+
+    void deallocate(void* UMPIRE_UNUSED_ARG(ptr)) {
+      UMPIRE_ERROR(m_name << " chunks must be freed with their size");
+    }
+
+    void* allocateUntracked(size_t bytes) { return m_next.allocate(bytes); }
+    void* tryAllocateUntracked(size_t bytes) { return m_next.tryAllocate(bytes); }
+
+    void deallocateUntracked(void* ptr) { deallocate(ptr); }
+    void deallocateUntracked(void* ptr, size_t bytes) { m_next.deallocate(ptr, bytes); }
+
+    long getCurrentSize() { return m_next.getCurrentSize(); }
+    long getHighWatermark() { return m_next.getHighWatermark(); }
+
+    Platform getPlatform() { return m_allocator->getPlatform(); }
+
+    resource::MemoryResourceType getResourceType() {
+      return m_allocator->getResourceType();
+    }
+
+  private:
+    Next& m_next;
+    std::shared_ptr<AllocationStrategy> m_allocator;
+};
+
+template <typename Pool, typename Next>
+class PooledLayer :
+  public ForwardingLayer<Next>
+{
+  public:
+    explicit PooledLayer(const Context& context) :
+      ForwardingLayer<Next>(context),
+      m_upstream(std::make_shared<UpstreamStrategy<Next>>(context, this->m_next)),
+      m_pool(m_upstream, context.min_initial_alloc_size, context.min_alloc_size)
+    {
+    }
+
+    void* allocate(size_t bytes) {
+      return m_pool.allocate(bytes);
+    }
+
+    void* tryAllocate(size_t bytes) {
+      return m_pool.tryAllocate(bytes, Pool::alignment);
+    }
+
+    void deallocate(void* ptr, size_t UMPIRE_UNUSED_ARG(bytes)) {
+      m_pool.deallocate(ptr);
+    }
+
+    void release() {
+      m_pool.releaseFreeChunks();
+      this->m_next.release();
+    }
+
+    long getActualSize() {
+      return static_cast<long>(m_pool.totalSize());
+    }
+
+    bool isThreadSafe() { return false; }
+
+  private:
+    // Declared in this order so the pool returns its chunks first
+    std::shared_ptr<UpstreamStrategy<Next>> m_upstream;
+    Pool m_pool;
+};
+
+template <typename Next>
+class TrackedLayer :
+  public ForwardingLayer<Next>
+{
+  public:
+    explicit TrackedLayer(const Context& context) :
+      ForwardingLayer<Next>(context),
+      m_current_size(0),
+      m_highwatermark(0)
+    {
+    }
+
+    void* allocate(size_t bytes) {
+      void* ptr = this->m_next.allocate(bytes);
+      util::increaseSize(m_current_size, m_highwatermark, bytes);
+      return ptr;
+    }
+
+    void* tryAllocate(size_t bytes) {
+      void* ptr = this->m_next.tryAllocate(bytes);
+      if (ptr) {
+        util::increaseSize(m_current_size, m_highwatermark, bytes);
+      }
+      return ptr;
+    }
+
+    void deallocate(void* ptr, size_t bytes) {
+      this->m_next.deallocate(ptr, bytes);
+      util::decreaseSize(m_current_size, bytes);
+    }
+
+    long getCurrentSize() {
+      return m_current_size.load(std::memory_order_relaxed);
+    }
+
+    long getHighWatermark() {
+      return m_highwatermark.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
+};
+
+template <>
+struct Chain<>
+{
+  using type = ResourceLayer;
+};
+
+template <typename Policy, typename... Policies>
+struct Chain<Policy, Policies...>
+{
+  using type = typename Policy::template apply<typename Chain<Policies...>::type>;
+};
+
+} // end of namespace detail
+} // end of namespace compose
+
+template <typename... Policies>
+ComposedStrategy<Policies...>::ComposedStrategy(
+    const std::string& name,
+    int id,
+    Allocator allocator,
+    const std::size_t min_initial_alloc_size,
+    const std::size_t min_alloc_size) :
+  AllocationStrategy(name, id),
+  m_allocator(allocator.getAllocationStrategy()),
+  m_chain(compose::Context{name, m_allocator, min_initial_alloc_size, min_alloc_size})
+{
+}
+
+template <typename... Policies>
+void*
+ComposedStrategy<Policies...>::allocate(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+  void* ptr = m_chain.allocate(bytes);
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+
+  return ptr;
+}
+
+template <typename... Policies>
+void*
+ComposedStrategy<Policies...>::tryAllocate(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+  void* ptr = m_chain.tryAllocate(bytes);
+
+  if (ptr) {
+    ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+  }
+
+  return ptr;
+}
+
+template <typename... Policies>
+void
+ComposedStrategy<Policies...>::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+template <typename... Policies>
+void
+ComposedStrategy<Policies...>::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+  m_chain.deallocate(ptr, record.m_size);
+}
+
+template <typename... Policies>
+void
+ComposedStrategy<Policies...>::release()
+{
+  UMPIRE_LOG(Debug, "()");
+  m_chain.release();
+}
+
+template <typename... Policies>
+long
+ComposedStrategy<Policies...>::getCurrentSize()
+{
+  return m_chain.getCurrentSize();
+}
+
+template <typename... Policies>
+long
+ComposedStrategy<Policies...>::getHighWatermark()
+{
+  return m_chain.getHighWatermark();
+}
+
+template <typename... Policies>
+long
+ComposedStrategy<Policies...>::getActualSize()
+{
+  // Without a pool, the memory held is the memory handed out
+  const long actual = m_chain.getActualSize();
+  return actual ? actual : getCurrentSize();
+}
+
+template <typename... Policies>
+Platform
+ComposedStrategy<Policies...>::getPlatform()
+{
+  return m_allocator->getPlatform();
+}
+
+template <typename... Policies>
+resource::MemoryResourceType
+ComposedStrategy<Policies...>::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+template <typename... Policies>
+bool
+ComposedStrategy<Policies...>::isThreadSafe()
+{
+  return m_chain.isThreadSafe();
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
+
+#endif // UMPIRE_ComposedStrategy_INL
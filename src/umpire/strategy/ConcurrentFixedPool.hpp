@@ -0,0 +1,193 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_ConcurrentFixedPool_HPP
+#define UMPIRE_ConcurrentFixedPool_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+#include "umpire/Allocator.hpp"
+
+#include "umpire/tpl/simpool/StdAllocator.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief A FixedPool that many threads can use at once without a lock.
+ *
+ * Like FixedPool, each pool holds NP*64 blocks of sizeof(T) bytes and a
+ * bitmap with a set bit for every free block. Blocks are claimed with an
+ * atomic fetch-and on a bitmap word and returned with a fetch-or. A per-pool
+ * count of free blocks is decremented before a bit is searched for, so a
+ * thread that gets past it is guaranteed to find one, and threads start
+ * their search at different words to keep from contending.
+ *
+ * Pools are appended to a fixed-capacity directory of segments of 64 pools,
+ * each with a bitmap of the pools that may have free blocks, and published
+ * by an atomic count. Nothing is copied when a pool is added, and when the
+ * last used pool is full the search skips the full ones a word at a time.
+ * The pool owning a freed block is found through its registered chunk.
+ * Only adding a pool takes a mutex. Pools are kept until the strategy is
+ * destroyed.
+ */
+template <typename T, int NP=64, typename IA=StdAllocator>
+class ConcurrentFixedPool
+  : public AllocationStrategy
+{
+  public:
+    ConcurrentFixedPool(
+        const std::string& name,
+        int id,
+        Allocator allocator);
+
+    ~ConcurrentFixedPool();
+
+    void* allocate(size_t bytes);
+
+    /*!
+     * \brief Allocate a block, checking that it meets alignment.
+     *
+     * See FixedPool::allocateAligned.
+     */
+    void* allocateAligned(size_t bytes, size_t alignment);
+
+    void deallocate(void* ptr);
+
+    void* allocateUntracked(size_t bytes);
+
+    void deallocateUntracked(void* ptr);
+
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    /*!
+     * \brief Return the record of the block containing ptr.
+     *
+     * As in FixedPool, pools are registered as chunks and blocks are never
+     * entered into the ResourceManager's AllocationMap.
+     */
+    util::AllocationRecord* findRecord(void* ptr, void* handle);
+
+    long getCurrentSize();
+    long getHighWatermark();
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+    bool isThreadSafe();
+
+    /*!
+     * \brief Return the number of pools obtained from the underlying
+     * Allocator.
+     */
+    size_t getNumChunks();
+
+    /*!
+     * \brief Return the number of blocks handed out by the pool.
+     */
+    size_t getNumUsedBlocks();
+
+  private:
+    struct Pool
+    {
+      unsigned char *base;
+      unsigned char *data;
+      std::atomic<uint64_t> *avail;
+      util::AllocationRecord *records;
+      std::atomic<long> numAvail;
+      size_t index;
+    };
+
+    static const size_t s_pools_per_segment = 64;
+    static const size_t s_max_segments = 1024;
+
+    struct Segment
+    {
+      /*!
+       * \brief Bit i is set if pools[i] may have free blocks.
+       */
+      std::atomic<uint64_t> withAvail;
+      struct Pool* pools[s_pools_per_segment];
+    };
+
+    struct Pool* newPool();
+
+    T* allocInPool(struct Pool *p);
+
+    /*!
+     * \brief Allocate from the first pool marked as having free blocks,
+     * clearing the marks of full pools on the way.
+     */
+    T* allocInAnyPool(struct Pool*& p);
+
+    /*!
+     * \brief Mark p as having free blocks, after its count was raised.
+     */
+    void markAvail(const struct Pool* p);
+
+    T* allocateBlock(bool track);
+
+    void deallocateBlock(T* ptr);
+
+    static size_t blockAlignment();
+
+    static size_t availOffset();
+
+    static size_t recordsOffset();
+
+    /*!
+     * \brief Bytes taken from the allocator for each pool's blocks,
+     * including room to align them.
+     */
+    size_t dataBytes() const;
+
+    /*!
+     * \brief Pool i is m_segments[i / 64]->pools[i % 64], for i below
+     * m_num_pools.
+     */
+    std::atomic<Segment*> m_segments[s_max_segments];
+    std::atomic<size_t> m_num_pools;
+
+    /*!
+     * \brief The pool the last block was found in, tried first.
+     */
+    std::atomic<struct Pool*> m_current_pool;
+
+    std::mutex m_mutex;
+
+    const size_t m_num_per_pool;
+    const size_t m_total_pool_size;
+    const size_t m_block_alignment;
+
+    std::atomic<size_t> m_num_blocks;
+
+    std::atomic<long> m_highwatermark;
+    std::atomic<long> m_current_size;
+
+    std::shared_ptr<umpire::strategy::AllocationStrategy> m_allocator;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#include "umpire/strategy/ConcurrentFixedPool.inl"
+
+#endif // UMPIRE_ConcurrentFixedPool_HPP
@@ -0,0 +1,444 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_ConcurrentFixedPool_INL
+#define UMPIRE_ConcurrentFixedPool_INL
+
+#include "umpire/strategy/ConcurrentFixedPool.hpp"
+
+#include "umpire/ResourceManager.hpp"
+
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <thread>
+
+namespace umpire {
+namespace strategy {
+
+template <typename T, int NP, typename IA>
+ConcurrentFixedPool<T, NP, IA>::ConcurrentFixedPool(
+    const std::string& name,
+    int id,
+    Allocator allocator) :
+  AllocationStrategy(name, id),
+  m_num_pools(0),
+  m_current_pool(nullptr),
+  m_mutex(),
+  m_num_per_pool(NP * 64),
+  m_total_pool_size(recordsOffset() + m_num_per_pool * (sizeof(T) + sizeof(util::AllocationRecord))),
+  m_block_alignment(blockAlignment()),
+  m_num_blocks(0),
+  m_highwatermark(0),
+  m_current_size(0),
+  m_allocator(allocator.getAllocationStrategy())
+{
+  for (auto& segment : m_segments) {
+    segment.store(nullptr, std::memory_order_relaxed);
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_current_pool.store(newPool(), std::memory_order_release);
+}
+
+template <typename T, int NP, typename IA>
+ConcurrentFixedPool<T, NP, IA>::~ConcurrentFixedPool()
+{
+  const size_t num_pools = m_num_pools.load(std::memory_order_acquire);
+
+  for (size_t i = 0; i < num_pools; i++) {
+    struct Pool *p = m_segments[i / s_pools_per_segment].load(std::memory_order_relaxed)
+      ->pools[i % s_pools_per_segment];
+
+    ResourceManager::getInstance().deregisterChunk(p->data, this);
+    m_allocator->deallocateUntracked(p->base, dataBytes());
+
+    p->~Pool();
+    IA::deallocate(p);
+
+    util::decreaseSize(m_current_size, sizeof(T)*m_num_per_pool);
+  }
+
+  for (auto& entry : m_segments) {
+    Segment* segment = entry.load(std::memory_order_relaxed);
+    if (segment) {
+      segment->~Segment();
+      IA::deallocate(segment);
+    }
+  }
+}
+
+template <typename T, int NP, typename IA>
+typename ConcurrentFixedPool<T, NP, IA>::Pool*
+ConcurrentFixedPool<T, NP, IA>::newPool()
+{
+  // Called with m_mutex held.
+  const size_t index = m_num_pools.load(std::memory_order_relaxed);
+  if (index == s_max_segments * s_pools_per_segment) {
+    UMPIRE_ERROR(getName() << " cannot hold more than "
+        << s_max_segments * s_pools_per_segment << " pools");
+  }
+
+  Segment* segment = m_segments[index / s_pools_per_segment].load(std::memory_order_relaxed);
+  if (!segment) {
+    segment = new (IA::allocate(sizeof(Segment))) Segment;
+    segment->withAvail.store(0, std::memory_order_relaxed);
+    m_segments[index / s_pools_per_segment].store(segment, std::memory_order_release);
+  }
+
+  void* header = IA::allocate(
+      recordsOffset() + m_num_per_pool * sizeof(util::AllocationRecord));
+
+  struct Pool *p = new (header) Pool;
+
+  // Pool data is untracked, so over-allocate to align it ourselves.
+  p->base = static_cast<unsigned char*>(m_allocator->allocateUntracked(dataBytes()));
+  p->data = p->base;
+  if (m_block_alignment > alignof(std::max_align_t)) {
+    const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(p->base);
+    p->data += (m_block_alignment - addr % m_block_alignment) % m_block_alignment;
+  }
+
+  p->avail = reinterpret_cast<std::atomic<uint64_t>*>(
+      static_cast<unsigned char*>(header) + availOffset());
+  for (int i = 0; i < NP; i++) new (&p->avail[i]) std::atomic<uint64_t>(~uint64_t{0});
+
+  p->records = reinterpret_cast<util::AllocationRecord*>(
+      static_cast<unsigned char*>(header) + recordsOffset());
+  for (size_t i = 0; i < m_num_per_pool; i++) {
+    p->records[i] = util::AllocationRecord{nullptr, sizeof(T), this};
+  }
+
+  p->numAvail.store(static_cast<long>(m_num_per_pool), std::memory_order_relaxed);
+  p->index = index;
+
+  ResourceManager::getInstance().registerChunk(p->data, m_num_per_pool * sizeof(T), this, p);
+
+  segment->pools[index % s_pools_per_segment] = p;
+  segment->withAvail.fetch_or(uint64_t{1} << (index % s_pools_per_segment));
+  m_num_pools.store(index + 1, std::memory_order_release);
+
+  util::increaseSize(m_current_size, m_highwatermark, m_num_per_pool*sizeof(T));
+
+  return p;
+}
+
+template <typename T, int NP, typename IA>
+T*
+ConcurrentFixedPool<T, NP, IA>::allocInPool(struct Pool *p)
+{
+  // Reserve a block first; once reserved, a set bit is sure to be found.
+  if (p->numAvail.load(std::memory_order_relaxed) <= 0) return nullptr;
+  if (p->numAvail.fetch_sub(1, std::memory_order_acquire) <= 0) {
+    // A block freed while this one was reserved may have seen p marked and
+    // left it to this thread to mark it again.
+    if (p->numAvail.fetch_add(1) >= 0) {
+      markAvail(p);
+    }
+    return nullptr;
+  }
+
+  static thread_local const size_t start =
+    std::hash<std::thread::id>()(std::this_thread::get_id());
+
+  for (size_t n = 0; ; n++) {
+    const size_t i = (start + n) % NP;
+    uint64_t word = p->avail[i].load(std::memory_order_relaxed);
+
+    while (word) {
+      const uint64_t bit = word & (~word + 1);
+      word = p->avail[i].fetch_and(~bit, std::memory_order_acquire);
+
+      if (word & bit) {
+        const size_t entry = i * 64 + __builtin_ctzll(bit);
+        return reinterpret_cast<T*>(p->data) + entry;
+      }
+
+      word &= ~bit;
+    }
+  }
+}
+
+template <typename T, int NP, typename IA>
+T*
+ConcurrentFixedPool<T, NP, IA>::allocateBlock(bool track)
+{
+  struct Pool *p = m_current_pool.load(std::memory_order_acquire);
+  T* ptr = allocInPool(p);
+
+  while (!ptr) {
+    if ((ptr = allocInAnyPool(p))) {
+      m_current_pool.store(p, std::memory_order_release);
+    } else {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      // Another thread may have added a pool while this one searched.
+      if (m_current_pool.load(std::memory_order_relaxed)->numAvail.load(std::memory_order_relaxed) <= 0) {
+        m_current_pool.store(newPool(), std::memory_order_release);
+      }
+    }
+  }
+
+  if (track) {
+    p->records[ptr - reinterpret_cast<T*>(p->data)].m_ptr = ptr;
+  }
+
+  m_num_blocks.fetch_add(1, std::memory_order_relaxed);
+
+  return ptr;
+}
+
+template <typename T, int NP, typename IA>
+void
+ConcurrentFixedPool<T, NP, IA>::deallocateBlock(T* t_ptr)
+{
+  struct Pool *p = static_cast<struct Pool*>(
+      ResourceManager::getInstance().findChunk(t_ptr, this));
+  if (!p) {
+    UMPIRE_ERROR("Could not find pointer to deallocate");
+  }
+
+  const T* start = reinterpret_cast<T*>(p->data);
+
+  const size_t index = t_ptr - start;
+  const uint64_t bit = uint64_t{1} << (index % 64);
+
+  p->records[index].m_ptr = nullptr;
+
+  const uint64_t word = p->avail[index / 64].fetch_or(bit, std::memory_order_release);
+  if (word & bit) {
+    UMPIRE_ERROR("Trying to deallocate an entry that was not marked as allocated");
+  }
+
+  p->numAvail.fetch_add(1);
+  markAvail(p);
+
+  m_num_blocks.fetch_sub(1, std::memory_order_relaxed);
+}
+
+template <typename T, int NP, typename IA>
+T*
+ConcurrentFixedPool<T, NP, IA>::allocInAnyPool(struct Pool*& p)
+{
+  const size_t num_pools = m_num_pools.load(std::memory_order_acquire);
+
+  for (size_t s = 0; s * s_pools_per_segment < num_pools; s++) {
+    Segment* segment = m_segments[s].load(std::memory_order_acquire);
+    uint64_t word = segment->withAvail.load();
+
+    while (word) {
+      const size_t i = __builtin_ctzll(word);
+      const uint64_t bit = uint64_t{1} << i;
+      word &= ~bit;
+
+      struct Pool *candidate = segment->pools[i];
+      T* ptr = allocInPool(candidate);
+      if (ptr) {
+        p = candidate;
+        return ptr;
+      }
+
+      // Unmark the full pool, then check for a block freed in between: the
+      // freeing thread either sees the bit cleared or this one sees its count.
+      segment->withAvail.fetch_and(~bit);
+      if (candidate->numAvail.load() > 0) {
+        segment->withAvail.fetch_or(bit);
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+template <typename T, int NP, typename IA>
+void
+ConcurrentFixedPool<T, NP, IA>::markAvail(const struct Pool* p)
+{
+  Segment* segment = m_segments[p->index / s_pools_per_segment].load(std::memory_order_relaxed);
+  const uint64_t bit = uint64_t{1} << (p->index % s_pools_per_segment);
+
+  // Most frees find the bit already set and leave the word's line shared.
+  if (!(segment->withAvail.load() & bit)) {
+    segment->withAvail.fetch_or(bit);
+  }
+}
+
+template <typename T, int NP, typename IA>
+void*
+ConcurrentFixedPool<T, NP, IA>::allocate(size_t bytes)
+{
+  if (bytes > sizeof(T)) {
+    UMPIRE_ERROR(getName() << " cannot allocate " << bytes << " bytes in blocks of " << sizeof(T));
+  }
+
+  return allocateBlock(true);
+}
+
+template <typename T, int NP, typename IA>
+void*
+ConcurrentFixedPool<T, NP, IA>::allocateAligned(size_t bytes, size_t alignment)
+{
+  if (alignment > m_block_alignment) {
+    UMPIRE_ERROR(getName() << " blocks are only aligned to " << m_block_alignment
+        << " bytes, cannot align to " << alignment);
+  }
+
+  return allocate(bytes);
+}
+
+template <typename T, int NP, typename IA>
+void
+ConcurrentFixedPool<T, NP, IA>::deallocate(void* ptr)
+{
+  deallocateBlock(static_cast<T*>(ptr));
+}
+
+template <typename T, int NP, typename IA>
+void*
+ConcurrentFixedPool<T, NP, IA>::allocateUntracked(size_t bytes)
+{
+  if (bytes > sizeof(T)) {
+    UMPIRE_ERROR(getName() << " cannot allocate " << bytes << " bytes in blocks of " << sizeof(T));
+  }
+
+  return allocateBlock(false);
+}
+
+template <typename T, int NP, typename IA>
+void
+ConcurrentFixedPool<T, NP, IA>::deallocateUntracked(void* ptr)
+{
+  deallocateBlock(static_cast<T*>(ptr));
+}
+
+template <typename T, int NP, typename IA>
+void
+ConcurrentFixedPool<T, NP, IA>::deallocateRecord(void* ptr, const util::AllocationRecord& UMPIRE_UNUSED_ARG(record))
+{
+  // Blocks are found through their pool, not the AllocationMap
+  deallocate(ptr);
+}
+
+template <typename T, int NP, typename IA>
+util::AllocationRecord*
+ConcurrentFixedPool<T, NP, IA>::findRecord(void* ptr, void* handle)
+{
+  const struct Pool *p = static_cast<const struct Pool *>(handle);
+  const size_t index = (static_cast<unsigned char*>(ptr) - p->data) / sizeof(T);
+
+  util::AllocationRecord* record = &p->records[index];
+
+  // Untracked and free blocks have no record
+  return record->m_ptr ? record : nullptr;
+}
+
+template <typename T, int NP, typename IA>
+long
+ConcurrentFixedPool<T, NP, IA>::getCurrentSize()
+{
+  return m_current_size.load(std::memory_order_relaxed);
+}
+
+template <typename T, int NP, typename IA>
+long
+ConcurrentFixedPool<T, NP, IA>::getHighWatermark()
+{
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+template <typename T, int NP, typename IA>
+long
+ConcurrentFixedPool<T, NP, IA>::getActualSize()
+{
+  return getNumChunks() * m_total_pool_size;
+}
+
+template <typename T, int NP, typename IA>
+Platform
+ConcurrentFixedPool<T, NP, IA>::getPlatform()
+{
+  return m_allocator->getPlatform();
+}
+
+template <typename T, int NP, typename IA>
+resource::MemoryResourceType
+ConcurrentFixedPool<T, NP, IA>::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+template <typename T, int NP, typename IA>
+bool
+ConcurrentFixedPool<T, NP, IA>::isThreadSafe()
+{
+  return m_allocator->isThreadSafe();
+}
+
+template <typename T, int NP, typename IA>
+size_t
+ConcurrentFixedPool<T, NP, IA>::getNumChunks()
+{
+  return m_num_pools.load(std::memory_order_acquire);
+}
+
+template <typename T, int NP, typename IA>
+size_t
+ConcurrentFixedPool<T, NP, IA>::getNumUsedBlocks()
+{
+  return m_num_blocks.load(std::memory_order_relaxed);
+}
+
+template <typename T, int NP, typename IA>
+size_t
+ConcurrentFixedPool<T, NP, IA>::blockAlignment()
+{
+  // Blocks sit at multiples of sizeof(T) from the start of a pool, so they
+  // share the largest power of two that divides it.
+  const size_t alignment = sizeof(T) & (~sizeof(T) + 1);
+  return (alignment > 4096) ? 4096 : alignment;
+}
+
+template <typename T, int NP, typename IA>
+size_t
+ConcurrentFixedPool<T, NP, IA>::availOffset()
+{
+  // The bitmap follows the Pool header, on a cache line of its own
+  return (sizeof(struct Pool) + 63) / 64 * 64;
+}
+
+template <typename T, int NP, typename IA>
+size_t
+ConcurrentFixedPool<T, NP, IA>::dataBytes() const
+{
+  const size_t bytes = m_num_per_pool * sizeof(T);
+  return m_block_alignment > alignof(std::max_align_t) ? bytes + m_block_alignment : bytes;
+}
+
+template <typename T, int NP, typename IA>
+size_t
+ConcurrentFixedPool<T, NP, IA>::recordsOffset()
+{
+  const size_t offset = availOffset() + NP * sizeof(std::atomic<uint64_t>);
+  const size_t alignment = alignof(util::AllocationRecord);
+
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
+
+#endif // UMPIRE_ConcurrentFixedPool_INL
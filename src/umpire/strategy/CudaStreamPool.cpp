@@ -0,0 +1,339 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/CudaStreamPool.hpp"
+
+#include "umpire/ResourceManager.hpp"
+
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace strategy {
+
+namespace {
+
+bool isCapturing(cudaStream_t stream)
+{
+  cudaStreamCaptureStatus status = cudaStreamCaptureStatusNone;
+  cudaError_t error = ::cudaStreamIsCapturing(stream, &status);
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaStreamIsCapturing( stream = " << stream
+        << " ) failed with error: " << cudaGetErrorString(error));
+  }
+
+  return status == cudaStreamCaptureStatusActive;
+}
+
+} // end of anonymous namespace
+
+CudaStreamPool::CudaStreamPool(
+    const std::string& name,
+    int id,
+    Allocator allocator) :
+  AllocationStrategy(name, id),
+  m_free_blocks(),
+  m_used_blocks(),
+  m_graph_blocks(),
+  m_events(),
+  m_current_size(0),
+  m_highwatermark(0),
+  m_actual_size(0),
+  m_allocator(allocator.getAllocationStrategy()),
+  m_mutex(new std::mutex())
+{
+}
+
+CudaStreamPool::~CudaStreamPool()
+{
+  release();
+
+  for (auto event : m_events) {
+    ::cudaEventDestroy(event);
+  }
+
+  delete m_mutex;
+}
+
+void*
+CudaStreamPool::allocate(size_t bytes)
+{
+  return allocate(bytes, 0);
+}
+
+void
+CudaStreamPool::deallocate(void* ptr)
+{
+  deallocate(ptr, 0);
+}
+
+void*
+CudaStreamPool::allocate(size_t bytes, cudaStream_t stream)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ", stream=" << stream << ")");
+
+  size_t size = ((bytes + s_granularity - 1) / s_granularity) * s_granularity;
+  if (size == 0)
+    size = s_granularity;
+
+  void* ptr = nullptr;
+
+  if (isCapturing(stream)) {
+    cudaError_t error = ::cudaMallocAsync(&ptr, size, stream);
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaMallocAsync( bytes = " << size << ", stream = " << stream
+          << " ) failed with error: " << cudaGetErrorString(error));
+    }
+
+    try {
+      UMPIRE_LOCK;
+      m_graph_blocks[ptr] = size;
+      UMPIRE_UNLOCK;
+    } catch (...) {
+      UMPIRE_UNLOCK;
+      throw;
+    }
+
+    ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+    util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+    return ptr;
+  }
+
+  try {
+    UMPIRE_LOCK;
+
+    ptr = takeFreeBlock(size, stream);
+
+    if (!ptr) {
+      ptr = m_allocator->allocateUntracked(size);
+      m_actual_size.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    m_used_blocks[ptr] = size;
+
+    UMPIRE_UNLOCK;
+  } catch (...) {
+    UMPIRE_UNLOCK;
+    throw;
+  }
+
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ptr;
+}
+
+void
+CudaStreamPool::deallocate(void* ptr, cudaStream_t stream)
+{
+  // Check before the record is dropped, so a refused block stays allocated
+  // and can be freed once the capture has ended.
+  if (isCapturing(stream)) {
+    bool graph_block = false;
+
+    try {
+      UMPIRE_LOCK;
+      graph_block = m_graph_blocks.find(ptr) != m_graph_blocks.end();
+      UMPIRE_UNLOCK;
+    } catch (...) {
+      UMPIRE_UNLOCK;
+      throw;
+    }
+
+    if (!graph_block) {
+      UMPIRE_ERROR("Cannot free " << ptr << " on stream " << stream
+          << " while it is being captured, it was allocated outside the capture");
+    }
+  }
+
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr), stream);
+}
+
+void
+CudaStreamPool::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  deallocateRecord(ptr, record, 0);
+}
+
+void
+CudaStreamPool::deallocateRecord(void* ptr, const util::AllocationRecord& record, cudaStream_t stream)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", stream=" << stream << ")");
+
+  util::decreaseSize(m_current_size, record.m_size);
+
+  try {
+    UMPIRE_LOCK;
+
+    auto graph = m_graph_blocks.find(ptr);
+    if (graph != m_graph_blocks.end()) {
+      m_graph_blocks.erase(graph);
+
+      cudaError_t error = ::cudaFreeAsync(ptr, stream);
+      if (error != cudaSuccess) {
+        UMPIRE_ERROR("cudaFreeAsync( ptr = " << ptr << ", stream = " << stream
+            << " ) failed with error: " << cudaGetErrorString(error));
+      }
+
+      UMPIRE_UNLOCK;
+      return;
+    }
+
+    auto used = m_used_blocks.find(ptr);
+    const size_t size = used->second;
+    m_used_blocks.erase(used);
+
+    cudaEvent_t event = getEvent();
+    cudaError_t error = ::cudaEventRecord(event, stream);
+    if (error != cudaSuccess) {
+      m_events.push_back(event);
+      UMPIRE_ERROR("cudaEventRecord( stream = " << stream
+          << " ) failed with error: " << cudaGetErrorString(error));
+    }
+
+    m_free_blocks.emplace(size, Block{ptr, size, stream, event});
+
+    UMPIRE_UNLOCK;
+  } catch (...) {
+    UMPIRE_UNLOCK;
+    throw;
+  }
+}
+
+void
+CudaStreamPool::release()
+{
+  UMPIRE_LOG(Debug, "()");
+
+  try {
+    UMPIRE_LOCK;
+
+    for (auto& entry : m_free_blocks) {
+      Block& block = entry.second;
+
+      ::cudaEventSynchronize(block.event);
+      m_events.push_back(block.event);
+
+      m_allocator->deallocateUntracked(block.ptr, block.size);
+      m_actual_size.fetch_sub(block.size, std::memory_order_relaxed);
+    }
+    m_free_blocks.clear();
+
+    UMPIRE_UNLOCK;
+  } catch (...) {
+    UMPIRE_UNLOCK;
+    throw;
+  }
+}
+
+long
+CudaStreamPool::getCurrentSize()
+{
+  UMPIRE_LOG(Debug, "() returning " << m_current_size);
+  return m_current_size.load(std::memory_order_relaxed);
+}
+
+long
+CudaStreamPool::getHighWatermark()
+{
+  UMPIRE_LOG(Debug, "() returning " << m_highwatermark);
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+long
+CudaStreamPool::getActualSize()
+{
+  UMPIRE_LOG(Debug, "() returning " << m_actual_size);
+  return m_actual_size.load(std::memory_order_relaxed);
+}
+
+Platform
+CudaStreamPool::getPlatform()
+{
+  return m_allocator->getPlatform();
+}
+
+resource::MemoryResourceType
+CudaStreamPool::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+bool
+CudaStreamPool::isThreadSafe()
+{
+  return true;
+}
+
+cudaEvent_t
+CudaStreamPool::getEvent()
+{
+  if (!m_events.empty()) {
+    cudaEvent_t event = m_events.back();
+    m_events.pop_back();
+    return event;
+  }
+
+  cudaEvent_t event;
+  cudaError_t error = ::cudaEventCreateWithFlags(&event, cudaEventDisableTiming);
+
+  if (error != cudaSuccess) {
+    UMPIRE_ERROR("cudaEventCreateWithFlags failed with error: "
+        << cudaGetErrorString(error));
+  }
+
+  return event;
+}
+
+void*
+CudaStreamPool::takeFreeBlock(size_t& size, cudaStream_t stream)
+{
+  // Only consider blocks up to twice the request to bound the waste.
+  auto end = m_free_blocks.upper_bound(2*size);
+
+  for (auto it = m_free_blocks.lower_bound(size); it != end; ++it) {
+    Block& block = it->second;
+
+    bool ready = (block.stream == stream);
+
+    if (!ready) {
+      cudaError_t error = ::cudaEventQuery(block.event);
+
+      if (error == cudaSuccess) {
+        ready = true;
+      } else if (error != cudaErrorNotReady) {
+        UMPIRE_ERROR("cudaEventQuery failed with error: "
+            << cudaGetErrorString(error));
+      }
+    }
+
+    if (ready) {
+      void* ptr = block.ptr;
+
+      size = block.size;
+      m_events.push_back(block.event);
+      m_free_blocks.erase(it);
+
+      return ptr;
+    }
+  }
+
+  return nullptr;
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
@@ -0,0 +1,143 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CudaStreamPool_HPP
+#define UMPIRE_CudaStreamPool_HPP
+
+#include <atomic>
+#include <cuda_runtime_api.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+#include "umpire/Allocator.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Pool of device blocks whose reuse is ordered by CUDA streams.
+ *
+ * A block freed with deallocate(ptr, stream) is tagged with stream and an
+ * event recorded on it. A later allocate on the same stream may reuse the
+ * block immediately, since the stream orders the new work after the old.
+ * Other streams only get the block once its event has completed, so no
+ * device-wide synchronization is needed to recycle memory safely.
+ *
+ * allocate and deallocate without a stream use the default stream.
+ *
+ * While stream is being captured into a CUDA graph, allocate(bytes, stream)
+ * does not touch the pool, since events cannot be queried and blocks would
+ * be reused before the graph runs. The block is instead allocated with
+ * cudaMallocAsync on stream, which adds a memory allocation node to the
+ * graph. Such blocks are freed with cudaFreeAsync by deallocate(ptr,
+ * stream), either inside the capture or after the graph has been launched.
+ * Blocks allocated outside the capture cannot be freed on a capturing
+ * stream: deallocate throws and leaves them allocated. Requires CUDA 11.4
+ * or newer.
+ */
+class CudaStreamPool : public AllocationStrategy
+{
+  public:
+    CudaStreamPool(
+        const std::string& name,
+        int id,
+        Allocator allocator);
+
+    ~CudaStreamPool();
+
+    void* allocate(size_t bytes);
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    /*!
+     * \brief Allocate bytes of memory for use on stream.
+     */
+    void* allocate(size_t bytes, cudaStream_t stream);
+
+    /*!
+     * \brief Free ptr once the work already queued on stream is done.
+     */
+    void deallocate(void* ptr, cudaStream_t stream);
+
+    /*!
+     * \brief Wait for all freed blocks to become idle and return them to
+     * the underlying allocator.
+     */
+    void release();
+
+    long getCurrentSize();
+    long getHighWatermark();
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+    bool isThreadSafe();
+
+  private:
+    struct Block
+    {
+      void* ptr;
+      size_t size;
+      cudaStream_t stream;
+      cudaEvent_t event;
+    };
+
+    /*!
+     * \brief Requests are rounded up to this many bytes so freed blocks can be
+     * matched by size.
+     */
+    static const size_t s_granularity = 512;
+
+    cudaEvent_t getEvent();
+
+    /*!
+     * \brief Return ptr, whose record has been removed, to the free blocks
+     * once the work queued on stream is done.
+     */
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record, cudaStream_t stream);
+
+    /*!
+     * \brief Remove and return a free block of at least size bytes that is
+     * safe to use on stream, or nullptr.
+     *
+     * On success, size is updated to the size of the block.
+     */
+    void* takeFreeBlock(size_t& size, cudaStream_t stream);
+
+    std::multimap<size_t, Block> m_free_blocks;
+    std::unordered_map<void*, size_t> m_used_blocks;
+    std::unordered_map<void*, size_t> m_graph_blocks;
+    std::vector<cudaEvent_t> m_events;
+
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
+    std::atomic<long> m_actual_size;
+
+    std::shared_ptr<umpire::strategy::AllocationStrategy> m_allocator;
+
+    std::mutex* m_mutex;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_CudaStreamPool_HPP
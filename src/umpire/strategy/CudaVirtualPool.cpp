@@ -0,0 +1,182 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/CudaVirtualPool.hpp"
+
+#include <cuda_runtime_api.h>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace strategy {
+
+namespace {
+
+void checkDriver(CUresult result, const char* call)
+{
+  if (result != CUDA_SUCCESS) {
+    const char* message = nullptr;
+    ::cuGetErrorString(result, &message);
+    UMPIRE_ERROR(call << " failed with error: " << (message ? message : "unknown"));
+  }
+}
+
+/*
+ * Makes the pool's context current for the driver calls in a scope.
+ */
+struct ContextGuard {
+  ContextGuard(CUcontext context)
+  {
+    checkDriver(::cuCtxPushCurrent(context), "cuCtxPushCurrent");
+  }
+
+  ~ContextGuard()
+  {
+    CUcontext previous;
+    ::cuCtxPopCurrent(&previous);
+  }
+};
+
+} // end of anonymous namespace
+
+CudaVirtualPool::CudaVirtualPool(
+    const std::string& name,
+    int id,
+    int device,
+    size_t reserve_bytes) :
+  VirtualPool(name, id),
+  m_device(device),
+  m_context(nullptr),
+  m_prop(),
+  m_access(),
+  m_handles()
+{
+  if (m_device < 0) {
+    ::cudaGetDevice(&m_device);
+  }
+
+  checkDriver(::cuInit(0), "cuInit");
+
+  CUdevice cu_device;
+  checkDriver(::cuDeviceGet(&cu_device, m_device), "cuDeviceGet");
+  checkDriver(::cuDevicePrimaryCtxRetain(&m_context, cu_device), "cuDevicePrimaryCtxRetain");
+
+  ContextGuard guard(m_context);
+
+  m_prop.type = CU_MEM_ALLOCATION_TYPE_PINNED;
+  m_prop.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
+  m_prop.location.id = m_device;
+
+  m_access.location = m_prop.location;
+  m_access.flags = CU_MEM_ACCESS_FLAGS_PROT_READWRITE;
+
+  size_t granularity;
+  checkDriver(::cuMemGetAllocationGranularity(&granularity, &m_prop,
+        CU_MEM_ALLOC_GRANULARITY_RECOMMENDED), "cuMemGetAllocationGranularity");
+
+  if (reserve_bytes == 0) {
+    checkDriver(::cuDeviceTotalMem(&reserve_bytes, cu_device), "cuDeviceTotalMem");
+  }
+
+  const size_t reserved = ((reserve_bytes + granularity - 1) / granularity) * granularity;
+
+  CUdeviceptr base;
+  checkDriver(::cuMemAddressReserve(&base, reserved, 0, 0, 0), "cuMemAddressReserve");
+
+  m_handles.resize(reserved / granularity);
+  initialize(reinterpret_cast<char*>(base), reserved, granularity);
+
+  UMPIRE_LOG(Debug, "(device=" << m_device << ") reserved " << reserved
+      << " bytes at " << reinterpret_cast<void*>(base)
+      << " with granularity " << granularity);
+}
+
+CudaVirtualPool::~CudaVirtualPool()
+{
+  {
+    ContextGuard guard(m_context);
+
+    decommitAll();
+    ::cuMemAddressFree(reinterpret_cast<CUdeviceptr>(m_base), m_reserved);
+  }
+
+  CUdevice cu_device;
+  if (::cuDeviceGet(&cu_device, m_device) == CUDA_SUCCESS) {
+    ::cuDevicePrimaryCtxRelease(cu_device);
+  }
+}
+
+Platform
+CudaVirtualPool::getPlatform()
+{
+  return Platform::cuda;
+}
+
+resource::MemoryResourceType
+CudaVirtualPool::getResourceType()
+{
+  return resource::Device;
+}
+
+void
+CudaVirtualPool::commit(size_t first, size_t count)
+{
+  ContextGuard guard(m_context);
+
+  // Each granule gets its own handle so that it can be unmapped alone.
+  for (size_t i = first; i < first + count; ++i) {
+    const CUdeviceptr granule = reinterpret_cast<CUdeviceptr>(granuleAddress(i));
+    CUmemGenericAllocationHandle handle;
+
+    CUresult result = ::cuMemCreate(&handle, m_granularity, &m_prop, 0);
+    if (result == CUDA_SUCCESS) {
+      result = ::cuMemMap(granule, m_granularity, 0, handle, 0);
+      if (result == CUDA_SUCCESS) {
+        result = ::cuMemSetAccess(granule, m_granularity, &m_access, 1);
+        if (result != CUDA_SUCCESS) {
+          ::cuMemUnmap(granule, m_granularity);
+        }
+      }
+      if (result != CUDA_SUCCESS) {
+        ::cuMemRelease(handle);
+      }
+    }
+
+    if (result != CUDA_SUCCESS) {
+      // Leave the range as it was so the pool's bookkeeping stays correct.
+      if (i > first) {
+        decommit(first, i - first);
+      }
+      checkDriver(result, "cuMemCreate/cuMemMap");
+    }
+
+    m_handles[i] = handle;
+  }
+}
+
+void
+CudaVirtualPool::decommit(size_t first, size_t count)
+{
+  ContextGuard guard(m_context);
+
+  for (size_t i = first; i < first + count; ++i) {
+    const CUdeviceptr granule = reinterpret_cast<CUdeviceptr>(granuleAddress(i));
+
+    checkDriver(::cuMemUnmap(granule, m_granularity), "cuMemUnmap");
+    checkDriver(::cuMemRelease(m_handles[i]), "cuMemRelease");
+  }
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
@@ -0,0 +1,83 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_CudaVirtualPool_HPP
+#define UMPIRE_CudaVirtualPool_HPP
+
+#include <cuda.h>
+
+#include <vector>
+
+#include "umpire/strategy/VirtualPool.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Device pool that grows inside one reserved range of virtual
+ * addresses.
+ *
+ * The pool reserves reserve_bytes of contiguous address space with
+ * cuMemAddressReserve. Physical memory is created with cuMemCreate and
+ * mapped one granule at a time, so release and trim can unmap any granule
+ * that no block uses. See VirtualPool for how blocks are placed.
+ *
+ * \code
+ *
+ * auto pool = rm.makeAllocator<umpire::strategy::CudaVirtualPool>(
+ *   "vmm_pool", 0);
+ *
+ * \endcode
+ */
+class CudaVirtualPool : public VirtualPool
+{
+  public:
+    /*!
+     * \brief Construct a new CudaVirtualPool.
+     *
+     * \param name Name of this instance of the CudaVirtualPool.
+     * \param id Id of this instance of the CudaVirtualPool.
+     * \param device CUDA device to allocate on, or -1 for the current one.
+     * \param reserve_bytes Size of the address range to reserve. The
+     *        default of 0 reserves the device's total memory.
+     */
+    CudaVirtualPool(
+        const std::string& name,
+        int id,
+        int device = -1,
+        size_t reserve_bytes = 0);
+
+    ~CudaVirtualPool();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+  protected:
+    void commit(size_t first, size_t count);
+    void decommit(size_t first, size_t count);
+
+  private:
+    int m_device;
+    CUcontext m_context;
+    CUmemAllocationProp m_prop;
+    CUmemAccessDesc m_access;
+
+    std::vector<CUmemGenericAllocationHandle> m_handles;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_CudaVirtualPool_HPP
@@ -56,5 +56,11 @@ DefaultAllocationStrategy::getPlatform()
   return m_allocator->getPlatform();
 }
 
+resource::MemoryResourceType
+DefaultAllocationStrategy::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
 } // end of namespace strategy
 } // end of namespace umpire
@@ -40,6 +40,8 @@ class DefaultAllocationStrategy :
 
     Platform getPlatform();
 
+    resource::MemoryResourceType getResourceType();
+
   protected:
     std::shared_ptr<AllocationStrategy> m_allocator;
 };
@@ -14,64 +14,336 @@
 //////////////////////////////////////////////////////////////////////////////
 #include "umpire/strategy/DynamicPool.hpp"
 
+#include <algorithm>
+
 #include "umpire/ResourceManager.hpp"
 
+#include "umpire/op/MemoryOperationRegistry.hpp"
+
+#include "umpire/util/AtomicStatistics.hpp"
 #include "umpire/util/Macros.hpp"
 
+#if defined(UMPIRE_ENABLE_CUDA)
+#include <cuda_runtime_api.h>
+#endif
+
+#include <unistd.h>
+
 namespace umpire {
 namespace strategy {
 
+namespace {
+
+/*
+ * Bytes free on the device for cuda, or of physical memory for cpu.
+ */
+std::size_t getFreeMemory(Platform platform)
+{
+#if defined(UMPIRE_ENABLE_CUDA)
+  if (platform == Platform::cuda) {
+    std::size_t free_bytes = 0;
+    std::size_t total_bytes = 0;
+
+    cudaError_t error = ::cudaMemGetInfo(&free_bytes, &total_bytes);
+    if (error != cudaSuccess) {
+      UMPIRE_ERROR("cudaMemGetInfo failed with error: " << cudaGetErrorString(error));
+    }
+
+    return free_bytes;
+  }
+#else
+  static_cast<void>(platform);
+#endif
+
+  return static_cast<std::size_t>(::sysconf(_SC_AVPHYS_PAGES))
+    * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+} // end of anonymous namespace
+
+const std::size_t DynamicPool::s_color_step;
+const std::size_t DynamicPool::s_color_period;
+
 DynamicPool::DynamicPool(
     const std::string& name,
     int id,
     Allocator allocator,
     const std::size_t min_initial_alloc_size,
-    const std::size_t min_alloc_size) :
+    const std::size_t min_alloc_size,
+    const PlacementPolicy policy,
+    const std::size_t alignment,
+    const bool cache_coloring) :
+  DynamicPool(
+      name, id, allocator,
+      GrowthPolicy::fixed(min_initial_alloc_size),
+      GrowthPolicy::fixed(min_alloc_size),
+      policy, alignment, cache_coloring)
+{
+}
+
+DynamicPool::DynamicPool(
+    const std::string& name,
+    int id,
+    Allocator allocator,
+    const GrowthPolicy initial,
+    const GrowthPolicy growth,
+    const PlacementPolicy policy,
+    const std::size_t alignment,
+    const bool cache_coloring) :
   AllocationStrategy(name, id),
   dpa(nullptr),
+  m_alignment(alignment),
+  m_cache_coloring(cache_coloring),
+  m_next_color(0),
   m_current_size(0),
   m_highwatermark(0),
   m_allocator(allocator.getAllocationStrategy())
 {
-  dpa = new DynamicSizePool<>(m_allocator, min_initial_alloc_size, min_alloc_size);
+  if (alignment < DynamicSizePool<>::alignment || (alignment & (alignment - 1))) {
+    UMPIRE_ERROR("DynamicPool alignment " << alignment << " must be a power of two of at least "
+        << static_cast<std::size_t>(DynamicSizePool<>::alignment));
+  }
+
+  const Platform platform = m_allocator->getPlatform();
+
+  const std::size_t initial_size = alignSize(initial.chunkSize(0,
+      (initial.kind == GrowthPolicy::Kind::free_fraction) ? getFreeMemory(platform) : 0));
+
+  std::function<std::size_t(std::size_t)> grow_bytes;
+  if (growth.kind != GrowthPolicy::Kind::fixed) {
+    grow_bytes = [this, growth, platform] (std::size_t total_bytes) {
+      return alignSize(growth.chunkSize(total_bytes,
+          (growth.kind == GrowthPolicy::Kind::free_fraction) ? getFreeMemory(platform) : 0));
+    };
+  }
+
+  dpa = new DynamicSizePool<>(m_allocator, initial_size, growth.size, policy, grow_bytes);
+}
+
+DynamicPool::~DynamicPool()
+{
+  // Records of blocks still in use would otherwise point at freed memory.
+  // Dropping them a chunk at a time costs little, and nothing once
+  // ResourceManager::shutdown has emptied the map.
+  if (dpa->numUsedBlocks() > 0) {
+    auto& rm = ResourceManager::getInstance();
+
+    dpa->forEachChunk([&](char* data, std::size_t size) {
+      rm.deregisterAllocationRange(data, data + size, this);
+    });
+  }
+
+  delete dpa;
 }
 
 void*
 DynamicPool::allocate(size_t bytes)
 {
   UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
-  void* ptr = dpa->allocate(bytes);
-  ResourceManager::getInstance().registerAllocation(ptr, new util::AllocationRecord{ptr, bytes, this->shared_from_this()});
+  void* ptr = place(bytes, m_alignment, false);
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
 
-  m_current_size += bytes;
-  if (m_current_size > m_highwatermark)
-    m_highwatermark = m_current_size;
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
 
   return ptr;
 }
 
+void*
+DynamicPool::allocateAligned(size_t bytes, size_t alignment)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ", alignment=" << alignment << ")");
+  void* ptr = place(bytes, std::max(alignment, m_alignment), false);
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ptr;
+}
+
+void*
+DynamicPool::tryAllocate(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+  void* ptr = place(bytes, m_alignment, true);
+
+  if (ptr) {
+    ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+    util::increaseSize(m_current_size, m_highwatermark, bytes);
+  }
+
+  return ptr;
+}
+
+void
+DynamicPool::allocateMany(const size_t* sizes, size_t count, void** ptrs)
+{
+  UMPIRE_LOG(Debug, "(count=" << count << ")");
+
+  // Blocks carved side by side are only aligned to the pool's default.
+  if (m_alignment > DynamicSizePool<>::alignment) {
+    AllocationStrategy::allocateMany(sizes, count, ptrs);
+    return;
+  }
+
+  dpa->allocate(sizes, count, ptrs);
+
+  std::vector<util::AllocationRecord> records(count);
+  size_t bytes = 0;
+
+  for (size_t i = 0; i < count; ++i) {
+    records[i] = util::AllocationRecord{ptrs[i], sizes[i], this};
+    bytes += sizes[i];
+  }
+
+  ResourceManager::getInstance().registerAllocationBatch(ptrs, records.data(), count);
+
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+}
+
 void 
 DynamicPool::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+DynamicPool::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+  dpa->deallocate(ptr);
+
+  util::decreaseSize(m_current_size, record.m_size);
+}
+
+void*
+DynamicPool::allocateUntracked(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  // Untracked allocations have no record to hold their size, so they are
+  // accounted for using the size of the block taken from the pool.
+  const std::size_t allocated = dpa->allocatedSize();
+  void* ptr = place(bytes, m_alignment, false);
+
+  util::increaseSize(m_current_size, m_highwatermark, dpa->allocatedSize() - allocated);
+
+  return ptr;
+}
+
+void*
+DynamicPool::tryAllocateUntracked(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  const std::size_t allocated = dpa->allocatedSize();
+  void* ptr = place(bytes, m_alignment, true);
+
+  util::increaseSize(m_current_size, m_highwatermark, dpa->allocatedSize() - allocated);
+
+  return ptr;
+}
+
+void
+DynamicPool::deallocateUntracked(void* ptr)
 {
   UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  const std::size_t allocated = dpa->allocatedSize();
   dpa->deallocate(ptr);
-  m_current_size -= ResourceManager::getInstance().getSize(ptr);
 
-  ResourceManager::getInstance().deregisterAllocation(ptr);
+  util::decreaseSize(m_current_size, allocated - dpa->allocatedSize());
+}
+
+bool
+DynamicPool::reallocateInPlace(void* ptr, size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", bytes=" << bytes << ")");
+
+  if (!dpa->resize(ptr, alignSize(bytes))) {
+    return false;
+  }
+
+  auto& rm = ResourceManager::getInstance();
+  util::AllocationRecord record = rm.deregisterAllocation(ptr);
+  rm.registerAllocation(ptr, {ptr, bytes, this});
+
+  util::increaseSize(m_current_size, m_highwatermark, static_cast<long>(bytes) - static_cast<long>(record.m_size));
+
+  return true;
+}
+
+void
+DynamicPool::coalesce()
+{
+  UMPIRE_LOG(Debug, "()");
+  dpa->coalesce();
+}
+
+void
+DynamicPool::release()
+{
+  UMPIRE_LOG(Debug, "()");
+  dpa->releaseFreeChunks();
+}
+
+void
+DynamicPool::trim(size_t target_bytes)
+{
+  UMPIRE_LOG(Debug, "(target_bytes=" << target_bytes << ")");
+  dpa->releaseFreeChunks(target_bytes);
+}
+
+void
+DynamicPool::reserve(size_t bytes, bool prefault)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ", prefault=" << prefault << ")");
+
+  const std::size_t total_before = dpa->totalSize();
+  void* chunk = dpa->reserve(alignSize(bytes));
+
+  if (!chunk || !prefault) {
+    return;
+  }
+
+  const std::size_t chunk_size = dpa->totalSize() - total_before;
+
+  // The chunk is untracked, so apply the operations to it directly
+  auto& op_registry = op::MemoryOperationRegistry::getInstance();
+  util::AllocationRecord record{chunk, chunk_size, m_allocator.get()};
+
+  switch (m_allocator->getResourceType()) {
+    case resource::Host:
+    case resource::File:
+      op_registry.find(op::MemoryOperationType::memset,
+          m_allocator.get(), m_allocator.get())->apply(chunk, &record, 0, chunk_size);
+      break;
+    case resource::UnifiedMemory:
+#if defined(UMPIRE_ENABLE_CUDA)
+      {
+        int device;
+        ::cudaGetDevice(&device);
+        op_registry.find("PREFETCH",
+            m_allocator.get(), m_allocator.get())->apply(chunk, &record, device, chunk_size);
+      }
+#endif
+      break;
+    default:
+      break;
+  }
 }
 
 long 
 DynamicPool::getCurrentSize()
 { 
   UMPIRE_LOG(Debug, "() returning " << m_current_size);
-  return m_current_size;
+  return m_current_size.load(std::memory_order_relaxed);
 }
 
 long 
 DynamicPool::getHighWatermark()
 { 
   UMPIRE_LOG(Debug, "() returning " << m_highwatermark);
-  return m_highwatermark;
+  return m_highwatermark.load(std::memory_order_relaxed);
 }
 
 long 
@@ -88,5 +360,96 @@ DynamicPool::getPlatform()
   return m_allocator->getPlatform();
 }
 
+resource::MemoryResourceType
+DynamicPool::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+PlacementPolicy
+DynamicPool::getPlacementPolicy()
+{
+  return dpa->getPolicy();
+}
+
+bool
+DynamicPool::getCacheColoring()
+{
+  return m_cache_coloring;
+}
+
+size_t
+DynamicPool::getAlignment()
+{
+  return m_alignment;
+}
+
+size_t
+DynamicPool::alignSize(size_t bytes)
+{
+  return (bytes + (m_alignment - 1)) & ~(m_alignment - 1);
+}
+
+void*
+DynamicPool::place(size_t bytes, size_t alignment, bool may_fail)
+{
+  const std::size_t size = alignSize(bytes);
+
+  if (m_cache_coloring && size >= s_color_period && alignment < s_color_period) {
+    // Each block starts one color further into the period than the last
+    const std::size_t step = std::max(s_color_step, alignment);
+    const std::size_t offset = (m_next_color++ % (s_color_period / step)) * step;
+
+    return may_fail ?
+      dpa->tryAllocate(size, s_color_period, offset) :
+      dpa->allocate(size, s_color_period, offset);
+  }
+
+  return may_fail ?
+    dpa->tryAllocate(size, alignment) :
+    dpa->allocate(size, alignment);
+}
+
+size_t
+DynamicPool::getNumChunks()
+{
+  return dpa->numAllocatedChunks();
+}
+
+size_t
+DynamicPool::getNumUsedBlocks()
+{
+  return dpa->numUsedBlocks();
+}
+
+size_t
+DynamicPool::getNumFreeBlocks()
+{
+  return dpa->numFreeBlocks();
+}
+
+size_t
+DynamicPool::getAvailableSize()
+{
+  return dpa->totalSize() - dpa->allocatedSize();
+}
+
+size_t
+DynamicPool::getLargestAvailableBlock()
+{
+  return dpa->largestFreeBlock();
+}
+
+double
+DynamicPool::getFragmentation()
+{
+  const size_t available = getAvailableSize();
+  const double fragmentation = (available == 0) ? 0.0 :
+    1.0 - static_cast<double>(getLargestAvailableBlock()) / available;
+
+  UMPIRE_LOG(Debug, "() returning " << fragmentation);
+  return fragmentation;
+}
+
 } // end of namespace strategy
 } // end of namespace umpire
@@ -15,6 +15,7 @@
 #ifndef UMPIRE_DynamicPool_HPP
 #define UMPIRE_DynamicPool_HPP
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -22,11 +23,40 @@
 
 #include "umpire/Allocator.hpp"
 
+#include "umpire/util/GrowthPolicy.hpp"
+#include "umpire/util/PlacementPolicy.hpp"
+
 #include "umpire/tpl/simpool/DynamicSizePool.hpp"
 
 namespace umpire {
 namespace strategy {
 
+/*!
+ * \brief Pool variable-sized allocations in chunks taken from an Allocator.
+ *
+ * The placement policy decides which free block serves a request; see
+ * umpire::PlacementPolicy. best_fit gives the least fragmentation for a
+ * logarithmic search, segregated_fit gives constant-time selection.
+ *
+ * Every block starts on a multiple of alignment and is rounded up to a
+ * multiple of it. With alignment set to the page size of unified memory,
+ * no two allocations share a page, so a page migrated for one allocation
+ * never drags another along. Combined with an AllocationAdvisor, and a
+ * separate pool for memory used on each side, page placement then stays
+ * where the advice puts it.
+ *
+ * With cache_coloring, blocks of at least s_color_period bytes start at a
+ * rotating multiple of s_color_step bytes past a s_color_period boundary.
+ * Arrays of 2^k doubles would otherwise all start at the same offset in a
+ * page, so a loop streaming through several of them would map them to the
+ * same cache sets and stall on 4K aliasing. Each colored block may leave up
+ * to s_color_period bytes in front of it free in the pool.
+ *
+ * By default every chunk after the first is min_alloc_size bytes. A pool
+ * that ramps up to many gigabytes is better served by a GrowthPolicy that
+ * grows geometrically or by a share of free memory, keeping the number of
+ * chunks, and of calls to the underlying Allocator, small.
+ */
 class DynamicPool : public AllocationStrategy
 {
   public:
@@ -35,11 +65,84 @@ class DynamicPool : public AllocationStrategy
         int id,
         Allocator allocator,
         const std::size_t min_initial_alloc_size = (512 * 1024 * 1024),
-        const std::size_t min_alloc_size = (1 * 1024 *1024));
+        const std::size_t min_alloc_size = (1 * 1024 *1024),
+        const PlacementPolicy policy = PlacementPolicy::best_fit,
+        const std::size_t alignment = DynamicSizePool<>::alignment,
+        const bool cache_coloring = false);
+
+    /*!
+     * \brief Construct a pool whose chunks are sized by GrowthPolicy.
+     *
+     * initial sizes the first chunk and is evaluated here, so
+     * GrowthPolicy::freeFraction(0.8) reserves 80% of the memory free when
+     * the pool is built. growth sizes every chunk after it.
+     */
+    DynamicPool(
+        const std::string& name,
+        int id,
+        Allocator allocator,
+        const GrowthPolicy initial,
+        const GrowthPolicy growth,
+        const PlacementPolicy policy = PlacementPolicy::best_fit,
+        const std::size_t alignment = DynamicSizePool<>::alignment,
+        const bool cache_coloring = false);
+
+    /*!
+     * \brief Return every chunk to the parent Allocator, including those
+     * with blocks still in use.
+     */
+    ~DynamicPool();
 
     void* allocate(size_t bytes);
 
+    /*!
+     * \brief Allocate from the pool at an aligned address.
+     *
+     * Any bytes skipped to reach the boundary remain free in the pool.
+     */
+    void* allocateAligned(size_t bytes, size_t alignment);
+
+    /*!
+     * \brief Allocate the blocks side by side from one free block of the
+     * pool and register them together.
+     */
+    void allocateMany(const size_t* sizes, size_t count, void** ptrs);
+
+    /*!
+     * \brief Allocate from the pool, returning nullptr if the pool cannot
+     * grow.
+     *
+     * The pool grows with tryAllocateUntracked, so a memory resource that
+     * is full reports it without an exception being thrown.
+     */
+    void* tryAllocate(size_t bytes);
+
     void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    void* allocateUntracked(size_t bytes);
+    void* tryAllocateUntracked(size_t bytes);
+
+    void deallocateUntracked(void* ptr);
+
+    /*!
+     * \brief Grow the block at ptr into a free neighbour, or shrink it and
+     * return the tail to the pool.
+     */
+    bool reallocateInPlace(void* ptr, size_t bytes);
+
+    void coalesce();
+    void release();
+    void trim(size_t target_bytes);
+
+    /*!
+     * \brief Add a chunk so that at least bytes are free in the pool.
+     *
+     * With prefault, host chunks are first-touched by several threads and
+     * unified memory chunks are prefetched to the current device. Device
+     * memory is not demand-paged and is left as is.
+     */
+    void reserve(size_t bytes, bool prefault);
 
     long getCurrentSize();
     long getHighWatermark();
@@ -47,11 +150,92 @@ class DynamicPool : public AllocationStrategy
 
     Platform getPlatform();
 
+    resource::MemoryResourceType getResourceType();
+
+    PlacementPolicy getPlacementPolicy();
+
+    /*!
+     * \brief Return whether block start addresses are staggered.
+     */
+    bool getCacheColoring();
+
+    /*!
+     * \brief Return the alignment, and size granularity, of every block.
+     */
+    size_t getAlignment();
+
+    /*!
+     * \brief Return the number of chunks obtained from the underlying
+     * Allocator.
+     */
+    size_t getNumChunks();
+
+    /*!
+     * \brief Return the number of blocks handed out by the pool.
+     */
+    size_t getNumUsedBlocks();
+
+    /*!
+     * \brief Return the number of free blocks in the pool.
+     *
+     * Free neighbours are merged on release, so every free block is
+     * bordered by used blocks or chunk boundaries.
+     */
+    size_t getNumFreeBlocks();
+
+    /*!
+     * \brief Return the number of bytes held by the pool but not handed
+     * out.
+     */
+    size_t getAvailableSize();
+
+    /*!
+     * \brief Return the size of the largest free block.
+     *
+     * No request larger than this can be served without a new chunk.
+     */
+    size_t getLargestAvailableBlock();
+
+    /*!
+     * \brief Return how fragmented the free memory of the pool is.
+     *
+     * This is 1 - getLargestAvailableBlock() / getAvailableSize(): 0 when
+     * all free memory is one block (or there is none), approaching 1 as it
+     * is split into many small blocks.
+     */
+    double getFragmentation();
+
+    /*!
+     * \brief Distance between successive block colors, one cache line.
+     */
+    static const std::size_t s_color_step = 64;
+
+    /*!
+     * \brief Colors repeat every page, which covers the L1 sets and 4K
+     * aliasing.
+     */
+    static const std::size_t s_color_period = 4096;
+
   private:
+    /*!
+     * \brief Round bytes up to a multiple of the block alignment.
+     */
+    size_t alignSize(size_t bytes);
+
+    /*!
+     * \brief Take a block from the pool, colored if cache coloring is on.
+     */
+    void* place(size_t bytes, size_t alignment, bool may_fail);
+
     DynamicSizePool<>* dpa;
 
-    long m_current_size;
-    long m_highwatermark;
+    const std::size_t m_alignment;
+
+    const bool m_cache_coloring;
+    std::size_t m_next_color;
+
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
 
     std::shared_ptr<umpire::strategy::AllocationStrategy> m_allocator;
 };
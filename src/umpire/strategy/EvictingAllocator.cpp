@@ -0,0 +1,387 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/EvictingAllocator.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/op/MemoryOperationRegistry.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+#if defined(UMPIRE_ENABLE_CUDA)
+#include <cuda_runtime_api.h>
+#endif
+
+#include <new>
+
+namespace umpire {
+namespace strategy {
+
+EvictingAllocator::EvictingAllocator(
+    const std::string& name,
+    int id,
+    Allocator device,
+    Allocator host,
+    size_t capacity) :
+  AllocationStrategy(name, id),
+  m_device(device.getAllocationStrategy()),
+  m_host(host.getAllocationStrategy()),
+  m_capacity(capacity),
+  m_current_size(0),
+  m_highwatermark(0),
+  m_device_size(0),
+  m_held_size(0),
+  m_epoch(1),
+  m_num_evictions(0),
+  m_mutex(),
+  m_entries(),
+  m_lru(),
+  m_held()
+{
+}
+
+EvictingAllocator::~EvictingAllocator()
+{
+  for (auto& held : m_held) {
+    m_device->deallocateUntracked(held.first, held.second);
+  }
+}
+
+void*
+EvictingAllocator::allocate(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  void* ptr = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ptr = allocateDevice(bytes, nullptr, nullptr);
+
+    Entry entry{ptr, nullptr, bytes, 0, m_lru.insert(m_lru.end(), ptr)};
+    m_entries.insert({ptr, entry});
+  }
+
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ptr;
+}
+
+void
+EvictingAllocator::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+EvictingAllocator::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto found = m_entries.find(ptr);
+    if (found == m_entries.end()) {
+      UMPIRE_ERROR(ptr << " was not allocated by " << getName());
+    }
+
+    Entry& entry = found->second;
+
+    if (entry.device) {
+      m_lru.erase(entry.lru);
+      m_device->deallocateUntracked(entry.device, entry.size);
+      m_device_size -= entry.size;
+    } else {
+      auto held = m_held.find(ptr);
+      if (held != m_held.end()) {
+        m_device->deallocateUntracked(held->first, held->second);
+        m_held_size -= held->second;
+        m_held.erase(held);
+      }
+    }
+
+    if (entry.host) {
+      m_host->deallocateUntracked(entry.host, entry.size);
+    }
+
+    m_entries.erase(found);
+  }
+
+  util::decreaseSize(m_current_size, record.m_size);
+}
+
+void
+EvictingAllocator::release()
+{
+  UMPIRE_LOG(Debug, "()");
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    bool synchronized = false;
+    for (auto& entry : m_entries) {
+      if (entry.second.device && entry.second.host) {
+        // A copy from the host may still be reading it.
+        if (!synchronized) {
+          synchronize(nullptr);
+          synchronized = true;
+        }
+        m_host->deallocateUntracked(entry.second.host, entry.second.size);
+        entry.second.host = nullptr;
+      }
+    }
+  }
+
+  m_device->release();
+  m_host->release();
+}
+
+long
+EvictingAllocator::getCurrentSize()
+{
+  return m_current_size.load(std::memory_order_relaxed);
+}
+
+long
+EvictingAllocator::getHighWatermark()
+{
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+long
+EvictingAllocator::getActualSize()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_device_size + m_held_size;
+}
+
+Platform
+EvictingAllocator::getPlatform()
+{
+  return m_device->getPlatform();
+}
+
+resource::MemoryResourceType
+EvictingAllocator::getResourceType()
+{
+  return m_device->getResourceType();
+}
+
+bool
+EvictingAllocator::isThreadSafe()
+{
+  return true;
+}
+
+void*
+EvictingAllocator::acquire(void* ptr, void* stream)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", stream=" << stream << ")");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto found = m_entries.find(ptr);
+  if (found == m_entries.end()) {
+    UMPIRE_ERROR(ptr << " was not allocated by " << getName());
+  }
+
+  Entry& entry = found->second;
+  entry.epoch = m_epoch;
+
+  if (entry.device) {
+    m_lru.splice(m_lru.end(), m_lru, entry.lru);
+    return entry.device;
+  }
+
+  UMPIRE_LOG(Debug, "Bringing back " << entry.size << " bytes at " << ptr);
+
+  void* device = nullptr;
+
+  auto held = m_held.find(ptr);
+  if (held != m_held.end() && held->second == entry.size) {
+    makeRoom(entry.size, stream);
+    device = ptr;
+    m_held_size -= held->second;
+    m_device_size += held->second;
+    m_held.erase(held);
+  } else {
+    device = allocateDevice(entry.size, stream, ptr);
+  }
+
+  util::AllocationRecord host_record{entry.host, entry.size, m_host.get()};
+  util::AllocationRecord device_record{device, entry.size, m_device.get()};
+
+  auto op = op::MemoryOperationRegistry::getInstance().find(
+      op::MemoryOperationType::copy, m_host.get(), m_device.get());
+  op->transformAsync(entry.host, &device, &host_record, &device_record, entry.size, stream);
+
+  entry.device = device;
+  entry.lru = m_lru.insert(m_lru.end(), device);
+
+  if (device != ptr) {
+    // The allocation has a new address, so move its record there.
+    auto& rm = ResourceManager::getInstance();
+    auto record = rm.deregisterAllocation(ptr);
+    record.m_ptr = device;
+    rm.registerAllocation(device, record);
+
+    held = m_held.find(ptr);
+    if (held != m_held.end()) {
+      m_device->deallocateUntracked(held->first, held->second);
+      m_held_size -= held->second;
+      m_held.erase(held);
+    }
+
+    Entry moved = entry;
+    m_entries.erase(found);
+    m_entries.insert({device, moved});
+  }
+
+  return device;
+}
+
+void
+EvictingAllocator::advanceEpoch()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_epoch;
+}
+
+bool
+EvictingAllocator::isResident(void* ptr)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto found = m_entries.find(ptr);
+  return found != m_entries.end() && found->second.device;
+}
+
+size_t
+EvictingAllocator::getNumEvictions()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_num_evictions;
+}
+
+void*
+EvictingAllocator::allocateDevice(size_t bytes, void* stream, void* key)
+{
+  for (;;) {
+    makeRoom(bytes, stream);
+
+    void* ptr = nullptr;
+
+    try {
+      ptr = m_device->allocateUntracked(bytes);
+    } catch (util::Exception&) {
+      if (evict(bytes, stream) == 0) {
+        throw;
+      }
+      continue;
+    } catch (std::bad_alloc&) {
+      if (evict(bytes, stream) == 0) {
+        throw;
+      }
+      continue;
+    }
+
+    // The address still names an evicted allocation, so hold the block and
+    // try again.
+    if (ptr != key && m_entries.count(ptr)) {
+      m_held.insert({ptr, bytes});
+      m_held_size += bytes;
+      continue;
+    }
+
+    m_device_size += bytes;
+    return ptr;
+  }
+}
+
+void
+EvictingAllocator::makeRoom(size_t bytes, void* stream)
+{
+  if (m_capacity > 0 && m_device_size + bytes > m_capacity) {
+    size_t needed = m_device_size + bytes - m_capacity;
+    if (evict(needed, stream) < needed) {
+      UMPIRE_ERROR(getName() << " cannot make room for " << bytes
+          << " bytes, the allocations on the device are in use");
+    }
+  }
+}
+
+size_t
+EvictingAllocator::evict(size_t bytes, void* stream)
+{
+  std::vector<Entry*> victims;
+  size_t freed = 0;
+
+  for (auto it = m_lru.begin(); it != m_lru.end() && freed < bytes; ++it) {
+    Entry& entry = m_entries.find(*it)->second;
+    if (entry.epoch != m_epoch) {
+      victims.push_back(&entry);
+      freed += entry.size;
+    }
+  }
+
+  if (victims.empty()) {
+    return 0;
+  }
+
+  auto op = op::MemoryOperationRegistry::getInstance().find(
+      op::MemoryOperationType::copy, m_device.get(), m_host.get());
+
+  for (auto entry : victims) {
+    UMPIRE_LOG(Debug, "Evicting " << entry->size << " bytes at " << entry->device);
+
+    if (!entry->host) {
+      entry->host = m_host->allocateUntracked(entry->size);
+    }
+
+    util::AllocationRecord device_record{entry->device, entry->size, m_device.get()};
+    util::AllocationRecord host_record{entry->host, entry->size, m_host.get()};
+
+    op->transformAsync(entry->device, &entry->host, &device_record, &host_record, entry->size, stream);
+  }
+
+  // Every copy has to finish before its device memory can be reused.
+  synchronize(stream);
+
+  for (auto entry : victims) {
+    m_lru.erase(entry->lru);
+    m_device->deallocateUntracked(entry->device, entry->size);
+    m_device_size -= entry->size;
+    entry->device = nullptr;
+    ++m_num_evictions;
+  }
+
+  return freed;
+}
+
+void
+EvictingAllocator::synchronize(void* stream)
+{
+#if defined(UMPIRE_ENABLE_CUDA)
+  if (m_device->getPlatform() == Platform::cuda) {
+    ::cudaStreamSynchronize(static_cast<cudaStream_t>(stream));
+  }
+#else
+  UMPIRE_USE_VAR(stream);
+#endif
+}
+
+} // end of namespace strategy
+} // end namespace umpire
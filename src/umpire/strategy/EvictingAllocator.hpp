@@ -0,0 +1,181 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_EvictingAllocator_HPP
+#define UMPIRE_EvictingAllocator_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "umpire/Allocator.hpp"
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Allocate from a device AllocationStrategy, evicting the least
+ * recently used allocations to a host AllocationStrategy when the device
+ * is full.
+ *
+ * This gives a working set larger than device memory predictable,
+ * explicit transfers instead of unified memory page faults:
+ *
+ * \code
+ * auto evicting = rm.makeAllocator<umpire::strategy::EvictingAllocator>(
+ *     "EVICTING", rm.getAllocator("DEVICE"), rm.getAllocator("PINNED"));
+ *
+ * auto strategy = std::dynamic_pointer_cast<umpire::strategy::EvictingAllocator>(
+ *     evicting.getAllocationStrategy());
+ *
+ * double* data = static_cast<double*>(evicting.allocate(bytes));
+ * ...
+ * data = static_cast<double*>(strategy->acquire(data, stream));
+ * \endcode
+ *
+ * Evicted data is copied to the host asynchronously, and the stream is
+ * synchronized once per batch of evictions before the device memory is
+ * freed. The host copy is kept, so evicting the allocation again does not
+ * allocate host memory; release frees the host copies of resident
+ * allocations.
+ *
+ * An allocation may be evicted whenever this strategy allocates, so
+ * acquire must be called before each use. acquire returns the pointer to
+ * use from then on, which differs from the old one if the data had to be
+ * brought back to a new address. Allocations acquired since the last
+ * advanceEpoch are never evicted.
+ *
+ * When the device allocator hands out the address of an evicted
+ * allocation, the block is held until that allocation is brought back or
+ * freed, so pointers stay unique. Held blocks are not counted against the
+ * capacity, but are included in getActualSize.
+ */
+class EvictingAllocator :
+  public AllocationStrategy
+{
+  public:
+    /*!
+     * \brief Construct a new EvictingAllocator.
+     *
+     * \param name Name of this instance of the EvictingAllocator.
+     * \param id Id of this instance of the EvictingAllocator.
+     * \param device Allocator for resident data.
+     * \param host Allocator for evicted data.
+     * \param capacity Number of bytes to keep on the device. The default of
+     *        0 evicts only when the device allocator fails.
+     */
+    EvictingAllocator(
+        const std::string& name,
+        int id,
+        Allocator device,
+        Allocator host,
+        size_t capacity = 0);
+
+    ~EvictingAllocator();
+
+    void* allocate(size_t bytes);
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    void release();
+
+    long getCurrentSize();
+    long getHighWatermark();
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+    bool isThreadSafe();
+
+    /*!
+     * \brief Make the allocation at ptr resident and protect it from
+     * eviction until the next advanceEpoch.
+     *
+     * \param ptr Pointer returned by allocate or by an earlier acquire.
+     * \param stream Stream to order the copies on (a cudaStream_t for CUDA
+     *        memory), or nullptr for the default stream.
+     *
+     * \return Device pointer to the allocation.
+     */
+    void* acquire(void* ptr, void* stream = nullptr);
+
+    /*!
+     * \brief Start a new epoch, so that allocations acquired so far may be
+     * evicted again.
+     */
+    void advanceEpoch();
+
+    /*!
+     * \brief Return whether the data of the allocation at ptr is on the
+     * device.
+     */
+    bool isResident(void* ptr);
+
+    /*!
+     * \brief Return the number of allocations that have been evicted.
+     */
+    size_t getNumEvictions();
+
+  private:
+    struct Entry {
+      void* device;
+      void* host;
+      size_t size;
+      uint64_t epoch;
+      std::list<void*>::iterator lru;
+    };
+
+    void* allocateDevice(size_t bytes, void* stream, void* key);
+    void makeRoom(size_t bytes, void* stream);
+    size_t evict(size_t bytes, void* stream);
+    void synchronize(void* stream);
+
+    std::shared_ptr<AllocationStrategy> m_device;
+    std::shared_ptr<AllocationStrategy> m_host;
+
+    size_t m_capacity;
+
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
+    long m_device_size;
+    long m_held_size;
+
+    uint64_t m_epoch;
+    size_t m_num_evictions;
+
+    std::mutex m_mutex;
+
+    // Every live allocation, by the pointer last returned for it.
+    std::unordered_map<void*, Entry> m_entries;
+
+    // Resident allocations, least recently used first.
+    std::list<void*> m_lru;
+
+    // Device blocks at the address of an evicted allocation, held so the
+    // address is not handed out again while it names that allocation.
+    // Bringing the allocation back reuses its block if the size matches.
+    std::unordered_map<void*, size_t> m_held;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_EvictingAllocator_HPP
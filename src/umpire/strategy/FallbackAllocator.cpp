@@ -0,0 +1,234 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/FallbackAllocator.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+#include <new>
+
+namespace umpire {
+namespace strategy {
+
+FallbackAllocator::FallbackAllocator(
+    const std::string& name,
+    int id,
+    Allocator primary,
+    Allocator fallback) :
+  FallbackAllocator(name, id, std::vector<Allocator>{primary, fallback})
+{
+}
+
+FallbackAllocator::FallbackAllocator(
+    const std::string& name,
+    int id,
+    std::vector<Allocator> tiers) :
+  AllocationStrategy(name, id),
+  m_current_size(0),
+  m_highwatermark(0),
+  m_tiers(),
+  m_num_fallbacks(0),
+  m_mutex(),
+  m_fallback_ptrs(),
+  m_num_fallback_ptrs(0)
+{
+  if (tiers.empty()) {
+    UMPIRE_ERROR("FallbackAllocator " << name << " needs at least one Allocator");
+  }
+
+  for (auto& tier : tiers) {
+    m_tiers.push_back(tier.getAllocationStrategy());
+
+    if (m_tiers.back()->getPlatform() != m_tiers.front()->getPlatform()) {
+      UMPIRE_ERROR("FallbackAllocator " << name << " needs " << m_tiers.front()->getName()
+          << " and " << m_tiers.back()->getName() << " to be on the same platform");
+    }
+  }
+}
+
+template <typename TryAllocate, typename Allocate>
+void*
+FallbackAllocator::allocateFrom(size_t bytes, TryAllocate try_allocate, Allocate allocate)
+{
+  OwnerScope scope(this, bytes);
+
+  void* ptr = try_allocate(m_tiers.front().get());
+  size_t tier = 0;
+
+  while (!ptr && bytes > 0) {
+    AllocationStrategy* strategy = m_tiers[tier].get();
+
+    UMPIRE_LOG(Debug, strategy->getName() << " cannot allocate " << bytes
+        << " bytes, releasing its unused memory");
+    strategy->release();
+
+    if (tier + 1 == m_tiers.size()) {
+      ptr = allocate(strategy);
+    } else {
+      ptr = try_allocate(strategy);
+      if (!ptr) {
+        ++tier;
+        UMPIRE_LOG(Debug, "Using " << m_tiers[tier]->getName());
+        ptr = try_allocate(m_tiers[tier].get());
+      }
+    }
+  }
+
+  if (tier > 0) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_fallback_ptrs[ptr] = tier;
+    m_num_fallback_ptrs.store(m_fallback_ptrs.size(), std::memory_order_release);
+    ++m_num_fallbacks;
+  }
+
+  if (!scope.claimed()) {
+    ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+  }
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ptr;
+}
+
+void*
+FallbackAllocator::allocate(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  return allocateFrom(bytes,
+    [bytes] (AllocationStrategy* strategy) {
+      return strategy->tryAllocate(bytes);
+    },
+    [bytes] (AllocationStrategy* strategy) {
+      return strategy->allocate(bytes);
+    });
+}
+
+void*
+FallbackAllocator::allocateAligned(size_t bytes, size_t alignment)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ", alignment=" << alignment << ")");
+
+  return allocateFrom(bytes,
+    [bytes, alignment] (AllocationStrategy* strategy) -> void* {
+      try {
+        return strategy->allocateAligned(bytes, alignment);
+      } catch (util::Exception&) {
+      } catch (std::bad_alloc&) {
+      }
+      return nullptr;
+    },
+    [bytes, alignment] (AllocationStrategy* strategy) {
+      return strategy->allocateAligned(bytes, alignment);
+    });
+}
+
+void
+FallbackAllocator::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+FallbackAllocator::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  size_t tier = 0;
+
+  if (m_num_fallback_ptrs.load(std::memory_order_acquire) > 0) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto spilled = m_fallback_ptrs.find(ptr);
+    if (spilled != m_fallback_ptrs.end()) {
+      tier = spilled->second;
+      m_fallback_ptrs.erase(spilled);
+    }
+    m_num_fallback_ptrs.store(m_fallback_ptrs.size(), std::memory_order_release);
+  }
+
+  m_tiers[tier]->deallocateRecord(ptr, record);
+
+  util::decreaseSize(m_current_size, record.m_size);
+}
+
+void
+FallbackAllocator::coalesce()
+{
+  for (auto& tier : m_tiers) {
+    tier->coalesce();
+  }
+}
+
+void
+FallbackAllocator::release()
+{
+  for (auto& tier : m_tiers) {
+    tier->release();
+  }
+}
+
+long
+FallbackAllocator::getCurrentSize()
+{
+  return m_current_size.load(std::memory_order_relaxed);
+}
+
+long
+FallbackAllocator::getHighWatermark()
+{
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+long
+FallbackAllocator::getActualSize()
+{
+  long size = 0;
+  for (auto& tier : m_tiers) {
+    size += tier->getActualSize();
+  }
+  return size;
+}
+
+Platform
+FallbackAllocator::getPlatform()
+{
+  return m_tiers.front()->getPlatform();
+}
+
+resource::MemoryResourceType
+FallbackAllocator::getResourceType()
+{
+  return m_tiers.front()->getResourceType();
+}
+
+bool
+FallbackAllocator::isThreadSafe()
+{
+  for (auto& tier : m_tiers) {
+    if (!tier->isThreadSafe()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t
+FallbackAllocator::getNumFallbacks()
+{
+  return m_num_fallbacks.load(std::memory_order_relaxed);
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
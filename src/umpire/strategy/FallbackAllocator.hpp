@@ -0,0 +1,119 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_FallbackAllocator_HPP
+#define UMPIRE_FallbackAllocator_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "umpire/Allocator.hpp"
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Allocate from a primary AllocationStrategy, and from fallbacks
+ * when the primary cannot satisfy a request.
+ *
+ * This puts data in the faster of two memory tiers while it has room, e.g.
+ * HBM in front of HOST:
+ *
+ * \code
+ * auto tiered = rm.makeAllocator<umpire::strategy::FallbackAllocator>(
+ *     "TIERED", rm.getAllocator("HBM"), rm.getAllocator("HOST"));
+ * \endcode
+ *
+ * Longer chains are given as a list, fastest first:
+ *
+ * \code
+ * auto chain = rm.makeAllocator<umpire::strategy::FallbackAllocator>(
+ *     "CHAIN", std::vector<umpire::Allocator>{
+ *       rm.getAllocator("DEVICE_POOL"), rm.getAllocator("UM"),
+ *       rm.getAllocator("PINNED")});
+ * \endcode
+ *
+ * Each tier is asked with tryAllocate, so a memory resource that is full
+ * returns nullptr instead of throwing. When a tier fails, its unused
+ * memory is released, e.g. a pool's free chunks, and it is asked again
+ * before the request moves on to the next tier. Only the last tier throws.
+ * All strategies must be on the same Platform. Spilled allocations are
+ * remembered so they are returned to their tier; while there are none,
+ * deallocation takes no lock.
+ */
+class FallbackAllocator :
+  public AllocationStrategy
+{
+  public:
+    FallbackAllocator(
+        const std::string& name,
+        int id,
+        Allocator primary,
+        Allocator fallback);
+
+    FallbackAllocator(
+        const std::string& name,
+        int id,
+        std::vector<Allocator> tiers);
+
+    void* allocate(size_t bytes);
+    void* allocateAligned(size_t bytes, size_t alignment);
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    void coalesce();
+    void release();
+
+    long getCurrentSize();
+    long getHighWatermark();
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+    bool isThreadSafe();
+
+    /*!
+     * \brief Return the number of allocations that have been made from a
+     * fallback strategy.
+     */
+    size_t getNumFallbacks();
+
+  private:
+    template <typename TryAllocate, typename Allocate>
+    void* allocateFrom(size_t bytes, TryAllocate try_allocate, Allocate allocate);
+
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
+
+    std::vector<std::shared_ptr<AllocationStrategy>> m_tiers;
+
+    std::atomic<size_t> m_num_fallbacks;
+
+    // Allocations currently held by a fallback, with the index of its tier,
+    // and how many there are.
+    std::mutex m_mutex;
+    std::unordered_map<void*, size_t> m_fallback_ptrs;
+    std::atomic<size_t> m_num_fallback_ptrs;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_FallbackAllocator_HPP
@@ -15,6 +15,8 @@
 #ifndef UMPIRE_FixedPool_HPP
 #define UMPIRE_FixedPool_HPP
 
+#include <atomic>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -27,6 +29,14 @@
 namespace umpire {
 namespace strategy {
 
+/*!
+ * \brief Pool of fixed size blocks, each holding one T.
+ *
+ * If cache_coloring is set and sizeof(T) is a multiple of 4096 bytes,
+ * blocks are spaced one 64 byte cache line further apart than sizeof(T).
+ * Otherwise every block would start at the same offset within a page and
+ * map to the same cache sets.
+ */
 template <typename T, int NP=64, typename IA=StdAllocator>
 class FixedPool 
   : public AllocationStrategy
@@ -36,45 +46,158 @@ class FixedPool
     FixedPool(
         const std::string& name,
         int id,
-        Allocator allocator);
+        Allocator allocator,
+        const bool cache_coloring = false);
 
     ~FixedPool();
 
     void* allocate(size_t bytes);
 
+    /*!
+     * \brief Allocate a block, checking that it meets alignment.
+     *
+     * Pools are placed so that every block is aligned to the largest power
+     * of two dividing the block stride, up to 4096 bytes. Asking for more than that
+     * throws an umpire::Exception.
+     */
+    void* allocateAligned(size_t bytes, size_t alignment);
+
     void deallocate(void* ptr);
 
+    void* allocateUntracked(size_t bytes);
+
+    void deallocateUntracked(void* ptr);
+
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    /*!
+     * \brief Return the record of the block containing ptr.
+     *
+     * Pools are registered with ResourceManager::registerChunk and keep one
+     * AllocationRecord per block, so blocks are never entered into the
+     * ResourceManager's AllocationMap and looking one up is a little
+     * arithmetic.
+     */
+    util::AllocationRecord* findRecord(void* ptr, void* handle);
+
     long getCurrentSize();
     long getHighWatermark();
     long getActualSize();
 
     Platform getPlatform();
 
+    resource::MemoryResourceType getResourceType();
+
+    /*!
+     * \brief Return the number of pools obtained from the underlying
+     * Allocator.
+     */
+    size_t getNumChunks();
+
+    /*!
+     * \brief Return the number of blocks handed out by the pool.
+     */
+    size_t getNumUsedBlocks();
+
+    /*!
+     * \brief Return the number of free blocks across all pools.
+     */
+    size_t getNumFreeBlocks();
+
+    /*!
+     * \brief Return the number of bytes in free blocks.
+     */
+    size_t getAvailableSize();
+
+    /*!
+     * \brief Return the size in bytes of the longest run of adjacent free
+     * blocks within one pool.
+     *
+     * This scans every pool's bitmap.
+     */
+    size_t getLargestAvailableBlock();
+
+    /*!
+     * \brief Return 1 - getLargestAvailableBlock() / getAvailableSize(), or
+     * 0 if nothing is free.
+     */
+    double getFragmentation();
+
   private:
     struct Pool
     {
+      unsigned char *base;
       unsigned char *data;
       unsigned int *avail;
+      util::AllocationRecord *records;
       unsigned int numAvail;
-      struct Pool* next;
+      struct Pool* nextFree;
     };
 
-    void newPool(struct Pool **pnew);
+    void newPool();
 
     T* allocInPool(struct Pool *p);
 
+    T* allocateBlock(bool track);
+
+    void deallocateBlock(T* ptr);
+
     size_t numPools() const;
 
+    static size_t blockStride(bool cache_coloring);
+
+    static size_t blockAlignment(size_t stride);
+
+    static size_t recordsOffset();
+
+    /*!
+     * \brief Bytes taken from the allocator for each pool's blocks,
+     * including room to align them.
+     */
+    size_t dataBytes() const;
+
+
+    /*!
+     * \brief Pools with at least one free block, most recently used first.
+     *
+     * A pool is pushed when it goes from full to having a free block and
+     * popped when its last block is handed out, so allocation never has to
+     * look past the head.
+     */
+    struct Pool *m_free_pools;
+
+    /*!
+     * \brief All pools, keyed by the start address of their data.
+     *
+     * Used to find the owning pool of a block on deallocation without
+     * scanning every pool.
+     */
+    std::map<const unsigned char*, struct Pool*> m_pools;
+
+    /*!
+     * \brief Number of entries in m_pools, readable from any thread.
+     */
+    std::atomic<size_t> m_num_pools;
+
+    /*!
+     * \brief Distance in bytes between the starts of adjacent blocks, see
+     * blockStride().
+     */
+    size_t m_stride;
 
-    struct Pool *m_pool;
     size_t m_num_per_pool;
     size_t m_total_pool_size;
 
     size_t m_num_blocks;
 
+    /*!
+     * \brief Alignment guaranteed for every block, see blockAlignment().
+     */
+    size_t m_block_alignment;
+
 
-    long m_highwatermark;
-    long m_current_size;
+    std::atomic<long> m_highwatermark;
+    std::atomic<long> m_current_size;
 
     std::shared_ptr<umpire::strategy::AllocationStrategy> m_allocator;
 };
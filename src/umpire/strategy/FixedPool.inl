@@ -17,28 +17,49 @@
 
 #include "umpire/strategy/FixedPool.hpp"
 
+#include "umpire/util/AtomicStatistics.hpp"
 #include "umpire/util/Macros.hpp"
 
+#include <strings.h>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
 namespace umpire {
 namespace strategy {
 
 template <typename T, int NP, typename IA>
 void 
-FixedPool<T, NP, IA>::newPool(struct Pool **pnew) {
-  struct Pool *p = static_cast<struct Pool *>(IA::allocate(sizeof(struct Pool) + NP * sizeof(unsigned int)));
+FixedPool<T, NP, IA>::newPool() {
+  struct Pool *p = static_cast<struct Pool *>(IA::allocate(
+        recordsOffset() + m_num_per_pool * sizeof(util::AllocationRecord)));
   p->numAvail = m_num_per_pool;
-  p->next = NULL;
 
-  p->data  = reinterpret_cast<unsigned char*>(m_allocator->allocate(m_num_per_pool * sizeof(T)));
+  // Pool data is untracked, so over-allocate to align it ourselves.
+  p->base = static_cast<unsigned char*>(m_allocator->allocateUntracked(dataBytes()));
+  p->data = p->base;
+  if (m_block_alignment > alignof(std::max_align_t)) {
+    const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(p->base);
+    p->data += (m_block_alignment - addr % m_block_alignment) % m_block_alignment;
+  }
   p->avail = reinterpret_cast<unsigned int *>(p + 1);
   for (int i = 0; i < NP; i++) p->avail[i] = (~0);
 
-  *pnew = p;
-
-  m_current_size += m_num_per_pool*sizeof(T);
-  if (m_current_size > m_highwatermark) {
-    m_highwatermark = m_current_size;
+  p->records = reinterpret_cast<util::AllocationRecord*>(
+      reinterpret_cast<unsigned char*>(p) + recordsOffset());
+  for (size_t i = 0; i < m_num_per_pool; i++) {
+    p->records[i] = util::AllocationRecord{nullptr, sizeof(T), this};
   }
+
+  m_pools[p->data] = p;
+  m_num_pools.fetch_add(1, std::memory_order_relaxed);
+
+  ResourceManager::getInstance().registerChunk(p->data, m_num_per_pool * m_stride, this, p);
+
+  p->nextFree = m_free_pools;
+  m_free_pools = p;
+
+  util::increaseSize(m_current_size, m_highwatermark, m_num_per_pool*sizeof(T));
 }
 
 template <typename T, int NP, typename IA>
@@ -52,7 +73,7 @@ FixedPool<T, NP, IA>::allocInPool(struct Pool *p) {
         p->avail[i] ^= 1 << bit;
         p->numAvail--;
         const int entry = i * sizeof(unsigned int) * 8 + bit;
-        return reinterpret_cast<T*>(p->data) + entry;
+        return reinterpret_cast<T*>(p->data + entry * m_stride);
       }
     }
 
@@ -63,111 +84,209 @@ template <typename T, int NP, typename IA>
 FixedPool<T, NP, IA>::FixedPool(
     const std::string& name,
     int id,
-    Allocator allocator) : 
+    Allocator allocator,
+    const bool cache_coloring) : 
   AllocationStrategy(name, id),
+  m_free_pools(NULL),
+  m_pools(),
+  m_num_pools(0),
+  m_stride(blockStride(cache_coloring)),
   m_num_per_pool(NP * sizeof(unsigned int) * 8),
-  m_total_pool_size(sizeof(struct Pool) + m_num_per_pool * sizeof(T) + NP * sizeof(unsigned int)),
+  m_total_pool_size(recordsOffset() + m_num_per_pool * (m_stride + sizeof(util::AllocationRecord))),
   m_num_blocks(0),
+  m_block_alignment(blockAlignment(m_stride)),
   m_highwatermark(0),
   m_current_size(0),
   m_allocator(allocator.getAllocationStrategy())
 { 
-  newPool(&m_pool); 
+  newPool(); 
 }
 
 template <typename T, int NP, typename IA>
 FixedPool<T, NP, IA>::~FixedPool() {
-    for (struct Pool *curr = m_pool; curr; ) {
-      struct Pool *next = curr->next;
-      m_allocator->deallocate(curr);
-      m_current_size -= sizeof(T)*m_num_per_pool;
-      curr = next;
+    for (auto& entry : m_pools) {
+      struct Pool *curr = entry.second;
+      ResourceManager::getInstance().deregisterChunk(curr->data, this);
+      m_allocator->deallocateUntracked(curr->base, dataBytes());
+      IA::deallocate(curr);
+      util::decreaseSize(m_current_size, sizeof(T)*m_num_per_pool);
     }
   }
 
 template <typename T, int NP, typename IA>
-void* 
-FixedPool<T, NP, IA>::allocate(size_t bytes) {
-  T* ptr = NULL;
-
-  struct Pool *prev = NULL;
-  struct Pool *curr = m_pool;
-  while (!ptr && curr) {
-    ptr = allocInPool(curr);
-    prev = curr;
-    curr = curr->next;
+T*
+FixedPool<T, NP, IA>::allocateBlock(bool track) {
+  if (!m_free_pools) {
+    newPool();
   }
 
-  if (!ptr) {
-    newPool(&prev->next);
-    ptr = static_cast<T*>(allocate(bytes));
-    // TODO: In this case we should reverse the linked list for optimality
+  struct Pool *curr = m_free_pools;
+  T* ptr = allocInPool(curr);
+
+  if (track) {
+    curr->records[(reinterpret_cast<unsigned char*>(ptr) - curr->data) / m_stride].m_ptr = ptr;
   }
-  else {
-    m_num_blocks++;
+
+  if (!curr->numAvail) {
+    m_free_pools = curr->nextFree;
+    curr->nextFree = NULL;
   }
 
-  ResourceManager::getInstance().registerAllocation(ptr, new util::AllocationRecord{ptr, sizeof(T), this->shared_from_this()});
+  m_num_blocks++;
 
   return ptr;
 }
 
 template <typename T, int NP, typename IA>
-void 
-FixedPool<T,NP, IA>::deallocate(void* ptr) {
-  T* t_ptr = static_cast<T*>(ptr);
-
-  int i = 0;
-  for (struct Pool *curr = m_pool; curr; curr = curr->next) {
-    const T* start = reinterpret_cast<T*>(curr->data);
-    const T* end   = reinterpret_cast<T*>(curr->data) + m_num_per_pool;
-    if ( (t_ptr >= start) && (t_ptr < end) ) {
-      // indexes bits 0 - m_num_per_pool-1
-      const int indexD = t_ptr - reinterpret_cast<T*>(curr->data);
-      const int indexI = indexD / ( sizeof(unsigned int) * 8 );
-      const int indexB = indexD % ( sizeof(unsigned int) * 8 );
+void
+FixedPool<T, NP, IA>::deallocateBlock(T* t_ptr) {
+  const unsigned char* addr = reinterpret_cast<const unsigned char*>(t_ptr);
+
+  // The owning pool is the one with the highest start address <= addr.
+  auto it = m_pools.upper_bound(addr);
+  if (it == m_pools.begin()) {
+    UMPIRE_ERROR("Could not find pointer to deallocate");
+  }
+  --it;
+
+  struct Pool *curr = it->second;
+  const unsigned char* start = curr->data;
+  const unsigned char* end   = curr->data + m_num_per_pool * m_stride;
+  if ( (addr < start) || (addr >= end) ) {
+    UMPIRE_ERROR("Could not find pointer to deallocate");
+  }
+
+  // indexes bits 0 - m_num_per_pool-1
+  const int indexD = (addr - start) / m_stride;
+  const int indexI = indexD / ( sizeof(unsigned int) * 8 );
+  const int indexB = indexD % ( sizeof(unsigned int) * 8 );
 #ifndef NDEBUG
-      if ((curr->avail[indexI] & (1 << indexB))) {
-        std::cerr << "Trying to deallocate an entry that was not marked as allocated" << std::endl;
-      }
+  if ((curr->avail[indexI] & (1 << indexB))) {
+    std::cerr << "Trying to deallocate an entry that was not marked as allocated" << std::endl;
+  }
 #endif
-      curr->avail[indexI] ^= 1 << indexB;
-      curr->numAvail++;
-      m_num_blocks--;
-      ResourceManager::getInstance().deregisterAllocation(ptr);
+  curr->avail[indexI] ^= 1 << indexB;
+  curr->records[indexD].m_ptr = nullptr;
 
-      return;
-    }
-    i++;
+  if (!curr->numAvail) {
+    curr->nextFree = m_free_pools;
+    m_free_pools = curr;
   }
+  curr->numAvail++;
+  m_num_blocks--;
+}
 
-  UMPIRE_ERROR("Could not find pointer to deallocate");
+template <typename T, int NP, typename IA>
+void* 
+FixedPool<T, NP, IA>::allocate(size_t UMPIRE_UNUSED_ARG(bytes)) {
+  return allocateBlock(true);
+}
+
+template <typename T, int NP, typename IA>
+void*
+FixedPool<T, NP, IA>::allocateAligned(size_t bytes, size_t alignment) {
+  if (alignment > m_block_alignment) {
+    UMPIRE_ERROR(getName() << " blocks are only aligned to " << m_block_alignment
+        << " bytes, cannot align to " << alignment);
+  }
+
+  return allocate(bytes);
+}
+
+template <typename T, int NP, typename IA>
+void 
+FixedPool<T,NP, IA>::deallocate(void* ptr) {
+  deallocateBlock(static_cast<T*>(ptr));
+}
+
+template <typename T, int NP, typename IA>
+void*
+FixedPool<T, NP, IA>::allocateUntracked(size_t UMPIRE_UNUSED_ARG(bytes)) {
+  return allocateBlock(false);
+}
+
+template <typename T, int NP, typename IA>
+void
+FixedPool<T, NP, IA>::deallocateUntracked(void* ptr) {
+  deallocateBlock(static_cast<T*>(ptr));
+}
+
+template <typename T, int NP, typename IA>
+void
+FixedPool<T, NP, IA>::deallocateRecord(void* ptr, const util::AllocationRecord& UMPIRE_UNUSED_ARG(record)) {
+  // Blocks are found through their pool, not the AllocationMap
+  deallocate(ptr);
+}
+
+template <typename T, int NP, typename IA>
+util::AllocationRecord*
+FixedPool<T, NP, IA>::findRecord(void* ptr, void* handle) {
+  const struct Pool *p = static_cast<const struct Pool *>(handle);
+  const size_t index = (static_cast<unsigned char*>(ptr) - p->data) / m_stride;
+
+  util::AllocationRecord* record = &p->records[index];
+
+  // Untracked and free blocks have no record
+  return record->m_ptr ? record : nullptr;
 }
 
 template <typename T, int NP, typename IA>
 long 
 FixedPool<T, NP, IA>::getCurrentSize() {
-    return m_current_size;
+    return m_current_size.load(std::memory_order_relaxed);
 }
 
 template <typename T, int NP, typename IA>
 long 
 FixedPool<T, NP, IA>::getActualSize() {
-    return m_total_pool_size;
+    return numPools() * m_total_pool_size;
 }
 
 template <typename T, int NP, typename IA>
 long 
 FixedPool<T, NP, IA>::getHighWatermark() {
-  return m_highwatermark;
+  return m_highwatermark.load(std::memory_order_relaxed);
 }
 
 template <typename T, int NP, typename IA>
 size_t
 FixedPool<T, NP, IA>::numPools() const {
-  std::size_t np = 0;
-  for (struct Pool *curr = m_pool; curr; curr = curr->next) np++;
-  return np;
+  return m_num_pools.load(std::memory_order_relaxed);
+}
+
+template <typename T, int NP, typename IA>
+size_t
+FixedPool<T, NP, IA>::blockStride(bool cache_coloring) {
+  // Page multiples would put every block on the same cache sets, so push
+  // each one a line further along.
+  const size_t bytes = sizeof(T);
+  return (cache_coloring && bytes % 4096 == 0) ? bytes + 64 : bytes;
+}
+
+template <typename T, int NP, typename IA>
+size_t
+FixedPool<T, NP, IA>::blockAlignment(size_t stride) {
+  // Blocks sit at multiples of the stride from the start of a pool, so they
+  // share the largest power of two that divides it.
+  const size_t alignment = stride & (~stride + 1);
+  return (alignment > 4096) ? 4096 : alignment;
+}
+
+template <typename T, int NP, typename IA>
+size_t
+FixedPool<T, NP, IA>::dataBytes() const {
+  const size_t bytes = m_num_per_pool * m_stride;
+  return m_block_alignment > alignof(std::max_align_t) ? bytes + m_block_alignment : bytes;
+}
+
+template <typename T, int NP, typename IA>
+size_t
+FixedPool<T, NP, IA>::recordsOffset() {
+  // The records follow the Pool header and its bitmap
+  const size_t offset = sizeof(struct Pool) + NP * sizeof(unsigned int);
+  const size_t alignment = alignof(util::AllocationRecord);
+
+  return (offset + alignment - 1) / alignment * alignment;
 }
 
 template <typename T, int NP, typename IA>
@@ -177,6 +296,77 @@ FixedPool<T, NP, IA>::getPlatform()
   return m_allocator->getPlatform();
 }
 
+template <typename T, int NP, typename IA>
+resource::MemoryResourceType
+FixedPool<T, NP, IA>::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+template <typename T, int NP, typename IA>
+size_t
+FixedPool<T, NP, IA>::getNumChunks()
+{
+  return numPools();
+}
+
+template <typename T, int NP, typename IA>
+size_t
+FixedPool<T, NP, IA>::getNumUsedBlocks()
+{
+  return m_num_blocks;
+}
+
+template <typename T, int NP, typename IA>
+size_t
+FixedPool<T, NP, IA>::getNumFreeBlocks()
+{
+  return numPools() * m_num_per_pool - m_num_blocks;
+}
+
+template <typename T, int NP, typename IA>
+size_t
+FixedPool<T, NP, IA>::getAvailableSize()
+{
+  return getNumFreeBlocks() * sizeof(T);
+}
+
+template <typename T, int NP, typename IA>
+size_t
+FixedPool<T, NP, IA>::getLargestAvailableBlock()
+{
+  const size_t bits_per_word = sizeof(unsigned int) * 8;
+  size_t longest = 0;
+
+  for (auto& entry : m_pools) {
+    const struct Pool *p = entry.second;
+
+    // A set bit marks a free block.
+    size_t run = 0;
+    for (size_t i = 0; i < m_num_per_pool; ++i) {
+      if (p->avail[i / bits_per_word] & (1u << (i % bits_per_word))) {
+        if (++run > longest) {
+          longest = run;
+        }
+      } else {
+        run = 0;
+      }
+    }
+  }
+
+  return longest * sizeof(T);
+}
+
+template <typename T, int NP, typename IA>
+double
+FixedPool<T, NP, IA>::getFragmentation()
+{
+  const size_t available = getAvailableSize();
+
+  return (available == 0) ? 0.0 :
+    1.0 - static_cast<double>(getLargestAvailableBlock()) / available;
+}
+
 } // end of namespace strategy
 } // end of namespace umpire
 
@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/HostVirtualPool.hpp"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace strategy {
+
+HostVirtualPool::HostVirtualPool(
+    const std::string& name,
+    int id,
+    size_t reserve_bytes,
+    size_t granularity) :
+  VirtualPool(name, id)
+{
+  const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+  if (granularity == 0) {
+    granularity = 2*1024*1024;
+  }
+  granularity = ((granularity + page_size - 1) / page_size) * page_size;
+
+  if (reserve_bytes == 0) {
+    reserve_bytes = static_cast<size_t>(::sysconf(_SC_PHYS_PAGES)) * page_size;
+  }
+  const size_t reserved = ((reserve_bytes + granularity - 1) / granularity) * granularity;
+
+  void* base = ::mmap(nullptr, reserved, PROT_NONE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (base == MAP_FAILED) {
+    UMPIRE_ERROR("mmap( bytes = " << reserved << " ) failed: " << std::strerror(errno));
+  }
+
+  initialize(static_cast<char*>(base), reserved, granularity);
+
+  UMPIRE_LOG(Debug, "reserved " << reserved << " bytes at " << base
+      << " with granularity " << granularity);
+}
+
+HostVirtualPool::~HostVirtualPool()
+{
+  ::munmap(m_base, m_reserved);
+}
+
+Platform
+HostVirtualPool::getPlatform()
+{
+  return Platform::cpu;
+}
+
+resource::MemoryResourceType
+HostVirtualPool::getResourceType()
+{
+  return resource::Host;
+}
+
+void
+HostVirtualPool::commit(size_t first, size_t count)
+{
+  if (::mprotect(granuleAddress(first), count * m_granularity, PROT_READ | PROT_WRITE) != 0) {
+    UMPIRE_ERROR("mprotect( bytes = " << count * m_granularity << " ) failed: " << std::strerror(errno));
+  }
+}
+
+void
+HostVirtualPool::decommit(size_t first, size_t count)
+{
+  char* ptr = granuleAddress(first);
+  const size_t bytes = count * m_granularity;
+
+  // The pages are dropped but stay reserved, so the addresses are kept.
+  ::madvise(ptr, bytes, MADV_DONTNEED);
+
+  if (::mprotect(ptr, bytes, PROT_NONE) != 0) {
+    UMPIRE_ERROR("mprotect( bytes = " << bytes << " ) failed: " << std::strerror(errno));
+  }
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
@@ -0,0 +1,75 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_HostVirtualPool_HPP
+#define UMPIRE_HostVirtualPool_HPP
+
+#include "umpire/strategy/VirtualPool.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Host pool that grows inside one reserved range of virtual
+ * addresses.
+ *
+ * The range is reserved with an inaccessible mmap, and granules are made
+ * usable with mprotect as blocks first cover them. release and trim return
+ * unused granules to the operating system with MADV_DONTNEED and make them
+ * inaccessible again, but never unmap them, so addresses stay stable and
+ * large arrays can keep growing in place. See VirtualPool for how blocks
+ * are placed.
+ *
+ * \code
+ *
+ * auto pool = rm.makeAllocator<umpire::strategy::HostVirtualPool>(
+ *   "host_vm_pool", 64ul*1024*1024*1024);
+ *
+ * \endcode
+ */
+class HostVirtualPool : public VirtualPool
+{
+  public:
+    /*!
+     * \brief Construct a new HostVirtualPool.
+     *
+     * \param name Name of this instance of the HostVirtualPool.
+     * \param id Id of this instance of the HostVirtualPool.
+     * \param reserve_bytes Size of the address range to reserve. The
+     *        default of 0 reserves the size of physical memory.
+     * \param granularity Bytes committed or decommitted at a time, rounded
+     *        up to a multiple of the page size. The default of 0 uses 2MB,
+     *        so transparent huge pages can back each granule.
+     */
+    HostVirtualPool(
+        const std::string& name,
+        int id,
+        size_t reserve_bytes = 0,
+        size_t granularity = 0);
+
+    ~HostVirtualPool();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+  protected:
+    void commit(size_t first, size_t count);
+    void decommit(size_t first, size_t count);
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_HostVirtualPool_HPP
@@ -0,0 +1,144 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/LifetimePool.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace strategy {
+
+LifetimePool::LifetimePool(
+    const std::string& name,
+    int id,
+    Allocator temporary,
+    Allocator long_lived,
+    Allocator persistent) :
+  AllocationStrategy(name, id),
+  m_allocators{
+    temporary.getAllocationStrategy(),
+    long_lived.getAllocationStrategy(),
+    persistent.getAllocationStrategy()},
+  m_current_size(0),
+  m_highwatermark(0)
+{
+  for (auto& allocator : m_allocators) {
+    if (allocator->getPlatform() != m_allocators[0]->getPlatform()) {
+      UMPIRE_ERROR("LifetimePool " << name << " Allocators " << m_allocators[0]->getName()
+          << " and " << allocator->getName() << " are on different platforms");
+    }
+  }
+}
+
+void*
+LifetimePool::allocate(size_t bytes)
+{
+  return allocateWithLifetime(bytes, Lifetime::long_lived);
+}
+
+void*
+LifetimePool::allocateWithLifetime(size_t bytes, Lifetime lifetime)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ", lifetime=" << static_cast<int>(lifetime) << ")");
+
+  void* ptr = nullptr;
+  {
+    // Keep the inner record, it says which Allocator to free ptr with
+    OwnerScope unclaimed(nullptr);
+    ptr = m_allocators[static_cast<int>(lifetime)]->allocate(bytes);
+  }
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ptr;
+}
+
+void
+LifetimePool::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+LifetimePool::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  // The record underneath belongs to the Allocator that served ptr.
+  ResourceManager::getInstance().deallocate(ptr);
+  util::decreaseSize(m_current_size, record.m_size);
+}
+
+void
+LifetimePool::release()
+{
+  for (auto& allocator : m_allocators) {
+    allocator->release();
+  }
+}
+
+void
+LifetimePool::release(Lifetime lifetime)
+{
+  m_allocators[static_cast<int>(lifetime)]->release();
+}
+
+void
+LifetimePool::coalesce()
+{
+  for (auto& allocator : m_allocators) {
+    allocator->coalesce();
+  }
+}
+
+long
+LifetimePool::getCurrentSize()
+{
+  return m_current_size.load(std::memory_order_relaxed);
+}
+
+long
+LifetimePool::getHighWatermark()
+{
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+long
+LifetimePool::getActualSize()
+{
+  long actual_size = 0;
+  for (auto& allocator : m_allocators) {
+    actual_size += allocator->getActualSize();
+  }
+
+  return actual_size;
+}
+
+Platform
+LifetimePool::getPlatform()
+{
+  return m_allocators[0]->getPlatform();
+}
+
+resource::MemoryResourceType
+LifetimePool::getResourceType()
+{
+  return m_allocators[0]->getResourceType();
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
@@ -0,0 +1,90 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_LifetimePool_HPP
+#define UMPIRE_LifetimePool_HPP
+
+#include <atomic>
+#include <memory>
+
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+#include "umpire/Allocator.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Keep allocations of different lifetimes in separate Allocators.
+ *
+ * When long-lived allocations share a pool with temporary ones, each
+ * long-lived block can pin a chunk that would otherwise be freed once the
+ * temporaries are gone. A LifetimePool sends allocations made with
+ * Allocator::allocate(bytes, lifetime) to the Allocator given for that
+ * Lifetime, usually a DynamicPool each, so the temporary pool empties
+ * completely and can be released or trimmed as a whole. Allocations made
+ * without a lifetime are treated as long_lived.
+ *
+ * Like AllocationAdvisor, the LifetimePool registers each allocation on
+ * top of the record of the Allocator that served it.
+ */
+class LifetimePool : public AllocationStrategy
+{
+  public:
+    LifetimePool(
+        const std::string& name,
+        int id,
+        Allocator temporary,
+        Allocator long_lived,
+        Allocator persistent);
+
+    void* allocate(size_t bytes);
+    void* allocateWithLifetime(size_t bytes, Lifetime lifetime);
+
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    /*!
+     * \brief Release every Allocator, or only the one for lifetime.
+     */
+    void release();
+    void release(Lifetime lifetime);
+
+    void coalesce();
+
+    long getCurrentSize();
+    long getHighWatermark();
+
+    /*!
+     * \brief Return the sum of the actual sizes of the three Allocators.
+     */
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+  private:
+    static const int s_num_lifetimes = 3;
+
+    std::shared_ptr<AllocationStrategy> m_allocators[s_num_lifetimes];
+
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_LifetimePool_HPP
@@ -0,0 +1,155 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/MixedPool.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+#include <algorithm>
+
+namespace umpire {
+namespace strategy {
+
+MixedPool::MixedPool(
+    const std::string& name,
+    int id,
+    const std::vector<std::size_t>& thresholds,
+    const std::vector<Allocator>& allocators) :
+  AllocationStrategy(name, id),
+  m_thresholds(thresholds),
+  m_allocators(),
+  m_current_size(0),
+  m_highwatermark(0)
+{
+  if (allocators.size() != thresholds.size() + 1) {
+    UMPIRE_ERROR("MixedPool " << name << " needs one more Allocator than thresholds, got "
+        << allocators.size() << " Allocators and " << thresholds.size() << " thresholds");
+  }
+
+  if (!std::is_sorted(thresholds.begin(), thresholds.end())) {
+    UMPIRE_ERROR("MixedPool " << name << " thresholds must be in ascending order");
+  }
+
+  for (auto allocator : allocators) {
+    m_allocators.push_back(allocator.getAllocationStrategy());
+
+    if (m_allocators.back()->getPlatform() != m_allocators.front()->getPlatform()) {
+      UMPIRE_ERROR("MixedPool " << name << " Allocators " << m_allocators.front()->getName()
+          << " and " << m_allocators.back()->getName() << " are on different platforms");
+    }
+  }
+}
+
+AllocationStrategy*
+MixedPool::route(size_t bytes)
+{
+  const auto threshold = std::lower_bound(m_thresholds.begin(), m_thresholds.end(), bytes);
+  return m_allocators[threshold - m_thresholds.begin()].get();
+}
+
+void*
+MixedPool::allocate(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  void* ptr = route(bytes)->allocateUntracked(bytes);
+
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ptr;
+}
+
+void
+MixedPool::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+MixedPool::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  route(record.m_size)->deallocateUntracked(ptr, record.m_size);
+  util::decreaseSize(m_current_size, record.m_size);
+}
+
+void
+MixedPool::coalesce()
+{
+  for (auto& allocator : m_allocators) {
+    allocator->coalesce();
+  }
+}
+
+void
+MixedPool::release()
+{
+  for (auto& allocator : m_allocators) {
+    allocator->release();
+  }
+}
+
+long
+MixedPool::getCurrentSize()
+{
+  return m_current_size.load(std::memory_order_relaxed);
+}
+
+long
+MixedPool::getHighWatermark()
+{
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+long
+MixedPool::getActualSize()
+{
+  long actual_size = 0;
+  for (auto& allocator : m_allocators) {
+    actual_size += allocator->getActualSize();
+  }
+
+  return actual_size;
+}
+
+Platform
+MixedPool::getPlatform()
+{
+  return m_allocators.front()->getPlatform();
+}
+
+resource::MemoryResourceType
+MixedPool::getResourceType()
+{
+  return m_allocators.front()->getResourceType();
+}
+
+bool
+MixedPool::isThreadSafe()
+{
+  for (auto& allocator : m_allocators) {
+    if (!allocator->isThreadSafe()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
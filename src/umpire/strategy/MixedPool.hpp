@@ -0,0 +1,90 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_MixedPool_HPP
+#define UMPIRE_MixedPool_HPP
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+#include "umpire/Allocator.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Route each allocation to one of several Allocators by its size.
+ *
+ * No single strategy suits every size: fixed and size-class pools are best
+ * for tiny blocks, a DynamicPool for medium ones, and very large blocks are
+ * best taken straight from the resource. A MixedPool is given ascending
+ * size thresholds and one more Allocator than thresholds. A request of
+ * bytes goes to the first Allocator whose threshold is at least bytes, and
+ * anything larger than the last threshold goes to the last Allocator.
+ *
+ * Blocks are taken from the children with allocateUntracked, so only the
+ * MixedPool's record is entered in the AllocationMap for strategies that
+ * support it. Deallocation routes on the recorded size, without looking up
+ * which child owns the address.
+ */
+class MixedPool : public AllocationStrategy
+{
+  public:
+    MixedPool(
+        const std::string& name,
+        int id,
+        const std::vector<std::size_t>& thresholds,
+        const std::vector<Allocator>& allocators);
+
+    void* allocate(size_t bytes);
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    void coalesce();
+    void release();
+
+    long getCurrentSize();
+    long getHighWatermark();
+
+    /*!
+     * \brief Return the sum of the actual sizes of the child Allocators.
+     */
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+    bool isThreadSafe();
+
+  private:
+    /*!
+     * \brief Return the child that serves requests of bytes.
+     */
+    AllocationStrategy* route(size_t bytes);
+
+    std::vector<std::size_t> m_thresholds;
+    std::vector<std::shared_ptr<AllocationStrategy> > m_allocators;
+
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_MixedPool_HPP
@@ -31,22 +31,46 @@ MonotonicAllocationStrategy::MonotonicAllocationStrategy(
   m_capacity(capacity),
   m_allocator(allocator.getAllocationStrategy())
 {
-  m_block = m_allocator->allocate(m_capacity);
+  m_block = m_allocator->allocateUntracked(m_capacity);
 }
 
 void* 
 MonotonicAllocationStrategy::allocate(size_t bytes)
 {
-  void* ret = static_cast<char*>(m_block) + bytes;
-  m_size += bytes;
+  const size_t size = m_size.load(std::memory_order_relaxed);
 
-  if (m_size > m_capacity) {
-    UMPIRE_ERROR("MonoticAllocationStrategy capacity exceeded " << m_size << " > " << m_capacity);
+  if (size + bytes > m_capacity) {
+    UMPIRE_ERROR("MonoticAllocationStrategy capacity exceeded " << size + bytes << " > " << m_capacity);
   }
 
+  void* ret = static_cast<char*>(m_block) + size;
+  m_size.store(size + bytes, std::memory_order_relaxed);
+
   UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ret);
 
-  ResourceManager::getInstance().registerAllocation(ret, new util::AllocationRecord{ret, bytes, this->shared_from_this()});
+  ResourceManager::getInstance().registerAllocation(ret, {ret, bytes, this});
+
+  return ret;
+}
+
+void*
+MonotonicAllocationStrategy::allocateAligned(size_t bytes, size_t alignment)
+{
+  const uintptr_t start = reinterpret_cast<uintptr_t>(m_block);
+  const uintptr_t mask = alignment - 1;
+  const size_t offset =
+    ((start + m_size.load(std::memory_order_relaxed) + mask) & ~mask) - start;
+
+  if (offset + bytes > m_capacity) {
+    UMPIRE_ERROR("MonoticAllocationStrategy capacity exceeded " << offset + bytes << " > " << m_capacity);
+  }
+
+  void* ret = static_cast<char*>(m_block) + offset;
+  m_size.store(offset + bytes, std::memory_order_relaxed);
+
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ", alignment=" << alignment << ") returning " << ret);
+
+  ResourceManager::getInstance().registerAllocation(ret, {ret, bytes, this});
 
   return ret;
 }
@@ -60,11 +84,17 @@ MonotonicAllocationStrategy::deallocate(void* ptr)
   ResourceManager::getInstance().deregisterAllocation(ptr);
 }
 
+void
+MonotonicAllocationStrategy::deallocateRecord(void* UMPIRE_UNUSED_ARG(ptr), const util::AllocationRecord& UMPIRE_UNUSED_ARG(record))
+{
+  UMPIRE_LOG(Info, "() doesn't do anything");
+}
+
 long 
 MonotonicAllocationStrategy::getCurrentSize()
 {
   UMPIRE_LOG(Debug, "() returning " << m_size);
-  return m_size;
+  return m_size.load(std::memory_order_relaxed);
 }
 
 long 
@@ -80,5 +110,11 @@ MonotonicAllocationStrategy::getPlatform()
   return m_allocator->getPlatform();
 }
 
+resource::MemoryResourceType
+MonotonicAllocationStrategy::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
 } // end of namespace strategy
 } // end of namespace umpire
@@ -15,6 +15,7 @@
 #ifndef UMPIRE_MonotonicAllocationStrategy_HPP
 #define UMPIRE_MonotonicAllocationStrategy_HPP
 
+#include <atomic>
 #include <vector>
 
 #include "umpire/strategy/AllocationStrategy.hpp"
@@ -36,7 +37,9 @@ class MonotonicAllocationStrategy :
         Allocator allocator);
 
     void* allocate(size_t bytes);
+    void* allocateAligned(size_t bytes, size_t alignment);
     void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
 
     size_t getSize(void* ptr);
 
@@ -45,10 +48,13 @@ class MonotonicAllocationStrategy :
 
     Platform getPlatform();
 
+    resource::MemoryResourceType getResourceType();
+
   private:
     void* m_block;
 
-    size_t m_size;
+    // Atomic only so that statistics can be read from other threads.
+    std::atomic<size_t> m_size;
     size_t m_capacity;
 
     std::shared_ptr<AllocationStrategy> m_allocator;
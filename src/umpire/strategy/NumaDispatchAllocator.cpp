@@ -0,0 +1,177 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/NumaDispatchAllocator.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+#include <numa.h>
+#include <sched.h>
+
+namespace umpire {
+namespace strategy {
+
+NumaDispatchAllocator::NumaDispatchAllocator(
+    const std::string& name,
+    int id,
+    const std::vector<Allocator>& allocators) :
+  AllocationStrategy(name, id),
+  m_allocators(),
+  m_cpu_nodes(),
+  m_current_size(0),
+  m_highwatermark(0)
+{
+  if (allocators.empty()) {
+    UMPIRE_ERROR("NumaDispatchAllocator " << name << " needs at least one Allocator");
+  }
+
+  for (auto allocator : allocators) {
+    m_allocators.push_back(allocator.getAllocationStrategy());
+
+    if (m_allocators.back()->getPlatform() != Platform::cpu) {
+      UMPIRE_ERROR("NumaDispatchAllocator " << name << " Allocator "
+          << m_allocators.back()->getName() << " is not host memory");
+    }
+  }
+
+  /*
+   * Look up each CPU's node once, so that dispatching only costs a
+   * sched_getcpu.
+   */
+  if (::numa_available() != -1) {
+    const int cpus = ::numa_num_configured_cpus();
+    for (int cpu = 0; cpu < cpus; ++cpu) {
+      const int node = ::numa_node_of_cpu(cpu);
+      m_cpu_nodes.push_back(
+          (node >= 0 && node < static_cast<int>(m_allocators.size())) ? node : 0);
+    }
+  }
+}
+
+int
+NumaDispatchAllocator::getLocalIndex()
+{
+  const int cpu = ::sched_getcpu();
+
+  if (cpu < 0 || cpu >= static_cast<int>(m_cpu_nodes.size())) {
+    return 0;
+  }
+
+  return m_cpu_nodes[cpu];
+}
+
+void*
+NumaDispatchAllocator::allocate(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  const int index = getLocalIndex();
+
+  char* block = static_cast<char*>(
+      m_allocators[index]->allocateUntracked(bytes + s_header_size));
+  *reinterpret_cast<int*>(block) = index;
+
+  void* ptr = block + s_header_size;
+
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ptr;
+}
+
+void
+NumaDispatchAllocator::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+NumaDispatchAllocator::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  char* block = static_cast<char*>(ptr) - s_header_size;
+  const int index = *reinterpret_cast<int*>(block);
+
+  m_allocators[index]->deallocateUntracked(block, record.m_size + s_header_size);
+  util::decreaseSize(m_current_size, record.m_size);
+}
+
+void
+NumaDispatchAllocator::coalesce()
+{
+  for (auto& allocator : m_allocators) {
+    allocator->coalesce();
+  }
+}
+
+void
+NumaDispatchAllocator::release()
+{
+  for (auto& allocator : m_allocators) {
+    allocator->release();
+  }
+}
+
+long
+NumaDispatchAllocator::getCurrentSize()
+{
+  return m_current_size.load(std::memory_order_relaxed);
+}
+
+long
+NumaDispatchAllocator::getHighWatermark()
+{
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+long
+NumaDispatchAllocator::getActualSize()
+{
+  long actual_size = 0;
+  for (auto& allocator : m_allocators) {
+    actual_size += allocator->getActualSize();
+  }
+
+  return actual_size;
+}
+
+Platform
+NumaDispatchAllocator::getPlatform()
+{
+  return Platform::cpu;
+}
+
+resource::MemoryResourceType
+NumaDispatchAllocator::getResourceType()
+{
+  return m_allocators.front()->getResourceType();
+}
+
+bool
+NumaDispatchAllocator::isThreadSafe()
+{
+  for (auto& allocator : m_allocators) {
+    if (!allocator->isThreadSafe()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_NumaDispatchAllocator_HPP
+#define UMPIRE_NumaDispatchAllocator_HPP
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+#include "umpire/Allocator.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Send each allocation to the pool for the NUMA node that the
+ * calling thread is running on.
+ *
+ * The NumaDispatchAllocator is given one Allocator per NUMA node, where the
+ * Allocator at index n should take its memory from HOST_NUMAn. Each
+ * allocation asks the kernel which CPU the thread is on (sched_getcpu) and
+ * takes the block from that CPU's node, so threads that allocate their own
+ * data get node-local memory without naming a node. Threads on a node
+ * without an Allocator use the first one.
+ *
+ * Blocks are taken from the children with allocateUntracked, 16 bytes
+ * larger than requested, and the owning child is stored in those first 16
+ * bytes. Memory can be freed from any thread and goes back to the child
+ * that allocated it. Returned blocks are aligned to 16 bytes.
+ *
+ * Threads on the same node share a child, so for OpenMP code the children
+ * should be thread-safe, e.g. a ThreadSafeAllocator around a DynamicPool.
+ *
+ * \code
+ *
+ * std::vector<umpire::Allocator> pools;
+ * for (int node : umpire::alloc::NumaAllocator::getNodes()) {
+ *   pools.push_back(rm.makeAllocator<umpire::strategy::ThreadSafeAllocator>(
+ *     "safe_pool_" + std::to_string(node),
+ *     rm.makeAllocator<umpire::strategy::DynamicPool>(
+ *       "pool_" + std::to_string(node),
+ *       rm.getAllocator("HOST_NUMA" + std::to_string(node)))));
+ * }
+ *
+ * auto local = rm.makeAllocator<umpire::strategy::NumaDispatchAllocator>(
+ *   "numa_local", pools);
+ *
+ * \endcode
+ */
+class NumaDispatchAllocator : public AllocationStrategy
+{
+  public:
+    NumaDispatchAllocator(
+        const std::string& name,
+        int id,
+        const std::vector<Allocator>& allocators);
+
+    void* allocate(size_t bytes);
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    void coalesce();
+    void release();
+
+    long getCurrentSize();
+    long getHighWatermark();
+
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+    bool isThreadSafe();
+
+    /*!
+     * \brief Return the index of the Allocator that an allocation from the
+     * calling thread would use right now.
+     */
+    int getLocalIndex();
+
+    static const std::size_t s_header_size = 16;
+
+  private:
+    std::vector<std::shared_ptr<AllocationStrategy> > m_allocators;
+    std::vector<int> m_cpu_nodes;
+
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_NumaDispatchAllocator_HPP
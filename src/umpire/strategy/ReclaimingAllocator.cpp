@@ -0,0 +1,276 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/ReclaimingAllocator.hpp"
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace strategy {
+
+ReclaimingAllocator::ReclaimingAllocator(
+    const std::string& name,
+    int id,
+    Allocator allocator,
+    size_t threshold) :
+  AllocationStrategy(name, id),
+  m_allocator(allocator.getAllocationStrategy()),
+  m_allocator_is_thread_safe(m_allocator->isThreadSafe()),
+  m_threshold(threshold),
+  m_current_size(0),
+  m_highwatermark(0),
+  m_num_reclaimed(0),
+  m_allocator_mutex(),
+  m_mutex(),
+  m_wake(),
+  m_idle(),
+  m_pending(),
+  m_busy(false),
+  m_stop(false),
+  m_thread()
+{
+  m_thread = std::thread(&ReclaimingAllocator::run, this);
+}
+
+ReclaimingAllocator::~ReclaimingAllocator()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+
+  // The thread empties the queue before it exits
+  m_wake.notify_one();
+  m_thread.join();
+}
+
+void
+ReclaimingAllocator::run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  for (;;) {
+    m_wake.wait(lock, [this] () { return m_stop || !m_pending.empty(); });
+
+    if (m_pending.empty()) {
+      return;
+    }
+
+    Pending pending = m_pending.front();
+    m_pending.pop_front();
+    m_busy = true;
+    lock.unlock();
+
+    try {
+      if (m_allocator_is_thread_safe) {
+        m_allocator->deallocateRecord(pending.ptr, pending.record);
+      } else {
+        std::lock_guard<std::mutex> allocator_lock(m_allocator_mutex);
+        m_allocator->deallocateRecord(pending.ptr, pending.record);
+      }
+    } catch (util::Exception& e) {
+      UMPIRE_LOG(Error, "Freeing " << pending.ptr << " failed: " << e.what());
+    }
+
+    lock.lock();
+    m_busy = false;
+    if (m_pending.empty()) {
+      m_idle.notify_all();
+    }
+  }
+}
+
+void
+ReclaimingAllocator::flush()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_idle.wait(lock, [this] () { return m_pending.empty() && !m_busy; });
+}
+
+void*
+ReclaimingAllocator::allocate(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+  OwnerScope scope(this, bytes);
+  void* ptr;
+
+  if (m_allocator_is_thread_safe) {
+    ptr = m_allocator->allocate(bytes);
+  } else {
+    std::lock_guard<std::mutex> lock(m_allocator_mutex);
+    ptr = m_allocator->allocate(bytes);
+  }
+
+  if (!scope.claimed()) {
+    ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+  }
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ptr;
+}
+
+void*
+ReclaimingAllocator::allocateAligned(size_t bytes, size_t alignment)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ", alignment=" << alignment << ")");
+  OwnerScope scope(this, bytes);
+  void* ptr;
+
+  if (m_allocator_is_thread_safe) {
+    ptr = m_allocator->allocateAligned(bytes, alignment);
+  } else {
+    std::lock_guard<std::mutex> lock(m_allocator_mutex);
+    ptr = m_allocator->allocateAligned(bytes, alignment);
+  }
+
+  if (!scope.claimed()) {
+    ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+  }
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ptr;
+}
+
+void*
+ReclaimingAllocator::tryAllocate(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+  OwnerScope scope(this, bytes);
+  void* ptr;
+
+  if (m_allocator_is_thread_safe) {
+    ptr = m_allocator->tryAllocate(bytes);
+  } else {
+    std::lock_guard<std::mutex> lock(m_allocator_mutex);
+    ptr = m_allocator->tryAllocate(bytes);
+  }
+
+  if (ptr) {
+    if (!scope.claimed()) {
+      ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+    }
+    util::increaseSize(m_current_size, m_highwatermark, bytes);
+  }
+
+  return ptr;
+}
+
+void
+ReclaimingAllocator::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+ReclaimingAllocator::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  util::decreaseSize(m_current_size, record.m_size);
+
+  if (record.m_size >= m_threshold) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_pending.push_back(Pending{ptr, record});
+    }
+    ++m_num_reclaimed;
+    m_wake.notify_one();
+  } else if (m_allocator_is_thread_safe) {
+    m_allocator->deallocateRecord(ptr, record);
+  } else {
+    std::lock_guard<std::mutex> lock(m_allocator_mutex);
+    m_allocator->deallocateRecord(ptr, record);
+  }
+}
+
+void
+ReclaimingAllocator::coalesce()
+{
+  flush();
+
+  std::lock_guard<std::mutex> lock(m_allocator_mutex);
+  m_allocator->coalesce();
+}
+
+void
+ReclaimingAllocator::release()
+{
+  flush();
+
+  std::lock_guard<std::mutex> lock(m_allocator_mutex);
+  m_allocator->release();
+}
+
+void
+ReclaimingAllocator::trim(size_t target_bytes)
+{
+  flush();
+
+  std::lock_guard<std::mutex> lock(m_allocator_mutex);
+  m_allocator->trim(target_bytes);
+}
+
+long
+ReclaimingAllocator::getCurrentSize()
+{
+  return m_current_size.load(std::memory_order_relaxed);
+}
+
+long
+ReclaimingAllocator::getHighWatermark()
+{
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+long
+ReclaimingAllocator::getActualSize()
+{
+  return m_allocator->getActualSize();
+}
+
+Platform
+ReclaimingAllocator::getPlatform()
+{
+  return m_allocator->getPlatform();
+}
+
+resource::MemoryResourceType
+ReclaimingAllocator::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+bool
+ReclaimingAllocator::isThreadSafe()
+{
+  // Calls to a strategy that is not thread safe are made under a lock
+  return true;
+}
+
+size_t
+ReclaimingAllocator::getThreshold()
+{
+  return m_threshold;
+}
+
+size_t
+ReclaimingAllocator::getNumReclaimed()
+{
+  return m_num_reclaimed.load(std::memory_order_relaxed);
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
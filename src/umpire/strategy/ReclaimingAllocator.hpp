@@ -0,0 +1,141 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_ReclaimingAllocator_HPP
+#define UMPIRE_ReclaimingAllocator_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "umpire/Allocator.hpp"
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Free large allocations from a background thread.
+ *
+ * Freeing a multi-gigabyte HOST block unmaps it and freeing a PINNED block
+ * unpins it, both of which can take milliseconds. Deallocations of at least
+ * threshold bytes are queued for a reclaim thread instead, and return at
+ * once; smaller ones are passed straight through:
+ *
+ * \code
+ * auto host = rm.makeAllocator<umpire::strategy::ReclaimingAllocator>(
+ *     "HOST_RECLAIMING", rm.getAllocator("HOST"));
+ * \endcode
+ *
+ * The allocation is removed from the AllocationMap and from getCurrentSize
+ * right away, but stays in the wrapped allocator, and so in getActualSize,
+ * until the thread has freed it. Calls to a wrapped strategy that is not
+ * thread safe are serialized with a mutex. Destroying the allocator, and
+ * release and trim, wait for the queued frees first.
+ */
+class ReclaimingAllocator :
+  public AllocationStrategy
+{
+  public:
+    /*!
+     * \brief Construct a new ReclaimingAllocator.
+     *
+     * \param name Name of this instance of the ReclaimingAllocator.
+     * \param id Id of this instance of the ReclaimingAllocator.
+     * \param allocator Allocator to allocate from and free to.
+     * \param threshold Size in bytes from which deallocations are handed to
+     *        the reclaim thread.
+     */
+    ReclaimingAllocator(
+        const std::string& name,
+        int id,
+        Allocator allocator,
+        size_t threshold = (64 * 1024 * 1024));
+
+    ~ReclaimingAllocator();
+
+    void* allocate(size_t bytes);
+    void* allocateAligned(size_t bytes, size_t alignment);
+    void* tryAllocate(size_t bytes);
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    void coalesce();
+    void release();
+    void trim(size_t target_bytes);
+
+    long getCurrentSize();
+    long getHighWatermark();
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+    bool isThreadSafe();
+
+    size_t getThreshold();
+
+    /*!
+     * \brief Return the number of deallocations handed to the reclaim
+     * thread so far.
+     */
+    size_t getNumReclaimed();
+
+    /*!
+     * \brief Wait until the reclaim thread has freed every queued
+     * allocation.
+     */
+    void flush();
+
+    ReclaimingAllocator(const ReclaimingAllocator&) = delete;
+    ReclaimingAllocator& operator=(const ReclaimingAllocator&) = delete;
+
+  private:
+    struct Pending {
+      void* ptr;
+      util::AllocationRecord record;
+    };
+
+    void run();
+
+    std::shared_ptr<AllocationStrategy> m_allocator;
+    const bool m_allocator_is_thread_safe;
+    const size_t m_threshold;
+
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
+    std::atomic<size_t> m_num_reclaimed;
+
+    // Serializes calls to a wrapped strategy that is not thread safe.
+    std::mutex m_allocator_mutex;
+
+    // Guards m_pending, m_busy and m_stop.
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::deque<Pending> m_pending;
+    bool m_busy;
+    bool m_stop;
+
+    std::thread m_thread;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_ReclaimingAllocator_HPP
@@ -0,0 +1,218 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/SizeClassPool.hpp"
+
+#include <algorithm>
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace strategy {
+
+namespace {
+
+// 16, 24, 32, 48, ... 49152, 65536: each power of two and the point half
+// way to the next one.
+const std::size_t s_class_sizes[] = {
+  16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536,
+  2048, 3072, 4096, 6144, 8192, 12288, 16384, 24576, 32768, 49152, 65536
+};
+
+} // end of anonymous namespace
+
+SizeClassPool::SizeClassPool(
+    const std::string& name,
+    int id,
+    Allocator allocator,
+    const std::size_t slab_size) :
+  AllocationStrategy(name, id),
+  m_slabs(),
+  m_slab_size(slab_size > s_max_class_size ? slab_size : s_max_class_size),
+  m_current_size(0),
+  m_highwatermark(0),
+  m_actual_size(0),
+  m_allocator(allocator.getAllocationStrategy())
+{
+}
+
+SizeClassPool::~SizeClassPool()
+{
+  auto& rm = ResourceManager::getInstance();
+
+  // Blocks still in use would otherwise be left pointing at freed memory.
+  for (auto slab : m_slabs) {
+    rm.deregisterAllocationRange(slab, static_cast<char*>(slab) + m_slab_size, this);
+    m_allocator->deallocateUntracked(slab, m_slab_size);
+  }
+}
+
+void*
+SizeClassPool::allocate(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  void* ret = allocateBlock(bytes);
+
+  ResourceManager::getInstance().registerAllocation(ret, {ret, bytes, this});
+
+  return ret;
+}
+
+void
+SizeClassPool::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+SizeClassPool::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  deallocateBlock(ptr, record.m_size);
+}
+
+void*
+SizeClassPool::allocateUntracked(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  return allocateBlock(bytes);
+}
+
+void
+SizeClassPool::deallocateUntracked(void* ptr)
+{
+  UMPIRE_ERROR("Cannot free untracked memory " << ptr << " from " << getName() << " without its size");
+}
+
+void
+SizeClassPool::deallocateUntracked(void* ptr, size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", bytes=" << bytes << ")");
+
+  deallocateBlock(ptr, bytes);
+}
+
+long
+SizeClassPool::getCurrentSize()
+{
+  UMPIRE_LOG(Debug, "() returning " << m_current_size);
+  return m_current_size.load(std::memory_order_relaxed);
+}
+
+long
+SizeClassPool::getHighWatermark()
+{
+  UMPIRE_LOG(Debug, "() returning " << m_highwatermark);
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+long
+SizeClassPool::getActualSize()
+{
+  UMPIRE_LOG(Debug, "() returning " << m_actual_size);
+  return m_actual_size.load(std::memory_order_relaxed);
+}
+
+Platform
+SizeClassPool::getPlatform()
+{
+  return m_allocator->getPlatform();
+}
+
+resource::MemoryResourceType
+SizeClassPool::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+int
+SizeClassPool::getSizeClass(std::size_t bytes)
+{
+  return static_cast<int>(
+      std::lower_bound(s_class_sizes, s_class_sizes + s_num_size_classes, bytes)
+      - s_class_sizes);
+}
+
+std::size_t
+SizeClassPool::getClassSize(int size_class)
+{
+  return s_class_sizes[size_class];
+}
+
+void*
+SizeClassPool::allocateBlock(size_t bytes)
+{
+  void* ret = nullptr;
+
+  if (bytes <= s_max_class_size) {
+    const int size_class = getSizeClass(bytes);
+    std::vector<void*>& free_blocks = m_free_blocks[size_class];
+
+    if (free_blocks.empty()) {
+      newSlab(size_class);
+    }
+
+    ret = free_blocks.back();
+    free_blocks.pop_back();
+  } else {
+    ret = m_allocator->allocateUntracked(bytes);
+    m_actual_size.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ret;
+}
+
+void
+SizeClassPool::deallocateBlock(void* ptr, size_t bytes)
+{
+  util::decreaseSize(m_current_size, bytes);
+
+  if (bytes <= s_max_class_size) {
+    m_free_blocks[getSizeClass(bytes)].push_back(ptr);
+  } else {
+    m_allocator->deallocateUntracked(ptr, bytes);
+    m_actual_size.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+}
+
+void
+SizeClassPool::newSlab(int size_class)
+{
+  const std::size_t class_size = getClassSize(size_class);
+  const std::size_t num_blocks = m_slab_size / class_size;
+
+  UMPIRE_LOG(Debug, "(size_class=" << size_class << ", num_blocks=" << num_blocks << ")");
+
+  char* slab = static_cast<char*>(m_allocator->allocateUntracked(m_slab_size));
+  m_slabs.push_back(slab);
+  m_actual_size.fetch_add(m_slab_size, std::memory_order_relaxed);
+
+  std::vector<void*>& free_blocks = m_free_blocks[size_class];
+  free_blocks.reserve(free_blocks.size() + num_blocks);
+
+  // Push in reverse so blocks are handed out in address order.
+  for (std::size_t i = num_blocks; i > 0; --i) {
+    free_blocks.push_back(slab + (i-1)*class_size);
+  }
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
@@ -0,0 +1,108 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_SizeClassPool_HPP
+#define UMPIRE_SizeClassPool_HPP
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+#include "umpire/Allocator.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Pool small allocations in segregated size classes.
+ *
+ * Requests up to s_max_class_size bytes are rounded up to one of a set of
+ * geometric size classes (two per power of two, from 16B to 64KiB), so no
+ * more than a third of a block is wasted. Each class carves slabs of
+ * slab_size bytes from the backing Allocator into equal blocks, and
+ * allocation and deallocation just pop and push that class's free list.
+ * Larger requests are forwarded to the backing Allocator.
+ *
+ * Slabs are kept until the pool is destroyed.
+ */
+class SizeClassPool : public AllocationStrategy
+{
+  public:
+    SizeClassPool(
+        const std::string& name,
+        int id,
+        Allocator allocator,
+        const std::size_t slab_size = (1 * 1024 * 1024));
+
+    ~SizeClassPool();
+
+    void* allocate(size_t bytes);
+
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    void* allocateUntracked(size_t bytes);
+
+    /*!
+     * \brief Blocks are freed to their size class, so this throws; use
+     * deallocateUntracked(ptr, bytes).
+     */
+    void deallocateUntracked(void* ptr);
+    void deallocateUntracked(void* ptr, size_t bytes);
+
+    long getCurrentSize();
+    long getHighWatermark();
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+  private:
+    static const std::size_t s_max_class_size = 64 * 1024;
+    static const int s_num_size_classes = 25;
+
+    static int getSizeClass(std::size_t bytes);
+    static std::size_t getClassSize(int size_class);
+
+    /*!
+     * \brief Take a block of bytes without registering it.
+     */
+    void* allocateBlock(size_t bytes);
+
+    /*!
+     * \brief Return a block of bytes taken with allocateBlock.
+     */
+    void deallocateBlock(void* ptr, size_t bytes);
+
+    void newSlab(int size_class);
+
+    std::vector<void*> m_free_blocks[s_num_size_classes];
+    std::vector<void*> m_slabs;
+
+    std::size_t m_slab_size;
+
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
+    std::atomic<long> m_actual_size;
+
+    std::shared_ptr<umpire::strategy::AllocationStrategy> m_allocator;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_SizeClassPool_HPP
@@ -0,0 +1,336 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/SizedFixedPool.hpp"
+
+#include "umpire/ResourceManager.hpp"
+
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+#include <strings.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace umpire {
+namespace strategy {
+
+namespace {
+
+const std::size_t s_bits_per_word = sizeof(unsigned int) * 8;
+
+} // end of anonymous namespace
+
+SizedFixedPool::SizedFixedPool(
+    const std::string& name,
+    int id,
+    Allocator allocator,
+    const std::size_t block_size,
+    const std::size_t alignment,
+    const std::size_t blocks_per_pool) :
+  AllocationStrategy(name, id),
+  m_free_pools(nullptr),
+  m_pools(),
+  m_num_pools(0),
+  m_block_size(block_size),
+  m_alignment(alignment),
+  m_stride((block_size + alignment - 1) / alignment * alignment),
+  m_num_words((blocks_per_pool + s_bits_per_word - 1) / s_bits_per_word),
+  m_num_per_pool(m_num_words * s_bits_per_word),
+  m_data_bytes(m_num_per_pool * m_stride
+      + (alignment > alignof(std::max_align_t) ? alignment : 0)),
+  m_num_blocks(0),
+  m_highwatermark(0),
+  m_current_size(0),
+  m_allocator(allocator.getAllocationStrategy())
+{
+  if (block_size == 0) {
+    UMPIRE_ERROR("SizedFixedPool block_size must be greater than 0");
+  }
+
+  if (alignment == 0 || (alignment & (alignment - 1))) {
+    UMPIRE_ERROR("SizedFixedPool alignment " << alignment << " is not a power of two");
+  }
+
+  if (blocks_per_pool == 0) {
+    UMPIRE_ERROR("SizedFixedPool blocks_per_pool must be greater than 0");
+  }
+
+  newPool();
+}
+
+SizedFixedPool::~SizedFixedPool()
+{
+  for (auto& entry : m_pools) {
+    struct Pool *curr = entry.second;
+    ResourceManager::getInstance().deregisterChunk(curr->data, this);
+    m_allocator->deallocateUntracked(curr->base, m_data_bytes);
+    std::free(curr);
+  }
+}
+
+void
+SizedFixedPool::newPool()
+{
+  struct Pool *p = static_cast<struct Pool *>(std::malloc(
+        recordsOffset() + m_num_per_pool * sizeof(util::AllocationRecord)));
+  if (!p) {
+    UMPIRE_ERROR("Could not allocate the bookkeeping of a " << m_num_per_pool << " block pool");
+  }
+
+  // Pool data is untracked, so over-allocate to align it ourselves.
+  try {
+    p->base = static_cast<unsigned char*>(m_allocator->allocateUntracked(m_data_bytes));
+  } catch (...) {
+    std::free(p);
+    throw;
+  }
+
+  p->data = p->base;
+  if (m_alignment > alignof(std::max_align_t)) {
+    const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(p->base);
+    p->data += (m_alignment - addr % m_alignment) % m_alignment;
+  }
+
+  p->numAvail = m_num_per_pool;
+  p->firstAvail = 0;
+
+  p->avail = reinterpret_cast<unsigned int *>(p + 1);
+  for (std::size_t i = 0; i < m_num_words; i++) p->avail[i] = (~0u);
+
+  p->records = reinterpret_cast<util::AllocationRecord*>(
+      reinterpret_cast<unsigned char*>(p) + recordsOffset());
+  for (std::size_t i = 0; i < m_num_per_pool; i++) {
+    p->records[i] = util::AllocationRecord{nullptr, m_block_size, this};
+  }
+
+  m_pools[p->data] = p;
+  m_num_pools.fetch_add(1, std::memory_order_relaxed);
+
+  ResourceManager::getInstance().registerChunk(p->data, m_num_per_pool * m_stride, this, p);
+
+  p->nextFree = m_free_pools;
+  m_free_pools = p;
+}
+
+void*
+SizedFixedPool::allocInPool(struct Pool *p)
+{
+  // Words before firstAvail are known to be full.
+  for (std::size_t i = p->firstAvail; i < m_num_words; i++) {
+    const int bit = ffs(p->avail[i]) - 1;
+    if (bit >= 0) {
+      p->avail[i] ^= 1u << bit;
+      p->numAvail--;
+      p->firstAvail = i;
+      const std::size_t entry = i * s_bits_per_word + bit;
+      return p->data + entry * m_stride;
+    }
+  }
+
+  UMPIRE_ERROR("Pool with " << p->numAvail << " free blocks has none in its bitmap");
+}
+
+void*
+SizedFixedPool::allocateBlock(bool track)
+{
+  if (!m_free_pools) {
+    newPool();
+  }
+
+  struct Pool *curr = m_free_pools;
+  void* ptr = allocInPool(curr);
+
+  if (track) {
+    curr->records[(static_cast<unsigned char*>(ptr) - curr->data) / m_stride].m_ptr = ptr;
+  }
+
+  if (!curr->numAvail) {
+    m_free_pools = curr->nextFree;
+    curr->nextFree = nullptr;
+  }
+
+  m_num_blocks++;
+  util::increaseSize(m_current_size, m_highwatermark, m_block_size);
+
+  return ptr;
+}
+
+void
+SizedFixedPool::deallocateBlock(void* ptr)
+{
+  const unsigned char* addr = static_cast<const unsigned char*>(ptr);
+
+  // The owning pool is the one with the highest start address <= addr.
+  auto it = m_pools.upper_bound(addr);
+  if (it == m_pools.begin()) {
+    UMPIRE_ERROR("Could not find pointer to deallocate");
+  }
+  --it;
+
+  struct Pool *curr = it->second;
+  const unsigned char* start = curr->data;
+  const unsigned char* end = curr->data + m_num_per_pool * m_stride;
+  if ((addr < start) || (addr >= end)) {
+    UMPIRE_ERROR("Could not find pointer to deallocate");
+  }
+
+  const std::size_t indexD = (addr - start) / m_stride;
+  const std::size_t indexI = indexD / s_bits_per_word;
+  const unsigned int mask = 1u << (indexD % s_bits_per_word);
+
+  if (curr->avail[indexI] & mask) {
+    UMPIRE_ERROR("Block " << ptr << " of " << getName() << " is not allocated");
+  }
+
+  curr->avail[indexI] ^= mask;
+  curr->records[indexD].m_ptr = nullptr;
+
+  if (indexI < curr->firstAvail) {
+    curr->firstAvail = indexI;
+  }
+
+  if (!curr->numAvail) {
+    curr->nextFree = m_free_pools;
+    m_free_pools = curr;
+  }
+  curr->numAvail++;
+
+  m_num_blocks--;
+  util::decreaseSize(m_current_size, m_block_size);
+}
+
+void*
+SizedFixedPool::allocate(size_t bytes)
+{
+  if (bytes > m_block_size) {
+    UMPIRE_ERROR(getName() << " cannot allocate " << bytes << " bytes in blocks of " << m_block_size);
+  }
+
+  return allocateBlock(true);
+}
+
+void*
+SizedFixedPool::allocateAligned(size_t bytes, size_t alignment)
+{
+  if (alignment > m_alignment) {
+    UMPIRE_ERROR(getName() << " blocks are only aligned to " << m_alignment
+        << " bytes, cannot align to " << alignment);
+  }
+
+  return allocate(bytes);
+}
+
+void
+SizedFixedPool::deallocate(void* ptr)
+{
+  deallocateBlock(ptr);
+}
+
+void*
+SizedFixedPool::allocateUntracked(size_t bytes)
+{
+  if (bytes > m_block_size) {
+    UMPIRE_ERROR(getName() << " cannot allocate " << bytes << " bytes in blocks of " << m_block_size);
+  }
+
+  return allocateBlock(false);
+}
+
+void
+SizedFixedPool::deallocateUntracked(void* ptr)
+{
+  deallocateBlock(ptr);
+}
+
+void
+SizedFixedPool::deallocateRecord(void* ptr, const util::AllocationRecord& UMPIRE_UNUSED_ARG(record))
+{
+  // Blocks are found through their pool, not the AllocationMap
+  deallocateBlock(ptr);
+}
+
+util::AllocationRecord*
+SizedFixedPool::findRecord(void* ptr, void* handle)
+{
+  const struct Pool *p = static_cast<const struct Pool *>(handle);
+  const std::size_t index = (static_cast<unsigned char*>(ptr) - p->data) / m_stride;
+
+  util::AllocationRecord* record = &p->records[index];
+
+  // Untracked and free blocks have no record
+  return record->m_ptr ? record : nullptr;
+}
+
+long
+SizedFixedPool::getCurrentSize()
+{
+  return m_current_size.load(std::memory_order_relaxed);
+}
+
+long
+SizedFixedPool::getHighWatermark()
+{
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+long
+SizedFixedPool::getActualSize()
+{
+  return m_num_pools.load(std::memory_order_relaxed) * m_data_bytes;
+}
+
+Platform
+SizedFixedPool::getPlatform()
+{
+  return m_allocator->getPlatform();
+}
+
+resource::MemoryResourceType
+SizedFixedPool::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+size_t
+SizedFixedPool::getNumChunks()
+{
+  return m_num_pools.load(std::memory_order_relaxed);
+}
+
+size_t
+SizedFixedPool::getNumUsedBlocks()
+{
+  return m_num_blocks;
+}
+
+size_t
+SizedFixedPool::getNumFreeBlocks()
+{
+  return getNumChunks() * m_num_per_pool - m_num_blocks;
+}
+
+std::size_t
+SizedFixedPool::recordsOffset() const
+{
+  // The records follow the Pool header and its bitmap
+  const std::size_t offset = sizeof(struct Pool) + m_num_words * sizeof(unsigned int);
+  const std::size_t alignment = alignof(util::AllocationRecord);
+
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
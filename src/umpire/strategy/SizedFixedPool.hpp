@@ -0,0 +1,175 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_SizedFixedPool_HPP
+#define UMPIRE_SizedFixedPool_HPP
+
+#include <atomic>
+#include <map>
+#include <memory>
+
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+#include "umpire/Allocator.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Pool of fixed size blocks, with the block size and the number of
+ * blocks per pool given at run time.
+ *
+ * Works like FixedPool, but the sizes need not be known at compile time.
+ * FixedPool<T> has sizeof(T) byte blocks and NP * 32 blocks in each pool
+ * it takes from the Allocator, so small blocks lead to many small pools.
+ * Here a deployment can choose large pools, for example:
+ *
+ * \code
+ * auto nodes = rm.makeAllocator<umpire::strategy::SizedFixedPool>(
+ *     "tree_nodes", rm.getAllocator("HOST"), 48, 16, 1024 * 1024);
+ * \endcode
+ *
+ * Each pool remembers the first bitmap word that may have a free block,
+ * so large pools do not make allocation scan more of the bitmap.
+ */
+class SizedFixedPool :
+  public AllocationStrategy
+{
+  public:
+    /*!
+     * \brief Construct a new SizedFixedPool.
+     *
+     * \param name Name of this instance of the SizedFixedPool.
+     * \param id Id of this instance of the SizedFixedPool.
+     * \param allocator Allocator to take pools from.
+     * \param block_size Largest allocation, in bytes.
+     * \param alignment Alignment of every block, a power of two. Blocks
+     *        are block_size rounded up to a multiple of it apart.
+     * \param blocks_per_pool Number of blocks in each pool, rounded up to
+     *        a multiple of 32.
+     */
+    SizedFixedPool(
+        const std::string& name,
+        int id,
+        Allocator allocator,
+        const std::size_t block_size,
+        const std::size_t alignment = 16,
+        const std::size_t blocks_per_pool = 2048);
+
+    ~SizedFixedPool();
+
+    void* allocate(size_t bytes);
+
+    /*!
+     * \brief Allocate a block, checking that it meets alignment.
+     */
+    void* allocateAligned(size_t bytes, size_t alignment);
+
+    void deallocate(void* ptr);
+
+    void* allocateUntracked(size_t bytes);
+
+    void deallocateUntracked(void* ptr);
+
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    /*!
+     * \brief Return the record of the block containing ptr.
+     *
+     * As for FixedPool, pools are registered with
+     * ResourceManager::registerChunk and blocks are never entered into the
+     * AllocationMap.
+     */
+    util::AllocationRecord* findRecord(void* ptr, void* handle);
+
+    long getCurrentSize();
+    long getHighWatermark();
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+    /*!
+     * \brief Return the number of pools obtained from the underlying
+     * Allocator.
+     */
+    size_t getNumChunks();
+
+    /*!
+     * \brief Return the number of blocks handed out by the pool.
+     */
+    size_t getNumUsedBlocks();
+
+    /*!
+     * \brief Return the number of free blocks across all pools.
+     */
+    size_t getNumFreeBlocks();
+
+  private:
+    struct Pool
+    {
+      unsigned char *base;
+      unsigned char *data;
+      unsigned int *avail;
+      util::AllocationRecord *records;
+      std::size_t numAvail;
+      std::size_t firstAvail;
+      struct Pool* nextFree;
+    };
+
+    void newPool();
+
+    void* allocInPool(struct Pool *p);
+
+    void* allocateBlock(bool track);
+
+    void deallocateBlock(void* ptr);
+
+    std::size_t recordsOffset() const;
+
+    /*!
+     * \brief Pools with at least one free block, most recently used first.
+     */
+    struct Pool *m_free_pools;
+
+    /*!
+     * \brief All pools, keyed by the start address of their data.
+     */
+    std::map<const unsigned char*, struct Pool*> m_pools;
+
+    /*!
+     * \brief Number of entries in m_pools, readable from any thread.
+     */
+    std::atomic<std::size_t> m_num_pools;
+
+    const std::size_t m_block_size;
+    const std::size_t m_alignment;
+    const std::size_t m_stride;
+    const std::size_t m_num_words;
+    const std::size_t m_num_per_pool;
+    const std::size_t m_data_bytes;
+
+    std::size_t m_num_blocks;
+
+    std::atomic<long> m_highwatermark;
+    std::atomic<long> m_current_size;
+
+    std::shared_ptr<umpire::strategy::AllocationStrategy> m_allocator;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_SizedFixedPool_HPP
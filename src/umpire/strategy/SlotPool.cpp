@@ -15,6 +15,8 @@
 
 #include "umpire/strategy/SlotPool.hpp"
 
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
 #include "umpire/util/Macros.hpp"
 
 namespace umpire {
@@ -26,54 +28,86 @@ SlotPool::SlotPool(
     size_t slots,
     Allocator allocator) :
   AllocationStrategy(name, id),
+  m_slot_storage(slots),
+  m_unused_slots(nullptr),
+  m_cached_by_size(),
+  m_oldest(nullptr),
+  m_newest(nullptr),
   m_current_size(0),
   m_highwatermark(0),
+  m_actual_size(0),
   m_slots(slots),
   m_allocator(allocator.getAllocationStrategy())
 {
   UMPIRE_LOG(Debug, "Creating " << m_slots << "-slot pool.");
 
-  m_lengths = new size_t[m_slots];
-  m_pointers = new void*[m_slots];
-
-  for (size_t i = 0; i < m_slots; ++i) {
-    m_pointers[i] = nullptr;
-    m_lengths[i] = 0;
+  for (auto& slot : m_slot_storage) {
+    slot.lru_next = m_unused_slots;
+    m_unused_slots = &slot;
   }
 }
 
+SlotPool::~SlotPool()
+{
+  release();
+}
+
 void*
 SlotPool::allocate(size_t bytes)
 {
   void* ptr = nullptr;
 
-  for (size_t i = 0; i < m_slots; ++i) {
-     if (m_lengths[i] == bytes) {
-        m_lengths[i] = -m_lengths[i] ;
-        ptr = m_pointers[i] ;
-        break ;
-     } else if (m_lengths[i] == 0) {
-        m_lengths[i] = -static_cast<int>(bytes) ;
-        m_pointers[i] = m_allocator->allocate(bytes);
-        ptr = m_pointers[i] ;
-        break ;
-     }
+  auto cached = m_cached_by_size.find(bytes);
+  if (cached != m_cached_by_size.end()) {
+    Slot* slot = cached->second;
+    ptr = slot->ptr;
+    uncache(slot);
+  } else {
+    ptr = m_allocator->allocateUntracked(bytes);
+    m_actual_size.fetch_add(bytes, std::memory_order_relaxed);
   }
 
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
   UMPIRE_LOG(Debug, "(bytes=" << bytes << ") returning " << ptr);
   return ptr;
 }
 
 void
 SlotPool::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+SlotPool::deallocateRecord(void* ptr, const util::AllocationRecord& record)
 {
   UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
-  for (size_t i = 0; i < m_slots; ++i) {
-    if (m_pointers[i] == ptr) {
-      m_lengths[i] = -m_lengths[i];
-      ptr = nullptr;
-      break;
-    }
+
+  util::decreaseSize(m_current_size, record.m_size);
+
+  if (m_slots == 0) {
+    m_allocator->deallocateUntracked(ptr, record.m_size);
+    m_actual_size.fetch_sub(record.m_size, std::memory_order_relaxed);
+    return;
+  }
+
+  if (!m_unused_slots) {
+    evict(m_oldest);
+  }
+
+  cache(ptr, record.m_size);
+}
+
+void
+SlotPool::release()
+{
+  UMPIRE_LOG(Debug, "()");
+
+  while (m_oldest) {
+    evict(m_oldest);
   }
 }
 
@@ -81,14 +115,21 @@ long
 SlotPool::getCurrentSize()
 {
   UMPIRE_LOG(Debug, "() returning " << m_current_size);
-  return m_current_size;
+  return m_current_size.load(std::memory_order_relaxed);
 }
 
 long 
 SlotPool::getHighWatermark()
 {
   UMPIRE_LOG(Debug, "() returning " << m_highwatermark);
-  return m_highwatermark;
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+long
+SlotPool::getActualSize()
+{
+  UMPIRE_LOG(Debug, "() returning " << m_actual_size);
+  return m_actual_size.load(std::memory_order_relaxed);
 }
 
 Platform
@@ -97,6 +138,66 @@ SlotPool::getPlatform()
   return m_allocator->getPlatform();
 }
 
+resource::MemoryResourceType
+SlotPool::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+void
+SlotPool::cache(void* ptr, size_t bytes)
+{
+  Slot* slot = m_unused_slots;
+  m_unused_slots = slot->lru_next;
+
+  slot->ptr = ptr;
+  slot->bytes = bytes;
+
+  Slot*& head = m_cached_by_size[bytes];
+  slot->size_prev = nullptr;
+  slot->size_next = head;
+  if (head) head->size_prev = slot;
+  head = slot;
+
+  slot->lru_prev = m_newest;
+  slot->lru_next = nullptr;
+  if (m_newest) m_newest->lru_next = slot;
+  else m_oldest = slot;
+  m_newest = slot;
+}
+
+void
+SlotPool::uncache(Slot* slot)
+{
+  if (slot->size_prev) {
+    slot->size_prev->size_next = slot->size_next;
+  } else if (slot->size_next) {
+    m_cached_by_size[slot->bytes] = slot->size_next;
+  } else {
+    m_cached_by_size.erase(slot->bytes);
+  }
+  if (slot->size_next) slot->size_next->size_prev = slot->size_prev;
+
+  if (slot->lru_prev) slot->lru_prev->lru_next = slot->lru_next;
+  else m_oldest = slot->lru_next;
+  if (slot->lru_next) slot->lru_next->lru_prev = slot->lru_prev;
+  else m_newest = slot->lru_prev;
+
+  slot->lru_next = m_unused_slots;
+  m_unused_slots = slot;
+}
+
+void
+SlotPool::evict(Slot* slot)
+{
+  void* ptr = slot->ptr;
+  const size_t bytes = slot->bytes;
+
+  uncache(slot);
+
+  m_allocator->deallocateUntracked(ptr, bytes);
+  m_actual_size.fetch_sub(bytes, std::memory_order_relaxed);
+}
 
 } // end of namespace strategy
 } // end of namespace umpire
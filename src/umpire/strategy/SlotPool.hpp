@@ -15,7 +15,9 @@
 #ifndef UMPIRE_SlotPool_HPP
 #define UMPIRE_SlotPool_HPP
 
+#include <atomic>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "umpire/strategy/AllocationStrategy.hpp"
@@ -24,6 +26,20 @@
 namespace umpire {
 namespace strategy {
 
+/*!
+ * \brief Cache up to a fixed number of freed allocations for reuse by
+ * requests of exactly the same size.
+ *
+ * Freed allocations are kept in slots indexed by size, so a repeated
+ * request for the same number of bytes is served without touching the
+ * backing Allocator. Both allocate and deallocate are O(1). When every slot
+ * is taken, the least recently freed allocation is returned to the backing
+ * Allocator to make room.
+ *
+ * This suits code that repeatedly allocates and frees buffers of a few
+ * fixed sizes on a resource with expensive allocation, such as device
+ * memory.
+ */
 class SlotPool :
   public AllocationStrategy
 {
@@ -34,21 +50,56 @@ class SlotPool :
         size_t slots,
         Allocator allocator);
 
+    ~SlotPool();
+
     void* allocate(size_t bytes);
     void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    /*!
+     * \brief Return every cached allocation to the backing Allocator.
+     */
+    void release();
 
     long getCurrentSize();
     long getHighWatermark();
+    long getActualSize();
 
     Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
   private:
-    void init();
+    struct Slot {
+      void* ptr;
+      size_t bytes;
+
+      // Neighbours among cached allocations of the same size.
+      Slot* size_prev;
+      Slot* size_next;
+
+      // Neighbours in order of release, oldest first.
+      Slot* lru_prev;
+      Slot* lru_next;
+    };
+
+    void cache(void* ptr, size_t bytes);
+    void uncache(Slot* slot);
+    void evict(Slot* slot);
+
+    std::vector<Slot> m_slot_storage;
+    Slot* m_unused_slots;
+
+    /*!
+     * \brief Most recently freed cached allocation of each size.
+     */
+    std::unordered_map<size_t, Slot*> m_cached_by_size;
 
-    void** m_pointers;
-    size_t* m_lengths;
+    Slot* m_oldest;
+    Slot* m_newest;
 
-    long m_current_size;
-    long m_highwatermark;
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
+    std::atomic<long> m_actual_size;
 
     size_t m_slots;
 
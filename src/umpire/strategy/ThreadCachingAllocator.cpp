@@ -0,0 +1,452 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/ThreadCachingAllocator.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+#include "umpire/ResourceManager.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace strategy {
+
+namespace {
+
+std::atomic<unsigned long> s_next_serial(0);
+
+// Guards every ThreadCache::owner and m_caches, so that an exiting thread and
+// a ThreadCachingAllocator being destroyed agree on who drains each cache.
+std::mutex s_caches_mutex;
+
+// Memo of the last cache looked up on this thread. Serials start at 1, so a
+// fresh thread never matches it.
+thread_local unsigned long t_last_serial = 0;
+thread_local void* t_last_cache = nullptr;
+
+// Set once this thread's ThreadCacheTable has been destroyed.
+thread_local bool t_caches_destroyed = false;
+
+} // end of anonymous namespace
+
+struct ThreadCachingAllocator::ThreadCacheTable
+{
+  std::unordered_map<unsigned long, ThreadCache*> caches;
+
+  ~ThreadCacheTable()
+  {
+    t_last_serial = 0;
+    t_last_cache = nullptr;
+    t_caches_destroyed = true;
+
+    std::lock_guard<std::mutex> lock(s_caches_mutex);
+
+    for (auto& entry : caches) {
+      ThreadCache* cache = entry.second;
+
+      if (cache && cache->owner) {
+        std::vector<ThreadCache*>& owner_caches = cache->owner->m_caches;
+        owner_caches.erase(std::find(owner_caches.begin(), owner_caches.end(), cache));
+
+        // Nothing can be thrown out of a thread exiting; keep the blocks.
+        try {
+          cache->owner->drain(cache);
+        } catch (...) {
+        }
+      }
+
+      delete cache;
+    }
+  }
+};
+
+ThreadCachingAllocator::ThreadCachingAllocator(
+    const std::string& name,
+    int id,
+    Allocator allocator) :
+  AllocationStrategy(name, id),
+  m_serial(++s_next_serial),
+  m_current_size(0),
+  m_highwatermark(0),
+  m_actual_size(0),
+  m_caches(),
+  m_aligned_blocks(),
+  m_num_aligned_blocks(0),
+  m_allocator(allocator.getAllocationStrategy()),
+  m_mutex(new std::mutex())
+{
+}
+
+ThreadCachingAllocator::~ThreadCachingAllocator()
+{
+  {
+    std::lock_guard<std::mutex> lock(s_caches_mutex);
+
+    // The threads still holding these caches delete them when they exit.
+    for (auto cache : m_caches) {
+      drain(cache);
+      cache->owner = nullptr;
+    }
+  }
+
+  delete m_mutex;
+}
+
+void*
+ThreadCachingAllocator::allocate(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  void* ret = nullptr;
+  ThreadCache* cache = (bytes <= s_max_cached_size) ? getThreadCache() : nullptr;
+
+  if (cache) {
+    const int size_class = getSizeClass(bytes);
+    std::vector<void*>& bin = cache->bins[size_class];
+
+    if (bin.empty()) {
+      refill(cache, size_class);
+    }
+
+    ret = bin.back();
+    bin.pop_back();
+  } else {
+    const std::size_t block_bytes = getBlockSize(bytes);
+
+    try {
+      UMPIRE_LOCK;
+
+      ret = m_allocator->allocateUntracked(block_bytes);
+      m_actual_size += block_bytes;
+
+      UMPIRE_UNLOCK;
+    } catch (...) {
+      UMPIRE_UNLOCK;
+      throw;
+    }
+  }
+
+  ResourceManager::getInstance().registerAllocation(ret, {ret, bytes, this});
+
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ret;
+}
+
+void*
+ThreadCachingAllocator::allocateAligned(size_t bytes, size_t alignment)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ", alignment=" << alignment << ")");
+
+  if (bytes <= s_max_cached_size) {
+    void* ptr = allocate(bytes);
+
+    if (reinterpret_cast<uintptr_t>(ptr) % alignment == 0) {
+      return ptr;
+    }
+
+    deallocate(ptr);
+  }
+
+  const std::size_t block_bytes = bytes + alignment - 1;
+  void* ret = nullptr;
+
+  try {
+    UMPIRE_LOCK;
+
+    void* block = m_allocator->allocateUntracked(block_bytes);
+    const uintptr_t address = reinterpret_cast<uintptr_t>(block);
+    ret = reinterpret_cast<void*>((address + alignment - 1) / alignment * alignment);
+
+    try {
+      m_aligned_blocks[ret] = std::make_pair(block, block_bytes);
+    } catch (...) {
+      m_allocator->deallocateUntracked(block, block_bytes);
+      throw;
+    }
+
+    m_actual_size += block_bytes;
+    m_num_aligned_blocks.fetch_add(1, std::memory_order_relaxed);
+
+    UMPIRE_UNLOCK;
+  } catch (...) {
+    UMPIRE_UNLOCK;
+    throw;
+  }
+
+  ResourceManager::getInstance().registerAllocation(ret, {ret, bytes, this});
+
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ret;
+}
+
+void
+ThreadCachingAllocator::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+ThreadCachingAllocator::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  util::decreaseSize(m_current_size, record.m_size);
+
+  // A thread freeing a block from allocateAligned has seen the count raised.
+  if (m_num_aligned_blocks.load(std::memory_order_relaxed) > 0 && deallocateAligned(ptr)) {
+    return;
+  }
+
+  ThreadCache* cache = (record.m_size <= s_max_cached_size) ? getThreadCache() : nullptr;
+
+  if (cache) {
+    const int size_class = getSizeClass(record.m_size);
+    std::vector<void*>& bin = cache->bins[size_class];
+
+    bin.push_back(ptr);
+
+    if (bin.size() > 2*getBatchCount(size_class)) {
+      flush(cache, size_class);
+    }
+  } else {
+    const std::size_t block_bytes = getBlockSize(record.m_size);
+
+    try {
+      UMPIRE_LOCK;
+
+      m_allocator->deallocateUntracked(ptr, block_bytes);
+      m_actual_size -= block_bytes;
+
+      UMPIRE_UNLOCK;
+    } catch (...) {
+      UMPIRE_UNLOCK;
+      throw;
+    }
+  }
+}
+
+long
+ThreadCachingAllocator::getCurrentSize()
+{
+  return m_current_size.load(std::memory_order_relaxed);
+}
+
+long
+ThreadCachingAllocator::getHighWatermark()
+{
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+long
+ThreadCachingAllocator::getActualSize()
+{
+  return m_actual_size;
+}
+
+Platform
+ThreadCachingAllocator::getPlatform()
+{
+  return m_allocator->getPlatform();
+}
+
+resource::MemoryResourceType
+ThreadCachingAllocator::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+bool
+ThreadCachingAllocator::isThreadSafe()
+{
+  return true;
+}
+
+int
+ThreadCachingAllocator::getSizeClass(std::size_t bytes)
+{
+  int size_class = 0;
+  std::size_t class_size = s_min_cached_size;
+
+  while (class_size < bytes) {
+    class_size <<= 1;
+    ++size_class;
+  }
+
+  return size_class;
+}
+
+std::size_t
+ThreadCachingAllocator::getClassSize(int size_class)
+{
+  return s_min_cached_size << size_class;
+}
+
+std::size_t
+ThreadCachingAllocator::getBatchCount(int size_class)
+{
+  const std::size_t count = s_batch_bytes / getClassSize(size_class);
+  return std::min<std::size_t>(std::max<std::size_t>(count, 2), 64);
+}
+
+std::size_t
+ThreadCachingAllocator::getBlockSize(std::size_t bytes)
+{
+  return (bytes <= s_max_cached_size) ? getClassSize(getSizeClass(bytes)) : bytes;
+}
+
+ThreadCachingAllocator::ThreadCache*
+ThreadCachingAllocator::getThreadCache()
+{
+  if (t_last_serial != m_serial) {
+    // Blocks freed by destructors that run after the table's go straight
+    // to the backing Allocator.
+    if (t_caches_destroyed) {
+      return nullptr;
+    }
+
+    static thread_local ThreadCacheTable t_table;
+    ThreadCache*& cache = t_table.caches[m_serial];
+
+    if (!cache) {
+      std::unique_ptr<ThreadCache> created(new ThreadCache());
+
+      {
+        std::lock_guard<std::mutex> lock(s_caches_mutex);
+
+        m_caches.push_back(created.get());
+        created->owner = this;
+      }
+
+      cache = created.release();
+    }
+
+    t_last_serial = m_serial;
+    t_last_cache = cache;
+  }
+
+  return static_cast<ThreadCache*>(t_last_cache);
+}
+
+void
+ThreadCachingAllocator::refill(ThreadCache* cache, int size_class)
+{
+  std::vector<void*>& bin = cache->bins[size_class];
+  const std::size_t class_size = getClassSize(size_class);
+  const std::size_t count = getBatchCount(size_class);
+
+  UMPIRE_LOG(Debug, "(size_class=" << size_class << ", count=" << count << ")");
+
+  try {
+    UMPIRE_LOCK;
+
+    for (std::size_t i = 0; i < count; ++i) {
+      bin.push_back(m_allocator->allocateUntracked(class_size));
+      m_actual_size += class_size;
+    }
+
+    UMPIRE_UNLOCK;
+  } catch (...) {
+    UMPIRE_UNLOCK;
+
+    // A partial batch is still usable.
+    if (bin.empty())
+      throw;
+  }
+}
+
+void
+ThreadCachingAllocator::flush(ThreadCache* cache, int size_class)
+{
+  std::vector<void*>& bin = cache->bins[size_class];
+  const std::size_t class_size = getClassSize(size_class);
+  const std::size_t count = getBatchCount(size_class);
+
+  UMPIRE_LOG(Debug, "(size_class=" << size_class << ", count=" << count << ")");
+
+  // The most recently freed blocks are at the back; keep those cached.
+  try {
+    UMPIRE_LOCK;
+
+    for (std::size_t i = 0; i < count; ++i) {
+      m_allocator->deallocateUntracked(bin[i], class_size);
+      m_actual_size -= class_size;
+    }
+
+    UMPIRE_UNLOCK;
+  } catch (...) {
+    UMPIRE_UNLOCK;
+    throw;
+  }
+
+  bin.erase(bin.begin(), bin.begin() + count);
+}
+
+void
+ThreadCachingAllocator::drain(ThreadCache* cache)
+{
+  try {
+    UMPIRE_LOCK;
+
+    for (int size_class = 0; size_class < s_num_size_classes; ++size_class) {
+      std::vector<void*>& bin = cache->bins[size_class];
+      const std::size_t class_size = getClassSize(size_class);
+
+      while (!bin.empty()) {
+        m_allocator->deallocateUntracked(bin.back(), class_size);
+        m_actual_size -= class_size;
+        bin.pop_back();
+      }
+    }
+
+    UMPIRE_UNLOCK;
+  } catch (...) {
+    UMPIRE_UNLOCK;
+    throw;
+  }
+}
+
+bool
+ThreadCachingAllocator::deallocateAligned(void* ptr)
+{
+  bool found = false;
+
+  try {
+    UMPIRE_LOCK;
+
+    auto block = m_aligned_blocks.find(ptr);
+    if (block != m_aligned_blocks.end()) {
+      m_allocator->deallocateUntracked(block->second.first, block->second.second);
+      m_actual_size -= block->second.second;
+
+      m_aligned_blocks.erase(block);
+      m_num_aligned_blocks.fetch_sub(1, std::memory_order_relaxed);
+      found = true;
+    }
+
+    UMPIRE_UNLOCK;
+  } catch (...) {
+    UMPIRE_UNLOCK;
+    throw;
+  }
+
+  return found;
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
@@ -0,0 +1,169 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_ThreadCachingAllocator_HPP
+#define UMPIRE_ThreadCachingAllocator_HPP
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "umpire/Allocator.hpp"
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Front an Allocator with per-thread caches of free blocks.
+ *
+ * Requests up to s_max_cached_size bytes are rounded up to a power-of-two
+ * size class and served from a cache owned by the calling thread, so the
+ * common path takes no lock. Each cache refills from, and flushes to, the
+ * backing Allocator in batches of blocks under a single lock. Larger
+ * requests go straight to the backing Allocator.
+ *
+ * Blocks are taken from the backing Allocator with allocateUntracked, so
+ * only the ThreadCachingAllocator's own allocations are registered with the
+ * ResourceManager. A thread's caches are returned to the backing Allocator
+ * when it exits, and the caches of live threads when the
+ * ThreadCachingAllocator is destroyed.
+ */
+class ThreadCachingAllocator :
+  public AllocationStrategy
+{
+  public:
+    ThreadCachingAllocator(
+        const std::string& name,
+        int id,
+        Allocator allocator);
+
+    ~ThreadCachingAllocator();
+
+    void* allocate(size_t bytes);
+
+    /*!
+     * \brief Allocate bytes aligned to alignment.
+     *
+     * A cached block is used if it happens to be aligned. Otherwise the
+     * block is over-allocated from the backing Allocator and kept in a
+     * table under the lock; while any such blocks are live, frees look them
+     * up there first.
+     */
+    void* allocateAligned(size_t bytes, size_t alignment);
+
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    long getCurrentSize();
+    long getHighWatermark();
+    long getActualSize();
+
+    Platform getPlatform();
+
+    resource::MemoryResourceType getResourceType();
+
+    bool isThreadSafe();
+
+  private:
+    static const std::size_t s_min_cached_size = 16;
+    static const std::size_t s_max_cached_size = 32 * 1024;
+    static const int s_num_size_classes = 12;
+
+    /*!
+     * \brief Number of bytes moved between a thread cache and the backing
+     * Allocator in one refill or flush.
+     */
+    static const std::size_t s_batch_bytes = 64 * 1024;
+
+    struct ThreadCache
+    {
+      std::vector<void*> bins[s_num_size_classes];
+
+      /*!
+       * \brief The ThreadCachingAllocator the blocks belong to, or nullptr
+       * once it has been destroyed.
+       */
+      ThreadCachingAllocator* owner = nullptr;
+    };
+
+    /*!
+     * \brief A thread's caches, drained back to their owners when the
+     * thread exits.
+     */
+    struct ThreadCacheTable;
+
+    static int getSizeClass(std::size_t bytes);
+    static std::size_t getClassSize(int size_class);
+    static std::size_t getBatchCount(int size_class);
+
+    /*!
+     * \brief Bytes taken from the backing Allocator for a request of bytes.
+     */
+    static std::size_t getBlockSize(std::size_t bytes);
+
+    /*!
+     * \brief Return the calling thread's cache, or nullptr once the thread
+     * has begun to exit and its caches are gone.
+     */
+    ThreadCache* getThreadCache();
+
+    void refill(ThreadCache* cache, int size_class);
+    void flush(ThreadCache* cache, int size_class);
+
+    /*!
+     * \brief Return every block in cache to the backing Allocator.
+     */
+    void drain(ThreadCache* cache);
+
+    /*!
+     * \brief Free ptr if it came from the aligned block table.
+     */
+    bool deallocateAligned(void* ptr);
+
+
+    /*!
+     * \brief Identifies this instance in the per-thread cache tables; never
+     * reused, unlike the address of the object.
+     */
+    const unsigned long m_serial;
+
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
+    std::atomic<long> m_actual_size;
+
+    /*!
+     * \brief Caches of live threads, guarded by a mutex shared with exiting
+     * threads.
+     */
+    std::vector<ThreadCache*> m_caches;
+
+    /*!
+     * \brief Blocks handed out by allocateAligned, each with the block taken
+     * from the backing Allocator and its size.
+     */
+    std::unordered_map<void*, std::pair<void*, std::size_t> > m_aligned_blocks;
+    std::atomic<long> m_num_aligned_blocks;
+
+    std::shared_ptr<AllocationStrategy> m_allocator;
+
+    std::mutex* m_mutex;
+};
+
+} // end of namespace strategy
+} // end of namespace umpire
+
+#endif // UMPIRE_ThreadCachingAllocator_HPP
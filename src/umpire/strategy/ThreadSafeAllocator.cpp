@@ -15,8 +15,11 @@
 
 #include "umpire/ResourceManager.hpp"
 #include "umpire/strategy/ThreadSafeAllocator.hpp"
+#include "umpire/util/AtomicStatistics.hpp"
 #include "umpire/util/Macros.hpp"
 
+#include <vector>
+
 namespace umpire {
 namespace strategy {
 
@@ -28,6 +31,7 @@ ThreadSafeAllocator::ThreadSafeAllocator(
   m_current_size(0),
   m_highwatermark(0),
   m_allocator(allocator.getAllocationStrategy()),
+  m_allocator_is_thread_safe(m_allocator->isThreadSafe()),
   m_mutex(new std::mutex())
 {
 }
@@ -36,69 +40,320 @@ void*
 ThreadSafeAllocator::allocate(size_t bytes) 
 {
   void* ret = nullptr;
+  OwnerScope scope(this, bytes);
 
   try {
-    UMPIRE_LOCK;
+    lock();
 
     ret = m_allocator->allocate(bytes);
 
-    m_current_size += bytes;
-    if (m_current_size > m_highwatermark)
-      m_highwatermark = m_current_size;
+    unlock();
+  } catch (...) {
+    unlock();
+    throw;
+  }
 
+  if (!scope.claimed()) {
+    ResourceManager::getInstance().registerAllocation(ret, {ret, bytes, this});
+  }
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
 
-    UMPIRE_UNLOCK;
+  return ret;
+}
+
+void*
+ThreadSafeAllocator::tryAllocate(size_t bytes)
+{
+  OwnerScope scope(this, bytes);
+
+  lock();
+  void* ret = m_allocator->tryAllocate(bytes);
+  unlock();
+
+  if (ret) {
+    if (!scope.claimed()) {
+      ResourceManager::getInstance().registerAllocation(ret, {ret, bytes, this});
+    }
+    util::increaseSize(m_current_size, m_highwatermark, bytes);
+  }
+
+  return ret;
+}
+
+void*
+ThreadSafeAllocator::allocateAligned(size_t bytes, size_t alignment)
+{
+  void* ret = nullptr;
+  OwnerScope scope(this, bytes);
+
+  try {
+    lock();
+
+    ret = m_allocator->allocateAligned(bytes, alignment);
+
+    unlock();
   } catch (...) {
-    UMPIRE_UNLOCK;
+    unlock();
+    throw;
+  }
+
+  if (!scope.claimed()) {
+    ResourceManager::getInstance().registerAllocation(ret, {ret, bytes, this});
+  }
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ret;
+}
+
+void*
+ThreadSafeAllocator::allocateWithLifetime(size_t bytes, Lifetime lifetime)
+{
+  void* ret = nullptr;
+  OwnerScope scope(this, bytes);
+
+  try {
+    lock();
+
+    ret = m_allocator->allocateWithLifetime(bytes, lifetime);
+
+    unlock();
+  } catch (...) {
+    unlock();
     throw;
   }
 
-  ResourceManager::getInstance().registerAllocation(ret, 
-      new util::AllocationRecord{ret, bytes, this->shared_from_this()});
+  if (!scope.claimed()) {
+    ResourceManager::getInstance().registerAllocation(ret, {ret, bytes, this});
+  }
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
 
   return ret;
 }
 
+void*
+ThreadSafeAllocator::allocateZeroed(size_t bytes)
+{
+  void* ret = nullptr;
+  OwnerScope scope(this, bytes);
+
+  try {
+    lock();
+
+    ret = m_allocator->allocateZeroed(bytes);
+
+    unlock();
+  } catch (...) {
+    unlock();
+    throw;
+  }
+
+  if (!scope.claimed()) {
+    ResourceManager::getInstance().registerAllocation(ret, {ret, bytes, this});
+  }
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ret;
+}
+
+void
+ThreadSafeAllocator::allocateMany(const size_t* sizes, size_t count, void** ptrs)
+{
+  OwnerScope scope(this);
+
+  try {
+    lock();
+
+    m_allocator->allocateMany(sizes, count, ptrs);
+
+    unlock();
+  } catch (...) {
+    unlock();
+    throw;
+  }
+
+  size_t bytes = 0;
+  for (size_t i = 0; i < count; ++i) {
+    bytes += sizes[i];
+  }
+
+  if (!scope.claimed()) {
+    std::vector<util::AllocationRecord> records(count);
+
+    for (size_t i = 0; i < count; ++i) {
+      records[i] = util::AllocationRecord{ptrs[i], sizes[i], this};
+    }
+
+    ResourceManager::getInstance().registerAllocationBatch(ptrs, records.data(), count);
+  }
+
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+}
+
+void
+ThreadSafeAllocator::deallocateMany(void** ptrs, size_t count)
+{
+  auto& rm = ResourceManager::getInstance();
+  std::vector<util::AllocationRecord> records(count);
+  size_t bytes = 0;
+
+  for (size_t i = 0; i < count; ++i) {
+    if (ptrs[i]) {
+      records[i] = rm.deregisterAllocation(ptrs[i]);
+      bytes += records[i].m_size;
+    }
+  }
+
+  util::decreaseSize(m_current_size, bytes);
+
+  try {
+    lock();
+
+    for (size_t i = 0; i < count; ++i) {
+      if (ptrs[i]) {
+        m_allocator->deallocateRecord(ptrs[i], records[i]);
+      }
+    }
+
+    unlock();
+  } catch (...) {
+    unlock();
+    throw;
+  }
+}
+
 void 
 ThreadSafeAllocator::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+ThreadSafeAllocator::deallocateRecord(void* ptr, const util::AllocationRecord& record)
 {
   try {
-    UMPIRE_LOCK;
+    lock();
 
-    m_allocator->deallocate(ptr);
+    // The record was registered for this allocator in place of the
+    // wrapped one, so hand it down rather than looking it up again.
+    m_allocator->deallocateRecord(ptr, record);
 
-    UMPIRE_UNLOCK;
+    unlock();
   } catch (...) {
-    UMPIRE_UNLOCK;
+    unlock();
     throw;
   }
 
-  util::AllocationRecord* record = ResourceManager::getInstance().deregisterAllocation(ptr);
-  m_current_size -= record->m_size;
+  util::decreaseSize(m_current_size, record.m_size);
+}
+
+bool
+ThreadSafeAllocator::reallocateInPlace(void* ptr, size_t bytes)
+{
+  OwnerScope scope(this, bytes);
+  bool resized = false;
+  size_t old_bytes = 0;
+
+  try {
+    lock();
+
+    old_bytes = ResourceManager::getInstance().getSize(ptr);
+    resized = m_allocator->reallocateInPlace(ptr, bytes);
+
+    unlock();
+  } catch (...) {
+    unlock();
+    throw;
+  }
 
-  delete record;
+  if (resized) {
+    util::increaseSize(m_current_size, m_highwatermark,
+        static_cast<long>(bytes) - static_cast<long>(old_bytes));
+  }
+
+  return resized;
+}
+
+void
+ThreadSafeAllocator::coalesce()
+{
+  try {
+    lock();
+
+    m_allocator->coalesce();
+
+    unlock();
+  } catch (...) {
+    unlock();
+    throw;
+  }
+}
+
+void
+ThreadSafeAllocator::release()
+{
+  try {
+    lock();
+
+    m_allocator->release();
+
+    unlock();
+  } catch (...) {
+    unlock();
+    throw;
+  }
+}
+
+void
+ThreadSafeAllocator::trim(size_t target_bytes)
+{
+  try {
+    lock();
+
+    m_allocator->trim(target_bytes);
+
+    unlock();
+  } catch (...) {
+    unlock();
+    throw;
+  }
+}
+
+void
+ThreadSafeAllocator::reserve(size_t bytes, bool prefault)
+{
+  try {
+    lock();
+
+    m_allocator->reserve(bytes, prefault);
+
+    unlock();
+  } catch (...) {
+    unlock();
+    throw;
+  }
 }
 
 long
 ThreadSafeAllocator::getCurrentSize()
 {
-  long size;
-  
-  size = m_current_size;
-
-  return size;
+  return m_current_size.load(std::memory_order_relaxed);
 }
 
 long
 ThreadSafeAllocator::getHighWatermark()
 {
-  long size;
-  
-  size = m_highwatermark;
-
-  return size;
+  return m_highwatermark.load(std::memory_order_relaxed);
 }
 
+long
+ThreadSafeAllocator::getActualSize()
+{
+  lock();
+  const long actual = m_allocator->getActualSize();
+  unlock();
+
+  return actual;
+}
 
 Platform
 ThreadSafeAllocator::getPlatform()
@@ -107,5 +362,33 @@ ThreadSafeAllocator::getPlatform()
   return m_allocator->getPlatform();
 }
 
+resource::MemoryResourceType
+ThreadSafeAllocator::getResourceType()
+{
+  return m_allocator->getResourceType();
+}
+
+bool
+ThreadSafeAllocator::isThreadSafe()
+{
+  return true;
+}
+
+void
+ThreadSafeAllocator::lock()
+{
+  if (!m_allocator_is_thread_safe) {
+    UMPIRE_LOCK;
+  }
+}
+
+void
+ThreadSafeAllocator::unlock()
+{
+  if (!m_allocator_is_thread_safe) {
+    UMPIRE_UNLOCK;
+  }
+}
+
 } // end of namespace strategy
 } // end of namespace umpire
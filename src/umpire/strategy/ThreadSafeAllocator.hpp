@@ -15,6 +15,7 @@
 #ifndef UMPIRE_ThreadSafeAllocator_HPP
 #define UMPIRE_ThreadSafeAllocator_HPP
 
+#include <atomic>
 #include <mutex>
 
 #include "umpire/Allocator.hpp"
@@ -23,6 +24,13 @@
 namespace umpire {
 namespace strategy {
 
+/*!
+ * \brief Serialize calls to another AllocationStrategy with a mutex.
+ *
+ * Size statistics are kept in atomics, so getCurrentSize and
+ * getHighWatermark never take the lock. Strategies whose isThreadSafe
+ * returns true are called without locking at all.
+ */
 class ThreadSafeAllocator :
   public AllocationStrategy
 {
@@ -33,18 +41,46 @@ class ThreadSafeAllocator :
         Allocator allocator);
 
     void* allocate(size_t bytes);
+    void* allocateAligned(size_t bytes, size_t alignment);
+    void* allocateWithLifetime(size_t bytes, Lifetime lifetime);
+    void* allocateZeroed(size_t bytes);
+    void* tryAllocate(size_t bytes);
     void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    /*!
+     * \brief Hand the whole batch to the wrapped strategy under a single
+     * lock.
+     */
+    void allocateMany(const size_t* sizes, size_t count, void** ptrs);
+    void deallocateMany(void** ptrs, size_t count);
+
+    bool reallocateInPlace(void* ptr, size_t bytes);
+
+    void coalesce();
+    void release();
+    void trim(size_t target_bytes);
+    void reserve(size_t bytes, bool prefault);
 
     long getCurrentSize();
     long getHighWatermark();
+    long getActualSize();
 
     Platform getPlatform();
 
+    resource::MemoryResourceType getResourceType();
+
+    bool isThreadSafe();
+
   protected:
-    long m_current_size;
-    long m_highwatermark;
+    void lock();
+    void unlock();
+
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
 
     std::shared_ptr<AllocationStrategy> m_allocator;
+    bool m_allocator_is_thread_safe;
 
     std::mutex* m_mutex;
 };
@@ -0,0 +1,376 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/strategy/VirtualPool.hpp"
+
+#include "umpire/ResourceManager.hpp"
+
+#include "umpire/util/AtomicStatistics.hpp"
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace strategy {
+
+VirtualPool::VirtualPool(const std::string& name, int id) :
+  AllocationStrategy(name, id),
+  m_base(nullptr),
+  m_reserved(0),
+  m_granularity(0),
+  m_committed(),
+  m_num_committed(0),
+  m_used_blocks(),
+  m_free_by_address(),
+  m_free_by_size(),
+  m_current_size(0),
+  m_highwatermark(0),
+  m_mutex(new std::mutex())
+{
+}
+
+VirtualPool::~VirtualPool()
+{
+  delete m_mutex;
+}
+
+void
+VirtualPool::initialize(char* base, size_t reserved, size_t granularity)
+{
+  m_base = base;
+  m_reserved = reserved;
+  m_granularity = granularity;
+
+  m_committed.assign(reserved / granularity, false);
+
+  insertFree(m_base, m_reserved);
+}
+
+void*
+VirtualPool::allocate(size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(bytes=" << bytes << ")");
+
+  size_t size = ((bytes + s_alignment - 1) / s_alignment) * s_alignment;
+  if (size == 0)
+    size = s_alignment;
+
+  char* ptr = nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock(*m_mutex);
+
+    ptr = takeFree(size);
+    if (!ptr) {
+      UMPIRE_ERROR(getName() << " has no free range of " << size
+          << " bytes in its " << m_reserved << " byte reservation");
+    }
+
+    try {
+      commitRange(ptr, size);
+    } catch (...) {
+      insertFree(ptr, size);
+      throw;
+    }
+
+    m_used_blocks[ptr] = size;
+  }
+
+  ResourceManager::getInstance().registerAllocation(ptr, {ptr, bytes, this});
+
+  util::increaseSize(m_current_size, m_highwatermark, bytes);
+
+  return ptr;
+}
+
+void
+VirtualPool::deallocate(void* ptr)
+{
+  deallocateRecord(ptr, ResourceManager::getInstance().deregisterAllocation(ptr));
+}
+
+void
+VirtualPool::deallocateRecord(void* ptr, const util::AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ")");
+
+  {
+    std::lock_guard<std::mutex> lock(*m_mutex);
+
+    auto block = m_used_blocks.find(static_cast<char*>(ptr));
+    if (block == m_used_blocks.end()) {
+      UMPIRE_ERROR(getName() << " did not allocate " << ptr);
+    }
+
+    // Freed blocks stay committed until release or trim.
+    insertFree(block->first, block->second);
+    m_used_blocks.erase(block);
+  }
+
+  util::decreaseSize(m_current_size, record.m_size);
+}
+
+bool
+VirtualPool::reallocateInPlace(void* ptr, size_t bytes)
+{
+  UMPIRE_LOG(Debug, "(ptr=" << ptr << ", bytes=" << bytes << ")");
+
+  size_t size = ((bytes + s_alignment - 1) / s_alignment) * s_alignment;
+  if (size == 0)
+    size = s_alignment;
+
+  {
+    std::lock_guard<std::mutex> lock(*m_mutex);
+
+    auto block = m_used_blocks.find(static_cast<char*>(ptr));
+    if (block == m_used_blocks.end()) {
+      return false;
+    }
+
+    char* data = block->first;
+    const size_t old_size = block->second;
+
+    if (size < old_size) {
+      insertFree(data + size, old_size - size);
+    } else if (size > old_size) {
+      // Grow into the free range that starts where the block ends.
+      auto next = m_free_by_address.find(data + old_size);
+      const size_t extra = size - old_size;
+
+      if (next == m_free_by_address.end() || next->second < extra) {
+        return false;
+      }
+
+      const size_t next_size = next->second;
+      removeFree(next);
+      if (next_size > extra) {
+        insertFree(data + size, next_size - extra);
+      }
+
+      try {
+        commitRange(data + old_size, extra);
+      } catch (...) {
+        insertFree(data + old_size, extra);
+        throw;
+      }
+    }
+
+    block->second = size;
+  }
+
+  auto& rm = ResourceManager::getInstance();
+  util::AllocationRecord record = rm.deregisterAllocation(ptr);
+  rm.registerAllocation(ptr, {ptr, bytes, this});
+
+  util::increaseSize(m_current_size, m_highwatermark, static_cast<long>(bytes) - static_cast<long>(record.m_size));
+
+  return true;
+}
+
+void
+VirtualPool::release()
+{
+  UMPIRE_LOG(Debug, "()");
+
+  std::lock_guard<std::mutex> lock(*m_mutex);
+  decommitUnused(0);
+}
+
+void
+VirtualPool::trim(size_t target_bytes)
+{
+  UMPIRE_LOG(Debug, "(target_bytes=" << target_bytes << ")");
+
+  std::lock_guard<std::mutex> lock(*m_mutex);
+  decommitUnused(target_bytes);
+}
+
+long
+VirtualPool::getCurrentSize()
+{
+  return m_current_size.load(std::memory_order_relaxed);
+}
+
+long
+VirtualPool::getHighWatermark()
+{
+  return m_highwatermark.load(std::memory_order_relaxed);
+}
+
+long
+VirtualPool::getActualSize()
+{
+  std::lock_guard<std::mutex> lock(*m_mutex);
+  return static_cast<long>(m_num_committed * m_granularity);
+}
+
+bool
+VirtualPool::isThreadSafe()
+{
+  return true;
+}
+
+void
+VirtualPool::decommitAll()
+{
+  std::lock_guard<std::mutex> lock(*m_mutex);
+
+  for (size_t i = 0; i < m_committed.size(); ) {
+    if (!m_committed[i]) {
+      ++i;
+      continue;
+    }
+
+    const size_t first = i;
+    while (i < m_committed.size() && m_committed[i]) {
+      m_committed[i++] = false;
+    }
+
+    decommit(first, i - first);
+    m_num_committed -= i - first;
+  }
+}
+
+char*
+VirtualPool::granuleAddress(size_t index) const
+{
+  return m_base + index * m_granularity;
+}
+
+char*
+VirtualPool::takeFree(size_t size)
+{
+  auto best = m_free_by_size.lower_bound(size);
+  if (best == m_free_by_size.end()) {
+    return nullptr;
+  }
+
+  char* ptr = best->second;
+  const size_t free_size = best->first;
+
+  removeFree(m_free_by_address.find(ptr));
+  if (free_size > size) {
+    insertFree(ptr + size, free_size - size);
+  }
+
+  return ptr;
+}
+
+void
+VirtualPool::insertFree(char* ptr, size_t size)
+{
+  auto next = m_free_by_address.find(ptr + size);
+  if (next != m_free_by_address.end()) {
+    size += next->second;
+    removeFree(next);
+  }
+
+  auto prev = m_free_by_address.lower_bound(ptr);
+  if (prev != m_free_by_address.begin()) {
+    --prev;
+    if (prev->first + prev->second == ptr) {
+      ptr = prev->first;
+      size += prev->second;
+      removeFree(prev);
+    }
+  }
+
+  m_free_by_address[ptr] = size;
+  m_free_by_size.insert(std::make_pair(size, ptr));
+}
+
+void
+VirtualPool::removeFree(std::map<char*, size_t>::iterator it)
+{
+  auto range = m_free_by_size.equal_range(it->second);
+  for (auto entry = range.first; entry != range.second; ++entry) {
+    if (entry->second == it->first) {
+      m_free_by_size.erase(entry);
+      break;
+    }
+  }
+
+  m_free_by_address.erase(it);
+}
+
+void
+VirtualPool::commitRange(char* ptr, size_t size)
+{
+  const size_t last = (ptr + size - 1 - m_base) / m_granularity;
+
+  for (size_t i = (ptr - m_base) / m_granularity; i <= last; ) {
+    if (m_committed[i]) {
+      ++i;
+      continue;
+    }
+
+    size_t count = 1;
+    while (i + count <= last && !m_committed[i + count]) {
+      ++count;
+    }
+
+    UMPIRE_ANNOTATE_SCOPE("grow", getName(), count * m_granularity);
+    commit(i, count);
+
+    for (size_t j = i; j < i + count; ++j) {
+      m_committed[j] = true;
+    }
+    m_num_committed += count;
+    i += count;
+  }
+}
+
+bool
+VirtualPool::isGranuleUsed(size_t index) const
+{
+  char* start = granuleAddress(index);
+  char* end = start + m_granularity;
+
+  // Blocks do not overlap, so only the last one starting before the end of
+  // the granule can reach into it.
+  auto block = m_used_blocks.lower_bound(end);
+  if (block == m_used_blocks.begin()) {
+    return false;
+  }
+  --block;
+
+  return block->first + block->second > start;
+}
+
+void
+VirtualPool::decommitUnused(size_t target_bytes)
+{
+  size_t i = m_committed.size();
+
+  while (i > 0 && m_num_committed * m_granularity > target_bytes) {
+    if (!m_committed[i - 1] || isGranuleUsed(i - 1)) {
+      --i;
+      continue;
+    }
+
+    const size_t end = i;
+    while (i > 0 && m_committed[i - 1] && !isGranuleUsed(i - 1)
+        && (m_num_committed - (end - i)) * m_granularity > target_bytes) {
+      --i;
+    }
+
+    decommit(i, end - i);
+
+    for (size_t j = i; j < end; ++j) {
+      m_committed[j] = false;
+    }
+    m_num_committed -= end - i;
+  }
+}
+
+} // end of namespace strategy
+} // end of namespace umpire
@@ -0,0 +1,144 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_VirtualPool_HPP
+#define UMPIRE_VirtualPool_HPP
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+namespace umpire {
+namespace strategy {
+
+/*!
+ * \brief Base class for pools that place every block inside one reserved
+ * range of virtual addresses and back it with memory on demand.
+ *
+ * The range is split into granules. A granule is committed when a block
+ * first covers it and stays committed after the block is freed, until
+ * release or trim decommits the granules no block uses. Free blocks always
+ * merge with their neighbours, so a request fits as long as there is a
+ * large enough hole in the range, and reallocateInPlace grows a block into
+ * the free space after it.
+ *
+ * Subclasses reserve the range, call initialize, and implement commit and
+ * decommit. Their destructor frees the range, calling decommitAll first if
+ * freeing the range does not also free the memory behind it.
+ */
+class VirtualPool : public AllocationStrategy
+{
+  public:
+    void* allocate(size_t bytes);
+    void deallocate(void* ptr);
+    void deallocateRecord(void* ptr, const util::AllocationRecord& record);
+
+    bool reallocateInPlace(void* ptr, size_t bytes);
+
+    /*!
+     * \brief Decommit every granule not used by a block.
+     */
+    void release();
+
+    /*!
+     * \brief Decommit unused granules, highest address first, until
+     * getActualSize is no more than target_bytes.
+     */
+    void trim(size_t target_bytes);
+
+    long getCurrentSize();
+    long getHighWatermark();
+    long getActualSize();
+
+    bool isThreadSafe();
+
+  protected:
+    VirtualPool(const std::string& name, int id);
+
+    ~VirtualPool();
+
+    /*!
+     * \brief Hand the pool the range [base, base + reserved), which must be
+     * a multiple of granularity bytes long.
+     */
+    void initialize(char* base, size_t reserved, size_t granularity);
+
+    /*!
+     * \brief Back count granules, starting at granule first, with memory.
+     */
+    virtual void commit(size_t first, size_t count) = 0;
+
+    /*!
+     * \brief Return the memory behind count granules, starting at granule
+     * first, keeping their addresses reserved.
+     */
+    virtual void decommit(size_t first, size_t count) = 0;
+
+    /*!
+     * \brief Decommit every committed granule, used or not.
+     */
+    void decommitAll();
+
+    char* granuleAddress(size_t index) const;
+
+    char* m_base;
+    size_t m_reserved;
+    size_t m_granularity;
+
+  private:
+    /*!
+     * \brief Blocks are rounded up to this many bytes.
+     */
+    static const size_t s_alignment = 256;
+
+    char* takeFree(size_t size);
+    void insertFree(char* ptr, size_t size);
+    void removeFree(std::map<char*, size_t>::iterator it);
+
+    /*!
+     * \brief Commit every uncommitted granule overlapping [ptr, ptr + size).
+     */
+    void commitRange(char* ptr, size_t size);
+
+    /*!
+     * \brief Return whether a used block overlaps granule index.
+     */
+    bool isGranuleUsed(size_t index) const;
+
+    /*!
+     * \brief Decommit unused granules from the top of the range down,
+     * stopping once no more than target_bytes are committed.
+     */
+    void decommitUnused(size_t target_bytes);
+
+    std::vector<bool> m_committed;
+    size_t m_num_committed;
+
+    std::map<char*, size_t> m_used_blocks;
+    std::map<char*, size_t> m_free_by_address;
+    std::multimap<size_t, char*> m_free_by_size;
+
+    std::atomic<long> m_current_size;
+    std::atomic<long> m_highwatermark;
+
+    std::mutex* m_mutex;
+};
+
+} // end of namespace strategy
+} // end namespace umpire
+
+#endif // UMPIRE_VirtualPool_HPP
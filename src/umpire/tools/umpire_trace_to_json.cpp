@@ -0,0 +1,134 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Convert a binary trace written with ENABLE_TRACE into the JSON layout that
+ * StatisticsDatabase prints: one object per statistic name, holding the name
+ * and the list of its events in timestamp order.
+ *
+ *   umpire_trace_to_json umpire.1234.trace > statistics.json
+ */
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "umpire/util/Exception.hpp"
+#include "umpire/util/Tracer.hpp"
+
+namespace {
+
+using umpire::util::trace::Record;
+
+std::string quote(const std::string& name)
+{
+  std::string quoted("\"");
+
+  for (char c : name) {
+    if (c == '"' || c == '\\') {
+      quoted += '\\';
+    }
+    quoted += c;
+  }
+
+  return quoted + "\"";
+}
+
+void printRecord(std::ostream& out, const Record& record)
+{
+  namespace trace = umpire::util::trace;
+
+  out << "{";
+
+  if (record.fields & trace::has_ptr) {
+    out << "\"ptr\": " << record.ptr << ", ";
+  }
+  if (record.fields & trace::has_src_ptr) {
+    out << "\"src_ptr\": " << record.ptr << ", ";
+  }
+  if (record.fields & trace::has_dst_ptr) {
+    out << "\"dst_ptr\": " << record.dst_ptr << ", ";
+  }
+  if (record.arg_key != trace::none && record.arg_key < trace::Num_Arguments) {
+    out << "\"" << trace::ArgumentName[record.arg_key] << "\": " << record.arg << ", ";
+  }
+  if (record.fields & trace::has_size) {
+    out << "\"size\": " << record.size << ", ";
+  }
+
+  const int event = record.event < trace::Num_Events
+    ? static_cast<int>(record.event) : static_cast<int>(trace::unknown);
+
+  out << "\"event\": \"" << trace::EventName[event] << "\", "
+      << "\"timestamp\": " << record.timestamp << "}";
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char* argv[])
+{
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " <trace file>" << std::endl;
+    return 1;
+  }
+
+  std::vector<std::string> names;
+  std::vector<Record> records;
+
+  try {
+    umpire::util::Tracer::readTrace(argv[1], names, records);
+  } catch (umpire::util::Exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  std::map<std::string, std::vector<const Record*> > statistics;
+
+  for (const auto& record : records) {
+    const std::string name = record.name < names.size()
+      ? names[record.name] : "unknown";
+    statistics[name].push_back(&record);
+  }
+
+  std::cout << "{" << std::endl;
+
+  for (auto statistic = statistics.begin(); statistic != statistics.end(); ++statistic) {
+    auto& events = statistic->second;
+
+    std::stable_sort(events.begin(), events.end(),
+        [] (const Record* a, const Record* b) { return a->timestamp < b->timestamp; });
+
+    std::cout << "  " << quote(statistic->first) << ": " << std::endl
+      << "  {" << std::endl
+      << "    \"name\": " << quote(statistic->first) << "," << std::endl
+      << "    \"statistics\": " << std::endl
+      << "    [" << std::endl;
+
+    for (std::size_t i = 0; i < events.size(); ++i) {
+      std::cout << "      ";
+      printRecord(std::cout, *events[i]);
+      std::cout << (i + 1 < events.size() ? "," : "") << std::endl;
+    }
+
+    std::cout << "    ]" << std::endl
+      << "  }" << (std::next(statistic) != statistics.end() ? "," : "") << std::endl;
+  }
+
+  std::cout << "}" << std::endl;
+
+  return 0;
+}
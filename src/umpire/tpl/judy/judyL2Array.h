@@ -152,6 +152,12 @@ class judyL2Array {
         const cpair atOrBefore( JudyKey key) {
             atOrAfter(key);
 
+            // no key at or after the given key, so the last key is the one before it
+            if (!_lastSlot) {
+              _lastSlot = ( vector ** ) judy_end( _judyarray );
+              return mostRecentPair();
+            }
+
             JudyKey found_key;
             judy_key( _judyarray, (unsigned char *) &found_key, _depth * JUDY_key_size);
 
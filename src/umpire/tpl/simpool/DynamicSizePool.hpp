@@ -0,0 +1,623 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef _DYNAMICSIZEPOOL_HPP
+#define _DYNAMICSIZEPOOL_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+#include "umpire/strategy/AllocationStrategy.hpp"
+#include "umpire/util/Macros.hpp"
+#include "umpire/util/PlacementPolicy.hpp"
+
+#include "umpire/tpl/simpool/StdAllocator.hpp"
+
+/*!
+ * \brief Pool of variable-sized blocks carved from chunks obtained from an
+ * AllocationStrategy.
+ *
+ * Blocks are kept in one address-ordered list per chunk so a freed block is
+ * merged with its free neighbours immediately. Free blocks are also indexed
+ * according to the pool's PlacementPolicy, which decides how a request
+ * picks its block. Block metadata is allocated with IA.
+ */
+template <class IA = StdAllocator>
+class DynamicSizePool
+{
+  public:
+    // Every block is aligned to, and sized in multiples of, this many bytes.
+    static const std::size_t alignment = 16;
+
+  protected:
+    struct Block
+    {
+      char *data;
+      std::size_t size;
+      bool isHead;
+      bool isFree;
+
+      // Neighbours in address order; a chunk ends at the next head block.
+      Block *prev;
+      Block *next;
+
+      // Links within a segregated-fit bin.
+      Block *binPrev;
+      Block *binNext;
+
+      // Position in the best-fit size index.
+      typename std::multimap<std::size_t, Block*>::iterator sizeIt;
+    };
+
+    static const int numBins = 64;
+
+    std::shared_ptr<umpire::strategy::AllocationStrategy> allocator;
+    const umpire::PlacementPolicy policy;
+
+    // All blocks, chunk by chunk.
+    Block *blocks;
+    Block *lastBlock;
+
+    // Block structs ready for reuse.
+    Block *spareBlocks;
+
+    // Block structs are carved from slabs of blocksPerSlab, which are only
+    // freed, whole, by the destructor.
+    static const std::size_t blocksPerSlab = 256;
+    std::vector<Block*> blockSlabs;
+
+    std::unordered_map<char*, Block*> usedBlocks;
+
+    // Free block indices; only the one for the active policy is populated.
+    std::map<char*, Block*> freeByAddress;
+    std::multimap<std::size_t, Block*> freeBySize;
+    Block *bins[numBins];
+    std::uint64_t binMask;
+
+    std::size_t numFree;
+    std::size_t numChunks;
+
+    // Atomic so that totalSize can be read while another thread allocates.
+    std::atomic<std::size_t> totalBytes;
+    std::size_t allocBytes;
+    std::size_t minInitialBytes;
+    std::size_t minBytes;
+
+    // Sizes chunks after the first from totalBytes; minBytes when unset.
+    std::function<std::size_t(std::size_t)> growBytes;
+
+    static std::size_t alignSize(std::size_t size) {
+      if (size == 0) size = 1;
+      return (size + (alignment - 1)) & ~(alignment - 1);
+    }
+
+    static int floorLog2(std::size_t size) {
+      return 63 - __builtin_clzll(static_cast<unsigned long long>(size));
+    }
+
+    static int ceilLog2(std::size_t size) {
+      const int l = floorLog2(size);
+      return (static_cast<std::size_t>(1) << l) == size ? l : l + 1;
+    }
+
+    Block* newBlock() {
+      if (!spareBlocks) {
+        Block *slab = static_cast<Block*>(IA::allocate(blocksPerSlab * sizeof(Block)));
+        blockSlabs.push_back(slab);
+
+        for (std::size_t i = 0; i < blocksPerSlab; ++i) {
+          slab[i].next = (i + 1 < blocksPerSlab) ? &slab[i + 1] : nullptr;
+        }
+        spareBlocks = slab;
+      }
+
+      Block *b = spareBlocks;
+      spareBlocks = b->next;
+      return new (b) Block();
+    }
+
+    void recycleBlock(Block *b) {
+      b->~Block();
+      b->next = spareBlocks;
+      spareBlocks = b;
+    }
+
+    void insertFree(Block *b) {
+      b->isFree = true;
+      numFree++;
+
+      switch (policy) {
+        case umpire::PlacementPolicy::first_fit:
+          freeByAddress.emplace(b->data, b);
+          break;
+        case umpire::PlacementPolicy::best_fit:
+          b->sizeIt = freeBySize.emplace(b->size, b);
+          break;
+        case umpire::PlacementPolicy::segregated_fit:
+          {
+            const int bin = floorLog2(b->size);
+            b->binPrev = nullptr;
+            b->binNext = bins[bin];
+            if (bins[bin]) bins[bin]->binPrev = b;
+            bins[bin] = b;
+            binMask |= (static_cast<std::uint64_t>(1) << bin);
+          }
+          break;
+      }
+    }
+
+    void removeFree(Block *b) {
+      b->isFree = false;
+      numFree--;
+
+      switch (policy) {
+        case umpire::PlacementPolicy::first_fit:
+          freeByAddress.erase(b->data);
+          break;
+        case umpire::PlacementPolicy::best_fit:
+          freeBySize.erase(b->sizeIt);
+          break;
+        case umpire::PlacementPolicy::segregated_fit:
+          {
+            const int bin = floorLog2(b->size);
+            if (b->binPrev) b->binPrev->binNext = b->binNext;
+            else bins[bin] = b->binNext;
+            if (b->binNext) b->binNext->binPrev = b->binPrev;
+            if (!bins[bin]) binMask &= ~(static_cast<std::uint64_t>(1) << bin);
+          }
+          break;
+      }
+    }
+
+    Block* findFree(std::size_t size) {
+      switch (policy) {
+        case umpire::PlacementPolicy::first_fit:
+          for (auto& entry : freeByAddress) {
+            if (entry.second->size >= size) return entry.second;
+          }
+          return nullptr;
+        case umpire::PlacementPolicy::best_fit:
+          {
+            auto it = freeBySize.lower_bound(size);
+            return (it == freeBySize.end()) ? nullptr : it->second;
+          }
+        case umpire::PlacementPolicy::segregated_fit:
+          {
+            // Every block in bins at or above ceilLog2(size) is big enough.
+            const int fit = ceilLog2(size);
+            const std::uint64_t mask = (fit < numBins) ?
+              (binMask & (~static_cast<std::uint64_t>(0) << fit)) : 0;
+            if (mask) return bins[__builtin_ctzll(mask)];
+
+            // Otherwise a block in the size's own bin may still fit.
+            for (Block *b = bins[floorLog2(size)]; b; b = b->binNext) {
+              if (b->size >= size) return b;
+            }
+            return nullptr;
+          }
+      }
+      return nullptr;
+    }
+
+    Block* allocateChunk(std::size_t size, bool mayFail = false) {
+      if (totalBytes == 0) return addChunk(std::max(size, minInitialBytes), mayFail);
+      return addChunk(std::max(size, growBytes ? growBytes(totalBytes) : minBytes), mayFail);
+    }
+
+    // With mayFail, returns nullptr instead of throwing if the allocator
+    // has no memory left.
+    Block* addChunk(std::size_t sizeToAlloc, bool mayFail = false) {
+      UMPIRE_ANNOTATE_SCOPE("grow", allocator->getName(), sizeToAlloc);
+
+      void *data = mayFail ?
+        allocator->tryAllocateUntracked(sizeToAlloc) :
+        allocator->allocateUntracked(sizeToAlloc);
+      if (!data) return nullptr;
+
+      Block *b = newBlock();
+      b->data = static_cast<char*>(data);
+      b->size = sizeToAlloc;
+      b->isHead = true;
+      b->prev = lastBlock;
+      b->next = nullptr;
+
+      if (lastBlock) lastBlock->next = b;
+      else blocks = b;
+      lastBlock = b;
+
+      totalBytes += sizeToAlloc;
+      numChunks++;
+
+      insertFree(b);
+      return b;
+    }
+
+    void splitBlock(Block *b, std::size_t size) {
+      if (b->size == size) return;
+
+      Block *rest = newBlock();
+      rest->data = b->data + size;
+      rest->size = b->size - size;
+      rest->isHead = false;
+      rest->prev = b;
+      rest->next = b->next;
+
+      if (b->next) b->next->prev = rest;
+      else lastBlock = rest;
+      b->next = rest;
+      b->size = size;
+
+      insertFree(rest);
+    }
+
+    // Merge b->next into b; both must be in the same chunk.
+    void mergeNext(Block *b) {
+      Block *n = b->next;
+      b->size += n->size;
+      b->next = n->next;
+      if (n->next) n->next->prev = b;
+      else lastBlock = b;
+      recycleBlock(n);
+    }
+
+    // A chunk is wholly free once it has merged back into its head block.
+    static bool isFreeChunk(const Block *b) {
+      return b->isHead && b->isFree && (!b->next || b->next->isHead);
+    }
+
+    void releaseChunk(Block *b) {
+      removeFree(b);
+
+      if (b->prev) b->prev->next = b->next;
+      else blocks = b->next;
+      if (b->next) b->next->prev = b->prev;
+      else lastBlock = b->prev;
+
+      allocator->deallocateUntracked(b->data, b->size);
+      totalBytes -= b->size;
+      numChunks--;
+
+      recycleBlock(b);
+    }
+
+    void releaseBlock(Block *b) {
+      Block *n = b->next;
+      if (n && n->isFree && !n->isHead) {
+        removeFree(n);
+        mergeNext(b);
+      }
+
+      Block *p = b->prev;
+      if (p && p->isFree && !b->isHead) {
+        removeFree(p);
+        mergeNext(p);
+        b = p;
+      }
+
+      insertFree(b);
+    }
+
+    void *place(std::size_t size, std::size_t align, std::size_t offset, bool mayFail) {
+      size = alignSize(size);
+      const std::size_t searchSize =
+        (align > alignment) ? size + align - alignment : size;
+
+      Block *b = findFree(searchSize);
+      if (!b) b = allocateChunk(searchSize, mayFail);
+      if (!b) return nullptr;
+
+      removeFree(b);
+
+      const std::size_t padding = (align > alignment) ?
+        (offset - reinterpret_cast<std::uintptr_t>(b->data)) & (align - 1) : 0;
+      if (padding) {
+        // Leave the padding in front as a free block of its own.
+        splitBlock(b, padding);
+        Block *aligned = b->next;
+        removeFree(aligned);
+        insertFree(b);
+        b = aligned;
+      }
+
+      splitBlock(b, size);
+
+      usedBlocks[b->data] = b;
+      allocBytes += size;
+
+      return b->data;
+    }
+
+  public:
+    DynamicSizePool(
+        std::shared_ptr<umpire::strategy::AllocationStrategy> strat,
+        const std::size_t _minInitialBytes = (16 * 1024),
+        const std::size_t _minBytes = 256,
+        const umpire::PlacementPolicy _policy = umpire::PlacementPolicy::best_fit,
+        std::function<std::size_t(std::size_t)> _growBytes = nullptr)
+      : allocator(strat),
+        policy(_policy),
+        blocks(nullptr),
+        lastBlock(nullptr),
+        spareBlocks(nullptr),
+        blockSlabs(),
+        usedBlocks(),
+        freeByAddress(),
+        freeBySize(),
+        binMask(0),
+        numFree(0),
+        numChunks(0),
+        totalBytes(0),
+        allocBytes(0),
+        minInitialBytes(_minInitialBytes),
+        minBytes(_minBytes),
+        growBytes(_growBytes)
+    {
+      for (int i = 0; i < numBins; i++) bins[i] = nullptr;
+    }
+
+    // Chunks go back to the allocator whole, blocks in use or not, and the
+    // block metadata goes with its slabs.
+    ~DynamicSizePool() {
+      forEachChunk([this](char *data, std::size_t size) {
+        allocator->deallocateUntracked(data, size);
+      });
+
+      for (Block *slab : blockSlabs) {
+        IA::deallocate(slab);
+      }
+    }
+
+    void *allocate(std::size_t size) {
+      return place(size, alignment, 0, false);
+    }
+
+    /*!
+     * \brief Allocate size bytes starting on an align-byte boundary.
+     *
+     * The block is searched for with enough slack to reach the boundary;
+     * the bytes in front of it stay in the pool as a free block, so the
+     * allocation itself is only size bytes.
+     */
+    void *allocate(std::size_t size, std::size_t align) {
+      return place(size, align, 0, false);
+    }
+
+    /*!
+     * \brief Allocate size bytes starting offset bytes past an align-byte
+     * boundary, where offset is a multiple of alignment below align.
+     */
+    void *allocate(std::size_t size, std::size_t align, std::size_t offset) {
+      return place(size, align, offset, false);
+    }
+
+    /*!
+     * \brief Like allocate, but return nullptr instead of throwing if the
+     * pool cannot grow.
+     */
+    void *tryAllocate(std::size_t size, std::size_t align) {
+      return place(size, align, 0, true);
+    }
+
+    void *tryAllocate(std::size_t size, std::size_t align, std::size_t offset) {
+      return place(size, align, offset, true);
+    }
+
+    /*!
+     * \brief Allocate count blocks, of sizes[i] bytes each, next to one
+     * another.
+     *
+     * A single free block large enough for the whole batch is found and
+     * split in address order, so the blocks share a chunk and can still be
+     * freed one at a time.
+     */
+    void allocate(const std::size_t *sizes, std::size_t count, void **ptrs) {
+      if (count == 0) return;
+
+      std::size_t total = 0;
+      for (std::size_t i = 0; i < count; i++) total += alignSize(sizes[i]);
+
+      Block *b = findFree(total);
+      if (!b) b = allocateChunk(total);
+
+      removeFree(b);
+
+      for (std::size_t i = 0; i < count; i++) {
+        const std::size_t size = alignSize(sizes[i]);
+        splitBlock(b, size);
+
+        usedBlocks[b->data] = b;
+        allocBytes += size;
+        ptrs[i] = b->data;
+
+        if (i + 1 < count) {
+          b = b->next;
+          removeFree(b);
+        }
+      }
+    }
+
+    void deallocate(void *ptr) {
+      auto it = usedBlocks.find(static_cast<char*>(ptr));
+      if (it == usedBlocks.end()) return;
+
+      Block *b = it->second;
+      usedBlocks.erase(it);
+      allocBytes -= b->size;
+
+      releaseBlock(b);
+    }
+
+    /*!
+     * \brief Resize the used block at ptr to size without moving it.
+     *
+     * Shrinking returns the tail to the pool. Growing absorbs the following
+     * free block of the same chunk, if it is big enough.
+     *
+     * \return false if the block could not be resized in place.
+     */
+    bool resize(void *ptr, std::size_t size) {
+      auto it = usedBlocks.find(static_cast<char*>(ptr));
+      if (it == usedBlocks.end()) return false;
+
+      Block *b = it->second;
+      const std::size_t oldSize = b->size;
+      size = alignSize(size);
+
+      if (size < oldSize) {
+        splitBlock(b, size);
+
+        // The new tail may border a free block.
+        Block *tail = b->next;
+        removeFree(tail);
+        releaseBlock(tail);
+      } else if (size > oldSize) {
+        Block *n = b->next;
+        if (!n || !n->isFree || n->isHead || oldSize + n->size < size)
+          return false;
+
+        removeFree(n);
+        mergeNext(b);
+        splitBlock(b, size);
+      }
+
+      allocBytes += size;
+      allocBytes -= oldSize;
+
+      return true;
+    }
+
+    /*!
+     * \brief Return wholly free chunks to the allocator until at most
+     * targetBytes remain in the pool.
+     *
+     * \return Number of bytes released.
+     */
+    std::size_t releaseFreeChunks(std::size_t targetBytes = 0) {
+      std::size_t released = 0;
+
+      for (Block *b = blocks; b && totalBytes > targetBytes; ) {
+        Block *next = b->next;
+        if (isFreeChunk(b)) {
+          released += b->size;
+          releaseChunk(b);
+        }
+        b = next;
+      }
+
+      return released;
+    }
+
+    /*!
+     * \brief Replace all wholly free chunks with a single chunk of their
+     * combined size.
+     *
+     * Free blocks are merged with their neighbours as they are released, so
+     * the only fragmentation left to remove is that between chunks.
+     */
+    void coalesce() {
+      std::size_t freeChunks = 0;
+      for (Block *b = blocks; b; b = b->next) {
+        if (isFreeChunk(b)) freeChunks++;
+      }
+
+      if (freeChunks > 1) {
+        const std::size_t released = releaseFreeChunks();
+        addChunk(released);
+      }
+    }
+
+    /*!
+     * \brief Add a chunk so that at least size bytes are free.
+     *
+     * Returns the data of the new chunk, or nullptr if that much is free
+     * already.
+     */
+    void* reserve(std::size_t size) {
+      const std::size_t freeBytes = totalBytes - allocBytes;
+      if (freeBytes >= size) return nullptr;
+
+      return addChunk(size - freeBytes)->data;
+    }
+
+    std::size_t allocatedSize() const { return allocBytes; }
+
+    std::size_t totalSize() const { return totalBytes; }
+
+    std::size_t numFreeBlocks() const { return numFree; }
+
+    std::size_t numUsedBlocks() const { return usedBlocks.size(); }
+
+    std::size_t numAllocatedChunks() const { return numChunks; }
+
+    /*!
+     * \brief Call function(data, size) for every chunk. Chunks are
+     * untracked, so their sizes are recovered by adding up their blocks.
+     */
+    template <typename Function>
+    void forEachChunk(Function function) const {
+      for (const Block *b = blocks; b; ) {
+        char *data = b->data;
+        std::size_t size = 0;
+        do {
+          size += b->size;
+          b = b->next;
+        } while (b && !b->isHead);
+
+        function(data, size);
+      }
+    }
+
+    /*!
+     * \brief Return the size of the largest free block, or 0 if there is
+     * none.
+     *
+     * Constant time for best_fit; the other policies scan their index.
+     */
+    std::size_t largestFreeBlock() const {
+      std::size_t largest = 0;
+
+      switch (policy) {
+        case umpire::PlacementPolicy::first_fit:
+          for (auto& entry : freeByAddress) {
+            largest = std::max(largest, entry.second->size);
+          }
+          break;
+        case umpire::PlacementPolicy::best_fit:
+          if (!freeBySize.empty()) largest = freeBySize.rbegin()->first;
+          break;
+        case umpire::PlacementPolicy::segregated_fit:
+          // The largest block is in the highest non-empty bin.
+          if (binMask) {
+            for (Block *b = bins[floorLog2(binMask)]; b; b = b->binNext) {
+              largest = std::max(largest, b->size);
+            }
+          }
+          break;
+      }
+
+      return largest;
+    }
+
+    umpire::PlacementPolicy getPolicy() const { return policy; }
+};
+
+#endif
@@ -0,0 +1,26 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef _STDALLOCATOR_HPP
+#define _STDALLOCATOR_HPP
+
+#include <cstdlib>
+
+struct StdAllocator
+{
+  static inline void *allocate(std::size_t size) { return std::malloc(size); }
+  static inline void deallocate(void *ptr) { std::free(ptr); }
+};
+
+#endif
@@ -14,107 +14,1188 @@
 //////////////////////////////////////////////////////////////////////////////
 #include "umpire/util/AllocationMap.hpp"
 
+#include "umpire/config.hpp"
+
 #include "umpire/util/Macros.hpp"
 
+#include "umpire/tpl/judy/judy.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <utility>
+
+#if !defined(UMPIRE_ALLOCATION_MAP_BACKEND)
+#define UMPIRE_ALLOCATION_MAP_BACKEND judy
+#endif
+
 namespace umpire {
 namespace util {
 
-AllocationMap::AllocationMap() :
-  m_mutex(new std::mutex())
+namespace {
+
+/*
+ * Size (as a power of two) of the address regions that are assigned to each
+ * shard. Regions are assigned to shards round-robin.
+ */
+const int s_shard_region_bits = 21;
+
+/*
+ * Number of recent lookups remembered by each thread, see findWord.
+ */
+const std::size_t s_lookaside_entries = 4;
+
+/*
+ * Number of AllocationRecord slots in each slab of a RecordPool.
+ */
+const std::size_t s_records_per_slab = 1024;
+
+/*
+ * Initial number of slots, as a power of two, in each ExactIndex. Tables
+ * double when they are half full.
+ */
+const int s_exact_index_initial_bits = 10;
+
+/*
+ * The low two bits of a word say whether it points to an AllocationRecord,
+ * points to an EntryVector, or holds a packed record: the strategy id in
+ * the next s_packed_id_bits bits and the size in the rest.
+ */
+const uintptr_t s_word_tag_mask = 0x3;
+const uintptr_t s_word_record = 0x0;
+const uintptr_t s_word_vector = 0x1;
+const uintptr_t s_word_packed = 0x2;
+
+const int s_packed_id_bits = 16;
+const int s_packed_size_shift = 2 + s_packed_id_bits;
+const std::size_t s_max_strategies = std::size_t{1} << s_packed_id_bits;
+const std::size_t s_strategies_per_chunk = 256;
+
+/*
+ * A lookup of address in map_id that found word, whose base is key, while
+ * the epoch of the shard searched was epoch.
+ */
+struct LookasideEntry
+{
+  std::uint64_t map_id;
+  std::uint64_t epoch;
+  uintptr_t address;
+  uintptr_t key;
+  uintptr_t word;
+};
+
+struct Lookaside
+{
+  LookasideEntry entries[s_lookaside_entries];
+  std::size_t next;
+};
+
+thread_local Lookaside t_lookaside;
+
+std::atomic<std::uint64_t> s_next_map_id{1};
+
+/*
+ * Mark a change to shard; called with its mutex held.
+ */
+template <typename Shard>
+void advanceEpoch(Shard& shard)
+{
+  shard.epoch.store(shard.epoch.load(std::memory_order_relaxed) + 1,
+      std::memory_order_release);
+}
+
+AllocationMap::EntryVector*
+getVector(uintptr_t word)
 {
+  return reinterpret_cast<AllocationMap::EntryVector*>(word & ~s_word_tag_mask);
+}
+
+/*
+ * Return the words stored in slot, oldest first, and set count to their
+ * number.
+ */
+const uintptr_t*
+getWords(const uintptr_t& slot, std::size_t& count)
+{
+  if ((slot & s_word_tag_mask) == s_word_vector) {
+    const AllocationMap::EntryVector* words = getVector(slot);
+    count = words->size();
+    return words->data();
+  }
+
+  count = 1;
+  return &slot;
+}
+
+} // end of anonymous namespace
+
+class AllocationMap::RangeIndex
+{
+  public:
+    virtual ~RangeIndex() {}
+
+    /*!
+     * \brief Return the word of key, or nullptr if key is not in the index.
+     *
+     * The word may be modified in place until the next call.
+     */
+    virtual uintptr_t* find(uintptr_t key) = 0;
+
+    /*!
+     * \brief Add key, which must not be in the index, with a non-zero word.
+     */
+    virtual void insert(uintptr_t key, uintptr_t word) = 0;
+
+    virtual void remove(uintptr_t key) = 0;
+
+    /*!
+     * \brief Return the word of the greatest key not above key, and set
+     * found_key to it, or return nullptr if there is no such key.
+     */
+    virtual uintptr_t* atOrBefore(uintptr_t key, uintptr_t& found_key) = 0;
+
+    /*!
+     * \brief Append every key in [first, last) to keys, in order.
+     */
+    virtual void collect(uintptr_t first, uintptr_t last, std::vector<uintptr_t>& keys) = 0;
+
+    /*!
+     * \brief Return the bytes of memory used by the index.
+     */
+    virtual std::size_t getMemoryUsage() const = 0;
+};
+
+namespace {
+
+class JudyRangeIndex : public AllocationMap::RangeIndex
+{
+  public:
+    JudyRangeIndex() :
+      m_judy(judy_open(sizeof(uintptr_t), 1))
+    {
+      if (!m_judy) {
+        UMPIRE_ERROR("Cannot allocate Judy array");
+      }
+    }
+
+    ~JudyRangeIndex()
+    {
+      judy_close(m_judy);
+    }
+
+    uintptr_t* find(uintptr_t key) override
+    {
+      JudySlot* slot = judy_slot(m_judy, getBytes(key), sizeof(uintptr_t));
+      return (slot && *slot) ? reinterpret_cast<uintptr_t*>(slot) : nullptr;
+    }
+
+    void insert(uintptr_t key, uintptr_t word) override
+    {
+      JudySlot* slot = judy_cell(m_judy, getBytes(key), sizeof(uintptr_t));
+      if (!slot) {
+        UMPIRE_ERROR("Cannot insert " << reinterpret_cast<void*>(key) << " into Judy array");
+      }
+      *slot = word;
+    }
+
+    void remove(uintptr_t key) override
+    {
+      if (judy_slot(m_judy, getBytes(key), sizeof(uintptr_t))) {
+        judy_del(m_judy);
+      }
+    }
+
+    // Iteration skips cells without a word, and only stops at the end of
+    // the array.
+    uintptr_t* atOrBefore(uintptr_t key, uintptr_t& found_key) override
+    {
+      JudySlot* slot = judy_strt(m_judy, getBytes(key), sizeof(uintptr_t));
+
+      if (!slot) {
+        slot = judy_end(m_judy);
+      } else if (getKey() != key) {
+        slot = judy_prv(m_judy);
+      }
+
+      while (slot && !*slot) {
+        slot = judy_prv(m_judy);
+      }
+
+      if (!slot) {
+        return nullptr;
+      }
+
+      found_key = getKey();
+      return reinterpret_cast<uintptr_t*>(slot);
+    }
+
+    void collect(uintptr_t first, uintptr_t last, std::vector<uintptr_t>& keys) override
+    {
+      for (JudySlot* slot = judy_strt(m_judy, getBytes(first), sizeof(uintptr_t));
+          slot; slot = judy_nxt(m_judy)) {
+        const uintptr_t key = getKey();
+        if (key >= last) {
+          break;
+        }
+        if (*slot) {
+          keys.push_back(key);
+        }
+      }
+    }
+
+    // Judy arrays allocate fixed-size segments and never return them.
+    std::size_t getMemoryUsage() const override
+    {
+      std::size_t bytes = 0;
+      for (JudySeg* seg = m_judy->seg; seg; seg = static_cast<JudySeg*>(seg->seg)) {
+        bytes += JUDY_seg;
+      }
+      return bytes;
+    }
+
+  private:
+    static const unsigned char* getBytes(const uintptr_t& key)
+    {
+      return reinterpret_cast<const unsigned char*>(&key);
+    }
+
+    /*
+     * Key of the cell found by the last judy call.
+     */
+    uintptr_t getKey()
+    {
+      uintptr_t key = 0;
+      judy_key(m_judy, reinterpret_cast<unsigned char*>(&key), sizeof(uintptr_t));
+      return key;
+    }
+
+    Judy* m_judy;
+};
+
+class TreeRangeIndex : public AllocationMap::RangeIndex
+{
+  public:
+    uintptr_t* find(uintptr_t key) override
+    {
+      auto it = m_map.find(key);
+      return (it != m_map.end()) ? &it->second : nullptr;
+    }
+
+    void insert(uintptr_t key, uintptr_t word) override
+    {
+      m_map.emplace(key, word);
+    }
+
+    void remove(uintptr_t key) override
+    {
+      m_map.erase(key);
+    }
+
+    uintptr_t* atOrBefore(uintptr_t key, uintptr_t& found_key) override
+    {
+      auto it = m_map.upper_bound(key);
+      if (it == m_map.begin()) {
+        return nullptr;
+      }
+      --it;
+
+      found_key = it->first;
+      return &it->second;
+    }
+
+    void collect(uintptr_t first, uintptr_t last, std::vector<uintptr_t>& keys) override
+    {
+      for (auto it = m_map.lower_bound(first);
+          it != m_map.end() && it->first < last; ++it) {
+        keys.push_back(it->first);
+      }
+    }
+
+    // An estimate: each node holds its value, three links and a colour.
+    std::size_t getMemoryUsage() const override
+    {
+      return m_map.size() *
+        (sizeof(std::map<uintptr_t, uintptr_t>::value_type) + 4 * sizeof(void*));
+    }
+
+  private:
+    std::map<uintptr_t, uintptr_t> m_map;
+};
+
+class SortedVectorRangeIndex : public AllocationMap::RangeIndex
+{
+  public:
+    uintptr_t* find(uintptr_t key) override
+    {
+      auto it = lowerBound(key);
+      return (it != m_entries.end() && it->first == key) ? &it->second : nullptr;
+    }
+
+    void insert(uintptr_t key, uintptr_t word) override
+    {
+      m_entries.insert(lowerBound(key), Entry(key, word));
+    }
+
+    void remove(uintptr_t key) override
+    {
+      auto it = lowerBound(key);
+      if (it != m_entries.end() && it->first == key) {
+        m_entries.erase(it);
+      }
+    }
+
+    uintptr_t* atOrBefore(uintptr_t key, uintptr_t& found_key) override
+    {
+      auto it = std::upper_bound(m_entries.begin(), m_entries.end(), key,
+          [] (uintptr_t k, const Entry& entry) { return k < entry.first; });
+      if (it == m_entries.begin()) {
+        return nullptr;
+      }
+      --it;
+
+      found_key = it->first;
+      return &it->second;
+    }
+
+    void collect(uintptr_t first, uintptr_t last, std::vector<uintptr_t>& keys) override
+    {
+      for (auto it = lowerBound(first);
+          it != m_entries.end() && it->first < last; ++it) {
+        keys.push_back(it->first);
+      }
+    }
+
+    std::size_t getMemoryUsage() const override
+    {
+      return m_entries.capacity() * sizeof(Entry);
+    }
+
+  private:
+    using Entry = std::pair<uintptr_t, uintptr_t>;
+
+    std::vector<Entry>::iterator lowerBound(uintptr_t key)
+    {
+      return std::lower_bound(m_entries.begin(), m_entries.end(), key,
+          [] (const Entry& entry, uintptr_t k) { return entry.first < k; });
+    }
+
+    std::vector<Entry> m_entries;
+};
+
+std::unique_ptr<AllocationMap::RangeIndex>
+makeRangeIndex(AllocationMap::Backend backend)
+{
+  switch (backend) {
+    case AllocationMap::Backend::tree:
+      return std::unique_ptr<AllocationMap::RangeIndex>(new TreeRangeIndex());
+    case AllocationMap::Backend::sorted_vector:
+      return std::unique_ptr<AllocationMap::RangeIndex>(new SortedVectorRangeIndex());
+    case AllocationMap::Backend::judy:
+    default:
+      return std::unique_ptr<AllocationMap::RangeIndex>(new JudyRangeIndex());
+  }
+}
+
+} // end of anonymous namespace
+
+AllocationMap::ExactIndex::ExactIndex() :
+  m_slots(std::size_t(1) << s_exact_index_initial_bits, Slot{0, 0}),
+  m_size(0),
+  m_shift(64 - s_exact_index_initial_bits)
+{
+}
+
+std::size_t
+AllocationMap::ExactIndex::getIndex(uintptr_t key) const
+{
+  // Fibonacci hashing: base addresses are aligned, so take the high bits
+  // of the product, which depend on every bit of the key.
+  return static_cast<std::size_t>(
+      (static_cast<uint64_t>(key) * UINT64_C(0x9E3779B97F4A7C15)) >> m_shift);
+}
+
+uintptr_t
+AllocationMap::ExactIndex::find(uintptr_t key) const
+{
+  if (!key) {
+    return 0;
+  }
+
+  const std::size_t mask = m_slots.size() - 1;
+
+  for (std::size_t i = getIndex(key); ; i = (i + 1) & mask) {
+    const Slot& slot = m_slots[i];
+
+    if (slot.key == key) {
+      return slot.word;
+    } else if (!slot.key) {
+      return 0;
+    }
+  }
+}
+
+void
+AllocationMap::ExactIndex::set(uintptr_t key, uintptr_t word)
+{
+  if (!key) {
+    return;
+  }
+
+  if (2 * (m_size + 1) > m_slots.size()) {
+    grow();
+  }
+
+  const std::size_t mask = m_slots.size() - 1;
+
+  for (std::size_t i = getIndex(key); ; i = (i + 1) & mask) {
+    Slot& slot = m_slots[i];
+
+    if (slot.key == key) {
+      slot.word = word;
+      return;
+    } else if (!slot.key) {
+      slot.key = key;
+      slot.word = word;
+      ++m_size;
+      return;
+    }
+  }
+}
+
+void
+AllocationMap::ExactIndex::erase(uintptr_t key)
+{
+  if (!key) {
+    return;
+  }
+
+  const std::size_t mask = m_slots.size() - 1;
+
+  std::size_t hole = getIndex(key);
+  while (m_slots[hole].key != key) {
+    if (!m_slots[hole].key) {
+      return;
+    }
+    hole = (hole + 1) & mask;
+  }
+
+  // Shift back any later entry of the run that would no longer be
+  // reachable from its home slot across the hole.
+  for (std::size_t i = (hole + 1) & mask; m_slots[i].key; i = (i + 1) & mask) {
+    const std::size_t home = getIndex(m_slots[i].key);
+
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      m_slots[hole] = m_slots[i];
+      hole = i;
+    }
+  }
+
+  m_slots[hole] = Slot{0, 0};
+  --m_size;
+}
+
+void
+AllocationMap::ExactIndex::grow()
+{
+  std::vector<Slot> old_slots(2 * m_slots.size(), Slot{0, 0});
+  old_slots.swap(m_slots);
+
+  --m_shift;
+  m_size = 0;
+
+  for (const auto& slot : old_slots) {
+    if (slot.key) {
+      set(slot.key, slot.word);
+    }
+  }
+}
+
+std::size_t
+AllocationMap::ExactIndex::getMemoryUsage() const
+{
+  return m_slots.capacity() * sizeof(Slot);
+}
+
+AllocationMap::Shard::Shard() :
+  records(),
+  exact(),
+  pool(),
+  num_records(0),
+  vector_bytes(0),
+  last_strategy(nullptr),
+  last_strategy_id(0),
+  epoch(0),
+  mutex()
+{
+}
+
+AllocationMap::Shard::~Shard()
+{
+  if (records) {
+    releaseVectors();
+  }
+}
+
+void
+AllocationMap::Shard::releaseVectors()
+{
+  if (vector_bytes == 0) {
+    return;
+  }
+
+  // Vectors of duplicate records are owned through their words.
+  std::vector<uintptr_t> keys;
+  records->collect(0, UINTPTR_MAX, keys);
+
+  for (auto key : keys) {
+    const uintptr_t word = *records->find(key);
+
+    if ((word & s_word_tag_mask) == s_word_vector) {
+      delete getVector(word);
+    }
+  }
+
+  vector_bytes = 0;
+}
+
+AllocationMap::RecordPool::RecordPool() :
+  m_free_slots(nullptr),
+  m_slabs()
+{
+}
+
+AllocationMap::RecordPool::~RecordPool()
+{
+  clear();
+}
+
+void
+AllocationMap::RecordPool::clear()
+{
+  for (auto slab : m_slabs) {
+    ::free(slab);
+  }
+
+  m_slabs.clear();
+  m_free_slots = nullptr;
+}
+
+AllocationRecord*
+AllocationMap::RecordPool::allocate()
+{
+  if (!m_free_slots) {
+    Slot* slab = static_cast<Slot*>(::malloc(s_records_per_slab * sizeof(Slot)));
+
+    if (!slab) {
+      UMPIRE_ERROR("Cannot allocate AllocationRecord slab");
+    }
+
+    m_slabs.push_back(slab);
+
+    for (std::size_t i = 0; i < s_records_per_slab; ++i) {
+      slab[i].next = (i + 1 < s_records_per_slab) ? &slab[i+1] : nullptr;
+    }
+
+    m_free_slots = slab;
+  }
+
+  Slot* slot = m_free_slots;
+  m_free_slots = slot->next;
+
+  return &slot->record;
+}
+
+void
+AllocationMap::RecordPool::deallocate(AllocationRecord* record)
+{
+  Slot* slot = reinterpret_cast<Slot*>(record);
+  slot->next = m_free_slots;
+  m_free_slots = slot;
+}
+
+std::size_t
+AllocationMap::RecordPool::getMemoryUsage() const
+{
+  return m_slabs.size() * s_records_per_slab * sizeof(Slot)
+    + m_slabs.capacity() * sizeof(Slot*);
+}
+
+AllocationMap::AllocationMap(std::size_t num_shards, Backend backend, bool compact) :
+  m_id(s_next_map_id.fetch_add(1, std::memory_order_relaxed)),
+  m_num_shards(num_shards > 0 ? num_shards : 1),
+  m_backend(backend),
+  m_compact(compact),
+  m_shards(nullptr),
+  m_strategy_ids(),
+  m_strategies_mutex()
+{
+  m_shards = new Shard[m_num_shards];
+
+  for (std::size_t s = 0; s < m_num_shards; ++s) {
+    m_shards[s].records = makeRangeIndex(m_backend);
+  }
+
+  static_assert(s_strategy_chunks * s_strategies_per_chunk == s_max_strategies,
+      "strategy table must cover every id");
+
+  for (auto& chunk : m_strategies) {
+    chunk.store(nullptr, std::memory_order_relaxed);
+  }
 }
 
 AllocationMap::~AllocationMap()
 {
+  delete[] m_shards;
+
+  for (auto& chunk : m_strategies) {
+    delete[] chunk.load(std::memory_order_relaxed);
+  }
+}
+
+AllocationMap::Backend
+AllocationMap::getDefaultBackend()
+{
+  const char* name = std::getenv("UMPIRE_ALLOCATION_MAP_BACKEND");
+
+  if (name && *name) {
+    return getBackend(name);
+  }
+
+  return Backend::UMPIRE_ALLOCATION_MAP_BACKEND;
+}
+
+AllocationMap::Backend
+AllocationMap::getBackend(const std::string& name)
+{
+  if (name == "judy") {
+    return Backend::judy;
+  } else if (name == "tree") {
+    return Backend::tree;
+  } else if (name == "sorted_vector") {
+    return Backend::sorted_vector;
+  }
+
+  UMPIRE_ERROR("Unknown AllocationMap backend \"" << name
+      << "\", expected judy, tree or sorted_vector");
+}
+
+bool
+AllocationMap::getDefaultCompact()
+{
+  const char* value = std::getenv("UMPIRE_ALLOCATION_MAP_COMPACT");
+
+  if (value && *value) {
+    return std::string(value) == "1";
+  }
+
+#if defined(UMPIRE_ALLOCATION_MAP_COMPACT)
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::size_t
+AllocationMap::getShardIndex(uintptr_t address) const
+{
+  return (address >> s_shard_region_bits) % m_num_shards;
+}
+
+std::size_t
+AllocationMap::getShardSpan(uintptr_t address, std::size_t size) const
+{
+  if (m_num_shards == 1) {
+    return 1;
+  }
+
+  const uintptr_t first_region = address >> s_shard_region_bits;
+  const uintptr_t last_region =
+    (address + (size > 0 ? size - 1 : 0)) >> s_shard_region_bits;
+
+  const std::size_t regions = static_cast<std::size_t>(last_region - first_region) + 1;
+
+  return (regions < m_num_shards) ? regions : m_num_shards;
+}
+
+uintptr_t
+AllocationMap::getStrategyId(Shard& shard, strategy::AllocationStrategy* strategy)
+{
+  if (!strategy) {
+    return 0;
+  }
+
+  if (strategy == shard.last_strategy) {
+    return shard.last_strategy_id;
+  }
+
+  std::lock_guard<std::mutex> lock(m_strategies_mutex);
+
+  uintptr_t id;
+  auto it = m_strategy_ids.find(strategy);
+
+  if (it != m_strategy_ids.end()) {
+    id = it->second;
+  } else {
+    // Id 0 is nullptr, and a full table makes every new strategy fall back
+    // to unpacked records.
+    id = m_strategy_ids.size() + 1;
+    if (id == s_max_strategies) {
+      return id;
+    }
+
+    auto& chunk = m_strategies[id / s_strategies_per_chunk];
+    if (!chunk.load(std::memory_order_relaxed)) {
+      chunk.store(new strategy::AllocationStrategy*[s_strategies_per_chunk],
+          std::memory_order_release);
+    }
+
+    chunk.load(std::memory_order_relaxed)[id % s_strategies_per_chunk] = strategy;
+    m_strategy_ids[strategy] = id;
+  }
+
+  shard.last_strategy = strategy;
+  shard.last_strategy_id = id;
+
+  return id;
+}
+
+uintptr_t
+AllocationMap::makeWord(Shard& shard, const AllocationRecord& record)
+{
+  const int size_bits = static_cast<int>(sizeof(uintptr_t) * 8) - s_packed_size_shift;
+
+  if (m_compact && (static_cast<uint64_t>(record.m_size) >> size_bits) == 0) {
+    const uintptr_t id = getStrategyId(shard, record.m_strategy);
+
+    if (id < s_max_strategies) {
+      return (static_cast<uintptr_t>(record.m_size) << s_packed_size_shift)
+        | (id << 2) | s_word_packed;
+    }
+  }
+
+  AllocationRecord* alloc_record = shard.pool.allocate();
+  *alloc_record = record;
+
+  return reinterpret_cast<uintptr_t>(alloc_record);
+}
+
+AllocationRecord
+AllocationMap::getRecord(uintptr_t key, uintptr_t word) const
+{
+  if ((word & s_word_tag_mask) == s_word_packed) {
+    return AllocationRecord{
+      reinterpret_cast<void*>(key),
+      static_cast<std::size_t>(word >> s_packed_size_shift),
+      getStrategy(word)};
+  }
+
+  return *reinterpret_cast<AllocationRecord*>(word);
 }
 
 void
-AllocationMap::insert(void* ptr, AllocationRecord* alloc_record)
+AllocationMap::releaseWord(Shard& shard, uintptr_t word)
 {
-  try {
-    UMPIRE_LOCK;
+  if ((word & s_word_tag_mask) == s_word_record) {
+    shard.pool.deallocate(reinterpret_cast<AllocationRecord*>(word));
+  }
+}
 
-    UMPIRE_LOG(Debug, "Inserting " << ptr);
+std::size_t
+AllocationMap::getSize(uintptr_t word)
+{
+  if ((word & s_word_tag_mask) == s_word_packed) {
+    return static_cast<std::size_t>(word >> s_packed_size_shift);
+  }
 
-    m_records.insert(
-        reinterpret_cast<uintptr_t>(ptr),
-        reinterpret_cast<uintptr_t>(alloc_record));
+  return reinterpret_cast<AllocationRecord*>(word)->m_size;
+}
 
-    UMPIRE_UNLOCK;
-  } catch (...) {
-    UMPIRE_UNLOCK;
-    throw;
+strategy::AllocationStrategy*
+AllocationMap::getStrategy(uintptr_t word) const
+{
+  if ((word & s_word_tag_mask) == s_word_packed) {
+    const std::size_t id = (word >> 2) & (s_max_strategies - 1);
+    if (id == 0) {
+      return nullptr;
+    }
+
+    return m_strategies[id / s_strategies_per_chunk].load(
+        std::memory_order_acquire)[id % s_strategies_per_chunk];
+  }
+
+  return reinterpret_cast<AllocationRecord*>(word)->m_strategy;
+}
+
+void
+AllocationMap::append(Shard& shard, uintptr_t key, uintptr_t word)
+{
+  uintptr_t* slot = shard.records->find(key);
+
+  if (!slot) {
+    shard.records->insert(key, word);
+    return;
+  }
+
+  EntryVector* words;
+
+  if ((*slot & s_word_tag_mask) == s_word_vector) {
+    words = getVector(*slot);
+  } else {
+    words = new EntryVector(1, *slot);
+    shard.vector_bytes += sizeof(EntryVector) + words->capacity() * sizeof(uintptr_t);
+    *slot = reinterpret_cast<uintptr_t>(words) | s_word_vector;
+  }
+
+  shard.vector_bytes -= words->capacity() * sizeof(uintptr_t);
+  words->push_back(word);
+  shard.vector_bytes += words->capacity() * sizeof(uintptr_t);
+}
+
+uintptr_t
+AllocationMap::popBack(Shard& shard, uintptr_t key, uintptr_t& latest)
+{
+  uintptr_t* slot = shard.records->find(key);
+
+  latest = 0;
+
+  if (!slot) {
+    return 0;
+  }
+
+  if ((*slot & s_word_tag_mask) != s_word_vector) {
+    const uintptr_t word = *slot;
+    shard.records->remove(key);
+    return word;
+  }
+
+  EntryVector* words = getVector(*slot);
+
+  const uintptr_t word = words->back();
+  words->pop_back();
+
+  // A single record goes back to being stored directly.
+  if (words->size() == 1) {
+    *slot = words->front();
+    shard.vector_bytes -= sizeof(EntryVector) + words->capacity() * sizeof(uintptr_t);
+    delete words;
+
+    latest = *slot;
+  } else {
+    latest = words->back();
+  }
+
+  return word;
+}
+
+void
+AllocationMap::setWords(Shard& shard, uintptr_t key, const EntryVector& words)
+{
+  uintptr_t* slot = shard.records->find(key);
+
+  if ((*slot & s_word_tag_mask) == s_word_vector) {
+    EntryVector* old_words = getVector(*slot);
+    shard.vector_bytes -= sizeof(EntryVector) + old_words->capacity() * sizeof(uintptr_t);
+    delete old_words;
+  }
+
+  if (words.empty()) {
+    shard.records->remove(key);
+  } else if (words.size() == 1) {
+    *slot = words.front();
+  } else {
+    EntryVector* new_words = new EntryVector(words);
+    shard.vector_bytes += sizeof(EntryVector) + new_words->capacity() * sizeof(uintptr_t);
+    *slot = reinterpret_cast<uintptr_t>(new_words) | s_word_vector;
+  }
+}
+
+void
+AllocationMap::updateExact(Shard& shard, uintptr_t key)
+{
+  const uintptr_t* slot = shard.records->find(key);
+
+  if (slot) {
+    std::size_t count;
+    const uintptr_t* words = getWords(*slot, count);
+    shard.exact.set(key, words[count - 1]);
+  } else {
+    shard.exact.erase(key);
   }
 }
 
 AllocationRecord*
+AllocationMap::insert(void* ptr, const AllocationRecord& record)
+{
+  UMPIRE_LOG(Debug, "Inserting " << ptr);
+
+  const uintptr_t key = reinterpret_cast<uintptr_t>(ptr);
+  const std::size_t first_shard = getShardIndex(key);
+  const std::size_t span = getShardSpan(key, record.m_size);
+
+  uintptr_t word = 0;
+
+  for (std::size_t i = 0; i < span; ++i) {
+    Shard& shard = m_shards[(first_shard + i) % m_num_shards];
+
+    try {
+      shard.mutex.lock();
+
+      // the record is stored in the shard that owns its base address
+      if (i == 0) {
+        word = makeWord(shard, record);
+        shard.exact.set(key, word);
+        ++shard.num_records;
+      }
+
+      append(shard, key, word);
+      advanceEpoch(shard);
+
+      shard.mutex.unlock();
+    } catch (...) {
+      shard.mutex.unlock();
+      throw;
+    }
+  }
+
+  return ((word & s_word_tag_mask) == s_word_record) ?
+    reinterpret_cast<AllocationRecord*>(word) : nullptr;
+}
+
+AllocationRecord
 AllocationMap::remove(void* ptr)
 {
-  Entry ret = nullptr;
+  AllocationRecord ret{nullptr, 0, nullptr};
 
-  try {
-    UMPIRE_LOCK;
+  UMPIRE_LOG(Debug, "Removing " << ptr);
+
+  const uintptr_t key = reinterpret_cast<uintptr_t>(ptr);
+  const std::size_t first_shard = getShardIndex(key);
 
-    UMPIRE_LOG(Debug, "Removing " << ptr);
+  std::size_t span = 1;
 
-    EntryVector* record_vector =
-      const_cast<EntryVector*>(
-          m_records.find(reinterpret_cast<uintptr_t>(ptr)));
+  for (std::size_t i = 0; i < span; ++i) {
+    Shard& shard = m_shards[(first_shard + i) % m_num_shards];
 
-    if (record_vector) {
-      if (record_vector->size() > 0) {
+    try {
+      shard.mutex.lock();
 
-        ret = reinterpret_cast<Entry>(record_vector->back());
-        record_vector->pop_back();
+      uintptr_t latest = 0;
+      const uintptr_t word = popBack(shard, key, latest);
 
-        if (record_vector->empty()) {
-          m_records.removeEntry(reinterpret_cast<uintptr_t>(ptr));
+      if (!word) {
+        UMPIRE_ERROR("Cannot remove " << ptr );
+      }
+
+      advanceEpoch(shard);
+
+      if (i == 0) {
+        if (latest) {
+          shard.exact.set(key, latest);
+        } else {
+          shard.exact.erase(key);
         }
+
+        ret = getRecord(key, word);
+        span = getShardSpan(key, ret.m_size);
+
+        --shard.num_records;
+        releaseWord(shard, word);
       }
-    } else {
-      UMPIRE_ERROR("Cannot remove " << ptr );
+
+      shard.mutex.unlock();
+    } catch (...) {
+      shard.mutex.unlock();
+      throw;
     }
-    
-    UMPIRE_UNLOCK;
-  } catch (...) {
-    UMPIRE_UNLOCK;
-    throw;
   }
 
   return ret;
 }
 
-AllocationRecord*
-AllocationMap::findRecord(void* ptr)
+uintptr_t
+AllocationMap::findWord(void* ptr, uintptr_t& key)
 {
+  uintptr_t found_word = 0;
+
+  const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+  Shard& shard = m_shards[getShardIndex(address)];
 
-  Entry alloc_record = nullptr;
+  Lookaside& lookaside = t_lookaside;
+  const std::uint64_t current = shard.epoch.load(std::memory_order_acquire);
+
+  for (const auto& entry : lookaside.entries) {
+    if (entry.address == address && entry.map_id == m_id && entry.epoch == current) {
+      key = entry.key;
+      return entry.word;
+    }
+  }
+
+  std::uint64_t epoch = 0;
 
   try {
-    UMPIRE_LOCK;
-    auto record = m_records.atOrBefore(reinterpret_cast<uintptr_t>(ptr));
-    if (record.value) {
-      void* parent_ptr = reinterpret_cast<void*>(record.key);
-      alloc_record =
-        reinterpret_cast<Entry>(record.value->back());
+    shard.mutex.lock();
+
+    epoch = shard.epoch.load(std::memory_order_relaxed);
+    found_word = shard.exact.find(address);
 
-      if (alloc_record &&
-          ((static_cast<char*>(parent_ptr) + alloc_record->m_size)
-             > static_cast<char*>(ptr))) {
+    if (found_word) {
+      key = address;
+    } else {
+      uintptr_t parent_key = 0;
+      const uintptr_t* slot = shard.records->atOrBefore(address, parent_key);
+
+      // The most recent record at the base that covers ptr.
+      if (slot) {
+        std::size_t count;
+        const uintptr_t* words = getWords(*slot, count);
 
-         UMPIRE_LOG(Debug, "Found " << ptr << " at " << parent_ptr
-            << " with size " << alloc_record->m_size);
+        for (std::size_t i = count; i > 0; --i) {
+          const std::size_t size = getSize(words[i-1]);
 
+          if (parent_key + size > address) {
+            UMPIRE_LOG(Debug, "Found " << ptr << " at " << reinterpret_cast<void*>(parent_key)
+                << " with size " << size);
+            found_word = words[i-1];
+            key = parent_key;
+            break;
+          }
+        }
       }
     }
-    UMPIRE_UNLOCK;
+
+    shard.mutex.unlock();
   }
   catch (...){
-    UMPIRE_UNLOCK;
+    shard.mutex.unlock();
+    throw;
+  }
+
+  if (found_word) {
+    lookaside.entries[lookaside.next] =
+      LookasideEntry{m_id, epoch, address, key, found_word};
+    lookaside.next = (lookaside.next + 1) % s_lookaside_entries;
+  }
+
+  return found_word;
+}
+
+void
+AllocationMap::insertBatch(void** ptrs, const AllocationRecord* records, std::size_t count)
+{
+  UMPIRE_LOG(Debug, "Inserting " << count << " records");
+
+  lockAllShards();
+
+  try {
+    for (std::size_t r = 0; r < count; ++r) {
+      const uintptr_t key = reinterpret_cast<uintptr_t>(ptrs[r]);
+      const std::size_t first_shard = getShardIndex(key);
+      const std::size_t span = getShardSpan(key, records[r].m_size);
+
+      // the record is stored in the shard that owns its base address
+      Shard& owner = m_shards[first_shard];
+      const uintptr_t word = makeWord(owner, records[r]);
+      owner.exact.set(key, word);
+      ++owner.num_records;
+
+      for (std::size_t i = 0; i < span; ++i) {
+        Shard& shard = m_shards[(first_shard + i) % m_num_shards];
+        append(shard, key, word);
+        advanceEpoch(shard);
+      }
+    }
+  } catch (...) {
+    unlockAllShards();
+    throw;
+  }
+
+  unlockAllShards();
+}
+
+std::size_t
+AllocationMap::removeRange(void* begin, void* end,
+    strategy::AllocationStrategy* strategy)
+{
+  UMPIRE_LOG(Debug, "Removing [" << begin << ", " << end << ")");
+
+  const uintptr_t first = reinterpret_cast<uintptr_t>(begin);
+  const uintptr_t last = reinterpret_cast<uintptr_t>(end);
+
+  std::vector<uintptr_t> keys;
+  EntryVector words;
+  EntryVector kept;
+
+  // Records are returned to their pools only once every shard has dropped
+  // them, because a non-owning shard still reads them while filtering.
+  std::vector<std::pair<std::size_t, uintptr_t>> removed;
+
+  lockAllShards();
+
+  try {
+    for (std::size_t s = 0; s < m_num_shards; ++s) {
+      Shard& shard = m_shards[s];
+
+      // Collect first: removing entries would disturb the iteration.
+      keys.clear();
+      shard.records->collect(first, last, keys);
+
+      for (auto key : keys) {
+        std::size_t count;
+        const uintptr_t* current = getWords(*shard.records->find(key), count);
+        words.assign(current, current + count);
+
+        const bool owner = (getShardIndex(key) == s);
+        kept.clear();
+
+        for (auto word : words) {
+          if (strategy && getStrategy(word) != strategy) {
+            kept.push_back(word);
+          } else if (owner) {
+            removed.push_back(std::make_pair(s, word));
+          }
+        }
+
+        if (kept.size() != words.size()) {
+          setWords(shard, key, kept);
+          advanceEpoch(shard);
+
+          if (owner) {
+            updateExact(shard, key);
+          }
+        }
+      }
+    }
+
+    for (auto& entry : removed) {
+      Shard& owner = m_shards[entry.first];
+      --owner.num_records;
+      releaseWord(owner, entry.second);
+    }
+  } catch (...) {
+    unlockAllShards();
     throw;
   }
 
-  return alloc_record;
+  unlockAllShards();
+
+  return removed.size();
+}
+
+void
+AllocationMap::lockAllShards()
+{
+  // Always in index order, so two batch operations cannot deadlock.
+  for (std::size_t s = 0; s < m_num_shards; ++s) {
+    m_shards[s].mutex.lock();
+  }
+}
+
+void
+AllocationMap::unlockAllShards()
+{
+  for (std::size_t s = m_num_shards; s > 0; --s) {
+    m_shards[s-1].mutex.unlock();
+  }
 }
 
 AllocationRecord*
@@ -122,10 +1203,30 @@ AllocationMap::find(void* ptr)
 {
   UMPIRE_LOG(Debug, "Searching for " << ptr);
 
-  auto alloc_record = findRecord(ptr);
+  if (m_compact) {
+    UMPIRE_ERROR("Records in a compact AllocationMap have no address, use get to find " << ptr);
+  }
+
+  uintptr_t key;
+  const uintptr_t word = findWord(ptr, key);
+
+  if (word) {
+    return reinterpret_cast<AllocationRecord*>(word);
+  } else {
+    UMPIRE_ERROR("Allocation not mapped: " << ptr);
+  }
+}
+
+AllocationRecord
+AllocationMap::get(void* ptr)
+{
+  UMPIRE_LOG(Debug, "Searching for " << ptr);
+
+  uintptr_t key;
+  const uintptr_t word = findWord(ptr, key);
 
-  if (alloc_record) {
-    return alloc_record;
+  if (word) {
+    return getRecord(key, word);
   } else {
     UMPIRE_ERROR("Allocation not mapped: " << ptr);
   }
@@ -136,7 +1237,80 @@ AllocationMap::contains(void* ptr)
 {
   UMPIRE_LOG(Debug, "Searching for " << ptr);
 
-  return (findRecord(ptr) != nullptr);
+  uintptr_t key;
+  return (findWord(ptr, key) != 0);
+}
+
+void
+AllocationMap::reset()
+{
+  UMPIRE_LOG(Debug, "Removing every record");
+
+  lockAllShards();
+
+  try {
+    for (std::size_t s = 0; s < m_num_shards; ++s) {
+      Shard& shard = m_shards[s];
+
+      shard.releaseVectors();
+      shard.records = makeRangeIndex(m_backend);
+      shard.exact = ExactIndex();
+      shard.pool.clear();
+      shard.num_records = 0;
+
+      advanceEpoch(shard);
+    }
+  } catch (...) {
+    unlockAllShards();
+    throw;
+  }
+
+  unlockAllShards();
+}
+
+std::size_t
+AllocationMap::getNumShards() const
+{
+  return m_num_shards;
+}
+
+AllocationMap::Backend
+AllocationMap::getBackendType() const
+{
+  return m_backend;
+}
+
+bool
+AllocationMap::isCompact() const
+{
+  return m_compact;
+}
+
+AllocationMap::Statistics
+AllocationMap::getStatistics()
+{
+  Statistics statistics{0, sizeof(AllocationMap) + m_num_shards * sizeof(Shard)};
+
+  for (auto& chunk : m_strategies) {
+    if (chunk.load(std::memory_order_acquire)) {
+      statistics.num_bytes +=
+        s_strategies_per_chunk * sizeof(strategy::AllocationStrategy*);
+    }
+  }
+
+  for (std::size_t s = 0; s < m_num_shards; ++s) {
+    Shard& shard = m_shards[s];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    statistics.num_records += shard.num_records;
+    statistics.num_bytes += shard.records->getMemoryUsage()
+      + shard.exact.getMemoryUsage()
+      + shard.pool.getMemoryUsage()
+      + shard.vector_bytes;
+  }
+
+  return statistics;
 }
 
 } // end of namespace util
@@ -17,45 +17,420 @@
 
 #include "umpire/util/AllocationRecord.hpp"
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <mutex>
-
-#include "umpire/tpl/judy/judyL2Array.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace umpire {
 namespace util {
 
+/*!
+ * \brief Map from pointers to the AllocationRecord objects describing them.
+ *
+ * The map can be split into a number of shards, each protected by its own
+ * mutex. Addresses are assigned to shards by the region of memory they fall
+ * in, so lookups made by different threads on unrelated allocations do not
+ * contend on a single lock. A record is inserted into every shard covering
+ * its address range, which means that offset pointers can always be resolved
+ * by searching the shard that the pointer itself belongs to.
+ *
+ * Each shard keeps its records in two structures. An ordered index, whose
+ * implementation is chosen by Backend, answers range queries for pointers
+ * offset into an allocation. In front of it, an open-addressing hash table
+ * maps each base address in the shard to its most recent record, so the
+ * common lookups (deallocate, getSize) on an exact base pointer cost a
+ * single probe.
+ *
+ * Both structures hold one word per address. It points to the record, or,
+ * only while several records share the address, to an EntryVector holding
+ * all of them. In compact mode a record whose size fits in 46 bits is packed
+ * into the word itself together with a 16-bit strategy id, so it takes no
+ * memory beyond the index entries. Packed records have no address, which
+ * is why a compact map must be searched with get rather than find.
+ *
+ * Each thread also remembers its last few successful lookups. Every change
+ * to a shard advances the shard's epoch, and a remembered lookup is only
+ * used while the epoch of its shard is unchanged, so looking the same
+ * pointer up again costs a few compares and takes no lock.
+ */
 class AllocationMap
 {
   public:
-    using AddressPair = judyL2Array<uintptr_t, uintptr_t>::cpair;
-    using EntryVector = judyL2Array<uintptr_t, uintptr_t>::vector;
-    using Entry = AllocationRecord*;
+    using EntryVector = std::vector<uintptr_t>;
+
+    /*!
+     * \brief Ordered index used for range queries.
+     *
+     * judy is a Judy array, tree a balanced binary tree (std::map) and
+     * sorted_vector a vector kept sorted by address, which is the most
+     * compact and fastest to search but makes insertion linear in the
+     * number of allocations.
+     */
+    enum class Backend {
+      judy,
+      tree,
+      sorted_vector
+    };
+
+    /*!
+     * \brief Ordered map from base address to the word describing the
+     * records at that address. Implemented once per Backend.
+     */
+    class RangeIndex;
+
+    /*!
+     * \brief Size of the map, see getStatistics.
+     */
+    struct Statistics {
+      std::size_t num_records;
 
-  AllocationMap();
+      /*!
+       * \brief Bytes of bookkeeping memory held by the map: records, index
+       * nodes, hash tables and vectors of duplicate records.
+       */
+      std::size_t num_bytes;
+    };
+
+  /*!
+   * \brief Construct an AllocationMap.
+   *
+   * \param num_shards Number of independently locked shards to use. The
+   * default of one shard gives a single, globally locked map.
+   * \param backend Ordered index to use in each shard.
+   * \param compact Whether to pack records into the index, see isCompact.
+   */
+  AllocationMap(std::size_t num_shards = 1,
+      Backend backend = getDefaultBackend(),
+      bool compact = getDefaultCompact());
   ~AllocationMap();
 
-  void
-  insert(void* ptr, AllocationRecord* record);
+  /*!
+   * \brief Return the Backend named by the UMPIRE_ALLOCATION_MAP_BACKEND
+   * environment variable, or the one chosen at build time with
+   * ALLOCATION_MAP_BACKEND if it is not set.
+   */
+  static Backend getDefaultBackend();
+
+  /*!
+   * \brief Return the Backend called name ("judy", "tree" or
+   * "sorted_vector").
+   *
+   * Throws an umpire::util::Exception for any other name.
+   */
+  static Backend getBackend(const std::string& name);
+
+  /*!
+   * \brief Return whether the UMPIRE_ALLOCATION_MAP_COMPACT environment
+   * variable is set to 1, or, if it is not set, whether Umpire was built
+   * with ALLOCATION_MAP_COMPACT.
+   */
+  static bool getDefaultCompact();
 
+  /*!
+   * \brief Insert a copy of record for ptr.
+   *
+   * \return Pointer to the record stored in the map, or nullptr if the
+   * record was packed (compact mode only).
+   */
   AllocationRecord*
+  insert(void* ptr, const AllocationRecord& record);
+
+  /*!
+   * \brief Remove the most recently inserted record for ptr.
+   *
+   * \return Copy of the removed record.
+   */
+  AllocationRecord
   remove(void* ptr);
 
+  /*!
+   * \brief Insert a copy of records[i] for ptrs[i], for i below count.
+   *
+   * Each shard is locked once for the whole batch rather than once per
+   * record.
+   */
+  void
+  insertBatch(void** ptrs, const AllocationRecord* records, std::size_t count);
+
+  /*!
+   * \brief Remove every record whose pointer lies in [begin, end).
+   *
+   * Each shard is locked once, and all shards are held together so no
+   * other thread sees a partly removed range.
+   *
+   * \param strategy If not nullptr, only records made by this strategy
+   * are removed, so a pool can drop its allocations without touching the
+   * record of the chunk that holds them.
+   *
+   * \return Number of records removed.
+   */
+  std::size_t
+  removeRange(void* begin, void* end,
+      strategy::AllocationStrategy* strategy = nullptr);
+
+  /*!
+   * \brief Return the record of the allocation containing ptr.
+   *
+   * Throws an umpire::util::Exception if there is none, or if the map is
+   * compact.
+   */
   AllocationRecord*
   find(void* ptr);
 
+  /*!
+   * \brief Return a copy of the record of the allocation containing ptr.
+   *
+   * Works in both modes. Throws an umpire::util::Exception if there is no
+   * such allocation.
+   */
+  AllocationRecord
+  get(void* ptr);
+
   bool
   contains(void* ptr);
 
+  /*!
+   * \brief Remove every record.
+   *
+   * Each shard frees its index, hash table and record slabs whole instead
+   * of removing records one at a time, so this takes milliseconds even
+   * with millions of records. Used by ResourceManager::shutdown.
+   */
   void
-    reset();
+  reset();
+
+  std::size_t
+  getNumShards() const;
+
+  Backend
+  getBackendType() const;
+
+  /*!
+   * \brief Return whether records are packed into the index.
+   */
+  bool
+  isCompact() const;
+
+  /*!
+   * \brief Return the number of records and the bytes used to store them.
+   *
+   * Locks every shard in turn.
+   */
+  Statistics
+  getStatistics();
 
   private:
-    AllocationRecord* findRecord(void* ptr);
+    /*!
+     * \brief Freelist of AllocationRecord slots, carved out of fixed-size
+     * slabs that are only returned when the map is destroyed.
+     */
+    class RecordPool
+    {
+      public:
+        RecordPool();
+        ~RecordPool();
+
+        AllocationRecord* allocate();
+        void deallocate(AllocationRecord* record);
+
+        /*!
+         * \brief Free every slab, and with them every record.
+         */
+        void clear();
+
+        std::size_t getMemoryUsage() const;
+
+      private:
+        union Slot
+        {
+          AllocationRecord record;
+          Slot* next;
+        };
+
+        Slot* m_free_slots;
+        std::vector<Slot*> m_slabs;
+    };
+
+    /*!
+     * \brief Open-addressing hash table from base address to the word of
+     * the most recent record at that address.
+     *
+     * Linear probing with backward-shift deletion, so there are no
+     * tombstones and a miss stops at the first empty slot. The null
+     * address is never stored.
+     */
+    class ExactIndex
+    {
+      public:
+        ExactIndex();
+
+        /*!
+         * \brief Return the word for key, or 0 if there is none.
+         */
+        uintptr_t find(uintptr_t key) const;
+
+        /*!
+         * \brief Map key to word, replacing any word it had.
+         */
+        void set(uintptr_t key, uintptr_t word);
+
+        void erase(uintptr_t key);
+
+        std::size_t getMemoryUsage() const;
+
+      private:
+        struct Slot
+        {
+          uintptr_t key;
+          uintptr_t word;
+        };
+
+        std::size_t getIndex(uintptr_t key) const;
+
+        void grow();
+
+        std::vector<Slot> m_slots;
+        std::size_t m_size;
+        int m_shift;
+    };
+
+    struct Shard
+    {
+      Shard();
+      ~Shard();
+
+      /*!
+       * \brief Delete the vectors of duplicate records owned by the words
+       * in this shard's index.
+       */
+      void releaseVectors();
+
+      std::unique_ptr<RangeIndex> records;
+      ExactIndex exact;
+      RecordPool pool;
+
+      /*!
+       * \brief Records whose base address is in this shard.
+       */
+      std::size_t num_records;
+
+      /*!
+       * \brief Bytes held by the EntryVectors of this shard.
+       */
+      std::size_t vector_bytes;
+
+      /*!
+       * \brief Last strategy given an id by this shard, so that runs of
+       * inserts from one strategy skip the id table lock.
+       */
+      strategy::AllocationStrategy* last_strategy;
+      uintptr_t last_strategy_id;
+
+      /*!
+       * \brief Advanced, under the mutex, whenever the records visible from
+       * this shard change.
+       */
+      std::atomic<std::uint64_t> epoch;
+
+      std::mutex mutex;
+    };
+
+    /*!
+     * \brief Return a word describing record, packing it if possible and
+     * otherwise storing it in the RecordPool of shard.
+     */
+    uintptr_t makeWord(Shard& shard, const AllocationRecord& record);
+
+    /*!
+     * \brief Return the record described by word, whose base is key.
+     */
+    AllocationRecord getRecord(uintptr_t key, uintptr_t word) const;
+
+    /*!
+     * \brief Free the storage of a word made by makeWord for shard.
+     */
+    static void releaseWord(Shard& shard, uintptr_t word);
+
+    static std::size_t getSize(uintptr_t word);
+
+    strategy::AllocationStrategy* getStrategy(uintptr_t word) const;
+
+    /*!
+     * \brief Return the id of strategy in the compact strategy table,
+     * adding it if needed.
+     */
+    uintptr_t getStrategyId(Shard& shard, strategy::AllocationStrategy* strategy);
+
+    /*!
+     * \brief Add word to the records at key in shard.
+     */
+    static void append(Shard& shard, uintptr_t key, uintptr_t word);
+
+    /*!
+     * \brief Remove and return the most recent word at key in shard, or 0
+     * if there is none, and set latest to the word left most recent, or 0.
+     */
+    static uintptr_t popBack(Shard& shard, uintptr_t key, uintptr_t& latest);
+
+    /*!
+     * \brief Replace the words at key in shard by words, which may be
+     * empty.
+     */
+    static void setWords(Shard& shard, uintptr_t key, const EntryVector& words);
+
+    /*!
+     * \brief Point the exact index of shard at the most recent word left
+     * for key, or drop key if none are left.
+     */
+    static void updateExact(Shard& shard, uintptr_t key);
+
+    /*!
+     * \brief Return the word of the record containing ptr, and set key to
+     * its base, or return 0.
+     */
+    uintptr_t findWord(void* ptr, uintptr_t& key);
+
+    void lockAllShards();
+    void unlockAllShards();
+
+    std::size_t getShardIndex(uintptr_t address) const;
+
+    /*!
+     * \brief Number of shards that the range [address, address+size) touches.
+     */
+    std::size_t getShardSpan(uintptr_t address, std::size_t size) const;
+
+    /*!
+     * \brief Identifies this map in the per-thread lookup cache, so the
+     * cache is never consulted by another map at the same address.
+     */
+    const std::uint64_t m_id;
+
+    std::size_t m_num_shards;
+
+    Backend m_backend;
+
+    bool m_compact;
+
+    Shard* m_shards;
 
-    judyL2Array<uintptr_t, uintptr_t> m_records;
+    static const std::size_t s_strategy_chunks = 256;
 
-    std::mutex* m_mutex;
+    /*!
+     * \brief Strategies of packed records by id, in chunks that are
+     * allocated on demand. Id 0 is nullptr.
+     *
+     * Each entry is written once, before any record with its id is
+     * inserted, so readers need no lock.
+     */
+    std::atomic<strategy::AllocationStrategy**> m_strategies[s_strategy_chunks];
+    std::unordered_map<strategy::AllocationStrategy*, uintptr_t> m_strategy_ids;
+    std::mutex m_strategies_mutex;
 };
 
 } // end of namespace util
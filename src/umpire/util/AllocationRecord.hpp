@@ -17,8 +17,6 @@
 
 #include <cstddef>
 
-#include <memory>
-
 namespace umpire {
 
 namespace strategy {
@@ -27,11 +25,19 @@ namespace strategy {
 
 namespace util {
 
+/*!
+ * \brief Bookkeeping information for a single allocation.
+ *
+ * Records are stored by value in the AllocationMap. The strategy is held
+ * through a raw pointer: the ResourceManager owns every AllocationStrategy for
+ * the lifetime of the allocations it makes, and avoiding a shared_ptr keeps
+ * the registration path free of atomic reference counting.
+ */
 struct AllocationRecord
 {
   void* m_ptr;
   size_t m_size;
-  std::shared_ptr<strategy::AllocationStrategy> m_strategy;
+  strategy::AllocationStrategy* m_strategy;
 };
 
 } // end of namespace util
@@ -0,0 +1,233 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/util/AllocatorStatistics.hpp"
+
+#include "umpire/util/Macros.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <unordered_map>
+
+namespace umpire {
+namespace util {
+
+namespace {
+
+std::atomic<unsigned long> s_next_serial(0);
+
+inline void relaxedAdd(std::atomic<uint64_t>& counter, uint64_t value)
+{
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+      std::memory_order_relaxed);
+}
+
+} // end of anonymous namespace
+
+const int Histogram::s_num_buckets;
+
+int
+Histogram::getBucket(uint64_t value)
+{
+  if (value == 0) {
+    return 0;
+  }
+
+#if defined(__GNUC__)
+  const int bucket = 64 - __builtin_clzll(value);
+#else
+  int bucket = 0;
+  while (value) {
+    value >>= 1;
+    ++bucket;
+  }
+#endif
+
+  return bucket < s_num_buckets ? bucket : s_num_buckets - 1;
+}
+
+double
+Histogram::getMean() const
+{
+  return count ? static_cast<double>(sum) / count : 0.0;
+}
+
+uint64_t
+Histogram::getPercentile(double percentile) const
+{
+  if (count == 0) {
+    return 0;
+  }
+
+  const double rank = percentile / 100.0 * count;
+  uint64_t seen = 0;
+
+  for (int i = 0; i < s_num_buckets; ++i) {
+    seen += buckets[i];
+    if (seen > 0 && seen >= rank) {
+      if (i == 0) {
+        return 0;
+      }
+      const uint64_t top =
+        (i < s_num_buckets - 1) ? ((uint64_t{1} << i) - 1) : max;
+      return top < max ? top : max;
+    }
+  }
+
+  return max;
+}
+
+AllocatorStatistics::Shard::Shard()
+{
+  for (int kind = 0; kind < num_kinds; ++kind) {
+    count[kind].store(0, std::memory_order_relaxed);
+    sum[kind].store(0, std::memory_order_relaxed);
+    max[kind].store(0, std::memory_order_relaxed);
+    for (int i = 0; i < Histogram::s_num_buckets; ++i) {
+      buckets[kind][i].store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+void
+AllocatorStatistics::Shard::add(Kind kind, uint64_t value)
+{
+  relaxedAdd(count[kind], 1);
+  relaxedAdd(sum[kind], value);
+  relaxedAdd(buckets[kind][Histogram::getBucket(value)], 1);
+
+  if (value > max[kind].load(std::memory_order_relaxed)) {
+    max[kind].store(value, std::memory_order_relaxed);
+  }
+}
+
+void
+AllocatorStatistics::Shard::mergeInto(Kind kind, Histogram& histogram) const
+{
+  histogram.count += count[kind].load(std::memory_order_relaxed);
+  histogram.sum += sum[kind].load(std::memory_order_relaxed);
+
+  const uint64_t shard_max = max[kind].load(std::memory_order_relaxed);
+  if (shard_max > histogram.max) {
+    histogram.max = shard_max;
+  }
+
+  for (int i = 0; i < Histogram::s_num_buckets; ++i) {
+    histogram.buckets[i] += buckets[kind][i].load(std::memory_order_relaxed);
+  }
+}
+
+AllocatorStatistics::AllocatorStatistics() :
+  m_serial(++s_next_serial),
+  m_shards(),
+  m_mutex(new std::mutex())
+{
+}
+
+AllocatorStatistics::~AllocatorStatistics()
+{
+  for (auto shard : m_shards) {
+    delete shard;
+  }
+
+  delete m_mutex;
+}
+
+void
+AllocatorStatistics::recordAllocate(uint64_t nanoseconds, uint64_t bytes)
+{
+  Shard* shard = getShard();
+  shard->add(allocate_ns, nanoseconds);
+  shard->add(allocation_bytes, bytes);
+}
+
+void
+AllocatorStatistics::recordDeallocate(uint64_t nanoseconds)
+{
+  getShard()->add(deallocate_ns, nanoseconds);
+}
+
+void
+AllocatorStatistics::recordCopy(uint64_t nanoseconds)
+{
+  getShard()->add(copy_ns, nanoseconds);
+}
+
+AllocatorStatistics::Summary
+AllocatorStatistics::getSummary()
+{
+  Summary summary;
+  std::memset(&summary, 0, sizeof(summary));
+
+  try {
+    UMPIRE_LOCK;
+
+    for (auto shard : m_shards) {
+      shard->mergeInto(allocate_ns, summary.allocate_ns);
+      shard->mergeInto(deallocate_ns, summary.deallocate_ns);
+      shard->mergeInto(copy_ns, summary.copy_ns);
+      shard->mergeInto(allocation_bytes, summary.allocation_bytes);
+    }
+
+    UMPIRE_UNLOCK;
+  } catch (...) {
+    UMPIRE_UNLOCK;
+    throw;
+  }
+
+  return summary;
+}
+
+uint64_t
+AllocatorStatistics::now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+AllocatorStatistics::Shard*
+AllocatorStatistics::getShard()
+{
+  // Serials start at 1, so a fresh thread never matches the memo.
+  static thread_local unsigned long t_last_serial = 0;
+  static thread_local Shard* t_last_shard = nullptr;
+  static thread_local std::unordered_map<unsigned long, Shard*> t_shards;
+
+  if (t_last_serial != m_serial) {
+    Shard*& shard = t_shards[m_serial];
+
+    if (!shard) {
+      shard = new Shard();
+
+      try {
+        UMPIRE_LOCK;
+
+        m_shards.push_back(shard);
+
+        UMPIRE_UNLOCK;
+      } catch (...) {
+        UMPIRE_UNLOCK;
+        throw;
+      }
+    }
+
+    t_last_serial = m_serial;
+    t_last_shard = shard;
+  }
+
+  return t_last_shard;
+}
+
+} // end of namespace util
+} // end of namespace umpire
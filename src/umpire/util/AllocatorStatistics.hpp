@@ -0,0 +1,134 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_AllocatorStatistics_HPP
+#define UMPIRE_AllocatorStatistics_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace umpire {
+namespace util {
+
+/*!
+ * \brief A log2 histogram of unsigned values.
+ *
+ * Bucket 0 counts zeros, and bucket i > 0 counts values in
+ * [2^(i-1), 2^i). The last bucket also holds everything larger.
+ */
+struct Histogram {
+  static const int s_num_buckets = 64;
+
+  uint64_t count;
+  uint64_t sum;
+  uint64_t max;
+  uint64_t buckets[s_num_buckets];
+
+  /*!
+   * \brief Return the bucket that value falls in.
+   */
+  static int getBucket(uint64_t value);
+
+  /*!
+   * \brief Return the mean of all values, or 0 if there are none.
+   */
+  double getMean() const;
+
+  /*!
+   * \brief Return an upper bound on the given percentile (0 to 100).
+   *
+   * The bound is the top of the bucket holding the percentile, capped at
+   * max, so it is within a factor of two of the exact value.
+   */
+  uint64_t getPercentile(double percentile) const;
+};
+
+/*!
+ * \brief Latency and size histograms for one Allocator.
+ *
+ * Each recording thread updates its own shard, so recording takes no lock
+ * and shares no cache lines; getSummary merges the shards. Shards live
+ * until the AllocatorStatistics is destroyed.
+ */
+class AllocatorStatistics {
+  public:
+    /*!
+     * \brief All histograms of an Allocator, merged across threads.
+     *
+     * Latencies are in nanoseconds.
+     */
+    struct Summary {
+      Histogram allocate_ns;
+      Histogram deallocate_ns;
+      Histogram copy_ns;
+      Histogram allocation_bytes;
+    };
+
+    AllocatorStatistics();
+    ~AllocatorStatistics();
+
+    AllocatorStatistics(const AllocatorStatistics&) = delete;
+    AllocatorStatistics& operator=(const AllocatorStatistics&) = delete;
+
+    void recordAllocate(uint64_t nanoseconds, uint64_t bytes);
+    void recordDeallocate(uint64_t nanoseconds);
+    void recordCopy(uint64_t nanoseconds);
+
+    Summary getSummary();
+
+    /*!
+     * \brief Return the current time in nanoseconds from a steady clock.
+     */
+    static uint64_t now();
+
+  private:
+    enum Kind {
+      allocate_ns = 0,
+      deallocate_ns,
+      copy_ns,
+      allocation_bytes,
+      num_kinds
+    };
+
+    /*!
+     * Only the owning thread writes a shard, so updates are relaxed loads
+     * and stores rather than read-modify-write operations.
+     */
+    struct Shard {
+      std::atomic<uint64_t> count[num_kinds];
+      std::atomic<uint64_t> sum[num_kinds];
+      std::atomic<uint64_t> max[num_kinds];
+      std::atomic<uint64_t> buckets[num_kinds][Histogram::s_num_buckets];
+
+      Shard();
+      void add(Kind kind, uint64_t value);
+      void mergeInto(Kind kind, Histogram& histogram) const;
+    };
+
+    Shard* getShard();
+
+    const unsigned long m_serial;
+
+    std::vector<Shard*> m_shards;
+
+    std::mutex* m_mutex;
+};
+
+} // end of namespace util
+} // end of namespace umpire
+
+#endif // UMPIRE_AllocatorStatistics_HPP
@@ -0,0 +1,54 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_AtomicStatistics_HPP
+#define UMPIRE_AtomicStatistics_HPP
+
+#include <atomic>
+
+namespace umpire {
+namespace util {
+
+/*!
+ * \brief Add bytes to current_size and raise highwatermark to match.
+ *
+ * Both counters only feed statistics, so relaxed ordering is enough: each
+ * update is atomic, but orders no other memory.
+ */
+inline void increaseSize(
+    std::atomic<long>& current_size,
+    std::atomic<long>& highwatermark,
+    long bytes)
+{
+  const long size =
+    current_size.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+  long peak = highwatermark.load(std::memory_order_relaxed);
+  while (size > peak &&
+      !highwatermark.compare_exchange_weak(peak, size, std::memory_order_relaxed)) {
+  }
+}
+
+/*!
+ * \brief Subtract bytes from current_size.
+ */
+inline void decreaseSize(std::atomic<long>& current_size, long bytes)
+{
+  current_size.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+} // end of namespace util
+} // end of namespace umpire
+
+#endif // UMPIRE_AtomicStatistics_HPP
@@ -0,0 +1,209 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/util/ChunkRegistry.hpp"
+
+#include "umpire/strategy/AllocationStrategy.hpp"
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace util {
+
+ChunkRegistry::ChunkRegistry() :
+  m_mutex(),
+  m_retired()
+{
+  for (auto& leaf : m_root) {
+    leaf.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+ChunkRegistry::~ChunkRegistry()
+{
+  for (auto& entry : m_root) {
+    Leaf* leaf = entry.load(std::memory_order_relaxed);
+    if (!leaf) {
+      continue;
+    }
+
+    for (auto& head : leaf->heads) {
+      Chunk* chunk = head.load(std::memory_order_relaxed);
+      while (chunk) {
+        Chunk* next = chunk->next.load(std::memory_order_relaxed);
+        delete chunk;
+        chunk = next;
+      }
+    }
+
+    delete leaf;
+  }
+}
+
+std::atomic<ChunkRegistry::Chunk*>*
+ChunkRegistry::getHead(uintptr_t region, bool create)
+{
+  auto& entry = m_root[region >> s_leaf_bits];
+  Leaf* leaf = entry.load(std::memory_order_acquire);
+
+  if (!leaf) {
+    if (!create) {
+      return nullptr;
+    }
+
+    leaf = new Leaf;
+    for (auto& head : leaf->heads) {
+      head.store(nullptr, std::memory_order_relaxed);
+    }
+    entry.store(leaf, std::memory_order_release);
+  }
+
+  return &leaf->heads[region & ((uintptr_t{1} << s_leaf_bits) - 1)];
+}
+
+const std::atomic<ChunkRegistry::Chunk*>*
+ChunkRegistry::getHead(uintptr_t region) const
+{
+  const Leaf* leaf = m_root[region >> s_leaf_bits].load(std::memory_order_acquire);
+
+  return leaf ? &leaf->heads[region & ((uintptr_t{1} << s_leaf_bits) - 1)] : nullptr;
+}
+
+void
+ChunkRegistry::insert(void* ptr, std::size_t size,
+    strategy::AllocationStrategy* strategy, void* handle)
+{
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+  const uintptr_t end = begin + size;
+
+  if (size == 0) {
+    return;
+  }
+
+  if ((end - 1) >> s_address_bits) {
+    UMPIRE_ERROR("Cannot register chunk " << ptr << " of size " << size
+        << ", addresses are limited to " << s_address_bits << " bits");
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  // One list node per region the chunk overlaps, pushed to the front so that
+  // chunks nested inside another registered chunk are checked first.
+  for (uintptr_t region = begin >> s_region_bits;
+       region <= ((end - 1) >> s_region_bits); ++region) {
+    auto head = getHead(region, true);
+
+    Chunk* chunk = new Chunk;
+    chunk->begin = begin;
+    chunk->end = end;
+    chunk->strategy = strategy;
+    chunk->handle = handle;
+    chunk->next.store(head->load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    head->store(chunk, std::memory_order_release);
+  }
+}
+
+void
+ChunkRegistry::remove(void* ptr, strategy::AllocationStrategy* strategy)
+{
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  uintptr_t end = 0;
+
+  for (uintptr_t region = begin >> s_region_bits;
+       end == 0 || region <= ((end - 1) >> s_region_bits); ++region) {
+    auto link = getHead(region, false);
+
+    while (link) {
+      Chunk* chunk = link->load(std::memory_order_relaxed);
+
+      if (!chunk) {
+        link = nullptr;
+      } else if (chunk->begin == begin && chunk->strategy == strategy) {
+        // Readers may still be looking at chunk, so leave its next pointer
+        // intact and keep it alive.
+        end = chunk->end;
+        link->store(chunk->next.load(std::memory_order_relaxed), std::memory_order_release);
+        m_retired.emplace_back(chunk);
+        break;
+      } else {
+        link = &chunk->next;
+      }
+    }
+
+    if (!link) {
+      if (end == 0) {
+        UMPIRE_ERROR("Cannot remove chunk " << ptr << ", it was not registered");
+      }
+      break;
+    }
+  }
+}
+
+AllocationRecord*
+ChunkRegistry::find(void* ptr) const
+{
+  const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+
+  if (address >> s_address_bits) {
+    return nullptr;
+  }
+
+  auto head = getHead(address >> s_region_bits);
+  if (!head) {
+    return nullptr;
+  }
+
+  for (const Chunk* chunk = head->load(std::memory_order_acquire);
+       chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+    if (address >= chunk->begin && address < chunk->end) {
+      AllocationRecord* record = chunk->strategy->findRecord(ptr, chunk->handle);
+      if (record) {
+        return record;
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+void*
+ChunkRegistry::findHandle(void* ptr, const strategy::AllocationStrategy* strategy) const
+{
+  const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+
+  if (address >> s_address_bits) {
+    return nullptr;
+  }
+
+  auto head = getHead(address >> s_region_bits);
+  if (!head) {
+    return nullptr;
+  }
+
+  for (const Chunk* chunk = head->load(std::memory_order_acquire);
+       chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+    if (address >= chunk->begin && address < chunk->end && chunk->strategy == strategy) {
+      return chunk->handle;
+    }
+  }
+
+  return nullptr;
+}
+
+} // end of namespace util
+} // end of namespace umpire
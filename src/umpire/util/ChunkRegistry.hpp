@@ -0,0 +1,117 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_ChunkRegistry_HPP
+#define UMPIRE_ChunkRegistry_HPP
+
+#include "umpire/util/AllocationRecord.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace umpire {
+
+namespace strategy {
+  class AllocationStrategy;
+}
+
+namespace util {
+
+/*!
+ * \brief Sparse table from address ranges to the strategies that own them.
+ *
+ * Pools that can resolve pointers into their own memory register each chunk
+ * they obtain from their parent here, instead of registering every
+ * allocation in the AllocationMap. A lookup finds the 2MB region that a
+ * pointer falls in through a two-level radix table, walks the (usually
+ * single-entry) list of chunks overlapping that region and asks the owning
+ * strategy for the record, see AllocationStrategy::findRecord.
+ *
+ * Lookups take no locks. Chunks are inserted and removed under a mutex, and
+ * removed list nodes are kept until the registry is destroyed so that
+ * concurrent readers never follow a dangling pointer. Chunks are expected to
+ * be large and long lived, which keeps this small.
+ */
+class ChunkRegistry
+{
+  public:
+    ChunkRegistry();
+
+    ~ChunkRegistry();
+
+    ChunkRegistry(const ChunkRegistry&) = delete;
+    ChunkRegistry& operator=(const ChunkRegistry&) = delete;
+
+    /*!
+     * \brief Register the chunk [ptr, ptr + size) as owned by strategy.
+     *
+     * \param handle Passed back to AllocationStrategy::findRecord for
+     * pointers inside this chunk.
+     */
+    void insert(void* ptr, std::size_t size,
+        strategy::AllocationStrategy* strategy, void* handle);
+
+    /*!
+     * \brief Remove the chunk starting at ptr registered by strategy.
+     */
+    void remove(void* ptr, strategy::AllocationStrategy* strategy);
+
+    /*!
+     * \brief Return the record of the allocation containing ptr, or nullptr
+     * if no registered chunk owner knows of one.
+     */
+    AllocationRecord* find(void* ptr) const;
+
+    /*!
+     * \brief Return the handle of the chunk registered by strategy that
+     * contains ptr, or nullptr if there is none.
+     */
+    void* findHandle(void* ptr, const strategy::AllocationStrategy* strategy) const;
+
+  private:
+    struct Chunk {
+      uintptr_t begin;
+      uintptr_t end;
+      strategy::AllocationStrategy* strategy;
+      void* handle;
+      std::atomic<Chunk*> next;
+    };
+
+    static const int s_address_bits = 48;
+    static const int s_region_bits = 21;
+    static const int s_leaf_bits = 14;
+    static const int s_root_bits = s_address_bits - s_region_bits - s_leaf_bits;
+
+    struct Leaf {
+      std::atomic<Chunk*> heads[std::size_t{1} << s_leaf_bits];
+    };
+
+    std::atomic<Chunk*>* getHead(uintptr_t region, bool create);
+
+    const std::atomic<Chunk*>* getHead(uintptr_t region) const;
+
+    std::atomic<Leaf*> m_root[std::size_t{1} << s_root_bits];
+
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<Chunk> > m_retired;
+};
+
+} // end of namespace util
+} // end of namespace umpire
+
+#endif // UMPIRE_ChunkRegistry_HPP
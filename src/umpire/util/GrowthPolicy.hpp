@@ -0,0 +1,81 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_GrowthPolicy_HPP
+#define UMPIRE_GrowthPolicy_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+namespace umpire {
+
+/*!
+ * \brief How a pool sizes the chunks it takes from its Allocator.
+ *
+ * fixed takes chunks of size bytes. geometric takes chunks as large as the
+ * pool already is, so each new chunk doubles the pool, from size bytes up
+ * to a cap of max_size bytes. free_fraction takes fraction of the memory
+ * free on the pool's platform at the time the chunk is sized, but no less
+ * than size bytes.
+ *
+ * A chunk is never smaller than the request it is taken for.
+ */
+struct GrowthPolicy {
+  enum class Kind {
+    fixed,
+    geometric,
+    free_fraction
+  };
+
+  static GrowthPolicy fixed(std::size_t size)
+  {
+    return GrowthPolicy{Kind::fixed, size, size, 0.0};
+  }
+
+  static GrowthPolicy geometric(std::size_t min_size, std::size_t max_size)
+  {
+    return GrowthPolicy{Kind::geometric, min_size, max_size, 0.0};
+  }
+
+  static GrowthPolicy freeFraction(double fraction, std::size_t min_size = 0)
+  {
+    return GrowthPolicy{Kind::free_fraction, min_size, 0, fraction};
+  }
+
+  /*!
+   * \brief Return the size of the next chunk of a pool holding
+   * total_bytes, with free_bytes free on its platform.
+   */
+  std::size_t chunkSize(std::size_t total_bytes, std::size_t free_bytes) const
+  {
+    switch (kind) {
+      case Kind::geometric:
+        return std::max(size, std::min(total_bytes, max_size));
+      case Kind::free_fraction:
+        return std::max(size, static_cast<std::size_t>(fraction * free_bytes));
+      case Kind::fixed:
+      default:
+        return size;
+    }
+  }
+
+  Kind kind;
+  std::size_t size;
+  std::size_t max_size;
+  double fraction;
+};
+
+} // end of namespace umpire
+
+#endif
@@ -0,0 +1,42 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_IpcHandle_HPP
+#define UMPIRE_IpcHandle_HPP
+
+#include <cstddef>
+
+namespace umpire {
+namespace util {
+
+/*!
+ * \brief Handle by which another process can open a DEVICE allocation.
+ *
+ * The handle is plain bytes, so it can be sent over a pipe, a socket or
+ * MPI. memory and event hold a cudaIpcMemHandle_t and cudaIpcEventHandle_t
+ * for the cudaMalloc block that contains the allocation, which starts
+ * offset bytes into that block.
+ */
+struct IpcHandle
+{
+  char memory[64];
+  char event[64];
+  std::size_t offset;
+  std::size_t size;
+};
+
+} // end of namespace util
+} // end of namespace umpire
+
+#endif // UMPIRE_IpcHandle_HPP
@@ -0,0 +1,37 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_Lifetime_HPP
+#define UMPIRE_Lifetime_HPP
+
+namespace umpire {
+
+/*!
+ * \brief How long an allocation is expected to live.
+ *
+ * temporary allocations are freed soon, typically within a timestep.
+ * long_lived ones outlast many of those, and persistent ones live until
+ * the end of the run. Strategies that segregate allocations by lifetime,
+ * such as strategy::LifetimePool, use this as a hint; all others ignore
+ * it.
+ */
+enum class Lifetime {
+  temporary,
+  long_lived,
+  persistent
+};
+
+} // end of namespace umpire
+
+#endif
@@ -24,6 +24,7 @@ namespace util {
 static const char* env_name = "UMPIRE_LOG_LEVEL";
 static message::Level defaultLevel = message::Info;
 Logger* Logger::s_Logger = nullptr;
+int Logger::s_enabled_level = message::Num_Levels;
 
 static const std::string MessageLevelName[ message::Num_Levels ] = {
   "ERROR",
@@ -47,6 +48,9 @@ void Logger::setLoggingMsgLevel( message::Level level )
 {
   for ( int i=0 ; i < message::Num_Levels ; ++i )
     m_isEnabled[ i ] = (i<= level) ? true : false;
+
+  if ( this == s_Logger )
+    s_enabled_level = level;
 }
 
 void Logger::logMessage( message::Level level,
@@ -89,6 +93,7 @@ void Logger::finalize()
 {
   delete s_Logger;
   s_Logger = nullptr;
+  s_enabled_level = message::Num_Levels;
 }
 
 Logger* Logger::getActiveLogger()
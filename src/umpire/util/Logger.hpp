@@ -17,6 +17,16 @@
 
 #include <string>
 
+#include "umpire/config.hpp"
+
+/*
+ * Messages more verbose than this level are removed at compile time by
+ * UMPIRE_LOG, whatever UMPIRE_LOG_LEVEL is set to at runtime.
+ */
+#if !defined(UMPIRE_LOG_LEVEL_MIN)
+#define UMPIRE_LOG_LEVEL_MIN Debug
+#endif
+
 namespace umpire {
 namespace util {
 
@@ -64,12 +74,30 @@ class Logger {
       return true;
   };
 
+  /*!
+   * \brief Cheap check for whether the active logger may print messages at
+   * level.
+   *
+   * Until the active logger is created every level passes, so the first
+   * message goes through getActiveLogger and reads UMPIRE_LOG_LEVEL.
+   */
+  static inline bool mayLog( message::Level level )
+  {
+    return level <= s_enabled_level;
+  };
+
 private:
   Logger();
   ~Logger();
 
   bool m_isEnabled[ message::Num_Levels ];
   static Logger* s_Logger;
+
+  /*
+   * Most verbose level enabled on the active logger, kept in a plain static
+   * so UMPIRE_LOG costs one comparison when a level is disabled.
+   */
+  static int s_enabled_level;
 };
 
 } /* namespace util */
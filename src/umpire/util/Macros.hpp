@@ -18,10 +18,16 @@
 #include "umpire/util/Exception.hpp"
 #include "umpire/config.hpp"
 
-#if defined(UMPIRE_ENABLE_STATISTICS)
+#if defined(UMPIRE_ENABLE_TRACE)
+#include "umpire/util/trace_helper.hpp"
+#elif defined(UMPIRE_ENABLE_STATISTICS)
 #include "umpire/util/statistic_helper.hpp"
 #endif
 
+#if defined(UMPIRE_ENABLE_NVTX) || defined(UMPIRE_ENABLE_CALIPER)
+#include "umpire/util/annotation_helper.hpp"
+#endif
+
 #include <sstream>
 #include <iostream>
 #include <mutex>
@@ -78,7 +84,10 @@
 #include "umpire/util/Logger.hpp"
 #define UMPIRE_LOG( lvl, msg )                                                                \
 {                                                                                             \
-  if (umpire::util::Logger::getActiveLogger()->logLevelEnabled(umpire::util::message::lvl)) { \
+  if (umpire::util::message::lvl <= umpire::util::message::UMPIRE_LOG_LEVEL_MIN               \
+      && umpire::util::Logger::mayLog(umpire::util::message::lvl)                             \
+      && umpire::util::Logger::getActiveLogger()->logLevelEnabled(                            \
+        umpire::util::message::lvl)) {                                                        \
     std::ostringstream local_msg;                                                             \
     local_msg  << " " << __func__ << " " << msg;                                              \
     umpire::util::Logger::getActiveLogger()->logMessage(                                      \
@@ -108,7 +117,12 @@
                                  __LINE__);                        \
 }
 
-#if defined(UMPIRE_ENABLE_STATISTICS)
+#if defined(UMPIRE_ENABLE_TRACE)
+
+#define UMPIRE_RECORD_STATISTIC(name, ...) \
+  umpire::util::detail::record_trace(name, __VA_ARGS__);
+
+#elif defined(UMPIRE_ENABLE_STATISTICS)
 
 #define UMPIRE_RECORD_STATISTIC(name, ...) \
   umpire::util::detail::record_statistic(name, __VA_ARGS__);
@@ -117,7 +131,18 @@
 
 #define UMPIRE_RECORD_STATISTIC(name, ...) ((void) 0)
 
-#endif // defined(UMPIRE_ENABLE_STATISTICS)
+#endif // defined(UMPIRE_ENABLE_TRACE)
+
+#if defined(UMPIRE_ENABLE_NVTX) || defined(UMPIRE_ENABLE_CALIPER)
+
+#define UMPIRE_ANNOTATE_SCOPE(event, name, size) \
+  umpire::util::detail::ScopedAnnotation umpire_scoped_annotation(event, name, size)
+
+#else
+
+#define UMPIRE_ANNOTATE_SCOPE(event, name, size) ((void) 0)
+
+#endif // defined(UMPIRE_ENABLE_NVTX) || defined(UMPIRE_ENABLE_CALIPER)
 
 #define UMPIRE_LOCK \
   if ( !m_mutex->try_lock() ) \
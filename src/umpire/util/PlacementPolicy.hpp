@@ -0,0 +1,37 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_PlacementPolicy_HPP
+#define UMPIRE_PlacementPolicy_HPP
+
+namespace umpire {
+
+/*!
+ * \brief How a pool chooses the free block that satisfies a request.
+ *
+ * first_fit takes the lowest-addressed block that is large enough.
+ * best_fit takes the smallest block that is large enough, found through a
+ * size-ordered tree. segregated_fit keeps free blocks in power-of-two
+ * bins and takes the first block from the smallest non-empty bin that is
+ * guaranteed to fit, in constant time.
+ */
+enum class PlacementPolicy {
+  first_fit,
+  best_fit,
+  segregated_fit
+};
+
+} // end of namespace umpire
+
+#endif
@@ -19,7 +19,9 @@ namespace umpire {
 
 enum class Platform {
   cpu,
-  cuda
+  cuda,
+  hip,
+  omp_target
 };
 
 } // end of namespace umpire
@@ -12,11 +12,11 @@
 // For details, see https://github.com/LLNL/Umpire
 // Please also see the LICENSE file for MIT license.
 //////////////////////////////////////////////////////////////////////////////
-
 #include "umpire/util/Statistic.hpp"
 
 #include <iostream>
 
+#include "umpire/util/StatisticsDatabase.hpp"
 #include "umpire/util/Macros.hpp"
 
 #include "conduit.hpp"
@@ -24,12 +24,20 @@
 namespace umpire {
 namespace util {
 
-Statistic::Statistic(const std::string& name) :
+Statistic::Statistic(
+    const std::string& name,
+    StatisticsDatabase* database,
+    std::size_t chunk_size,
+    std::size_t sample_rate) :
   m_name(name),
-  m_counter(),
-  m_data()
+  m_counter(0),
+  m_database(database),
+  m_chunk_size(chunk_size),
+  m_sample_rate(sample_rate),
+  m_recorded(0),
+  m_mutex(),
+  m_data(newChunk())
 {
-  m_data["name"] = name;
 }
 
 Statistic::~Statistic()
@@ -39,16 +47,60 @@ Statistic::~Statistic()
 void
 Statistic::recordStatistic(conduit::Node&& stat)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if ((m_counter++ % m_sample_rate) != 0) {
+    return;
+  }
+
   auto time = std::chrono::time_point_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now()).time_since_epoch();
   stat["timestamp"] = static_cast<long>(time.count());
 
-  m_data["statistics"].append().set(stat);
+  (*m_data)["statistics"].append().set(stat);
+
+  if (m_chunk_size && ++m_recorded == m_chunk_size) {
+    m_recorded = 0;
+
+    std::unique_ptr<conduit::Node> chunk(newChunk());
+    chunk.swap(m_data);
+    m_database->write(std::move(chunk));
+  }
 }
 
 void
 Statistic::printData(std::ostream& stream)
 {
-  m_data.print();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_data->print();
+}
+
+std::unique_ptr<conduit::Node>
+Statistic::newChunk() const
+{
+  std::unique_ptr<conduit::Node> chunk(new conduit::Node());
+  (*chunk)["name"] = m_name;
+
+  if (m_sample_rate > 1) {
+    (*chunk)["sample_rate"] = static_cast<long>(m_sample_rate);
+  }
+
+  return chunk;
+}
+
+void
+Statistic::flush()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_recorded == 0) {
+    return;
+  }
+
+  m_recorded = 0;
+
+  std::unique_ptr<conduit::Node> chunk(newChunk());
+  chunk.swap(m_data);
+  m_database->write(std::move(chunk));
 }
 
 } // end of namespace util
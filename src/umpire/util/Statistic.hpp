@@ -16,6 +16,8 @@
 #define UMPIRE_Statistic_HPP
 
 #include <chrono>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 
@@ -31,18 +33,46 @@ class Statistic {
   public:
     ~Statistic();
 
+    /*!
+     * \brief Record the event n, keeping one in every sample rate events.
+     *
+     * When the StatisticsDatabase is streaming, every chunk size recorded
+     * events are handed to its writer, so a Statistic never holds more than
+     * one chunk.
+     */
     void recordStatistic(conduit::Node&& n);
 
+    /*!
+     * \brief Print the events held in memory: all of them, or when
+     * streaming, those not yet handed to the writer.
+     */
     void printData(std::ostream& stream);
 
   protected:
-    Statistic(const std::string& name);
+    Statistic(
+        const std::string& name,
+        StatisticsDatabase* database,
+        std::size_t chunk_size,
+        std::size_t sample_rate);
 
   private:
+    std::unique_ptr<conduit::Node> newChunk() const;
+
+    // Hand the events held to the database's writer.
+    void flush();
+
     std::string m_name;
     size_t m_counter;
 
-    conduit::Node m_data;
+    StatisticsDatabase* m_database;
+
+    // Events held before flushing, or 0 to hold every event.
+    std::size_t m_chunk_size;
+    std::size_t m_sample_rate;
+    std::size_t m_recorded;
+
+    std::mutex m_mutex;
+    std::unique_ptr<conduit::Node> m_data;
 };
 
 } // end of namespace util
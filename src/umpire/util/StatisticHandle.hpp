@@ -0,0 +1,44 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_StatisticHandle_HPP
+#define UMPIRE_StatisticHandle_HPP
+
+#include "umpire/config.hpp"
+
+#include <cstdint>
+
+namespace umpire {
+namespace util {
+
+class Statistic;
+
+/*!
+ * \brief What UMPIRE_RECORD_STATISTIC records against when given a handle
+ * instead of a name: the Statistic itself in statistics builds, and the id
+ * of the name in the trace file in trace builds.
+ *
+ * Strategies resolve their handle once, so recording an event does not
+ * build or hash a name.
+ */
+#if defined(UMPIRE_ENABLE_TRACE)
+using StatisticHandle = uint32_t;
+#else
+using StatisticHandle = Statistic*;
+#endif
+
+} // end of namespace util
+} // end of namespace umpire
+
+#endif // UMPIRE_StatisticHandle_HPP
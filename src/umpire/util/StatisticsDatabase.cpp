@@ -12,9 +12,11 @@
 // For details, see https://github.com/LLNL/Umpire
 // Please also see the LICENSE file for MIT license.
 //////////////////////////////////////////////////////////////////////////////
-
 #include "umpire/util/StatisticsDatabase.hpp"
 
+#include <cstdlib>
+#include <string>
+
 #include "umpire/util/Macros.hpp"
 
 namespace umpire {
@@ -22,22 +24,35 @@ namespace util {
 
 StatisticsDatabase* StatisticsDatabase::s_statistics_database_instance(nullptr);
 
+const std::size_t StatisticsDatabase::s_chunk_size;
+const std::size_t StatisticsDatabase::s_max_pending_chunks;
+
 StatisticsDatabase* StatisticsDatabase::getDatabase()
 {
-  if (!s_statistics_database_instance)
+  static std::once_flag created;
+
+  std::call_once(created, [] () {
     s_statistics_database_instance = new StatisticsDatabase();
 
+    if (s_statistics_database_instance->m_file) {
+      std::atexit(StatisticsDatabase::finalize);
+    }
+  });
+
   return s_statistics_database_instance;
 }
 
 std::shared_ptr<Statistic> 
 StatisticsDatabase::getStatistic(const std::string& name)
 {
+  std::lock_guard<std::mutex> lock(m_statistics_mutex);
+
   auto statistic = m_statistics.find(name);
   std::shared_ptr<Statistic> stat;
 
   if (statistic == m_statistics.end()) {
-    stat = std::shared_ptr<Statistic>(new Statistic(name));
+    stat = std::shared_ptr<Statistic>(new Statistic(name, this,
+          m_file ? s_chunk_size : 0, m_sample_rate));
     m_statistics[name] = stat;
   } else {
     stat = statistic->second;
@@ -47,18 +62,163 @@ StatisticsDatabase::getStatistic(const std::string& name)
 }
 
 StatisticsDatabase::StatisticsDatabase() :
-  m_statistics()
+  m_statistics_mutex(),
+  m_statistics(),
+  m_sample_rate(1),
+  m_file(nullptr),
+  m_first_chunk(true),
+  m_mutex(),
+  m_pending_changed(),
+  m_pending(),
+  m_writing(false),
+  m_stop(false),
+  m_thread()
 {
+  const char* rate = std::getenv("UMPIRE_STATISTICS_SAMPLE_RATE");
+
+  if (rate) {
+    const long value = std::strtol(rate, nullptr, 10);
+
+    if (value < 1) {
+      UMPIRE_ERROR("UMPIRE_STATISTICS_SAMPLE_RATE must be a positive integer, not " << rate);
+    }
+
+    m_sample_rate = static_cast<std::size_t>(value);
+  }
+
+  const char* filename = std::getenv("UMPIRE_STATISTICS_FILE");
+
+  if (filename) {
+    m_file = std::fopen(filename, "w");
+
+    if (!m_file) {
+      UMPIRE_ERROR("Cannot open statistics file " << filename);
+    }
+
+    std::fputs("[\n", m_file);
+
+    m_thread = std::thread(&StatisticsDatabase::run, this);
+  }
 }
 
 void
 StatisticsDatabase::printStatistics(std::ostream& stream)
 {
+  std::lock_guard<std::mutex> lock(m_statistics_mutex);
+
   stream << "umpire::util::StatisticsDatabase contains " << m_statistics.size() << " statistics" << std::endl;
   for (auto& stat : m_statistics) {
     stat.second->printData(stream);
   }
 }
 
+void
+StatisticsDatabase::flush()
+{
+  if (!m_file) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_statistics_mutex);
+    for (auto& stat : m_statistics) {
+      stat.second->flush();
+    }
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_pending_changed.wait(lock, [this] () {
+    return (m_pending.empty() && !m_writing) || m_stop;
+  });
+
+  std::fflush(m_file);
+}
+
+void
+StatisticsDatabase::finalize()
+{
+  StatisticsDatabase* database = s_statistics_database_instance;
+
+  database->flush();
+
+  {
+    std::lock_guard<std::mutex> lock(database->m_mutex);
+    database->m_stop = true;
+  }
+  database->m_pending_changed.notify_all();
+  database->m_thread.join();
+
+  std::lock_guard<std::mutex> lock(database->m_mutex);
+  std::fputs("\n]\n", database->m_file);
+  std::fclose(database->m_file);
+  database->m_file = nullptr;
+}
+
+void
+StatisticsDatabase::write(std::unique_ptr<conduit::Node>&& chunk)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  if (m_stop) {
+    // Events recorded by destructors run after finalize are dropped, as the
+    // file has been closed.
+    if (m_file) {
+      writeChunk(*chunk);
+    }
+    return;
+  }
+
+  m_pending_changed.wait(lock, [this] () {
+    return m_pending.size() < s_max_pending_chunks || m_stop;
+  });
+
+  m_pending.push_back(std::move(chunk));
+  lock.unlock();
+
+  m_pending_changed.notify_all();
+}
+
+void
+StatisticsDatabase::run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  while (true) {
+    m_pending_changed.wait(lock, [this] () {
+      return !m_pending.empty() || m_stop;
+    });
+
+    if (m_pending.empty()) {
+      return;
+    }
+
+    std::unique_ptr<conduit::Node> chunk(std::move(m_pending.front()));
+    m_pending.pop_front();
+    m_writing = true;
+
+    lock.unlock();
+    m_pending_changed.notify_all();
+
+    writeChunk(*chunk);
+    chunk.reset();
+
+    lock.lock();
+    m_writing = false;
+    m_pending_changed.notify_all();
+  }
+}
+
+void
+StatisticsDatabase::writeChunk(const conduit::Node& chunk)
+{
+  if (!m_first_chunk) {
+    std::fputs(",\n", m_file);
+  }
+  m_first_chunk = false;
+
+  const std::string json = chunk.to_json();
+  std::fwrite(json.data(), 1, json.size(), m_file);
+}
+
 } // end of namespace util
 } // end of namespace umpire
@@ -15,16 +15,36 @@
 #ifndef UMPIRE_StatisticsDatabase_HPP
 #define UMPIRE_StatisticsDatabase_HPP
 
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
 #include <ostream>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include "umpire/util/Statistic.hpp"
 
 namespace umpire {
 namespace util {
 
+/*!
+ * \brief Owns the Statistic recorded for each Allocator and operation.
+ *
+ * By default every event is kept in memory until printStatistics. If the
+ * UMPIRE_STATISTICS_FILE environment variable names a file, events are
+ * instead streamed there as a JSON array of chunks, each in the layout
+ * printStatistics uses: a Statistic hands every s_chunk_size events to a
+ * background thread that writes them, and waits for it rather than hold more
+ * than s_max_pending_chunks. Remaining events are written when the program
+ * exits.
+ *
+ * If UMPIRE_STATISTICS_SAMPLE_RATE is set to N, each Statistic keeps only
+ * one in every N events, and records N as its sample_rate.
+ */
 class StatisticsDatabase {
+  friend class Statistic;
   public:
     static StatisticsDatabase* getDatabase();
 
@@ -32,15 +52,47 @@ class StatisticsDatabase {
         const std::string& name);
 
     void printStatistics(std::ostream& stream);
+
+    /*!
+     * \brief When streaming, write every event recorded so far to the file.
+     */
+    void flush();
+
   private:
+    static const std::size_t s_chunk_size = 1024;
+    static const std::size_t s_max_pending_chunks = 8;
+
     StatisticsDatabase();
 
     StatisticsDatabase (const StatisticsDatabase&) = delete;
     StatisticsDatabase& operator= (const StatisticsDatabase&) = delete;
 
+    static void finalize();
+
+    // Queue chunk for the writer thread, or write it now once it has stopped.
+    void write(std::unique_ptr<conduit::Node>&& chunk);
+
+    void run();
+    void writeChunk(const conduit::Node& chunk);
+
     static StatisticsDatabase* s_statistics_database_instance;
 
+    std::mutex m_statistics_mutex;
     std::map<std::string, std::shared_ptr<Statistic> > m_statistics;
+
+    std::size_t m_sample_rate;
+
+    // Null unless streaming.
+    std::FILE* m_file;
+    bool m_first_chunk;
+
+    // Guards m_pending, m_writing and m_stop.
+    std::mutex m_mutex;
+    std::condition_variable m_pending_changed;
+    std::deque<std::unique_ptr<conduit::Node> > m_pending;
+    bool m_writing;
+    bool m_stop;
+    std::thread m_thread;
 };
 
 } // end of namespace util
@@ -0,0 +1,86 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/util/ThreadPool.hpp"
+
+#include <utility>
+
+namespace umpire {
+namespace util {
+
+ThreadPool::ThreadPool(unsigned int num_threads) :
+  m_mutex(),
+  m_wake(),
+  m_tasks(),
+  m_stop(false),
+  m_threads()
+{
+  m_threads.reserve(num_threads);
+  for (unsigned int i = 0; i < num_threads; ++i) {
+    m_threads.push_back(std::thread(&ThreadPool::run, this));
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+
+  for (auto& thread : m_threads) {
+    thread.join();
+  }
+}
+
+std::future<void>
+ThreadPool::submit(std::function<void()> task)
+{
+  std::packaged_task<void()> packaged(std::move(task));
+  std::future<void> future = packaged.get_future();
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push_back(std::move(packaged));
+  }
+  m_wake.notify_one();
+
+  return future;
+}
+
+void
+ThreadPool::run()
+{
+  for (;;) {
+    std::packaged_task<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wake.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+
+      if (m_tasks.empty()) {
+        return;
+      }
+
+      task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+    }
+
+    task();
+  }
+}
+
+} // end of namespace util
+} // end of namespace umpire
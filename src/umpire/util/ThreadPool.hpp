@@ -0,0 +1,66 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_ThreadPool_HPP
+#define UMPIRE_ThreadPool_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace umpire {
+namespace util {
+
+/*!
+ * \brief A fixed set of threads running queued tasks in order.
+ *
+ * Each task's result, or the exception it threw, is delivered through the
+ * future returned by submit. The destructor runs every task still queued
+ * before joining the threads.
+ */
+class ThreadPool
+{
+  public:
+    explicit ThreadPool(unsigned int num_threads);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /*!
+     * \brief Queue task to run on one of the threads.
+     */
+    std::future<void> submit(std::function<void()> task);
+
+  private:
+    void run();
+
+    // Guards m_tasks and m_stop.
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<std::packaged_task<void()> > m_tasks;
+    bool m_stop;
+
+    std::vector<std::thread> m_threads;
+};
+
+} // end of namespace util
+} // end of namespace umpire
+
+#endif // UMPIRE_ThreadPool_HPP
@@ -0,0 +1,365 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/util/Tracer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include <unistd.h>
+
+#include "umpire/util/Macros.hpp"
+
+namespace umpire {
+namespace util {
+
+namespace {
+
+void writeOrThrow(const void* data, std::size_t size, std::size_t count, std::FILE* file)
+{
+  if (std::fwrite(data, size, count, file) != count) {
+    UMPIRE_ERROR("Failed to write trace file");
+  }
+}
+
+void readOrThrow(void* data, std::size_t size, std::size_t count, std::FILE* file)
+{
+  if (std::fread(data, size, count, file) != count) {
+    std::fclose(file);
+    UMPIRE_ERROR("Trace file is truncated");
+  }
+}
+
+} // end of anonymous namespace
+
+Tracer* Tracer::s_tracer_instance(nullptr);
+
+const std::size_t Tracer::s_buffer_size;
+const int Tracer::s_flush_interval_ms;
+
+Tracer::Buffer::Buffer() :
+  head(0),
+  tail(0)
+{
+}
+
+Tracer*
+Tracer::getTracer()
+{
+  static std::once_flag created;
+
+  std::call_once(created, [] () {
+    s_tracer_instance = new Tracer();
+    std::atexit(Tracer::finalize);
+  });
+
+  return s_tracer_instance;
+}
+
+Tracer::Tracer() :
+  m_file(nullptr),
+  m_mutex(),
+  m_buffers(),
+  m_name_ids(),
+  m_pending_names(),
+  m_write_mutex(),
+  m_wake_mutex(),
+  m_wake(),
+  m_stop(false),
+  m_thread()
+{
+  std::string filename;
+
+  const char* env = std::getenv("UMPIRE_TRACE_FILE");
+
+  if (env) {
+    filename = env;
+  } else {
+    std::ostringstream name;
+    name << "umpire." << getpid() << ".trace";
+    filename = name.str();
+  }
+
+  m_file = std::fopen(filename.c_str(), "wb");
+
+  if (!m_file) {
+    UMPIRE_ERROR("Cannot open trace file " << filename);
+  }
+
+  const uint32_t version = trace::Version;
+  const uint32_t record_size = sizeof(trace::Record);
+
+  writeOrThrow(trace::Magic, sizeof(trace::Magic), 1, m_file);
+  writeOrThrow(&version, sizeof(version), 1, m_file);
+  writeOrThrow(&record_size, sizeof(record_size), 1, m_file);
+
+  m_thread = std::thread(&Tracer::run, this);
+}
+
+void
+Tracer::finalize()
+{
+  Tracer* tracer = s_tracer_instance;
+
+  tracer->m_stop = true;
+  tracer->m_wake.notify_one();
+  tracer->m_thread.join();
+
+  tracer->drain();
+}
+
+void
+Tracer::record(const std::string& name, trace::Record& record)
+{
+  thread_local std::unordered_map<std::string, uint32_t> name_ids;
+
+  auto id = name_ids.find(name);
+
+  if (id == name_ids.end()) {
+    id = name_ids.insert(std::make_pair(name, getNameId(name))).first;
+  }
+
+  record.name = id->second;
+  push(record);
+}
+
+void
+Tracer::record(const char* name, trace::Record& record)
+{
+  thread_local std::unordered_map<const char*, uint32_t> name_ids;
+
+  auto id = name_ids.find(name);
+
+  if (id == name_ids.end()) {
+    id = name_ids.insert(std::make_pair(name, getNameId(name))).first;
+  }
+
+  record.name = id->second;
+  push(record);
+}
+
+void
+Tracer::record(uint32_t name_id, trace::Record& record)
+{
+  record.name = name_id;
+  push(record);
+}
+
+void
+Tracer::flush()
+{
+  drain();
+}
+
+uint32_t
+Tracer::getNameId(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto id = m_name_ids.find(name);
+
+  if (id == m_name_ids.end()) {
+    const uint32_t next_id = static_cast<uint32_t>(m_name_ids.size());
+
+    id = m_name_ids.insert(std::make_pair(name, next_id)).first;
+    m_pending_names.push_back(std::make_pair(next_id, name));
+  }
+
+  return id->second;
+}
+
+Tracer::Buffer*
+Tracer::getThreadBuffer()
+{
+  thread_local std::shared_ptr<Buffer> buffer;
+
+  if (!buffer) {
+    buffer = std::make_shared<Buffer>();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_buffers.push_back(buffer);
+  }
+
+  return buffer.get();
+}
+
+void
+Tracer::push(trace::Record& record)
+{
+  auto time = std::chrono::time_point_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now()).time_since_epoch();
+  record.timestamp = static_cast<uint64_t>(time.count());
+
+  Buffer* buffer = getThreadBuffer();
+
+  const std::size_t head = buffer->head.load(std::memory_order_relaxed);
+  std::size_t tail = buffer->tail.load(std::memory_order_acquire);
+
+  while (head - tail >= s_buffer_size) {
+    if (m_stop) {
+      drain();
+    } else {
+      m_wake.notify_one();
+      std::this_thread::yield();
+    }
+    tail = buffer->tail.load(std::memory_order_acquire);
+  }
+
+  buffer->records[head % s_buffer_size] = record;
+  buffer->head.store(head + 1, std::memory_order_release);
+
+  if (m_stop) {
+    drain();
+  } else if (head + 1 - tail == s_buffer_size / 2) {
+    m_wake.notify_one();
+  }
+}
+
+void
+Tracer::run()
+{
+  while (!m_stop) {
+    {
+      std::unique_lock<std::mutex> lock(m_wake_mutex);
+      m_wake.wait_for(lock, std::chrono::milliseconds(s_flush_interval_ms));
+    }
+
+    drain();
+  }
+}
+
+void
+Tracer::drain()
+{
+  std::lock_guard<std::mutex> write_lock(m_write_mutex);
+
+  std::vector<std::pair<uint32_t, std::string> > names;
+  std::vector<std::shared_ptr<Buffer> > buffers;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    names.swap(m_pending_names);
+
+    // Buffers only the tracer still refers to belong to threads that have
+    // exited, and can go once they are empty.
+    for (auto buffer = m_buffers.begin(); buffer != m_buffers.end(); ) {
+      if (buffer->use_count() == 1 &&
+          (*buffer)->head.load(std::memory_order_acquire) ==
+          (*buffer)->tail.load(std::memory_order_relaxed)) {
+        buffer = m_buffers.erase(buffer);
+      } else {
+        ++buffer;
+      }
+    }
+
+    buffers = m_buffers;
+  }
+
+  if (!names.empty()) {
+    const uint32_t header[2] = {trace::names_block, static_cast<uint32_t>(names.size())};
+    writeOrThrow(header, sizeof(uint32_t), 2, m_file);
+
+    for (auto& name : names) {
+      const uint32_t entry[2] = {name.first, static_cast<uint32_t>(name.second.size())};
+      writeOrThrow(entry, sizeof(uint32_t), 2, m_file);
+      writeOrThrow(name.second.data(), 1, name.second.size(), m_file);
+    }
+  }
+
+  for (auto& buffer : buffers) {
+    const std::size_t tail = buffer->tail.load(std::memory_order_relaxed);
+    const std::size_t head = buffer->head.load(std::memory_order_acquire);
+
+    if (head == tail) {
+      continue;
+    }
+
+    const uint32_t header[2] = {trace::records_block, static_cast<uint32_t>(head - tail)};
+    writeOrThrow(header, sizeof(uint32_t), 2, m_file);
+
+    const std::size_t begin = tail % s_buffer_size;
+    const std::size_t first = std::min(head - tail, s_buffer_size - begin);
+
+    writeOrThrow(&buffer->records[begin], sizeof(trace::Record), first, m_file);
+    writeOrThrow(&buffer->records[0], sizeof(trace::Record), head - tail - first, m_file);
+
+    buffer->tail.store(head, std::memory_order_release);
+  }
+
+  std::fflush(m_file);
+}
+
+void
+Tracer::readTrace(
+    const std::string& filename,
+    std::vector<std::string>& names,
+    std::vector<trace::Record>& records)
+{
+  std::FILE* file = std::fopen(filename.c_str(), "rb");
+
+  if (!file) {
+    UMPIRE_ERROR("Cannot open trace file " << filename);
+  }
+
+  char magic[sizeof(trace::Magic)];
+  uint32_t version;
+  uint32_t record_size;
+
+  readOrThrow(magic, sizeof(magic), 1, file);
+  readOrThrow(&version, sizeof(version), 1, file);
+  readOrThrow(&record_size, sizeof(record_size), 1, file);
+
+  if (std::memcmp(magic, trace::Magic, sizeof(magic)) != 0
+      || version != trace::Version
+      || record_size != sizeof(trace::Record)) {
+    std::fclose(file);
+    UMPIRE_ERROR(filename << " is not an Umpire trace file of version " << trace::Version);
+  }
+
+  uint32_t header[2];
+
+  while (std::fread(header, sizeof(uint32_t), 2, file) == 2) {
+    if (header[0] == trace::names_block) {
+      for (uint32_t i = 0; i < header[1]; ++i) {
+        uint32_t entry[2];
+        readOrThrow(entry, sizeof(uint32_t), 2, file);
+
+        std::string name(entry[1], '\0');
+        if (entry[1] > 0) {
+          readOrThrow(&name[0], 1, entry[1], file);
+        }
+
+        if (entry[0] >= names.size()) {
+          names.resize(entry[0] + 1);
+        }
+        names[entry[0]] = name;
+      }
+    } else if (header[0] == trace::records_block) {
+      const std::size_t offset = records.size();
+      records.resize(offset + header[1]);
+      readOrThrow(&records[offset], sizeof(trace::Record), header[1], file);
+    } else {
+      std::fclose(file);
+      UMPIRE_ERROR(filename << " contains an unknown block type " << header[0]);
+    }
+  }
+
+  std::fclose(file);
+}
+
+} // end of namespace util
+} // end of namespace umpire
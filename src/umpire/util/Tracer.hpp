@@ -0,0 +1,234 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_Tracer_HPP
+#define UMPIRE_Tracer_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace umpire {
+namespace util {
+
+namespace trace {
+
+enum Event : uint8_t {
+  unknown,
+  allocate,
+  deallocate,
+  copy,
+  copy_async,
+  copy_batch,
+  memset,
+  memset_async,
+  fill,
+  fill_async,
+  reallocate,
+  prefetch,
+
+  Num_Events
+};
+
+static const char* const EventName[ Event::Num_Events ] = {
+  "unknown",
+  "allocate",
+  "deallocate",
+  "copy",
+  "copy_async",
+  "copy_batch",
+  "memset",
+  "memset_async",
+  "fill",
+  "fill_async",
+  "reallocate",
+  "prefetch"
+};
+
+/*!
+ * \brief Keys of the optional integer argument some events carry.
+ */
+enum Argument : uint8_t {
+  none,
+  value,
+  count,
+  pattern_size,
+  device,
+
+  Num_Arguments
+};
+
+static const char* const ArgumentName[ Argument::Num_Arguments ] = {
+  "",
+  "value",
+  "count",
+  "pattern_size",
+  "device"
+};
+
+/*!
+ * \brief Which of the pointer and size fields of a Record were given.
+ */
+enum Field : uint8_t {
+  has_ptr = 1,
+  has_src_ptr = 2,
+  has_dst_ptr = 4,
+  has_size = 8
+};
+
+/*!
+ * \brief One traced event, written to the trace file as is.
+ *
+ * name is an index into the names stored in the same file: the name of the
+ * Allocator for allocate and deallocate events, and of the operation for
+ * everything else.
+ */
+struct Record {
+  uint64_t timestamp;
+  uint64_t ptr;
+  uint64_t dst_ptr;
+  uint64_t size;
+  int64_t arg;
+  uint32_t name;
+  uint8_t event;
+  uint8_t arg_key;
+  uint8_t fields;
+  uint8_t reserved;
+};
+
+/*
+ * A trace file is the 8 byte magic, a uint32_t version and the uint32_t
+ * size of a Record, followed by blocks. Each block is a uint32_t BlockType
+ * and a uint32_t count: a names block holds count entries of a uint32_t id,
+ * a uint32_t length and the characters of the name, and a records block
+ * holds count Records.
+ */
+static const char Magic[8] = {'U', 'M', 'P', 'T', 'R', 'A', 'C', 'E'};
+static const uint32_t Version = 1;
+
+enum BlockType : uint32_t {
+  names_block = 1,
+  records_block = 2
+};
+
+} // end of namespace trace
+
+/*!
+ * \brief Write trace::Records to a binary file with little overhead on the
+ * threads that produce them.
+ *
+ * Each thread appends to its own lock-free single-producer ring buffer. A
+ * background thread drains every buffer to the file named by the
+ * UMPIRE_TRACE_FILE environment variable (umpire.<pid>.trace by default)
+ * whenever one fills past half way, and at least every s_flush_interval. A
+ * thread that finds its buffer full waits for the flusher rather than drop
+ * events. Remaining events are written when the program exits.
+ */
+class Tracer {
+  public:
+    static Tracer* getTracer();
+
+    /*!
+     * \brief Stamp record with the current time and the id of name, and
+     * append it to the calling thread's buffer.
+     */
+    void record(const std::string& name, trace::Record& record);
+
+    /*!
+     * \brief As above for a name with static storage, which is looked up by
+     * address.
+     */
+    void record(const char* name, trace::Record& record);
+
+    /*!
+     * \brief As above for a name id returned by getNameId.
+     */
+    void record(uint32_t name_id, trace::Record& record);
+
+    /*!
+     * \brief Return the id of name in the trace file, assigning one the
+     * first time name is seen.
+     */
+    uint32_t getNameId(const std::string& name);
+
+    /*!
+     * \brief Write every buffered event to the trace file.
+     */
+    void flush();
+
+    /*!
+     * \brief Read the names and records of the trace file filename.
+     *
+     * \throws util::Exception if the file cannot be read or is not a trace.
+     */
+    static void readTrace(
+        const std::string& filename,
+        std::vector<std::string>& names,
+        std::vector<trace::Record>& records);
+
+  private:
+    static const std::size_t s_buffer_size = 4096;
+    static const int s_flush_interval_ms = 100;
+
+    struct Buffer {
+      Buffer();
+
+      trace::Record records[s_buffer_size];
+      std::atomic<std::size_t> head;
+      std::atomic<std::size_t> tail;
+    };
+
+    Tracer();
+
+    Tracer (const Tracer&) = delete;
+    Tracer& operator= (const Tracer&) = delete;
+
+    static void finalize();
+
+    Buffer* getThreadBuffer();
+    void push(trace::Record& record);
+
+    void run();
+    void drain();
+
+    static Tracer* s_tracer_instance;
+
+    std::FILE* m_file;
+
+    // Guards m_buffers, m_name_ids and m_pending_names.
+    std::mutex m_mutex;
+    std::vector<std::shared_ptr<Buffer> > m_buffers;
+    std::unordered_map<std::string, uint32_t> m_name_ids;
+    std::vector<std::pair<uint32_t, std::string> > m_pending_names;
+
+    // Held while writing to m_file, so buffers have one consumer at a time.
+    std::mutex m_write_mutex;
+
+    std::mutex m_wake_mutex;
+    std::condition_variable m_wake;
+    std::atomic<bool> m_stop;
+    std::thread m_thread;
+};
+
+} // end of namespace util
+} // end of namespace umpire
+
+#endif // UMPIRE_Tracer_HPP
@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_annotation_helper_HPP
+#define UMPIRE_annotation_helper_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "umpire/config.hpp"
+
+#if defined(UMPIRE_ENABLE_NVTX)
+#include "nvToolsExt.h"
+#endif
+
+#if defined(UMPIRE_ENABLE_CALIPER)
+#include "caliper/cali.h"
+#endif
+
+namespace umpire {
+namespace util {
+namespace detail {
+
+#if defined(UMPIRE_ENABLE_NVTX)
+inline
+nvtxDomainHandle_t
+nvtx_domain()
+{
+  static nvtxDomainHandle_t domain = nvtxDomainCreateA("umpire");
+  return domain;
+}
+#endif
+
+/*!
+ * \brief Mark the lifetime of this object as a range named after event in
+ * the enabled profiler annotations.
+ *
+ * The range is tagged with name, the Allocator or operation it belongs to,
+ * and size in bytes: as the message and payload of an NVTX range in the
+ * "umpire" domain, and as the umpire.name and umpire.size attributes of a
+ * Caliper region.
+ */
+class ScopedAnnotation {
+  public:
+    ScopedAnnotation(const char* event, const std::string& name, std::size_t size)
+#if defined(UMPIRE_ENABLE_CALIPER)
+      : m_event(event)
+#endif
+    {
+#if defined(UMPIRE_ENABLE_NVTX)
+      const std::string message = std::string(event) + " " + name;
+
+      nvtxEventAttributes_t attributes = {};
+      attributes.version = NVTX_VERSION;
+      attributes.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
+      attributes.messageType = NVTX_MESSAGE_TYPE_ASCII;
+      attributes.message.ascii = message.c_str();
+      attributes.payloadType = NVTX_PAYLOAD_TYPE_UNSIGNED_INT64;
+      attributes.payload.ullValue = static_cast<uint64_t>(size);
+
+      nvtxDomainRangePushEx(nvtx_domain(), &attributes);
+#endif
+
+#if defined(UMPIRE_ENABLE_CALIPER)
+      cali_begin_string_byname("umpire.name", name.c_str());
+      cali_begin_int_byname("umpire.size", static_cast<int>(size));
+      cali_begin_region(event);
+#endif
+    }
+
+    ~ScopedAnnotation()
+    {
+#if defined(UMPIRE_ENABLE_CALIPER)
+      cali_end_region(m_event);
+      cali_end_byname("umpire.size");
+      cali_end_byname("umpire.name");
+#endif
+
+#if defined(UMPIRE_ENABLE_NVTX)
+      nvtxDomainRangePop(nvtx_domain());
+#endif
+    }
+
+    ScopedAnnotation(const ScopedAnnotation&) = delete;
+    ScopedAnnotation& operator=(const ScopedAnnotation&) = delete;
+
+#if defined(UMPIRE_ENABLE_CALIPER)
+  private:
+    const char* m_event;
+#endif
+};
+
+} // end of namespace detail
+} // end of namespace util
+} // end of namespace umpire
+
+#endif // UMPIRE_annotation_helper_HPP
@@ -65,6 +65,20 @@ record_statistic(const std::string& name, Args&&... args) {
   util::StatisticsDatabase::getDatabase()->getStatistic(name)->recordStatistic(add_entry(node, args...));
 }
 
+template<typename... Args>
+inline
+void
+record_statistic(Statistic* statistic, Args&&... args) {
+  auto node = conduit::Node{};
+  statistic->recordStatistic(add_entry(node, args...));
+}
+
+inline
+Statistic*
+get_statistic_handle(const std::string& name) {
+  return util::StatisticsDatabase::getDatabase()->getStatistic(name).get();
+}
+
 } // end of namespace detail
 } // end of namespace util
 } // end of namespace umpire
@@ -0,0 +1,106 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#ifndef UMPIRE_trace_helper_HPP
+#define UMPIRE_trace_helper_HPP
+
+#include <cstring>
+
+#include "umpire/util/Tracer.hpp"
+
+namespace umpire {
+namespace util {
+namespace detail {
+
+inline
+void
+set_trace_field(trace::Record& record, const char* key, const char* value)
+{
+  if (std::strcmp(key, "event") == 0) {
+    for (int i = 0; i < trace::Num_Events; ++i) {
+      if (std::strcmp(value, trace::EventName[i]) == 0) {
+        record.event = static_cast<uint8_t>(i);
+        return;
+      }
+    }
+  }
+}
+
+template <typename T>
+inline
+void
+set_trace_field(trace::Record& record, const char* key, T value)
+{
+  if (std::strcmp(key, "ptr") == 0) {
+    record.ptr = static_cast<uint64_t>(value);
+    record.fields |= trace::has_ptr;
+  } else if (std::strcmp(key, "src_ptr") == 0) {
+    record.ptr = static_cast<uint64_t>(value);
+    record.fields |= trace::has_src_ptr;
+  } else if (std::strcmp(key, "dst_ptr") == 0) {
+    record.dst_ptr = static_cast<uint64_t>(value);
+    record.fields |= trace::has_dst_ptr;
+  } else if (std::strcmp(key, "size") == 0) {
+    record.size = static_cast<uint64_t>(value);
+    record.fields |= trace::has_size;
+  } else {
+    for (int i = 1; i < trace::Num_Arguments; ++i) {
+      if (std::strcmp(key, trace::ArgumentName[i]) == 0) {
+        record.arg = static_cast<int64_t>(value);
+        record.arg_key = static_cast<uint8_t>(i);
+        return;
+      }
+    }
+  }
+}
+
+inline
+void
+add_trace_fields(trace::Record&)
+{
+}
+
+template <typename T, typename U, typename... Args>
+inline
+void
+add_trace_fields(trace::Record& record, T k, U v, Args... args)
+{
+  set_trace_field(record, k, v);
+  add_trace_fields(record, args...);
+}
+
+/*!
+ * \brief Trace counterpart of record_statistic, taking the same name and
+ * key/value pairs.
+ */
+template<typename Name, typename... Args>
+inline
+void
+record_trace(const Name& name, Args&&... args) {
+  trace::Record record = trace::Record();
+  add_trace_fields(record, args...);
+  util::Tracer::getTracer()->record(name, record);
+}
+
+inline
+uint32_t
+get_statistic_handle(const std::string& name) {
+  return util::Tracer::getTracer()->getNameId(name);
+}
+
+} // end of namespace detail
+} // end of namespace util
+} // end of namespace umpire
+
+#endif // UMPIRE_trace_helper_HPP
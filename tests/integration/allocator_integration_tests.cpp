@@ -17,8 +17,38 @@
 #include "umpire/config.hpp"
 
 #include "umpire/Allocator.hpp"
+#include "umpire/AllocationProfile.hpp"
+#include "umpire/AllocatorConfiguration.hpp"
+#include "umpire/Array.hpp"
+#include "umpire/NodeAllocator.hpp"
 #include "umpire/ResourceManager.hpp"
+#include "umpire/ScopedDefaultAllocator.hpp"
+#if defined(UMPIRE_ENABLE_CUDA)
+#include "umpire/DeviceAllocator.hpp"
+#endif
+#include "umpire/StrategyAllocator.hpp"
+#include "umpire/TypedAllocator.hpp"
+#include "umpire/pmr/memory_resource_adaptor.hpp"
 #include "umpire/resource/MemoryResourceTypes.hpp"
+#include "umpire/strategy/DynamicPool.hpp"
+#include "umpire/strategy/ThreadSafeAllocator.hpp"
+#include "umpire/util/Exception.hpp"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <list>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 class AllocatorTest :
   public ::testing::TestWithParam< std::string >
@@ -64,8 +94,9 @@ TEST_P(AllocatorTest, AllocateDeallocateSmall)
 
 TEST_P(AllocatorTest, AllocateDeallocateNothing)
 {
-  // CUDA doesn't support allocating 0 bytes
-  if (m_allocator->getPlatform() == umpire::Platform::cuda) {
+  // CUDA and HIP don't support allocating 0 bytes
+  if (m_allocator->getPlatform() == umpire::Platform::cuda
+      || m_allocator->getPlatform() == umpire::Platform::hip) {
     SUCCEED();
   } else {
     double* data = static_cast<double*>(
@@ -88,6 +119,43 @@ TEST_P(AllocatorTest, DeallocateNullptr)
   SUCCEED();
 }
 
+TEST_P(AllocatorTest, AllocateAligned)
+{
+  const size_t alignment = 256;
+
+  double* data = static_cast<double*>(
+    m_allocator->allocate(m_big*sizeof(double), alignment));
+
+  ASSERT_NE(nullptr, data);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(data) % alignment);
+  ASSERT_EQ(m_big*sizeof(double), m_allocator->getSize(data));
+
+  m_allocator->deallocate(data);
+
+  ASSERT_ANY_THROW(m_allocator->allocate(m_big, 3));
+}
+
+TEST_P(AllocatorTest, AllocateZeroed)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  const size_t size = m_big*sizeof(double);
+
+  double* data = static_cast<double*>(m_allocator->allocateZeroed(size));
+  ASSERT_NE(nullptr, data);
+  ASSERT_EQ(size, m_allocator->getSize(data));
+
+  auto host = rm.getAllocator("HOST");
+  double* check = static_cast<double*>(host.allocate(size));
+  rm.copy(check, data);
+
+  for (size_t i = 0; i < m_big; ++i) {
+    ASSERT_EQ(0.0, check[i]);
+  }
+
+  host.deallocate(check);
+  m_allocator->deallocate(data);
+}
+
 TEST_P(AllocatorTest, GetSize)
 {
   const size_t size = m_big*sizeof(double);
@@ -125,10 +193,25 @@ TEST_P(AllocatorTest, GetById)
 
 const std::string allocator_strings[] = {
   "HOST"
-#if defined(UMPIRE_ENABLE_CUDA)
+  , "HOST_HUGEPAGE"
+  , "FILE"
+  , "HOST_COW"
+#if defined(UMPIRE_ENABLE_CUDA) || defined(UMPIRE_ENABLE_HIP)
   , "DEVICE"
+  , "DEVICE::0"
   , "UM"
   , "PINNED"
+  , "PINNED_MAPPED"
+#endif
+#if defined(UMPIRE_ENABLE_CUDA_MALLOC_ASYNC)
+  , "DEVICE_ASYNC"
+#endif
+#if defined(UMPIRE_ENABLE_NUMA)
+  , "HOST_NUMA0"
+  , "HOST_NUMA_INTERLEAVED"
+#endif
+#if defined(UMPIRE_ENABLE_CUDA) && defined(UMPIRE_ENABLE_NUMA)
+  , "PINNED::0"
 #endif
 };
 
@@ -146,6 +229,87 @@ TEST(Allocator, isRegistered)
   ASSERT_FALSE(rm.isAllocatorRegistered("BANANAS"));
 }
 
+TEST(Allocator, HugePages)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  const size_t huge_page_size = 2*1024*1024;
+
+  auto thp_allocator = rm.getAllocator("HOST_HUGEPAGE");
+  void* data = thp_allocator.allocate(3*huge_page_size + 100);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(data) % huge_page_size);
+  thp_allocator.deallocate(data);
+
+  // MAP_HUGETLB needs reserved huge pages, which may not be configured
+  auto hugetlb_allocator = rm.getAllocator("HOST_HUGETLB");
+  try {
+    data = hugetlb_allocator.allocate(huge_page_size + 100);
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(data) % huge_page_size);
+    hugetlb_allocator.deallocate(data);
+  } catch (umpire::util::Exception&) {
+    SUCCEED();
+  }
+}
+
+TEST(Allocator, LazyResources)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto names = rm.getAvailableAllocators();
+  ASSERT_NE(names.end(), std::find(names.begin(), names.end(), "HOST_HUGETLB_1GB"));
+  ASSERT_TRUE(rm.isAllocator("HOST_HUGETLB_1GB"));
+
+  // Every thread must see the same resource, made once.
+  std::vector<std::shared_ptr<umpire::strategy::AllocationStrategy> > strategies(8);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < strategies.size(); ++i) {
+    threads.emplace_back([&, i] {
+      strategies[i] = rm.getAllocator("HOST_HUGETLB_1GB").getAllocationStrategy();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto& strategy : strategies) {
+    ASSERT_EQ(strategies[0], strategy);
+  }
+
+  auto allocator = rm.getAllocator("HOST_HUGETLB_1GB");
+  ASSERT_EQ(strategies[0], rm.getAllocator(allocator.getId()).getAllocationStrategy());
+}
+
+TEST(Allocator, ConcurrentRegistry)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  const int host_id = rm.getAllocator("HOST").getId();
+
+  std::vector<int> ids(8);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < ids.size(); ++i) {
+    threads.emplace_back([&, i] {
+      auto allocator = rm.makeAllocator<umpire::strategy::ThreadSafeAllocator>(
+          "concurrent_registry_" + std::to_string(i), rm.getAllocator("HOST"));
+      ids[i] = allocator.getId();
+
+      for (int j = 0; j < 1000; ++j) {
+        ASSERT_EQ(host_id, rm.getAllocator(host_id).getId());
+        ASSERT_EQ(host_id, rm.getAllocator("HOST").getId());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < ids.size(); ++i) {
+    const std::string name = "concurrent_registry_" + std::to_string(i);
+    ASSERT_EQ(name, rm.getAllocator(ids[i]).getName());
+    ASSERT_EQ(ids[i], rm.getAllocator(name).getId());
+  }
+
+  ASSERT_ANY_THROW(rm.getAllocator(-1));
+}
+
 TEST(Allocator, registerAllocator)
 {
   auto& rm = umpire::ResourceManager::getInstance();
@@ -172,6 +336,623 @@ TEST(Allocator, GetSetDefault)
   );
 }
 
+TEST(Allocator, ThreadDefault)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  const std::string global_default = rm.getDefaultAllocator().getName();
+
+  auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "thread_default_pool", rm.getAllocator("HOST"), 4096, 4096);
+  auto inner = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "thread_default_inner", rm.getAllocator("HOST"), 4096, 4096);
+
+  {
+    umpire::ScopedDefaultAllocator scope(pool);
+    ASSERT_EQ(rm.getDefaultAllocator().getName(), "thread_default_pool");
+
+    void* ptr = rm.reallocate(nullptr, 100);
+    ASSERT_EQ(rm.getAllocator(ptr).getName(), "thread_default_pool");
+    rm.deallocate(ptr);
+
+    {
+      umpire::ScopedDefaultAllocator nested(inner);
+      ASSERT_EQ(rm.getDefaultAllocator().getName(), "thread_default_inner");
+    }
+    ASSERT_EQ(rm.getDefaultAllocator().getName(), "thread_default_pool");
+
+    // Other threads still see the global default.
+    std::string other_default;
+    std::thread other([&] {
+      other_default = rm.getDefaultAllocator().getName();
+    });
+    other.join();
+    ASSERT_EQ(other_default, global_default);
+  }
+
+  ASSERT_EQ(rm.getDefaultAllocator().getName(), global_default);
+
+  rm.setThreadDefaultAllocator(inner);
+  ASSERT_EQ(rm.getDefaultAllocator().getName(), "thread_default_inner");
+  rm.resetThreadDefaultAllocator();
+  ASSERT_EQ(rm.getDefaultAllocator().getName(), global_default);
+}
+
+TEST(Allocator, AllocateZeroedReusedBlock)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "zeroed_pool", rm.getAllocator("HOST"));
+
+  const size_t size = 1024;
+
+  char* dirty = static_cast<char*>(pool.allocate(size));
+  std::fill(dirty, dirty + size, 'x');
+  pool.deallocate(dirty);
+
+  char* data = static_cast<char*>(pool.allocateZeroed(size));
+  ASSERT_EQ(dirty, data);
+
+  for (size_t i = 0; i < size; ++i) {
+    ASSERT_EQ(0, data[i]);
+  }
+
+  pool.deallocate(data);
+}
+
+TEST(Allocator, Statistics)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "statistics_pool", rm.getAllocator("HOST"), 4096, 4096);
+
+  void* untimed = allocator.allocate(64);
+  allocator.deallocate(untimed);
+
+  auto summary = allocator.getStatistics();
+  ASSERT_EQ(0u, summary.allocate_ns.count);
+
+  allocator.enableStatistics();
+  allocator.enableStatistics();
+
+  void* src = allocator.allocate(100);
+  void* dst = allocator.allocate(1000);
+  rm.copy(dst, src);
+  allocator.deallocate(src);
+  allocator.deallocate(dst);
+
+  summary = allocator.getStatistics();
+
+  ASSERT_EQ(2u, summary.allocate_ns.count);
+  ASSERT_EQ(2u, summary.deallocate_ns.count);
+  ASSERT_EQ(1u, summary.copy_ns.count);
+
+  ASSERT_EQ(2u, summary.allocation_bytes.count);
+  ASSERT_EQ(1100u, summary.allocation_bytes.sum);
+  ASSERT_EQ(1000u, summary.allocation_bytes.max);
+  ASSERT_EQ(1u, summary.allocation_bytes.buckets[umpire::util::Histogram::getBucket(100)]);
+  ASSERT_EQ(1u, summary.allocation_bytes.buckets[umpire::util::Histogram::getBucket(1000)]);
+
+  ASSERT_EQ(127u, summary.allocation_bytes.getPercentile(50));
+  ASSERT_EQ(1000u, summary.allocation_bytes.getPercentile(100));
+  ASSERT_DOUBLE_EQ(550.0, summary.allocation_bytes.getMean());
+
+  allocator.release();
+}
+
+TEST(StrategyAllocator, AllocateDeallocate)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "strategy_allocator_pool", rm.getAllocator("HOST"));
+
+  umpire::StrategyAllocator<umpire::strategy::DynamicPool> pool(allocator);
+  auto copy = pool;
+
+  ASSERT_EQ(allocator.getAllocationStrategy().get(), copy.getStrategy());
+  ASSERT_EQ(allocator.getId(), copy.getId());
+  ASSERT_EQ("strategy_allocator_pool", copy.getName());
+
+  void* data = copy.allocate(1024);
+  ASSERT_NE(nullptr, data);
+  ASSERT_EQ(1024u, rm.getSize(data));
+  ASSERT_EQ(allocator.getId(), rm.getAllocator(data).getId());
+
+  umpire::Allocator erased = copy;
+  ASSERT_EQ(allocator.getAllocationStrategy(), erased.getAllocationStrategy());
+
+  copy.deallocate(data);
+  copy.deallocate(nullptr);
+  ASSERT_EQ(0u, allocator.getCurrentSize());
+
+  ASSERT_THROW(
+      (umpire::StrategyAllocator<umpire::strategy::DynamicPool>(rm.getAllocator("HOST"))),
+      umpire::util::Exception);
+}
+
+TEST(TypedAllocator, NodeContainers)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  umpire::TypedAllocator<int> alloc(rm.getAllocator("HOST"));
+  umpire::TypedAllocator<double> rebound(alloc);
+
+  ASSERT_TRUE(alloc == rebound);
+  ASSERT_FALSE(alloc != umpire::TypedAllocator<int>(rebound));
+  auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "typed_allocator_pool", rm.getAllocator("HOST"));
+  ASSERT_TRUE(alloc != umpire::TypedAllocator<int>(pool));
+
+  std::map<int, double, std::less<int>,
+    umpire::TypedAllocator<std::pair<const int, double>>> map(alloc);
+  for (int i = 0; i < 100; ++i) {
+    map[i] = i;
+  }
+  ASSERT_EQ(100u, map.size());
+
+  std::list<int, umpire::TypedAllocator<int>> list(alloc);
+  list.push_back(1);
+  std::list<int, umpire::TypedAllocator<int>> other(list);
+  ASSERT_EQ(1, other.front());
+
+  auto shared = std::allocate_shared<double>(rebound, 3.0);
+  ASSERT_EQ(3.0, *shared);
+}
+
+TEST(Array, ResizeCopyAndMove)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto host = rm.getAllocator("HOST");
+  auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "array_pool", rm.getAllocator("HOST"));
+
+  umpire::Array<int> a(100, pool);
+  ASSERT_EQ(100u, a.size());
+  ASSERT_EQ(pool.getId(), rm.getAllocator(a.data()).getId());
+  std::iota(a.begin(), a.end(), 0);
+
+  a.resize(1000);
+  ASSERT_EQ(1000u, a.size());
+  ASSERT_EQ(1000*sizeof(int), rm.getSize(a.data()));
+  ASSERT_EQ(99, a[99]);
+
+  umpire::Array<int> b(a, host);
+  ASSERT_EQ(host.getId(), b.getAllocator().getId());
+  ASSERT_EQ(host.getId(), rm.getAllocator(b.data()).getId());
+  ASSERT_TRUE(std::equal(a.begin(), a.begin() + 100, b.begin()));
+
+  a.resize(10);
+  a.shrink_to_fit();
+  ASSERT_EQ(10u, a.capacity());
+  ASSERT_EQ(9, a[9]);
+
+  a = b;
+  ASSERT_EQ(1000u, a.size());
+  ASSERT_EQ(pool.getId(), rm.getAllocator(a.data()).getId());
+  ASSERT_EQ(99, a[99]);
+
+  umpire::Array<int> c(host);
+  c.assign(a, nullptr);
+  ASSERT_EQ(1000u, c.size());
+  ASSERT_EQ(99, c[99]);
+
+  int* data = a.data();
+  umpire::Array<int> d(std::move(a));
+  ASSERT_EQ(data, d.data());
+  ASSERT_EQ(pool.getId(), d.getAllocator().getId());
+  ASSERT_TRUE(a.empty());
+  ASSERT_EQ(nullptr, a.data());
+
+  c = std::move(d);
+  ASSERT_EQ(data, c.data());
+  ASSERT_EQ(pool.getId(), c.getAllocator().getId());
+
+  c.resize(0);
+  c.shrink_to_fit();
+  ASSERT_EQ(nullptr, c.data());
+}
+
+TEST(NodeAllocator, NodeContainers)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  umpire::NodeAllocator<int> alloc(rm.getAllocator("HOST"));
+  ASSERT_TRUE(alloc == umpire::NodeAllocator<long>(alloc));
+
+  {
+    std::map<int, int, std::less<int>,
+      umpire::NodeAllocator<std::pair<const int, int>>> map(alloc);
+    for (int i = 0; i < 1000; ++i) {
+      map[i] = -i;
+    }
+    ASSERT_EQ(-999, map[999]);
+
+    std::list<int, umpire::NodeAllocator<int>> list(alloc);
+    list.push_back(1);
+    list.push_back(2);
+    ASSERT_EQ(3, list.front() + list.back());
+
+  }
+
+  int* one = alloc.allocate(1);
+  int* many = alloc.allocate(16);
+
+  ASSERT_EQ(rm.getAllocator("HOST_node_pool_" + std::to_string(sizeof(int))
+        + "_" + std::to_string(alignof(int))).getId(), rm.getAllocator(one).getId());
+  ASSERT_EQ(rm.getAllocator("HOST").getId(), rm.getAllocator(many).getId());
+
+  alloc.deallocate(one, 1);
+  alloc.deallocate(many, 16);
+}
+
+#if defined(UMPIRE_HAVE_PMR)
+TEST(MemoryResourceAdaptor, Containers)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "pmr_pool", rm.getAllocator("HOST"));
+  allocator.enableStatistics();
+
+  umpire::pmr::memory_resource_adaptor resource(allocator);
+  umpire::pmr::memory_resource_adaptor same(allocator);
+  umpire::pmr::memory_resource_adaptor host(rm.getAllocator("HOST"));
+
+  ASSERT_TRUE(resource == same);
+  ASSERT_FALSE(resource == host);
+
+  {
+    std::pmr::vector<double> data(100, 1.0, &resource);
+    ASSERT_EQ(allocator.getId(), rm.getAllocator(data.data()).getId());
+  }
+  ASSERT_EQ(0u, allocator.getCurrentSize());
+  ASSERT_EQ(1u, allocator.getStatistics().allocate_ns.count);
+
+  void* aligned = resource.allocate(100, 256);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(aligned) % 256);
+  resource.deallocate(aligned, 100, 256);
+
+  {
+    umpire::pmr::monotonic_buffer_resource arena(allocator, 4096);
+    std::pmr::vector<int> ints(&arena);
+    ints.resize(10000);
+    ASSERT_LT(0u, allocator.getCurrentSize());
+  }
+  ASSERT_EQ(0u, allocator.getCurrentSize());
+
+  {
+    umpire::pmr::unsynchronized_pool_resource pool(allocator);
+    std::pmr::map<int, int> map(&pool);
+    map[1] = 2;
+    ASSERT_EQ(2, map[1]);
+  }
+  ASSERT_EQ(0u, allocator.getCurrentSize());
+}
+#endif
+
+TEST(AllocatorConfiguration, Apply)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  std::istringstream config(
+      "# name          strategy             base\n"
+      "config_pool     DynamicPool          HOST  min_initial_alloc_size=64K min_alloc_size=4k policy=first_fit\n"
+      "\n"
+      "config_safe     ThreadSafeAllocator  config_pool  # wraps the pool\n"
+      "config_arena    ArenaAllocator       HOST  block_size=1M alignment=64 track_allocations=true\n"
+      "config_padded   AlignedAllocator     config_pool  alignment=128\n"
+      "config_growing  DynamicPool          HOST  min_initial_alloc_size=0.01% min_alloc_size=4K growth=geometric max_alloc_size=1M\n");
+
+  auto configuration = umpire::AllocatorConfiguration::fromStream(config);
+  ASSERT_EQ(5u, configuration.getEntries().size());
+  ASSERT_EQ(4, configuration.getEntries()[1].line);
+  ASSERT_EQ("4k", configuration.getEntries()[0].options.at("min_alloc_size"));
+
+  configuration.apply(rm);
+
+  auto pool = std::dynamic_pointer_cast<umpire::strategy::DynamicPool>(
+      rm.getAllocator("config_pool").getAllocationStrategy());
+  ASSERT_NE(nullptr, pool);
+  ASSERT_EQ(umpire::PlacementPolicy::first_fit, pool->getPlacementPolicy());
+
+  auto safe = rm.getAllocator("config_safe");
+  void* ptr = safe.allocate(100);
+  ASSERT_EQ(64*1024, pool->getActualSize());
+  safe.deallocate(ptr);
+
+  auto arena = rm.getAllocator("config_arena");
+  ptr = arena.allocate(10);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % 64);
+  arena.deallocate(ptr);
+
+  auto padded = rm.getAllocator("config_padded");
+  ptr = padded.allocate(8);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % 128);
+  padded.deallocate(ptr);
+
+  auto growing = rm.getAllocator("config_growing");
+  ptr = growing.allocate(100);
+  ASSERT_GT(growing.getActualSize(), 0);
+  growing.deallocate(ptr);
+
+  pool->release();
+}
+
+TEST(AllocatorConfiguration, Errors)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  const char* bad_configs[] = {
+    "config_bad_0 DynamicPool\n",
+    "config_bad_1 DynamicPool HOST min_alloc_size\n",
+    "config_bad_2 NoSuchStrategy HOST\n",
+    "config_bad_3 DynamicPool NO_SUCH_ALLOCATOR\n",
+    "config_bad_4 DynamicPool HOST min_alloc_size=lots\n",
+    "config_bad_5 DynamicPool HOST min_aloc_size=1M\n",
+    "config_bad_6 DynamicPool HOST policy=worst_fit\n",
+    "config_bad_7 MonotonicAllocationStrategy HOST\n",
+    "config_bad_8 DynamicPool HOST growth=linear\n",
+    "config_bad_9 DynamicPool HOST min_initial_alloc_size=150%\n",
+    "config_bad_10 DynamicPool HOST min_alloc_size=-5\n",
+    "config_bad_11 DynamicPool HOST min_alloc_size=99999999999999999999999\n",
+    "config_bad_12 DynamicPool HOST min_alloc_size=99999999999T\n",
+    "config_bad_13 DynamicPool HOST min_alloc_size=1M min_alloc_size=2M\n",
+    "config_bad_14 SlotPool HOST slots=0\n",
+    "config_bad_15 SizeClassPool HOST slab_size=1\n",
+    "config_bad_16 ArenaAllocator HOST block_size=0\n",
+  };
+
+  for (auto text : bad_configs) {
+    std::istringstream config(text);
+    ASSERT_THROW(
+        umpire::AllocatorConfiguration::fromStream(config).apply(rm),
+        umpire::util::Exception) << text;
+  }
+
+  ASSERT_THROW(
+      rm.configure("/no/such/umpire/config"),
+      umpire::util::Exception);
+}
+
+TEST(AllocationProfile, RoundTrip)
+{
+  std::istringstream text(
+      "# name  options\n"
+      "pool  high_watermark=1024 actual_size=4096 chunks=3 sizes=4:10,11:2\n"
+      "\n"
+      "other high_watermark=8\n");
+
+  auto profile = umpire::AllocationProfile::fromStream(text);
+  ASSERT_EQ(2u, profile.getEntries().size());
+
+  auto entry = profile.find("pool");
+  ASSERT_NE(nullptr, entry);
+  ASSERT_EQ(1024, entry->high_watermark);
+  ASSERT_EQ(4096, entry->actual_size);
+  ASSERT_EQ(3u, entry->num_chunks);
+  ASSERT_EQ(10u, entry->allocation_bytes.buckets[4]);
+  ASSERT_EQ(12u, entry->allocation_bytes.count);
+  ASSERT_EQ(nullptr, profile.find("missing"));
+
+  std::stringstream written;
+  profile.toStream(written);
+
+  auto reread = umpire::AllocationProfile::fromStream(written);
+  ASSERT_EQ(2u, reread.getEntries().size());
+  ASSERT_EQ(2u, reread.find("pool")->allocation_bytes.buckets[11]);
+  ASSERT_EQ(8, reread.find("other")->high_watermark);
+
+  const char* bad_profiles[] = {
+    "pool high_watermark=lots\n",
+    "pool sizes=4\n",
+    "pool sizes=99:1\n",
+    "pool no_such_option=1\n",
+  };
+
+  for (auto bad : bad_profiles) {
+    std::istringstream stream(bad);
+    ASSERT_THROW(umpire::AllocationProfile::fromStream(stream), umpire::util::Exception) << bad;
+  }
+}
+
+TEST(AllocationProfile, PreSizesPools)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  const std::string filename = "umpire_profile_test.txt";
+  {
+    std::ofstream file(filename);
+    file << "profile_pool high_watermark=524288 actual_size=1048576 chunks=40\n";
+  }
+
+  rm.useProfile(filename);
+
+  auto allocator = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "profile_pool", rm.getAllocator("HOST"), 4096, 4096);
+  auto pool = std::dynamic_pointer_cast<umpire::strategy::DynamicPool>(
+      allocator.getAllocationStrategy());
+
+  ASSERT_EQ(1u, pool->getNumChunks());
+  ASSERT_EQ(1024*1024, pool->getActualSize());
+
+  void* ptr = allocator.allocate(768*1024);
+  ASSERT_EQ(1u, pool->getNumChunks());
+  allocator.deallocate(ptr);
+
+  rm.finalize();
+  rm.useProfile("");
+
+  auto profile = umpire::AllocationProfile::fromFile(filename);
+  auto entry = profile.find("profile_pool");
+  ASSERT_NE(nullptr, entry);
+  ASSERT_EQ(768*1024, entry->high_watermark);
+  ASSERT_EQ(1024*1024, entry->actual_size);
+  ASSERT_EQ(1u, entry->num_chunks);
+  ASSERT_EQ(1u, entry->allocation_bytes.count);
+
+  std::remove(filename.c_str());
+}
+
+TEST(UsageSampler, WritesAllocatorUsage)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  const std::string filename = "umpire_usage_test.csv";
+  rm.startUsageSampler(filename, 1);
+
+  auto allocator = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "usage_pool", rm.getAllocator("HOST"), 4096, 4096);
+  void* ptr = allocator.allocate(1024);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  rm.stopUsageSampler();
+
+  std::ifstream file(filename);
+  std::string line;
+
+  ASSERT_TRUE(static_cast<bool>(std::getline(file, line)));
+  ASSERT_EQ("timestamp,name,current_size,actual_size,high_watermark", line);
+
+  int samples = 0;
+  while (std::getline(file, line)) {
+    if (line.find(",usage_pool,") != std::string::npos) {
+      ASSERT_NE(std::string::npos, line.find(",usage_pool,1024,4096,1024"));
+      ++samples;
+    }
+  }
+
+  // At least the last sample, taken as the sampler stops.
+  ASSERT_GE(samples, 1);
+
+  allocator.deallocate(ptr);
+  std::remove(filename.c_str());
+}
+
+TEST(SharedMemory, SharedBetweenProcesses)
+{
+  // A unique key keeps concurrent test runs apart
+  const std::string key = "test." + std::to_string(::getpid());
+  ::setenv("UMPIRE_SHARED_KEY", key.c_str(), 1);
+
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto allocator = rm.getAllocator("SHARED");
+
+  const size_t size = 1024*1024;
+
+  pid_t child = ::fork();
+  ASSERT_GE(child, 0);
+
+  if (child == 0) {
+    int status = 1;
+    try {
+      int* data = static_cast<int*>(allocator.allocate(size));
+      data[size/sizeof(int) - 1] = 42;
+      status = 0;
+    } catch (...) {
+    }
+    // Exit without deallocating, so the parent can still attach
+    ::_exit(status);
+  }
+
+  int* data = static_cast<int*>(allocator.allocate(size));
+
+  int status = 0;
+  ASSERT_EQ(child, ::waitpid(child, &status, 0));
+  ASSERT_TRUE(WIFEXITED(status));
+  ASSERT_EQ(0, WEXITSTATUS(status));
+
+  ASSERT_EQ(42, data[size/sizeof(int) - 1]);
+  ASSERT_EQ(size, allocator.getCurrentSize());
+
+  allocator.deallocate(data);
+
+  ::unsetenv("UMPIRE_SHARED_KEY");
+}
+
+TEST(HostCow, Snapshot)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto allocator = rm.getAllocator("HOST_COW");
+
+  const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  const size_t size = 64*page_size + 10;
+
+  char* data = static_cast<char*>(allocator.allocate(size));
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<char>(i % 127);
+  }
+
+  char* first = static_cast<char*>(rm.snapshot(data));
+  ASSERT_EQ(size, rm.getSize(first));
+  ASSERT_EQ(allocator.getId(), rm.getAllocator(first).getId());
+  ASSERT_EQ(2*size, allocator.getCurrentSize());
+
+  // Writes on either side stay on that side
+  data[3*page_size] = 'a';
+  first[5*page_size] = 'b';
+  ASSERT_EQ(static_cast<char>((3*page_size) % 127), first[3*page_size]);
+  ASSERT_EQ(static_cast<char>((5*page_size) % 127), data[5*page_size]);
+
+  // Snapshot again while the first is alive, then after it is released
+  char* second = static_cast<char*>(rm.snapshot(data));
+  data[3*page_size] = 'c';
+  ASSERT_EQ('a', second[3*page_size]);
+  ASSERT_EQ(static_cast<char>((3*page_size) % 127), first[3*page_size]);
+
+  rm.deallocate(first);
+
+  data[7*page_size] = 'd';
+  char* third = static_cast<char*>(rm.snapshot(data));
+  data[7*page_size] = 'e';
+  data[size - 1] = 'f';
+
+  ASSERT_EQ('c', third[3*page_size]);
+  ASSERT_EQ('d', third[7*page_size]);
+  ASSERT_EQ(static_cast<char>((size - 1) % 127), third[size - 1]);
+  ASSERT_EQ('a', second[3*page_size]);
+  ASSERT_EQ(static_cast<char>((7*page_size) % 127), second[7*page_size]);
+  for (size_t i = 0; i < size; i += 997) {
+    if (i / page_size != 3 && i / page_size != 5 && i / page_size != 7) {
+      ASSERT_EQ(static_cast<char>(i % 127), third[i]);
+    }
+  }
+
+  // Snapshots can be snapshotted too
+  second[9*page_size] = 'h';
+  char* copy_of_second = static_cast<char*>(rm.snapshot(second));
+  second[3*page_size] = 'g';
+  ASSERT_EQ('a', copy_of_second[3*page_size]);
+  ASSERT_EQ('h', copy_of_second[9*page_size]);
+
+  // With no snapshot left on its file, only the written pages go back to it
+  allocator.deallocate(third);
+  data[11*page_size] = 'i';
+  char* fourth = static_cast<char*>(rm.snapshot(data));
+  data[11*page_size] = 'j';
+  ASSERT_EQ('i', fourth[11*page_size]);
+  ASSERT_EQ('e', fourth[7*page_size]);
+  ASSERT_EQ('f', fourth[size - 1]);
+  ASSERT_EQ(static_cast<char>((13*page_size) % 127), fourth[13*page_size]);
+
+  ASSERT_THROW(rm.snapshot(data + 1), umpire::util::Exception);
+
+  auto host_allocator = rm.getAllocator("HOST");
+  void* host_data = host_allocator.allocate(size);
+  ASSERT_THROW(rm.snapshot(host_data), umpire::util::Exception);
+  host_allocator.deallocate(host_data);
+
+  allocator.deallocate(copy_of_second);
+  allocator.deallocate(fourth);
+  allocator.deallocate(second);
+  allocator.deallocate(data);
+
+  ASSERT_EQ(0u, allocator.getCurrentSize());
+}
+
 class AllocatorByResourceTest :
   public ::testing::TestWithParam< umpire::resource::MemoryResourceType >
 {
@@ -206,7 +987,7 @@ TEST_P(AllocatorByResourceTest, AllocateDeallocate)
 
 const umpire::resource::MemoryResourceType resource_types[] = {
   umpire::resource::Host
-#if defined(UMPIRE_ENABLE_CUDA)
+#if defined(UMPIRE_ENABLE_CUDA) || defined(UMPIRE_ENABLE_HIP)
   , umpire::resource::Device
   , umpire::resource::UnifiedMemory
   , umpire::resource::PinnedMemory
@@ -217,3 +998,95 @@ INSTANTIATE_TEST_CASE_P(
     Resources,
     AllocatorByResourceTest,
     ::testing::ValuesIn(resource_types));
+
+#if defined(UMPIRE_ENABLE_CUDA)
+TEST(Allocator, PinnedPool)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.getAllocator("PINNED_POOL");
+  ASSERT_EQ(allocator.getName(), "PINNED_POOL");
+  ASSERT_EQ(allocator.getPlatform(), umpire::Platform::cuda);
+  ASSERT_EQ(rm.getAllocator(allocator.getId()).getAllocationStrategy(),
+      allocator.getAllocationStrategy());
+
+  void* first = allocator.allocate(1024*1024);
+  ASSERT_EQ(rm.getAllocator(first).getName(), "PINNED_POOL");
+  const long actual = allocator.getActualSize();
+  allocator.deallocate(first);
+
+  // A buffer of the same size class is served from the pool.
+  void* second = allocator.allocate(1024*1024);
+  ASSERT_EQ(allocator.getActualSize(), actual);
+  ASSERT_EQ(allocator.getCurrentSize(), 1024*1024);
+  allocator.deallocate(second);
+}
+
+#if defined(UMPIRE_ENABLE_NUMA)
+TEST(Allocator, DeviceLocalPinnedPool)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  ASSERT_TRUE(rm.isAllocatorRegistered("PINNED::0"));
+  ASSERT_TRUE(rm.isAllocatorRegistered("PINNED_POOL::0"));
+
+  auto allocator = rm.getAllocator("PINNED_POOL::0");
+  ASSERT_EQ(allocator.getName(), "PINNED_POOL::0");
+  ASSERT_EQ(allocator.getPlatform(), umpire::Platform::cuda);
+
+  void* ptr = allocator.allocate(1024*1024);
+  ASSERT_EQ(rm.getAllocator(ptr).getName(), "PINNED_POOL::0");
+  ASSERT_GT(rm.getAllocator("PINNED::0").getCurrentSize(), 0u);
+  allocator.deallocate(ptr);
+}
+#endif
+
+TEST(Allocator, DevicePools)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto pools = rm.makeDevicePools("device_pools", 1024*1024);
+  ASSERT_FALSE(pools.empty());
+
+  for (std::size_t device = 0; device < pools.size(); ++device) {
+    const std::string name = "device_pools::" + std::to_string(device);
+    ASSERT_TRUE(rm.isAllocatorRegistered("DEVICE::" + std::to_string(device)));
+    ASSERT_EQ(pools[device].getName(), name);
+    ASSERT_EQ(rm.getAllocator(name).getId(), pools[device].getId());
+
+    // The first chunk was allocated up front.
+    ASSERT_GE(pools[device].getActualSize(), 1024*1024);
+    const long actual = pools[device].getActualSize();
+
+    void* ptr = pools[device].allocate(1024);
+    ASSERT_EQ(rm.getAllocator(ptr).getName(), name);
+    ASSERT_EQ(pools[device].getActualSize(), actual);
+    pools[device].deallocate(ptr);
+  }
+
+  ASSERT_THROW(rm.makeDevicePools("device_pools", 1024), umpire::util::Exception);
+}
+
+TEST(Allocator, DeviceAllocator)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto device = rm.getAllocator("DEVICE");
+  const long before = device.getCurrentSize();
+
+  umpire::DeviceAllocator scratch(device, 1024*1024);
+  ASSERT_EQ(scratch.getSize(), 1024u*1024);
+  ASSERT_EQ(scratch.getCurrentSize(), 0u);
+  ASSERT_GT(device.getCurrentSize(), before + 1024*1024 - 1);
+
+  scratch.reset();
+  ASSERT_EQ(scratch.getCurrentSize(), 0u);
+
+  scratch.destroy();
+  ASSERT_EQ(device.getCurrentSize(), before);
+
+  ASSERT_THROW(
+      umpire::DeviceAllocator(rm.getAllocator("HOST"), 1024),
+      umpire::util::Exception);
+}
+#endif
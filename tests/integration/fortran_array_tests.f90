@@ -0,0 +1,127 @@
+!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+!! Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+!! Produced at the Lawrence Livermore National Laboratory
+!!
+!! Created by David Beckingsale, david@llnl.gov
+!! LLNL-CODE-747640
+!!
+!! All rights reserved.
+!!
+!! This file is part of Umpire.
+!!
+!! For details, see https://github.com/LLNL/Umpire
+!! Please also see the LICENSE file for MIT license.
+!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+!
+! Checks the typed array allocate and deallocate routines of umpire_mod.
+!
+program fortran_array_tests
+    use iso_c_binding, only : C_DOUBLE, C_INT, C_INTPTR_T, C_SIZE_T, c_loc
+    use umpire_mod
+    implicit none
+
+    type(UmpireResourceManager) :: rm
+    type(UmpireAllocator) :: allocator
+    integer(C_SIZE_T) :: start_size
+
+    real(C_DOUBLE), pointer, dimension(:) :: d1
+    real(C_DOUBLE), pointer, dimension(:, :) :: d2
+    real(C_DOUBLE), pointer, dimension(:, :, :) :: d3
+    real(C_DOUBLE), pointer, dimension(:, :, :, :) :: d4
+    integer(C_INT), pointer, dimension(:) :: i1
+    integer(C_INT), pointer, dimension(:, :) :: i2
+    integer(C_INT), pointer, dimension(:, :, :) :: i3
+    integer(C_INT), pointer, dimension(:, :, :, :) :: i4
+
+    rm = resourcemanager_get()
+    allocator = rm%get_allocator("HOST")
+    start_size = allocator%get_current_size()
+
+    call allocator%allocate_array(d1, [10])
+    call check(all(shape(d1) == [10]), "double 1d shape")
+    call check(allocator%get_size(c_loc(d1)) == 10 * 8, "double 1d size")
+    call check_aligned(transfer(c_loc(d1), 0_C_INTPTR_T), "double 1d")
+    d1 = 1.0_C_DOUBLE
+    call check(sum(d1) == 10.0_C_DOUBLE, "double 1d values")
+
+    call allocator%allocate_array(d2, [10, 20])
+    call check(all(shape(d2) == [10, 20]), "double 2d shape")
+    call check(allocator%get_size(c_loc(d2)) == 10 * 20 * 8, "double 2d size")
+    call check_aligned(transfer(c_loc(d2), 0_C_INTPTR_T), "double 2d")
+    d2 = 1.0_C_DOUBLE
+    call check(sum(d2) == 200.0_C_DOUBLE, "double 2d values")
+
+    call allocator%allocate_array(d3, [10, 20, 30])
+    call check(all(shape(d3) == [10, 20, 30]), "double 3d shape")
+    call check(allocator%get_size(c_loc(d3)) == 10 * 20 * 30 * 8, "double 3d size")
+    call check_aligned(transfer(c_loc(d3), 0_C_INTPTR_T), "double 3d")
+    d3 = 1.0_C_DOUBLE
+    call check(sum(d3) == 6000.0_C_DOUBLE, "double 3d values")
+
+    call allocator%allocate_array(d4, [10, 20, 30, 2])
+    call check(all(shape(d4) == [10, 20, 30, 2]), "double 4d shape")
+    call check(allocator%get_size(c_loc(d4)) == 10 * 20 * 30 * 2 * 8, "double 4d size")
+    call check_aligned(transfer(c_loc(d4), 0_C_INTPTR_T), "double 4d")
+    d4 = 1.0_C_DOUBLE
+    call check(sum(d4) == 12000.0_C_DOUBLE, "double 4d values")
+
+    call allocator%allocate_array(i1, [10])
+    call check(all(shape(i1) == [10]), "int 1d shape")
+    call check(allocator%get_size(c_loc(i1)) == 10 * 4, "int 1d size")
+    call check_aligned(transfer(c_loc(i1), 0_C_INTPTR_T), "int 1d")
+    i1 = 1
+    call check(sum(i1) == 10, "int 1d values")
+
+    call allocator%allocate_array(i2, [10, 20])
+    call check(all(shape(i2) == [10, 20]), "int 2d shape")
+    call check(allocator%get_size(c_loc(i2)) == 10 * 20 * 4, "int 2d size")
+    call check_aligned(transfer(c_loc(i2), 0_C_INTPTR_T), "int 2d")
+    i2 = 1
+    call check(sum(i2) == 200, "int 2d values")
+
+    call allocator%allocate_array(i3, [10, 20, 30])
+    call check(all(shape(i3) == [10, 20, 30]), "int 3d shape")
+    call check(allocator%get_size(c_loc(i3)) == 10 * 20 * 30 * 4, "int 3d size")
+    call check_aligned(transfer(c_loc(i3), 0_C_INTPTR_T), "int 3d")
+    i3 = 1
+    call check(sum(i3) == 6000, "int 3d values")
+
+    call allocator%allocate_array(i4, [10, 20, 30, 2])
+    call check(all(shape(i4) == [10, 20, 30, 2]), "int 4d shape")
+    call check(allocator%get_size(c_loc(i4)) == 10 * 20 * 30 * 2 * 4, "int 4d size")
+    call check_aligned(transfer(c_loc(i4), 0_C_INTPTR_T), "int 4d")
+    i4 = 1
+    call check(sum(i4) == 12000, "int 4d values")
+
+    call allocator%deallocate_array(d1)
+    call allocator%deallocate_array(d2)
+    call allocator%deallocate_array(d3)
+    call allocator%deallocate_array(d4)
+    call allocator%deallocate_array(i1)
+    call allocator%deallocate_array(i2)
+    call allocator%deallocate_array(i3)
+    call allocator%deallocate_array(i4)
+
+    call check(.not. associated(d1) .and. .not. associated(i4), "nullified")
+    call check(allocator%get_current_size() == start_size, "all freed")
+
+contains
+
+    subroutine check(condition, what)
+        logical, intent(IN) :: condition
+        character(*), intent(IN) :: what
+
+        if (.not. condition) then
+            write(*, *) "FAILED: ", what
+            error stop 1
+        end if
+    end subroutine check
+
+    subroutine check_aligned(address, what)
+        integer(C_INTPTR_T), intent(IN) :: address
+        character(*), intent(IN) :: what
+
+        call check(mod(address, int(UMPIRE_ARRAY_ALIGNMENT, C_INTPTR_T)) == 0, what // " alignment")
+    end subroutine check_aligned
+
+end program fortran_array_tests
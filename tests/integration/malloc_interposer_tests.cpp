@@ -0,0 +1,161 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "gtest/gtest.h"
+
+#include <malloc.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/*
+ * Run with libumpire_malloc preloaded. The program does not link Umpire, so
+ * every call below goes through the interposer.
+ */
+
+TEST(MallocInterposer, Preloaded)
+{
+  // Umpire reports the size asked for, glibc the size of its chunk.
+  void* ptr = std::malloc(100);
+  ASSERT_NE(ptr, nullptr);
+  ASSERT_EQ(malloc_usable_size(ptr), 100u);
+  std::free(ptr);
+}
+
+TEST(MallocInterposer, MallocFree)
+{
+  std::vector<char*> allocs;
+
+  for (size_t bytes = 1; bytes <= 1024*1024; bytes *= 4) {
+    char* ptr = static_cast<char*>(std::malloc(bytes));
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % (2 * sizeof(void*)));
+
+    std::memset(ptr, static_cast<int>(bytes % 251), bytes);
+    allocs.push_back(ptr);
+  }
+
+  size_t bytes = 1;
+  for (auto ptr : allocs) {
+    ASSERT_EQ(ptr[bytes - 1], static_cast<char>(bytes % 251));
+    std::free(ptr);
+    bytes *= 4;
+  }
+
+  std::free(nullptr);
+  std::free(std::malloc(0));
+}
+
+TEST(MallocInterposer, Calloc)
+{
+  std::vector<int*> allocs;
+
+  // Reuse blocks dirtied by malloc to check that calloc clears them.
+  for (int i = 0; i < 64; ++i) {
+    void* dirty = std::malloc(64 * sizeof(int));
+    std::memset(dirty, 0xff, 64 * sizeof(int));
+    std::free(dirty);
+
+    int* ptr = static_cast<int*>(std::calloc(64, sizeof(int)));
+    ASSERT_NE(ptr, nullptr);
+    for (int j = 0; j < 64; ++j) {
+      ASSERT_EQ(ptr[j], 0);
+    }
+    allocs.push_back(ptr);
+  }
+
+  for (auto ptr : allocs) {
+    std::free(ptr);
+  }
+
+  // Volatile so the compiler cannot see the overflow coming.
+  volatile size_t count = static_cast<size_t>(-1);
+  ASSERT_EQ(std::calloc(count, 16), nullptr);
+}
+
+TEST(MallocInterposer, Realloc)
+{
+  char* ptr = static_cast<char*>(std::realloc(nullptr, 16));
+  ASSERT_NE(ptr, nullptr);
+  std::memcpy(ptr, "umpire-interpose", 16);
+
+  ptr = static_cast<char*>(std::realloc(ptr, 1024*1024));
+  ASSERT_NE(ptr, nullptr);
+  ASSERT_EQ(std::memcmp(ptr, "umpire-interpose", 16), 0);
+
+  ptr = static_cast<char*>(std::realloc(ptr, 6));
+  ASSERT_NE(ptr, nullptr);
+  ASSERT_EQ(std::memcmp(ptr, "umpire", 6), 0);
+
+  std::free(ptr);
+}
+
+TEST(MallocInterposer, PosixMemalign)
+{
+  std::vector<void*> allocs;
+
+  for (size_t alignment = sizeof(void*); alignment <= 4096; alignment *= 2) {
+    void* ptr = nullptr;
+    ASSERT_EQ(posix_memalign(&ptr, alignment, 100), 0);
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % alignment);
+    std::memset(ptr, 0, 100);
+    allocs.push_back(ptr);
+
+    ptr = aligned_alloc(alignment, alignment);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % alignment);
+    allocs.push_back(ptr);
+
+    // Blocks from glibc can still be reallocated.
+    ptr = std::realloc(allocs.back(), 2 * alignment);
+    ASSERT_NE(ptr, nullptr);
+    allocs.back() = ptr;
+  }
+
+  void* ptr = nullptr;
+  ASSERT_EQ(posix_memalign(&ptr, 3, 100), EINVAL);
+
+  for (auto p : allocs) {
+    std::free(p);
+  }
+}
+
+TEST(MallocInterposer, Threads)
+{
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < 8; ++t) {
+    threads.push_back(std::thread([t] {
+      std::vector<void*> allocs;
+      for (int i = 0; i < 10000; ++i) {
+        allocs.push_back(std::malloc(8 * (t + 1) + i % 512));
+        if (i % 3 == 0) {
+          std::free(allocs[i / 2]);
+          allocs[i / 2] = nullptr;
+        }
+      }
+      for (auto ptr : allocs) {
+        std::free(ptr);
+      }
+    }));
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
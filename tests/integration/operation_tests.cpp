@@ -14,111 +14,1037 @@
 //////////////////////////////////////////////////////////////////////////////
 #include "gtest/gtest.h"
 
+#include <cstring>
+#include <vector>
+
 #include "umpire/config.hpp"
 
-#include "umpire/ResourceManager.hpp"
-#include "umpire/Allocator.hpp"
-#include "umpire/util/Exception.hpp"
+#include "umpire/ResourceManager.hpp"
+#include "umpire/Allocator.hpp"
+#include "umpire/TilePipeline.hpp"
+#include "umpire/strategy/BudgetAllocator.hpp"
+#include "umpire/util/Exception.hpp"
+
+#include "umpire/op/MemoryOperationRegistry.hpp"
+
+#include "umpire/op/HostCopyOperation.hpp"
+#include "umpire/op/FileCopyOperation.hpp"
+
+#if defined(UMPIRE_ENABLE_CUDA)
+#include <cuda_runtime_api.h>
+
+#include "umpire/op/CudaFileCopyOperation.hpp"
+#include "umpire/op/CudaPinnedCopyOperation.hpp"
+#include "umpire/op/CudaUnifiedMemoryCopyOperation.hpp"
+
+#include "umpire/strategy/DynamicPool.hpp"
+#endif
+
+#if defined(UMPIRE_ENABLE_HIP)
+#include <hip/hip_runtime_api.h>
+#endif
+
+#if defined(UMPIRE_ENABLE_OPENMP_TARGET)
+#include <omp.h>
+
+#include "umpire/strategy/DynamicPool.hpp"
+#endif
+
+class OperationTest : 
+  public ::testing::TestWithParam< ::testing::tuple<std::string, std::string> >
+{
+  public:
+    virtual void SetUp() {
+      auto& rm = umpire::ResourceManager::getInstance();
+      source_allocator = new umpire::Allocator(rm.getAllocator(::testing::get<0>(GetParam())));
+      dest_allocator = new umpire::Allocator(rm.getAllocator(::testing::get<1>(GetParam())));
+
+      source_array = static_cast<float*>(source_allocator->allocate(m_size*sizeof(float)));
+      dest_array = static_cast<float*>(dest_allocator->allocate(m_size*sizeof(float)));
+
+      check_array = static_cast<float*>(
+          rm.getAllocator("HOST").allocate(m_size*sizeof(float)));
+    }
+
+    virtual void TearDown() {
+      auto& rm = umpire::ResourceManager::getInstance();
+
+      if (source_array)
+        source_allocator->deallocate(source_array);
+
+      if (dest_array)
+        dest_allocator->deallocate(dest_array);
+
+      if (check_array)
+        rm.getAllocator("HOST").deallocate(check_array);
+    }
+
+    float* source_array;
+    float* dest_array;
+    float* check_array;
+
+    const size_t m_size = 1024;
+
+    umpire::Allocator* source_allocator;
+    umpire::Allocator* dest_allocator;
+};
+
+class CopyTest :
+  public OperationTest
+{
+};
+
+TEST_P(CopyTest, Copy) {
+    auto& rm = umpire::ResourceManager::getInstance();
+
+    for (size_t i = 0; i < m_size; i++) {
+      source_array[i] = i;
+    }
+
+    rm.copy(dest_array, source_array);
+
+    rm.copy(check_array, dest_array);
+
+    for (size_t i = 0; i < m_size; i++) {
+      ASSERT_FLOAT_EQ(source_array[i], check_array[i]);
+    }
+}
+
+TEST_P(CopyTest, CopyAsync) {
+    auto& rm = umpire::ResourceManager::getInstance();
+
+    for (size_t i = 0; i < m_size; i++) {
+      source_array[i] = i;
+    }
+
+#if defined(UMPIRE_ENABLE_CUDA)
+    cudaStream_t stream;
+    cudaStreamCreate(&stream);
+#elif defined(UMPIRE_ENABLE_HIP)
+    hipStream_t stream;
+    hipStreamCreate(&stream);
+#else
+    void* stream = nullptr;
+#endif
+
+    rm.copy(dest_array, source_array, 0, stream);
+    rm.copy(check_array, dest_array, 0, stream);
+
+#if defined(UMPIRE_ENABLE_CUDA)
+    cudaStreamSynchronize(stream);
+    cudaStreamDestroy(stream);
+#elif defined(UMPIRE_ENABLE_HIP)
+    hipStreamSynchronize(stream);
+    hipStreamDestroy(stream);
+#endif
+
+    for (size_t i = 0; i < m_size; i++) {
+      ASSERT_FLOAT_EQ(source_array[i], check_array[i]);
+    }
+}
+
+TEST_P(CopyTest, CopyKnownAllocators) {
+    auto& rm = umpire::ResourceManager::getInstance();
+    auto host_allocator = rm.getAllocator("HOST");
+
+    for (size_t i = 0; i < m_size; i++) {
+      source_array[i] = i;
+    }
+
+    rm.copy(dest_array, *dest_allocator,
+        source_array, *source_allocator, m_size*sizeof(float));
+    rm.copy(check_array, host_allocator,
+        dest_array, *dest_allocator, m_size*sizeof(float));
+
+    for (size_t i = 0; i < m_size; i++) {
+      ASSERT_FLOAT_EQ(source_array[i], check_array[i]);
+    }
+}
+
+TEST_P(CopyTest, CopyBatch) {
+    auto& rm = umpire::ResourceManager::getInstance();
+
+    for (size_t i = 0; i < m_size; i++) {
+      source_array[i] = i;
+    }
+
+    // Copy the array in four pieces, then back in one
+    const size_t pieces = 4;
+    const size_t piece_size = m_size/pieces;
+
+    void* dst_ptrs[pieces];
+    void* src_ptrs[pieces];
+    size_t sizes[pieces];
+
+    for (size_t i = 0; i < pieces; i++) {
+      dst_ptrs[i] = &dest_array[i*piece_size];
+      src_ptrs[i] = &source_array[i*piece_size];
+      sizes[i] = piece_size*sizeof(float);
+    }
+
+    rm.copyBatch(dst_ptrs, src_ptrs, sizes, pieces);
+
+    void* check_ptr = check_array;
+    void* dest_ptr = dest_array;
+    size_t size = 0;
+    rm.copyBatch(&check_ptr, &dest_ptr, &size, 1);
+
+    for (size_t i = 0; i < m_size; i++) {
+      ASSERT_FLOAT_EQ(source_array[i], check_array[i]);
+    }
+}
+
+TEST_P(CopyTest, CopyBatchInvalidSize)
+{
+    auto& rm = umpire::ResourceManager::getInstance();
+
+    void* dst_ptrs[] = { dest_array, dest_array };
+    void* src_ptrs[] = { source_array, source_array };
+    size_t sizes[] = { sizeof(float), (m_size+100)*sizeof(float) };
+
+    ASSERT_THROW(
+        rm.copyBatch(dst_ptrs, src_ptrs, sizes, 2),
+        umpire::util::Exception);
+}
+
+TEST_P(CopyTest, CopyLarge) {
+    auto& rm = umpire::ResourceManager::getInstance();
+    auto host_allocator = rm.getAllocator("HOST");
+
+    // Large enough to be staged in several chunks, with a partial last one
+    const size_t large_size = 5*1024*1024 + 3;
+
+    float* large_source = static_cast<float*>(
+        source_allocator->allocate(large_size*sizeof(float)));
+    float* large_dest = static_cast<float*>(
+        dest_allocator->allocate(large_size*sizeof(float)));
+    float* large_check = static_cast<float*>(
+        host_allocator.allocate(large_size*sizeof(float)));
+
+    for (size_t i = 0; i < large_size; i++) {
+      large_source[i] = i;
+    }
+
+    rm.copy(large_dest, large_source);
+    rm.copy(large_check, large_dest);
+
+    for (size_t i = 0; i < large_size; i++) {
+      ASSERT_FLOAT_EQ(large_source[i], large_check[i]);
+    }
+
+    source_allocator->deallocate(large_source);
+    dest_allocator->deallocate(large_dest);
+    host_allocator.deallocate(large_check);
+}
+
+TEST_P(CopyTest, CopyOffset)
+{
+    auto& rm = umpire::ResourceManager::getInstance();
+
+    check_array[10] = 3.14;
+
+    rm.copy(&dest_array[11], &check_array[10], sizeof(float));
+    rm.copy(&check_array[0], &dest_array[11], sizeof(float));
+
+    ASSERT_EQ(check_array[0], check_array[10]);
+}
+
+TEST_P(CopyTest, Copy2D)
+{
+    auto& rm = umpire::ResourceManager::getInstance();
+
+    // A 16 x 8 sub-block of a 32 x 32 source, packed into the destination.
+    const size_t nx = 32;
+    const size_t bx = 16;
+    const size_t by = 8;
+
+    for (size_t i = 0; i < m_size; i++) {
+      source_array[i] = i;
+    }
+
+    rm.copy2D(dest_array, bx*sizeof(float),
+        &source_array[2*nx + 3], nx*sizeof(float),
+        bx*sizeof(float), by);
+
+    rm.copy(check_array, dest_array, bx*by*sizeof(float));
+
+    for (size_t j = 0; j < by; j++) {
+      for (size_t i = 0; i < bx; i++) {
+        ASSERT_FLOAT_EQ(source_array[(j + 2)*nx + i + 3], check_array[j*bx + i]);
+      }
+    }
+}
+
+TEST_P(CopyTest, Copy3D)
+{
+    auto& rm = umpire::ResourceManager::getInstance();
+
+    // A 4 x 4 x 4 sub-block of an 8 x 8 x 16 source, packed into the
+    // destination.
+    const size_t nx = 8;
+    const size_t ny = 8;
+    const size_t b = 4;
+
+    for (size_t i = 0; i < m_size; i++) {
+      source_array[i] = i;
+    }
+
+    rm.copy3D(dest_array, b*sizeof(float), b,
+        &source_array[(3*ny + 2)*nx + 1], nx*sizeof(float), ny,
+        b*sizeof(float), b, b);
+
+    rm.copy(check_array, dest_array, b*b*b*sizeof(float));
+
+    for (size_t k = 0; k < b; k++) {
+      for (size_t j = 0; j < b; j++) {
+        for (size_t i = 0; i < b; i++) {
+          ASSERT_FLOAT_EQ(
+              source_array[((k + 3)*ny + j + 2)*nx + i + 1],
+              check_array[(k*b + j)*b + i]);
+        }
+      }
+    }
+}
+
+TEST_P(CopyTest, CopyStridedInvalid)
+{
+    auto& rm = umpire::ResourceManager::getInstance();
+
+    const size_t pitch = 32*sizeof(float);
+
+    ASSERT_THROW(
+        rm.copy2D(dest_array, pitch, source_array, pitch, pitch + 1, 1),
+        umpire::util::Exception);
+
+    ASSERT_THROW(
+        rm.copy2D(dest_array, pitch, source_array, pitch, pitch, 33),
+        umpire::util::Exception);
+
+    ASSERT_THROW(
+        rm.copy3D(dest_array, pitch, 8, source_array, pitch, 8, pitch, 9, 2),
+        umpire::util::Exception);
+
+    ASSERT_THROW(
+        rm.copy3D(dest_array, pitch, 8, source_array, pitch, 8, pitch, 8, 5),
+        umpire::util::Exception);
+}
+
+TEST_P(CopyTest, InvalidSize)
+{
+    auto& rm = umpire::ResourceManager::getInstance();
+
+    ASSERT_THROW(
+        rm.copy(dest_array, source_array, (m_size+100)*sizeof(float)),
+        umpire::util::Exception);
+
+    float* small_dest_array = static_cast<float*>(
+        dest_allocator->allocate(10*sizeof(float)));
+
+    ASSERT_THROW(
+        rm.copy(small_dest_array, source_array),
+        umpire::util::Exception);
+
+    dest_allocator->deallocate(small_dest_array);
+}
+
+TEST(MemoryOperationRegistry, FindByType)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto strategy = rm.getAllocator("HOST").getAllocationStrategy();
+
+  auto& op_registry = umpire::op::MemoryOperationRegistry::getInstance();
+
+  ASSERT_EQ(
+      op_registry.find(umpire::op::MemoryOperationType::copy,
+        umpire::Platform::cpu, umpire::Platform::cpu),
+      op_registry.find("COPY", strategy, strategy).get());
+
+  ASSERT_EQ(
+      op_registry.find(umpire::op::MemoryOperationType::memset,
+        umpire::Platform::cpu, umpire::Platform::cpu),
+      op_registry.find("MEMSET", strategy, strategy).get());
+
+  ASSERT_EQ(
+      op_registry.find(umpire::op::MemoryOperationType::reallocate,
+        umpire::Platform::cpu, umpire::Platform::cpu),
+      op_registry.find("REALLOCATE", strategy, strategy).get());
+
+#if !defined(UMPIRE_ENABLE_CUDA)
+  ASSERT_THROW(
+      op_registry.find(umpire::op::MemoryOperationType::copy,
+        umpire::Platform::cpu, umpire::Platform::cuda),
+      umpire::util::Exception);
+#endif
+}
+
+TEST(MemoryOperationRegistry, FindByResourceType)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto& op_registry = umpire::op::MemoryOperationRegistry::getInstance();
+
+  auto host = rm.getAllocator("HOST").getAllocationStrategy();
+
+  // With no specialized operation the Platform operation is used
+  ASSERT_EQ(
+      op_registry.find(umpire::op::MemoryOperationType::copy,
+        umpire::Platform::cpu, umpire::Platform::cpu),
+      op_registry.find(umpire::op::MemoryOperationType::copy,
+        host.get(), host.get()));
+
+  auto file = rm.getAllocator("FILE").getAllocationStrategy();
+
+  ASSERT_EQ(umpire::resource::File, rm.getAllocator("FILE").getResourceType());
+
+  ASSERT_NE(nullptr, dynamic_cast<umpire::op::FileCopyOperation*>(
+      op_registry.find(umpire::op::MemoryOperationType::copy,
+        file.get(), host.get())));
+
+#if defined(UMPIRE_ENABLE_CUDA)
+  auto pinned = rm.getAllocator("PINNED").getAllocationStrategy();
+  auto um = rm.getAllocator("UM").getAllocationStrategy();
+  auto device = rm.getAllocator("DEVICE").getAllocationStrategy();
+
+  ASSERT_EQ(umpire::resource::PinnedMemory, rm.getAllocator("PINNED").getResourceType());
+
+  ASSERT_NE(nullptr, dynamic_cast<umpire::op::HostCopyOperation*>(
+      op_registry.find(umpire::op::MemoryOperationType::copy,
+        pinned.get(), host.get())));
+
+  ASSERT_NE(nullptr, dynamic_cast<umpire::op::CudaPinnedCopyOperation*>(
+      op_registry.find(umpire::op::MemoryOperationType::copy,
+        pinned.get(), device.get())));
+
+  ASSERT_NE(nullptr, dynamic_cast<umpire::op::CudaUnifiedMemoryCopyOperation*>(
+      op_registry.find(umpire::op::MemoryOperationType::copy,
+        um.get(), host.get())));
+
+  ASSERT_NE(nullptr, dynamic_cast<umpire::op::CudaFileCopyOperation*>(
+      op_registry.find(umpire::op::MemoryOperationType::copy,
+        file.get(), device.get())));
+
+  ASSERT_NE(nullptr, dynamic_cast<umpire::op::CudaFileCopyOperation*>(
+      op_registry.find(umpire::op::MemoryOperationType::copy,
+        device.get(), file.get())));
+#elif defined(UMPIRE_ENABLE_HIP)
+  auto pinned = rm.getAllocator("PINNED").getAllocationStrategy();
+
+  ASSERT_EQ(umpire::resource::PinnedMemory, rm.getAllocator("PINNED").getResourceType());
+
+  ASSERT_NE(nullptr, dynamic_cast<umpire::op::HostCopyOperation*>(
+      op_registry.find(umpire::op::MemoryOperationType::copy,
+        pinned.get(), host.get())));
+#endif
+}
+
+TEST(MemoryOperationRegistry, Statistics)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto allocator = rm.getAllocator("HOST");
+
+  const std::size_t size = 4096;
+  char* src = static_cast<char*>(allocator.allocate(size));
+  char* dst = static_cast<char*>(allocator.allocate(size));
+
+  rm.resetOperationStatistics();
+
+  rm.memset(src, 1);
+  rm.copy(dst, src);
+  rm.copy(dst, src, size / 2);
+
+  // Failed calls are not counted
+  ASSERT_THROW(rm.copy(dst, src, 2 * size), umpire::util::Exception);
+
+  auto statistics = rm.getOperationStatistics();
+  ASSERT_EQ(statistics.size(), 2u);
+
+  for (const auto& entry : statistics) {
+    ASSERT_EQ(entry.src_platform, umpire::Platform::cpu);
+    ASSERT_EQ(entry.dst_platform, umpire::Platform::cpu);
+
+    if (entry.type == umpire::op::MemoryOperationType::copy) {
+      ASSERT_EQ(entry.calls, 2u);
+      ASSERT_EQ(entry.bytes, size + size / 2);
+    } else {
+      ASSERT_EQ(entry.type, umpire::op::MemoryOperationType::memset);
+      ASSERT_EQ(entry.calls, 1u);
+      ASSERT_EQ(entry.bytes, size);
+    }
+  }
+
+  rm.resetOperationStatistics();
+  ASSERT_TRUE(rm.getOperationStatistics().empty());
+
+  allocator.deallocate(src);
+  allocator.deallocate(dst);
+}
+
+TEST(MemoryOperationRegistry, CopyCompressed)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto host = rm.getAllocator("HOST");
+#if defined(UMPIRE_ENABLE_CUDA)
+  auto other = rm.getAllocator("DEVICE");
+#else
+  auto other = rm.getAllocator("HOST");
+#endif
+
+  // Mostly zeros and large enough to be compressed
+  const std::size_t size = 8 * 1024 * 1024;
+  char* src = static_cast<char*>(host.allocate(size));
+  char* dst = static_cast<char*>(host.allocate(size));
+  void* middle = other.allocate(size);
+
+  std::memset(src, 0, size);
+  for (std::size_t i = 0; i < size; i += 4096) {
+    src[i] = static_cast<char>(i / 4096 + 1);
+  }
+  std::memset(dst, 1, size);
+
+  ASSERT_NO_THROW(rm.copyCompressed(middle, src));
+
+  other.setCompressCopies(true);
+  ASSERT_NO_THROW(rm.copy(dst, middle));
+  other.setCompressCopies(false);
+
+  ASSERT_EQ(std::memcmp(src, dst, size), 0);
+
+  host.deallocate(src);
+  host.deallocate(dst);
+  other.deallocate(middle);
+}
+
+TEST(HostAdviseOperation, FileAccessPattern)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto file_allocator = rm.getAllocator("FILE");
+  auto host_allocator = rm.getAllocator("HOST");
+
+  const size_t size = 1024*1024 + 3;
+
+  char* data = static_cast<char*>(file_allocator.allocate(size));
+  char* check = static_cast<char*>(host_allocator.allocate(size));
+
+  rm.advise("MADV_RANDOM", data, 0);
+  rm.memset(data, 0x5A);
+
+  rm.advise("MADV_SEQUENTIAL", data + 100, 0, size - 200);
+  rm.advise("MADV_WILLNEED", data, 0);
+  rm.copy(check, data);
+
+  for (size_t i = 0; i < size; ++i) {
+    ASSERT_EQ(0x5A, check[i]);
+  }
+
+  ASSERT_THROW(
+      rm.advise("MADV_SEQUENTIAL", data, 0, size + 1),
+      umpire::util::Exception);
+
+  host_allocator.deallocate(check);
+  file_allocator.deallocate(data);
+}
+
+TEST(HostCopyOperation, LargeUnaligned)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto allocator = rm.getAllocator("HOST");
+
+  // Past both the threaded and the streaming thresholds, with the copy
+  // starting and ending off any alignment boundary.
+  const size_t size = 40*1024*1024 + 13;
+
+  char* src = static_cast<char*>(allocator.allocate(size + 8));
+  char* dst = static_cast<char*>(allocator.allocate(size + 8));
+
+  for (size_t i = 0; i < size + 8; i++) {
+    src[i] = static_cast<char>(i % 251);
+    dst[i] = 0;
+  }
+
+  rm.copy(dst + 3, src + 5, size);
+
+  ASSERT_EQ(0, dst[0]);
+  ASSERT_EQ(0, dst[2]);
+  for (size_t i = 0; i < size; i++) {
+    ASSERT_EQ(src[i + 5], dst[i + 3]);
+  }
+  ASSERT_EQ(0, dst[size + 3]);
+
+  allocator.deallocate(src);
+  allocator.deallocate(dst);
+}
+
+TEST(HostCopyOperation, LargeStrided)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto allocator = rm.getAllocator("HOST");
+
+  // Every other 4KB row of 8192 rows, enough to be split among threads.
+  const size_t width = 4096;
+  const size_t height = 8192;
+  const size_t src_pitch = 2*width;
+
+  char* src = static_cast<char*>(allocator.allocate(src_pitch*height));
+  char* dst = static_cast<char*>(allocator.allocate(width*height));
+
+  for (size_t i = 0; i < src_pitch*height; i++) {
+    src[i] = static_cast<char>(i % 251);
+  }
+
+  rm.copy2D(dst, width, src, src_pitch, width, height);
+
+  for (size_t j = 0; j < height; j++) {
+    for (size_t i = 0; i < width; i++) {
+      ASSERT_EQ(src[j*src_pitch + i], dst[j*width + i]);
+    }
+  }
+
+  allocator.deallocate(src);
+  allocator.deallocate(dst);
+}
+
+TEST(HostCopyOperation, CopyAsync)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto allocator = rm.getAllocator("HOST");
+
+  const std::size_t size = 64 * 1024 * 1024;
+  char* src = static_cast<char*>(allocator.allocate(size));
+  char* dst = static_cast<char*>(allocator.allocate(size));
+  char* small = static_cast<char*>(allocator.allocate(1024));
+
+  for (std::size_t i = 0; i < size; i += 4096) {
+    src[i] = static_cast<char>(i / 4096);
+  }
+
+  auto large_copy = rm.copyAsync(dst, src);
+  auto small_copy = rm.copyAsync(small, src + 4096, 1024);
+
+  ASSERT_THROW(rm.copyAsync(small, src), umpire::util::Exception);
+
+  small_copy.get();
+  large_copy.get();
+
+  for (std::size_t i = 0; i < size; i += 4096) {
+    ASSERT_EQ(dst[i], static_cast<char>(i / 4096));
+  }
+  ASSERT_EQ(small[0], src[4096]);
+
+#if defined(UMPIRE_ENABLE_CUDA)
+  auto device = rm.getAllocator("DEVICE");
+  void* device_ptr = device.allocate(1024);
+  ASSERT_THROW(rm.copyAsync(device_ptr, small), umpire::util::Exception);
+  device.deallocate(device_ptr);
+#endif
+
+  allocator.deallocate(src);
+  allocator.deallocate(dst);
+  allocator.deallocate(small);
+}
+
+TEST(HostMemsetOperation, Large)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto allocator = rm.getAllocator("HOST");
+
+  // Large enough to be split among threads, ending part way into a page
+  const size_t size = 16*1024*1024 + 100;
+
+  unsigned char* data = static_cast<unsigned char*>(allocator.allocate(size + 1));
+  data[size] = 0;
+
+  rm.memset(data, 0xAB, size);
+
+  for (size_t i = 0; i < size; i++) {
+    ASSERT_EQ(0xAB, data[i]);
+  }
+  ASSERT_EQ(0, data[size]);
+
+  allocator.deallocate(data);
+}
+
+TEST(TilePipeline, ProcessesEveryTile)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto host_allocator = rm.getAllocator("HOST");
+  auto buffer_allocator = rm.makeAllocator<umpire::strategy::BudgetAllocator>(
+      "tile_pipeline_budget", rm.getAllocator("HOST"), 3*4096);
+
+  const size_t size = 10*4096 + 100;
+
+  unsigned char* input = static_cast<unsigned char*>(host_allocator.allocate(size));
+  unsigned char* output = static_cast<unsigned char*>(host_allocator.allocate(size));
+  for (size_t i = 0; i < size; ++i) {
+    input[i] = static_cast<unsigned char>(i % 199);
+  }
+
+  ASSERT_THROW(umpire::TilePipeline(buffer_allocator, 0), umpire::util::Exception);
+
+  umpire::TilePipeline pipeline(buffer_allocator, 4096, 3);
+  ASSERT_EQ(3u*4096, buffer_allocator.getCurrentSize());
+
+  size_t tiles = 0;
+  size_t covered = 0;
+  auto add_one = [&](void* tile, size_t offset, size_t length, void* stream) {
+    // Buffers are reused, nothing is allocated per tile
+    ASSERT_EQ(3u*4096, buffer_allocator.getCurrentSize());
+    ASSERT_EQ(covered, offset);
+    ASSERT_EQ(nullptr, stream);
+
+    unsigned char* data = static_cast<unsigned char*>(tile);
+    for (size_t i = 0; i < length; ++i) {
+      data[i] = static_cast<unsigned char>(data[i] + 1);
+    }
+    covered += length;
+    ++tiles;
+  };
+
+  pipeline.run(input, output, size, add_one);
+
+  ASSERT_EQ(11u, tiles);
+  ASSERT_EQ(size, covered);
+  for (size_t i = 0; i < size; ++i) {
+    ASSERT_EQ(static_cast<unsigned char>(i % 199 + 1), output[i]);
+  }
+
+  // In place
+  tiles = 0;
+  covered = 0;
+  pipeline.run(output, output, size, add_one);
+  ASSERT_EQ(static_cast<unsigned char>(3), output[1]);
+
+  // Without copying back
+  tiles = 0;
+  covered = 0;
+  pipeline.run(input, nullptr, size, add_one);
+  ASSERT_EQ(static_cast<unsigned char>(1), input[1]);
+
+  host_allocator.deallocate(input);
+  host_allocator.deallocate(output);
+}
+
+TEST(ExternalAllocation, CopyAndMemset)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto allocator = rm.getAllocator("HOST");
+
+  const size_t size = 1024;
+
+  std::vector<float> external(size);
+  float* data = static_cast<float*>(allocator.allocate(size*sizeof(float)));
+
+  ASSERT_ANY_THROW(rm.deregisterExternalAllocation(external.data()));
+
+  rm.registerExternalAllocation(
+      external.data(), size*sizeof(float), umpire::resource::Host);
+
+  ASSERT_TRUE(rm.hasAllocator(external.data()));
+  ASSERT_EQ(size*sizeof(float), rm.getSize(external.data()));
+  ASSERT_EQ(rm.getAllocator("EXTERNAL_HOST").getId(),
+      rm.getAllocator(external.data()).getId());
+  ASSERT_EQ(size*sizeof(float),
+      rm.getAllocator("EXTERNAL_HOST").getCurrentSize());
+  ASSERT_ANY_THROW(rm.getAllocator("EXTERNAL_HOST").allocate(size));
+
+  rm.memset(external.data(), 0);
+  for (size_t i = 0; i < size; i++) {
+    data[i] = static_cast<float>(i);
+  }
+
+  rm.copy(external.data(), data);
+  for (size_t i = 0; i < size; i++) {
+    ASSERT_FLOAT_EQ(static_cast<float>(i), external[i]);
+  }
+
+  ASSERT_ANY_THROW(rm.deregisterExternalAllocation(data));
+
+  rm.deregisterExternalAllocation(external.data());
+
+  ASSERT_FALSE(rm.hasAllocator(external.data()));
+  ASSERT_EQ(0, rm.getAllocator("EXTERNAL_HOST").getCurrentSize());
+
+  allocator.deallocate(data);
+}
+
+#if defined(UMPIRE_ENABLE_CUDA)
+TEST(CudaPeerCopyOperation, CopyBetweenDevices)
+{
+  int device_count = 0;
+  cudaGetDeviceCount(&device_count);
+
+  if (device_count < 2) {
+    SUCCEED();
+    return;
+  }
+
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto host_allocator = rm.getAllocator("HOST");
+  auto device0_allocator = rm.getAllocator("DEVICE::0");
+  auto device1_allocator = rm.getAllocator("DEVICE::1");
+
+  const size_t size = 1024*1024;
+
+  float* host_src = static_cast<float*>(host_allocator.allocate(size*sizeof(float)));
+  float* host_dst = static_cast<float*>(host_allocator.allocate(size*sizeof(float)));
+  float* device0_data = static_cast<float*>(device0_allocator.allocate(size*sizeof(float)));
+  float* device1_data = static_cast<float*>(device1_allocator.allocate(size*sizeof(float)));
+
+  for (size_t i = 0; i < size; i++) {
+    host_src[i] = static_cast<float>(i);
+    host_dst[i] = 0.0f;
+  }
+
+  rm.copy(device0_data, host_src);
+  rm.copy(device1_data, device0_data);
+  rm.copy(host_dst, device1_data);
+
+  for (size_t i = 0; i < size; i++) {
+    ASSERT_FLOAT_EQ(host_src[i], host_dst[i]);
+  }
+
+  host_allocator.deallocate(host_src);
+  host_allocator.deallocate(host_dst);
+  device0_allocator.deallocate(device0_data);
+  device1_allocator.deallocate(device1_data);
+}
+
+TEST(CudaPinnedCopyOperation, RegisteredHostMemory)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto device_allocator = rm.getAllocator("DEVICE");
+
+  const size_t size = 1024*1024;
 
-#include "umpire/op/MemoryOperationRegistry.hpp"
+  std::vector<float> host_src(size);
+  std::vector<float> host_dst(size, 0.0f);
+  for (size_t i = 0; i < size; i++) {
+    host_src[i] = static_cast<float>(i);
+  }
 
-#if defined(UMPIRE_ENABLE_CUDA)
-#include <cuda_runtime_api.h>
-#endif
+  rm.registerHostMemory(host_src.data(), size*sizeof(float));
+  rm.registerHostMemory(host_dst.data(), size*sizeof(float));
 
-class OperationTest : 
-  public ::testing::TestWithParam< ::testing::tuple<std::string, std::string> >
-{
-  public:
-    virtual void SetUp() {
-      auto& rm = umpire::ResourceManager::getInstance();
-      source_allocator = new umpire::Allocator(rm.getAllocator(::testing::get<0>(GetParam())));
-      dest_allocator = new umpire::Allocator(rm.getAllocator(::testing::get<1>(GetParam())));
+  ASSERT_EQ(rm.getAllocator(host_src.data()).getName(), "HOST_REGISTERED");
+  ASSERT_EQ(rm.getSize(host_src.data()), size*sizeof(float));
 
-      source_array = static_cast<float*>(source_allocator->allocate(m_size*sizeof(float)));
-      dest_array = static_cast<float*>(dest_allocator->allocate(m_size*sizeof(float)));
+  float* device_data = static_cast<float*>(device_allocator.allocate(size*sizeof(float)));
 
-      check_array = static_cast<float*>(
-          rm.getAllocator("HOST").allocate(m_size*sizeof(float)));
-    }
+  rm.copy(device_data, host_src.data());
+  rm.copy(host_dst.data(), device_data);
 
-    virtual void TearDown() {
-      auto& rm = umpire::ResourceManager::getInstance();
+  for (size_t i = 0; i < size; i++) {
+    ASSERT_FLOAT_EQ(host_src[i], host_dst[i]);
+  }
 
-      if (source_array)
-        source_allocator->deallocate(source_array);
+  device_allocator.deallocate(device_data);
 
-      if (dest_array)
-        dest_allocator->deallocate(dest_array);
+  rm.deregisterHostMemory(host_src.data());
+  rm.deallocate(host_dst.data());
 
-      if (check_array)
-        rm.getAllocator("HOST").deallocate(check_array);
-    }
+  ASSERT_FALSE(rm.hasAllocator(host_src.data()));
+  ASSERT_ANY_THROW(rm.deregisterHostMemory(host_src.data()));
+}
 
-    float* source_array;
-    float* dest_array;
-    float* check_array;
+TEST(CudaPinnedCopyOperation, MappedHostMemory)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto allocator = rm.getAllocator("PINNED_MAPPED");
 
-    const size_t m_size = 1024;
+  const size_t size = 1024;
 
-    umpire::Allocator* source_allocator;
-    umpire::Allocator* dest_allocator;
-};
+  int* host_data = static_cast<int*>(allocator.allocate(size*sizeof(int)));
+  int* device_data = static_cast<int*>(rm.getDevicePointer(host_data));
+  ASSERT_NE(device_data, nullptr);
 
-class CopyTest :
-  public OperationTest
+  // Offsets into the allocation map to the same offsets on the device.
+  ASSERT_EQ(rm.getDevicePointer(host_data + 10), device_data + 10);
+
+  ASSERT_EQ(cudaMemset(device_data, 0xff, size*sizeof(int)), cudaSuccess);
+  ASSERT_EQ(cudaDeviceSynchronize(), cudaSuccess);
+
+  for (size_t i = 0; i < size; i++) {
+    ASSERT_EQ(host_data[i], -1);
+  }
+
+  allocator.deallocate(host_data);
+}
+
+TEST(CudaCopyScheduler, BidirectionalBatch)
 {
-};
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto pinned = rm.getAllocator("PINNED");
+  auto device = rm.getAllocator("DEVICE");
 
-TEST_P(CopyTest, Copy) {
-    auto& rm = umpire::ResourceManager::getInstance();
+  // Larger than a chunk, so each transfer is split
+  const size_t size = 40 * 1024 * 1024;
 
-    for (size_t i = 0; i < m_size; i++) {
-      source_array[i] = i;
-    }
+  char* upload_src = static_cast<char*>(pinned.allocate(size));
+  char* download_dst = static_cast<char*>(pinned.allocate(size));
+  char* upload_dst = static_cast<char*>(device.allocate(size));
+  char* download_src = static_cast<char*>(device.allocate(size));
 
-    rm.copy(dest_array, source_array);
+  std::memset(upload_src, 1, size);
+  std::memset(download_dst, 0, size);
+  rm.memset(download_src, 2);
 
-    rm.copy(check_array, dest_array);
+  cudaStream_t stream;
+  ASSERT_EQ(cudaStreamCreate(&stream), cudaSuccess);
 
-    for (size_t i = 0; i < m_size; i++) {
-      ASSERT_FLOAT_EQ(source_array[i], check_array[i]);
-    }
+  void* dst_ptrs[2] = {upload_dst, download_dst};
+  void* src_ptrs[2] = {upload_src, download_src};
+  size_t sizes[2] = {size, size};
+
+  rm.copyBatch(dst_ptrs, src_ptrs, sizes, 2, stream);
+
+  // Work on the stream is ordered after both directions
+  ASSERT_EQ(cudaMemcpyAsync(upload_src, upload_dst, size,
+        cudaMemcpyDeviceToHost, stream), cudaSuccess);
+  ASSERT_EQ(cudaStreamSynchronize(stream), cudaSuccess);
+
+  for (size_t i = 0; i < size; i += 4096) {
+    ASSERT_EQ(download_dst[i], 2);
+    ASSERT_EQ(upload_src[i], 1);
+  }
+  ASSERT_EQ(download_dst[size - 1], 2);
+
+  cudaStreamDestroy(stream);
+
+  pinned.deallocate(upload_src);
+  pinned.deallocate(download_dst);
+  device.deallocate(upload_dst);
+  device.deallocate(download_src);
 }
 
-TEST_P(CopyTest, CopyOffset)
+TEST(CudaFileCopyOperation, RoundTrip)
 {
-    auto& rm = umpire::ResourceManager::getInstance();
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto file_allocator = rm.getAllocator("FILE");
+  auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "file_copy_pool", rm.getAllocator("DEVICE"));
 
-    check_array[10] = 3.14;
+  // Large enough for the staged path, and not a multiple of the page size
+  const size_t size = 8*1024*1024 + 3;
 
-    rm.copy(&dest_array[11], &check_array[10], sizeof(float));
-    rm.copy(&check_array[0], &dest_array[11], sizeof(float));
+  char* source = static_cast<char*>(file_allocator.allocate(size));
+  char* restored = static_cast<char*>(file_allocator.allocate(size));
+  char* device_data = static_cast<char*>(pool.allocate(size));
 
-    ASSERT_EQ(check_array[0], check_array[10]);
+  for (size_t i = 0; i < size; ++i) {
+    source[i] = static_cast<char>(i % 251);
+  }
+  rm.memset(restored, 0);
+
+  rm.copy(device_data, source);
+  rm.copy(restored, device_data);
+
+  for (size_t i = 0; i < size; ++i) {
+    ASSERT_EQ(source[i], restored[i]);
+  }
+
+  // Copies at an offset into the file use the matching file offset
+  rm.memset(restored, 0);
+  rm.copy(device_data, source + 4096, 4096);
+  rm.copy(restored + 4096, device_data, 4096);
+
+  ASSERT_EQ(0, restored[4095]);
+  for (size_t i = 4096; i < 8192; ++i) {
+    ASSERT_EQ(source[i], restored[i]);
+  }
+  ASSERT_EQ(0, restored[8192]);
+
+  pool.deallocate(device_data);
+  file_allocator.deallocate(restored);
+  file_allocator.deallocate(source);
 }
 
-TEST_P(CopyTest, InvalidSize)
+TEST(CudaIpc, HandleForPoolAllocation)
 {
-    auto& rm = umpire::ResourceManager::getInstance();
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "ipc_pool", rm.getAllocator("DEVICE"));
+
+  char* first = static_cast<char*>(pool.allocate(1024));
+  char* second = static_cast<char*>(pool.allocate(1024));
+
+  // Both blocks come from the same cudaMalloc chunk, so their handles name
+  // the same memory and differ only in offset.
+  auto first_handle = rm.getIpcHandle(first);
+  auto second_handle = rm.getIpcHandle(second);
+
+  ASSERT_EQ(0, std::memcmp(first_handle.memory, second_handle.memory, sizeof(first_handle.memory)));
+  ASSERT_EQ(second_handle.offset - first_handle.offset,
+      static_cast<size_t>(second - first));
+  ASSERT_EQ(second_handle.size, 1024u);
+
+  // Handles can also point into the middle of an allocation.
+  auto inner_handle = rm.getIpcHandle(second + 256);
+  ASSERT_EQ(inner_handle.offset, second_handle.offset + 256);
+  ASSERT_EQ(inner_handle.size, 768u);
+
+  pool.deallocate(first);
+  pool.deallocate(second);
+
+  auto host_allocator = rm.getAllocator("HOST");
+  void* host_data = host_allocator.allocate(1024);
+  ASSERT_ANY_THROW(rm.getIpcHandle(host_data));
+  host_allocator.deallocate(host_data);
+}
+#endif
 
-    ASSERT_THROW(
-        rm.copy(dest_array, source_array, (m_size+100)*sizeof(float)),
-        umpire::util::Exception);
+#if defined(UMPIRE_ENABLE_OPENMP_TARGET)
+TEST(OpenMPTargetCopyOperation, CopyThroughPool)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto host_allocator = rm.getAllocator("HOST");
+  auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "omp_target_copy_pool", rm.getAllocator("OMP_TARGET"));
 
-    float* small_dest_array = static_cast<float*>(
-        dest_allocator->allocate(10*sizeof(float)));
+  ASSERT_EQ(pool.getPlatform(), umpire::Platform::omp_target);
 
-    ASSERT_THROW(
-        rm.copy(small_dest_array, source_array),
-        umpire::util::Exception);
+  const size_t size = 1024;
 
-    dest_allocator->deallocate(small_dest_array);
+  float* host_src = static_cast<float*>(host_allocator.allocate(size*sizeof(float)));
+  float* host_dst = static_cast<float*>(host_allocator.allocate(size*sizeof(float)));
+  float* target_a = static_cast<float*>(pool.allocate(size*sizeof(float)));
+  float* target_b = static_cast<float*>(pool.allocate(size*sizeof(float)));
+
+  for (size_t i = 0; i < size; i++) {
+    host_src[i] = static_cast<float>(i);
+    host_dst[i] = 0.0f;
+  }
+
+  rm.copy(target_a, host_src);
+  rm.copy(target_b, target_a);
+  rm.copy(host_dst, target_b);
+
+  for (size_t i = 0; i < size; i++) {
+    ASSERT_FLOAT_EQ(host_src[i], host_dst[i]);
+  }
+
+  if (::omp_get_num_devices() > 1) {
+    auto other_allocator = rm.getAllocator("OMP_TARGET::1");
+    float* other = static_cast<float*>(other_allocator.allocate(size*sizeof(float)));
+
+    rm.copy(other, target_a);
+    rm.copy(host_dst, other);
+
+    for (size_t i = 0; i < size; i++) {
+      ASSERT_FLOAT_EQ(host_src[i], host_dst[i]);
+    }
+
+    other_allocator.deallocate(other);
+  }
+
+  host_allocator.deallocate(host_src);
+  host_allocator.deallocate(host_dst);
+  pool.deallocate(target_a);
+  pool.deallocate(target_b);
 }
+#endif
 
 const std::string copy_sources[] = {
   "HOST"
-#if defined(UMPIRE_ENABLE_CUDA)
+  , "FILE"
+#if defined(UMPIRE_ENABLE_CUDA) || defined(UMPIRE_ENABLE_HIP)
   , "UM"
   , "PINNED"
 #endif
@@ -126,7 +1052,8 @@ const std::string copy_sources[] = {
 
 const std::string copy_dests[] = {
     "HOST"
-#if defined(UMPIRE_ENABLE_CUDA)
+    , "FILE"
+#if defined(UMPIRE_ENABLE_CUDA) || defined(UMPIRE_ENABLE_HIP)
     , "DEVICE"
     , "UM"
     , "PINNED"
@@ -159,6 +1086,35 @@ TEST_P(MemsetTest, Memset) {
     }
 }
 
+TEST_P(MemsetTest, MemsetAsync) {
+    auto& rm = umpire::ResourceManager::getInstance();
+
+#if defined(UMPIRE_ENABLE_CUDA)
+    cudaStream_t stream;
+    cudaStreamCreate(&stream);
+#elif defined(UMPIRE_ENABLE_HIP)
+    hipStream_t stream;
+    hipStreamCreate(&stream);
+#else
+    void* stream = nullptr;
+#endif
+
+    rm.memset(source_array, 0, 0, stream);
+    rm.copy(check_array, source_array, 0, stream);
+
+#if defined(UMPIRE_ENABLE_CUDA)
+    cudaStreamSynchronize(stream);
+    cudaStreamDestroy(stream);
+#elif defined(UMPIRE_ENABLE_HIP)
+    hipStreamSynchronize(stream);
+    hipStreamDestroy(stream);
+#endif
+
+    for (size_t i = 0; i < m_size; i++) {
+      ASSERT_EQ(0, check_array[i]);
+    }
+}
+
 TEST_P(MemsetTest, InvalidSize)
 {
     auto& rm = umpire::ResourceManager::getInstance();
@@ -177,9 +1133,65 @@ TEST_P(MemsetTest, InvalidPointer)
     umpire::util::Exception);
 }
 
+TEST_P(MemsetTest, Fill) {
+    auto& rm = umpire::ResourceManager::getInstance();
+
+    rm.fill(source_array, 3.5f);
+
+    rm.copy(check_array, source_array);
+
+    for (size_t i = 0; i < m_size; i++) {
+      ASSERT_EQ(3.5f, check_array[i]);
+    }
+}
+
+TEST_P(MemsetTest, FillOffset) {
+    auto& rm = umpire::ResourceManager::getInstance();
+
+    rm.memset(source_array, 0);
+    rm.fill(source_array + 8, -1.0f, 16);
+
+    rm.copy(check_array, source_array);
+
+    for (size_t i = 0; i < m_size; i++) {
+      ASSERT_EQ((i >= 8 && i < 24) ? -1.0f : 0.0f, check_array[i]);
+    }
+}
+
+TEST_P(MemsetTest, FillPattern) {
+    auto& rm = umpire::ResourceManager::getInstance();
+
+    const unsigned char pattern[3] = {1, 2, 3};
+    const size_t length = 3 * ((m_size*sizeof(float)) / 3);
+
+    rm.fill(source_array, pattern, sizeof(pattern), length);
+
+    rm.copy(check_array, source_array);
+
+    const unsigned char* check = reinterpret_cast<unsigned char*>(check_array);
+
+    for (size_t i = 0; i < length; i++) {
+      ASSERT_EQ(pattern[i % 3], check[i]);
+    }
+}
+
+TEST_P(MemsetTest, FillInvalidSize)
+{
+    auto& rm = umpire::ResourceManager::getInstance();
+    const double value = 1.0;
+
+    ASSERT_THROW(
+        rm.fill(source_array, &value, sizeof(value), 12),
+        umpire::util::Exception);
+
+    ASSERT_THROW(
+        rm.fill(source_array, 0.0f, m_size+1),
+        umpire::util::Exception);
+}
+
 const std::string memset_sources[] = {
   "HOST"
-#if defined(UMPIRE_ENABLE_CUDA)
+#if defined(UMPIRE_ENABLE_CUDA) || defined(UMPIRE_ENABLE_HIP)
   , "DEVICE"
   , "UM"
   , "PINNED"
@@ -335,7 +1347,7 @@ TEST_P(ReallocateTest, ReallocateWithAllocatorFail)
 
 const std::string reallocate_sources[] = {
   "HOST"
-#if defined(UMPIRE_ENABLE_CUDA)
+#if defined(UMPIRE_ENABLE_CUDA) || defined(UMPIRE_ENABLE_HIP)
   , "UM"
   , "DEVICE"
   , "PINNED"
@@ -385,9 +1397,59 @@ TEST_P(MoveTest, Move)
   source_array = nullptr;
 }
 
+TEST_P(MoveTest, MoveAsync)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  for (size_t i = 0; i < m_size; i++) {
+    source_array[i] = i;
+  }
+
+#if defined(UMPIRE_ENABLE_CUDA)
+  cudaStream_t stream;
+  cudaStreamCreate(&stream);
+#elif defined(UMPIRE_ENABLE_HIP)
+  hipStream_t stream;
+  hipStreamCreate(&stream);
+#else
+  void* stream = nullptr;
+#endif
+
+  float* moved_array = static_cast<float*>(
+      rm.move(source_array, *dest_allocator, stream));
+
+  if ( dest_allocator->getAllocationStrategy()
+      == source_allocator->getAllocationStrategy()) {
+    ASSERT_EQ(moved_array, source_array);
+  }
+
+  rm.copy(check_array, moved_array, 0, stream);
+
+#if defined(UMPIRE_ENABLE_CUDA)
+  cudaStreamSynchronize(stream);
+  cudaStreamDestroy(stream);
+#elif defined(UMPIRE_ENABLE_HIP)
+  hipStreamSynchronize(stream);
+  hipStreamDestroy(stream);
+#endif
+
+  for (size_t i = 0; i < m_size; i++) {
+    ASSERT_FLOAT_EQ(check_array[i], i);
+  }
+
+  rm.synchronizeMoves();
+
+  if (moved_array != source_array) {
+    ASSERT_FALSE(rm.hasAllocator(source_array));
+  }
+
+  dest_allocator->deallocate(moved_array);
+  source_array = nullptr;
+}
+
 const std::string move_sources[] = {
   "HOST"
-#if defined(UMPIRE_ENABLE_CUDA)
+#if defined(UMPIRE_ENABLE_CUDA) || defined(UMPIRE_ENABLE_HIP)
   , "UM"
   , "PINNED"
 #endif
@@ -395,7 +1457,7 @@ const std::string move_sources[] = {
 
 const std::string move_dests[] = {
   "HOST"
-#if defined(UMPIRE_ENABLE_CUDA)
+#if defined(UMPIRE_ENABLE_CUDA) || defined(UMPIRE_ENABLE_HIP)
   , "DEVICE"
   , "UM"
   , "PINNED"
@@ -410,6 +1472,52 @@ INSTANTIATE_TEST_CASE_P(
       ::testing::ValuesIn(move_dests)
 ));
 
+TEST(Move, InPlaceRequiresUnifiedMemory)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto allocator = rm.getAllocator("HOST");
+
+  void* data = allocator.allocate(1024);
+
+  ASSERT_THROW(rm.move(data, 0), umpire::util::Exception);
+
+  allocator.deallocate(data);
+}
+
+#if defined(UMPIRE_ENABLE_CUDA)
+TEST(Move, UnifiedMemoryInPlace)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto allocator = rm.getAllocator("UM");
+
+  const size_t size = 1024;
+  const long before = allocator.getCurrentSize();
+
+  float* data = static_cast<float*>(allocator.allocate(size*sizeof(float)));
+  for (size_t i = 0; i < size; i++) {
+    data[i] = i;
+  }
+
+  int device;
+  cudaGetDevice(&device);
+
+  ASSERT_EQ(data, rm.move(data, device));
+  ASSERT_EQ(before + static_cast<long>(size*sizeof(float)),
+      allocator.getCurrentSize());
+
+  ASSERT_THROW(rm.move(&data[1], device), umpire::util::Exception);
+
+  ASSERT_EQ(data, rm.move(data, cudaCpuDeviceId));
+  cudaDeviceSynchronize();
+
+  for (size_t i = 0; i < size; i++) {
+    ASSERT_FLOAT_EQ(i, data[i]);
+  }
+
+  allocator.deallocate(data);
+}
+#endif
+
 #if defined(UMPIRE_ENABLE_CUDA)
 class AdviceTest :
   public OperationTest
@@ -491,6 +1599,56 @@ TEST_P(AdviceTest, AccessedBy)
   });
 }
 
+TEST_P(AdviceTest, Prefetch)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  int device = 0;
+
+  if (dest_allocator->getPlatform() == umpire::Platform::cpu) {
+    device = cudaCpuDeviceId;
+  }
+
+  ASSERT_NO_THROW({
+      rm.prefetch(source_array, device);
+      cudaDeviceSynchronize();
+  });
+
+  ASSERT_THROW(
+      rm.prefetch(source_array, device, (m_size+1)*sizeof(float)),
+      umpire::util::Exception);
+}
+
+TEST_P(AdviceTest, OffsetRange)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  int device = 0;
+
+  if (dest_allocator->getPlatform() == umpire::Platform::cpu) {
+    device = cudaCpuDeviceId;
+  }
+
+  float* tile = source_array + m_size/2;
+  const size_t tile_bytes = (m_size/4)*sizeof(float);
+
+  ASSERT_NO_THROW({
+      rm.advise("READ_MOSTLY", tile, device, tile_bytes);
+      rm.advise("PREFERRED_LOCATION", tile, device);
+      rm.prefetch(tile, device, tile_bytes);
+      cudaDeviceSynchronize();
+  });
+
+  // Only half the allocation lies past the tile
+  ASSERT_THROW(
+      rm.prefetch(tile, device, (m_size/2 + 1)*sizeof(float)),
+      umpire::util::Exception);
+
+  ASSERT_THROW(
+      rm.advise("ACCESSED_BY", tile, device, (m_size/2 + 1)*sizeof(float)),
+      umpire::util::Exception);
+}
+
 const std::string advice_sources[] = {
   "UM"
 };
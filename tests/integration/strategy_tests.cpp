@@ -13,19 +13,53 @@
 // Please also see the LICENSE file for MIT license.
 //////////////////////////////////////////////////////////////////////////////
 #include "gtest/gtest.h"
+#include <cstring>
+#include <set>
 #include <string>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include "umpire/config.hpp"
 #include "umpire/ResourceManager.hpp"
+#include "umpire/ScopedArena.hpp"
 
 #include "umpire/strategy/AllocationStrategy.hpp"
+#include "umpire/strategy/AlignedAllocator.hpp"
+#include "umpire/strategy/BudgetAllocator.hpp"
+#include "umpire/strategy/CachingAllocator.hpp"
+#include "umpire/strategy/CommBufferPool.hpp"
+#include "umpire/strategy/CompactingPool.hpp"
+#include "umpire/strategy/ComposedStrategy.hpp"
+#include "umpire/strategy/EvictingAllocator.hpp"
+#include "umpire/strategy/FallbackAllocator.hpp"
+#include "umpire/strategy/LifetimePool.hpp"
+#include "umpire/strategy/MixedPool.hpp"
 #include "umpire/strategy/MonotonicAllocationStrategy.hpp"
+#include "umpire/strategy/ReclaimingAllocator.hpp"
 #include "umpire/strategy/SlotPool.hpp"
 #include "umpire/strategy/DynamicPool.hpp"
+#include "umpire/strategy/SizeClassPool.hpp"
+#include "umpire/strategy/SizedFixedPool.hpp"
 #include "umpire/strategy/ThreadSafeAllocator.hpp"
+#include "umpire/strategy/ThreadCachingAllocator.hpp"
 #include "umpire/strategy/FixedPool.hpp"
+#include "umpire/strategy/ArenaAllocator.hpp"
+#include "umpire/strategy/SlotPool.hpp"
 #include "umpire/strategy/AllocationAdvisor.hpp"
+#include "umpire/strategy/ConcurrentFixedPool.hpp"
+#include "umpire/strategy/HostVirtualPool.hpp"
+
+#if defined(UMPIRE_ENABLE_NUMA)
+#include "umpire/strategy/NumaDispatchAllocator.hpp"
+#include "umpire/alloc/NumaAllocator.hpp"
+#include <numa.h>
+#endif
+
+#if defined(UMPIRE_ENABLE_CUDA)
+#include "umpire/strategy/CudaStreamPool.hpp"
+#include "umpire/strategy/CudaVirtualPool.hpp"
+#endif
 
 #if defined(_OPENMP)
 #include <omp.h>
@@ -37,11 +71,16 @@ static int subsequent_min_size = 512;
 
 const char* AllocationDevices[] = {
   "HOST"
-#if defined(UMPIRE_ENABLE_CUDA)
+    , "HOST_HUGEPAGE"
+#if defined(UMPIRE_ENABLE_CUDA) || defined(UMPIRE_ENABLE_HIP)
     , "DEVICE"
+    , "DEVICE::0"
     , "UM"
     , "PINNED"
 #endif
+#if defined(UMPIRE_ENABLE_NUMA)
+    , "HOST_NUMA0"
+#endif
 };
 
 class StrategyTest :
@@ -105,9 +144,26 @@ TEST_P(StrategyTest, Duplicate)
         poolName.str(), rm.getAllocator(allocatorName)));
 }
 
+TEST_P(StrategyTest, ResourceManagerDeallocate)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto safe_allocator = rm.makeAllocator<umpire::strategy::ThreadSafeAllocator>(
+      poolName.str() + "_safe", *allocator);
+
+  void* alloc = safe_allocator.allocate(100);
+  ASSERT_EQ(safe_allocator.getCurrentSize(), 100);
+  ASSERT_EQ(allocator->getCurrentSize(), 100);
+
+  ASSERT_NO_THROW(rm.deallocate(alloc));
+
+  ASSERT_EQ(safe_allocator.getCurrentSize(), 0);
+  ASSERT_EQ(allocator->getCurrentSize(), 0);
+}
+
 INSTANTIATE_TEST_CASE_P(Allocations, StrategyTest, ::testing::ValuesIn(AllocationDevices));
 
-#if defined(UMPIRE_ENABLE_CUDA)
+#if defined(UMPIRE_ENABLE_CUDA) || defined(UMPIRE_ENABLE_HIP)
 TEST(SimpoolStrategy, Device)
 {
   auto& rm = umpire::ResourceManager::getInstance();
@@ -177,107 +233,2425 @@ TEST(MonotonicStrategy, Host)
   ASSERT_EQ(allocator.getName(), "host_monotonic_pool");
 }
 
-#if defined(UMPIRE_ENABLE_CUDA)
-TEST(MonotonicStrategy, Device)
+TEST(MonotonicStrategy, Distinct)
 {
   auto& rm = umpire::ResourceManager::getInstance();
 
   auto allocator = rm.makeAllocator<umpire::strategy::MonotonicAllocationStrategy>(
-      "device_monotonic_pool", 65536, rm.getAllocator("DEVICE"));
+      "host_monotonic_pool_distinct", 1024, rm.getAllocator("HOST"));
 
-  void* alloc = allocator.allocate(100);
+  char* first = static_cast<char*>(allocator.allocate(100));
+  char* second = static_cast<char*>(allocator.allocate(200));
+  ASSERT_EQ(second, first + 100);
 
-  ASSERT_GE(allocator.getCurrentSize(), 100);
-  ASSERT_EQ(allocator.getSize(alloc), 100);
-  ASSERT_GE(allocator.getHighWatermark(), 100);
-  ASSERT_EQ(allocator.getName(), "device_monotonic_pool");
+  ASSERT_ANY_THROW(allocator.allocate(1024));
 }
 
-TEST(MonotonicStrategy, UM)
+TEST(FallbackAllocator, Host)
 {
   auto& rm = umpire::ResourceManager::getInstance();
 
-  auto allocator = rm.makeAllocator<umpire::strategy::MonotonicAllocationStrategy>(
-      "um_monotonic_pool", 65536, rm.getAllocator("UM"));
+  auto primary = rm.makeAllocator<umpire::strategy::MonotonicAllocationStrategy>(
+      "fallback_primary", 1024, rm.getAllocator("HOST"));
 
-  void* alloc = allocator.allocate(100);
+  auto allocator = rm.makeAllocator<umpire::strategy::FallbackAllocator>(
+      "host_fallback", primary, rm.getAllocator("HOST"));
 
-  ASSERT_GE(allocator.getCurrentSize(), 100);
-  ASSERT_EQ(allocator.getSize(alloc), 100);
-  ASSERT_GE(allocator.getHighWatermark(), 100);
-  ASSERT_EQ(allocator.getName(), "um_monotonic_pool");
+  auto strategy = std::dynamic_pointer_cast<umpire::strategy::FallbackAllocator>(
+      allocator.getAllocationStrategy());
+
+  void* fast = allocator.allocate(512);
+  ASSERT_EQ(0u, strategy->getNumFallbacks());
+  ASSERT_EQ(512, primary.getCurrentSize());
+
+  void* spilled = allocator.allocate(1024);
+  ASSERT_NE(nullptr, spilled);
+  ASSERT_EQ(1u, strategy->getNumFallbacks());
+  ASSERT_EQ(1024u, allocator.getSize(spilled));
+  ASSERT_EQ(512 + 1024, allocator.getCurrentSize());
+
+  allocator.deallocate(spilled);
+  allocator.deallocate(fast);
+
+  ASSERT_EQ(0, allocator.getCurrentSize());
+  ASSERT_EQ(1024 + 512, allocator.getHighWatermark());
 }
 
-TEST(AllocationAdvisor, Create)
+TEST(FallbackAllocator, Chain)
 {
   auto& rm = umpire::ResourceManager::getInstance();
 
-  ASSERT_NO_THROW(
-    auto read_only_alloc = 
-    rm.makeAllocator<umpire::strategy::AllocationAdvisor>(
-      "read_only_um", rm.getAllocator("UM"), "READ_MOSTLY"));
+  const size_t chunk = 64*1024;
 
-  ASSERT_ANY_THROW(
-      auto failed_alloc = 
-    rm.makeAllocator<umpire::strategy::AllocationAdvisor>(
-      "read_only_um", rm.getAllocator("UM"), "FOOBAR"));
+  // A pool whose memory runs out after two chunks.
+  auto limited = rm.makeAllocator<umpire::strategy::HostVirtualPool>(
+      "chain_limited", 2*chunk, chunk);
+  auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "chain_pool", limited, chunk, chunk);
+  auto middle = rm.makeAllocator<umpire::strategy::MonotonicAllocationStrategy>(
+      "chain_middle", 3*chunk, rm.getAllocator("HOST"));
+
+  auto allocator = rm.makeAllocator<umpire::strategy::FallbackAllocator>(
+      "host_chain", std::vector<umpire::Allocator>{pool, middle, rm.getAllocator("HOST")});
+
+  auto strategy = std::dynamic_pointer_cast<umpire::strategy::FallbackAllocator>(
+      allocator.getAllocationStrategy());
+
+  ASSERT_EQ(nullptr, limited.getAllocationStrategy()->tryAllocate(4*chunk));
+
+  void* first = allocator.allocate(chunk);
+  void* second = allocator.allocate(chunk);
+  allocator.deallocate(first);
+  allocator.deallocate(second);
+  ASSERT_EQ(0u, strategy->getNumFallbacks());
+
+  // Only fits once the pool's free chunks are released.
+  void* large = allocator.allocate(2*chunk);
+  ASSERT_EQ(0u, strategy->getNumFallbacks());
+  ASSERT_EQ(2*chunk, static_cast<size_t>(pool.getCurrentSize()));
+
+  void* spilled = allocator.allocate(2*chunk);
+  ASSERT_EQ(1u, strategy->getNumFallbacks());
+  ASSERT_EQ(2*chunk, static_cast<size_t>(middle.getCurrentSize()));
+
+  void* last = allocator.allocate(2*chunk);
+  ASSERT_EQ(2u, strategy->getNumFallbacks());
+  ASSERT_EQ(2*chunk, allocator.getSize(last));
+
+  allocator.deallocate(last);
+  allocator.deallocate(spilled);
+  allocator.deallocate(large);
+
+  ASSERT_EQ(0, allocator.getCurrentSize());
+  ASSERT_EQ(0, pool.getCurrentSize());
 }
 
-TEST(AllocationAdvisor, Host)
+TEST(DynamicPool, TryAllocate)
 {
   auto& rm = umpire::ResourceManager::getInstance();
-  auto um_allocator = rm.getAllocator("UM");
-  auto host_allocator = rm.getAllocator("HOST");
 
-  auto read_only_alloc = 
-    rm.makeAllocator<umpire::strategy::AllocationAdvisor>(
-      "preferred_location_host", um_allocator, "PREFERRED_LOCATION", host_allocator);
+  const size_t chunk = 64*1024;
 
-  ASSERT_NO_THROW({
-      double* data = static_cast<double*>(
-          read_only_alloc.allocate(1024*sizeof(double)));
-      read_only_alloc.deallocate(data);
-  });
+  auto limited = rm.makeAllocator<umpire::strategy::HostVirtualPool>(
+      "try_limited", 2*chunk, chunk);
+  auto allocator = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "try_pool", limited, chunk, chunk);
+
+  ASSERT_EQ(nullptr, allocator.tryAllocate(4*chunk));
+  ASSERT_EQ(0, allocator.getCurrentSize());
+
+  void* ptr = allocator.tryAllocate(chunk);
+  ASSERT_NE(nullptr, ptr);
+  ASSERT_EQ(chunk, allocator.getSize(ptr));
+  ASSERT_TRUE(rm.hasAllocator(ptr));
 
+  allocator.deallocate(ptr);
+  ASSERT_EQ(0, allocator.getCurrentSize());
 }
-#endif
 
-TEST(FixedPool, Host)
+TEST(BudgetAllocator, Host)
 {
-  struct data { int _[100]; };
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  const size_t chunk = 4096;
+
+  auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "budget_pool", rm.getAllocator("HOST"), chunk, chunk);
+  auto allocator = rm.makeAllocator<umpire::strategy::BudgetAllocator>(
+      "host_budget", pool, 4*chunk, 2*chunk);
+
+  auto strategy = std::dynamic_pointer_cast<umpire::strategy::BudgetAllocator>(
+      allocator.getAllocationStrategy());
+
+  void* data[3];
+  for (int i = 0; i < 3; ++i) {
+    data[i] = allocator.allocate(chunk);
+  }
+  ASSERT_EQ(3*chunk, strategy->getBudgetedSize());
+
+  ASSERT_EQ(nullptr, allocator.tryAllocate(2*chunk));
+  ASSERT_ANY_THROW(allocator.allocate(2*chunk));
+  ASSERT_EQ(2u, strategy->getNumRejections());
+  ASSERT_EQ(3*chunk, strategy->getBudgetedSize());
+
+  // Freeing below the soft limit returns the pool's free chunks.
+  allocator.deallocate(data[0]);
+  allocator.deallocate(data[1]);
+  ASSERT_EQ(chunk, strategy->getBudgetedSize());
+  ASSERT_GE(2*chunk, static_cast<size_t>(pool.getActualSize()));
+  ASSERT_LT(0u, strategy->getNumTrims());
+
+  allocator.deallocate(data[2]);
+  ASSERT_EQ(0, allocator.getCurrentSize());
+  ASSERT_EQ(0u, strategy->getBudgetedSize());
+}
 
+TEST(BudgetAllocator, Fallback)
+{
   auto& rm = umpire::ResourceManager::getInstance();
 
-  auto allocator = rm.makeAllocator<umpire::strategy::FixedPool<data>>(
-      "host_fixed_pool", rm.getAllocator("HOST"));
+  auto allocator = rm.makeAllocator<umpire::strategy::BudgetAllocator>(
+      "host_budget_fallback", rm.getAllocator("HOST"), rm.getAllocator("HOST"), 1024);
 
-  void* alloc = allocator.allocate(100);
+  auto strategy = std::dynamic_pointer_cast<umpire::strategy::BudgetAllocator>(
+      allocator.getAllocationStrategy());
 
-  ASSERT_GE(allocator.getCurrentSize(), sizeof(data)*64);
-  ASSERT_EQ(allocator.getSize(alloc), sizeof(data));
-  ASSERT_GE(allocator.getHighWatermark(), sizeof(data)*64);
-  ASSERT_EQ(allocator.getName(), "host_fixed_pool");
+  void* within = allocator.allocate(1024);
+  void* spilled = allocator.allocate(1024);
+  ASSERT_EQ(1u, strategy->getNumRejections());
+  ASSERT_EQ(1024u, strategy->getBudgetedSize());
+  ASSERT_EQ(2048, allocator.getCurrentSize());
+
+  allocator.deallocate(spilled);
+  ASSERT_EQ(1024u, strategy->getBudgetedSize());
+  allocator.deallocate(within);
+  ASSERT_EQ(0u, strategy->getBudgetedSize());
+  ASSERT_EQ(0, allocator.getCurrentSize());
 }
 
-#if defined(_OPENMP)
-TEST(ThreadSafeAllocator, Host)
+TEST(ReclaimingAllocator, Host)
 {
   auto& rm = umpire::ResourceManager::getInstance();
 
-  auto allocator = rm.makeAllocator<umpire::strategy::ThreadSafeAllocator>(
-      "thread_safe_allocator", rm.getAllocator("HOST"));
+  auto host = rm.getAllocator("HOST");
+  auto allocator = rm.makeAllocator<umpire::strategy::ReclaimingAllocator>(
+      "host_reclaiming", host, 1024*1024);
 
-#pragma omp parallel
-  {
-    const size_t size = 1024*omp_get_thread_num();
+  auto reclaiming = std::dynamic_pointer_cast<umpire::strategy::ReclaimingAllocator>(
+      allocator.getAllocationStrategy());
+  ASSERT_EQ(reclaiming->getThreshold(), 1024*1024u);
 
-    double* thread_data = static_cast<double*>(
-     allocator.allocate(size*sizeof(double)));
+  const size_t host_size = host.getCurrentSize();
 
-    allocator.deallocate(thread_data);
+  void* small = allocator.allocate(1024);
+  void* large = allocator.allocate(16*1024*1024);
+  ASSERT_EQ(allocator.getCurrentSize(), 1024u + 16*1024*1024);
+  ASSERT_EQ(rm.getSize(large), 16*1024*1024u);
+
+  allocator.deallocate(small);
+  ASSERT_EQ(reclaiming->getNumReclaimed(), 0u);
+
+  rm.deallocate(large);
+  ASSERT_EQ(allocator.getCurrentSize(), 0u);
+  ASSERT_EQ(reclaiming->getNumReclaimed(), 1u);
+  ASSERT_FALSE(rm.hasAllocator(large));
+
+  reclaiming->flush();
+  ASSERT_EQ(host.getCurrentSize(), host_size);
+}
+
+TEST(ReclaimingAllocator, Pool)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  // The pool is not thread safe, so frees from the reclaim thread are
+  // serialized with allocations.
+  auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "host_reclaiming_base_pool", rm.getAllocator("HOST"), 1024*1024, 1024*1024);
+  auto allocator = rm.makeAllocator<umpire::strategy::ReclaimingAllocator>(
+      "host_reclaiming_pool", pool, 4096);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&allocator] () {
+      for (int i = 0; i < 100; ++i) {
+        void* ptr = allocator.allocate((i % 2) ? 100 : 8192);
+        allocator.deallocate(ptr);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
   }
 
-  SUCCEED();
+  allocator.release();
+  ASSERT_EQ(allocator.getCurrentSize(), 0u);
+  ASSERT_EQ(pool.getCurrentSize(), 0u);
+}
+
+TEST(CompactingPool, Handles)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::CompactingPool>(
+      "host_compacting", rm.getAllocator("HOST"), 4096);
+
+  auto strategy = std::dynamic_pointer_cast<umpire::strategy::CompactingPool>(
+      allocator.getAllocationStrategy());
+
+  // Fill three chunks, then free every other allocation.
+  std::vector<umpire::strategy::CompactingPool::Handle> handles;
+  for (int i = 0; i < 12; ++i) {
+    auto handle = strategy->allocateHandle(1024);
+    char* data = static_cast<char*>(strategy->pin(handle));
+    std::memset(data, i, 1024);
+    strategy->unpin(handle);
+    handles.push_back(handle);
+  }
+  ASSERT_EQ(strategy->getNumChunks(), 3u);
+
+  std::vector<umpire::strategy::CompactingPool::Handle> live;
+  for (int i = 0; i < 12; ++i) {
+    if (i % 2) {
+      strategy->deallocateHandle(handles[i]);
+    } else {
+      live.push_back(handles[i]);
+    }
+  }
+
+  // A pinned allocation stays where it is.
+  void* pinned = strategy->pin(live[1]);
+
+  ASSERT_GT(strategy->compact(), 0u);
+  ASSERT_EQ(strategy->getNumChunks(), 2u);
+  ASSERT_EQ(allocator.getActualSize(), 2*4096);
+  ASSERT_EQ(allocator.getCurrentSize(), 6*1024);
+  ASSERT_EQ(strategy->pin(live[1]), pinned);
+
+  for (size_t i = 0; i < live.size(); ++i) {
+    char* data = static_cast<char*>(strategy->pin(live[i]));
+    ASSERT_EQ(data[0], static_cast<char>(2*i));
+    ASSERT_EQ(data[1023], static_cast<char>(2*i));
+    ASSERT_EQ(rm.getAllocator(data).getName(), "host_compacting");
+    strategy->unpin(live[i]);
+  }
+
+  strategy->unpin(live[1]);
+  strategy->unpin(live[1]);
+
+  for (auto handle : live) {
+    strategy->deallocateHandle(handle);
+  }
+  allocator.release();
+  ASSERT_EQ(strategy->getNumChunks(), 0u);
+}
+
+TEST(CompactingPool, SlidesOverlappingBlocks)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::CompactingPool>(
+      "host_compacting_slide", rm.getAllocator("HOST"), 64*1024);
+
+  auto strategy = std::dynamic_pointer_cast<umpire::strategy::CompactingPool>(
+      allocator.getAllocationStrategy());
+
+  // Plain allocations are never moved.
+  void* fixed = allocator.allocate(64);
+  void* gap = allocator.allocate(32);
+  auto handle = strategy->allocateHandle(8192);
+
+  char* data = static_cast<char*>(strategy->pin(handle));
+  for (int i = 0; i < 8192; ++i) {
+    data[i] = static_cast<char>(i % 251);
+  }
+  strategy->unpin(handle);
+
+  allocator.deallocate(gap);
+  strategy->compact();
+
+  data = static_cast<char*>(strategy->pin(handle));
+  ASSERT_EQ(data, static_cast<char*>(fixed) + 64);
+  for (int i = 0; i < 8192; ++i) {
+    ASSERT_EQ(data[i], static_cast<char>(i % 251));
+  }
+  strategy->unpin(handle);
+
+  strategy->deallocateHandle(handle);
+  allocator.deallocate(fixed);
+  ASSERT_EQ(allocator.getCurrentSize(), 0u);
+}
+
+TEST(CachingAllocator, Host)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  const std::size_t granularity = 64 * 1024;
+  auto allocator = rm.makeAllocator<umpire::strategy::CachingAllocator>(
+      "caching_host", rm.getAllocator("HOST"), granularity);
+  auto cache = std::dynamic_pointer_cast<umpire::strategy::CachingAllocator>(
+      allocator.getAllocationStrategy());
+
+  void* big = allocator.allocate(3 * granularity + 1);
+  ASSERT_EQ(rm.getAllocator(big).getName(), "caching_host");
+  ASSERT_EQ(allocator.getSize(big), 3 * granularity + 1);
+  ASSERT_EQ(allocator.getCurrentSize(), static_cast<long>(3 * granularity + 1));
+  ASSERT_EQ(allocator.getActualSize(), static_cast<long>(4 * granularity));
+
+  // A freed block is reused, and split for a smaller request.
+  allocator.deallocate(big);
+  ASSERT_EQ(cache->getCachedBytes(), 4 * granularity);
+
+  void* small = allocator.allocate(granularity);
+  ASSERT_EQ(small, big);
+  void* rest = allocator.allocate(2 * granularity);
+  ASSERT_EQ(rest, static_cast<char*>(big) + granularity);
+  ASSERT_EQ(cache->getNumSegments(), 1u);
+  ASSERT_EQ(cache->getCachedBytes(), granularity);
+
+  // A request that nothing cached fits takes a new segment.
+  void* other = allocator.allocate(2 * granularity);
+  ASSERT_EQ(cache->getNumSegments(), 2u);
+
+  // Pieces of a segment are merged again before it is released.
+  allocator.deallocate(small);
+  allocator.release();
+  ASSERT_EQ(cache->getNumSegments(), 2u);
+
+  allocator.deallocate(rest);
+  ASSERT_EQ(cache->getCachedBytes(), 4 * granularity);
+  allocator.release();
+  ASSERT_EQ(cache->getNumSegments(), 1u);
+  ASSERT_EQ(allocator.getActualSize(), static_cast<long>(2 * granularity));
+
+  allocator.deallocate(other);
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+  ASSERT_EQ(allocator.getHighWatermark(), static_cast<long>(5 * granularity));
+
+  allocator.release();
+  ASSERT_EQ(allocator.getActualSize(), 0);
+  ASSERT_EQ(cache->getCachedBytes(), 0u);
+}
+
+TEST(CachingAllocator, MaxCachedBytes)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  const std::size_t granularity = 64 * 1024;
+  auto allocator = rm.makeAllocator<umpire::strategy::CachingAllocator>(
+      "caching_host_limited", rm.getAllocator("HOST"), granularity, 2 * granularity);
+  auto cache = std::dynamic_pointer_cast<umpire::strategy::CachingAllocator>(
+      allocator.getAllocationStrategy());
+
+  void* a = allocator.allocate(2 * granularity);
+  void* b = allocator.allocate(2 * granularity);
+
+  allocator.deallocate(a);
+  ASSERT_EQ(cache->getCachedBytes(), 2 * granularity);
+  allocator.deallocate(b);
+  ASSERT_EQ(cache->getCachedBytes(), 2 * granularity);
+  ASSERT_EQ(cache->getNumSegments(), 1u);
+
+  ASSERT_ANY_THROW(
+      rm.makeAllocator<umpire::strategy::CachingAllocator>(
+        "caching_host_bad", rm.getAllocator("HOST"), 0));
+}
+
+TEST(CachingAllocator, SharedByPools)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  const std::size_t chunk = 1024 * 1024;
+  auto chunks = rm.makeAllocator<umpire::strategy::CachingAllocator>(
+      "caching_host_chunks", rm.getAllocator("HOST"), 64 * 1024);
+  auto cache = std::dynamic_pointer_cast<umpire::strategy::CachingAllocator>(
+      chunks.getAllocationStrategy());
+
+  auto first = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "caching_host_first_pool", chunks, chunk, chunk);
+  auto second = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "caching_host_second_pool", chunks, chunk, chunk);
+
+  void* ptr = first.allocate(1024);
+  ASSERT_EQ(rm.getAllocator(ptr).getName(), "caching_host_first_pool");
+  ASSERT_EQ(chunks.getCurrentSize(), static_cast<long>(chunk));
+
+  // A chunk released by one pool is reused by the other.
+  first.deallocate(ptr);
+  first.release();
+  ASSERT_EQ(chunks.getCurrentSize(), 0);
+  ASSERT_EQ(cache->getCachedBytes(), chunk);
+
+  ptr = second.allocate(1024);
+  ASSERT_EQ(cache->getNumSegments(), 1u);
+  ASSERT_EQ(cache->getCachedBytes(), 0u);
+
+  second.deallocate(ptr);
+  second.release();
+  chunks.release();
+  ASSERT_EQ(chunks.getActualSize(), 0);
+}
+
+TEST(CommBufferPool, Host)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  std::vector<std::pair<void*, std::size_t> > registered;
+  int deregistrations = 0;
+
+  const std::size_t slab_size = 1024 * 1024;
+  auto allocator = rm.makeAllocator<umpire::strategy::CommBufferPool>(
+      "host_comm_buffers", rm.getAllocator("HOST"), slab_size,
+      [&] (void* ptr, std::size_t bytes) {
+        registered.push_back(std::make_pair(ptr, bytes)); },
+      [&] (void*, std::size_t) { deregistrations++; });
+  auto pool = std::dynamic_pointer_cast<umpire::strategy::CommBufferPool>(
+      allocator.getAllocationStrategy());
+
+  // Buffers come and go every exchange, but the slab is registered once.
+  for (int step = 0; step < 10; ++step) {
+    void* send = allocator.allocate(64 * 1024);
+    void* recv = allocator.allocate(100 * 1024 + step);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(recv) % 256, 0u);
+
+    void* slab;
+    std::size_t bytes;
+    ASSERT_TRUE(pool->findSlab(recv, &slab, &bytes));
+    ASSERT_EQ(slab, registered[0].first);
+    ASSERT_LE(static_cast<char*>(recv) + 100 * 1024, static_cast<char*>(slab) + bytes);
+
+    allocator.deallocate(send);
+    allocator.deallocate(recv);
+  }
+  ASSERT_EQ(registered.size(), 1u);
+  ASSERT_EQ(pool->getNumSlabs(), 1u);
+  ASSERT_EQ(allocator.getHighWatermark(), 64 * 1024 + 100 * 1024 + 9);
+
+  void* large = allocator.allocate(2 * slab_size);
+  ASSERT_EQ(registered.size(), 2u);
+  ASSERT_GE(registered[1].second, 2 * slab_size);
+
+  int local;
+  void* slab;
+  std::size_t bytes;
+  ASSERT_FALSE(pool->findSlab(&local, &slab, &bytes));
+
+  allocator.deallocate(large);
+  ASSERT_EQ(deregistrations, 0);
+
+  allocator.release();
+  ASSERT_EQ(deregistrations, 2);
+  ASSERT_EQ(pool->getNumSlabs(), 0u);
+  ASSERT_EQ(allocator.getActualSize(), 0);
+}
+
+TEST(EvictingAllocator, Host)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::EvictingAllocator>(
+      "host_evicting", rm.getAllocator("HOST"), rm.getAllocator("HOST"), 3*1024);
+
+  auto strategy = std::dynamic_pointer_cast<umpire::strategy::EvictingAllocator>(
+      allocator.getAllocationStrategy());
+
+  char* data[4];
+  for (int i = 0; i < 3; ++i) {
+    data[i] = static_cast<char*>(allocator.allocate(1024));
+    std::memset(data[i], 'a' + i, 1024);
+  }
+  ASSERT_EQ(0u, strategy->getNumEvictions());
+
+  // The least recently used allocation makes room for the fourth.
+  data[3] = static_cast<char*>(allocator.allocate(1024));
+  ASSERT_EQ(1u, strategy->getNumEvictions());
+  ASSERT_FALSE(strategy->isResident(data[0]));
+  ASSERT_TRUE(strategy->isResident(data[1]));
+  ASSERT_EQ(4*1024, allocator.getCurrentSize());
+
+  data[0] = static_cast<char*>(strategy->acquire(data[0]));
+  ASSERT_TRUE(strategy->isResident(data[0]));
+  ASSERT_FALSE(strategy->isResident(data[1]));
+  ASSERT_EQ(1024u, rm.getSize(data[0]));
+  for (int j = 0; j < 1024; ++j) {
+    ASSERT_EQ('a', data[0][j]);
+  }
+
+  // Everything acquired in this epoch stays on the device.
+  data[2] = static_cast<char*>(strategy->acquire(data[2]));
+  data[3] = static_cast<char*>(strategy->acquire(data[3]));
+  ASSERT_ANY_THROW(strategy->acquire(data[1]));
+
+  strategy->advanceEpoch();
+  data[1] = static_cast<char*>(strategy->acquire(data[1]));
+  for (int j = 0; j < 1024; ++j) {
+    ASSERT_EQ('b', data[1][j]);
+  }
+  ASSERT_FALSE(strategy->isResident(data[0]));
+
+  for (int i = 0; i < 4; ++i) {
+    allocator.deallocate(data[i]);
+  }
+
+  ASSERT_EQ(0, allocator.getCurrentSize());
+  ASSERT_EQ(0, allocator.getActualSize());
+}
+
+TEST(ArenaAllocator, Host)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::ArenaAllocator>(
+      "host_arena", rm.getAllocator("HOST"), 1024, 64);
+  auto arena = std::dynamic_pointer_cast<umpire::strategy::ArenaAllocator>(
+      allocator.getAllocationStrategy());
+  ASSERT_NE(arena, nullptr);
+
+  char* a = static_cast<char*>(allocator.allocate(10));
+  char* b = static_cast<char*>(allocator.allocate(10));
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(a) % 64);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(b) % 64);
+  ASSERT_GE(b, a + 10);
+  ASSERT_EQ(allocator.getSize(b), 10u);
+  ASSERT_EQ(rm.getAllocator(b).getName(), "host_arena");
+  ASSERT_EQ(allocator.getCurrentSize(), 20);
+
+  auto position = arena->mark();
+
+  // Overflowing the first block chains a second one
+  void* big = allocator.allocate(2000);
+  ASSERT_GT(allocator.getActualSize(), 1024);
+  ASSERT_EQ(allocator.getCurrentSize(), 2020);
+
+  allocator.deallocate(b);
+
+  arena->rewind(position);
+  ASSERT_EQ(allocator.getCurrentSize(), 20);
+  ASSERT_EQ(allocator.getSize(a), 10u);
+
+  // Memory after the mark is handed out again
+  void* reused = allocator.allocate(2000);
+  ASSERT_EQ(reused, big);
+
+  arena->reset();
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+  ASSERT_EQ(allocator.getHighWatermark(), 2020);
+  ASSERT_EQ(allocator.allocate(10), a);
+
+  ASSERT_ANY_THROW(arena->rewind(position));
+
+  arena->reset();
+  arena->release();
+  ASSERT_EQ(allocator.getActualSize(), 0);
+  ASSERT_NO_THROW(allocator.allocate(10));
+  arena->reset();
+}
+
+TEST(ArenaAllocator, Aligned)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::ArenaAllocator>(
+      "host_arena_aligned", rm.getAllocator("HOST"), 64*1024);
+
+  allocator.allocate(8);
+  void* ptr = allocator.allocate(100, 256);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % 256);
+  ASSERT_EQ(allocator.getSize(ptr), 100u);
+
+  // Larger than a block, so a new one must be taken.
+  void* big = allocator.allocate(128*1024, 4096);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(big) % 4096);
+
+  allocator.deallocate(ptr);
+  allocator.deallocate(big);
+}
+
+TEST(MonotonicStrategy, Aligned)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::MonotonicAllocationStrategy>(
+      "host_monotonic_aligned", 64*1024, rm.getAllocator("HOST"));
+
+  allocator.allocate(8);
+  void* ptr = allocator.allocate(100, 64);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % 64);
+
+  ASSERT_ANY_THROW(allocator.allocate(64*1024, 64));
+}
+
+TEST(ArenaAllocator, Untracked)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::ArenaAllocator>(
+      "host_arena_untracked", rm.getAllocator("HOST"), 4096, 16, false);
+  auto arena = std::dynamic_pointer_cast<umpire::strategy::ArenaAllocator>(
+      allocator.getAllocationStrategy());
+
+  void* first = allocator.allocate(100);
+  ASSERT_FALSE(rm.hasAllocator(first));
+  ASSERT_NO_THROW(allocator.deallocate(first));
+
+  arena->reset();
+  ASSERT_EQ(allocator.allocate(100), first);
+
+  ASSERT_ANY_THROW(rm.makeAllocator<umpire::strategy::ArenaAllocator>(
+      "host_arena_bad_alignment", rm.getAllocator("HOST"), 4096, 24));
 }
 
+TEST(ScopedArena, ReleasesOnExit)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "scoped_arena_pool", rm.getAllocator("HOST"), 1024*1024, 1024*1024);
+
+  for (int step = 0; step < 3; ++step) {
+    umpire::ScopedArena scope(pool, 64*1024);
+
+    void* ptr = nullptr;
+    for (int i = 0; i < 100; ++i) {
+      ptr = scope.allocate(1000);
+    }
+
+    ASSERT_EQ(rm.getAllocator(ptr).getName(), "scoped_arena_pool::scope");
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(scope.allocate(10, 256)) % 256);
+    ASSERT_EQ(scope.getAllocator().getCurrentSize(), 100*1000 + 10);
+
+    ASSERT_GE(pool.getCurrentSize(), 2*64*1024);
+  }
+
+  // The scope's arena returned its blocks to the pool.
+  ASSERT_EQ(pool.getCurrentSize(), 0);
+
+  auto arena = rm.makeAllocator<umpire::strategy::ArenaAllocator>(
+      "scoped_arena_arena", rm.getAllocator("HOST"), 64*1024);
+
+  void* kept = arena.allocate(100);
+  const auto num_records = rm.getAllocationMapStatistics().num_records;
+  {
+    umpire::ScopedArena scope(arena);
+    for (int i = 0; i < 10; ++i) {
+      scope.allocate(100);
+    }
+    ASSERT_EQ(arena.getCurrentSize(), 11*100);
+  }
+
+  // Only the allocation made before the scope survives.
+  ASSERT_EQ(arena.getCurrentSize(), 100);
+  ASSERT_EQ(rm.getAllocationMapStatistics().num_records, num_records);
+  ASSERT_EQ(rm.getAllocator(kept).getName(), "scoped_arena_arena");
+  arena.deallocate(kept);
+}
+
+#if defined(UMPIRE_ENABLE_CUDA) || defined(UMPIRE_ENABLE_HIP)
+TEST(MonotonicStrategy, Device)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::MonotonicAllocationStrategy>(
+      "device_monotonic_pool", 65536, rm.getAllocator("DEVICE"));
+
+  void* alloc = allocator.allocate(100);
+
+  ASSERT_GE(allocator.getCurrentSize(), 100);
+  ASSERT_EQ(allocator.getSize(alloc), 100);
+  ASSERT_GE(allocator.getHighWatermark(), 100);
+  ASSERT_EQ(allocator.getName(), "device_monotonic_pool");
+}
+
+TEST(MonotonicStrategy, UM)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::MonotonicAllocationStrategy>(
+      "um_monotonic_pool", 65536, rm.getAllocator("UM"));
+
+  void* alloc = allocator.allocate(100);
+
+  ASSERT_GE(allocator.getCurrentSize(), 100);
+  ASSERT_EQ(allocator.getSize(alloc), 100);
+  ASSERT_GE(allocator.getHighWatermark(), 100);
+  ASSERT_EQ(allocator.getName(), "um_monotonic_pool");
+}
+#endif
+
+#if defined(UMPIRE_ENABLE_CUDA)
+TEST(CudaStreamPool, Device)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::CudaStreamPool>(
+      "device_stream_pool", rm.getAllocator("DEVICE"));
+
+  auto pool = std::dynamic_pointer_cast<umpire::strategy::CudaStreamPool>(
+      allocator.getAllocationStrategy());
+
+  cudaStream_t stream_a;
+  cudaStream_t stream_b;
+  cudaStreamCreate(&stream_a);
+  cudaStreamCreate(&stream_b);
+
+  void* alloc = pool->allocate(1000, stream_a);
+  ASSERT_EQ(allocator.getSize(alloc), 1000);
+  ASSERT_EQ(allocator.getCurrentSize(), 1000);
+
+  pool->deallocate(alloc, stream_a);
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+
+  // The same stream reuses the block without waiting
+  void* reused = pool->allocate(1000, stream_a);
+  ASSERT_EQ(reused, alloc);
+  pool->deallocate(reused, stream_a);
+
+  // Another stream reuses it once the freeing stream is idle
+  cudaStreamSynchronize(stream_a);
+  void* other = pool->allocate(1000, stream_b);
+  ASSERT_EQ(other, alloc);
+  pool->deallocate(other, stream_b);
+
+  const long actual_size = allocator.getActualSize();
+  ASSERT_GT(actual_size, 0);
+
+  pool->release();
+  ASSERT_EQ(allocator.getActualSize(), 0);
+
+  cudaStreamDestroy(stream_a);
+  cudaStreamDestroy(stream_b);
+}
+
+TEST(CudaStreamPool, GraphCapture)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::CudaStreamPool>(
+      "device_graph_stream_pool", rm.getAllocator("DEVICE"));
+
+  auto pool = std::dynamic_pointer_cast<umpire::strategy::CudaStreamPool>(
+      allocator.getAllocationStrategy());
+
+  cudaStream_t stream;
+  cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
+
+  cudaGraph_t graph;
+  ASSERT_EQ(cudaSuccess, cudaStreamBeginCapture(stream, cudaStreamCaptureModeGlobal));
+
+  void* scratch = pool->allocate(4*sizeof(int), stream);
+  const int pattern = 0x01020304;
+  rm.fill(scratch, &pattern, sizeof(int), 4*sizeof(int), stream);
+  pool->deallocate(scratch, stream);
+
+  ASSERT_EQ(cudaSuccess, cudaStreamEndCapture(stream, &graph));
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+  ASSERT_EQ(allocator.getActualSize(), 0);
+
+  cudaGraphExec_t exec;
+  ASSERT_EQ(cudaSuccess, cudaGraphInstantiate(&exec, graph, nullptr, nullptr, 0));
+  ASSERT_EQ(cudaSuccess, cudaGraphLaunch(exec, stream));
+  ASSERT_EQ(cudaSuccess, cudaStreamSynchronize(stream));
+
+  cudaGraphExecDestroy(exec);
+  cudaGraphDestroy(graph);
+  cudaStreamDestroy(stream);
+}
+
+TEST(CudaVirtualPool, Device)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::CudaVirtualPool>(
+      "device_virtual_pool", 0, 1024*1024*1024);
+
+  ASSERT_EQ(allocator.getActualSize(), 0);
+
+  char* first = static_cast<char*>(allocator.allocate(1000));
+  char* second = static_cast<char*>(allocator.allocate(1000));
+  ASSERT_EQ(second, first + 1024);
+  ASSERT_EQ(allocator.getCurrentSize(), 2000);
+
+  const long granule = allocator.getActualSize();
+  ASSERT_GT(granule, 0);
+
+  // Growing in place maps the pages after the block
+  ASSERT_EQ(rm.reallocate(second, 4*granule), second);
+  ASSERT_EQ(allocator.getSize(second), 4*granule);
+  ASSERT_GT(allocator.getActualSize(), 4*granule);
+  ASSERT_NO_THROW(rm.memset(second, 0));
+
+  allocator.deallocate(first);
+  allocator.deallocate(second);
+
+  // Freed blocks merge back into the rest of the range
+  char* merged = static_cast<char*>(allocator.allocate(8*granule));
+  ASSERT_EQ(merged, first);
+  allocator.deallocate(merged);
+
+  allocator.trim(granule);
+  ASSERT_EQ(allocator.getActualSize(), granule);
+
+  allocator.release();
+  ASSERT_EQ(allocator.getActualSize(), 0);
+}
+
+TEST(AllocationAdvisor, Create)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  ASSERT_NO_THROW(
+    auto read_only_alloc = 
+    rm.makeAllocator<umpire::strategy::AllocationAdvisor>(
+      "read_only_um", rm.getAllocator("UM"), "READ_MOSTLY"));
+
+  ASSERT_ANY_THROW(
+      auto failed_alloc = 
+    rm.makeAllocator<umpire::strategy::AllocationAdvisor>(
+      "read_only_um", rm.getAllocator("UM"), "FOOBAR"));
+}
+
+TEST(AllocationAdvisor, Host)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto um_allocator = rm.getAllocator("UM");
+  auto host_allocator = rm.getAllocator("HOST");
+
+  auto read_only_alloc = 
+    rm.makeAllocator<umpire::strategy::AllocationAdvisor>(
+      "preferred_location_host", um_allocator, "PREFERRED_LOCATION", host_allocator);
+
+  ASSERT_NO_THROW({
+      double* data = static_cast<double*>(
+          read_only_alloc.allocate(1024*sizeof(double)));
+      read_only_alloc.deallocate(data);
+  });
+
+}
+
+TEST(AllocationAdvisor, Prefetch)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto um_allocator = rm.getAllocator("UM");
+
+  auto prefetch_alloc =
+    rm.makeAllocator<umpire::strategy::AllocationAdvisor>(
+      "prefetch_device", um_allocator, "PREFETCH");
+
+  ASSERT_NO_THROW({
+      double* data = static_cast<double*>(
+          prefetch_alloc.allocate(1024*sizeof(double)));
+      prefetch_alloc.deallocate(data);
+  });
+}
+
+TEST(AllocationAdvisor, PersistingL2)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  cudaStream_t stream;
+  cudaStreamCreate(&stream);
+
+  auto persisting_alloc =
+    rm.makeAllocator<umpire::strategy::AllocationAdvisor>(
+      "persisting_l2_device", rm.getAllocator("DEVICE"), "PERSISTING_L2",
+      static_cast<void*>(stream));
+
+  ASSERT_NO_THROW({
+      double* table = static_cast<double*>(
+          persisting_alloc.allocate(1024*sizeof(double)));
+      rm.advise("PERSISTING_L2", table + 512, 0, 512*sizeof(double), stream);
+      persisting_alloc.deallocate(table);
+  });
+
+  cudaStreamDestroy(stream);
+}
+
+TEST(AllocationAdvisor, PageAlignedPool)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+  auto um_allocator = rm.getAllocator("UM");
+  auto host_allocator = rm.getAllocator("HOST");
+
+  const size_t page_size = 64*1024;
+
+  auto host_pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "um_host_page_pool", um_allocator, 4*1024*1024, 1024*1024,
+      umpire::PlacementPolicy::best_fit, page_size);
+  auto device_pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "um_device_page_pool", um_allocator, 4*1024*1024, 1024*1024,
+      umpire::PlacementPolicy::best_fit, page_size);
+
+  auto host_side = rm.makeAllocator<umpire::strategy::AllocationAdvisor>(
+      "um_host_side", host_pool, "PREFERRED_LOCATION", host_allocator);
+  auto device_side = rm.makeAllocator<umpire::strategy::AllocationAdvisor>(
+      "um_device_side", device_pool, "PREFERRED_LOCATION");
+
+  void* flag = host_side.allocate(sizeof(int));
+  void* array = device_side.allocate(1024*sizeof(double));
+
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(flag) % page_size);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(array) % page_size);
+
+  host_side.deallocate(flag);
+  device_side.deallocate(array);
+}
+#endif
+
+TEST(FixedPool, Host)
+{
+  struct data { int _[100]; };
+
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::FixedPool<data>>(
+      "host_fixed_pool", rm.getAllocator("HOST"));
+
+  void* alloc = allocator.allocate(100);
+
+  ASSERT_GE(allocator.getCurrentSize(), sizeof(data)*64);
+  ASSERT_EQ(allocator.getSize(alloc), sizeof(data));
+  ASSERT_GE(allocator.getHighWatermark(), sizeof(data)*64);
+  ASSERT_EQ(allocator.getName(), "host_fixed_pool");
+}
+
+TEST(ConcurrentFixedPool, Threads)
+{
+  struct data { double _[8]; };
+
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  // Two bitmap words per pool gives 128 blocks per pool
+  auto allocator = rm.makeAllocator<umpire::strategy::ConcurrentFixedPool<data, 2>>(
+      "host_concurrent_fixed_pool", rm.getAllocator("HOST"));
+
+  auto pool = std::dynamic_pointer_cast<umpire::strategy::ConcurrentFixedPool<data, 2>>(
+      allocator.getAllocationStrategy());
+  ASSERT_TRUE(pool->isThreadSafe());
+
+  const int num_threads = 8;
+  const int num_blocks = 1000;
+  std::vector<std::vector<void*>> allocations(num_threads);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.push_back(std::thread([&, t] {
+      for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < num_blocks; ++i) {
+          data* block = static_cast<data*>(allocator.allocate(sizeof(data)));
+          block->_[0] = t;
+          allocations[t].push_back(block);
+        }
+
+        // Keep the last round so the blocks can be checked.
+        if (round < 2) {
+          for (auto ptr : allocations[t]) {
+            allocator.deallocate(ptr);
+          }
+          allocations[t].clear();
+        }
+      }
+    }));
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::set<void*> distinct;
+  for (int t = 0; t < num_threads; ++t) {
+    for (auto ptr : allocations[t]) {
+      ASSERT_EQ(static_cast<data*>(ptr)->_[0], t);
+      distinct.insert(ptr);
+    }
+  }
+
+  ASSERT_EQ(distinct.size(), static_cast<size_t>(num_threads*num_blocks));
+  ASSERT_EQ(pool->getNumUsedBlocks(), static_cast<size_t>(num_threads*num_blocks));
+  ASSERT_EQ(rm.getAllocator(*distinct.begin()).getName(), "host_concurrent_fixed_pool");
+  ASSERT_EQ(allocator.getSize(*distinct.begin()), sizeof(data));
+
+  for (auto ptr : distinct) {
+    allocator.deallocate(ptr);
+  }
+
+  ASSERT_EQ(pool->getNumUsedBlocks(), 0u);
+  ASSERT_ANY_THROW(allocator.deallocate(*distinct.begin()));
+}
+
+TEST(ConcurrentFixedPool, TooLarge)
+{
+  struct data { char _[64]; };
+
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::ConcurrentFixedPool<data>>(
+      "host_concurrent_fixed_pool_too_large", rm.getAllocator("HOST"));
+
+  void* ptr = allocator.allocate(sizeof(data));
+  ASSERT_THROW(allocator.allocate(sizeof(data) + 1), umpire::util::Exception);
+  ASSERT_THROW(rm.reallocate(ptr, 128), umpire::util::Exception);
+
+  // A failed reallocate leaves the original block alone.
+  ASSERT_EQ(allocator.getSize(ptr), sizeof(data));
+  ASSERT_NO_THROW(allocator.deallocate(ptr));
+}
+
+TEST(ConcurrentFixedPool, ReusesFreedBlocks)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  // One bitmap word per pool gives 64 blocks per pool
+  auto allocator = rm.makeAllocator<umpire::strategy::ConcurrentFixedPool<double, 1>>(
+      "host_concurrent_fixed_pool_reuse", rm.getAllocator("HOST"));
+
+  auto pool = std::dynamic_pointer_cast<umpire::strategy::ConcurrentFixedPool<double, 1>>(
+      allocator.getAllocationStrategy());
+
+  // Enough pools to fill more than one segment of the pool directory
+  const size_t num_pools = 100;
+  std::vector<void*> allocs;
+  for (size_t i = 0; i < num_pools * 64; ++i) {
+    allocs.push_back(allocator.allocate(sizeof(double)));
+  }
+  ASSERT_EQ(pool->getNumChunks(), num_pools);
+
+  allocator.deallocate(allocs[3 * 64]);
+  allocator.deallocate(allocs[80 * 64 + 5]);
+
+  std::set<void*> reused;
+  reused.insert(allocator.allocate(sizeof(double)));
+  reused.insert(allocator.allocate(sizeof(double)));
+  ASSERT_EQ(pool->getNumChunks(), num_pools);
+  ASSERT_EQ(reused.count(allocs[3 * 64]), 1u);
+  ASSERT_EQ(reused.count(allocs[80 * 64 + 5]), 1u);
+
+  allocs.push_back(allocator.allocate(sizeof(double)));
+  ASSERT_EQ(pool->getNumChunks(), num_pools + 1);
+
+  for (auto ptr : allocs) {
+    allocator.deallocate(ptr);
+  }
+  ASSERT_EQ(pool->getNumUsedBlocks(), 0u);
+}
+
+TEST(FixedPool, Aligned)
+{
+  struct alignas(64) data { char _[128]; };
+
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::FixedPool<data>>(
+      "host_fixed_pool_aligned", rm.getAllocator("HOST"));
+
+  std::vector<void*> allocs;
+  for (int i = 0; i < 100; ++i) {
+    void* ptr = allocator.allocate(sizeof(data), 128);
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % 128);
+    allocs.push_back(ptr);
+  }
+
+  ASSERT_ANY_THROW(allocator.allocate(sizeof(data), 256));
+
+  for (auto alloc : allocs) {
+    allocator.deallocate(alloc);
+  }
+}
+
+TEST(FixedPool, CacheColoring)
+{
+  struct data { char _[4096]; };
+
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::FixedPool<data, 1>>(
+      "host_fixed_pool_colored", rm.getAllocator("HOST"), true);
+
+  void* a = allocator.allocate(sizeof(data));
+  void* b = allocator.allocate(sizeof(data));
+  // Blocks are handed out in address order within a pool.
+  ASSERT_EQ(static_cast<char*>(a) + sizeof(data) + 64, static_cast<char*>(b));
+  ASSERT_EQ(allocator.getSize(a), sizeof(data));
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(a) % 64);
+
+  allocator.deallocate(a);
+  allocator.deallocate(b);
+  ASSERT_EQ(allocator.getCurrentSize(), static_cast<long>(32 * sizeof(data)));
+}
+
+TEST(FixedPool, HostManyPools)
+{
+  struct data { int _[100]; };
+
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  // One bitmap word per pool gives 32 blocks per pool
+  auto allocator = rm.makeAllocator<umpire::strategy::FixedPool<data, 1>>(
+      "host_fixed_pool_many", rm.getAllocator("HOST"));
+
+  const int num_allocs = 32*8;
+  std::vector<void*> allocs(num_allocs);
+
+  for (int i = 0; i < num_allocs; ++i) {
+    ASSERT_NO_THROW( { allocs[i] = allocator.allocate(sizeof(data)); } );
+  }
+
+  const long pooled_size = allocator.getCurrentSize();
+  ASSERT_GE(pooled_size, sizeof(data)*num_allocs);
+
+  // Free every other block, then everything else in reverse order
+  for (int i = 0; i < num_allocs; i += 2) {
+    ASSERT_NO_THROW( { allocator.deallocate(allocs[i]); } );
+  }
+  for (int i = num_allocs - 1; i > 0; i -= 2) {
+    ASSERT_NO_THROW( { allocator.deallocate(allocs[i]); } );
+  }
+
+  // Freed blocks are reused before any new pool is created
+  for (int i = 0; i < num_allocs; ++i) {
+    ASSERT_NO_THROW( { allocs[i] = allocator.allocate(sizeof(data)); } );
+  }
+  ASSERT_EQ(allocator.getCurrentSize(), pooled_size);
+
+  for (int i = 0; i < num_allocs; ++i) {
+    ASSERT_NO_THROW( { allocator.deallocate(allocs[i]); } );
+  }
+}
+
+TEST(FixedPool, PointerLookup)
+{
+  struct data { double _[4]; };
+
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::FixedPool<data, 1>>(
+      "host_fixed_pool_lookup", rm.getAllocator("HOST"));
+
+  // Blocks are resolved through the pool's chunks, across several pools
+  const int num_allocs = 32*4;
+  std::vector<char*> allocs(num_allocs);
+
+  for (int i = 0; i < num_allocs; ++i) {
+    allocs[i] = static_cast<char*>(allocator.allocate(sizeof(data)));
+  }
+
+  for (auto alloc : allocs) {
+    ASSERT_TRUE(rm.hasAllocator(alloc));
+    ASSERT_EQ(rm.getSize(alloc), sizeof(data));
+    ASSERT_EQ(rm.getSize(alloc + sizeof(data) - 1), sizeof(data));
+    ASSERT_EQ(rm.getAllocator(alloc + 8).getId(), allocator.getId());
+  }
+
+  for (auto alloc : allocs) {
+    rm.deallocate(alloc);
+  }
+
+  ASSERT_EQ(allocator.getCurrentSize(), 4*32*sizeof(data));
+}
+
+TEST(FixedPool, Fragmentation)
+{
+  struct data { int _[100]; };
+
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  // One bitmap word per pool gives 32 blocks per pool
+  auto allocator = rm.makeAllocator<umpire::strategy::FixedPool<data, 1>>(
+      "host_fixed_pool_fragmentation", rm.getAllocator("HOST"));
+
+  auto fixed_pool = std::dynamic_pointer_cast<umpire::strategy::FixedPool<data, 1>>(
+      allocator.getAllocationStrategy());
+  ASSERT_NE(fixed_pool, nullptr);
+
+  const long one_pool_size = allocator.getActualSize();
+
+  ASSERT_EQ(fixed_pool->getNumChunks(), 1u);
+  ASSERT_EQ(fixed_pool->getNumFreeBlocks(), 32u);
+  ASSERT_EQ(fixed_pool->getLargestAvailableBlock(), 32*sizeof(data));
+  ASSERT_EQ(fixed_pool->getFragmentation(), 0.0);
+
+  std::vector<void*> allocs(40);
+  for (auto& alloc : allocs) {
+    alloc = allocator.allocate(sizeof(data));
+  }
+
+  ASSERT_EQ(fixed_pool->getNumChunks(), 2u);
+  ASSERT_EQ(fixed_pool->getNumUsedBlocks(), 40u);
+  ASSERT_EQ(fixed_pool->getNumFreeBlocks(), 24u);
+  ASSERT_EQ(allocator.getActualSize(), 2*one_pool_size);
+
+  // Blocks are handed out in address order, so this leaves four holes of
+  // one block and one run of 24 at the end of the second pool
+  for (int i = 0; i < 8; i += 2) {
+    allocator.deallocate(allocs[i]);
+  }
+
+  ASSERT_EQ(fixed_pool->getAvailableSize(), 28*sizeof(data));
+  ASSERT_EQ(fixed_pool->getLargestAvailableBlock(), 24*sizeof(data));
+  ASSERT_DOUBLE_EQ(fixed_pool->getFragmentation(), 1.0 - 24.0/28.0);
+
+  for (int i = 1; i < 8; i += 2) {
+    allocator.deallocate(allocs[i]);
+  }
+  for (int i = 8; i < 40; ++i) {
+    allocator.deallocate(allocs[i]);
+  }
+
+  // Free runs do not span pools
+  ASSERT_EQ(fixed_pool->getNumUsedBlocks(), 0u);
+  ASSERT_EQ(fixed_pool->getLargestAvailableBlock(), 32*sizeof(data));
+  ASSERT_DOUBLE_EQ(fixed_pool->getFragmentation(), 0.5);
+}
+
+TEST(FixedPool, HostUntracked)
+{
+  struct data { int _[100]; };
+
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::FixedPool<data>>(
+      "host_fixed_pool_untracked", rm.getAllocator("HOST"));
+
+  void* alloc = nullptr;
+  ASSERT_NO_THROW( { alloc = allocator.allocateUntracked(sizeof(data)); } );
+  ASSERT_NE(alloc, nullptr);
+
+  ASSERT_GE(allocator.getCurrentSize(), sizeof(data));
+  ASSERT_FALSE(rm.hasAllocator(alloc));
+
+  ASSERT_NO_THROW( { allocator.deallocateUntracked(alloc); } );
+}
+
+TEST(SizedFixedPool, Host)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  // 40 byte blocks 64 bytes apart, rounded up to 64 blocks per pool
+  auto allocator = rm.makeAllocator<umpire::strategy::SizedFixedPool>(
+      "host_sized_fixed_pool", rm.getAllocator("HOST"), 40, 64, 50);
+  auto pool = std::dynamic_pointer_cast<umpire::strategy::SizedFixedPool>(
+      allocator.getAllocationStrategy());
+
+  ASSERT_EQ(pool->getNumChunks(), 1u);
+  ASSERT_EQ(pool->getNumFreeBlocks(), 64u);
+
+  std::vector<char*> allocs(100);
+  for (auto& alloc : allocs) {
+    alloc = static_cast<char*>(allocator.allocate(40));
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(alloc) % 64, 0u);
+  }
+
+  ASSERT_EQ(pool->getNumChunks(), 2u);
+  ASSERT_EQ(pool->getNumUsedBlocks(), 100u);
+  ASSERT_EQ(allocator.getCurrentSize(), 100 * 40);
+  ASSERT_EQ(allocator.getHighWatermark(), 100 * 40);
+
+  for (auto alloc : allocs) {
+    ASSERT_EQ(rm.getSize(alloc + 39), 40u);
+    ASSERT_EQ(rm.getAllocator(alloc).getId(), allocator.getId());
+  }
+
+  ASSERT_THROW(allocator.allocate(41), umpire::util::Exception);
+
+  // Freed blocks are reused before any new pool is created
+  for (int i = 0; i < 100; i += 2) {
+    allocator.deallocate(allocs[i]);
+  }
+  ASSERT_THROW(allocator.deallocate(allocs[0]), umpire::util::Exception);
+
+  for (int i = 0; i < 100; i += 2) {
+    allocs[i] = static_cast<char*>(allocator.allocate(8));
+  }
+  ASSERT_EQ(pool->getNumChunks(), 2u);
+
+  for (auto alloc : allocs) {
+    rm.deallocate(alloc);
+  }
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+}
+
+TEST(SizedFixedPool, LargePools)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  const std::size_t blocks_per_pool = 64 * 1024;
+  auto allocator = rm.makeAllocator<umpire::strategy::SizedFixedPool>(
+      "host_sized_fixed_pool_large", rm.getAllocator("HOST"), 16, 16, blocks_per_pool);
+  auto pool = std::dynamic_pointer_cast<umpire::strategy::SizedFixedPool>(
+      allocator.getAllocationStrategy());
+
+  std::vector<void*> allocs(blocks_per_pool);
+  for (auto& alloc : allocs) {
+    alloc = allocator.allocateUntracked(16);
+  }
+  ASSERT_EQ(pool->getNumChunks(), 1u);
+
+  allocator.deallocateUntracked(allocs[blocks_per_pool / 2]);
+  allocs[blocks_per_pool / 2] = allocator.allocateUntracked(16);
+  ASSERT_EQ(pool->getNumChunks(), 1u);
+
+  void* extra = allocator.allocate(16);
+  ASSERT_EQ(pool->getNumChunks(), 2u);
+  allocator.deallocate(extra);
+
+  for (auto alloc : allocs) {
+    allocator.deallocateUntracked(alloc);
+  }
+  ASSERT_EQ(pool->getNumUsedBlocks(), 0u);
+}
+
+TEST(SlotPool, Host)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::SlotPool>(
+      "host_slot_pool", 2, rm.getAllocator("HOST"));
+
+  void* a = allocator.allocate(100);
+  ASSERT_EQ(allocator.getSize(a), 100u);
+  ASSERT_EQ(rm.getAllocator(a).getName(), "host_slot_pool");
+  ASSERT_EQ(allocator.getCurrentSize(), 100);
+
+  // A freed allocation is reused by the next request of the same size
+  allocator.deallocate(a);
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+  ASSERT_EQ(allocator.getActualSize(), 100);
+
+  void* b = allocator.allocate(100);
+  ASSERT_EQ(b, a);
+  ASSERT_EQ(allocator.getActualSize(), 100);
+
+  void* c = allocator.allocate(200);
+  void* d = allocator.allocate(300);
+  ASSERT_EQ(allocator.getCurrentSize(), 600);
+  ASSERT_EQ(allocator.getHighWatermark(), 600);
+
+  // With two slots, freeing a third allocation evicts the oldest
+  allocator.deallocate(b);
+  allocator.deallocate(c);
+  allocator.deallocate(d);
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+  ASSERT_EQ(allocator.getActualSize(), 500);
+
+  void* e = allocator.allocate(300);
+  ASSERT_EQ(e, d);
+  ASSERT_EQ(allocator.getActualSize(), 500);
+
+  allocator.release();
+  ASSERT_EQ(allocator.getActualSize(), 300);
+
+  allocator.deallocate(e);
+  allocator.release();
+  ASSERT_EQ(allocator.getActualSize(), 0);
+  ASSERT_EQ(allocator.getHighWatermark(), 600);
+}
+
+TEST(DynamicPool, PlacementPolicies)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  const umpire::PlacementPolicy policies[] = {
+    umpire::PlacementPolicy::first_fit,
+    umpire::PlacementPolicy::best_fit,
+    umpire::PlacementPolicy::segregated_fit
+  };
+
+  for (auto policy : policies) {
+    std::stringstream name;
+    name << "host_dynamic_pool_policy_" << static_cast<int>(policy);
+
+    auto allocator = rm.makeAllocator<umpire::strategy::DynamicPool>(
+        name.str(), rm.getAllocator("HOST"), 64*1024, 1024, policy);
+
+    auto dynamic_pool = std::dynamic_pointer_cast<umpire::strategy::DynamicPool>(
+        allocator.getAllocationStrategy());
+    ASSERT_NE(dynamic_pool, nullptr);
+    ASSERT_EQ(dynamic_pool->getPlacementPolicy(), policy);
+
+    std::vector<void*> allocs;
+    for (size_t size = 16; size <= 16*1024; size *= 2) {
+      allocs.push_back(allocator.allocate(size));
+      allocs.push_back(allocator.allocate(size + 8));
+    }
+
+    const long actual_size = allocator.getActualSize();
+
+    // Free every other block to leave holes, then reallocate into them
+    for (size_t i = 0; i < allocs.size(); i += 2) {
+      allocator.deallocate(allocs[i]);
+    }
+    for (size_t i = 0, size = 16; i < allocs.size(); i += 2, size *= 2) {
+      allocs[i] = allocator.allocate(size);
+      ASSERT_EQ(allocator.getSize(allocs[i]), size);
+    }
+
+    ASSERT_EQ(allocator.getActualSize(), actual_size);
+
+    for (auto alloc : allocs) {
+      ASSERT_NO_THROW( { allocator.deallocate(alloc); } );
+    }
+    ASSERT_EQ(allocator.getCurrentSize(), 0);
+  }
+}
+
+TEST(DynamicPool, Aligned)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  const umpire::PlacementPolicy policies[] = {
+    umpire::PlacementPolicy::first_fit,
+    umpire::PlacementPolicy::best_fit,
+    umpire::PlacementPolicy::segregated_fit
+  };
+
+  for (auto policy : policies) {
+    std::stringstream name;
+    name << "host_dynamic_pool_aligned_" << static_cast<int>(policy);
+
+    auto allocator = rm.makeAllocator<umpire::strategy::DynamicPool>(
+        name.str(), rm.getAllocator("HOST"), 64*1024, 1024, policy);
+
+    std::vector<void*> allocs;
+    for (size_t alignment : {64, 128, 4096}) {
+      // Offset the next block so it is not already aligned.
+      allocs.push_back(allocator.allocate(16));
+
+      void* ptr = allocator.allocate(100, alignment);
+      ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % alignment);
+      ASSERT_EQ(allocator.getSize(ptr), 100u);
+      allocs.push_back(ptr);
+    }
+
+    ASSERT_ANY_THROW(allocator.allocate(100, 48));
+
+    for (auto alloc : allocs) {
+      ASSERT_NO_THROW( { allocator.deallocate(alloc); } );
+    }
+    ASSERT_EQ(allocator.getCurrentSize(), 0);
+
+    auto dynamic_pool = std::dynamic_pointer_cast<umpire::strategy::DynamicPool>(
+        allocator.getAllocationStrategy());
+    ASSERT_EQ(dynamic_pool->getNumUsedBlocks(), 0u);
+  }
+}
+
+TEST(DynamicPool, PageAligned)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  const size_t page_size = 4096;
+
+  auto allocator = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "host_dynamic_pool_page_aligned", rm.getAllocator("HOST"), 64*1024, 1024,
+      umpire::PlacementPolicy::best_fit, page_size);
+
+  auto dynamic_pool = std::dynamic_pointer_cast<umpire::strategy::DynamicPool>(
+      allocator.getAllocationStrategy());
+  ASSERT_EQ(page_size, dynamic_pool->getAlignment());
+
+  // Small allocations still get a page each.
+  void* a = allocator.allocate(sizeof(int));
+  void* b = allocator.allocate(100);
+  void* c = allocator.allocate(page_size + 1);
+  void* d = allocator.allocate(100, 64);
+
+  for (void* ptr : {a, b, c, d}) {
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % page_size);
+  }
+
+  ASSERT_NE(reinterpret_cast<uintptr_t>(a) / page_size,
+      reinterpret_cast<uintptr_t>(b) / page_size);
+  ASSERT_EQ(allocator.getSize(b), 100u);
+  ASSERT_EQ(allocator.getCurrentSize(),
+      static_cast<long>(sizeof(int) + 100 + page_size + 1 + 100));
+
+  void* many[2];
+  const size_t sizes[] = {8, 8};
+  allocator.allocateMany(sizes, 2, many);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(many[0]) % page_size);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(many[1]) % page_size);
+  allocator.deallocateMany(many, 2);
+
+  for (void* ptr : {a, b, c, d}) {
+    allocator.deallocate(ptr);
+  }
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+
+  ASSERT_ANY_THROW(
+      rm.makeAllocator<umpire::strategy::DynamicPool>(
+        "host_dynamic_pool_bad_alignment", rm.getAllocator("HOST"), 64*1024, 1024,
+        umpire::PlacementPolicy::best_fit, 3000));
+}
+
+TEST(DynamicPool, CacheColoring)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  const size_t page_size = umpire::strategy::DynamicPool::s_color_period;
+  const size_t bytes = 8192 * sizeof(double);
+
+  auto allocator = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "host_dynamic_pool_colored", rm.getAllocator("HOST"), 1024*1024, 1024*1024,
+      umpire::PlacementPolicy::best_fit, 16, true);
+
+  auto dynamic_pool = std::dynamic_pointer_cast<umpire::strategy::DynamicPool>(
+      allocator.getAllocationStrategy());
+  ASSERT_TRUE(dynamic_pool->getCacheColoring());
+
+  std::set<uintptr_t> offsets;
+  std::vector<void*> allocs;
+  for (int i = 0; i < 4; ++i) {
+    void* ptr = allocator.allocate(bytes);
+    const uintptr_t offset = reinterpret_cast<uintptr_t>(ptr) % page_size;
+    ASSERT_EQ(0u, offset % umpire::strategy::DynamicPool::s_color_step);
+    ASSERT_EQ(allocator.getSize(ptr), bytes);
+    offsets.insert(offset);
+    allocs.push_back(ptr);
+  }
+  ASSERT_EQ(offsets.size(), 4u);
+
+  // Small blocks are not colored.
+  void* small = allocator.allocate(100);
+  allocator.deallocate(small);
+
+  for (auto alloc : allocs) {
+    allocator.deallocate(alloc);
+  }
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+}
+
+TEST(DynamicPool, GrowthPolicy)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto geometric = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "dynamic_pool_geometric", rm.getAllocator("HOST"),
+      umpire::GrowthPolicy::fixed(4096),
+      umpire::GrowthPolicy::geometric(4096, 64*1024));
+
+  auto pool = std::dynamic_pointer_cast<umpire::strategy::DynamicPool>(
+      geometric.getAllocationStrategy());
+
+  // Chunks of 4K, 4K, 8K, 16K, 32K then 64K hold thirty 4K blocks.
+  std::vector<void*> ptrs(30);
+  for (auto& ptr : ptrs) {
+    ptr = geometric.allocate(4096);
+  }
+
+  ASSERT_EQ(6u, pool->getNumChunks());
+  ASSERT_EQ(128*1024, pool->getActualSize());
+
+  for (auto ptr : ptrs) {
+    geometric.deallocate(ptr);
+  }
+  pool->release();
+
+  auto fraction = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "dynamic_pool_free_fraction", rm.getAllocator("HOST"),
+      umpire::GrowthPolicy::freeFraction(0.0001, 64*1024),
+      umpire::GrowthPolicy::fixed(4096));
+
+  void* ptr = fraction.allocate(100);
+  ASSERT_GE(fraction.getActualSize(), 64*1024);
+  fraction.deallocate(ptr);
+}
+
+TEST(DynamicPool, Reserve)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "dynamic_pool_reserve", rm.getAllocator("HOST"), 4096, 4096);
+
+  auto pool = std::dynamic_pointer_cast<umpire::strategy::DynamicPool>(
+      allocator.getAllocationStrategy());
+
+  allocator.reserve(1024*1024);
+  ASSERT_EQ(1u, pool->getNumChunks());
+  ASSERT_EQ(1024*1024, pool->getActualSize());
+
+  // Prefaulting touches every page of the chunk.
+  char* ptr = static_cast<char*>(allocator.allocate(512*1024));
+  ASSERT_EQ(0, ptr[0]);
+  ASSERT_EQ(0, ptr[512*1024 - 1]);
+
+  // Enough is free already.
+  allocator.reserve(256*1024, false);
+  ASSERT_EQ(1u, pool->getNumChunks());
+
+  allocator.reserve(768*1024, false);
+  ASSERT_EQ(2u, pool->getNumChunks());
+  ASSERT_EQ(768*1024, static_cast<long>(pool->getAvailableSize()));
+
+  allocator.deallocate(ptr);
+  pool->release();
+
+  // Allocators without free memory ignore it.
+  rm.getAllocator("HOST").reserve(1024);
+}
+
+TEST(DynamicPool, Fragmentation)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  const umpire::PlacementPolicy policies[] = {
+    umpire::PlacementPolicy::first_fit,
+    umpire::PlacementPolicy::best_fit,
+    umpire::PlacementPolicy::segregated_fit
+  };
+
+  for (auto policy : policies) {
+    std::stringstream name;
+    name << "host_dynamic_pool_fragmentation_" << static_cast<int>(policy);
+
+    auto allocator = rm.makeAllocator<umpire::strategy::DynamicPool>(
+        name.str(), rm.getAllocator("HOST"), 4*1024, 4*1024, policy);
+
+    auto dynamic_pool = std::dynamic_pointer_cast<umpire::strategy::DynamicPool>(
+        allocator.getAllocationStrategy());
+    ASSERT_NE(dynamic_pool, nullptr);
+
+    std::vector<void*> allocs;
+    for (int i = 0; i < 4; ++i) {
+      allocs.push_back(allocator.allocate(1024));
+    }
+
+    ASSERT_EQ(dynamic_pool->getNumChunks(), 1u);
+    ASSERT_EQ(dynamic_pool->getNumUsedBlocks(), 4u);
+    ASSERT_EQ(dynamic_pool->getNumFreeBlocks(), 0u);
+    ASSERT_EQ(dynamic_pool->getAvailableSize(), 0u);
+    ASSERT_EQ(dynamic_pool->getFragmentation(), 0.0);
+
+    // Two separated holes
+    allocator.deallocate(allocs[0]);
+    allocator.deallocate(allocs[2]);
+
+    ASSERT_EQ(dynamic_pool->getNumFreeBlocks(), 2u);
+    ASSERT_EQ(dynamic_pool->getAvailableSize(), 2*1024u);
+    ASSERT_EQ(dynamic_pool->getLargestAvailableBlock(), 1024u);
+    ASSERT_DOUBLE_EQ(dynamic_pool->getFragmentation(), 0.5);
+
+    // Freeing the block between them merges all three
+    allocator.deallocate(allocs[1]);
+
+    ASSERT_EQ(dynamic_pool->getNumFreeBlocks(), 1u);
+    ASSERT_EQ(dynamic_pool->getLargestAvailableBlock(), 3*1024u);
+    ASSERT_EQ(dynamic_pool->getFragmentation(), 0.0);
+
+    // A request that does not fit needs a second chunk
+    void* big = allocator.allocate(8*1024);
+    ASSERT_EQ(dynamic_pool->getNumChunks(), 2u);
+
+    allocator.deallocate(big);
+    allocator.deallocate(allocs[3]);
+    allocator.release();
+    ASSERT_EQ(dynamic_pool->getNumChunks(), 0u);
+  }
+}
+
+TEST(DynamicPool, ReleaseAndCoalesce)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "host_dynamic_pool_release", rm.getAllocator("HOST"), 1024, 1024);
+
+  // Each allocation fills a chunk of its own
+  std::vector<void*> allocs;
+  for (int i = 0; i < 4; ++i) {
+    allocs.push_back(allocator.allocate(1024));
+  }
+  ASSERT_EQ(allocator.getActualSize(), 4*1024);
+
+  allocator.deallocate(allocs[1]);
+  allocator.deallocate(allocs[2]);
+
+  allocator.coalesce();
+  ASSERT_EQ(allocator.getActualSize(), 4*1024);
+
+  // The two free chunks are now one, so a request for both fits
+  void* both = allocator.allocate(2*1024);
+  ASSERT_EQ(allocator.getActualSize(), 4*1024);
+  allocator.deallocate(both);
+
+  allocator.trim(3*1024);
+  ASSERT_EQ(allocator.getActualSize(), 2*1024);
+
+  allocator.deallocate(allocs[0]);
+  allocator.deallocate(allocs[3]);
+
+  allocator.release();
+  ASSERT_EQ(allocator.getActualSize(), 0);
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+
+  void* alloc = nullptr;
+  ASSERT_NO_THROW( { alloc = allocator.allocate(100); } );
+  ASSERT_NO_THROW( { allocator.deallocate(alloc); } );
+}
+
+TEST(DynamicPool, ReallocateInPlace)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "host_dynamic_pool_reallocate", rm.getAllocator("HOST"), 4096, 4096);
+
+  char* data = static_cast<char*>(allocator.allocate(1024));
+  for (int i = 0; i < 1024; ++i) {
+    data[i] = static_cast<char>(i);
+  }
+
+  // The rest of the chunk is free, so the block grows where it is
+  ASSERT_EQ(data, rm.reallocate(data, 2048));
+  ASSERT_EQ(allocator.getCurrentSize(), 2048);
+  ASSERT_EQ(rm.getSize(data), 2048);
+
+  ASSERT_EQ(data, rm.reallocate(data, 512));
+  ASSERT_EQ(allocator.getCurrentSize(), 512);
+
+  // Another block right after stops growth, so the data is moved
+  void* neighbour = allocator.allocate(1024);
+  char* moved = static_cast<char*>(rm.reallocate(data, 4096));
+  ASSERT_NE(data, moved);
+  ASSERT_EQ(allocator.getCurrentSize(), 1024 + 4096);
+
+  for (int i = 0; i < 512; ++i) {
+    ASSERT_EQ(static_cast<char>(i), moved[i]);
+  }
+
+  allocator.deallocate(moved);
+  allocator.deallocate(neighbour);
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+}
+
+TEST(DynamicPool, HostUntracked)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "host_dynamic_pool_untracked", rm.getAllocator("HOST"));
+
+  void* alloc = nullptr;
+  ASSERT_NO_THROW( { alloc = allocator.allocateUntracked(100); } );
+  ASSERT_NE(alloc, nullptr);
+
+  ASSERT_GE(allocator.getCurrentSize(), 100);
+  ASSERT_GE(allocator.getHighWatermark(), 100);
+  ASSERT_FALSE(rm.hasAllocator(alloc));
+
+  ASSERT_NO_THROW( { allocator.deallocateUntracked(alloc); } );
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+}
+
+TEST(DynamicPool, AllocateMany)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "host_dynamic_pool_many", rm.getAllocator("HOST"), 4096);
+  auto allocator = rm.makeAllocator<umpire::strategy::ThreadSafeAllocator>(
+      "host_dynamic_pool_many_safe", pool);
+
+  const size_t sizes[] = {64, 100, 16, 1000};
+  void* ptrs[4];
+
+  ASSERT_NO_THROW(allocator.allocateMany(sizes, 4, ptrs));
+
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(allocator.getSize(ptrs[i]), sizes[i]);
+    ASSERT_EQ(rm.getAllocator(ptrs[i]).getName(), "host_dynamic_pool_many_safe");
+  }
+
+  // The batch is carved from one block in order.
+  ASSERT_EQ(static_cast<char*>(ptrs[1]), static_cast<char*>(ptrs[0]) + 64);
+  ASSERT_EQ(static_cast<char*>(ptrs[2]), static_cast<char*>(ptrs[1]) + 112);
+  ASSERT_EQ(static_cast<char*>(ptrs[3]), static_cast<char*>(ptrs[2]) + 16);
+
+  ASSERT_EQ(allocator.getCurrentSize(), 1180);
+  ASSERT_EQ(pool.getCurrentSize(), 1180);
+
+  ASSERT_NO_THROW(allocator.deallocate(ptrs[1]));
+  ptrs[1] = nullptr;
+  ASSERT_EQ(allocator.getCurrentSize(), 1080);
+
+  ASSERT_NO_THROW(allocator.deallocateMany(ptrs, 2));
+  ASSERT_NO_THROW(rm.deallocateMany(ptrs + 2, 2));
+
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+  ASSERT_EQ(pool.getCurrentSize(), 0);
+}
+
+TEST(ThreadSafeAllocator, RegistersOnce)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "thread_safe_registers_once_pool", rm.getAllocator("HOST"));
+
+  auto allocator = rm.makeAllocator<umpire::strategy::ThreadSafeAllocator>(
+      "thread_safe_registers_once", pool);
+
+  const auto num_records = rm.getAllocationMapStatistics().num_records;
+
+  void* ptrs[3];
+  for (int i = 0; i < 3; ++i) {
+    ptrs[i] = allocator.allocate(100*(i+1));
+
+    ASSERT_EQ(rm.getAllocationMapStatistics().num_records, num_records + i + 1);
+    ASSERT_EQ(rm.getAllocator(ptrs[i]).getName(), "thread_safe_registers_once");
+    ASSERT_EQ(rm.getSize(ptrs[i]), static_cast<size_t>(100*(i+1)));
+  }
+
+  ASSERT_EQ(allocator.getCurrentSize(), 600);
+  ASSERT_EQ(pool.getCurrentSize(), 600);
+
+  for (auto ptr : ptrs) {
+    allocator.deallocate(ptr);
+  }
+
+  ASSERT_EQ(rm.getAllocationMapStatistics().num_records, num_records);
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+  ASSERT_EQ(pool.getCurrentSize(), 0);
+}
+
+TEST(HostVirtualPool, Host)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  const size_t granule = 64*1024;
+  auto allocator = rm.makeAllocator<umpire::strategy::HostVirtualPool>(
+      "host_virtual_pool", 16*granule, granule);
+
+  ASSERT_EQ(allocator.getActualSize(), 0);
+
+  char* first = static_cast<char*>(allocator.allocate(1000));
+  char* second = static_cast<char*>(allocator.allocate(1000));
+  ASSERT_EQ(second, first + 1024);
+  ASSERT_EQ(allocator.getCurrentSize(), 2000);
+  ASSERT_EQ(allocator.getActualSize(), granule);
+
+  // Growing in place commits the pages after the block
+  ASSERT_EQ(rm.reallocate(second, 4*granule), second);
+  ASSERT_EQ(allocator.getSize(second), 4*granule);
+  ASSERT_EQ(allocator.getActualSize(), 5*granule);
+  std::memset(second, 1, 4*granule);
+
+  // Freed memory stays committed until the pool is trimmed
+  ASSERT_EQ(rm.reallocate(second, 1000), second);
+  ASSERT_EQ(allocator.getActualSize(), 5*granule);
+  allocator.release();
+  ASSERT_EQ(allocator.getActualSize(), granule);
+
+  ASSERT_ANY_THROW(allocator.allocate(16*granule));
+
+  allocator.deallocate(first);
+  allocator.deallocate(second);
+
+  // Freed blocks merge back into the rest of the range
+  char* all = static_cast<char*>(allocator.allocate(16*granule));
+  ASSERT_EQ(all, first);
+  std::memset(all, 1, 16*granule);
+  allocator.deallocate(all);
+
+  allocator.trim(4*granule);
+  ASSERT_EQ(allocator.getActualSize(), 4*granule);
+
+  allocator.release();
+  ASSERT_EQ(allocator.getActualSize(), 0);
+
+  // Addresses are kept, and pages come back zeroed
+  char* again = static_cast<char*>(allocator.allocate(1000));
+  ASSERT_EQ(again, first);
+  ASSERT_EQ(again[0], 0);
+  allocator.deallocate(again);
+}
+
+TEST(SizeClassPool, Host)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::SizeClassPool>(
+      "host_size_class_pool", rm.getAllocator("HOST"));
+
+  ASSERT_EQ(allocator.getName(), "host_size_class_pool");
+
+  std::vector<void*> allocs;
+  size_t total = 0;
+  for (size_t size = 1; size <= 1024*1024; size *= 3) {
+    void* alloc = nullptr;
+    ASSERT_NO_THROW( { alloc = allocator.allocate(size); } );
+    ASSERT_EQ(allocator.getSize(alloc), size);
+    allocs.push_back(alloc);
+    total += size;
+  }
+
+  ASSERT_EQ(allocator.getCurrentSize(), total);
+  ASSERT_GE(allocator.getHighWatermark(), total);
+  ASSERT_GE(allocator.getActualSize(), total);
+
+  for (auto alloc : allocs) {
+    ASSERT_NO_THROW( { allocator.deallocate(alloc); } );
+  }
+
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+}
+
+TEST(SizeClassPool, Reuse)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::SizeClassPool>(
+      "host_size_class_pool_reuse", rm.getAllocator("HOST"));
+
+  void* first = allocator.allocate(100);
+  const long actual_size = allocator.getActualSize();
+  allocator.deallocate(first);
+
+  // Any size in the same class gets the freed block back
+  void* second = allocator.allocate(120);
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(allocator.getActualSize(), actual_size);
+
+  allocator.deallocate(second);
+}
+
+TEST(SizeClassPool, Untracked)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto pool = rm.makeAllocator<umpire::strategy::SizeClassPool>(
+      "host_size_class_pool_untracked", rm.getAllocator("HOST"));
+  auto strategy = pool.getAllocationStrategy();
+
+  void* small = strategy->allocateUntracked(100);
+  void* large = strategy->allocateUntracked(1024*1024);
+  ASSERT_FALSE(rm.hasAllocator(small));
+  ASSERT_FALSE(rm.hasAllocator(large));
+  ASSERT_EQ(pool.getCurrentSize(), 100 + 1024*1024);
+
+  strategy->deallocateUntracked(small, 100);
+  strategy->deallocateUntracked(large, 1024*1024);
+  ASSERT_EQ(pool.getCurrentSize(), 0);
+
+  // A thread cache refills a whole batch of 128 byte blocks, and only the
+  // block handed out, the last of the batch, is registered.
+  auto cached = rm.makeAllocator<umpire::strategy::ThreadCachingAllocator>(
+      "thread_caching_size_class_pool", pool);
+
+  void* ptr = cached.allocate(100);
+  ASSERT_EQ(rm.getAllocator(ptr).getName(), "thread_caching_size_class_pool");
+  ASSERT_FALSE(rm.hasAllocator(static_cast<char*>(ptr) - 128));
+  cached.deallocate(ptr);
+}
+
+TEST(ComposedStrategy, LockedPool)
+{
+  using namespace umpire::strategy;
+
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<ComposedStrategy<
+      compose::Locked, compose::Tracked, compose::Pooled<>>>(
+      "composed_locked_pool", rm.getAllocator("HOST"), 64*1024, 1024);
+
+  ASSERT_TRUE(allocator.getAllocationStrategy()->isThreadSafe());
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&allocator] () {
+      for (int i = 0; i < 100; ++i) {
+        void* ptr = allocator.allocate(100 + i);
+        allocator.deallocate(ptr);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  void* ptr = allocator.allocate(100);
+  ASSERT_EQ(allocator.getCurrentSize(), 100u);
+  ASSERT_EQ(rm.getSize(ptr), 100u);
+  ASSERT_EQ(rm.getAllocator(ptr).getName(), "composed_locked_pool");
+
+  rm.deallocate(ptr);
+  ASSERT_EQ(allocator.getCurrentSize(), 0u);
+  ASSERT_EQ(allocator.getActualSize(), 64*1024u);
+}
+
+TEST(ComposedStrategy, TracksPoolFootprint)
+{
+  using namespace umpire::strategy;
+
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  // Tracked below the pool counts the chunks it takes
+  auto allocator = rm.makeAllocator<ComposedStrategy<
+      compose::Pooled<>, compose::Tracked>>(
+      "composed_pool_footprint", rm.getAllocator("HOST"), 4096, 4096);
+
+  ASSERT_FALSE(allocator.getAllocationStrategy()->isThreadSafe());
+
+  void* a = allocator.allocate(1024);
+  void* b = allocator.allocate(8192);
+  ASSERT_EQ(allocator.getCurrentSize(), 4096u + 8192);
+  ASSERT_EQ(allocator.getSize(b), 8192u);
+
+  allocator.deallocate(b);
+  allocator.release();
+  ASSERT_EQ(allocator.getCurrentSize(), 4096u);
+  ASSERT_EQ(allocator.getHighWatermark(), 4096u + 8192);
+
+  allocator.deallocate(a);
+}
+
+#if defined(_OPENMP)
+TEST(ThreadSafeAllocator, Host)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::ThreadSafeAllocator>(
+      "thread_safe_allocator", rm.getAllocator("HOST"));
+
+#pragma omp parallel
+  {
+    const size_t size = 1024*omp_get_thread_num();
+
+    double* thread_data = static_cast<double*>(
+     allocator.allocate(size*sizeof(double)));
+
+    allocator.deallocate(thread_data);
+  }
+
+  SUCCEED();
+}
+
+TEST(ThreadSafeAllocator, PoolStatistics)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "thread_safe_pool", rm.getAllocator("HOST"));
+
+  auto allocator = rm.makeAllocator<umpire::strategy::ThreadSafeAllocator>(
+      "thread_safe_pool_allocator", pool);
+
+#pragma omp parallel
+  {
+    std::vector<void*> thread_data(100);
+
+    for (auto& ptr : thread_data) {
+      ptr = allocator.allocate(64);
+      EXPECT_GE(allocator.getCurrentSize(), 64);
+    }
+
+    for (auto& ptr : thread_data) {
+      allocator.deallocate(ptr);
+    }
+  }
+
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+  ASSERT_EQ(pool.getCurrentSize(), 0);
+  ASSERT_GE(allocator.getHighWatermark(), 100*64);
+}
+
+TEST(ThreadCachingAllocator, Host)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::ThreadCachingAllocator>(
+      "thread_caching_allocator", rm.getAllocator("HOST"));
+
+#pragma omp parallel
+  {
+    const size_t size = 8*(omp_get_thread_num() + 1);
+    std::vector<void*> thread_data(1000);
+
+    for (auto& ptr : thread_data) {
+      ptr = allocator.allocate(size);
+    }
+
+    for (auto& ptr : thread_data) {
+      allocator.deallocate(ptr);
+    }
+  }
+
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+  ASSERT_GT(allocator.getHighWatermark(), 0);
+}
+
+#endif
+
+TEST(ThreadSafeAllocator, ReallocateInPlace)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "thread_safe_pool_reallocate", rm.getAllocator("HOST"), 4096, 4096);
+
+  auto allocator = rm.makeAllocator<umpire::strategy::ThreadSafeAllocator>(
+      "thread_safe_pool_reallocate_allocator", pool);
+
+  void* data = allocator.allocate(1024);
+
+  ASSERT_EQ(data, rm.reallocate(data, 2048));
+  ASSERT_EQ(allocator.getCurrentSize(), 2048);
+  ASSERT_EQ(allocator.getHighWatermark(), 2048);
+
+  ASSERT_EQ(data, rm.reallocate(data, 512));
+  ASSERT_EQ(allocator.getCurrentSize(), 512);
+  ASSERT_EQ(allocator.getHighWatermark(), 2048);
+
+  allocator.deallocate(data);
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+  ASSERT_EQ(pool.getCurrentSize(), 0);
+}
+
+TEST(ThreadCachingAllocator, Sizes)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::ThreadCachingAllocator>(
+      "thread_caching_allocator_sizes", rm.getAllocator("HOST"));
+
+  void* small = nullptr;
+  void* large = nullptr;
+
+  ASSERT_NO_THROW( { small = allocator.allocate(100); } );
+  ASSERT_NO_THROW( { large = allocator.allocate(1024*1024); } );
+
+  ASSERT_EQ(allocator.getSize(small), 100);
+  ASSERT_EQ(allocator.getSize(large), 1024*1024);
+  ASSERT_EQ(allocator.getCurrentSize(), 100 + 1024*1024);
+  ASSERT_GE(allocator.getActualSize(), allocator.getCurrentSize());
+  ASSERT_EQ(rm.getAllocator(small).getName(), "thread_caching_allocator_sizes");
+
+  ASSERT_NO_THROW( { allocator.deallocate(small); } );
+  ASSERT_NO_THROW( { allocator.deallocate(large); } );
+
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+  ASSERT_GE(allocator.getHighWatermark(), 100 + 1024*1024);
+
+  // Freed blocks are served again from the cache
+  void* again = allocator.allocate(100);
+  ASSERT_EQ(again, small);
+  allocator.deallocate(again);
+}
+
+TEST(ThreadCachingAllocator, ThreadExit)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::ThreadCachingAllocator>(
+      "thread_caching_allocator_exit", rm.getAllocator("HOST"));
+
+  void* shared = nullptr;
+
+  std::thread worker([&] {
+    void* ptr = allocator.allocate(100);
+    allocator.deallocate(ptr);
+    shared = allocator.allocate(200);
+    ASSERT_GT(allocator.getActualSize(), allocator.getCurrentSize());
+  });
+  worker.join();
+
+  // The worker's cache went back to HOST when it exited.
+  ASSERT_EQ(allocator.getActualSize(), 256);
+
+  allocator.deallocate(shared);
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+}
+
+TEST(ThreadCachingAllocator, Aligned)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto allocator = rm.makeAllocator<umpire::strategy::ThreadCachingAllocator>(
+      "thread_caching_allocator_aligned", rm.getAllocator("HOST"));
+
+  std::vector<void*> allocs;
+  for (size_t bytes : {size_t{8}, size_t{100}, size_t{1024*1024}}) {
+    for (size_t alignment : {size_t{16}, size_t{256}, size_t{4096}}) {
+      void* ptr = allocator.allocate(bytes, alignment);
+      ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % alignment);
+      ASSERT_EQ(allocator.getSize(ptr), bytes);
+      allocs.push_back(ptr);
+    }
+  }
+
+  for (auto ptr : allocs) {
+    allocator.deallocate(ptr);
+  }
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+}
+
+TEST(AlignedAllocator, CacheLinePadding)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto pool = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "aligned_allocator_pool", rm.getAllocator("HOST"), 64*1024, 1024);
+
+  auto allocator = rm.makeAllocator<umpire::strategy::AlignedAllocator>(
+      "aligned_allocator", pool, 128);
+
+  std::vector<void*> accumulators(16);
+  for (auto& ptr : accumulators) {
+    ptr = allocator.allocate(sizeof(double));
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % 128);
+    ASSERT_EQ(allocator.getSize(ptr), sizeof(double));
+    ASSERT_EQ(rm.getAllocator(ptr).getName(), "aligned_allocator");
+  }
+
+  // No two accumulators share a 128-byte line.
+  for (size_t i = 1; i < accumulators.size(); ++i) {
+    ASSERT_NE(reinterpret_cast<uintptr_t>(accumulators[i]) / 128,
+        reinterpret_cast<uintptr_t>(accumulators[i - 1]) / 128);
+  }
+
+  ASSERT_EQ(allocator.getCurrentSize(),
+      static_cast<long>(accumulators.size()*sizeof(double)));
+  ASSERT_GE(pool.getCurrentSize(),
+      static_cast<long>(accumulators.size()*128));
+
+  void* page = allocator.allocate(100, 4096);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(page) % 4096);
+  allocator.deallocate(page);
+
+  for (auto ptr : accumulators) {
+    allocator.deallocate(ptr);
+  }
+
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+  ASSERT_EQ(pool.getCurrentSize(), 0);
+
+  ASSERT_ANY_THROW(
+      rm.makeAllocator<umpire::strategy::AlignedAllocator>(
+        "aligned_allocator_bad", pool, 96));
+}
+
+TEST(LifetimePool, SegregatesByLifetime)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto temporary = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "lifetime_pool_temporary", rm.getAllocator("HOST"), 64*1024, 64*1024);
+  auto long_lived = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "lifetime_pool_long_lived", rm.getAllocator("HOST"), 64*1024, 64*1024);
+  auto persistent = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "lifetime_pool_persistent", rm.getAllocator("HOST"), 64*1024, 64*1024);
+
+  auto allocator = rm.makeAllocator<umpire::strategy::LifetimePool>(
+      "lifetime_pool", temporary, long_lived, persistent);
+
+  void* mesh = allocator.allocate(1024, umpire::Lifetime::persistent);
+  void* state = allocator.allocate(2048);
+
+  std::vector<void*> scratch;
+  for (int i = 0; i < 16; ++i) {
+    scratch.push_back(allocator.allocate(16*1024, umpire::Lifetime::temporary));
+  }
+
+  ASSERT_EQ(rm.getAllocator(mesh).getName(), "lifetime_pool");
+  ASSERT_EQ(persistent.getCurrentSize(), 1024);
+  ASSERT_EQ(long_lived.getCurrentSize(), 2048);
+  ASSERT_EQ(temporary.getCurrentSize(), 16*16*1024);
+  ASSERT_EQ(allocator.getCurrentSize(), 1024 + 2048 + 16*16*1024);
+
+  for (auto ptr : scratch) {
+    allocator.deallocate(ptr);
+  }
+
+  // The temporaries empty their pool, which frees every chunk.
+  auto strategy = std::dynamic_pointer_cast<umpire::strategy::LifetimePool>(
+      allocator.getAllocationStrategy());
+  strategy->release(umpire::Lifetime::temporary);
+  ASSERT_EQ(temporary.getActualSize(), 0);
+  ASSERT_EQ(long_lived.getActualSize(), 64*1024);
+
+  rm.deallocate(state);
+  allocator.deallocate(mesh);
+
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+  ASSERT_EQ(persistent.getCurrentSize(), 0);
+  ASSERT_EQ(long_lived.getCurrentSize(), 0);
+
+  // Strategies without lifetimes ignore the hint.
+  void* ptr = temporary.allocate(100, umpire::Lifetime::persistent);
+  ASSERT_EQ(temporary.getCurrentSize(), 100);
+  temporary.deallocate(ptr);
+}
+
+TEST(MixedPool, RoutesBySize)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  auto small = rm.makeAllocator<umpire::strategy::SizeClassPool>(
+      "mixed_pool_small", rm.getAllocator("HOST"));
+  auto medium = rm.makeAllocator<umpire::strategy::DynamicPool>(
+      "mixed_pool_medium", rm.getAllocator("HOST"));
+  auto large = rm.getAllocator("HOST");
+
+  auto allocator = rm.makeAllocator<umpire::strategy::MixedPool>(
+      "mixed_pool",
+      std::vector<std::size_t>{256, 1024*1024},
+      std::vector<umpire::Allocator>{small, medium, large});
+
+  void* tiny = allocator.allocate(16);
+  void* mid = allocator.allocate(4096);
+  const long large_before = large.getCurrentSize();
+  void* big = allocator.allocate(2*1024*1024);
+
+  for (auto ptr : {tiny, mid, big}) {
+    ASSERT_EQ(rm.getAllocator(ptr).getName(), "mixed_pool");
+  }
+
+  ASSERT_EQ(allocator.getSize(big), 2u*1024*1024);
+  ASSERT_EQ(allocator.getCurrentSize(), 16 + 4096 + 2*1024*1024);
+  ASSERT_EQ(small.getCurrentSize(), 16);
+  ASSERT_EQ(medium.getCurrentSize(), 4096);
+  ASSERT_EQ(large.getCurrentSize(), large_before + 2*1024*1024);
+
+  allocator.deallocate(big);
+  ASSERT_EQ(large.getCurrentSize(), large_before);
+
+  allocator.deallocate(mid);
+  allocator.deallocate(tiny);
+
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+  ASSERT_EQ(allocator.getHighWatermark(), 16 + 4096 + 2*1024*1024);
+  ASSERT_EQ(small.getCurrentSize(), 0);
+  ASSERT_EQ(medium.getCurrentSize(), 0);
+
+  ASSERT_ANY_THROW(
+      rm.makeAllocator<umpire::strategy::MixedPool>(
+        "mixed_pool_bad",
+        std::vector<std::size_t>{256},
+        std::vector<umpire::Allocator>{small}));
+}
+
+#if defined(UMPIRE_ENABLE_NUMA)
+TEST(NumaDispatchAllocator, LocalNode)
+{
+  auto& rm = umpire::ResourceManager::getInstance();
+
+  std::vector<umpire::Allocator> pools;
+  for (int node : umpire::alloc::NumaAllocator::getNodes()) {
+    pools.resize(node + 1, rm.getAllocator("HOST"));
+    pools[node] = rm.makeAllocator<umpire::strategy::ThreadSafeAllocator>(
+        "numa_dispatch_pool" + std::to_string(node),
+        rm.makeAllocator<umpire::strategy::DynamicPool>(
+          "numa_dispatch_dynamic" + std::to_string(node),
+          rm.getAllocator("HOST_NUMA" + std::to_string(node))));
+  }
+  ASSERT_FALSE(pools.empty());
+
+  auto allocator = rm.makeAllocator<umpire::strategy::NumaDispatchAllocator>(
+      "numa_dispatch", pools);
+  auto dispatch = std::dynamic_pointer_cast<
+    umpire::strategy::NumaDispatchAllocator>(allocator.getAllocationStrategy());
+  ASSERT_TRUE(allocator.getAllocationStrategy()->isThreadSafe());
+
+  const int node = dispatch->getLocalIndex();
+  void* ptr = allocator.allocate(4096);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(ptr) % 16, 0u);
+  std::memset(ptr, 0, 4096);
+
+  ASSERT_EQ(rm.getAllocator(ptr).getName(), "numa_dispatch");
+  ASSERT_EQ(allocator.getSize(ptr), 4096u);
+  ASSERT_EQ(allocator.getCurrentSize(), 4096);
+  ASSERT_GT(pools[node].getCurrentSize(), 4096);
+
+  int status = -1;
+  ASSERT_EQ(::numa_move_pages(0, 1, &ptr, nullptr, &status, 0), 0);
+  ASSERT_EQ(status, node);
+
+  // Frees from any thread go back to the pool that allocated the block.
+  std::thread([&]() { allocator.deallocate(ptr); }).join();
+  ASSERT_EQ(pools[node].getCurrentSize(), 0);
+  ASSERT_EQ(allocator.getCurrentSize(), 0);
+
+  ASSERT_ANY_THROW(
+      rm.makeAllocator<umpire::strategy::NumaDispatchAllocator>(
+        "numa_dispatch_empty", std::vector<umpire::Allocator>{}));
+}
 #endif
@@ -15,6 +15,7 @@
 #include "umpire/config.hpp"
 
 #include "umpire/alloc/MallocAllocator.hpp"
+#include "umpire/alloc/MmapAllocator.hpp"
 
 using namespace umpire::alloc;
 
@@ -24,6 +25,10 @@ using namespace umpire::alloc;
 #include "umpire/alloc/CudaPinnedAllocator.hpp"
 #endif
 
+#if defined(UMPIRE_ENABLE_NUMA)
+#include "umpire/alloc/NumaAllocator.hpp"
+#endif
+
 #include "gtest/gtest.h"
 
 template <typename T>
@@ -40,14 +45,28 @@ TYPED_TEST_P(MemoryAllocatorTest, Allocate) {
   allocator.deallocate(allocation);
 }
 
+TYPED_TEST_P(MemoryAllocatorTest, AllocateAligned) {
+  TypeParam allocator;
+  void* allocation = allocator.allocate(1000, 256);
+  ASSERT_NE(nullptr, allocation);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(allocation) % 256);
+
+  allocator.deallocate(allocation);
+}
+
 REGISTER_TYPED_TEST_CASE_P(
     MemoryAllocatorTest,
-    Allocate);
+    Allocate,
+    AllocateAligned);
 
-#if defined(UMPIRE_ENABLE_CUDA)
-using test_types = ::testing::Types<MallocAllocator, CudaMallocAllocator, CudaMallocManagedAllocator, CudaPinnedAllocator>;
+#if defined(UMPIRE_ENABLE_CUDA) && defined(UMPIRE_ENABLE_NUMA)
+using test_types = ::testing::Types<MallocAllocator, MmapAllocator, NumaAllocator, CudaMallocAllocator, CudaMallocManagedAllocator, CudaPinnedAllocator>;
+#elif defined(UMPIRE_ENABLE_CUDA)
+using test_types = ::testing::Types<MallocAllocator, MmapAllocator, CudaMallocAllocator, CudaMallocManagedAllocator, CudaPinnedAllocator>;
+#elif defined(UMPIRE_ENABLE_NUMA)
+using test_types = ::testing::Types<MallocAllocator, MmapAllocator, NumaAllocator>;
 #else
-using test_types = ::testing::Types<MallocAllocator>;
+using test_types = ::testing::Types<MallocAllocator, MmapAllocator>;
 #endif
 
 INSTANTIATE_TYPED_TEST_CASE_P(Default, MemoryAllocatorTest, test_types);
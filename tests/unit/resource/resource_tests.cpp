@@ -16,6 +16,7 @@
 #include "gmock/gmock.h"
 
 #include "umpire/resource/DefaultMemoryResource.hpp"
+#include "umpire/resource/DeferredFreeMemoryResource.hpp"
 
 struct TestAllocator
 {
@@ -24,6 +25,23 @@ struct TestAllocator
     return ::malloc(bytes);
   }
 
+  void* allocateZeroed(size_t bytes)
+  {
+    return ::calloc(1, bytes);
+  }
+
+  void* tryAllocate(size_t bytes)
+  {
+    return ::malloc(bytes);
+  }
+
+  void* allocate(size_t bytes, size_t alignment)
+  {
+    void* ptr = nullptr;
+    ::posix_memalign(&ptr, alignment, bytes);
+    return ptr;
+  }
+
   void deallocate(void* ptr)
   {
     ::free(ptr);
@@ -44,6 +62,44 @@ TEST(DefaultMemoryResource, AllocateDeallocate)
   ASSERT_NE(pointer, nullptr);
 }
 
+TEST(DefaultMemoryResource, AllocateZeroed)
+{
+  auto alloc = std::make_shared<umpire::resource::DefaultMemoryResource<TestAllocator> >(umpire::Platform::cpu, "TEST", 0);
+  char* pointer = (char*)alloc->allocateZeroed(64);
+  ASSERT_NE(pointer, nullptr);
+  ASSERT_EQ(alloc->getCurrentSize(), 64);
+
+  for (int i = 0; i < 64; ++i) {
+    ASSERT_EQ(pointer[i], 0);
+  }
+
+  alloc->deallocate(pointer);
+  ASSERT_EQ(alloc->getCurrentSize(), 0);
+}
+
+struct FailingAllocator : TestAllocator
+{
+  void* tryAllocate(size_t)
+  {
+    return nullptr;
+  }
+};
+
+TEST(DefaultMemoryResource, TryAllocate)
+{
+  auto alloc = std::make_shared<umpire::resource::DefaultMemoryResource<TestAllocator> >(umpire::Platform::cpu, "TEST", 0);
+  void* pointer = alloc->tryAllocate(10);
+  ASSERT_NE(pointer, nullptr);
+  ASSERT_EQ(alloc->getCurrentSize(), 10);
+  alloc->deallocate(pointer);
+
+  auto failing = std::make_shared<umpire::resource::DefaultMemoryResource<FailingAllocator> >(umpire::Platform::cpu, "TEST", 0);
+  ASSERT_EQ(failing->tryAllocate(10), nullptr);
+  ASSERT_EQ(failing->tryAllocateUntracked(10), nullptr);
+  ASSERT_EQ(failing->getCurrentSize(), 0);
+  ASSERT_EQ(failing->getHighWatermark(), 0);
+}
+
 TEST(DefaultMemoryResource, GetSize)
 {
   auto alloc = std::make_shared<umpire::resource::DefaultMemoryResource<TestAllocator> >(umpire::Platform::cpu, "TEST", 0);
@@ -74,3 +130,52 @@ TEST(DefaultMemoryResource, GetHighWatermark)
 
   alloc->deallocate(pointer_two);
 }
+
+struct CountingAllocator : TestAllocator
+{
+  static int frees;
+
+  void deallocate(void* ptr)
+  {
+    ++frees;
+    TestAllocator::deallocate(ptr);
+  }
+};
+
+int CountingAllocator::frees = 0;
+
+TEST(DeferredFreeMemoryResource, QueuesUntilRelease)
+{
+  CountingAllocator::frees = 0;
+
+  auto alloc = std::make_shared<umpire::resource::DeferredFreeMemoryResource<CountingAllocator> >(umpire::Platform::cpu, "TEST", 0);
+
+  void* pointer = alloc->allocate(10);
+  void* pointer_two = alloc->allocate(30);
+
+  alloc->deallocate(pointer);
+  alloc->deallocate(pointer_two);
+
+  ASSERT_EQ(CountingAllocator::frees, 0);
+  ASSERT_EQ(alloc->getNumPendingFrees(), 2);
+  ASSERT_EQ(alloc->getCurrentSize(), 0);
+  ASSERT_EQ(alloc->getActualSize(), 40);
+
+  alloc->release();
+
+  ASSERT_EQ(CountingAllocator::frees, 2);
+  ASSERT_EQ(alloc->getNumPendingFrees(), 0);
+  ASSERT_EQ(alloc->getActualSize(), 0);
+}
+
+TEST(DeferredFreeMemoryResource, DrainsOnDestruction)
+{
+  CountingAllocator::frees = 0;
+
+  {
+    auto alloc = std::make_shared<umpire::resource::DeferredFreeMemoryResource<CountingAllocator> >(umpire::Platform::cpu, "TEST", 0);
+    alloc->deallocate(alloc->allocate(10));
+  }
+
+  ASSERT_EQ(CountingAllocator::frees, 1);
+}
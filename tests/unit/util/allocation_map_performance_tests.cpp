@@ -30,11 +30,11 @@ class AllocationMapPerformanceTest : public ::testing::Test {
       size = 8;
 
       data = new double*[num_entries];
-      records = new umpire::util::AllocationRecord*[num_entries];
+      records = new umpire::util::AllocationRecord[num_entries];
 
       for (size_t i = 0; i < num_entries; i++) {
         data[i] = new double[size];
-        records[i] = new umpire::util::AllocationRecord{data[i], size, nullptr};
+        records[i] = umpire::util::AllocationRecord{data[i], size, nullptr};
       }
 
     }
@@ -42,7 +42,6 @@ class AllocationMapPerformanceTest : public ::testing::Test {
     virtual void TearDown() {
       for (size_t i = 0; i < num_entries; i++) {
         delete[] data[i];
-        delete records[i];
       }
 
       delete[] data;
@@ -54,7 +53,7 @@ class AllocationMapPerformanceTest : public ::testing::Test {
     double** data;
     size_t size;
     size_t num_entries;
-    umpire::util::AllocationRecord** records;
+    umpire::util::AllocationRecord* records;
 };
 
 TEST_F(AllocationMapPerformanceTest, Insert)
@@ -20,12 +20,26 @@
 
 #include "gtest/gtest.h"
 
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * These tests look records up with find, so they use full maps whatever
+ * UMPIRE_ALLOCATION_MAP_COMPACT says; see CompactAllocationMapTest.
+ */
 class AllocationMapTest : public ::testing::Test {
   protected:
+    AllocationMapTest() :
+      map(1, umpire::util::AllocationMap::getDefaultBackend(), false)
+    {
+    }
+
     virtual void SetUp() {
       double* data = new double[15];
       size = 15*sizeof(double);
-      record = new umpire::util::AllocationRecord{data, size, nullptr};
+      record = umpire::util::AllocationRecord{data, size, nullptr};
     }
 
     virtual void TearDown() {
@@ -35,7 +49,7 @@ class AllocationMapTest : public ::testing::Test {
 
     double* data;
     size_t size;
-    umpire::util::AllocationRecord* record;
+    umpire::util::AllocationRecord record;
 };
 
 TEST_F(AllocationMapTest, Add)
@@ -60,7 +74,8 @@ TEST_F(AllocationMapTest, Find)
 
   auto actual_record = map.find(data);
 
-  ASSERT_EQ(record, actual_record);
+  ASSERT_EQ(record.m_ptr, actual_record->m_ptr);
+  ASSERT_EQ(record.m_size, actual_record->m_size);
 }
 
 TEST_F(AllocationMapTest, FindOffset)
@@ -71,7 +86,8 @@ TEST_F(AllocationMapTest, FindOffset)
 
   auto actual_record = map.find(&data[4]);
 
-  ASSERT_EQ(record, actual_record);
+  ASSERT_EQ(record.m_ptr, actual_record->m_ptr);
+  ASSERT_EQ(record.m_size, actual_record->m_size);
 }
 
 TEST_F(AllocationMapTest, Contains)
@@ -118,14 +134,14 @@ TEST_F(AllocationMapTest, RemoveAndUse)
 
   auto found_record = map.remove(data);
 
-  ASSERT_EQ(record, found_record);
+  ASSERT_EQ(record.m_ptr, found_record.m_ptr);
+  ASSERT_EQ(record.m_size, found_record.m_size);
 
 }
 
 TEST_F(AllocationMapTest, RegisterMultiple)
 {
-  umpire::util::AllocationRecord* next_record = 
-    new umpire::util::AllocationRecord{data, 1, nullptr};
+  umpire::util::AllocationRecord next_record{data, 1, nullptr};
 
   ASSERT_NO_THROW(
     map.insert(data, record);
@@ -135,8 +151,7 @@ TEST_F(AllocationMapTest, RegisterMultiple)
 
 TEST_F(AllocationMapTest, FindMultiple)
 {
-  umpire::util::AllocationRecord* next_record = 
-    new umpire::util::AllocationRecord{data, 1, nullptr};
+  umpire::util::AllocationRecord next_record{data, 1, nullptr};
 
   EXPECT_NO_THROW({
     map.insert(data, record);
@@ -145,7 +160,7 @@ TEST_F(AllocationMapTest, FindMultiple)
 
   auto actual_record = map.find(data);
 
-  ASSERT_EQ(next_record, actual_record);
+  ASSERT_EQ(next_record.m_size, actual_record->m_size);
 
   map.remove(data);
 
@@ -153,5 +168,480 @@ TEST_F(AllocationMapTest, FindMultiple)
     actual_record = map.find(data);
   );
 
-  ASSERT_EQ(actual_record, record);
+  ASSERT_EQ(actual_record->m_size, record.m_size);
+}
+
+class ShardedAllocationMapTest : public ::testing::Test {
+  protected:
+    ShardedAllocationMapTest() :
+      map(8, umpire::util::AllocationMap::getDefaultBackend(), false)
+    {
+    }
+
+    umpire::util::AllocationMap map;
+};
+
+TEST_F(ShardedAllocationMapTest, NumShards)
+{
+  ASSERT_EQ(map.getNumShards(), 8);
+}
+
+TEST_F(ShardedAllocationMapTest, FindAcrossShards)
+{
+  const size_t num_records = 64;
+  const uintptr_t stride = (1 << 21) + 128;
+  const uintptr_t base = 0x10000000;
+
+  for (size_t i = 0; i < num_records; ++i) {
+    void* ptr = reinterpret_cast<void*>(base + i*stride);
+    map.insert(ptr, {ptr, 64, nullptr});
+  }
+
+  for (size_t i = 0; i < num_records; ++i) {
+    char* ptr = reinterpret_cast<char*>(base + i*stride);
+    ASSERT_EQ(map.find(ptr)->m_ptr, ptr);
+    ASSERT_EQ(map.find(ptr + 32)->m_ptr, ptr);
+  }
+
+  for (size_t i = 0; i < num_records; ++i) {
+    void* ptr = reinterpret_cast<void*>(base + i*stride);
+    ASSERT_EQ(map.remove(ptr).m_ptr, ptr);
+  }
+}
+
+TEST_F(ShardedAllocationMapTest, FindSpanningRecord)
+{
+  char* ptr = reinterpret_cast<char*>(0x20000000);
+  const size_t size = 64*1024*1024;
+
+  auto record = map.insert(ptr, {ptr, size, nullptr});
+
+  for (size_t offset = 0; offset < size; offset += (1 << 20)) {
+    ASSERT_EQ(map.find(ptr + offset), record);
+  }
+  ASSERT_EQ(map.find(ptr + size - 1), record);
+
+  ASSERT_EQ(map.remove(ptr).m_size, size);
+
+  for (size_t offset = 0; offset < size; offset += (1 << 20)) {
+    ASSERT_FALSE(map.contains(ptr + offset));
+  }
+}
+
+TEST_F(ShardedAllocationMapTest, InsertBatchRemoveRange)
+{
+  const size_t num_records = 64;
+  const uintptr_t stride = (1 << 20) + 128;
+  const uintptr_t base = 0x30000000;
+
+  std::vector<void*> ptrs(num_records);
+  std::vector<umpire::util::AllocationRecord> records(num_records);
+
+  for (size_t i = 0; i < num_records; ++i) {
+    ptrs[i] = reinterpret_cast<void*>(base + i*stride);
+    records[i] = umpire::util::AllocationRecord{ptrs[i], 64, nullptr};
+  }
+
+  // The first record spans several shards
+  records[0].m_size = 8*stride;
+
+  map.insertBatch(ptrs.data(), records.data(), num_records);
+
+  for (size_t i = 0; i < num_records; ++i) {
+    ASSERT_EQ(map.find(ptrs[i])->m_ptr, ptrs[i]);
+  }
+
+  // Everything up to, but not including, the last record
+  const size_t removed = map.removeRange(ptrs[0], ptrs[num_records - 1]);
+  ASSERT_EQ(removed, num_records - 1);
+
+  for (size_t i = 0; i < num_records - 1; ++i) {
+    ASSERT_THROW(map.remove(ptrs[i]), umpire::util::Exception);
+  }
+  ASSERT_FALSE(map.contains(static_cast<char*>(ptrs[0]) + 4*stride + 256));
+
+  ASSERT_EQ(map.remove(ptrs[num_records - 1]).m_ptr, ptrs[num_records - 1]);
+  ASSERT_EQ(map.removeRange(ptrs[0], ptrs[num_records - 1]), 0u);
+}
+
+TEST_F(ShardedAllocationMapTest, RemoveRangeOfStrategy)
+{
+  auto owner = reinterpret_cast<umpire::strategy::AllocationStrategy*>(0x1);
+  char* chunk = reinterpret_cast<char*>(0x40000000);
+
+  // A chunk record, and a pool allocation at the same address
+  map.insert(chunk, {chunk, 4096, nullptr});
+  map.insert(chunk, {chunk, 64, owner});
+  map.insert(chunk + 64, {chunk + 64, 64, owner});
+
+  ASSERT_EQ(map.removeRange(chunk, chunk + 4096, owner), 2u);
+
+  ASSERT_EQ(map.find(chunk)->m_size, 4096u);
+  ASSERT_THROW(map.remove(chunk + 64), umpire::util::Exception);
+  ASSERT_EQ(map.remove(chunk).m_size, 4096u);
+}
+
+TEST_F(ShardedAllocationMapTest, ConcurrentInsertFindRemove)
+{
+  const int num_threads = 8;
+  const int num_records = 1000;
+
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < num_threads; ++t) {
+    threads.push_back(std::thread([this, t, num_records] () {
+      for (int i = 0; i < num_records; ++i) {
+        double* data = new double[8];
+        auto record = map.insert(data, {data, 8*sizeof(double), nullptr});
+
+        ASSERT_EQ(map.find(&data[4]), record);
+        ASSERT_EQ(map.remove(data).m_ptr, data);
+
+        delete[] data;
+      }
+    }));
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+class AllocationMapBackendTest :
+  public ::testing::TestWithParam<umpire::util::AllocationMap::Backend>
+{
+  protected:
+    AllocationMapBackendTest() :
+      map(4, GetParam(), false)
+    {
+    }
+
+    umpire::util::AllocationMap map;
+};
+
+TEST_P(AllocationMapBackendTest, Backend)
+{
+  ASSERT_EQ(map.getBackendType(), GetParam());
+}
+
+TEST_P(AllocationMapBackendTest, InsertFindRemove)
+{
+  // Enough records to grow each shard's exact index several times
+  const size_t num_records = 20000;
+  const uintptr_t stride = 4096 + 64;
+  const uintptr_t base = 0x50000000;
+
+  for (size_t i = 0; i < num_records; ++i) {
+    void* ptr = reinterpret_cast<void*>(base + i*stride);
+    map.insert(ptr, {ptr, 1024, nullptr});
+  }
+
+  for (size_t i = 0; i < num_records; ++i) {
+    char* ptr = reinterpret_cast<char*>(base + i*stride);
+    ASSERT_EQ(map.find(ptr)->m_ptr, ptr);
+    ASSERT_EQ(map.find(ptr + 1023)->m_ptr, ptr);
+    ASSERT_FALSE(map.contains(ptr + 1024));
+  }
+
+  // Remove every other record, then check the rest are still reachable
+  for (size_t i = 0; i < num_records; i += 2) {
+    void* ptr = reinterpret_cast<void*>(base + i*stride);
+    ASSERT_EQ(map.remove(ptr).m_ptr, ptr);
+  }
+
+  for (size_t i = 0; i < num_records; ++i) {
+    char* ptr = reinterpret_cast<char*>(base + i*stride);
+    ASSERT_EQ(map.contains(ptr), (i % 2) == 1);
+    ASSERT_EQ(map.contains(ptr + 512), (i % 2) == 1);
+  }
+
+  ASSERT_EQ(map.removeRange(
+        reinterpret_cast<void*>(base),
+        reinterpret_cast<void*>(base + num_records*stride)), num_records/2);
+
+  ASSERT_FALSE(map.contains(reinterpret_cast<void*>(base + stride)));
+}
+
+TEST_P(AllocationMapBackendTest, NestedRecords)
+{
+  char* chunk = reinterpret_cast<char*>(0x60000000);
+
+  map.insert(chunk, {chunk, 4096, nullptr});
+  map.insert(chunk, {chunk, 64, nullptr});
+
+  ASSERT_EQ(map.find(chunk)->m_size, 64u);
+  ASSERT_EQ(map.find(chunk + 32)->m_size, 64u);
+  ASSERT_EQ(map.find(chunk + 128)->m_size, 4096u);
+
+  map.remove(chunk);
+  ASSERT_EQ(map.find(chunk)->m_size, 4096u);
+
+  map.remove(chunk);
+  ASSERT_FALSE(map.contains(chunk));
+}
+
+TEST_P(AllocationMapBackendTest, Reset)
+{
+  const size_t num_records = 20000;
+  const uintptr_t stride = 4096;
+  const uintptr_t base = 0x70000000;
+
+  for (size_t i = 0; i < num_records; ++i) {
+    void* ptr = reinterpret_cast<void*>(base + i*stride);
+    map.insert(ptr, {ptr, 1024, nullptr});
+  }
+
+  // Nested records are held in vectors that must go too
+  char* chunk = reinterpret_cast<char*>(base);
+  map.insert(chunk, {chunk, 64, nullptr});
+
+  ASSERT_TRUE(map.contains(chunk));
+  map.reset();
+
+  ASSERT_EQ(map.getStatistics().num_records, 0u);
+  ASSERT_FALSE(map.contains(chunk));
+  ASSERT_FALSE(map.contains(reinterpret_cast<void*>(base + stride)));
+
+  // The map is usable afterwards
+  map.insert(chunk, {chunk, 128, nullptr});
+  ASSERT_EQ(map.find(chunk + 64)->m_size, 128u);
+  ASSERT_EQ(map.remove(chunk).m_ptr, chunk);
+}
+
+TEST_P(AllocationMapBackendTest, RepeatedLookups)
+{
+  char* chunk = reinterpret_cast<char*>(0x70000000);
+
+  map.insert(chunk, {chunk, 4096, nullptr});
+
+  // The second lookup of each pointer is answered from the thread's cache
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_EQ(map.find(chunk)->m_size, 4096u);
+    ASSERT_EQ(map.find(chunk + 128)->m_size, 4096u);
+  }
+
+  // Another map never sees this map's lookups
+  umpire::util::AllocationMap other(4, GetParam(), false);
+  ASSERT_FALSE(other.contains(chunk));
+
+  map.insert(chunk + 128, {chunk + 128, 64, nullptr});
+  ASSERT_EQ(map.find(chunk + 128)->m_size, 64u);
+
+  map.remove(chunk + 128);
+  ASSERT_EQ(map.find(chunk + 128)->m_size, 4096u);
+
+  map.remove(chunk);
+  ASSERT_FALSE(map.contains(chunk));
+  ASSERT_FALSE(map.contains(chunk + 128));
+
+  void* batch_ptr = chunk;
+  umpire::util::AllocationRecord batch_record{chunk, 1024, nullptr};
+  map.insertBatch(&batch_ptr, &batch_record, 1);
+  ASSERT_EQ(map.find(chunk)->m_size, 1024u);
+
+  map.removeRange(chunk, chunk + 4096);
+  ASSERT_FALSE(map.contains(chunk));
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Backends,
+    AllocationMapBackendTest,
+    ::testing::Values(
+      umpire::util::AllocationMap::Backend::judy,
+      umpire::util::AllocationMap::Backend::tree,
+      umpire::util::AllocationMap::Backend::sorted_vector));
+
+TEST(AllocationMapBackend, GetBackend)
+{
+  ASSERT_EQ(umpire::util::AllocationMap::getBackend("tree"),
+      umpire::util::AllocationMap::Backend::tree);
+  ASSERT_THROW(umpire::util::AllocationMap::getBackend("hash"),
+      umpire::util::Exception);
+}
+
+class CompactAllocationMapTest :
+  public ::testing::TestWithParam<umpire::util::AllocationMap::Backend>
+{
+  protected:
+    CompactAllocationMapTest() :
+      map(4, GetParam(), true)
+    {
+    }
+
+    umpire::util::AllocationMap map;
+};
+
+TEST_P(CompactAllocationMapTest, InsertGetRemove)
+{
+  auto owner = reinterpret_cast<umpire::strategy::AllocationStrategy*>(0x10);
+  char* ptr = reinterpret_cast<char*>(0x70000000);
+
+  ASSERT_TRUE(map.isCompact());
+
+  // Packed records have no address
+  ASSERT_EQ(map.insert(ptr, {ptr, 4096, owner}), nullptr);
+  ASSERT_THROW(map.find(ptr), umpire::util::Exception);
+
+  auto record = map.get(ptr + 100);
+  ASSERT_EQ(record.m_ptr, ptr);
+  ASSERT_EQ(record.m_size, 4096u);
+  ASSERT_EQ(record.m_strategy, owner);
+
+  ASSERT_FALSE(map.contains(ptr + 4096));
+
+  record = map.remove(ptr);
+  ASSERT_EQ(record.m_size, 4096u);
+  ASSERT_EQ(record.m_strategy, owner);
+  ASSERT_FALSE(map.contains(ptr));
+}
+
+TEST_P(CompactAllocationMapTest, NestedRecords)
+{
+  auto owner = reinterpret_cast<umpire::strategy::AllocationStrategy*>(0x10);
+  auto pool = reinterpret_cast<umpire::strategy::AllocationStrategy*>(0x20);
+  char* chunk = reinterpret_cast<char*>(0x80000000);
+
+  // Too large to pack, so stored as a full record
+  const size_t huge = size_t{1} << 50;
+  ASSERT_NE(map.insert(chunk, {chunk, huge, owner}), nullptr);
+  map.insert(chunk, {chunk, 64, pool});
+  map.insert(chunk + 64, {chunk + 64, 64, pool});
+
+  ASSERT_EQ(map.get(chunk).m_strategy, pool);
+  ASSERT_EQ(map.get(chunk + 96).m_strategy, pool);
+
+  ASSERT_EQ(map.removeRange(chunk, chunk + 4096, pool), 2u);
+
+  ASSERT_EQ(map.get(chunk).m_strategy, owner);
+  ASSERT_EQ(map.get(chunk + 128).m_size, huge);
+  ASSERT_EQ(map.remove(chunk).m_size, huge);
+  ASSERT_FALSE(map.contains(chunk));
+}
+
+TEST_P(CompactAllocationMapTest, Statistics)
+{
+  umpire::util::AllocationMap full_map(4, GetParam(), false);
+
+  const size_t num_records = 20000;
+  const uintptr_t stride = 256;
+  const uintptr_t base = 0x90000000;
+
+  for (size_t i = 0; i < num_records; ++i) {
+    void* ptr = reinterpret_cast<void*>(base + i*stride);
+    map.insert(ptr, {ptr, 128, nullptr});
+    full_map.insert(ptr, {ptr, 128, nullptr});
+  }
+
+  auto statistics = map.getStatistics();
+  auto full_statistics = full_map.getStatistics();
+
+  ASSERT_EQ(statistics.num_records, num_records);
+  ASSERT_EQ(full_statistics.num_records, num_records);
+  ASSERT_LT(statistics.num_bytes, full_statistics.num_bytes);
+
+  ASSERT_EQ(map.removeRange(
+        reinterpret_cast<void*>(base),
+        reinterpret_cast<void*>(base + num_records*stride)), num_records);
+  ASSERT_EQ(map.getStatistics().num_records, 0u);
+}
+
+TEST_P(CompactAllocationMapTest, GetAcrossShards)
+{
+  const size_t num_records = 64;
+  const uintptr_t stride = (1 << 21) + 128;
+  const uintptr_t base = 0x10000000;
+
+  for (size_t i = 0; i < num_records; ++i) {
+    void* ptr = reinterpret_cast<void*>(base + i*stride);
+    map.insert(ptr, {ptr, 64, nullptr});
+  }
+
+  for (size_t i = 0; i < num_records; ++i) {
+    char* ptr = reinterpret_cast<char*>(base + i*stride);
+    ASSERT_EQ(map.get(ptr).m_ptr, ptr);
+    ASSERT_EQ(map.get(ptr + 32).m_ptr, ptr);
+    ASSERT_THROW(map.find(ptr), umpire::util::Exception);
+  }
+
+  for (size_t i = 0; i < num_records; ++i) {
+    void* ptr = reinterpret_cast<void*>(base + i*stride);
+    ASSERT_EQ(map.remove(ptr).m_ptr, ptr);
+  }
+}
+
+TEST_P(CompactAllocationMapTest, GetSpanningRecord)
+{
+  char* ptr = reinterpret_cast<char*>(0x20000000);
+  const size_t size = 64*1024*1024;
+
+  map.insert(ptr, {ptr, size, nullptr});
+
+  for (size_t offset = 0; offset < size; offset += (1 << 20)) {
+    ASSERT_EQ(map.get(ptr + offset).m_size, size);
+  }
+  ASSERT_EQ(map.get(ptr + size - 1).m_ptr, ptr);
+
+  ASSERT_EQ(map.remove(ptr).m_size, size);
+  ASSERT_FALSE(map.contains(ptr));
 }
+
+TEST_P(CompactAllocationMapTest, InsertBatchRemoveRange)
+{
+  const size_t num_records = 64;
+  const uintptr_t stride = (1 << 20) + 128;
+  const uintptr_t base = 0x30000000;
+
+  std::vector<void*> ptrs(num_records);
+  std::vector<umpire::util::AllocationRecord> records(num_records);
+
+  for (size_t i = 0; i < num_records; ++i) {
+    ptrs[i] = reinterpret_cast<void*>(base + i*stride);
+    records[i] = umpire::util::AllocationRecord{ptrs[i], 64, nullptr};
+  }
+
+  map.insertBatch(ptrs.data(), records.data(), num_records);
+
+  for (size_t i = 0; i < num_records; ++i) {
+    ASSERT_EQ(map.get(ptrs[i]).m_ptr, ptrs[i]);
+  }
+
+  ASSERT_EQ(map.removeRange(ptrs[0], ptrs[num_records - 1]), num_records - 1);
+  ASSERT_FALSE(map.contains(ptrs[0]));
+  ASSERT_EQ(map.remove(ptrs[num_records - 1]).m_ptr, ptrs[num_records - 1]);
+}
+
+TEST(CompactAllocationMap, DefaultFromEnvironment)
+{
+  const char* saved = std::getenv("UMPIRE_ALLOCATION_MAP_COMPACT");
+  const std::string previous = saved ? saved : "";
+
+  ::setenv("UMPIRE_ALLOCATION_MAP_COMPACT", "1", 1);
+  umpire::util::AllocationMap compact_map;
+  ::setenv("UMPIRE_ALLOCATION_MAP_COMPACT", "0", 1);
+  umpire::util::AllocationMap full_map;
+
+  if (saved) {
+    ::setenv("UMPIRE_ALLOCATION_MAP_COMPACT", previous.c_str(), 1);
+  } else {
+    ::unsetenv("UMPIRE_ALLOCATION_MAP_COMPACT");
+  }
+
+  char* ptr = reinterpret_cast<char*>(0x50000000);
+
+  ASSERT_TRUE(compact_map.isCompact());
+  compact_map.insert(ptr, {ptr, 64, nullptr});
+  ASSERT_THROW(compact_map.find(ptr), umpire::util::Exception);
+  ASSERT_EQ(compact_map.get(ptr).m_size, 64u);
+
+  ASSERT_FALSE(full_map.isCompact());
+  full_map.insert(ptr, {ptr, 64, nullptr});
+  ASSERT_EQ(full_map.find(ptr)->m_size, 64u);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Backends,
+    CompactAllocationMapTest,
+    ::testing::Values(
+      umpire::util::AllocationMap::Backend::judy,
+      umpire::util::AllocationMap::Backend::tree,
+      umpire::util::AllocationMap::Backend::sorted_vector));
@@ -0,0 +1,115 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory
+//
+// Created by David Beckingsale, david@llnl.gov
+// LLNL-CODE-747640
+//
+// All rights reserved.
+//
+// This file is part of Umpire.
+//
+// For details, see https://github.com/LLNL/Umpire
+// Please also see the LICENSE file for MIT license.
+//////////////////////////////////////////////////////////////////////////////
+#include "umpire/util/Tracer.hpp"
+#include "umpire/util/Macros.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+const char* trace_file = "trace_tests.trace";
+
+class TraceEnvironment : public ::testing::Environment {
+  public:
+    void SetUp() {
+      setenv("UMPIRE_TRACE_FILE", trace_file, 1);
+    }
+};
+
+::testing::Environment* const trace_environment =
+  ::testing::AddGlobalTestEnvironment(new TraceEnvironment);
+
+} // end of anonymous namespace
+
+TEST(Tracer, RecordAndRead)
+{
+  const std::string allocator_name("trace_allocator");
+
+  UMPIRE_RECORD_STATISTIC(allocator_name,
+      "ptr", static_cast<uintptr_t>(0x1000),
+      "size", 64,
+      "event", "allocate");
+
+  UMPIRE_RECORD_STATISTIC("TraceOperation",
+      "src_ptr", static_cast<uintptr_t>(0x1000),
+      "value", 7,
+      "size", 32,
+      "event", "memset");
+
+  umpire::util::Tracer::getTracer()->flush();
+
+  std::vector<std::string> names;
+  std::vector<umpire::util::trace::Record> records;
+
+  umpire::util::Tracer::readTrace(trace_file, names, records);
+
+  ASSERT_GE(records.size(), 2u);
+
+  const auto& allocate = records[records.size() - 2];
+  ASSERT_EQ(names[allocate.name], allocator_name);
+  ASSERT_EQ(allocate.event, umpire::util::trace::allocate);
+  ASSERT_EQ(allocate.ptr, 0x1000u);
+  ASSERT_EQ(allocate.size, 64u);
+  ASSERT_EQ(allocate.fields, umpire::util::trace::has_ptr | umpire::util::trace::has_size);
+
+  const auto& memset = records[records.size() - 1];
+  ASSERT_EQ(names[memset.name], "TraceOperation");
+  ASSERT_EQ(memset.event, umpire::util::trace::memset);
+  ASSERT_EQ(memset.arg_key, umpire::util::trace::value);
+  ASSERT_EQ(memset.arg, 7);
+  ASSERT_GE(memset.timestamp, allocate.timestamp);
+}
+
+TEST(Tracer, ManyThreads)
+{
+  const int num_threads = 4;
+  const int events_per_thread = 10000;
+
+  std::vector<umpire::util::trace::Record> before;
+  std::vector<std::string> names;
+
+  umpire::util::Tracer::getTracer()->flush();
+  umpire::util::Tracer::readTrace(trace_file, names, before);
+
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < num_threads; ++t) {
+    threads.push_back(std::thread([=] () {
+      for (int i = 0; i < events_per_thread; ++i) {
+        UMPIRE_RECORD_STATISTIC("TraceThreads",
+            "ptr", static_cast<uintptr_t>(t),
+            "size", i,
+            "event", "deallocate");
+      }
+    }));
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  umpire::util::Tracer::getTracer()->flush();
+
+  std::vector<umpire::util::trace::Record> after;
+  umpire::util::Tracer::readTrace(trace_file, names, after);
+
+  ASSERT_EQ(after.size() - before.size(),
+      static_cast<std::size_t>(num_threads*events_per_thread));
+}